@@ -0,0 +1,205 @@
+/**
+ * @file adc_acq.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Timer triggered ADC acquisition interface 
+ * 
+ * @details ADC1 converts its regular sequence on each update (TRGO) of TIM2 or TIM3 so 
+ *          samples are taken at a fixed rate with no CPU work per sample. DMA2 Stream 0 
+ *          runs in double buffer mode and writes the results into two blocks of 
+ *          'scans' sequences each. While the DMA fills one block the other is handed 
+ *          out, either to a callback from the transfer complete interrupt or through 
+ *          adc_acq_block_get/adc_acq_block_release after EVENT_DMA2_0 (or a FreeRTOS 
+ *          task notification). 
+ * 
+ *          The ADC port, pins and sequence are set up with the ADC driver first (scan 
+ *          mode for more than one channel) and the ADC turned on. Continuous mode is 
+ *          cleared and DMA, external trigger and overrun interrupt settings are made 
+ *          here. 
+ * 
+ *          Overruns: 
+ *            - A block still held when the DMA comes back around to it is counted and 
+ *              adc_acq_block_release returns FALSE. 
+ *            - Blocks that finish before the last one was taken are skipped (only the 
+ *              newest block is handed out) and counted as lost. 
+ *            - An ADC overrun (DMA request missed) restarts the DMA at the start of a 
+ *              block so channels stay in order, and is counted. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _ADC_ACQ_H_ 
+#define _ADC_ACQ_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+#include "system_settings.h" 
+
+#if FREERTOS_ENABLE
+#include "FreeRTOS.h" 
+#include "task.h" 
+#endif   // FREERTOS_ENABLE 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define ADC_ACQ_BUFF_SIZE 512               // Max samples per block (all channels) 
+#define ADC_ACQ_ADC ADC1                    // ADC sampled 
+#define ADC_ACQ_DMA DMA2                    // DMA controller of the ADC stream 
+#define ADC_ACQ_STREAM DMA2_Stream0         // ADC1 stream 
+#define ADC_ACQ_CHNL DMA_CHNL_0             // ADC1 channel 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Block of samples - sequences one after the other with channels in sequence order 
+typedef struct adc_acq_block_s
+{
+    const uint16_t *data;                   // Samples 
+    uint16_t scans;                         // Sequences in the block 
+    uint8_t channels;                       // Channels per sequence 
+    uint32_t number;                        // Block number (counts from 0) 
+}
+adc_acq_block_t; 
+
+
+// Acquisition statistics 
+typedef struct adc_acq_stats_s
+{
+    uint32_t blocks;                        // Blocks filled 
+    uint32_t lost;                          // Blocks skipped before being taken 
+    uint32_t overruns;                      // Blocks overwritten while held 
+    uint32_t adc_overruns;                  // ADC overruns (DMA restarted) 
+}
+adc_acq_stats_t; 
+
+
+/**
+ * @brief Block callback - runs in the DMA interrupt 
+ * 
+ * @details The block can be used until the callback returns. It must finish within a 
+ *          block period. 
+ */
+typedef void (*adc_acq_callback_t)(const adc_acq_block_t *block); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Initialize the acquisition 
+ * 
+ * @details Sets the timer's prescaler and auto reload for the sample rate, selects its 
+ *          update event as the ADC trigger and configures the DMA stream. Nothing is 
+ *          sampled until adc_acq_start. 
+ * 
+ * @param timer : trigger timer (TIM2 or TIM3) 
+ * @param rate : sequences per second 
+ * @param scans : sequences per block (scans * channels up to ADC_ACQ_BUFF_SIZE) 
+ * @param callback : block callback (NULL to use adc_acq_block_get) 
+ * @param priority : DMA stream and ADC interrupt priority 
+ * @return uint32_t : actual sample rate or 0 if the timer isn't supported 
+ */
+uint32_t adc_acq_init(
+    TIM_TypeDef *timer, 
+    uint32_t rate, 
+    uint16_t scans, 
+    adc_acq_callback_t callback, 
+    uint8_t priority); 
+
+
+/**
+ * @brief Start sampling 
+ */
+void adc_acq_start(void); 
+
+
+/**
+ * @brief Stop sampling 
+ * 
+ * @details A block that was being filled is discarded. adc_acq_start starts over with 
+ *          a new block. 
+ */
+void adc_acq_stop(void); 
+
+
+/**
+ * @brief Get the newest filled block 
+ * 
+ * @details The block stays valid until adc_acq_block_release is called as long as the 
+ *          DMA doesn't fill the other block in that time, and the same block is returned 
+ *          until then. 
+ * 
+ * @param block : block of samples 
+ * @return uint8_t : TRUE if a block is available 
+ */
+uint8_t adc_acq_block_get(adc_acq_block_t *block); 
+
+
+/**
+ * @brief Release the block from adc_acq_block_get 
+ * 
+ * @return uint8_t : TRUE if the block wasn't overwritten while it was held 
+ */
+uint8_t adc_acq_block_release(void); 
+
+
+/**
+ * @brief Read the acquisition statistics 
+ * 
+ * @param stats : copy of the statistics 
+ */
+void adc_acq_get_stats(adc_acq_stats_t *stats); 
+
+
+#if FREERTOS_ENABLE
+
+/**
+ * @brief Notify a task each time a block is filled (vTaskNotifyGiveFromISR) 
+ * 
+ * @details The task waits with ulTaskNotifyTake then reads the block with 
+ *          adc_acq_block_get. 
+ * 
+ * @param task : task to notify (NULL to stop) 
+ */
+void adc_acq_notify_set(TaskHandle_t task); 
+
+#endif   // FREERTOS_ENABLE 
+
+
+/**
+ * @brief Interrupt handler hook - called from the DMA stream and ADC handlers 
+ * 
+ * @details Hands out a filled block and restarts the DMA after an ADC overrun. A filled 
+ *          block is found from the stream's current target bit so it doesn't matter if 
+ *          the flags were cleared by another stream's handler. Does nothing if the 
+ *          acquisition isn't initialized. 
+ */
+void adc_acq_irq_handler(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _ADC_ACQ_H_ 
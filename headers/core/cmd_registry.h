@@ -0,0 +1,284 @@
+/**
+ * @file cmd_registry.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Command registry interface 
+ * 
+ * @details Looks up user commands (serial terminal or radio payload) by name using a 
+ *          perfect hash built at compile time. The hash is seeded FNV-1a and the seed is 
+ *          searched for when the registry is built so every command lands in its own 
+ *          slot. A lookup hashes the input once and compares it to the one command in 
+ *          its slot, so the time depends on the input length and not the number of 
+ *          commands. The slots point to the command names so no strings are copied to 
+ *          RAM and the whole registry is constant data (flash). 
+ * 
+ *          A lookup returns the command's position in the list it was built from. The 
+ *          caller keeps its callbacks (or other command data) in a constant array in the 
+ *          same order. 
+ * 
+ *          Registries are built in C++ (cmd_registry_make). Tests written in C list 
+ *          their commands with a macro that is expanded into the callback array in the C 
+ *          file and into the names in a C++ file that builds the registry, which keeps 
+ *          the two in the same order. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _CMD_REGISTRY_H_ 
+#define _CMD_REGISTRY_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define CMD_REGISTRY_NONE 0xFF              // Lookup result for an unknown command 
+#define CMD_REGISTRY_MAX_CMDS 64            // Max commands in a registry 
+#define CMD_REGISTRY_MAX_LEN 48             // Max command name length 
+#define CMD_REGISTRY_MAX_SEEDS 100000       // Seeds tried before giving up 
+
+// Seeded FNV-1a (32-bit) - shared by the lookup and the compile time build 
+#define CMD_REGISTRY_FNV_BASIS 0x811C9DC5 
+#define CMD_REGISTRY_FNV_PRIME 0x01000193 
+#define CMD_REGISTRY_HASH_INIT(seed) ((uint32_t)CMD_REGISTRY_FNV_BASIS ^ (uint32_t)(seed)) 
+#define CMD_REGISTRY_HASH_STEP(hash, c) \
+    ((uint32_t)(((hash) ^ (uint8_t)(c)) * (uint32_t)CMD_REGISTRY_FNV_PRIME))
+#define CMD_REGISTRY_SLOT(hash, mask) (((hash) ^ ((hash) >> 15)) & (mask)) 
+
+// Expands a command list entry to its name (C++ registry build) 
+#define CMD_REGISTRY_NAME(name, func) name, 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Registry slot 
+typedef struct cmd_registry_slot_s
+{
+    const char *name;                       // Command name (NULL if the slot is empty) 
+    uint8_t len;                            // Command name length 
+    uint8_t index;                          // Position in the command list 
+}
+cmd_registry_slot_t; 
+
+
+// Registry 
+typedef struct cmd_registry_s
+{
+    const cmd_registry_slot_t *slots;       // Slots (power of 2 number of them) 
+    uint32_t seed;                          // Hash seed 
+    uint8_t mask;                           // Number of slots - 1 
+}
+cmd_registry_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Find a command 
+ * 
+ * @details The input is hashed in the same pass that finds its length and then compared 
+ *          to the command in its slot only. Input longer than CMD_REGISTRY_MAX_LEN never 
+ *          matches and isn't read past that length. 
+ * 
+ * @param registry : command registry 
+ * @param cmd : null terminated input 
+ * @return uint8_t : position in the command list or CMD_REGISTRY_NONE 
+ */
+uint8_t cmd_registry_find(
+    const cmd_registry_t *registry, 
+    const char *cmd); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#ifdef __cplusplus
+
+// C++ linkage even when included from a header's extern "C" block 
+extern "C++" {
+
+//=======================================================================================
+// Compile time build 
+
+/**
+ * @brief Registry table built by cmd_registry_make 
+ * 
+ * @details Declare it constexpr (static storage) and use registry() to get the 
+ *          cmd_registry_t passed to cmd_registry_find. 
+ * 
+ * @tparam NUM_SLOTS : number of slots 
+ */
+template <uint16_t NUM_SLOTS>
+struct cmd_registry_table_t
+{
+    cmd_registry_slot_t slots[NUM_SLOTS]; 
+    uint32_t seed; 
+
+    constexpr cmd_registry_t registry(void) const
+    {
+        return { slots, seed, static_cast<uint8_t>(NUM_SLOTS - 1) }; 
+    }
+}; 
+
+
+// Slots for a number of commands - a power of 2 at least twice the number of commands 
+// keeps the seed search short 
+consteval uint16_t cmd_registry_num_slots(size_t num_cmds)
+{
+    uint16_t num_slots = 2; 
+
+    while (num_slots < (2 * num_cmds))
+    {
+        num_slots <<= 1; 
+    }
+
+    return num_slots; 
+}
+
+
+// Command name length 
+consteval uint8_t cmd_registry_len(const char *name)
+{
+    size_t len = CLEAR; 
+
+    while (name[len] != NULL_CHAR)
+    {
+        len++; 
+    }
+
+    if (!len || (len > CMD_REGISTRY_MAX_LEN))
+    {
+        throw "Command name is empty or longer than CMD_REGISTRY_MAX_LEN"; 
+    }
+
+    return static_cast<uint8_t>(len); 
+}
+
+
+// Slot of a command name for a seed 
+consteval uint8_t cmd_registry_slot(
+    const char *name, 
+    uint32_t seed, 
+    uint8_t mask)
+{
+    uint32_t hash = CMD_REGISTRY_HASH_INIT(seed); 
+
+    for (size_t i = CLEAR; name[i] != NULL_CHAR; i++)
+    {
+        hash = CMD_REGISTRY_HASH_STEP(hash, name[i]); 
+    }
+
+    return static_cast<uint8_t>(CMD_REGISTRY_SLOT(hash, mask)); 
+}
+
+
+/**
+ * @brief Build a command registry at compile time 
+ * 
+ * @details Tries seeds until each command has its own slot. Duplicate names, too many 
+ *          commands, bad name lengths or no seed found stop the build. 
+ * 
+ *          static constexpr auto table = cmd_registry_make({ "start", "stop" }); 
+ * 
+ * @tparam NUM_CMDS : number of commands (deduced) 
+ * @param names : command names in command list order 
+ * @return registry table 
+ */
+template <size_t NUM_CMDS>
+consteval auto cmd_registry_make(const char *const (&names)[NUM_CMDS])
+{
+    constexpr uint16_t num_slots = cmd_registry_num_slots(NUM_CMDS); 
+    constexpr uint8_t mask = static_cast<uint8_t>(num_slots - 1); 
+    static_assert(NUM_CMDS <= CMD_REGISTRY_MAX_CMDS, "Too many commands for a registry"); 
+
+    cmd_registry_table_t<num_slots> table = {}; 
+    bool used[num_slots] = {}; 
+    bool found = false; 
+
+    for (size_t i = CLEAR; i < NUM_CMDS; i++)
+    {
+        uint8_t len = cmd_registry_len(names[i]); 
+
+        for (size_t j = CLEAR; j < i; j++)
+        {
+            bool same = (len == cmd_registry_len(names[j])); 
+
+            for (uint8_t k = CLEAR; same && (k < len); k++)
+            {
+                same = (names[i][k] == names[j][k]); 
+            }
+
+            if (same)
+            {
+                throw "Duplicate command name"; 
+            }
+        }
+    }
+
+    for (uint32_t seed = CLEAR; !found && (seed < CMD_REGISTRY_MAX_SEEDS); seed++)
+    {
+        found = true; 
+
+        for (uint16_t i = CLEAR; i < num_slots; i++)
+        {
+            used[i] = false; 
+        }
+
+        for (size_t i = CLEAR; found && (i < NUM_CMDS); i++)
+        {
+            uint8_t slot = cmd_registry_slot(names[i], seed, mask); 
+            found = !used[slot]; 
+            used[slot] = true; 
+        }
+
+        table.seed = seed; 
+    }
+
+    if (!found)
+    {
+        throw "No perfect hash seed found - raise CMD_REGISTRY_MAX_SEEDS"; 
+    }
+
+    for (size_t i = CLEAR; i < NUM_CMDS; i++)
+    {
+        uint8_t index = cmd_registry_slot(names[i], table.seed, mask); 
+
+        table.slots[index].name = names[i]; 
+        table.slots[index].len = cmd_registry_len(names[i]); 
+        table.slots[index].index = static_cast<uint8_t>(i); 
+    }
+
+    return table; 
+}
+
+//=======================================================================================
+
+}   // extern "C++" 
+
+#endif   // __cplusplus 
+
+#endif   // _CMD_REGISTRY_H_ 
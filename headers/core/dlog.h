@@ -0,0 +1,168 @@
+/**
+ * @file dlog.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Deferred format logging interface 
+ * 
+ * @details DLOG("RPM: %lu", rpm) doesn't format any text on the device. The format 
+ *          string is placed in the dlog_fmt section which is kept in the ELF file but 
+ *          not loaded into flash, and its offset in the section is used as the message 
+ *          ID. The ID and the arguments (32-bit each) are sent as a frame through the 
+ *          serial transmit queue (uart_tx_queue.h) which must be initialized first: 
+ * 
+ *            | DLOG_SYNC | argument bytes | ID (LE, 16-bit) | arguments (LE, 32-bit) | 
+ * 
+ *          The host decoder (tools/dlog_decode.cpp) reads the format strings from the 
+ *          ELF file and turns the frames in a serial capture back into text. Bytes 
+ *          outside of frames (plain text) are passed through unchanged. 
+ * 
+ *          Arguments: 
+ *            - Up to DLOG_ARGS_MAX (more won't compile), each cast to 32 bits. int and 
+ *              long are 32-bit on the target so %d, %u, %x, %c and their 'l' versions 
+ *              work. 
+ *            - Floats must be passed with dlog_float (%f, %e, %g). 
+ *            - Strings (%s) can't be used because only the pointer would be sent. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _DLOG_H_ 
+#define _DLOG_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define DLOG_SYNC 0xD1                      // Frame start (not used by ASCII text) 
+#define DLOG_HEADER_LEN 4                   // Sync, argument length and ID bytes 
+#define DLOG_ARGS_MAX 8                     // Max arguments per message 
+#define DLOG_ARG_LEN 4                      // Bytes per argument 
+#define DLOG_FRAME_MAX (DLOG_HEADER_LEN + (DLOG_ARGS_MAX * DLOG_ARG_LEN)) 
+
+// Format string placement - the section name must stay a valid C identifier so the 
+// linker defines __start_dlog_fmt 
+#define DLOG_FMT_SECTION __attribute__((section("dlog_fmt"), used, aligned(1))) 
+
+// Message ID - offset of the format string in the dlog_fmt section 
+#define DLOG_ID(fmt_str) \
+    ((uint16_t)((uintptr_t)(fmt_str) - (uintptr_t)__start_dlog_fmt))
+
+// Argument count (0 - 8) 
+#define DLOG_NARGS(...) DLOG_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0) 
+#define DLOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n 
+
+// Casts each argument to 32 bits 
+#define DLOG_CAT(a, b) DLOG_CAT_(a, b) 
+#define DLOG_CAT_(a, b) a##b 
+#define DLOG_CAST(n, ...) DLOG_CAT(DLOG_CAST_, n)(__VA_ARGS__) 
+#define DLOG_CAST_0() 
+#define DLOG_CAST_1(a) (uint32_t)(a) 
+#define DLOG_CAST_2(a, ...) (uint32_t)(a), DLOG_CAST_1(__VA_ARGS__) 
+#define DLOG_CAST_3(a, ...) (uint32_t)(a), DLOG_CAST_2(__VA_ARGS__) 
+#define DLOG_CAST_4(a, ...) (uint32_t)(a), DLOG_CAST_3(__VA_ARGS__) 
+#define DLOG_CAST_5(a, ...) (uint32_t)(a), DLOG_CAST_4(__VA_ARGS__) 
+#define DLOG_CAST_6(a, ...) (uint32_t)(a), DLOG_CAST_5(__VA_ARGS__) 
+#define DLOG_CAST_7(a, ...) (uint32_t)(a), DLOG_CAST_6(__VA_ARGS__) 
+#define DLOG_CAST_8(a, ...) (uint32_t)(a), DLOG_CAST_7(__VA_ARGS__) 
+
+/**
+ * @brief Log a message 
+ * 
+ * @details Only the format ID and the arguments are sent. Costs about as much as 
+ *          copying the frame into the transmit queue. 
+ * 
+ * @param fmt : format string literal 
+ * @param ... : arguments (see above) 
+ */
+#define DLOG(fmt, ...)                                                               \
+    do                                                                               \
+    {                                                                                \
+        static const char dlog_fmt_str[] DLOG_FMT_SECTION = fmt;                     \
+        const uint32_t dlog_args[DLOG_NARGS(__VA_ARGS__) + 1] =                      \
+            { DLOG_CAST(DLOG_NARGS(__VA_ARGS__), ##__VA_ARGS__) };                   \
+        dlog_write(DLOG_ID(dlog_fmt_str), dlog_args, DLOG_NARGS(__VA_ARGS__));       \
+    }                                                                                \
+    while (0)
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Variables 
+
+// Start of the format string section (defined by the linker) 
+extern const char __start_dlog_fmt[]; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Encode a message frame 
+ * 
+ * @param frame : frame buffer (at least DLOG_FRAME_MAX bytes) 
+ * @param id : message ID 
+ * @param args : arguments 
+ * @param num_args : number of arguments (up to DLOG_ARGS_MAX) 
+ * @return uint8_t : frame length 
+ */
+uint8_t dlog_encode(
+    uint8_t *frame, 
+    uint16_t id, 
+    const uint32_t *args, 
+    uint8_t num_args); 
+
+
+/**
+ * @brief Send a message frame through the serial transmit queue - called by DLOG 
+ * 
+ * @details The frame is queued whole or, with UART_TXQ_DROP, not at all. 
+ * 
+ * @param id : message ID 
+ * @param args : arguments 
+ * @param num_args : number of arguments 
+ */
+void dlog_write(
+    uint16_t id, 
+    const uint32_t *args, 
+    uint8_t num_args); 
+
+
+/**
+ * @brief Float argument 
+ * 
+ * @param value : float value 
+ * @return uint32_t : value bits 
+ */
+static inline uint32_t dlog_float(float value)
+{
+    uint32_t bits; 
+    memcpy(&bits, &value, sizeof(bits)); 
+    return bits; 
+}
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _DLOG_H_ 
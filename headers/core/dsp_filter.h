@@ -0,0 +1,467 @@
+/**
+ * @file dsp_filter.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Fixed point filter interface 
+ * 
+ * @details Filter stages for blocks of ADC and sensor samples in Q15 (int16_t, +/-1.0) 
+ *          with Q31 states and accumulators so no floating point is needed: 
+ *            - Offset (ex. remove the ADC mid scale bias) 
+ *            - Moving average over 2^n samples 
+ *            - Single pole low pass (exponential average), Q15 and Q31 versions 
+ *            - Biquad (direct form 1) with Q14 coefficients 
+ *            - CIC decimator 
+ * 
+ *          Each Q15 stage has the same block function form so stages can be chained 
+ *          with dsp_chain_q15. Input and output may be the same buffer. Results are 
+ *          truncated (not rounded) and saturated where they can overflow. 
+ * 
+ *          On the target the kernels use the Cortex-M4 DSP instructions (dual 16-bit 
+ *          multiply accumulate and saturating math) through the CMSIS intrinsics. Other 
+ *          builds (host) and DSP_SIMD_ENABLE = 0 use plain C versions of the same 
+ *          operations, which give bit for bit the same results. The DSP test 
+ *          (dsp_test.h) checks this. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _DSP_FILTER_H_ 
+#define _DSP_FILTER_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+#include "system_settings.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// DSP instructions are used when the core has them 
+#if DSP_SIMD_ENABLE && defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define DSP_SIMD 1 
+#else
+#define DSP_SIMD 0 
+#endif
+
+#define DSP_Q15_MAX 0x7FFF                  // Largest Q15 value (0.99997) 
+#define DSP_Q31_MAX 0x7FFFFFFF              // Largest Q31 value 
+#define DSP_Q14_SHIFT 14                    // Biquad coefficient fraction bits 
+#define DSP_MA_WINDOW_MAX_LOG2 6            // Largest moving average window (64) 
+#define DSP_MA_WINDOW_MAX (1 << DSP_MA_WINDOW_MAX_LOG2) 
+#define DSP_CIC_ORDER_MAX 4                 // Max CIC integrator/comb pairs 
+#define DSP_CIC_GROWTH_MAX 16               // Max CIC bit growth (order * log2(rate)) 
+
+#define DSP_Q15_PAIR 2                      // Samples per 32-bit dual 16-bit operation 
+
+// Float to fixed point (constants only) 
+#define DSP_Q15(x) ((dsp_q15_t)((x) * 32768.0 + (((x) < 0) ? -0.5 : 0.5))) 
+#define DSP_Q14(x) ((dsp_q15_t)((x) * 16384.0 + (((x) < 0) ? -0.5 : 0.5))) 
+#define DSP_Q31(x) ((dsp_q31_t)((x) * 2147483648.0 + (((x) < 0) ? -0.5 : 0.5))) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Data types 
+
+typedef int16_t dsp_q15_t;                  // Q15 sample 
+typedef int32_t dsp_q31_t;                  // Q31 sample 
+
+
+/**
+ * @brief Q15 stage block function 
+ * 
+ * @param stage : stage data 
+ * @param in : input samples 
+ * @param out : output samples (may be 'in') 
+ * @param len : number of input samples 
+ * @return uint16_t : number of output samples 
+ */
+typedef uint16_t (*dsp_process_q15_t)(
+    void *stage, 
+    const dsp_q15_t *in, 
+    dsp_q15_t *out, 
+    uint16_t len); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Stage in a chain 
+typedef struct dsp_stage_q15_s
+{
+    dsp_process_q15_t process;              // Block function 
+    void *stage;                            // Stage data 
+}
+dsp_stage_q15_t; 
+
+
+// Offset 
+typedef struct dsp_offset_q15_s
+{
+    dsp_q15_t offset;                       // Added to each sample 
+}
+dsp_offset_q15_t; 
+
+
+// Moving average 
+typedef struct dsp_ma_q15_s
+{
+    dsp_q15_t history[DSP_MA_WINDOW_MAX];   // Samples in the window 
+    int32_t sum;                            // Sum of the window 
+    uint8_t window_log2;                    // Window length = 2^window_log2 
+    uint8_t index;                          // Oldest sample 
+}
+dsp_ma_q15_t; 
+
+
+// Single pole low pass - Q15 samples 
+typedef struct dsp_iir1_q15_s
+{
+    dsp_q31_t state;                        // Output (Q31 to avoid a dead band) 
+    dsp_q15_t alpha;                        // Gain (0 - 1) 
+}
+dsp_iir1_q15_t; 
+
+
+// Single pole low pass - Q31 samples 
+typedef struct dsp_iir1_q31_s
+{
+    dsp_q31_t state;                        // Output 
+    dsp_q31_t alpha;                        // Gain (0 - 1) 
+}
+dsp_iir1_q31_t; 
+
+
+// Biquad - coefficient pairs are packed to be used two at a time 
+typedef struct dsp_biquad_q15_s
+{
+    dsp_q15_t b0;                           // Q14 
+    uint32_t b12;                           // b1 (low) and b2 (high) - Q14 
+    uint32_t a12;                           // -a1 (low) and -a2 (high) - Q14 
+    uint32_t x12;                           // x[n-1] (low) and x[n-2] (high) 
+    uint32_t y12;                           // y[n-1] (low) and y[n-2] (high) 
+}
+dsp_biquad_q15_t; 
+
+
+// CIC decimator 
+typedef struct dsp_cic_q15_s
+{
+    uint32_t integrators[DSP_CIC_ORDER_MAX];    // Integrator sums (wrap around) 
+    uint32_t combs[DSP_CIC_ORDER_MAX];          // Comb delays 
+    uint8_t order;                          // Integrator/comb pairs 
+    uint8_t rate_log2;                      // Decimation = 2^rate_log2 
+    uint8_t shift;                          // Gain correction (order * rate_log2) 
+    uint8_t phase;                          // Input samples since the last output 
+}
+dsp_cic_q15_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// DSP operations - plain C versions of the instructions used 
+
+// Pack two Q15 values - 'low' in bits 0-15 and 'high' in bits 16-31 
+static inline uint32_t dsp_pack_q15(dsp_q15_t low, dsp_q15_t high)
+{
+    return (uint16_t)low | ((uint32_t)(uint16_t)high << 16); 
+}
+
+
+// SMLAD - dual 16-bit multiply plus 32-bit accumulate (wraps) 
+static inline int32_t dsp_smlad_c(uint32_t x, uint32_t y, int32_t acc)
+{
+    int64_t sum = (int64_t)acc +
+                  ((int32_t)(int16_t)x * (int16_t)y) +
+                  ((int32_t)(int16_t)(x >> 16) * (int16_t)(y >> 16)); 
+    return (int32_t)(uint32_t)sum; 
+}
+
+
+// SMLALD - dual 16-bit multiply plus 64-bit accumulate 
+static inline int64_t dsp_smlald_c(uint32_t x, uint32_t y, int64_t acc)
+{
+    return acc +
+           ((int32_t)(int16_t)x * (int16_t)y) +
+           ((int32_t)(int16_t)(x >> 16) * (int16_t)(y >> 16)); 
+}
+
+
+// QADD - saturating 32-bit add 
+static inline int32_t dsp_qadd_c(int32_t x, int32_t y)
+{
+    int64_t sum = (int64_t)x + y; 
+    return (sum > INT32_MAX) ? INT32_MAX : ((sum < INT32_MIN) ? INT32_MIN : (int32_t)sum); 
+}
+
+
+// QSUB - saturating 32-bit subtract 
+static inline int32_t dsp_qsub_c(int32_t x, int32_t y)
+{
+    int64_t sum = (int64_t)x - y; 
+    return (sum > INT32_MAX) ? INT32_MAX : ((sum < INT32_MIN) ? INT32_MIN : (int32_t)sum); 
+}
+
+
+// QADD16 - saturating add of two 16-bit pairs 
+static inline uint32_t dsp_qadd16_c(uint32_t x, uint32_t y)
+{
+    int32_t low = (int16_t)x + (int16_t)y; 
+    int32_t high = (int16_t)(x >> 16) + (int16_t)(y >> 16); 
+    low = (low > INT16_MAX) ? INT16_MAX : ((low < INT16_MIN) ? INT16_MIN : low); 
+    high = (high > INT16_MAX) ? INT16_MAX : ((high < INT16_MIN) ? INT16_MIN : high); 
+    return dsp_pack_q15((dsp_q15_t)low, (dsp_q15_t)high); 
+}
+
+
+// SSAT 16 - saturate to 16 bits 
+static inline int32_t dsp_ssat16_c(int32_t x)
+{
+    return (x > INT16_MAX) ? INT16_MAX : ((x < INT16_MIN) ? INT16_MIN : x); 
+}
+
+
+// The operations used by the filters 
+#if DSP_SIMD
+#define dsp_smlad(x, y, acc) ((int32_t)__SMLAD((x), (y), (uint32_t)(acc))) 
+#define dsp_smlald(x, y, acc) ((int64_t)__SMLALD((x), (y), (uint64_t)(acc))) 
+#define dsp_qadd(x, y) __QADD((x), (y)) 
+#define dsp_qsub(x, y) __QSUB((x), (y)) 
+#define dsp_qadd16(x, y) __QADD16((x), (y)) 
+#define dsp_ssat16(x) __SSAT((x), 16) 
+#else   // DSP_SIMD 
+#define dsp_smlad(x, y, acc) dsp_smlad_c((x), (y), (acc)) 
+#define dsp_smlald(x, y, acc) dsp_smlald_c((x), (y), (acc)) 
+#define dsp_qadd(x, y) dsp_qadd_c((x), (y)) 
+#define dsp_qsub(x, y) dsp_qsub_c((x), (y)) 
+#define dsp_qadd16(x, y) dsp_qadd16_c((x), (y)) 
+#define dsp_ssat16(x) dsp_ssat16_c((x)) 
+#endif   // DSP_SIMD 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Convert ADC results to Q15 
+ * 
+ * @details Results are scaled to Q15 full scale (0 - 1.0). 'stride' picks one channel 
+ *          out of a scan block (adc_acq.h), ex. stride 3 and adc + 1 for the second of 
+ *          three channels. 
+ * 
+ * @param adc : first ADC result 
+ * @param stride : distance between results used 
+ * @param out : Q15 samples 
+ * @param len : number of samples 
+ * @param resolution : ADC resolution (bits) 
+ */
+void dsp_adc_to_q15(
+    const uint16_t *adc, 
+    uint8_t stride, 
+    dsp_q15_t *out, 
+    uint16_t len, 
+    uint8_t resolution); 
+
+
+/**
+ * @brief Run a block through a chain of Q15 stages 
+ * 
+ * @details Each stage works in place on 'block'. A decimating stage shortens the block 
+ *          for the stages after it. 
+ * 
+ * @param stages : stages in order 
+ * @param num_stages : number of stages 
+ * @param block : samples in, filtered samples out 
+ * @param len : number of samples 
+ * @return uint16_t : number of samples out 
+ */
+uint16_t dsp_chain_q15(
+    const dsp_stage_q15_t *stages, 
+    uint8_t num_stages, 
+    dsp_q15_t *block, 
+    uint16_t len); 
+
+
+/**
+ * @brief Offset block function - stage is a dsp_offset_q15_t 
+ * 
+ * @details Adds the offset to each sample with saturation, two samples at a time. 
+ * 
+ * @see dsp_process_q15_t 
+ */
+uint16_t dsp_offset_q15(
+    void *stage, 
+    const dsp_q15_t *in, 
+    dsp_q15_t *out, 
+    uint16_t len); 
+
+
+/**
+ * @brief Moving average setup 
+ * 
+ * @details The history starts at 'initial' so the output doesn't ramp up from 0. 
+ * 
+ * @param ma : moving average data 
+ * @param window_log2 : window length = 2^window_log2 (up to DSP_MA_WINDOW_MAX_LOG2) 
+ * @param initial : starting value 
+ */
+void dsp_ma_q15_init(
+    dsp_ma_q15_t *ma, 
+    uint8_t window_log2, 
+    dsp_q15_t initial); 
+
+
+/**
+ * @brief Moving average block function - stage is a dsp_ma_q15_t 
+ * 
+ * @see dsp_process_q15_t 
+ */
+uint16_t dsp_ma_q15(
+    void *stage, 
+    const dsp_q15_t *in, 
+    dsp_q15_t *out, 
+    uint16_t len); 
+
+
+/**
+ * @brief Single pole low pass setup - Q15 
+ * 
+ * @details y[n] = y[n-1] + alpha * (x[n] - y[n-1]). For a cutoff frequency fc at a 
+ *          sample rate fs, alpha ~ 1 - exp(-2 * pi * fc / fs). 
+ * 
+ * @param iir : filter data 
+ * @param alpha : gain (Q15, 0 - 1) 
+ * @param initial : starting output 
+ */
+void dsp_iir1_q15_init(
+    dsp_iir1_q15_t *iir, 
+    dsp_q15_t alpha, 
+    dsp_q15_t initial); 
+
+
+/**
+ * @brief Single pole low pass block function - stage is a dsp_iir1_q15_t 
+ * 
+ * @see dsp_process_q15_t 
+ */
+uint16_t dsp_iir1_q15(
+    void *stage, 
+    const dsp_q15_t *in, 
+    dsp_q15_t *out, 
+    uint16_t len); 
+
+
+/**
+ * @brief Single pole low pass setup - Q31 
+ * 
+ * @see dsp_iir1_q15_init 
+ * 
+ * @param iir : filter data 
+ * @param alpha : gain (Q31, 0 - 1) 
+ * @param initial : starting output 
+ */
+void dsp_iir1_q31_init(
+    dsp_iir1_q31_t *iir, 
+    dsp_q31_t alpha, 
+    dsp_q31_t initial); 
+
+
+/**
+ * @brief Single pole low pass - Q31 samples 
+ * 
+ * @param iir : filter data 
+ * @param in : input samples 
+ * @param out : output samples (may be 'in') 
+ * @param len : number of samples 
+ */
+void dsp_iir1_q31(
+    dsp_iir1_q31_t *iir, 
+    const dsp_q31_t *in, 
+    dsp_q31_t *out, 
+    uint16_t len); 
+
+
+/**
+ * @brief Biquad setup 
+ * 
+ * @details H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2) with the 
+ *          coefficients in Q14 (-2.0 to 2.0) - see DSP_Q14. a1 and a2 are stored negated 
+ *          so a value of -2.0 is limited to -1.99994. The states start at 0. 
+ * 
+ * @param biquad : filter data 
+ * @param coeffs : b0, b1, b2, a1, a2 
+ */
+void dsp_biquad_q15_init(
+    dsp_biquad_q15_t *biquad, 
+    const dsp_q15_t coeffs[5]); 
+
+
+/**
+ * @brief Biquad block function - stage is a dsp_biquad_q15_t 
+ * 
+ * @see dsp_process_q15_t 
+ */
+uint16_t dsp_biquad_q15(
+    void *stage, 
+    const dsp_q15_t *in, 
+    dsp_q15_t *out, 
+    uint16_t len); 
+
+
+/**
+ * @brief CIC decimator setup 
+ * 
+ * @details Output is one sample per 2^rate_log2 input samples with unity gain at DC. 
+ *          order * rate_log2 can't be more than DSP_CIC_GROWTH_MAX. 
+ * 
+ * @param cic : filter data 
+ * @param order : integrator/comb pairs (1 - DSP_CIC_ORDER_MAX) 
+ * @param rate_log2 : decimation = 2^rate_log2 
+ * @return uint8_t : TRUE if the settings are supported 
+ */
+uint8_t dsp_cic_q15_init(
+    dsp_cic_q15_t *cic, 
+    uint8_t order, 
+    uint8_t rate_log2); 
+
+
+/**
+ * @brief CIC decimator block function - stage is a dsp_cic_q15_t 
+ * 
+ * @details The decimation phase carries over between blocks so blocks don't need to 
+ *          be a multiple of the rate. 
+ * 
+ * @see dsp_process_q15_t 
+ */
+uint16_t dsp_cic_q15(
+    void *stage, 
+    const dsp_q15_t *in, 
+    dsp_q15_t *out, 
+    uint16_t len); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _DSP_FILTER_H_ 
@@ -0,0 +1,199 @@
+/**
+ * @file isr_profile.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Interrupt handler latency and duration profiler interface 
+ * 
+ * @details The interrupt handlers in stm32f4xx_it.c read the DWT cycle counter on entry 
+ *          and exit when ISR_PROFILE_ENABLE is set (system_settings.h). For each 
+ *          interrupt enabled with isr_profile_enable the handler duration, and the 
+ *          latency when the interrupt source gives one, are added to log2 histograms 
+ *          (bucket n counts times from 2^(n-1) up to 2^n cycles) in a fixed table. The 
+ *          histograms are written out one line at a time with isr_profile_dump so they 
+ *          can be sent to the serial terminal or written to an SD card file. 
+ * 
+ *          Durations include time spent in higher priority handlers that preempt the 
+ *          handler. Latency is the time from the interrupt request to the handler start 
+ *          and is found from the timer counter for timer update interrupts and from the 
+ *          SysTick counter for SysTick. It includes time spent waiting for other handlers 
+ *          of the same or higher priority to finish. 
+ * 
+ *          Interrupt overrides (INTERRUPT_OVERRIDE) can be profiled by adding the same 
+ *          ISR_PROFILE_ENTER / ISR_PROFILE_EXIT hooks to them. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _ISR_PROFILE_H_ 
+#define _ISR_PROFILE_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "system_settings.h" 
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define ISR_PROFILE_SLOTS 12                // Max number of profiled interrupts 
+#define ISR_PROFILE_BUCKETS 24              // Histogram buckets (last is >= 2^22 cycles) 
+#define ISR_PROFILE_LINE_LEN 100            // Max dump line length 
+#define ISR_PROFILE_NO_LATENCY 0xFFFFFFFF   // Interrupt source has no latency measurement 
+
+// Handler hooks - used at the start and end of the handlers in stm32f4xx_it.c 
+#if ISR_PROFILE_ENABLE
+
+#define ISR_PROFILE_ENTER(latency)                                       \
+    const uint32_t isr_profile_latency = (latency);                      \
+    const uint32_t isr_profile_start = isr_profile_enter()
+
+#define ISR_PROFILE_EXIT(irqn)                                           \
+    isr_profile_exit((irqn), isr_profile_start, isr_profile_latency)
+
+#else   // ISR_PROFILE_ENABLE 
+
+#define ISR_PROFILE_ENTER(latency) 
+#define ISR_PROFILE_EXIT(irqn) 
+
+#endif   // ISR_PROFILE_ENABLE 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Profile of one interrupt (times in CPU cycles) 
+typedef struct isr_profile_s
+{
+    IRQn_Type irqn;                                 // Interrupt number 
+    const char *name;                               // Name shown in the dump 
+    uint32_t count;                                 // Handler calls 
+    uint32_t duration_max;                          // Longest handler duration 
+    uint32_t latency_max;                           // Longest latency 
+    uint32_t duration[ISR_PROFILE_BUCKETS];         // Duration histogram 
+    uint32_t latency[ISR_PROFILE_BUCKETS];          // Latency histogram 
+}
+isr_profile_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Setup 
+
+/**
+ * @brief Profile an interrupt 
+ * 
+ * @details Gives the interrupt a slot in the profile table and starts the DWT cycle 
+ *          counter. Enabling an interrupt that is already profiled clears its profile. 
+ * 
+ * @param irqn : interrupt number (SysTick_IRQn is supported) 
+ * @param name : name shown in the dump 
+ * @return uint8_t : TRUE if the interrupt is profiled, FALSE if the table is full 
+ */
+uint8_t isr_profile_enable(
+    IRQn_Type irqn, 
+    const char *name); 
+
+
+/**
+ * @brief Clear the histograms of all profiled interrupts 
+ */
+void isr_profile_clear(void); 
+
+
+/**
+ * @brief Copy the profile of an interrupt 
+ * 
+ * @details Interrupts are disabled during the copy so the profile is consistent. 
+ * 
+ * @param irqn : interrupt number 
+ * @param profile : copy of the profile 
+ * @return uint8_t : TRUE if the interrupt is profiled 
+ */
+uint8_t isr_profile_get(
+    IRQn_Type irqn, 
+    isr_profile_t *profile); 
+
+
+/**
+ * @brief Write the profile of every profiled interrupt 
+ * 
+ * @details Each line is passed to 'write' (ending in "\r\n"). Use a function that sends 
+ *          the line to the serial terminal or one that writes it to an open file. 
+ * 
+ * @param write : line output function 
+ */
+void isr_profile_dump(void (*write)(const char *line)); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Handler hooks 
+
+/**
+ * @brief Handler start time 
+ * 
+ * @return uint32_t : DWT cycle count 
+ */
+uint32_t isr_profile_enter(void); 
+
+
+/**
+ * @brief Record a handler call 
+ * 
+ * @param irqn : interrupt number of the handler 
+ * @param start : start time from isr_profile_enter 
+ * @param latency : latency in CPU cycles or ISR_PROFILE_NO_LATENCY 
+ */
+void isr_profile_exit(
+    IRQn_Type irqn, 
+    uint32_t start, 
+    uint32_t latency); 
+
+
+/**
+ * @brief Latency of a timer update interrupt 
+ * 
+ * @details An up counting timer starts from zero at the update event so the counter 
+ *          gives the time since the interrupt was requested. The resolution is the 
+ *          prescaler and the timer clock is taken to be the CPU clock (84MHz setup used 
+ *          by the tests). 
+ * 
+ * @param timer : timer of the handler 
+ * @return uint32_t : latency (CPU cycles) 
+ */
+uint32_t isr_profile_timer_latency(TIM_TypeDef *timer); 
+
+
+/**
+ * @brief Latency of the SysTick interrupt 
+ * 
+ * @details SysTick counts down from LOAD and is clocked by the CPU clock. 
+ * 
+ * @return uint32_t : latency (CPU cycles) 
+ */
+uint32_t isr_profile_systick_latency(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _ISR_PROFILE_H_ 
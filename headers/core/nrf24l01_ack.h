@@ -0,0 +1,120 @@
+/**
+ * @file nrf24l01_ack.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief nRF24L01 ACK payload interface 
+ * 
+ * @details With auto acknowledgement on, the PRX answers every payload it receives 
+ *          with an ACK. This lets the PRX put its own payload in that ACK so data 
+ *          (ex. telemetry) goes back to the PTX without the two swapping roles or 
+ *          spending extra air time. It needs the radio's dynamic payload length and 
+ *          ACK payload features, which the driver doesn't set, so this writes those 
+ *          registers itself (nrf24l01_reg.h). 
+ * 
+ *          PRX side: nrf24l01_ack_load puts a payload in the radio's TX FIFO to be sent 
+ *          with the next ACK on a pipe. One payload is kept waiting at a time so the 
+ *          payload sent is never more than one received payload behind. 
+ * 
+ *          PTX side: a payload sent with an ACK is received like any other payload on 
+ *          data pipe 0 (the pipe ACKs come in on), so it's read from the receive ring 
+ *          (nrf24l01_rx.h) with nrf24l01_rx_read. 
+ * 
+ *          The radio's SPI port is shared with the receive interrupt so calls here mask 
+ *          it (nrf24l01_rx_lock). The ACK sent interrupt isn't wanted on the IRQ pin (it 
+ *          would hold the pin low with no payload to read) so it's masked at init and 
+ *          its flag is cleared each time a payload is loaded. 
+ * 
+ *          A waiting ACK payload sits in the radio's TX FIFO, so a PRX that also sends 
+ *          payloads sends it first. Keep ACK payloads to radios that only receive. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _NRF24L01_ACK_H_ 
+#define _NRF24L01_ACK_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define NRF24L01_ACK_PIPE NRF24L01_DP_0     // Pipe the PTX receives ACK payloads on 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// ACK payload statistics 
+typedef struct nrf24l01_ack_stats_s
+{
+    uint32_t loaded;                        // Payloads loaded 
+    uint32_t sent;                          // Loaded payloads seen sent with an ACK 
+    uint32_t waiting;                       // Loads skipped - a payload was still waiting 
+}
+nrf24l01_ack_stats_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Turn on dynamic payload length and ACK payloads 
+ * 
+ * @details Turns on auto acknowledgement and dynamic payload length on every pipe and 
+ *          enables pipe 0 so ACKs can be received. Both the PTX and PRX must call this. 
+ *          Called after the radio is configured (nrf24l01_ptx_config/prx_config). 
+ * 
+ * @return uint8_t : TRUE if the radio took the settings 
+ */
+uint8_t nrf24l01_ack_init(void); 
+
+
+/**
+ * @brief Load a payload to send with the next ACK on a pipe (PRX) 
+ * 
+ * @details Nothing is loaded if a payload is still waiting to be sent. 
+ * 
+ * @param pipe : data pipe whose next ACK carries the payload 
+ * @param data : payload 
+ * @param len : payload length (1 to NRF24L01_MAX_PAYLOAD_LEN bytes) 
+ * @return uint8_t : TRUE if the payload was loaded 
+ */
+uint8_t nrf24l01_ack_load(
+    nrf24l01_data_pipe_t pipe, 
+    const uint8_t *data, 
+    uint8_t len); 
+
+
+/**
+ * @brief Read the ACK payload statistics 
+ * 
+ * @param stats : copy of the statistics 
+ */
+void nrf24l01_ack_stats(nrf24l01_ack_stats_t *stats); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _NRF24L01_ACK_H_ 
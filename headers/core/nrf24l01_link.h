@@ -0,0 +1,164 @@
+/**
+ * @file nrf24l01_link.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief nRF24L01 link benchmark interface 
+ * 
+ * @details Measures how fast the radio link is for a data rate, payload size and retry 
+ *          setting. The sender (PTX) sends payloads back to back and times each one from 
+ *          the start of the send until the radio reports it acknowledged or out of 
+ *          retries. This send time is the round trip (RTT) of the payload and its ACK 
+ *          including any retransmits. A run reports: 
+ *            - payloads/s and goodput (payload bytes/s) acknowledged 
+ *            - RTT percentiles (histogram of NRF24L01_LINK_RTT_BUCKET_US wide buckets) 
+ *            - retransmit rate (retransmits per payload sent, from OBSERVE_TX) 
+ *            - loss rate (payloads that used up their retries) 
+ * 
+ *          The receiver counts the payloads it takes and returns the count in the ACK 
+ *          of each payload (nrf24l01_ack.h) so the sender can compare it with what it 
+ *          saw acknowledged. The count lags by one payload since the ACK payload is 
+ *          loaded before the payload it answers arrives. 
+ * 
+ *          Each run starts with a control payload carrying the run's data rate. The 
+ *          receiver clears its count and changes to that data rate once it's received. 
+ *          The sender changes only once the control payload is acknowledged. 
+ * 
+ *          Both radios must have ACK payloads on (nrf24l01_ack_init). Sends are made 
+ *          through the radio's registers (nrf24l01_reg.h) rather than the driver so the 
+ *          payload length can be set and the transmit statistics read. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _NRF24L01_LINK_H_ 
+#define _NRF24L01_LINK_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+#include "nrf24l01_rx.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define NRF24L01_LINK_RTT_BUCKET_US 20      // RTT histogram bucket width (us) 
+#define NRF24L01_LINK_RTT_BUCKETS 250       // RTT histogram buckets (last is the rest) 
+#define NRF24L01_LINK_TIMEOUT_US 100000     // Longest wait for a send to finish (us) 
+#define NRF24L01_LINK_CE_PULSE_US 15        // CE high time to start a send (us, >= 10) 
+#define NRF24L01_LINK_PIN_POLLS 1000        // IRQ pin reads between STATUS reads 
+#define NRF24L01_LINK_RETRIES_MAX 15        // Most auto retransmits the radio does 
+#define NRF24L01_LINK_CTRL_TRIES 10         // Control payload sends before a start fails 
+#define NRF24L01_LINK_SCALE 10000           // Rates are per NRF24L01_LINK_SCALE sends 
+
+// Payload tags (first byte) 
+#define NRF24L01_LINK_DATA 0xB1             // Benchmark payload 
+#define NRF24L01_LINK_CTRL 0xB2             // Run start - data rate follows 
+#define NRF24L01_LINK_PEER 0xB3             // Receiver count (ACK payload) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Run settings 
+typedef struct nrf24l01_link_config_s
+{
+    nrf24l01_data_rate_t rate;              // Data rate 
+    uint8_t len;                            // Payload length (bytes) 
+    uint8_t retries;                        // Auto retransmits (0-15) 
+    uint8_t delay;                          // Auto retransmit delay (250 us steps - 1) 
+}
+nrf24l01_link_config_t; 
+
+
+// Run results 
+typedef struct nrf24l01_link_result_s
+{
+    uint32_t sent;                          // Payloads sent 
+    uint32_t acked;                         // Payloads acknowledged 
+    uint32_t peer;                          // Payloads the receiver last reported 
+    uint32_t payloads_per_s;                // Acknowledged payloads per second 
+    uint32_t goodput;                       // Acknowledged payload bytes per second 
+    uint32_t rtt_p50;                       // Median RTT (us) 
+    uint32_t rtt_p90;                       // 90th percentile RTT (us) 
+    uint32_t rtt_p99;                       // 99th percentile RTT (us) 
+    uint32_t rtt_max;                       // Longest RTT (us) 
+    uint32_t retransmit;                    // Retransmits per NRF24L01_LINK_SCALE sends 
+    uint32_t loss;                          // Lost payloads per NRF24L01_LINK_SCALE sends 
+}
+nrf24l01_link_result_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Start a run (sender) 
+ * 
+ * @details Sends the run's control payload at the current data rate then applies the 
+ *          run's settings and clears the statistics. If the control payload isn't 
+ *          acknowledged within NRF24L01_LINK_CTRL_TRIES sends it's sent as many times 
+ *          again at the run's data rate, since the receiver may have taken it and 
+ *          changed rate with only the ACKs lost. If neither is acknowledged the receiver 
+ *          is taken to be on the old rate, so nothing is changed and the run doesn't 
+ *          start. 
+ * 
+ * @param config : run settings 
+ * @return uint8_t : TRUE if the run started, FALSE if the receiver didn't take the 
+ *                   settings 
+ */
+uint8_t nrf24l01_link_start(const nrf24l01_link_config_t *config); 
+
+
+/**
+ * @brief Send one benchmark payload (sender) 
+ * 
+ * @details Blocks until the payload is acknowledged or out of retries (at most 
+ *          NRF24L01_LINK_TIMEOUT_US). 
+ * 
+ * @return uint8_t : TRUE if the payload was acknowledged 
+ */
+uint8_t nrf24l01_link_send(void); 
+
+
+/**
+ * @brief Results of the run so far (sender) 
+ * 
+ * @param result : run results 
+ */
+void nrf24l01_link_result(nrf24l01_link_result_t *result); 
+
+
+/**
+ * @brief Handle a payload taken from the receive ring (receiver) 
+ * 
+ * @details Counts benchmark payloads and loads the count as the next ACK payload. A 
+ *          control payload clears the count and changes the data rate. 
+ * 
+ * @param payload : received payload 
+ */
+void nrf24l01_link_peer(const nrf24l01_rx_payload_t *payload); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _NRF24L01_LINK_H_ 
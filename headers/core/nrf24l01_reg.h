@@ -0,0 +1,150 @@
+/**
+ * @file nrf24l01_reg.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief nRF24L01 register access interface 
+ * 
+ * @details Direct register and command access to the radio over its SPI port for the 
+ *          features the driver doesn't cover (ACK payloads, retry settings, transmit 
+ *          statistics). The radio's SPI port is shared with the receive interrupt 
+ *          (nrf24l01_rx.h) so callers hold nrf24l01_rx_lock around these calls. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _NRF24L01_REG_H_ 
+#define _NRF24L01_REG_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Hardware 
+#define NRF24L01_REG_SPI SPI2               // Radio SPI port 
+#define NRF24L01_REG_SS_GPIO GPIOC          // Radio slave select pin GPIO port 
+#define NRF24L01_REG_SS_PIN GPIOX_PIN_1     // Radio slave select pin 
+#define NRF24L01_REG_CE_GPIO GPIOC          // Radio enable (CE) pin GPIO port 
+#define NRF24L01_REG_CE_PIN GPIOX_PIN_0     // Radio enable (CE) pin 
+
+// Commands 
+#define NRF24L01_REG_R_REGISTER 0x00        // Read register (OR'd with the register) 
+#define NRF24L01_REG_W_REGISTER 0x20        // Write register (OR'd with the register) 
+#define NRF24L01_REG_ACTIVATE 0x50          // Unlock FEATURE (nRF24L01, not the +) 
+#define NRF24L01_REG_ACTIVATE_KEY 0x73      // Data sent after ACTIVATE 
+#define NRF24L01_REG_R_RX_PL_WID 0x60       // Read the width of the top RX payload 
+#define NRF24L01_REG_R_RX_PAYLOAD 0x61      // Read the top RX payload 
+#define NRF24L01_REG_W_TX_PAYLOAD 0xA0      // Write a TX payload 
+#define NRF24L01_REG_W_ACK_PAYLOAD 0xA8     // Write an ACK payload (OR'd with the pipe) 
+#define NRF24L01_REG_FLUSH_TX 0xE1          // Empty the TX FIFO 
+#define NRF24L01_REG_FLUSH_RX 0xE2          // Empty the RX FIFO 
+#define NRF24L01_REG_NOP 0xFF               // No operation (reads STATUS) 
+
+// Registers 
+#define NRF24L01_REG_CONFIG 0x00 
+#define NRF24L01_REG_EN_AA 0x01 
+#define NRF24L01_REG_EN_RXADDR 0x02 
+#define NRF24L01_REG_SETUP_RETR 0x04 
+#define NRF24L01_REG_RF_CH 0x05 
+#define NRF24L01_REG_RF_SETUP 0x06 
+#define NRF24L01_REG_STATUS 0x07 
+#define NRF24L01_REG_OBSERVE_TX 0x08 
+#define NRF24L01_REG_RPD 0x09 
+#define NRF24L01_REG_FIFO_STATUS 0x17 
+#define NRF24L01_REG_DYNPD 0x1C 
+#define NRF24L01_REG_FEATURE 0x1D 
+
+// Register bits 
+#define NRF24L01_REG_MASK_TX_DS 0x20        // CONFIG - no IRQ for data sent 
+#define NRF24L01_REG_MASK_MAX_RT 0x10       // CONFIG - no IRQ for retries used up 
+#define NRF24L01_REG_PRIM_RX 0x01           // CONFIG - receiver (PRX) 
+#define NRF24L01_REG_RX_DR 0x40             // STATUS - payload received 
+#define NRF24L01_REG_TX_DS 0x20             // STATUS - payload sent (and ACKed) 
+#define NRF24L01_REG_MAX_RT 0x10            // STATUS - retries used up 
+#define NRF24L01_REG_RX_P_NO 0x0E           // STATUS - pipe of the top RX payload 
+#define NRF24L01_REG_RX_P_NO_POS 1          // STATUS - RX_P_NO position 
+#define NRF24L01_REG_ARC_CNT 0x0F           // OBSERVE_TX - retransmits of the last payload 
+#define NRF24L01_REG_ARD_POS 4              // SETUP_RETR - retry delay position 
+#define NRF24L01_REG_RPD_SET 0x01           // RPD - received power above -64 dBm 
+#define NRF24L01_REG_TX_FULL 0x20           // FIFO_STATUS - TX FIFO full 
+#define NRF24L01_REG_TX_EMPTY 0x10          // FIFO_STATUS - TX FIFO empty 
+#define NRF24L01_REG_RX_EMPTY 0x01          // FIFO_STATUS - RX FIFO empty 
+#define NRF24L01_REG_PIPES 0x3F             // EN_AA/DYNPD - every pipe 
+#define NRF24L01_REG_ERX_P0 0x01            // EN_RXADDR - pipe 0 
+#define NRF24L01_REG_EN_DPL 0x04            // FEATURE - dynamic payload length 
+#define NRF24L01_REG_EN_ACK_PAY 0x02        // FEATURE - ACK payloads 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Read a register 
+ * 
+ * @param reg : register 
+ * @return uint8_t : register value 
+ */
+uint8_t nrf24l01_reg_read(uint8_t reg); 
+
+
+/**
+ * @brief Write a register 
+ * 
+ * @param reg : register 
+ * @param value : register value 
+ */
+void nrf24l01_reg_write(
+    uint8_t reg, 
+    uint8_t value); 
+
+
+/**
+ * @brief Send a command with data 
+ * 
+ * @details 'len' bytes from 'tx' follow the command and the bytes received for them are 
+ *          stored in 'rx'. Either buffer can be NULL (0xFF is sent if 'tx' is NULL). 
+ * 
+ * @param cmd : command 
+ * @param tx : data to send after the command 
+ * @param rx : data received after the command 
+ * @param len : data length 
+ * @return uint8_t : STATUS register (clocked out with the command) 
+ */
+uint8_t nrf24l01_reg_cmd(
+    uint8_t cmd, 
+    const uint8_t *tx, 
+    uint8_t *rx, 
+    uint8_t len); 
+
+
+/**
+ * @brief Set the radio enable (CE) pin 
+ * 
+ * @param level : GPIO_HIGH or GPIO_LOW 
+ */
+void nrf24l01_reg_ce(gpio_pin_state_t level); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _NRF24L01_REG_H_ 
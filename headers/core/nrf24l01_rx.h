@@ -0,0 +1,173 @@
+/**
+ * @file nrf24l01_rx.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Interrupt driven nRF24L01 receive interface 
+ * 
+ * @details The radio's IRQ pin goes low when a payload is received. It's wired to an 
+ *          EXTI line (falling edge) and the line's interrupt reads every payload out of 
+ *          the radio's 3 deep RX FIFO into a ring of payloads in RAM, each tagged with 
+ *          its data pipe and the system clock time (sys_time.h) of the interrupt. The 
+ *          main loop takes payloads from the ring with nrf24l01_rx_read, which doesn't 
+ *          touch SPI, so it can check for payloads on every pass instead of polling the 
+ *          radio's status on a timer. The line's event (NRF24L01_RX_EVENT) is set after 
+ *          the ring is written so payloads can also be waited on with the other events. 
+ * 
+ *          The interrupt uses the radio's SPI port so the main loop must not use the 
+ *          radio while the interrupt can run. Sends go through nrf24l01_rx_send and any 
+ *          other driver calls (ex. changing the RF channel) are wrapped in 
+ *          nrf24l01_rx_lock/nrf24l01_rx_unlock, which mask the line's interrupt. 
+ *          Payloads received while it's masked are read when it's unmasked. 
+ * 
+ *          If the ring is full the newest payload is dropped (and counted) so the 
+ *          radio's FIFO is still emptied and the IRQ pin is released. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _NRF24L01_RX_H_ 
+#define _NRF24L01_RX_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define NRF24L01_RX_SIZE 16                 // Payloads in the ring (power of 2) 
+#define NRF24L01_RX_FIFO_DEPTH 3            // Payloads the radio's RX FIFO holds 
+#define NRF24L01_RX_GPIO GPIOC              // IRQ pin GPIO port 
+#define NRF24L01_RX_PIN PIN_4               // IRQ pin number 
+#define NRF24L01_RX_PIN_MASK GPIOX_PIN_4    // IRQ pin read mask 
+#define NRF24L01_RX_EXTI_PORT EXTI_PC       // IRQ pin EXTI port 
+#define NRF24L01_RX_EXTI_LINE EXTI_L4       // IRQ pin EXTI line 
+#define NRF24L01_RX_IRQN EXTI4_IRQn         // IRQ pin EXTI interrupt 
+#define NRF24L01_RX_EVENT EVENT_EXTI4       // Set when payloads are added to the ring 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Received payload 
+typedef struct nrf24l01_rx_payload_s
+{
+    uint64_t time;                          // System clock time of the interrupt (us) 
+    uint8_t pipe;                           // Data pipe it was received on 
+    uint8_t data[NRF24L01_MAX_PAYLOAD_LEN]; // Payload 
+}
+nrf24l01_rx_payload_t; 
+
+
+// Receive statistics 
+typedef struct nrf24l01_rx_stats_s
+{
+    uint32_t received;                      // Payloads added to the ring 
+    uint32_t dropped;                       // Payloads dropped with the ring full 
+    uint32_t interrupts;                    // Times the ring was filled from the radio 
+    uint32_t empty;                         // Interrupts that found no payload 
+    uint8_t used_max;                       // Most payloads in the ring at once 
+}
+nrf24l01_rx_stats_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Initialize the interrupt driven receive path 
+ * 
+ * @details Configures the IRQ pin's EXTI line for a falling edge and enables its 
+ *          interrupt. The radio must already be initialized and powered up and the 
+ *          system clock started (sys_time_init). Payloads already in the radio's FIFO 
+ *          are read straight away. 
+ * 
+ * @param priority : EXTI interrupt priority 
+ */
+void nrf24l01_rx_init(uint8_t priority); 
+
+
+/**
+ * @brief Take the oldest payload from the ring 
+ * 
+ * @param payload : copy of the payload 
+ * @return uint8_t : TRUE if a payload was taken 
+ */
+uint8_t nrf24l01_rx_read(nrf24l01_rx_payload_t *payload); 
+
+
+/**
+ * @brief Payloads waiting in the ring 
+ * 
+ * @return uint8_t : number of payloads 
+ */
+uint8_t nrf24l01_rx_count(void); 
+
+
+/**
+ * @brief Send a payload with the receive interrupt masked 
+ * 
+ * @param payload : payload to send 
+ * @return NRF24L01_STATUS : status of the send (see nrf24l01_send_payload) 
+ */
+NRF24L01_STATUS nrf24l01_rx_send(const uint8_t *payload); 
+
+
+/**
+ * @brief Mask the receive interrupt before using the radio from the main loop 
+ * 
+ * @details Calls don't nest. Not called from interrupts. 
+ */
+void nrf24l01_rx_lock(void); 
+
+
+/**
+ * @brief Unmask the receive interrupt after using the radio from the main loop 
+ * 
+ * @details If the IRQ pin is low the interrupt is pended so payloads received while it 
+ *          was masked are read even if their edge was missed. 
+ */
+void nrf24l01_rx_unlock(void); 
+
+
+/**
+ * @brief Read the receive statistics 
+ * 
+ * @param stats : copy of the statistics 
+ */
+void nrf24l01_rx_stats(nrf24l01_rx_stats_t *stats); 
+
+
+/**
+ * @brief Interrupt handler hook - called from the IRQ pin's EXTI handler 
+ * 
+ * @details Reads payloads from the radio until its FIFO is empty (at most 
+ *          NRF24L01_RX_FIFO_DEPTH per call). Does nothing if the receive path isn't 
+ *          initialized. 
+ */
+void nrf24l01_rx_irq_handler(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _NRF24L01_RX_H_ 
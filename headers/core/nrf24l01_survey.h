@@ -0,0 +1,173 @@
+/**
+ * @file nrf24l01_survey.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief nRF24L01 RF channel survey interface 
+ * 
+ * @details Finds the quietest RF channel and moves both radios of a link to it. 
+ * 
+ *          A sweep listens on each of the radio's channels (0-125) long enough for the 
+ *          received power detector (RPD) to latch and counts the channels where it saw 
+ *          a signal above -64 dBm. Repeating the sweep builds an occupancy histogram, 
+ *          and the best channel is the one with the least activity on it and on its 
+ *          neighbours (NRF24L01_SURVEY_SPREAD channels each side), since Wi-Fi and 2 
+ *          Mbps links take up more than one channel. Only channels from 
+ *          NRF24L01_SURVEY_CH_MIN to NRF24L01_SURVEY_CH_MAX can be picked or proposed, 
+ *          which keeps the link inside the 2.400-2.4835 GHz ISM band by default, but the 
+ *          sweep covers every channel so neighbours above the band still count. A sweep 
+ *          takes about 
+ *          NRF24L01_SURVEY_CHANNELS * NRF24L01_SURVEY_DWELL_US so 32 sweeps take under 
+ *          a second. The receive interrupt is masked during a sweep. 
+ * 
+ *          Handshake: the initiator sends the new channel to the responder on the home 
+ *          channel (the one both start on) then changes channel and sends a 
+ *          confirmation there. The responder changes channel once it receives the new 
+ *          channel (its ACK has gone out by then) and goes back to the home channel if 
+ *          the confirmation doesn't arrive within NRF24L01_SURVEY_CONFIRM_US, which 
+ *          covers a lost ACK on either side. The initiator goes back to the home channel 
+ *          if the confirmation isn't acknowledged. Since the confirmation can arrive 
+ *          while every one of its ACKs is lost, the responder only stays once other link 
+ *          traffic arrives on the new channel and otherwise goes back to the home channel 
+ *          NRF24L01_SURVEY_TRAFFIC_US after the last confirmation. The initiator has to 
+ *          send within that time once the move succeeds. A completed move makes the new 
+ *          channel the home channel on both sides (the initiator once the confirmation 
+ *          is acknowledged, the responder once the traffic arrives) so the next 
+ *          handshake starts where both radios are. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _NRF24L01_SURVEY_H_ 
+#define _NRF24L01_SURVEY_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+#include "nrf24l01_rx.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define NRF24L01_SURVEY_CHANNELS 126        // RF channels (2400-2525 MHz) 
+#define NRF24L01_SURVEY_CH_MIN 0            // Lowest channel the link can move to 
+#define NRF24L01_SURVEY_CH_MAX 83           // Highest channel the link can move to (ISM) 
+#define NRF24L01_SURVEY_DWELL_US 170        // RX settling (130 us) + RPD delay (40 us) 
+#define NRF24L01_SURVEY_SPREAD 2            // Neighbour channels counted each side 
+#define NRF24L01_SURVEY_TRIES 20            // Handshake sends before giving up 
+#define NRF24L01_SURVEY_CONFIRM_US 500000   // Responder wait for the confirmation (us) 
+#define NRF24L01_SURVEY_TRAFFIC_US 1000000  // Responder wait for traffic after it (us) 
+
+// Handshake payload: tag, step, channel 
+#define NRF24L01_SURVEY_TAG 0xB4 
+#define NRF24L01_SURVEY_CHANGE 0x01         // Step 1 - change to the channel (home) 
+#define NRF24L01_SURVEY_CONFIRM 0x02        // Step 2 - channel confirmed (new channel) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Occupancy histogram 
+typedef struct nrf24l01_survey_s
+{
+    uint16_t sweeps;                                // Sweeps done 
+    uint16_t hits[NRF24L01_SURVEY_CHANNELS];        // Sweeps with RPD set on each channel 
+}
+nrf24l01_survey_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Clear the histogram and set the home channel 
+ * 
+ * @param home : channel both radios start on and go back to if the handshake fails - 
+ *               becomes the new channel after each completed move 
+ */
+void nrf24l01_survey_init(uint8_t home); 
+
+
+/**
+ * @brief Listen on every channel once and add the result to the histogram 
+ * 
+ * @details The radio is left on the channel it was on in receive mode. 
+ */
+void nrf24l01_survey_sweep(void); 
+
+
+/**
+ * @brief Quietest channel in the histogram 
+ * 
+ * @return uint8_t : channel (NRF24L01_SURVEY_CH_MIN - NRF24L01_SURVEY_CH_MAX) with the 
+ *                   fewest hits on it and its neighbours 
+ */
+uint8_t nrf24l01_survey_best(void); 
+
+
+/**
+ * @brief Copy the histogram 
+ * 
+ * @param survey : histogram copy 
+ */
+void nrf24l01_survey_get(nrf24l01_survey_t *survey); 
+
+
+/**
+ * @brief Move both radios to a channel (initiator) 
+ * 
+ * @details Blocks for up to 2 * NRF24L01_SURVEY_TRIES sends. After a move the link 
+ *          has to carry traffic within NRF24L01_SURVEY_TRAFFIC_US or the responder goes 
+ *          back to the home channel. 
+ * 
+ * @param channel : new channel (NRF24L01_SURVEY_CH_MIN - NRF24L01_SURVEY_CH_MAX) 
+ * @return uint8_t : TRUE if both radios are on the new channel (now the home channel), 
+ *                   FALSE if back home or the channel is out of range 
+ */
+uint8_t nrf24l01_survey_propose(uint8_t channel); 
+
+
+/**
+ * @brief Handle a payload taken from the receive ring (responder) 
+ * 
+ * @details Every payload from the initiator is passed in, not only handshake payloads, 
+ *          since other traffic on the new channel is what completes a move. 
+ * 
+ * @param payload : received payload 
+ * @return uint8_t : TRUE if it was a handshake payload 
+ */
+uint8_t nrf24l01_survey_accept(const nrf24l01_rx_payload_t *payload); 
+
+
+/**
+ * @brief Go home if the confirmation or the traffic after it is late (responder) 
+ * 
+ * @details Called from the main loop. 
+ * 
+ * @return uint8_t : TRUE if the radio went back to the home channel 
+ */
+uint8_t nrf24l01_survey_update(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _NRF24L01_SURVEY_H_ 
@@ -0,0 +1,226 @@
+/**
+ * @file rc_frame.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Binary remote control frame interface 
+ * 
+ * @details Carries the throttle of both thrusters in one radio payload in place of one 
+ *          ASCII message per thruster. The frame is written straight into the payload 
+ *          buffer and read straight out of the received payload (little endian): 
+ * 
+ *            | tag + version | sequence | flags | right (int16) | left (int16) | CRC-8 | 
+ * 
+ *          The first byte has the top bit set so an ASCII message is never taken as a 
+ *          frame, and a frame from a different version is rejected. The CRC-8 
+ *          (polynomial 0x07) covers every byte before it. The rest of the payload isn't 
+ *          used. 
+ * 
+ *          The sequence number goes up by one with each frame sent. The receiver 
+ *          (rc_frame_rx_update) counts the frames missing from gaps in the sequence and 
+ *          drops frames that are older than the last one used. 
+ * 
+ *          Telemetry goes the other way in its own frame, sent by the receiver in the 
+ *          ACK of each payload it receives (nrf24l01_ack.h): 
+ * 
+ *            | tag + version | last sequence | link | battery | heading | lost | CRC-8 | 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _RC_FRAME_H_ 
+#define _RC_FRAME_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define RC_FRAME_TAG 0xC0                   // Frame tag (top of the first byte) 
+#define RC_FRAME_VERSION 1                  // Frame version (bottom of the first byte) 
+#define RC_FRAME_LEN 8                      // Frame length (bytes) 
+#define RC_FRAME_CRC_POLY 0x07              // CRC-8 polynomial 
+#define RC_FRAME_RESYNC 4                   // Old frames in a row before starting over 
+#define RC_FRAME_TELEM_TAG 0xA0             // Telemetry frame tag 
+#define RC_FRAME_TELEM_LEN 10               // Telemetry frame length (bytes) 
+
+// Flags 
+#define RC_FRAME_FLAG_STOP 0x01             // Stop the thrusters (ex. sender failsafe) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+// Thrusters 
+typedef enum {
+    RC_FRAME_RIGHT,                         // Right thruster 
+    RC_FRAME_LEFT,                          // Left thruster 
+    RC_FRAME_THRUSTERS                      // Number of thrusters 
+} rc_frame_thruster_t; 
+
+
+// Decode status 
+typedef enum {
+    RC_FRAME_OK,                            // Valid frame 
+    RC_FRAME_BAD_TAG,                       // Not a frame or a different version 
+    RC_FRAME_BAD_CRC                        // Frame is corrupted 
+} rc_frame_status_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Frame contents 
+typedef struct rc_frame_s
+{
+    uint8_t seq;                            // Sequence number 
+    uint8_t flags;                          // RC_FRAME_FLAG_x 
+    int16_t throttle[RC_FRAME_THRUSTERS];   // Throttle of each thruster 
+}
+rc_frame_t; 
+
+
+// Receiver sequence tracking - zeroed before first use 
+typedef struct rc_frame_rx_s
+{
+    uint8_t next;                           // Next sequence number expected 
+    uint8_t synced;                         // A frame has been received 
+    uint8_t old;                            // Old frames in a row 
+    uint32_t frames;                        // Frames used 
+    uint32_t lost;                          // Frames missing from sequence gaps 
+    uint32_t old_total;                     // Frames dropped for being old (ex. repeats) 
+    uint32_t bad;                           // Payloads that weren't a valid frame 
+}
+rc_frame_rx_t; 
+
+
+// Telemetry frame contents 
+typedef struct rc_frame_telem_s
+{
+    uint8_t seq;                            // Sequence number of the last frame used 
+    uint8_t link;                           // Frames received recently (%) - RSSI proxy 
+    uint16_t battery;                       // Battery voltage (mV) 
+    uint16_t heading;                       // Heading (0.1 degrees) 
+    uint16_t lost;                          // Frames lost (saturates) 
+}
+rc_frame_telem_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Write a frame into a payload buffer 
+ * 
+ * @param payload : payload buffer (at least RC_FRAME_LEN bytes) 
+ * @param frame : frame contents 
+ * @return uint8_t : frame length 
+ */
+uint8_t rc_frame_encode(
+    uint8_t *payload, 
+    const rc_frame_t *frame); 
+
+
+/**
+ * @brief Read a frame out of a received payload 
+ * 
+ * @param payload : received payload (at least RC_FRAME_LEN bytes) 
+ * @param frame : frame contents - only written if the frame is valid 
+ * @return rc_frame_status_t : decode status 
+ */
+rc_frame_status_t rc_frame_decode(
+    const uint8_t *payload, 
+    rc_frame_t *frame); 
+
+
+/**
+ * @brief Write a telemetry frame into a payload buffer 
+ * 
+ * @param payload : payload buffer (at least RC_FRAME_TELEM_LEN bytes) 
+ * @param telem : telemetry frame contents 
+ * @return uint8_t : frame length 
+ */
+uint8_t rc_frame_telem_encode(
+    uint8_t *payload, 
+    const rc_frame_telem_t *telem); 
+
+
+/**
+ * @brief Read a telemetry frame out of a received payload 
+ * 
+ * @param payload : received payload (at least RC_FRAME_TELEM_LEN bytes) 
+ * @param telem : telemetry frame contents - only written if the frame is valid 
+ * @return rc_frame_status_t : decode status 
+ */
+rc_frame_status_t rc_frame_telem_decode(
+    const uint8_t *payload, 
+    rc_frame_telem_t *telem); 
+
+
+/**
+ * @brief Decode a received payload and check its sequence number 
+ * 
+ * @details A frame older than the last one used is dropped. After RC_FRAME_RESYNC old 
+ *          frames in a row (ex. the sender restarted) the sequence starts over from the 
+ *          last of them. The counts in 'rx' are updated. 
+ * 
+ * @param rx : receiver sequence tracking 
+ * @param payload : received payload 
+ * @param frame : frame contents - only written if the frame is used 
+ * @return uint8_t : TRUE if the frame is valid and newer than the last one used 
+ */
+uint8_t rc_frame_rx_update(
+    rc_frame_rx_t *rx, 
+    const uint8_t *payload, 
+    rc_frame_t *frame); 
+
+
+/**
+ * @brief Start the sequence over - the next valid frame is used 
+ * 
+ * @param rx : receiver sequence tracking 
+ */
+static inline void rc_frame_rx_resync(rc_frame_rx_t *rx)
+{
+    rx->synced = CLEAR; 
+}
+
+
+/**
+ * @brief CRC-8 of a block of data 
+ * 
+ * @param data : data 
+ * @param len : data length 
+ * @return uint8_t : CRC (polynomial RC_FRAME_CRC_POLY, initial value 0) 
+ */
+uint8_t rc_frame_crc8(
+    const uint8_t *data, 
+    uint8_t len); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _RC_FRAME_H_ 
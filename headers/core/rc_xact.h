@@ -0,0 +1,264 @@
+/**
+ * @file rc_xact.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Radio request/response transaction engine interface 
+ * 
+ * @details A transaction sends a request payload and waits for a response without 
+ *          blocking. rc_xact_poll is called from the main loop: it reads the radio, 
+ *          matches payloads to the transaction in flight and sends the request again 
+ *          if no response is seen within the engine's timeout, up to a number of 
+ *          attempts. The transaction's callback runs from rc_xact_poll when it's done, 
+ *          with the response or a timeout. A callback can start the next transaction of 
+ *          a multi-step exchange (ex. a request followed by its data). 
+ * 
+ *          The radio is half duplex and responses carry no transaction ID, so one 
+ *          transaction is in flight at a time. Others are queued in the order they were 
+ *          requested. Payloads that don't answer the transaction in flight (ex. 
+ *          requests from the other device) go to the engine's receive callback. 
+ * 
+ *          Timeouts run on the hardware timer wheel (timer_wheel.h), which must be 
+ *          started first. The radio is reached through a link (send and receive 
+ *          functions) so the engine can be run against a simulated peer (see 
+ *          rc_xact_test.h). 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _RC_XACT_H_ 
+#define _RC_XACT_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+#include "timer_wheel.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define RC_XACT_PAYLOAD_LEN 32              // Radio payload size (bytes) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+// Transaction state 
+typedef enum {
+    RC_XACT_IDLE,                           // Not requested or finished 
+    RC_XACT_QUEUED,                         // Waiting for the transaction in flight 
+    RC_XACT_WAITING                         // Request sent, waiting for the response 
+} rc_xact_state_t; 
+
+
+// Transaction result 
+typedef enum {
+    RC_XACT_OK,                             // Response received 
+    RC_XACT_TIMEOUT,                        // No response after every attempt 
+    RC_XACT_CANCELLED                       // Cancelled with rc_xact_cancel 
+} rc_xact_result_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+typedef struct rc_xact_s rc_xact_t; 
+
+
+/**
+ * @brief Transaction done callback - runs from rc_xact_poll (or rc_xact_cancel) 
+ * 
+ * @details 'response' is the payload that answered the request (RC_XACT_OK) or NULL. 
+ *          The transaction can be requested again from its own callback. 
+ */
+typedef void (*rc_xact_callback_t)(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response); 
+
+
+// Transaction - owned by the user, zeroed before first use 
+struct rc_xact_s
+{
+    rc_xact_t *next;                        // Queue link 
+    uint8_t request[RC_XACT_PAYLOAD_LEN];   // Payload sent 
+    const uint8_t *response;                // Expected response (NULL for any) 
+    uint8_t response_len;                   // Bytes of the response to match 
+    uint8_t attempts;                       // Sends so far 
+    rc_xact_callback_t callback;            // Called when done (NULL for none) 
+    void *arg;                              // User data for the callback 
+    volatile uint8_t state;                 // Transaction state (rc_xact_state_t) 
+}; 
+
+
+// Radio link 
+typedef struct rc_xact_link_s
+{
+    uint8_t (*send)(const uint8_t *payload);    // Send a payload - TRUE if sent 
+    uint8_t (*receive)(uint8_t *payload);       // Read a payload - TRUE if one was read 
+}
+rc_xact_link_t; 
+
+
+// Payloads that don't answer the transaction in flight 
+typedef void (*rc_xact_receive_t)(const uint8_t *payload); 
+
+
+// Engine statistics 
+typedef struct rc_xact_stats_s
+{
+    uint32_t sent;                          // Requests sent (first attempts) 
+    uint32_t retries;                       // Requests sent again after a timeout 
+    uint32_t send_fails;                    // Sends the link reported as failed 
+    uint32_t completed;                     // Transactions with a response 
+    uint32_t timeouts;                      // Transactions with no response 
+    uint32_t unmatched;                     // Payloads passed to the receive callback 
+}
+rc_xact_stats_t; 
+
+
+// Engine 
+typedef struct rc_xact_engine_s
+{
+    rc_xact_link_t link;                    // Radio link 
+    rc_xact_receive_t receive;              // Other payloads (NULL to drop them) 
+    uint32_t timeout;                       // Time to wait for each response (us) 
+    uint8_t attempts;                       // Sends before a transaction times out 
+    rc_xact_t *head;                        // Transaction in flight (queue head) 
+    rc_xact_t *tail;                        // Last queued transaction 
+    twheel_timer_t timer;                   // Response timeout 
+    uint8_t buff[RC_XACT_PAYLOAD_LEN];      // Received payload 
+    rc_xact_stats_t stats;                  // Engine statistics 
+}
+rc_xact_engine_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Initialize an engine 
+ * 
+ * @details Transactions still queued on the engine are cancelled (callback called with 
+ *          RC_XACT_CANCELLED) once it's reset. The engine must be zeroed (ex. static) 
+ *          before it's first initialized. 
+ * 
+ * @param engine : engine to initialize 
+ * @param link : radio link 
+ * @param receive : callback for payloads that don't answer a transaction (NULL for none) 
+ * @param timeout : time to wait for each response (us) 
+ * @param attempts : sends of a request before it times out (at least 1) 
+ */
+void rc_xact_init(
+    rc_xact_engine_t *engine, 
+    const rc_xact_link_t *link, 
+    rc_xact_receive_t receive, 
+    uint32_t timeout, 
+    uint8_t attempts); 
+
+
+/**
+ * @brief Request a transaction 
+ * 
+ * @details The request is copied into the transaction and the rest of the payload is 
+ *          zeroed. It's sent straight away if no other transaction is in flight, 
+ *          otherwise when the ones before it are done. The expected response isn't 
+ *          copied so it must stay valid until the transaction is done. 
+ * 
+ * @param engine : engine 
+ * @param xact : transaction 
+ * @param request : request payload 
+ * @param request_len : request length (up to RC_XACT_PAYLOAD_LEN) 
+ * @param response : expected start of the response (NULL to take any payload) 
+ * @param response_len : bytes of the response to match 
+ * @param callback : called when the transaction is done (NULL for none) 
+ * @param arg : user data for the callback 
+ * @return uint8_t : TRUE if requested, FALSE if the transaction is already requested 
+ */
+uint8_t rc_xact_request(
+    rc_xact_engine_t *engine, 
+    rc_xact_t *xact, 
+    const void *request, 
+    uint8_t request_len, 
+    const void *response, 
+    uint8_t response_len, 
+    rc_xact_callback_t callback, 
+    void *arg); 
+
+
+/**
+ * @brief Cancel a transaction 
+ * 
+ * @details The callback is called with RC_XACT_CANCELLED. A response to a cancelled 
+ *          request that arrives later goes to the receive callback. Does nothing if the 
+ *          transaction isn't requested on this engine. 
+ * 
+ * @param engine : engine 
+ * @param xact : transaction 
+ */
+void rc_xact_cancel(
+    rc_xact_engine_t *engine, 
+    rc_xact_t *xact); 
+
+
+/**
+ * @brief Run the engine - called from the main loop 
+ * 
+ * @details Reads the radio, finishes the transaction in flight if it's answered or out 
+ *          of attempts, sends requests again after a timeout and starts the next queued 
+ *          transaction. Never waits. The radio isn't read while the engine is idle and 
+ *          has no receive callback. 
+ * 
+ * @param engine : engine 
+ */
+void rc_xact_poll(rc_xact_engine_t *engine); 
+
+
+/**
+ * @brief Check if a transaction is queued or in flight 
+ * 
+ * @param xact : transaction 
+ * @return uint8_t : TRUE if the transaction isn't done 
+ */
+static inline uint8_t rc_xact_busy(const rc_xact_t *xact)
+{
+    return xact->state != RC_XACT_IDLE; 
+}
+
+
+/**
+ * @brief Check if an engine has any transactions 
+ * 
+ * @param engine : engine 
+ * @return uint8_t : TRUE if a transaction is queued or in flight 
+ */
+static inline uint8_t rc_xact_engine_busy(const rc_xact_engine_t *engine)
+{
+    return engine->head != NULL; 
+}
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _RC_XACT_H_ 
@@ -0,0 +1,182 @@
+/**
+ * @file sd_log.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief SD card logging engine interface 
+ * 
+ * @details Records are copied into a ring of SD_LOG_BUFFS RAM buffers of 
+ *          SD_LOG_BUFF_SIZE bytes (a whole number of sectors) and each full buffer is 
+ *          written to the file with a single f_write. Since the writes are whole, 
+ *          sector aligned sectors FatFs sends them straight to the card as one 
+ *          multi-sector write instead of going through its sector window with a read 
+ *          of the partial sector first. If the file doesn't start on a sector boundary 
+ *          (ex. opened to append) the first buffer is cut short so the rest line up. 
+ * 
+ *          Appending a record (sd_log_write) only copies it into the buffer being 
+ *          filled so it can be done from an interrupt, such as a sampling timer. A 
+ *          record that fills a buffer carries on into the next one. If every buffer is 
+ *          full or waiting to be written the whole record is dropped and counted. 
+ *          Records come from one context at a time (one interrupt or the main loop). 
+ * 
+ *          Full buffers are written by sd_log_service from the main loop, one per call 
+ *          so the loop is held up for at most one buffer write at a time. The file is 
+ *          synced (f_sync) after every 'sync_every' buffers so at most that much data 
+ *          is lost if power goes. The time taken by each f_write and f_sync is kept 
+ *          along with the write rate since the log was opened. 
+ * 
+ *          Contiguous files (sd_log_open_contig): a file growing one cluster at a time 
+ *          has FatFs follow and extend the cluster chain and update the FAT as it's 
+ *          written, which shows up as write time spikes. Instead the file's space is 
+ *          allocated up front as one run of clusters (f_expand, needs _USE_EXPAND in 
+ *          ffconf.h) and buffers are written straight to its sectors with disk_write, 
+ *          so every write costs the same. Each sync writes the size logged so far to 
+ *          the directory entry. sd_log_close gives back the unused space. If power goes 
+ *          before then the file has the data up to the last sync and the rest of the 
+ *          space stays allocated (a disk check frees it). 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _SD_LOG_H_ 
+#define _SD_LOG_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SD_LOG_SECTOR 512                   // Card sector size (bytes) 
+#define SD_LOG_BUFF_SECTORS 8               // Sectors per buffer 
+#define SD_LOG_BUFF_SIZE (SD_LOG_SECTOR * SD_LOG_BUFF_SECTORS)   // Buffer size (bytes) 
+#define SD_LOG_BUFFS 4                      // Buffers in the ring (2 or more) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Logging statistics 
+typedef struct sd_log_stats_s
+{
+    uint32_t records;                       // Records appended 
+    uint32_t dropped;                       // Records dropped (no free buffer) 
+    uint32_t dropped_bytes;                 // Bytes of the dropped records 
+    uint32_t buffers;                       // Buffers written 
+    uint32_t syncs;                         // File syncs 
+    uint32_t errors;                        // Failed or short f_write and f_sync calls 
+    uint32_t bytes;                         // Bytes written to the file 
+    uint32_t write_avg_us;                  // Average buffer write (us) 
+    uint32_t write_max_us;                  // Longest buffer write (us) 
+    uint32_t sync_max_us;                   // Longest sync (us) 
+    uint32_t rate;                          // Bytes written per second since opened 
+    uint8_t waiting_max;                    // Most full buffers waiting at once 
+}
+sd_log_stats_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Start logging to a file 
+ * 
+ * @details The file must be open for writing and stay open until sd_log_close. Records 
+ *          are added at the file's read/write pointer. The statistics are cleared. 
+ *          Needs the system clock (sys_time_init) for the timings. 
+ * 
+ * @param file : open file 
+ * @param sync_every : buffers written between syncs (0 to sync on close only) 
+ * @return uint8_t : TRUE if started, FALSE if a log is already open 
+ */
+uint8_t sd_log_open(
+    FIL *file, 
+    uint16_t sync_every); 
+
+
+/**
+ * @brief Start logging to a file with its space allocated up front 
+ * 
+ * @details The file must be open for writing and empty. A log that outgrows the space 
+ *          counts the buffers it can't write as errors. The file must not be written 
+ *          by anything else until sd_log_close. 
+ * 
+ * @param file : open, empty file 
+ * @param size : space to allocate (bytes, rounded up to whole sectors) 
+ * @param sync_every : buffers written between syncs (0 to sync on close only) 
+ * @return uint8_t : TRUE if started, FALSE if the space couldn't be allocated in one 
+ *                   run, a log is already open or _USE_EXPAND is off 
+ */
+uint8_t sd_log_open_contig(
+    FIL *file, 
+    FSIZE_t size, 
+    uint16_t sync_every); 
+
+
+/**
+ * @brief Append a record 
+ * 
+ * @details Copies the record into the buffers. Can be called from an interrupt. 
+ * 
+ * @param data : record 
+ * @param len : record size (bytes, up to SD_LOG_BUFF_SIZE) 
+ * @return uint8_t : TRUE if appended, FALSE if dropped or no log is open 
+ */
+uint8_t sd_log_write(
+    const void *data, 
+    uint16_t len); 
+
+
+/**
+ * @brief Write the oldest full buffer to the file 
+ * 
+ * @details Called from the main loop. Syncs the file if it's time. 
+ * 
+ * @return uint8_t : TRUE if a buffer was written, FALSE if none were waiting 
+ */
+uint8_t sd_log_service(void); 
+
+
+/**
+ * @brief Write everything left and stop logging 
+ * 
+ * @details Records must have stopped coming. The partly filled buffer and any full 
+ *          ones are written, a contiguous file is cut down to the logged size and the 
+ *          file is synced. The file is left open. 
+ * 
+ * @return uint8_t : TRUE if there were no write or sync errors while the log was open 
+ */
+uint8_t sd_log_close(void); 
+
+
+/**
+ * @brief Read the logging statistics 
+ * 
+ * @param stats : copy of the statistics 
+ */
+void sd_log_get_stats(sd_log_stats_t *stats); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _SD_LOG_H_ 
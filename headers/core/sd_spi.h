@@ -0,0 +1,236 @@
+/**
+ * @file sd_spi.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief SD card SPI block driver with DMA data transfers interface 
+ * 
+ * @details Reads and writes SD card sectors over SPI for FatFs (sd_spi_driver) as an 
+ *          alternative to the HW125 driver, which moves every byte with a polled SPI 
+ *          transfer. 
+ * 
+ *          The card is brought up at a slow clock (SD_SPI_BR_INIT, under the 400 kHz the 
+ *          card allows before it's ready) and the clock is then stepped up to 
+ *          SD_SPI_BR_FAST. Commands and responses are a few bytes each and stay polled. 
+ *          The 512 byte data blocks are moved by the SPI's RX and TX DMA streams. For 
+ *          reads the TX stream clocks out 0xFF, and for writes the RX stream throws the 
+ *          received bytes away. More than one sector goes as a single multi-block 
+ *          command (CMD18/CMD25) so there's one command and one busy period for the 
+ *          whole run instead of one per sector. Before a multi-block write SD cards are 
+ *          told how many blocks are coming (ACMD23) so they can erase them up front. 
+ * 
+ *          The calls still return once the data is moved, like FatFs expects, but the 
+ *          CPU isn't needed while a block transfers or the card is busy. Whenever the 
+ *          driver waits it calls the idle callback (sd_spi_set_idle) so the main loop's 
+ *          control code can run. Interrupts run as normal. The DMA can be turned off 
+ *          (sd_spi_set_dma) to compare against polled data transfers. 
+ * 
+ *          Data buffers must be in SRAM for the DMA. The SPI and slave select pin must be 
+ *          set up (spi_init and spi_ss_init) before sd_spi_init, and the system clock 
+ *          (sys_time_init) is used for the timeouts. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _SD_SPI_H_ 
+#define _SD_SPI_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Hardware 
+#define SD_SPI_SPI SPI2                     // Card SPI port 
+#define SD_SPI_SS_GPIO GPIOB                // Card slave select pin GPIO port 
+#define SD_SPI_SS_PIN GPIOX_PIN_12          // Card slave select pin 
+#define SD_SPI_DMA DMA1                     // DMA controller of the SPI streams 
+#define SD_SPI_RX_STREAM DMA1_Stream3       // SPI2 RX stream 
+#define SD_SPI_TX_STREAM DMA1_Stream4       // SPI2 TX stream 
+#define SD_SPI_CHNL DMA_CHNL_0              // SPI2 RX and TX channel 
+
+// Clock - SPI baud rate divider fPCLK / 2^(BR + 1) 
+#define SD_SPI_BR_INIT 6                    // Card init: 42 MHz / 128 = 328 kHz 
+#define SD_SPI_BR_FAST 0                    // After init: 42 MHz / 2 = 21 MHz 
+
+// Timeouts (us) 
+#define SD_SPI_INIT_US 1000000              // Card to finish initializing (ACMD41) 
+#define SD_SPI_TOKEN_US 200000              // Read data token 
+#define SD_SPI_BUSY_US 500000               // Card busy after a write 
+
+#define SD_SPI_SECTOR 512                   // Sector size (bytes) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+// Result 
+typedef enum {
+    SD_SPI_OK,                              // Done 
+    SD_SPI_NOT_READY,                       // Card not initialized 
+    SD_SPI_PARAM,                           // Sectors outside the card 
+    SD_SPI_TIMEOUT,                         // Card didn't answer in time 
+    SD_SPI_ERROR                            // Card rejected a command or the data 
+} sd_spi_status_t; 
+
+
+// Card type 
+typedef enum {
+    SD_SPI_CT_NONE,                         // No card or not initialized 
+    SD_SPI_CT_MMC,                          // MMC version 3 
+    SD_SPI_CT_SDC1,                         // SD version 1 
+    SD_SPI_CT_SDC2_BYTE,                    // SD version 2 byte addressed 
+    SD_SPI_CT_SDC2_BLOCK                    // SD version 2 block addressed (SDHC/SDXC) 
+} sd_spi_card_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Driver statistics 
+typedef struct sd_spi_stats_s
+{
+    uint32_t reads;                         // Read commands 
+    uint32_t writes;                        // Write commands 
+    uint32_t sectors_read;                  // Sectors read 
+    uint32_t sectors_written;               // Sectors written 
+    uint32_t errors;                        // Rejected commands and data 
+    uint32_t timeouts;                      // Commands the card didn't finish in time 
+    uint32_t busy_max_us;                   // Longest wait for the card after a write 
+}
+sd_spi_stats_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Variables 
+
+extern Diskio_drvTypeDef sd_spi_driver;     // FatFs disk driver 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Initialize the card 
+ * 
+ * @details Sets up the DMA streams, brings the card up at the init clock, reads its 
+ *          size and switches to the fast clock. The statistics are cleared. 
+ * 
+ * @return sd_spi_status_t : SD_SPI_OK if the card is ready 
+ */
+sd_spi_status_t sd_spi_init(void); 
+
+
+/**
+ * @brief Read sectors 
+ * 
+ * @param buff : buffer for count * SD_SPI_SECTOR bytes 
+ * @param sector : first sector 
+ * @param count : number of sectors 
+ * @return sd_spi_status_t : SD_SPI_OK if every sector was read 
+ */
+sd_spi_status_t sd_spi_read(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint32_t count); 
+
+
+/**
+ * @brief Write sectors 
+ * 
+ * @details Returns once the card has taken the last sector. The card may still be 
+ *          programming it - sd_spi_sync waits for it to finish. 
+ * 
+ * @param buff : count * SD_SPI_SECTOR bytes 
+ * @param sector : first sector 
+ * @param count : number of sectors 
+ * @return sd_spi_status_t : SD_SPI_OK if every sector was accepted 
+ */
+sd_spi_status_t sd_spi_write(
+    const uint8_t *buff, 
+    uint32_t sector, 
+    uint32_t count); 
+
+
+/**
+ * @brief Wait for the card to finish writing 
+ * 
+ * @return sd_spi_status_t : SD_SPI_OK if the card isn't busy 
+ */
+sd_spi_status_t sd_spi_sync(void); 
+
+
+/**
+ * @brief Card type 
+ * 
+ * @return sd_spi_card_t : type found by sd_spi_init 
+ */
+sd_spi_card_t sd_spi_get_card_type(void); 
+
+
+/**
+ * @brief Card size 
+ * 
+ * @return uint32_t : number of sectors (0 if not initialized) 
+ */
+uint32_t sd_spi_get_sectors(void); 
+
+
+/**
+ * @brief Turn the DMA data transfers on or off 
+ * 
+ * @details With the DMA off the data is moved a byte at a time like the HW125 driver. 
+ *          The DMA is on after sd_spi_init. 
+ * 
+ * @param enable : TRUE to use the DMA 
+ */
+void sd_spi_set_dma(uint8_t enable); 
+
+
+/**
+ * @brief Set the function called while the driver waits 
+ * 
+ * @details Called repeatedly during DMA transfers and while the card is busy. It must 
+ *          not use the card. 
+ * 
+ * @param idle : idle callback (NULL for none) 
+ */
+void sd_spi_set_idle(void (*idle)(void)); 
+
+
+/**
+ * @brief Read the driver statistics 
+ * 
+ * @param stats : copy of the statistics 
+ */
+void sd_spi_get_stats(sd_spi_stats_t *stats); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _SD_SPI_H_ 
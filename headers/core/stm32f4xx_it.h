@@ -29,63 +29,72 @@ extern "C" {
 
 
 //=======================================================================================
-// Globals 
+// Data types 
+
+// Interrupt events - one bit each in the event word 
+typedef enum {
+    // EXTI interrupts 
+    EVENT_EXTI0,                                   // Line 0 
+    EVENT_EXTI1,                                   // Line 1 
+    EVENT_EXTI2,                                   // Line 2 
+    EVENT_EXTI3,                                   // Line 3 
+    EVENT_EXTI4,                                   // Line 4 
+    EVENT_EXTI5_9,                                 // Lines 5-9 
+    EVENT_EXTI10_15,                               // Lines 10-15 
+
+    // DMA1 interrupts 
+    EVENT_DMA1_0,                                  // Stream 0 
+    EVENT_DMA1_1,                                  // Stream 1 
+    EVENT_DMA1_2,                                  // Stream 2 
+    EVENT_DMA1_3,                                  // Stream 3 
+    EVENT_DMA1_4,                                  // Stream 4 
+    EVENT_DMA1_5,                                  // Stream 5 
+    EVENT_DMA1_6,                                  // Stream 6 
+    EVENT_DMA1_7,                                  // Stream 7 
+
+    // DMA2 interrupts 
+    EVENT_DMA2_0,                                  // Stream 0 
+    EVENT_DMA2_1,                                  // Stream 1 
+    EVENT_DMA2_2,                                  // Stream 2 
+    EVENT_DMA2_3,                                  // Stream 3 
+    EVENT_DMA2_4,                                  // Stream 4 
+    EVENT_DMA2_5,                                  // Stream 5 
+    EVENT_DMA2_6,                                  // Stream 6 
+    EVENT_DMA2_7,                                  // Stream 7 
+
+    // Timer interrupts 
+    EVENT_TIM1_BRK_TIM9,                           // TIM1 break + TIM9 global 
+    EVENT_TIM1_UP_TIM10,                           // TIM1 update + TIM10 global 
+    EVENT_TIM1_TRG_TIM11,                          // TIM1 trigger + TIM11 global 
+    EVENT_TIM1_CC,                                 // TIM1 capture compare 
+    EVENT_TIM2,                                    // TIM2 global 
+    EVENT_TIM3,                                    // TIM3 global 
+    EVENT_TIM4,                                    // TIM4 global 
+    EVENT_TIM5,                                    // TIM5 global 
+
+    // ADC interrupts 
+    EVENT_ADC,                                     // ADC1 global 
+
+    // USART interrupts 
+    EVENT_USART1,                                  // USART1 global 
+    EVENT_USART2,                                  // USART2 global 
+    EVENT_USART6,                                  // USART6 global 
+
+    EVENT_NUM                                      // Number of events 
+} event_id_t; 
+
+
+// Event bit mask - bit n is set for event n 
+typedef uint64_t event_mask_t; 
 
-// Interrupt flag data record 
-typedef struct int_handle_flags_s
-{
-    // EXTI interrupt flags 
-    uint8_t exti0_flag     : 1;                    // Line 0 
-    uint8_t exti1_flag     : 1;                    // Line 1 
-    uint8_t exti2_flag     : 1;                    // Line 2 
-    uint8_t exti3_flag     : 1;                    // Line 3 
-    uint8_t exti4_flag     : 1;                    // Line 4 
-    uint8_t exti5_9_flag   : 1;                    // Lines 5-9  
-    uint8_t exti10_15_flag : 1;                    // Lines 10-15 
-
-    // DMA1 interrupt flags 
-    uint8_t dma1_0_flag : 1;                       // Stream 0 
-    uint8_t dma1_1_flag : 1;                       // Stream 1 
-    uint8_t dma1_2_flag : 1;                       // Stream 2 
-    uint8_t dma1_3_flag : 1;                       // Stream 3 
-    uint8_t dma1_4_flag : 1;                       // Stream 4 
-    uint8_t dma1_5_flag : 1;                       // Stream 5 
-    uint8_t dma1_6_flag : 1;                       // Stream 6 
-    uint8_t dma1_7_flag : 1;                       // Stream 7 
-
-    // DMA2 interrupt flags 
-    uint8_t dma2_0_flag : 1;                       // Stream 0 
-    uint8_t dma2_1_flag : 1;                       // Stream 1 
-    uint8_t dma2_2_flag : 1;                       // Stream 2 
-    uint8_t dma2_3_flag : 1;                       // Stream 3 
-    uint8_t dma2_4_flag : 1;                       // Stream 4 
-    uint8_t dma2_5_flag : 1;                       // Stream 5 
-    uint8_t dma2_6_flag : 1;                       // Stream 6 
-    uint8_t dma2_7_flag : 1;                       // Stream 7 
-
-    // Timer interrupt flags 
-    uint8_t tim1_brk_tim9_glbl_flag  : 1;          // TIM1 break + TIM9 global 
-    uint8_t tim1_up_tim10_glbl_flag  : 1;          // TIM1 update + TIM10 global 
-    uint8_t tim1_trg_tim11_glbl_flag : 1;          // TIM1 trigger + TIM11 global 
-    uint8_t tim1_cc_flag             : 1;          // TIM1 capture compare 
-    uint8_t tim2_glbl_flag           : 1;          // TIM2 global 
-    uint8_t tim3_glbl_flag           : 1;          // TIM3 global 
-    uint8_t tim4_glbl_flag           : 1;          // TIM4 global 
-    uint8_t tim5_glbl_flag           : 1;          // TIM5 global 
-
-    // ADC interrupt flags 
-    uint8_t adc_flag: 1; 
-
-    // USART interrupt flags 
-    uint8_t usart1_flag : 1;                       // USART1 global 
-    uint8_t usart2_flag : 1;                       // USART2 global 
-    uint8_t usart6_flag : 1;                       // USART6 global 
-} 
-int_handle_flags_t;
-
-
-// Instance of interrupt flag data record - defined for external use 
-extern int_handle_flags_t handler_flags; 
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Event mask of a single event 
+#define EVENT_MASK(event) ((event_mask_t)1 << (event)) 
 
 //=======================================================================================
 
@@ -94,18 +103,133 @@ extern int_handle_flags_t handler_flags;
 // Initialization 
 
 /**
- * @brief Interrupt handler flag initialization 
+ * @brief Interrupt handler event initialization 
  * 
- * @details Clears all the interrupt flags in int_handle_flags_t so no interrupts are 
- *          triggered immediately after being enabled. 
+ * @details Clears all pending events so no interrupts are handled immediately after 
+ *          being enabled. 
  * 
- * @see int_handle_flags_t
+ * @see event_id_t 
  */
 void int_handler_init(void); 
 
 //=======================================================================================
 
 
+//=======================================================================================
+// Events 
+
+/**
+ * @brief Set an event 
+ * 
+ * @details Called by the interrupt handlers to tell the main loop an interrupt occurred. 
+ *          The event bit is set with an atomic read-modify-write (LDREX/STREX) so events 
+ *          set by other interrupts or cleared by the main loop at the same time are 
+ *          never lost. Setting an event that is already pending has no effect. 
+ * 
+ * @param event : event to set 
+ */
+void event_set_from_isr(event_id_t event); 
+
+
+/**
+ * @brief Take (read and clear) a group of events 
+ * 
+ * @details Atomically clears the events in 'mask' and returns the ones that were 
+ *          pending. Events outside the mask are left pending for other code. 
+ * 
+ * @param mask : events to take - see EVENT_MASK 
+ * @return event_mask_t : events in the mask that were pending 
+ */
+event_mask_t event_take(event_mask_t mask); 
+
+
+/**
+ * @brief Take (read and clear) all events 
+ * 
+ * @return event_mask_t : events that were pending 
+ */
+event_mask_t event_take_all(void); 
+
+
+/**
+ * @brief Remove the lowest event from a set of taken events 
+ * 
+ * @details Used to handle every taken event in one pass: 
+ *          
+ *          event_mask_t events = event_take(mask); 
+ *          while (events) 
+ *          {
+ *              switch (event_next(&events)) { ... } 
+ *          }
+ * 
+ * @param events : taken events - must not be zero 
+ * @return event_id_t : lowest event in the set 
+ */
+static inline event_id_t event_next(event_mask_t *events)
+{
+    event_id_t event = (event_id_t)__builtin_ctzll(*events); 
+    *events &= *events - 1; 
+    return event; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Event counters 
+
+/**
+ * @brief Count events instead of only flagging them 
+ * 
+ * @details An event flag only says an interrupt happened at least once since it was 
+ *          last taken. When counting is enabled for an event each interrupt also adds 
+ *          one to the event's counter so no edges are lost when the main loop is slower 
+ *          than the interrupt rate (ex. pulse counting). The event is still set so it 
+ *          can be taken as normal. Counting is available for every interrupt handler 
+ *          that sets an event. 
+ *          
+ *          With 'timestamp' set, the DWT cycle count of the last interrupt is also 
+ *          saved and the DWT cycle counter is started. 
+ * 
+ * @param events : events to count - see EVENT_MASK 
+ * @param timestamp : save the DWT cycle count of the last interrupt (SET/CLEAR) 
+ */
+void event_count_enable(
+    event_mask_t events, 
+    uint8_t timestamp); 
+
+
+/**
+ * @brief Stop counting events 
+ * 
+ * @param events : events to stop counting - see EVENT_MASK 
+ */
+void event_count_disable(event_mask_t events); 
+
+
+/**
+ * @brief Take (read and clear) an event count 
+ * 
+ * @details The count is swapped with zero in one atomic step so an interrupt between 
+ *          reading and clearing the count can't be lost. 
+ * 
+ * @param event : counted event 
+ * @return uint32_t : number of interrupts since the count was last taken 
+ */
+uint32_t event_count_take(event_id_t event); 
+
+
+/**
+ * @brief DWT cycle count of the last counted interrupt 
+ * 
+ * @param event : counted event with timestamps enabled 
+ * @return uint32_t : DWT->CYCCNT when the interrupt last occurred 
+ */
+uint32_t event_count_timestamp(event_id_t event); 
+
+//=======================================================================================
+
+
 //=======================================================================================
 // System Handlers 
 
@@ -176,7 +300,7 @@ void SysTick_Handler(void);
  * @brief EXTI Line 0 interrupt handler 
  * 
  * @details External interrupt handler for pin 0 of whichever port has been configured. This 
- *          function sets exti0_flag and clears it's corresponding bit in the pending 
+ *          function sets EVENT_EXTI0 and clears it's corresponding bit in the pending 
  *          register. External interrupts are triggered on rising and/or falling edges of 
  *          GPIO input pins. This interrupt handler can also be configured to trigger for 
  *          software events. 
@@ -190,7 +314,7 @@ void EXTI0_IRQHandler(void);
  * @brief EXTI Line 1 interrupt handler 
  * 
  * @details External interrupt handler for pin 1 of whichever port has been configured. This 
- *          function sets exti1_flag and clears it's corresponding bit in the pending 
+ *          function sets EVENT_EXTI1 and clears it's corresponding bit in the pending 
  *          register. External interrupts are triggered on rising and/or falling edges of 
  *          GPIO input pins. This interrupt handler can also be configured to trigger for 
  *          software events. 
@@ -204,7 +328,7 @@ void EXTI1_IRQHandler(void);
  * @brief EXTI Line 2 interrupt handler 
  * 
  * @details External interrupt handler for pin 2 of whichever port has been configured. This 
- *          function sets exti2_flag and clears it's corresponding bit in the pending 
+ *          function sets EVENT_EXTI2 and clears it's corresponding bit in the pending 
  *          register. External interrupts are triggered on rising and/or falling edges of 
  *          GPIO input pins. This interrupt handler can also be configured to trigger for 
  *          software events. 
@@ -218,7 +342,7 @@ void EXTI2_IRQHandler(void);
  * @brief EXTI Line 3 interrupt handler 
  * 
  * @details External interrupt handler for pin 3 of whichever port has been configured. This 
- *          function sets exti3_flag and clears it's corresponding bit in the pending 
+ *          function sets EVENT_EXTI3 and clears it's corresponding bit in the pending 
  *          register. External interrupts are triggered on rising and/or falling edges of 
  *          GPIO input pins. This interrupt handler can also be configured to trigger for 
  *          software events. 
@@ -232,7 +356,7 @@ void EXTI3_IRQHandler(void);
  * @brief EXTI Line 4 interrupt handler 
  * 
  * @details External interrupt handler for pin 4 of whichever port has been configured. This 
- *          function sets exti4_flag and clears it's corresponding bit in the pending 
+ *          function sets EVENT_EXTI4 and clears it's corresponding bit in the pending 
  *          register. External interrupts are triggered on rising and/or falling edges of 
  *          GPIO input pins. This interrupt handler can also be configured to trigger for 
  *          software events. 
@@ -247,7 +371,7 @@ void EXTI4_IRQHandler(void);
  * 
  * @details External interrupt handler for pins 5-9 of whichever port has been configured. This 
  *          means pins 5-9 will share this interrupt handler and it therefore won't distinguish 
- *          which pin has triggered the interrupt. This function sets exti5_9_flag and clears all 
+ *          which pin has triggered the interrupt. This function sets EVENT_EXTI5_9 and clears all 
  *          the bits corresponding to pins 5-9 in the pending register. External interrupts are 
  *          triggered on rising and/or falling edges of GPIO input pins. This interrupt handler 
  *          can also be configured to trigger for software events. 
@@ -262,7 +386,7 @@ void EXTI9_5_IRQHandler(void);
  * 
  * @details External interrupt handler for pins 10-15 of whichever port has been configured. This 
  *          means pins 10-15 will share this interrupt handler and it therefore won't distinguish 
- *          which pin has triggered the interrupt. This function sets exti10_15_flag and clears all 
+ *          which pin has triggered the interrupt. This function sets EVENT_EXTI10_15 and clears all 
  *          the bits corresponding to pins 10-15 in the pending register. External interrupts are 
  *          triggered on rising and/or falling edges of GPIO input pins. This interrupt handler 
  *          can also be configured to trigger for software events. 
@@ -275,7 +399,7 @@ void EXTI15_10_IRQHandler(void);
 /**
  * @brief DMA1 Stream 0 interrupt handler 
  * 
- * @details Interrupt handler for DMA 1, stream 0. This function sets dma1_0_flag and 
+ * @details Interrupt handler for DMA 1, stream 0. This function sets EVENT_DMA1_0 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -289,7 +413,7 @@ void DMA1_Stream0_IRQHandler(void);
 /**
  * @brief DMA1 Stream 1 interrupt handler 
  * 
- * @details Interrupt handler for DMA 1, stream 1. This function sets dma1_1_flag and 
+ * @details Interrupt handler for DMA 1, stream 1. This function sets EVENT_DMA1_1 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -303,7 +427,7 @@ void DMA1_Stream1_IRQHandler(void);
 /**
  * @brief DMA1 Stream 2 interrupt handler 
  * 
- * @details Interrupt handler for DMA 1, stream 2. This function sets dma1_2_flag and 
+ * @details Interrupt handler for DMA 1, stream 2. This function sets EVENT_DMA1_2 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -317,7 +441,7 @@ void DMA1_Stream2_IRQHandler(void);
 /**
  * @brief DMA1 Stream 3 interrupt handler 
  * 
- * @details Interrupt handler for DMA 1, stream 3. This function sets dma1_3_flag and 
+ * @details Interrupt handler for DMA 1, stream 3. This function sets EVENT_DMA1_3 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -331,7 +455,7 @@ void DMA1_Stream3_IRQHandler(void);
 /**
  * @brief DMA1 Stream 4 interrupt handler 
  * 
- * @details Interrupt handler for DMA 1, stream 4. This function sets dma1_4_flag and 
+ * @details Interrupt handler for DMA 1, stream 4. This function sets EVENT_DMA1_4 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -345,7 +469,7 @@ void DMA1_Stream4_IRQHandler(void);
 /**
  * @brief DMA1 Stream 5 interrupt handler 
  * 
- * @details Interrupt handler for DMA 1, stream 5. This function sets dma1_5_flag and 
+ * @details Interrupt handler for DMA 1, stream 5. This function sets EVENT_DMA1_5 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -359,7 +483,7 @@ void DMA1_Stream5_IRQHandler(void);
 /**
  * @brief DMA1 Stream 6 interrupt handler 
  * 
- * @details Interrupt handler for DMA 1, stream 6. This function sets dma1_6_flag and 
+ * @details Interrupt handler for DMA 1, stream 6. This function sets EVENT_DMA1_6 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -373,7 +497,7 @@ void DMA1_Stream6_IRQHandler(void);
 /**
  * @brief DMA1 Stream 7 interrupt handler 
  * 
- * @details Interrupt handler for DMA 1, stream 7. This function sets dma1_7_flag and 
+ * @details Interrupt handler for DMA 1, stream 7. This function sets EVENT_DMA1_7 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -387,7 +511,7 @@ void DMA1_Stream7_IRQHandler(void);
 /**
  * @brief DMA2 Stream 0 interrupt handler 
  * 
- * @details Interrupt handler for DMA 2, stream 0. This function sets dma2_0_flag and 
+ * @details Interrupt handler for DMA 2, stream 0. This function sets EVENT_DMA2_0 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -401,7 +525,7 @@ void DMA2_Stream0_IRQHandler(void);
 /**
  * @brief DMA2 Stream 1 interrupt handler 
  * 
- * @details Interrupt handler for DMA 2, stream 1. This function sets dma2_1_flag and 
+ * @details Interrupt handler for DMA 2, stream 1. This function sets EVENT_DMA2_1 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -415,7 +539,7 @@ void DMA2_Stream1_IRQHandler(void);
 /**
  * @brief DMA2 Stream 2 interrupt handler 
  * 
- * @details Interrupt handler for DMA 2, stream 2. This function sets dma2_2_flag and 
+ * @details Interrupt handler for DMA 2, stream 2. This function sets EVENT_DMA2_2 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -429,7 +553,7 @@ void DMA2_Stream2_IRQHandler(void);
 /**
  * @brief DMA2 Stream 3 interrupt handler 
  * 
- * @details Interrupt handler for DMA 2, stream 3. This function sets dma2_3_flag and 
+ * @details Interrupt handler for DMA 2, stream 3. This function sets EVENT_DMA2_3 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -443,7 +567,7 @@ void DMA2_Stream3_IRQHandler(void);
 /**
  * @brief DMA2 Stream 4 interrupt handler 
  * 
- * @details Interrupt handler for DMA 2, stream 4. This function sets dma2_4_flag and 
+ * @details Interrupt handler for DMA 2, stream 4. This function sets EVENT_DMA2_4 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -457,7 +581,7 @@ void DMA2_Stream4_IRQHandler(void);
 /**
  * @brief DMA2 Stream 5 interrupt handler 
  * 
- * @details Interrupt handler for DMA 2, stream 5. This function sets dma2_5_flag and 
+ * @details Interrupt handler for DMA 2, stream 5. This function sets EVENT_DMA2_5 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -471,7 +595,7 @@ void DMA2_Stream5_IRQHandler(void);
 /**
  * @brief DMA2 Stream 6 interrupt handler 
  * 
- * @details Interrupt handler for DMA 2, stream 6. This function sets dma2_6_flag and 
+ * @details Interrupt handler for DMA 2, stream 6. This function sets EVENT_DMA2_6 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -485,7 +609,7 @@ void DMA2_Stream6_IRQHandler(void);
 /**
  * @brief DMA2 Stream 7 interrupt handler 
  * 
- * @details Interrupt handler for DMA 2, stream 7. This function sets dma2_7_flag and 
+ * @details Interrupt handler for DMA 2, stream 7. This function sets EVENT_DMA2_7 and 
  *          then clears all the DMA interrupt flags so that the handler can be exited. 
  *          Interrupts can be produced when half-transfer is reached, transfer is complete, 
  *          there is a transfer error, there is a FIFO error (overrun, underrun, FIFO level 
@@ -511,7 +635,7 @@ void DMA2_Stream7_IRQHandler(void);
  *          update, capture/compare, or a trigger. This handler clears the update interrupt 
  *          flag for the timer so the handler can be exited. 
  *          
- *          This handler sets tim1_brk_tim9_glbl_flag and clears the update interrupt flag 
+ *          This handler sets EVENT_TIM1_BRK_TIM9 and clears the update interrupt flag 
  *          for the timers so the handler can be exited. 
  * 
  * @see tim_uif_clear
@@ -530,7 +654,7 @@ void TIM1_BRK_TIM9_IRQHandler(void);
  *          TIM10 is a general purpose timer and can be set to trigger interrupts for counter 
  *          updates (overflow, initialization), input capture or output compare. 
  *          
- *          This handler sets tim1_up_tim10_glbl_flag and clears the update interrupt flag 
+ *          This handler sets EVENT_TIM1_UP_TIM10 and clears the update interrupt flag 
  *          for the timers so the handler can be exited. 
  * 
  * @see tim_uif_clear
@@ -550,7 +674,7 @@ void TIM1_UP_TIM10_IRQHandler(void);
  *          TIM11 is a general purpose timer and can be set to trigger interrupts for counter 
  *          updates (overflow, initialization), input capture or output compare. 
  *          
- *          This handler sets tim1_trg_tim11_glbl_flag and clears the update interrupt flag 
+ *          This handler sets EVENT_TIM1_TRG_TIM11 and clears the update interrupt flag 
  *          for the timers so the handler can be exited. 
  * 
  * @see tim_uif_clear
@@ -571,7 +695,7 @@ void TIM1_TRG_COM_TIM11_IRQHandler(void);
  *          when a period of time has elapsed. This interrupt is triggered when a match is 
  *          found between the capture/compare register and the counter. 
  *          
- *          This handler sets tim1_cc_flag and clears the update interrupt flag for the timer 
+ *          This handler sets EVENT_TIM1_CC and clears the update interrupt flag for the timer 
  *          so the handler can be exited. 
  * 
  * @see tim_uif_clear
@@ -587,7 +711,7 @@ void TIM1_CC_IRQHandler(void);
  *          start, stop, initialization or count by internal/external trigger), input 
  *          capture or output compare. 
  *          
- *          This handler sets tim2_glbl_flag and clears the update interrupt flag for the timer 
+ *          This handler sets EVENT_TIM2 and clears the update interrupt flag for the timer 
  *          so the handler can be exited. 
  * 
  * @see tim_uif_clear
@@ -603,7 +727,7 @@ void TIM2_IRQHandler(void);
  *          start, stop, initialization or count by internal/external trigger), input 
  *          capture or output compare. 
  *          
- *          This handler sets tim3_glbl_flag and clears the update interrupt flag for the timer 
+ *          This handler sets EVENT_TIM3 and clears the update interrupt flag for the timer 
  *          so the handler can be exited. 
  * 
  * @see tim_uif_clear
@@ -619,7 +743,7 @@ void TIM3_IRQHandler(void);
  *          start, stop, initialization or count by internal/external trigger), input 
  *          capture or output compare. 
  *          
- *          This handler sets tim4_glbl_flag and clears the update interrupt flag for the timer 
+ *          This handler sets EVENT_TIM4 and clears the update interrupt flag for the timer 
  *          so the handler can be exited. 
  * 
  * @see tim_uif_clear
@@ -635,7 +759,7 @@ void TIM4_IRQHandler(void);
  *          start, stop, initialization or count by internal/external trigger), input 
  *          capture or output compare. 
  *          
- *          This handler sets tim5_glbl_flag and clears the update interrupt flag for the timer 
+ *          This handler sets EVENT_TIM5 and clears the update interrupt flag for the timer 
  *          so the handler can be exited. 
  * 
  * @see tim_uif_clear
@@ -646,7 +770,7 @@ void TIM5_IRQHandler(void);
 /**
  * @brief ADC1 interrupt handler 
  * 
- * @details Interrupt handler for ADC1. This handler sets adc_flag. Interrupt generation for 
+ * @details Interrupt handler for ADC1. This handler sets EVENT_ADC. Interrupt generation for 
  *          ADC1 can be configured to trigger at the end of conversion, end of injected 
  *          conversion, and for analog watchdog or overrun events. 
  */
@@ -656,7 +780,7 @@ void ADC_IRQHandler(void);
 /**
  * @brief USART1 interrupt handler 
  * 
- * @details Interrupt handler for USART1. This handler sets usart1_flag. 
+ * @details Interrupt handler for USART1. This handler sets EVENT_USART1. 
  */
 void USART1_IRQHandler(void); 
 
@@ -664,7 +788,7 @@ void USART1_IRQHandler(void);
 /**
  * @brief USART2 interrupt handler 
  * 
- * @details Interrupt handler for USART2. This handler sets usart2_flag. 
+ * @details Interrupt handler for USART2. This handler sets EVENT_USART2. 
  */
 void USART2_IRQHandler(void); 
 
@@ -672,7 +796,7 @@ void USART2_IRQHandler(void);
 /**
  * @brief USART6 interrupt handler 
  * 
- * @details Interrupt handler for USART6. This handler sets usart6_flag. 
+ * @details Interrupt handler for USART6. This handler sets EVENT_USART6. 
  */
 void USART6_IRQHandler(void); 
 
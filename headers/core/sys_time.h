@@ -0,0 +1,134 @@
+/**
+ * @file sys_time.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief System clock interface 
+ * 
+ * @details A 64-bit microsecond clock that counts from sys_time_init and doesn't wrap. 
+ *          A 32-bit timer (TIM2 or TIM5) counts microseconds over its full range and 
+ *          its update (overflow) interrupt counts the upper 32 bits, once every ~71 
+ *          minutes. Samples from different devices read with sys_time_us are on one 
+ *          timeline so they can be lined up and latencies measured. 
+ * 
+ *          Reads don't block or mask interrupts and can be made from the main loop, 
+ *          tasks and interrupts of any priority. An overflow whose interrupt hasn't run 
+ *          yet (pending or masked) is seen in the timer's update flag and counted by the 
+ *          reader, so the time never steps backwards. 
+ * 
+ *          With SYS_TIME_DWT_ENABLE set (system_settings.h) sys_time_ns fills in the 
+ *          time within the current microsecond from the DWT cycle counter. This needs 
+ *          the core and timer clocks to be the same whole number of MHz, otherwise 
+ *          sys_time_ns has microsecond resolution. Resetting the cycle counter (ex. 
+ *          bench_clock_init) after sys_time_init throws the sub-microsecond part off 
+ *          until sys_time_init is called again. 
+ * 
+ *          The timer's compare channels are left free - the timer wheel 
+ *          (timer_wheel.h) uses channel 1 of the same counter for its deadlines. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _SYS_TIME_H_ 
+#define _SYS_TIME_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+#include "system_settings.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SYS_TIME_CLK_HZ 1000000             // Counter rate (1 us) 
+#define SYS_TIME_NS_PER_US 1000             // Nanoseconds per microsecond 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Start the system clock 
+ * 
+ * @details Sets the timer to count microseconds freely over its 32-bit range, enables 
+ *          its update interrupt and starts the clock from 0. Calling it again restarts 
+ *          the clock. 
+ * 
+ * @param timer : TIM2 or TIM5 (32-bit timers) 
+ * @param priority : timer interrupt priority 
+ * @return uint8_t : TRUE if started, FALSE if the timer isn't supported 
+ */
+uint8_t sys_time_init(
+    TIM_TypeDef *timer, 
+    uint8_t priority); 
+
+
+/**
+ * @brief Time since the clock was started 
+ * 
+ * @return uint64_t : time (us) - 0 if the clock isn't started 
+ */
+uint64_t sys_time_us(void); 
+
+
+/**
+ * @brief Time since the clock was started with sub-microsecond resolution 
+ * 
+ * @return uint64_t : time (ns) - 0 if the clock isn't started 
+ */
+uint64_t sys_time_ns(void); 
+
+
+/**
+ * @brief Time elapsed since an earlier reading 
+ * 
+ * @param start : earlier sys_time_us reading 
+ * @return uint64_t : time since 'start' (us) 
+ */
+static inline uint64_t sys_time_since(uint64_t start)
+{
+    return sys_time_us() - start; 
+}
+
+
+/**
+ * @brief Timer used by the clock 
+ * 
+ * @return TIM_TypeDef* : timer, NULL if the clock isn't started 
+ */
+TIM_TypeDef *sys_time_timer(void); 
+
+
+/**
+ * @brief Interrupt handler hook - called from the TIM2 and TIM5 handlers 
+ * 
+ * @details Counts an overflow if the timer is the clock's timer and its update flag is 
+ *          set. The clock's timer flags are cleared by this and the timer wheel hooks 
+ *          only - a general clear of the update flag could lose an overflow. 
+ * 
+ * @param timer : timer of the interrupt handler 
+ * @return uint8_t : TRUE if 'timer' is the clock's timer 
+ */
+uint8_t sys_time_irq_handler(TIM_TypeDef *timer); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _SYS_TIME_H_ 
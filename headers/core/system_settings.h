@@ -36,6 +36,20 @@
 // specific override then this should be cleared. 
 #define INTERRUPT_OVERRIDE 0 
 
+// This adds DWT cycle counter reads to the start and end of the interrupt handlers in 
+// stm32f4xx_it.c so their latency and duration can be profiled (see isr_profile.h). 
+// Leave it cleared unless profiling as it adds time to every handler. 
+#define ISR_PROFILE_ENABLE 0 
+
+// This lets the fixed point filters (see dsp_filter.h) use the Cortex-M4 DSP (SIMD) 
+// instructions. Clear it to run the plain C versions on the target, which give the 
+// same results, for timing comparisons. 
+#define DSP_SIMD_ENABLE 1 
+
+// This lets the system clock (see sys_time.h) use the DWT cycle counter for the time 
+// within each microsecond. Clear it if the cycle counter is reset while the clock runs. 
+#define SYS_TIME_DWT_ENABLE 1 
+
 //==================================================
 
 //=======================================================================================
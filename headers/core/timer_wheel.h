@@ -0,0 +1,299 @@
+/**
+ * @file timer_wheel.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Hierarchical timer wheel interface 
+ * 
+ * @details All non-blocking delays share the system clock's 32-bit microsecond timer 
+ *          (TIM2 or TIM5, see sys_time.h). Timers are kept in a hierarchical wheel of 
+ *          TWHEEL_LEVELS levels with TWHEEL_SLOTS slots each: level 0 slots are one 
+ *          tick (TWHEEL_TICK_US) apart and each level above is TWHEEL_SLOTS times 
+ *          coarser. Timers in the upper levels move down a level (cascade) as their 
+ *          time gets close. Starting and stopping a timer is O(1) and the next deadline 
+ *          is found from a bitmap of the used slots of each level. 
+ * 
+ *          The timer's capture/compare 1 interrupt is set for the next deadline only so 
+ *          there is no interrupt per tick and nothing to poll. When a timer expires its 
+ *          expiry count goes up (taken with twheel_take, ex. in place of tim_compare) 
+ *          and its callback, if any, runs in the timer interrupt. Timers can be one 
+ *          shot or periodic. A periodic timer keeps its phase - if the interrupt is held 
+ *          off past one or more periods they all expire when it runs. Timers never 
+ *          expire early and are less than a tick late after the delay is rounded up to 
+ *          whole ticks. 
+ * 
+ *          Timers are started and stopped from the main loop or from timer callbacks, 
+ *          not from other interrupts. 
+ * 
+ *          twheel_sleep puts the core to sleep (WFI) until the next deadline or any 
+ *          other interrupt so a main loop that only waits on timers doesn't spin. The 
+ *          timer's interrupt handler also sets its event (EVENT_TIM2 or EVENT_TIM5) so 
+ *          the main loop can wait on timers along with other events (event_take). 
+ * 
+ *          The wheel itself (twheel_t) doesn't use the hardware and is driven with tick 
+ *          counts so the same logic can be run with simulated time (see 
+ *          timer_wheel_test.h). The twheel_start/twheel_stop functions use the wheel 
+ *          driven by the hardware timer. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _TIMER_WHEEL_H_ 
+#define _TIMER_WHEEL_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define TWHEEL_TICK_US 1000                 // Wheel tick (us) 
+#define TWHEEL_SLOT_BITS 6                  // log2 of TWHEEL_SLOTS 
+#define TWHEEL_SLOTS (1 << TWHEEL_SLOT_BITS)    // Slots per level 
+#define TWHEEL_LEVELS 4                     // Wheel levels 
+
+// Longest delay or period (ticks) - about 4.6 hours with 1 ms ticks 
+#define TWHEEL_MAX_TICKS ((1UL << (TWHEEL_SLOT_BITS * TWHEEL_LEVELS)) - 1) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// List link - each slot is a circular list with the slot's link as the head 
+typedef struct twheel_link_s
+{
+    struct twheel_link_s *next; 
+    struct twheel_link_s *prev; 
+}
+twheel_link_t; 
+
+
+typedef struct twheel_timer_s twheel_timer_t; 
+
+
+/**
+ * @brief Timer callback - runs where the wheel is advanced (timer interrupt) 
+ * 
+ * @details The callback can start or stop any timer, including its own. 
+ */
+typedef void (*twheel_callback_t)(twheel_timer_t *timer); 
+
+
+// Timer - owned by the user, zeroed before first use 
+struct twheel_timer_s
+{
+    twheel_link_t link;                     // Slot list link (first member) 
+    uint32_t expires;                       // Tick the timer expires on 
+    uint32_t period;                        // Period (ticks) - 0 for one shot 
+    twheel_callback_t callback;             // Called on expiry (NULL for none) 
+    void *arg;                              // User data for the callback 
+    volatile uint32_t expired;              // Expiries since last taken 
+    uint16_t slot;                          // Slot holding the timer (level, slot) 
+    uint8_t active;                         // Timer is in the wheel 
+}; 
+
+
+// Wheel 
+typedef struct twheel_s
+{
+    twheel_link_t slots[TWHEEL_LEVELS][TWHEEL_SLOTS];   // Timers in each slot 
+    uint64_t used[TWHEEL_LEVELS];           // Slots with timers (bit per slot) 
+    uint32_t now;                           // Next tick to process 
+}
+twheel_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Wheel functions 
+
+/**
+ * @brief Initialize a wheel 
+ * 
+ * @param wheel : wheel to initialize 
+ * @param now : first tick to process 
+ */
+void twheel_init(
+    twheel_t *wheel, 
+    uint32_t now); 
+
+
+/**
+ * @brief Add a timer to a wheel 
+ * 
+ * @details A timer already in the wheel is moved to its new time. The timer expires on 
+ *          tick 'now + delay' then every 'period' ticks if 'period' isn't 0. 
+ * 
+ * @param wheel : wheel 
+ * @param timer : timer to add 
+ * @param delay : ticks from the next tick to process to the first expiry 
+ * @param period : ticks between expiries (0 for one shot) 
+ * @return uint8_t : TRUE if added, FALSE if the delay or period is over TWHEEL_MAX_TICKS 
+ */
+uint8_t twheel_add(
+    twheel_t *wheel, 
+    twheel_timer_t *timer, 
+    uint32_t delay, 
+    uint32_t period); 
+
+
+/**
+ * @brief Remove a timer from a wheel 
+ * 
+ * @details Expiries not yet taken are kept. Does nothing if the timer isn't active. 
+ * 
+ * @param wheel : wheel 
+ * @param timer : timer to remove 
+ */
+void twheel_remove(
+    twheel_t *wheel, 
+    twheel_timer_t *timer); 
+
+
+/**
+ * @brief Ticks until the next tick with work to do 
+ * 
+ * @details Work is an expiry or moving timers down a level, so the result can be 
+ *          earlier than the next expiry. 0 means the next tick to process has work. 
+ * 
+ * @param wheel : wheel 
+ * @param limit : largest result returned (ex. when the wheel is empty) 
+ * @return uint32_t : ticks from the next tick to process 
+ */
+uint32_t twheel_next(
+    const twheel_t *wheel, 
+    uint32_t limit); 
+
+
+/**
+ * @brief Process a number of ticks 
+ * 
+ * @details Expired timers are counted, their callbacks are called and periodic timers 
+ *          are added again. Ticks with no work are skipped over without being looked 
+ *          at one by one. 
+ * 
+ * @param wheel : wheel 
+ * @param ticks : ticks to process (up to 2^31) 
+ * @return uint32_t : number of expiries 
+ */
+uint32_t twheel_advance(
+    twheel_t *wheel, 
+    uint32_t ticks); 
+
+
+/**
+ * @brief Take (read and clear) the expiry count of a timer 
+ * 
+ * @details The count is swapped with 0 in one atomic step so an expiry at the same time 
+ *          isn't lost. 
+ * 
+ * @param timer : timer 
+ * @return uint32_t : expiries since last taken 
+ */
+static inline uint32_t twheel_take(twheel_timer_t *timer)
+{
+    return __atomic_exchange_n(&timer->expired, 0U, __ATOMIC_RELAXED); 
+}
+
+
+/**
+ * @brief Check if a timer is in a wheel 
+ * 
+ * @param timer : timer 
+ * @return uint8_t : TRUE if the timer is waiting to expire 
+ */
+static inline uint8_t twheel_active(const twheel_timer_t *timer)
+{
+    return timer->active; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Hardware timer functions 
+
+/**
+ * @brief Start the hardware timer wheel 
+ * 
+ * @details Uses the system clock's timer (sys_time_init must be called first) and 
+ *          enables its capture/compare 1 interrupt. The interrupt priority is the one 
+ *          given to the system clock. Timers started before are lost. 
+ * 
+ * @return uint8_t : TRUE if started, FALSE if the system clock isn't started 
+ */
+uint8_t twheel_hw_init(void); 
+
+
+/**
+ * @brief Start a timer on the hardware timer wheel 
+ * 
+ * @details The first expiry is at least 'delay' microseconds away (rounded up to whole 
+ *          ticks). The period is rounded to the nearest tick. A running timer is 
+ *          restarted. 
+ * 
+ * @param timer : timer 
+ * @param delay : time to the first expiry (us) 
+ * @param period : time between expiries (us) - 0 for one shot 
+ * @param callback : expiry callback (NULL for none) 
+ * @param arg : user data for the callback 
+ * @return uint8_t : TRUE if started 
+ */
+uint8_t twheel_start(
+    twheel_timer_t *timer, 
+    uint32_t delay, 
+    uint32_t period, 
+    twheel_callback_t callback, 
+    void *arg); 
+
+
+/**
+ * @brief Stop a timer on the hardware timer wheel 
+ * 
+ * @param timer : timer 
+ */
+void twheel_stop(twheel_timer_t *timer); 
+
+
+/**
+ * @brief Sleep until the next deadline or interrupt 
+ * 
+ * @details Returns straight away if a timer expired since the last call so an expiry 
+ *          just before the call isn't slept through. Other interrupts also wake the 
+ *          core. 
+ */
+void twheel_sleep(void); 
+
+
+/**
+ * @brief Interrupt handler hook - called from the TIM2 and TIM5 handlers 
+ * 
+ * @details Processes the ticks that are due and sets the compare for the next deadline. 
+ *          Does nothing if the hardware wheel isn't started or its compare flag isn't 
+ *          set. 
+ */
+void twheel_irq_handler(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _TIMER_WHEEL_H_ 
@@ -0,0 +1,159 @@
+/**
+ * @file tlog.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Binary telemetry log interface 
+ * 
+ * @details Writes typed, fixed size telemetry records (GPS fix, heading, IMU, throttle 
+ *          and radio statistics) to an SD card file in the chunked format described in 
+ *          tlog_format.h. A record takes 4 bytes plus its contents instead of a line of 
+ *          text, and the chunks and index let the host reader (tools/tlog_reader.h) 
+ *          find a time without reading the whole file. 
+ * 
+ *          The bytes go through the SD card logging engine (sd_log.h), so records can 
+ *          be written from an interrupt and sd_log_service writes them to the card 
+ *          from the main loop. Each record is stamped with the system clock 
+ *          (sys_time_us) when written. Records come from one context at a time. 
+ * 
+ *          A chunk's header is written with its first record and its end is filled 
+ *          with zeros before the next one starts, so chunks stay at fixed places in 
+ *          the file. A record the logging engine can't take is dropped whole and 
+ *          counted, and anything left over from the chunk or index before it is 
+ *          written first next time. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _TLOG_H_ 
+#define _TLOG_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+#include "tlog_format.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Telemetry log statistics 
+typedef struct tlog_stats_s
+{
+    uint32_t records;                       // Records written 
+    uint32_t dropped;                       // Records dropped (logging engine full) 
+    uint32_t data_chunks;                   // Data chunks started 
+    uint32_t index_chunks;                  // Index chunks written 
+    uint32_t record_bytes;                  // Bytes of the records written 
+    uint32_t pad_bytes;                     // Zeros written to fill the ends of chunks 
+}
+tlog_stats_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Start a telemetry log 
+ * 
+ * @details The file must be open for writing and empty, and stay open until 
+ *          tlog_close. With a size the space is allocated up front like 
+ *          sd_log_open_contig. The statistics are cleared. 
+ * 
+ * @param file : open, empty file 
+ * @param size : space to allocate (bytes, 0 to grow the file) 
+ * @param sync_every : logging engine buffers written between syncs (0 to sync on close 
+ *                     only) 
+ * @return uint8_t : TRUE if started, FALSE if the file isn't empty, a log is already 
+ *                   open or the logging engine couldn't start 
+ */
+uint8_t tlog_open(
+    FIL *file, 
+    FSIZE_t size, 
+    uint16_t sync_every); 
+
+
+/**
+ * @brief Log a GPS fix 
+ * 
+ * @param gps : fix 
+ * @return uint8_t : TRUE if logged, FALSE if dropped or no log is open 
+ */
+uint8_t tlog_gps(const tlog_gps_t *gps); 
+
+
+/**
+ * @brief Log the heading 
+ * 
+ * @param heading : heading and target heading 
+ * @return uint8_t : TRUE if logged, FALSE if dropped or no log is open 
+ */
+uint8_t tlog_heading(const tlog_heading_t *heading); 
+
+
+/**
+ * @brief Log IMU readings 
+ * 
+ * @param imu : accelerometer and gyroscope readings 
+ * @return uint8_t : TRUE if logged, FALSE if dropped or no log is open 
+ */
+uint8_t tlog_imu(const tlog_imu_t *imu); 
+
+
+/**
+ * @brief Log the thruster throttle 
+ * 
+ * @param throttle : throttle of each thruster 
+ * @return uint8_t : TRUE if logged, FALSE if dropped or no log is open 
+ */
+uint8_t tlog_throttle(const tlog_throttle_t *throttle); 
+
+
+/**
+ * @brief Log radio link statistics 
+ * 
+ * @param radio : link statistics 
+ * @return uint8_t : TRUE if logged, FALSE if dropped or no log is open 
+ */
+uint8_t tlog_radio(const tlog_radio_t *radio); 
+
+
+/**
+ * @brief Finish the last chunk and stop logging 
+ * 
+ * @details Records must have stopped coming. The last chunk is filled out to its full 
+ *          size and the logging engine is closed (sd_log_close). The file is left 
+ *          open. 
+ * 
+ * @return uint8_t : TRUE if the logging engine had no write or sync errors 
+ */
+uint8_t tlog_close(void); 
+
+
+/**
+ * @brief Read the telemetry log statistics 
+ * 
+ * @param stats : copy of the statistics 
+ */
+void tlog_get_stats(tlog_stats_t *stats); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _TLOG_H_ 
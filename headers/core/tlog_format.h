@@ -0,0 +1,182 @@
+/**
+ * @file tlog_format.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Telemetry log file format 
+ * 
+ * @details Shared by the writer (tlog.h) and the host reader (tools/tlog_reader.h) so 
+ *          only needs stdint.h. Everything is little endian. 
+ * 
+ *          The file is a run of TLOG_CHUNK_SIZE byte chunks so chunk n is always at 
+ *          n * TLOG_CHUNK_SIZE. Each chunk starts with a header: 
+ * 
+ *            | magic (uint16) | kind | version | chunk number (uint32) | time (uint64) | 
+ * 
+ *          Data chunks hold records after the header. The header time is the time (us) 
+ *          of the chunk's first record and each record carries its time as an offset 
+ *          from it, so records stay small: 
+ * 
+ *            | type | time offset (uint24, us) | fixed size contents for the type | 
+ * 
+ *          A record never runs past the end of its chunk. The rest of a chunk after its 
+ *          last record is zeros (type TLOG_TYPE_END). 
+ * 
+ *          After every TLOG_INDEX_EVERY data chunks comes an index chunk holding the 
+ *          header time of each of those data chunks (uint64 each). A time is found by 
+ *          a binary search of the index chunks, which are at known places, and then of 
+ *          the times in the one found, so only a few chunks are read however long the 
+ *          log is. Data chunks after the last index chunk are searched by their 
+ *          headers. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _TLOG_FORMAT_H_ 
+#define _TLOG_FORMAT_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include <stdint.h> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Chunks 
+#define TLOG_MAGIC 0x4C54                   // Chunk header magic ("TL") 
+#define TLOG_VERSION 1                      // Format version 
+#define TLOG_CHUNK_SIZE 4096                // Chunk size (bytes) 
+#define TLOG_HEADER_LEN 16                  // Chunk header length (bytes) 
+#define TLOG_INDEX_EVERY 64                 // Data chunks per index chunk 
+#define TLOG_INDEX_ENTRY_LEN 8              // Index entry length (bytes) 
+
+// Records 
+#define TLOG_RECORD_HEADER_LEN 4            // Type and time offset (bytes) 
+#define TLOG_OFFSET_MAX 0xFFFFFF            // Largest record time offset (us) 
+#define TLOG_GPS_LEN 16                     // Record contents lengths (bytes) 
+#define TLOG_HEADING_LEN 4 
+#define TLOG_IMU_LEN 12 
+#define TLOG_THROTTLE_LEN 4 
+#define TLOG_RADIO_LEN 8 
+#define TLOG_RECORD_MAX_LEN (TLOG_RECORD_HEADER_LEN + TLOG_GPS_LEN)   // Longest record 
+
+// Record contents length of each type (indexed by tlog_type_t) 
+#define TLOG_RECORD_LENS                        \
+    {                                           \
+        0,                                      \
+        TLOG_GPS_LEN,                           \
+        TLOG_HEADING_LEN,                       \
+        TLOG_IMU_LEN,                           \
+        TLOG_THROTTLE_LEN,                      \
+        TLOG_RADIO_LEN                          \
+    }
+
+#define TLOG_IMU_AXES 3                     // Accelerometer or gyroscope axes 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+// Chunk kind 
+typedef enum {
+    TLOG_CHUNK_DATA = 1,                    // Records 
+    TLOG_CHUNK_INDEX                        // Header times of the data chunks before it 
+} tlog_chunk_t; 
+
+
+// Record type 
+typedef enum {
+    TLOG_TYPE_END,                          // No more records in the chunk 
+    TLOG_TYPE_GPS,                          // GPS fix 
+    TLOG_TYPE_HEADING,                      // Heading 
+    TLOG_TYPE_IMU,                          // IMU readings 
+    TLOG_TYPE_THROTTLE,                     // Thruster throttle 
+    TLOG_TYPE_RADIO,                        // Radio link statistics 
+    TLOG_TYPE_COUNT                         // Number of types 
+} tlog_type_t; 
+
+
+// Thrusters (same order as rc_frame.h) 
+typedef enum {
+    TLOG_RIGHT, 
+    TLOG_LEFT, 
+    TLOG_THRUSTERS
+} tlog_thruster_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// GPS fix - | lat | lon | alt | speed | fix | sats | 
+typedef struct tlog_gps_s
+{
+    int32_t lat;                            // Latitude (1e-7 degrees) 
+    int32_t lon;                            // Longitude (1e-7 degrees) 
+    int32_t alt;                            // Altitude (cm) 
+    uint16_t speed;                         // Ground speed (cm/s) 
+    uint8_t fix;                            // Fix type (0 for no fix) 
+    uint8_t sats;                           // Satellites used 
+}
+tlog_gps_t; 
+
+
+// Heading - | heading | target | 
+typedef struct tlog_heading_s
+{
+    uint16_t heading;                       // Heading (0.1 degrees) 
+    uint16_t target;                        // Target heading (0.1 degrees) 
+}
+tlog_heading_t; 
+
+
+// IMU readings - | accel x, y, z | gyro x, y, z | 
+typedef struct tlog_imu_s
+{
+    int16_t accel[TLOG_IMU_AXES];           // Accelerometer (raw) 
+    int16_t gyro[TLOG_IMU_AXES];            // Gyroscope (raw) 
+}
+tlog_imu_t; 
+
+
+// Thruster throttle - | right | left | 
+typedef struct tlog_throttle_s
+{
+    int16_t throttle[TLOG_THRUSTERS];       // Throttle of each thruster 
+}
+tlog_throttle_t; 
+
+
+// Radio link statistics - | link | channel | frames | lost | bad | 
+typedef struct tlog_radio_s
+{
+    uint8_t link;                           // Frames received recently (%) 
+    uint8_t channel;                        // RF channel 
+    uint16_t frames;                        // Frames received since the last record 
+    uint16_t lost;                          // Frames lost since the last record 
+    uint16_t bad;                           // Invalid payloads since the last record 
+}
+tlog_radio_t; 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _TLOG_FORMAT_H_ 
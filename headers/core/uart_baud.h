@@ -0,0 +1,128 @@
+/**
+ * @file uart_baud.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief UART baud rate calculator interface 
+ * 
+ * @details Finds the BRR register value for any baud rate from the UART's peripheral 
+ *          clock instead of using the fixed UART_FRAC_XX_XXXX / UART_MANT_XX_XXXX 
+ *          values. USARTDIV is the peripheral clock divided by (8 * (2 - OVER8) * baud) 
+ *          so in both oversampling modes the divider in 1/16 (OVER16) or 1/8 (OVER8) 
+ *          steps is the clock divided by the baud rate: 
+ *            - OVER16 : BRR = div, mantissa = div / 16, fraction = div % 16 
+ *            - OVER8  : BRR = mantissa << 4 | fraction, mantissa = div / 8, 
+ *                       fraction = div % 8 
+ *          Oversampling by 16 is used when the divider allows it (div >= 16) because it 
+ *          tolerates more clock error. Oversampling by 8 doubles the highest baud rate 
+ *          (peripheral clock / 8). The error of the actual baud rate is reported in 
+ *          hundredths of a percent. 
+ * 
+ *          uart_init still takes the fixed values. Call uart_baud_set after uart_init to 
+ *          change the baud rate. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _UART_BAUD_H_ 
+#define _UART_BAUD_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define UART_BAUD_ERROR_MAX 200             // Max error allowed (hundredths of a percent) 
+#define UART_BAUD_DIV_MIN_OVER16 16         // Min divider with oversampling by 16 
+#define UART_BAUD_DIV_MIN_OVER8 8           // Min divider with oversampling by 8 
+#define UART_BAUD_MANT_MAX 0x0FFF           // Max BRR mantissa 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Baud rate setting 
+typedef struct uart_baud_s
+{
+    uint16_t brr;                           // BRR register value 
+    uint16_t mantissa;                      // BRR mantissa 
+    uint8_t fraction;                       // BRR fraction 
+    uint8_t over8;                          // Oversampling by 8 (CR1 OVER8) 
+    uint32_t actual;                        // Actual baud rate 
+    int16_t error;                          // Error (hundredths of a percent) 
+}
+uart_baud_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Find the baud rate setting for a peripheral clock 
+ * 
+ * @details Only does the math so it can be checked without the hardware. 
+ * 
+ * @param pclk : UART peripheral clock (Hz) 
+ * @param baud : requested baud rate 
+ * @param setting : setting found (unchanged if FALSE is returned) 
+ * @return uint8_t : TRUE if the baud rate can be set within UART_BAUD_ERROR_MAX 
+ */
+uint8_t uart_baud_calc(
+    uint32_t pclk, 
+    uint32_t baud, 
+    uart_baud_t *setting); 
+
+
+/**
+ * @brief Peripheral clock of a UART 
+ * 
+ * @details USART1 and USART6 are on APB2 and USART2 is on APB1. 
+ * 
+ * @param uart : UART port 
+ * @return uint32_t : peripheral clock (Hz) 
+ */
+uint32_t uart_baud_pclk(USART_TypeDef *uart); 
+
+
+/**
+ * @brief Set the baud rate of an initialized UART 
+ * 
+ * @details Waits for any data being sent to finish then disables the UART while BRR 
+ *          and OVER8 are changed. The baud rate isn't changed if it can't be set within 
+ *          UART_BAUD_ERROR_MAX. 
+ * 
+ * @param uart : UART port 
+ * @param baud : requested baud rate 
+ * @param setting : setting used (can be NULL) 
+ * @return uint8_t : TRUE if the baud rate was set 
+ */
+uint8_t uart_baud_set(
+    USART_TypeDef *uart, 
+    uint32_t baud, 
+    uart_baud_t *setting); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _UART_BAUD_H_ 
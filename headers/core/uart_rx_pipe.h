@@ -0,0 +1,158 @@
+/**
+ * @file uart_rx_pipe.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief UART receive pipeline and line assembler interface 
+ * 
+ * @details Serial terminal input (USART2) is written by DMA1 Stream 5 into a circular 
+ *          buffer that is much larger than a single command. The half transfer and 
+ *          transfer complete interrupts and the UART IDLE line interrupt read how far 
+ *          the DMA has written so the received count is always up to date, no matter 
+ *          how much input arrives between main loop polls. 
+ * 
+ *          The line assembler finds lines ending in '\r' or '\n' (empty lines are 
+ *          skipped) and hands them out as slices of the circular buffer - no copy is 
+ *          made. A line that wraps around the end of the buffer is given as two parts. 
+ *          The slice stays valid until uart_rxp_line_release is called as long as the 
+ *          DMA doesn't write a full buffer of new input in that time. If it does, the 
+ *          release reports it and the overrun is counted. A line longer than the buffer 
+ *          is dropped and counted. 
+ * 
+ *          The input is read from the main loop only. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _UART_RX_PIPE_H_ 
+#define _UART_RX_PIPE_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define UART_RXP_SIZE 512                   // Circular buffer size (power of 2) 
+#define UART_RXP_UART USART2                // UART the input is read from 
+#define UART_RXP_DMA DMA1                   // DMA controller of the UART RX stream 
+#define UART_RXP_STREAM DMA1_Stream5        // USART2 RX stream 
+#define UART_RXP_CHNL DMA_CHNL_4            // USART2 RX channel 
+#define UART_RXP_PARTS 2                    // Max parts of a line slice 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Line slice - points into the circular buffer 
+typedef struct uart_rxp_line_s
+{
+    const uint8_t *data[UART_RXP_PARTS];    // Start of each part 
+    uint16_t len[UART_RXP_PARTS];           // Length of each part (0 = unused) 
+    uint16_t total;                         // Line length (terminator not included) 
+}
+uart_rxp_line_t; 
+
+
+// Pipeline statistics 
+typedef struct uart_rxp_stats_s
+{
+    uint32_t received;                      // Bytes received 
+    uint32_t lines;                         // Lines handed out 
+    uint32_t overruns;                      // Times unread input was overwritten 
+    uint32_t lost;                          // Bytes overwritten before being read 
+    uint32_t long_lines;                    // Lines dropped for being too long 
+}
+uart_rxp_stats_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Initialize the receive pipeline 
+ * 
+ * @details Configures the DMA stream in circular mode with its half transfer and 
+ *          transfer complete interrupts, enables DMA receive and the IDLE line 
+ *          interrupt on the UART and starts the stream. The UART must already be 
+ *          initialized. 
+ * 
+ * @param priority : DMA stream and UART interrupt priority 
+ */
+void uart_rxp_init(uint8_t priority); 
+
+
+/**
+ * @brief Get the next line 
+ * 
+ * @details The line stays in the circular buffer until uart_rxp_line_release is called 
+ *          and the same line is returned until then. 
+ * 
+ * @param line : slice of the line 
+ * @return uint8_t : TRUE if a line is available 
+ */
+uint8_t uart_rxp_line_get(uart_rxp_line_t *line); 
+
+
+/**
+ * @brief Release the line from uart_rxp_line_get 
+ * 
+ * @return uint8_t : TRUE if the line wasn't overwritten while it was held 
+ */
+uint8_t uart_rxp_line_release(void); 
+
+
+/**
+ * @brief Copy a line slice into a null terminated string 
+ * 
+ * @param line : line slice 
+ * @param buff : string buffer 
+ * @param size : buffer size - longer lines are cut short 
+ * @return uint16_t : string length 
+ */
+uint16_t uart_rxp_line_copy(
+    const uart_rxp_line_t *line, 
+    char *buff, 
+    uint16_t size); 
+
+
+/**
+ * @brief Read the pipeline statistics 
+ * 
+ * @param stats : copy of the statistics 
+ */
+void uart_rxp_get_stats(uart_rxp_stats_t *stats); 
+
+
+/**
+ * @brief Interrupt handler hook - called from the DMA stream and UART handlers 
+ * 
+ * @details Updates the received count from the DMA position. Does nothing if the 
+ *          pipeline isn't initialized. 
+ */
+void uart_rxp_irq_handler(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _UART_RX_PIPE_H_ 
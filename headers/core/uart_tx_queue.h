@@ -0,0 +1,176 @@
+/**
+ * @file uart_tx_queue.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Non-blocking UART transmit queue interface 
+ * 
+ * @details Serial terminal output (USART2) is copied into a ring buffer and sent by 
+ *          DMA1 Stream 6 so the caller doesn't wait for each byte to go out at the baud 
+ *          rate. When a transfer completes the stream interrupt starts the next one 
+ *          from the queued data. A transfer is the queued data up to the end of the 
+ *          ring buffer so the wrap point costs one extra transfer. 
+ * 
+ *          The policy set at init decides what happens when there isn't room for new 
+ *          data: 
+ *            - UART_TXQ_DROP : the new data is dropped 
+ *            - UART_TXQ_OVERWRITE : queued data that hasn't been handed to the DMA yet 
+ *              is dropped, oldest first, to make room 
+ *            - UART_TXQ_BLOCK : wait for room (main loop only, never in an interrupt) 
+ *          Dropped bytes are counted for either of the first two. 
+ * 
+ *          The queue is written from the main loop only. Don't mix queued output with 
+ *          uart_sendstring unless the queue has been flushed first. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _UART_TX_QUEUE_H_ 
+#define _UART_TX_QUEUE_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define UART_TXQ_SIZE 1024                  // Ring buffer size (power of 2) 
+#define UART_TXQ_UART USART2                // UART the queue sends on 
+#define UART_TXQ_DMA DMA1                   // DMA controller of the UART TX stream 
+#define UART_TXQ_STREAM DMA1_Stream6        // USART2 TX stream 
+#define UART_TXQ_CHNL DMA_CHNL_4            // USART2 TX channel 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+// Overflow policy - what to do when there's no room for new data 
+typedef enum {
+    UART_TXQ_DROP,                          // Drop the new data 
+    UART_TXQ_OVERWRITE,                     // Drop the oldest queued data 
+    UART_TXQ_BLOCK                          // Wait for room 
+} uart_txq_policy_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Queue statistics 
+typedef struct uart_txq_stats_s
+{
+    uint32_t queued;                        // Bytes added to the queue 
+    uint32_t dropped;                       // Bytes dropped (new or overwritten) 
+    uint32_t used_max;                      // Most bytes in the queue at once 
+}
+uart_txq_stats_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Initialize the transmit queue 
+ * 
+ * @details Configures the DMA stream and its transfer complete interrupt and enables DMA 
+ *          transmit on the UART. The UART must already be initialized. 
+ * 
+ * @param policy : overflow policy 
+ * @param priority : DMA stream interrupt priority 
+ */
+void uart_txq_init(
+    uart_txq_policy_t policy, 
+    uint8_t priority); 
+
+
+/**
+ * @brief Queue data to send 
+ * 
+ * @details Copies the data into the queue and starts the DMA if it's idle. Returns 
+ *          without waiting for the data to be sent unless the policy is UART_TXQ_BLOCK 
+ *          and the queue is full. 
+ * 
+ * @param data : data to send 
+ * @param len : number of bytes 
+ * @return uint16_t : number of bytes queued 
+ */
+uint16_t uart_txq_write(
+    const uint8_t *data, 
+    uint16_t len); 
+
+
+/**
+ * @brief Queue a string to send 
+ * 
+ * @see uart_txq_write 
+ * 
+ * @param string : null terminated string 
+ * @return uint16_t : number of bytes queued 
+ */
+uint16_t uart_txq_puts(const char *string); 
+
+
+/**
+ * @brief Queue an integer to send as text 
+ * 
+ * @param integer : number to send 
+ * @return uint16_t : number of bytes queued 
+ */
+uint16_t uart_txq_send_integer(int32_t integer); 
+
+
+/**
+ * @brief Wait for all queued data to be sent 
+ */
+void uart_txq_flush(void); 
+
+
+/**
+ * @brief Number of bytes waiting to be sent (including the current transfer) 
+ * 
+ * @return uint16_t : bytes in the queue 
+ */
+uint16_t uart_txq_used(void); 
+
+
+/**
+ * @brief Read the queue statistics 
+ * 
+ * @param stats : copy of the statistics 
+ */
+void uart_txq_get_stats(uart_txq_stats_t *stats); 
+
+
+/**
+ * @brief DMA stream interrupt handler - called from DMA1_Stream6_IRQHandler 
+ * 
+ * @details Clears the stream flags and starts the next transfer if there's more data. 
+ *          Does nothing if the queue isn't initialized. 
+ */
+void uart_txq_dma_handler(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _UART_TX_QUEUE_H_ 
@@ -23,6 +23,60 @@ extern "C" {
 // Includes 
 
 #include "includes_drivers.h"
+#include "cmd_registry.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// User command lists - name and callback in table order. Each list is expanded into the 
+// callback table in hw125_test.c and the command registry in hw125_test_cmds.cpp. 
+
+// Controller test commands 
+#define HW125_CONT_CMDS(CMD)                              \
+    CMD("eject",       hw125_cont_test_eject_set)         \
+    CMD("insert",      hw125_cont_test_eject_clear)       \
+    CMD("reset",       hw125_cont_test_reset_set)         \
+    CMD("make_dir",    hw125_cont_test_make_dir)          \
+    CMD("open",        hw125_cont_test_file_open)         \
+    CMD("close",       hw125_cont_test_file_close)        \
+    CMD("write",       hw125_cont_test_file_write)        \
+    CMD("puts",        hw125_cont_test_put_string)        \
+    CMD("printf",      hw125_cont_test_printf)            \
+    CMD("seek",        hw125_cont_test_file_seek)         \
+    CMD("state",       hw125_cont_test_state)             \
+    CMD("fault_code",  hw125_cont_test_fault_code)        \
+    CMD("fault_mode",  hw125_cont_test_fault_mode)        \
+    CMD("status",      hw125_cont_test_file_status)       \
+    CMD("read",        hw125_cont_test_file_read)         \
+    CMD("gets",        hw125_cont_test_get_string)        \
+    CMD("eof",         hw125_cont_test_file_end)          \
+    CMD("read_buffer", display_buffer)
+
+// Driver test commands 
+#define HW125_DRIVER_CMDS(CMD)                            \
+    CMD("f_mount",     mount_card)                        \
+    CMD("f_unmount",   unmount_card)                      \
+    CMD("f_cap",       card_capacity)                     \
+    CMD("f_check",     file_check)                        \
+    CMD("f_mkdir",     file_mkdir)                        \
+    CMD("f_open",      file_open)                         \
+    CMD("f_close",     file_close)                        \
+    CMD("f_puts",      file_put_string)                   \
+    CMD("f_gets",      file_get_string)                   \
+    CMD("f_printf",    file_printf)                       \
+    CMD("f_write",     file_write)                        \
+    CMD("f_read",      file_read)                         \
+    CMD("f_lseek",     file_seek)                         \
+    CMD("f_rewind",    file_rewind)                       \
+    CMD("f_fastfwd",   file_fast_fwd)                     \
+    CMD("f_unlink",    file_remove)                       \
+    CMD("log_bench",   file_log_bench)                    \
+    CMD("sd_bench",    file_sd_bench)                     \
+    CMD("tlog",        file_tlog)                         \
+    CMD("read_buffer", display_buffer)
 
 //=======================================================================================
 
@@ -51,6 +105,15 @@ hw125_test_drive_data_t;
 //=======================================================================================
 
 
+//=======================================================================================
+// Variables 
+
+extern const cmd_registry_t hw125_cont_cmds;      // Controller test command registry 
+extern const cmd_registry_t hw125_driver_cmds;    // Driver test command registry 
+
+//=======================================================================================
+
+
 //=======================================================================================
 // Function prototypes 
 
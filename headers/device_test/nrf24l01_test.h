@@ -23,6 +23,7 @@ extern "C" {
 // Includes 
 
 #include "includes_drivers.h" 
+#include "cmd_registry.h" 
 
 //=======================================================================================
 
@@ -32,6 +33,17 @@ extern "C" {
 
 #define NRF24L01_TEST_MAX_INPUT 32   // Max user input command length (bytes) 
 
+// Manual control test commands - name and callback in table order. Expanded into the 
+// callback table in nrf24l01_test.c and the command registry in nrf24l01_test_cmds.cpp. 
+#define NRF24L01_MC_CMDS(CMD)                             \
+    CMD("ping",      nrf24l01_test_send_ping)             \
+    CMD("channel",   nrf24l01_test_set_rf_ch)             \
+    CMD("data_rate", nrf24l01_test_set_rf_dr)             \
+    CMD("power",     nrf24l01_test_set_rf_pwr)
+
+// Expands a command list entry to its callback 
+#define NRF24L01_CMD_PTR(name, func) &func, 
+
 //=======================================================================================
 
 
@@ -50,13 +62,8 @@ typedef enum {
 //=======================================================================================
 // Structs 
 
-// Command template 
-typedef struct nrf24l01_cmds_s 
-{
-    const char *user_cmds; 
-    void (*cmd_ptr)(uint8_t, uint8_t *); 
-}
-nrf24l01_cmds_t; 
+// Command callback - positions in a callback table match the command registry 
+typedef void (*nrf24l01_cmd_ptr_t)(uint8_t, uint8_t *); 
 
 
 // User command data 
@@ -74,6 +81,14 @@ nrf24l01_cmd_data_t;
 //=======================================================================================
 
 
+//=======================================================================================
+// Variables 
+
+extern const cmd_registry_t nrf24l01_mc_cmds;     // Manual control test command registry 
+
+//=======================================================================================
+
+
 //=======================================================================================
 // Test code 
 
@@ -98,14 +113,14 @@ void nrf24l01_test_app(void);
  * @brief Check for user input and execute callbacks if a valid command arrives 
  * 
  * @param cmd_data : user command info 
- * @param cmd_table : list of commands and callbacks 
- * @param num_cmds : number of commands 
+ * @param cmds : command registry 
+ * @param cmd_ptrs : command callbacks in registry order 
  * @param cmd_arg_type : argument type to look for 
  */
 void nrf24l01_test_user_input(
     nrf24l01_cmd_data_t *cmd_data, 
-    const nrf24l01_cmds_t *cmd_table, 
-    uint8_t num_cmds, 
+    const cmd_registry_t *cmds, 
+    const nrf24l01_cmd_ptr_t *cmd_ptrs, 
     nrf24l01_cmd_arg_t cmd_arg_type); 
 
 
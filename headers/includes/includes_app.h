@@ -42,8 +42,16 @@
 #include "uart_test.h"
 
 // Tool test code 
+#include "bench_test.h" 
+#include "dlog_test.h" 
+#include "dsp_test.h" 
+#include "event_test.h" 
+#include "isr_profile_test.h" 
+#include "rc_xact_test.h" 
 #include "state_machine_test.h" 
 #include "switch_debounce_test.h" 
+#include "timer_wheel_test.h" 
+#include "uart_baud_test.h" 
 
 //=======================================================================================
 
@@ -0,0 +1,167 @@
+/**
+ * @file bench_test.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Micro-benchmark harness interface 
+ * 
+ * @details Benchmarks are registered from any test file with BENCH_REGISTER and are run 
+ *          by the bench test. Each benchmark is called a number of times to warm up the 
+ *          flash cache then timed over a set number of iterations. The min, median and 
+ *          99th percentile of the iteration times are sent to the serial terminal. 
+ * 
+ *          On the target the time is read from the DWT cycle counter (CPU cycles). The 
+ *          host build reads the time from std::chrono (nanoseconds) so the same 
+ *          benchmarks can be run on a PC. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _BENCH_TEST_H_ 
+#define _BENCH_TEST_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define BENCH_WARMUP 8                // Untimed calls before each benchmark 
+#define BENCH_ITERATIONS 200          // Timed calls of each benchmark 
+#define BENCH_ITERATIONS_MAX 256      // Sample buffer size - limit of BENCH_ITERATIONS 
+
+/**
+ * @brief Register a benchmark 
+ * 
+ * @details Adds a benchmark to the list run by the bench test. The registration runs 
+ *          before main (constructor) so benchmarks can live next to the code they 
+ *          measure. Use at file scope, once per function. 
+ * 
+ * @param name : benchmark name shown in the results (string) 
+ * @param fn : function to time - void fn(void) 
+ */
+#define BENCH_REGISTER(name, fn)                                          \
+    static bench_t bench_##fn = { name, fn, NULL };                       \
+    __attribute__((constructor)) static void bench_register_##fn(void)    \
+    {                                                                     \
+        bench_register(&bench_##fn);                                      \
+    }
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Benchmark 
+typedef struct bench_s
+{
+    const char *name;              // Name shown in the results 
+    void (*fn)(void);              // Function being timed 
+    struct bench_s *next;          // Next registered benchmark 
+}
+bench_t; 
+
+
+// Benchmark results (timer ticks) 
+typedef struct bench_result_s
+{
+    uint32_t min;                  // Fastest iteration 
+    uint32_t median;               // Median iteration 
+    uint32_t p99;                  // 99th percentile iteration 
+}
+bench_result_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Benchmark functions 
+
+/**
+ * @brief Add a benchmark to the list - called by BENCH_REGISTER 
+ * 
+ * @param bench : benchmark to add 
+ */
+void bench_register(bench_t *bench); 
+
+
+/**
+ * @brief Time a benchmark 
+ * 
+ * @details Calls the benchmark 'warmup' times without timing it then times 'iterations' 
+ *          calls. The cost of reading the timer is removed from each sample. 
+ * 
+ * @param bench : benchmark to run 
+ * @param warmup : number of untimed calls 
+ * @param iterations : number of timed calls (limited to BENCH_ITERATIONS_MAX) 
+ * @param result : min, median and 99th percentile of the timed calls 
+ */
+void bench_run(
+    const bench_t *bench, 
+    uint16_t warmup, 
+    uint16_t iterations, 
+    bench_result_t *result); 
+
+
+/**
+ * @brief Timer init - enables the DWT cycle counter on the target 
+ */
+void bench_clock_init(void); 
+
+
+/**
+ * @brief Timer count 
+ * 
+ * @return uint32_t : CPU cycles on the target, nanoseconds on the host 
+ */
+uint32_t bench_clock_now(void); 
+
+
+/**
+ * @brief Timer ticks per microsecond 
+ * 
+ * @return uint32_t : ticks/us 
+ */
+uint32_t bench_clock_ticks_per_us(void); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test code 
+
+/**
+ * @brief Bench test setup code 
+ */
+void bench_test_init(void); 
+
+
+/**
+ * @brief Bench test code 
+ * 
+ * @details Runs every registered benchmark and sends the results over USART2. Any 
+ *          serial terminal input runs the benchmarks again. 
+ */
+void bench_test_app(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _BENCH_TEST_H_ 
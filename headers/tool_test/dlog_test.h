@@ -0,0 +1,51 @@
+/**
+ * @file dlog_test.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Deferred format logging test interface 
+ * 
+ * @details Setup sends a set of messages twice, once formatted on the device ("text:") 
+ *          and once with DLOG ("dlog:"), then the number of bytes each took. Run the 
+ *          output through the host decoder (tools/dlog_decode.cpp) with the ELF file that 
+ *          was run and each "dlog:" line should match the "text:" line above it. The 
+ *          application then logs a counter every DLOG_TEST_PERIOD ms. 
+ * 
+ *          The dlog_write and snprintf benchmarks (bench_test.h) compare the cost of 
+ *          logging the wheel RPM test message each way. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _DLOG_TEST_H_ 
+#define _DLOG_TEST_H_ 
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Deferred logging test setup code 
+ */
+void dlog_test_init(void); 
+
+
+/**
+ * @brief Deferred logging test application code 
+ */
+void dlog_test_app(void); 
+
+//=======================================================================================
+
+#endif   // _DLOG_TEST_H_ 
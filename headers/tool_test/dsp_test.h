@@ -0,0 +1,58 @@
+/**
+ * @file dsp_test.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Fixed point filter test interface 
+ * 
+ * @details Setup first checks the DSP instruction operations against the plain C 
+ *          versions over a set of pseudo random inputs (only different code on the 
+ *          target with DSP_SIMD_ENABLE set). It then runs a fixed test signal (noise, a 
+ *          square wave and full scale steps) through each filter stage and a chain of 
+ *          stages in odd length blocks and compares a checksum of each output with the 
+ *          checksum from the host build. A PASS for every line means the target and 
+ *          host results are bit for bit the same. The largest difference between the 
+ *          biquad and the same filter in double precision is also shown. 
+ * 
+ *          The application then filters ADC1 channel 6 (PA6) sampled at DSP_TEST_RATE 
+ *          by adc_acq.h through a low pass biquad and a CIC decimator and shows the 
+ *          filtered value. 
+ * 
+ *          The dsp_* benchmarks (bench_test.h) time each stage over a block of samples 
+ *          along with the same biquad in float and double precision. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _DSP_TEST_H_ 
+#define _DSP_TEST_H_ 
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Fixed point filter test setup code 
+ */
+void dsp_test_init(void); 
+
+
+/**
+ * @brief Fixed point filter test application code 
+ */
+void dsp_test_app(void); 
+
+//=======================================================================================
+
+#endif   // _DSP_TEST_H_ 
@@ -0,0 +1,51 @@
+/**
+ * @file event_test.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Interrupt event word test interface 
+ * 
+ * @details Checks that no interrupt events are lost when events are set and taken at 
+ *          the same time. TIM9, TIM10 and TIM11 interrupt at the same rate while the main 
+ *          loop keeps setting and taking an event of its own in the same event word. The 
+ *          number of events taken from each timer is sent to the serial terminal and 
+ *          should never differ by more than one. 
+ * 
+ *          The host build also runs a stress test at setup where several threads set 
+ *          every event as fast as the main loop can take them. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _EVENT_TEST_H_ 
+#define _EVENT_TEST_H_ 
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Event test setup code 
+ */
+void event_test_init(void); 
+
+
+/**
+ * @brief Event test application code 
+ */
+void event_test_app(void); 
+
+//=======================================================================================
+
+#endif   // _EVENT_TEST_H_ 
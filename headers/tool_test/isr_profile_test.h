@@ -0,0 +1,59 @@
+/**
+ * @file isr_profile_test.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Interrupt handler profiler test interface 
+ * 
+ * @details Runs TIM9, TIM10 and TIM11 update interrupts at different rates and 
+ *          priorities and profiles them along with SysTick (see isr_profile.h). 
+ *          ISR_PROFILE_ENABLE must be set in system_settings.h. Serial terminal 
+ *          commands (single characters): 
+ *            d : send the profile to the serial terminal 
+ *            c : clear the profile 
+ *            s : append the profile to a file on the SD card (ISR_PROFILE_TEST_SD) 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _ISR_PROFILE_TEST_H_ 
+#define _ISR_PROFILE_TEST_H_ 
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Conditional compilation 
+#define ISR_PROFILE_TEST_SD 0         // Write the profile to the SD card (HW125 on SPI2) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief ISR profile test setup code 
+ */
+void isr_profile_test_init(void); 
+
+
+/**
+ * @brief ISR profile test application code 
+ */
+void isr_profile_test_app(void); 
+
+//=======================================================================================
+
+#endif   // _ISR_PROFILE_TEST_H_ 
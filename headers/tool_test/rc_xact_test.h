@@ -0,0 +1,57 @@
+/**
+ * @file rc_xact_test.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Radio transaction engine test interface 
+ * 
+ * @details Runs the RC test push/pop protocol (rc_test.cpp) on the transaction engine 
+ *          against a simulated system 2 instead of the radio, so it runs on the board 
+ *          or the host build without a second device. The simulated link delays each 
+ *          payload by a random time and can lose payloads in either direction. The 
+ *          peer confirms pushes, saves the pushed messages and sends the last one back 
+ *          on a pop, confirming repeated requests and messages again like system 2. 
+ * 
+ *          Random pushes and pops run back to back. Each round starts with a lossless 
+ *          phase where every transaction must complete and every pop must return the 
+ *          last message pushed, then a lossy phase where lost payloads are sent again 
+ *          by the engine and every popped message must be one that was pushed and not 
+ *          popped before. The main loop keeps running while transactions are in 
+ *          flight - the loop rate and the longest rc_xact_poll call are shown each 
+ *          second along with the transaction counts and errors. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _RC_XACT_TEST_H_ 
+#define _RC_XACT_TEST_H_ 
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Radio transaction engine test setup code 
+ */
+void rc_xact_test_init(void); 
+
+
+/**
+ * @brief Radio transaction engine test application code 
+ */
+void rc_xact_test_app(void); 
+
+//=======================================================================================
+
+#endif   // _RC_XACT_TEST_H_ 
@@ -0,0 +1,58 @@
+/**
+ * @file timer_wheel_test.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Timer wheel test interface 
+ * 
+ * @details Setup first checks the wheel logic with simulated time. A wheel of its own 
+ *          is driven tick by tick in random sized steps while timers are started and 
+ *          stopped at random with delays and periods covering every level. Each expiry 
+ *          is checked against the tick a reference copy of the timers says it's due on, 
+ *          and after every step no timer can be overdue, the expiry counts must match 
+ *          and twheel_next can't be past the earliest expiry. Timers are also restarted 
+ *          from their own callbacks. A PASS means the wheel matches the reference. 
+ * 
+ *          The application then runs timers on the hardware wheel (TIM5): a 250 ms 
+ *          periodic timer, a 1 s periodic timer and a one shot timer that restarts 
+ *          itself from its callback with a longer delay each time. The main loop sleeps 
+ *          (twheel_sleep) between expiries and shows the counts each second. 
+ * 
+ *          The twheel_* benchmarks (bench_test.h) time starting and stopping a timer 
+ *          and advancing a loaded wheel. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _TIMER_WHEEL_TEST_H_ 
+#define _TIMER_WHEEL_TEST_H_ 
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Timer wheel test setup code 
+ */
+void timer_wheel_test_init(void); 
+
+
+/**
+ * @brief Timer wheel test application code 
+ */
+void timer_wheel_test_app(void); 
+
+//=======================================================================================
+
+#endif   // _TIMER_WHEEL_TEST_H_ 
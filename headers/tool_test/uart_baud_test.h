@@ -0,0 +1,49 @@
+/**
+ * @file uart_baud_test.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief UART baud rate calculator test interface 
+ * 
+ * @details Setup runs the baud rate math over a table of peripheral clocks and baud 
+ *          rates and checks each result (divider rebuilt from BRR, closest divider 
+ *          chosen, oversampling mode and error) then sends the table and the number of 
+ *          failures to the serial terminal at 9600 baud. The math doesn't use the 
+ *          hardware so the host build checks the same table. USART2 is then switched to 
+ *          UART_BAUD_TEST_BAUD and received characters are echoed back. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _UART_BAUD_TEST_H_ 
+#define _UART_BAUD_TEST_H_ 
+
+//=======================================================================================
+// Includes 
+
+#include "includes_drivers.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief UART baud rate test setup code 
+ */
+void uart_baud_test_init(void); 
+
+
+/**
+ * @brief UART baud rate test application code 
+ */
+void uart_baud_test_app(void); 
+
+//=======================================================================================
+
+#endif   // _UART_BAUD_TEST_H_ 
@@ -0,0 +1,622 @@
+/**
+ * @file core_cm4.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Host replacement for the CMSIS Cortex-M4 core peripheral access layer 
+ * 
+ * @details The host build puts the simulator header directory ahead of the CMSIS include 
+ *          directory so that "stm32f411xe.h" picks up this file instead of the CMSIS 
+ *          original. The register layouts and base addresses match the real core so 
+ *          code that accesses NVIC, SCB, SysTick, DWT or CoreDebug registers works 
+ *          unchanged against the simulator. Core intrinsics that would otherwise be 
+ *          Thumb assembly (interrupt masking, barriers, WFI, DSP SIMD instructions) are 
+ *          implemented in portable C or routed to the simulator. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef __CORE_CM4_H_GENERIC
+#define __CORE_CM4_H_GENERIC 
+#define __CORE_CM4_H_DEPENDANT 
+
+#include <stdint.h> 
+
+#ifdef __cplusplus
+extern "C" {
+#endif 
+
+//=======================================================================================
+// Macros 
+
+//==================================================
+// Core information 
+
+#define __CM4_CMSIS_VERSION_MAIN  (5U) 
+#define __CM4_CMSIS_VERSION_SUB   (1U) 
+#define __CM4_CMSIS_VERSION       ((__CM4_CMSIS_VERSION_MAIN << 16U) | __CM4_CMSIS_VERSION_SUB) 
+#define __CORTEX_M                (4U) 
+#define __FPU_USED                1U 
+
+//==================================================
+
+
+//==================================================
+// Compiler abstraction 
+
+#ifndef __ASM
+#define __ASM                  __asm 
+#endif 
+#ifndef __INLINE
+#define __INLINE               inline 
+#endif 
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE        static inline 
+#endif 
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE   __attribute__((always_inline)) static inline 
+#endif 
+#ifndef __NO_RETURN
+#define __NO_RETURN            __attribute__((__noreturn__)) 
+#endif 
+#ifndef __USED
+#define __USED                 __attribute__((used)) 
+#endif 
+#ifndef __WEAK
+#define __WEAK                 __attribute__((weak)) 
+#endif 
+#ifndef __PACKED
+#define __PACKED               __attribute__((packed, aligned(1))) 
+#endif 
+#ifndef __PACKED_STRUCT
+#define __PACKED_STRUCT        struct __attribute__((packed, aligned(1))) 
+#endif 
+#ifndef __ALIGNED
+#define __ALIGNED(x)           __attribute__((aligned(x))) 
+#endif 
+#ifndef __RESTRICT
+#define __RESTRICT             __restrict 
+#endif 
+#ifndef __COMPILER_BARRIER
+#define __COMPILER_BARRIER()   __ASM volatile("" ::: "memory") 
+#endif 
+
+//==================================================
+
+
+//==================================================
+// IO type qualifiers 
+
+#ifdef __cplusplus
+#define __I     volatile 
+#else
+#define __I     volatile const 
+#endif 
+#define __O     volatile 
+#define __IO    volatile 
+#define __IM    volatile const 
+#define __OM    volatile 
+#define __IOM   volatile 
+
+//==================================================
+
+
+//==================================================
+// Memory map 
+
+#define SCS_BASE            (0xE000E000UL) 
+#define ITM_BASE            (0xE0000000UL) 
+#define DWT_BASE            (0xE0001000UL) 
+#define CoreDebug_BASE      (0xE000EDF0UL) 
+#define SysTick_BASE        (SCS_BASE +  0x0010UL) 
+#define NVIC_BASE           (SCS_BASE +  0x0100UL) 
+#define SCB_BASE            (SCS_BASE +  0x0D00UL) 
+#define MPU_BASE            (SCS_BASE +  0x0D90UL) 
+#define FPU_BASE            (SCS_BASE +  0x0F30UL) 
+
+#define SCnSCB              ((SCnSCB_Type    *) SCS_BASE) 
+#define SCB                 ((SCB_Type       *) SCB_BASE) 
+#define SysTick             ((SysTick_Type   *) SysTick_BASE) 
+#define NVIC                ((NVIC_Type      *) NVIC_BASE) 
+#define DWT                 ((DWT_Type       *) DWT_BASE) 
+#define CoreDebug           ((CoreDebug_Type *) CoreDebug_BASE) 
+#define MPU                 ((MPU_Type       *) MPU_BASE) 
+#define FPU                 ((FPU_Type       *) FPU_BASE) 
+
+//==================================================
+
+
+//==================================================
+// Register bit definitions 
+
+#define SCB_ICSR_PENDSVSET_Pos         28U 
+#define SCB_ICSR_PENDSVSET_Msk         (1UL << SCB_ICSR_PENDSVSET_Pos) 
+#define SCB_ICSR_PENDSTSET_Pos         26U 
+#define SCB_ICSR_PENDSTSET_Msk         (1UL << SCB_ICSR_PENDSTSET_Pos) 
+#define SCB_AIRCR_VECTKEY_Pos          16U 
+#define SCB_AIRCR_VECTKEY_Msk          (0xFFFFUL << SCB_AIRCR_VECTKEY_Pos) 
+#define SCB_AIRCR_PRIGROUP_Pos          8U 
+#define SCB_AIRCR_PRIGROUP_Msk         (7UL << SCB_AIRCR_PRIGROUP_Pos) 
+#define SCB_AIRCR_SYSRESETREQ_Pos       2U 
+#define SCB_AIRCR_SYSRESETREQ_Msk      (1UL << SCB_AIRCR_SYSRESETREQ_Pos) 
+#define SCB_SHCSR_MEMFAULTENA_Pos 16U 
+#define SCB_SHCSR_MEMFAULTENA_Msk (1UL << SCB_SHCSR_MEMFAULTENA_Pos) 
+#define SCB_SCR_SEVONPEND_Pos           4U 
+#define SCB_SCR_SEVONPEND_Msk          (1UL << SCB_SCR_SEVONPEND_Pos) 
+#define SCB_SCR_SLEEPDEEP_Pos           2U 
+#define SCB_SCR_SLEEPDEEP_Msk          (1UL << SCB_SCR_SLEEPDEEP_Pos) 
+#define SCB_SCR_SLEEPONEXIT_Pos         1U 
+#define SCB_SCR_SLEEPONEXIT_Msk        (1UL << SCB_SCR_SLEEPONEXIT_Pos) 
+
+#define SysTick_CTRL_COUNTFLAG_Pos     16U 
+#define SysTick_CTRL_COUNTFLAG_Msk     (1UL << SysTick_CTRL_COUNTFLAG_Pos) 
+#define SysTick_CTRL_CLKSOURCE_Pos      2U 
+#define SysTick_CTRL_CLKSOURCE_Msk     (1UL << SysTick_CTRL_CLKSOURCE_Pos) 
+#define SysTick_CTRL_TICKINT_Pos        1U 
+#define SysTick_CTRL_TICKINT_Msk       (1UL << SysTick_CTRL_TICKINT_Pos) 
+#define SysTick_CTRL_ENABLE_Pos         0U 
+#define SysTick_CTRL_ENABLE_Msk        (1UL) 
+#define SysTick_LOAD_RELOAD_Pos         0U 
+#define SysTick_LOAD_RELOAD_Msk        (0xFFFFFFUL) 
+#define SysTick_VAL_CURRENT_Pos         0U 
+#define SysTick_VAL_CURRENT_Msk        (0xFFFFFFUL) 
+
+#define DWT_CTRL_CYCCNTENA_Pos          0U 
+#define DWT_CTRL_CYCCNTENA_Msk         (1UL) 
+#define DWT_CTRL_NOCYCCNT_Pos          25U 
+#define DWT_CTRL_NOCYCCNT_Msk          (1UL << DWT_CTRL_NOCYCCNT_Pos) 
+
+#define CoreDebug_DEMCR_TRCENA_Pos     24U 
+#define CoreDebug_DEMCR_TRCENA_Msk     (1UL << CoreDebug_DEMCR_TRCENA_Pos) 
+
+#define MPU_CTRL_PRIVDEFENA_Pos 2U 
+#define MPU_CTRL_PRIVDEFENA_Msk (1UL << MPU_CTRL_PRIVDEFENA_Pos) 
+#define MPU_CTRL_HFNMIENA_Pos 1U 
+#define MPU_CTRL_HFNMIENA_Msk (1UL << MPU_CTRL_HFNMIENA_Pos) 
+#define MPU_CTRL_ENABLE_Pos 0U 
+#define MPU_CTRL_ENABLE_Msk (1UL) 
+#define MPU_RASR_XN_Pos 28U 
+#define MPU_RASR_AP_Pos 24U 
+#define MPU_RASR_TEX_Pos 19U 
+#define MPU_RASR_S_Pos 18U 
+#define MPU_RASR_C_Pos 17U 
+#define MPU_RASR_B_Pos 16U 
+#define MPU_RASR_SRD_Pos 8U 
+#define MPU_RASR_SIZE_Pos 1U 
+#define MPU_RASR_ENABLE_Pos 0U 
+
+#define FPU_FPCCR_ASPEN_Pos            31U 
+#define FPU_FPCCR_ASPEN_Msk            (1UL << FPU_FPCCR_ASPEN_Pos) 
+#define FPU_FPCCR_LSPEN_Pos            30U 
+#define FPU_FPCCR_LSPEN_Msk            (1UL << FPU_FPCCR_LSPEN_Pos) 
+
+//==================================================
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Register maps 
+
+// System control not in SCB 
+typedef struct
+{
+          uint32_t RESERVED0[1U]; 
+    __IM  uint32_t ICTR; 
+    __IOM uint32_t ACTLR; 
+}
+SCnSCB_Type; 
+
+
+// System control block 
+typedef struct
+{
+    __IM  uint32_t CPUID; 
+    __IOM uint32_t ICSR; 
+    __IOM uint32_t VTOR; 
+    __IOM uint32_t AIRCR; 
+    __IOM uint32_t SCR; 
+    __IOM uint32_t CCR; 
+    __IOM uint8_t  SHP[12U]; 
+    __IOM uint32_t SHCSR; 
+    __IOM uint32_t CFSR; 
+    __IOM uint32_t HFSR; 
+    __IOM uint32_t DFSR; 
+    __IOM uint32_t MMFAR; 
+    __IOM uint32_t BFAR; 
+    __IOM uint32_t AFSR; 
+    __IM  uint32_t PFR[2U]; 
+    __IM  uint32_t DFR; 
+    __IM  uint32_t ADR; 
+    __IM  uint32_t MMFR[4U]; 
+    __IM  uint32_t ISAR[5U]; 
+          uint32_t RESERVED0[5U]; 
+    __IOM uint32_t CPACR; 
+}
+SCB_Type; 
+
+
+// System timer 
+typedef struct
+{
+    __IOM uint32_t CTRL; 
+    __IOM uint32_t LOAD; 
+    __IOM uint32_t VAL; 
+    __IM  uint32_t CALIB; 
+}
+SysTick_Type; 
+
+
+// Nested vectored interrupt controller 
+typedef struct
+{
+    __IOM uint32_t ISER[8U]; 
+          uint32_t RESERVED0[24U]; 
+    __IOM uint32_t ICER[8U]; 
+          uint32_t RESERVED1[24U]; 
+    __IOM uint32_t ISPR[8U]; 
+          uint32_t RESERVED2[24U]; 
+    __IOM uint32_t ICPR[8U]; 
+          uint32_t RESERVED3[24U]; 
+    __IOM uint32_t IABR[8U]; 
+          uint32_t RESERVED4[56U]; 
+    __IOM uint8_t  IP[240U]; 
+          uint32_t RESERVED5[644U]; 
+    __OM  uint32_t STIR; 
+}
+NVIC_Type; 
+
+
+// Data watchpoint and trace 
+typedef struct
+{
+    __IOM uint32_t CTRL; 
+    __IOM uint32_t CYCCNT; 
+    __IOM uint32_t CPICNT; 
+    __IOM uint32_t EXCCNT; 
+    __IOM uint32_t SLEEPCNT; 
+    __IOM uint32_t LSUCNT; 
+    __IOM uint32_t FOLDCNT; 
+    __IM  uint32_t PCSR; 
+}
+DWT_Type; 
+
+
+// Core debug 
+typedef struct
+{
+    __IOM uint32_t DHCSR; 
+    __OM  uint32_t DCRSR; 
+    __IOM uint32_t DCRDR; 
+    __IOM uint32_t DEMCR; 
+}
+CoreDebug_Type; 
+
+
+// Memory protection unit 
+typedef struct
+{
+    __IM  uint32_t TYPE; 
+    __IOM uint32_t CTRL; 
+    __IOM uint32_t RNR; 
+    __IOM uint32_t RBAR; 
+    __IOM uint32_t RASR; 
+    __IOM uint32_t RBAR_A1; 
+    __IOM uint32_t RASR_A1; 
+    __IOM uint32_t RBAR_A2; 
+    __IOM uint32_t RASR_A2; 
+    __IOM uint32_t RBAR_A3; 
+    __IOM uint32_t RASR_A3; 
+}
+MPU_Type; 
+
+
+// Floating point unit 
+typedef struct
+{
+          uint32_t RESERVED0[1U]; 
+    __IOM uint32_t FPCCR; 
+    __IOM uint32_t FPCAR; 
+    __IOM uint32_t FPDSCR; 
+    __IM  uint32_t MVFR0; 
+    __IM  uint32_t MVFR1; 
+}
+FPU_Type; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Simulator hooks 
+
+/**
+ * @brief Set the simulated PRIMASK 
+ * 
+ * @param primask : 1 masks all configurable interrupts, 0 unmasks them 
+ */
+void sim_core_set_primask(uint32_t primask); 
+
+
+/**
+ * @brief Read the simulated PRIMASK 
+ * 
+ * @return uint32_t : current PRIMASK value 
+ */
+uint32_t sim_core_get_primask(void); 
+
+
+/**
+ * @brief Simulated wait for interrupt - advances time to the next peripheral event 
+ */
+void sim_core_wfi(void); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Core intrinsics 
+
+__STATIC_FORCEINLINE void __enable_irq(void) { sim_core_set_primask(0U); }
+__STATIC_FORCEINLINE void __disable_irq(void) { sim_core_set_primask(1U); }
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void) { return sim_core_get_primask(); }
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t primask) { sim_core_set_primask(primask); }
+__STATIC_FORCEINLINE void __NOP(void) { __COMPILER_BARRIER(); }
+__STATIC_FORCEINLINE void __WFI(void) { sim_core_wfi(); }
+__STATIC_FORCEINLINE void __WFE(void) { sim_core_wfi(); }
+__STATIC_FORCEINLINE void __SEV(void) { __COMPILER_BARRIER(); }
+__STATIC_FORCEINLINE void __ISB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+__STATIC_FORCEINLINE void __DSB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+__STATIC_FORCEINLINE void __DMB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+__STATIC_FORCEINLINE uint32_t __REV(uint32_t value) { return __builtin_bswap32(value); }
+__STATIC_FORCEINLINE uint32_t __REV16(uint32_t value)
+{
+    return ((value & 0xFF00FF00UL) >> 8U) | ((value & 0x00FF00FFUL) << 8U); 
+}
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value)
+{
+    return (value == 0U) ? 32U : (uint8_t)__builtin_clz(value); 
+}
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value)
+{
+    uint32_t result = 0U; 
+    for (uint8_t i = 0U; i < 32U; i++)
+    {
+        result = (result << 1U) | (value & 1U); 
+        value >>= 1U; 
+    }
+    return result; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// DSP intrinsics - portable equivalents of the Cortex-M4 SIMD instructions 
+
+__STATIC_FORCEINLINE int32_t __sim_sat(int64_t value, uint32_t bits)
+{
+    const int64_t max = (1LL << (bits - 1U)) - 1; 
+    const int64_t min = -(1LL << (bits - 1U)); 
+    return (int32_t)((value > max) ? max : ((value < min) ? min : value)); 
+}
+
+__STATIC_FORCEINLINE int32_t __SSAT(int32_t value, uint32_t bits)
+{
+    return __sim_sat(value, bits); 
+}
+
+__STATIC_FORCEINLINE int32_t __QADD(int32_t op1, int32_t op2)
+{
+    return __sim_sat((int64_t)op1 + op2, 32U); 
+}
+
+__STATIC_FORCEINLINE int32_t __QSUB(int32_t op1, int32_t op2)
+{
+    return __sim_sat((int64_t)op1 - op2, 32U); 
+}
+
+__STATIC_FORCEINLINE uint32_t __QADD16(uint32_t op1, uint32_t op2)
+{
+    int32_t lo = __sim_sat((int16_t)op1 + (int16_t)op2, 16U); 
+    int32_t hi = __sim_sat((int16_t)(op1 >> 16U) + (int16_t)(op2 >> 16U), 16U); 
+    return ((uint32_t)(uint16_t)hi << 16U) | (uint16_t)lo; 
+}
+
+__STATIC_FORCEINLINE uint32_t __QSUB16(uint32_t op1, uint32_t op2)
+{
+    int32_t lo = __sim_sat((int16_t)op1 - (int16_t)op2, 16U); 
+    int32_t hi = __sim_sat((int16_t)(op1 >> 16U) - (int16_t)(op2 >> 16U), 16U); 
+    return ((uint32_t)(uint16_t)hi << 16U) | (uint16_t)lo; 
+}
+
+__STATIC_FORCEINLINE uint32_t __SMLAD(uint32_t op1, uint32_t op2, uint32_t op3)
+{
+    return (uint32_t)((int32_t)op3 +
+                      (int16_t)op1 * (int16_t)op2 +
+                      (int16_t)(op1 >> 16U) * (int16_t)(op2 >> 16U)); 
+}
+
+__STATIC_FORCEINLINE uint64_t __SMLALD(uint32_t op1, uint32_t op2, uint64_t acc)
+{
+    return (uint64_t)((int64_t)acc +
+                      (int32_t)(int16_t)op1 * (int16_t)op2 +
+                      (int32_t)(int16_t)(op1 >> 16U) * (int16_t)(op2 >> 16U)); 
+}
+
+__STATIC_FORCEINLINE uint32_t __SMUAD(uint32_t op1, uint32_t op2)
+{
+    return __SMLAD(op1, op2, 0U); 
+}
+
+__STATIC_FORCEINLINE uint32_t __PKHBT(uint32_t op1, uint32_t op2, uint32_t shift)
+{
+    return (op1 & 0x0000FFFFUL) | ((op2 << shift) & 0xFFFF0000UL); 
+}
+
+__STATIC_FORCEINLINE int32_t __SMMLA(int32_t op1, int32_t op2, int32_t op3)
+{
+    return (int32_t)((((int64_t)op3 << 32) + (int64_t)op1 * op2) >> 32); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// NVIC and SysTick functions 
+
+__STATIC_INLINE void NVIC_SetPriorityGrouping(uint32_t PriorityGroup)
+{
+    uint32_t reg = SCB->AIRCR & ~(SCB_AIRCR_VECTKEY_Msk | SCB_AIRCR_PRIGROUP_Msk); 
+    SCB->AIRCR = reg | (0x5FAUL << SCB_AIRCR_VECTKEY_Pos) |
+                 ((PriorityGroup & 7UL) << SCB_AIRCR_PRIGROUP_Pos); 
+}
+
+__STATIC_INLINE uint32_t NVIC_GetPriorityGrouping(void)
+{
+    return (SCB->AIRCR & SCB_AIRCR_PRIGROUP_Msk) >> SCB_AIRCR_PRIGROUP_Pos; 
+}
+
+__STATIC_INLINE void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        NVIC->ISER[((uint32_t)IRQn) >> 5UL] = (1UL << (((uint32_t)IRQn) & 0x1FUL)); 
+    }
+}
+
+__STATIC_INLINE uint32_t NVIC_GetEnableIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        return (NVIC->ISER[((uint32_t)IRQn) >> 5UL] >> (((uint32_t)IRQn) & 0x1FUL)) & 1UL; 
+    }
+    return 0U; 
+}
+
+__STATIC_INLINE void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        NVIC->ICER[((uint32_t)IRQn) >> 5UL] = (1UL << (((uint32_t)IRQn) & 0x1FUL)); 
+    }
+}
+
+__STATIC_INLINE uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        return (NVIC->ISPR[((uint32_t)IRQn) >> 5UL] >> (((uint32_t)IRQn) & 0x1FUL)) & 1UL; 
+    }
+    return 0U; 
+}
+
+__STATIC_INLINE void NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        NVIC->ISPR[((uint32_t)IRQn) >> 5UL] = (1UL << (((uint32_t)IRQn) & 0x1FUL)); 
+    }
+}
+
+__STATIC_INLINE void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        NVIC->ICPR[((uint32_t)IRQn) >> 5UL] = (1UL << (((uint32_t)IRQn) & 0x1FUL)); 
+    }
+}
+
+__STATIC_INLINE uint32_t NVIC_GetActive(IRQn_Type IRQn)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        return (NVIC->IABR[((uint32_t)IRQn) >> 5UL] >> (((uint32_t)IRQn) & 0x1FUL)) & 1UL; 
+    }
+    return 0U; 
+}
+
+__STATIC_INLINE void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        NVIC->IP[((uint32_t)IRQn)] = (uint8_t)((priority << (8U - __NVIC_PRIO_BITS)) & 0xFFUL); 
+    }
+    else
+    {
+        SCB->SHP[(((uint32_t)IRQn) & 0xFUL) - 4UL] =
+            (uint8_t)((priority << (8U - __NVIC_PRIO_BITS)) & 0xFFUL); 
+    }
+}
+
+__STATIC_INLINE uint32_t NVIC_GetPriority(IRQn_Type IRQn)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        return ((uint32_t)NVIC->IP[((uint32_t)IRQn)] >> (8U - __NVIC_PRIO_BITS)); 
+    }
+    return ((uint32_t)SCB->SHP[(((uint32_t)IRQn) & 0xFUL) - 4UL] >> (8U - __NVIC_PRIO_BITS)); 
+}
+
+__STATIC_INLINE uint32_t NVIC_EncodePriority(
+    uint32_t PriorityGroup, 
+    uint32_t PreemptPriority, 
+    uint32_t SubPriority)
+{
+    uint32_t group = (PriorityGroup & 7UL); 
+    uint32_t preempt_bits = ((7UL - group) > (uint32_t)(__NVIC_PRIO_BITS)) ?
+                            (uint32_t)(__NVIC_PRIO_BITS) : (uint32_t)(7UL - group); 
+    uint32_t sub_bits = ((group + (uint32_t)(__NVIC_PRIO_BITS)) < 7UL) ?
+                        0UL : (uint32_t)((group - 7UL) + (uint32_t)(__NVIC_PRIO_BITS)); 
+
+    return (((PreemptPriority & ((1UL << preempt_bits) - 1UL)) << sub_bits) |
+            ((SubPriority & ((1UL << sub_bits) - 1UL)))); 
+}
+
+__STATIC_INLINE void NVIC_DecodePriority(
+    uint32_t Priority, 
+    uint32_t PriorityGroup, 
+    uint32_t *const pPreemptPriority, 
+    uint32_t *const pSubPriority)
+{
+    uint32_t group = (PriorityGroup & 7UL); 
+    uint32_t preempt_bits = ((7UL - group) > (uint32_t)(__NVIC_PRIO_BITS)) ?
+                            (uint32_t)(__NVIC_PRIO_BITS) : (uint32_t)(7UL - group); 
+    uint32_t sub_bits = ((group + (uint32_t)(__NVIC_PRIO_BITS)) < 7UL) ?
+                        0UL : (uint32_t)((group - 7UL) + (uint32_t)(__NVIC_PRIO_BITS)); 
+
+    *pPreemptPriority = (Priority >> sub_bits) & ((1UL << preempt_bits) - 1UL); 
+    *pSubPriority = Priority & ((1UL << sub_bits) - 1UL); 
+}
+
+__STATIC_INLINE void NVIC_SystemReset(void)
+{
+    SCB->AIRCR = (0x5FAUL << SCB_AIRCR_VECTKEY_Pos) | SCB_AIRCR_SYSRESETREQ_Msk; 
+    while (1) {}
+}
+
+__STATIC_INLINE uint32_t SysTick_Config(uint32_t ticks)
+{
+    if ((ticks - 1UL) > SysTick_LOAD_RELOAD_Msk)
+    {
+        return 1UL; 
+    }
+
+    SysTick->LOAD = (uint32_t)(ticks - 1UL); 
+    NVIC_SetPriority(SysTick_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL); 
+    SysTick->VAL = 0UL; 
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk |
+                    SysTick_CTRL_ENABLE_Msk; 
+    return 0UL; 
+}
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif 
+
+#endif   // __CORE_CM4_H_GENERIC 
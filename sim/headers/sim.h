@@ -0,0 +1,401 @@
+/**
+ * @file sim.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief STM32F411 peripheral simulator interface 
+ * 
+ * @details The simulator is only part of the host build (HOST_BUILD=ON). Peripheral 
+ *          register blocks are mapped at their real addresses with no access rights so 
+ *          every register access made by the drivers traps into the simulator. The 
+ *          simulator updates the peripheral models around the access, advances a 
+ *          deterministic simulated clock and delivers interrupts by calling the ISRs in 
+ *          stm32f4xx_it.c (or their test overrides) according to NVIC priority. 
+ * 
+ *          The functions below let test scenarios (and the command line script support) 
+ *          drive the outside world: GPIO input levels, bytes arriving on a UART, ADC 
+ *          channel voltages, SPI and I2C devices and timed callbacks. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _SIM_H_
+#define _SIM_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif 
+
+//=======================================================================================
+// Includes 
+
+#include "stm32f411xe.h" 
+#include <stdint.h> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Clock tree produced by SystemClock_Config (HSI -> PLL -> 84 MHz) 
+#define SIM_HCLK_HZ 84000000UL      // Core and AHB clock 
+#define SIM_PCLK1_HZ 42000000UL     // APB1 peripheral clock 
+#define SIM_PCLK2_HZ 84000000UL     // APB2 peripheral clock 
+#define SIM_TIMCLK_HZ 84000000UL    // Timer kernel clock (APB1 and APB2 timers) 
+
+// Time conversions 
+#define SIM_NS_PER_US 1000ULL 
+#define SIM_NS_PER_MS 1000000ULL 
+#define SIM_NS_PER_S 1000000000ULL 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// SPI device model - called for each frame while the device chip select is low 
+typedef struct sim_spi_device_s
+{
+    GPIO_TypeDef *cs_port;                               // Chip select port (NULL = always selected) 
+    uint8_t cs_pin;                                      // Chip select pin number 
+    uint16_t (*transfer)(void *context, uint16_t mosi);  // Exchange one frame 
+    void (*select)(void *context, uint8_t selected);     // Optional chip select edge callback 
+    void *context;                                       // Device specific data 
+    struct sim_spi_device_s *next;                       // Next device on the same bus 
+}
+sim_spi_device_t; 
+
+
+// I2C device model - addressed by its 7-bit address 
+typedef struct sim_i2c_device_s
+{
+    uint8_t address;                                     // 7-bit device address 
+    void (*start)(void *context, uint8_t read);          // Address phase matched 
+    void (*write)(void *context, uint8_t data);          // Master wrote a byte 
+    uint8_t (*read)(void *context);                      // Master reads a byte 
+    void (*stop)(void *context);                         // Stop condition 
+    void *context;                                       // Device specific data 
+    struct sim_i2c_device_s *next;                       // Next device on the same bus 
+}
+sim_i2c_device_t; 
+
+
+// Generic register file I2C device (register pointer with auto increment) 
+typedef struct sim_i2c_regfile_s
+{
+    sim_i2c_device_t device;                             // Bus attachment 
+    uint8_t regs[256];                                   // Register contents 
+    uint8_t pointer;                                     // Current register pointer 
+    uint8_t pointer_set;                                 // Pointer written in this transfer 
+    uint8_t auto_increment_mask;                         // Pointer bit that enables auto increment (0 = always) 
+}
+sim_i2c_regfile_t; 
+
+
+// Simulated radio link counters (sim_nrf24l01.c) 
+typedef struct sim_radio_stats_s
+{
+    uint64_t packets;                                    // Packets sent including retransmits 
+    uint64_t delivered;                                  // New payloads the peer received 
+    uint64_t duplicates;                                 // Retransmits the peer already had 
+    uint64_t lost;                                       // Packets lost on the way to the peer 
+    uint64_t acks_lost;                                  // ACKs lost on the way back 
+    uint64_t acks_late;                                  // ACKs later than the retransmit delay 
+    uint64_t max_rt;                                     // Payloads that used up their retries 
+    uint64_t off_channel;                                // Packets sent while the peer was elsewhere 
+    uint8_t channel;                                     // Channel of the MCU's radio 
+    uint8_t peer_channel;                                // Channel of the peer radio 
+}
+sim_radio_stats_t; 
+
+
+// Simulated SD card counters (sim_sd.c) 
+typedef struct sim_sd_stats_s
+{
+    uint64_t reads;                                      // Read commands 
+    uint64_t writes;                                     // Write commands 
+    uint64_t sectors_read;                               // Sectors read 
+    uint64_t sectors_written;                            // Sectors written 
+    uint64_t erase_changes;                              // Writes that opened another erase block 
+    uint64_t busy_ns;                                    // Time busy after writes 
+    uint64_t failures;                                   // Injected read and write failures 
+}
+sim_sd_stats_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Time 
+
+/**
+ * @brief Current simulated time 
+ * 
+ * @return uint64_t : nanoseconds since reset 
+ */
+uint64_t sim_time_ns(void); 
+
+
+/**
+ * @brief Advance simulated time, running peripheral models and interrupts on the way 
+ * 
+ * @param ns : nanoseconds to advance 
+ */
+void sim_advance_ns(uint64_t ns); 
+
+
+/**
+ * @brief Schedule a callback at an absolute simulated time 
+ * 
+ * @details Callbacks run from the simulator (like hardware events) so they must only 
+ *          touch peripherals through the sim_* functions and never through the 
+ *          register addresses. 
+ * 
+ * @param time_ns : absolute time to run the callback 
+ * @param callback : function to run 
+ * @param context : argument passed to the callback 
+ */
+void sim_schedule(uint64_t time_ns, void (*callback)(void *context), void *context); 
+
+
+/**
+ * @brief Number of times an interrupt handler has been called 
+ * 
+ * @param irqn : interrupt number (SysTick_IRQn is supported) 
+ * @return uint64_t : handler call count 
+ */
+uint64_t sim_irq_count(IRQn_Type irqn); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Peripheral stimulus 
+
+/**
+ * @brief Drive an external level onto a GPIO pin 
+ * 
+ * @details The level is seen in IDR when the pin is an input and generates EXTI edges. 
+ * 
+ * @param gpio : GPIO port 
+ * @param pin : pin number (0-15) 
+ * @param level : 0 or 1 
+ */
+void sim_gpio_input(GPIO_TypeDef *gpio, uint8_t pin, uint8_t level); 
+
+
+/**
+ * @brief Stop driving a GPIO pin so it falls back to its pull resistor 
+ * 
+ * @param gpio : GPIO port 
+ * @param pin : pin number (0-15) 
+ */
+void sim_gpio_release(GPIO_TypeDef *gpio, uint8_t pin); 
+
+
+/**
+ * @brief Drive a square wave onto a GPIO pin 
+ * 
+ * @details The pin is driven low then toggles every half period, so each pulse is a 
+ *          rising edge followed by a falling edge. Starting a new train on the same pin 
+ *          replaces the old one. 
+ * 
+ * @param gpio : GPIO port 
+ * @param pin : pin number (0-15) 
+ * @param hz : pulse frequency (0 stops the train and holds the pin level) 
+ * @param count : number of pulses (0 runs until stopped) 
+ */
+void sim_gpio_pulse(GPIO_TypeDef *gpio, uint8_t pin, uint32_t hz, uint32_t count); 
+
+
+/**
+ * @brief Read the level the MCU is driving on a pin 
+ * 
+ * @param gpio : GPIO port 
+ * @param pin : pin number (0-15) 
+ * @return uint8_t : ODR bit of the pin 
+ */
+uint8_t sim_gpio_output(GPIO_TypeDef *gpio, uint8_t pin); 
+
+
+/**
+ * @brief Register a callback for GPIO output level changes 
+ * 
+ * @param callback : called with the port, pin and new level 
+ * @param context : argument passed to the callback 
+ */
+void sim_gpio_listen(
+    void (*callback)(void *context, GPIO_TypeDef *gpio, uint8_t pin, uint8_t level), 
+    void *context); 
+
+
+/**
+ * @brief Queue bytes on the receive line of a USART 
+ * 
+ * @details Bytes arrive back to back at the configured baud rate followed by an idle 
+ *          line. If receiver DMA is enabled they are moved by the DMA stream that has the 
+ *          USART data register as its peripheral address. 
+ * 
+ * @param usart : USART instance 
+ * @param data : bytes to receive 
+ * @param len : number of bytes 
+ */
+void sim_usart_rx(USART_TypeDef *usart, const uint8_t *data, uint32_t len); 
+
+
+/**
+ * @brief Route the bytes a USART transmits to a callback 
+ * 
+ * @details USART2 (the ST-Link virtual COM port) is routed to stdout by default. 
+ * 
+ * @param usart : USART instance 
+ * @param sink : called for every transmitted byte (NULL discards) 
+ * @param context : argument passed to the sink 
+ */
+void sim_usart_tx_sink(
+    USART_TypeDef *usart, 
+    void (*sink)(void *context, uint8_t data), 
+    void *context); 
+
+
+/**
+ * @brief Set the value an ADC channel converts to 
+ * 
+ * @param channel : ADC channel (0-18) 
+ * @param value : 12-bit conversion result 
+ */
+void sim_adc_input(uint8_t channel, uint16_t value); 
+
+
+/**
+ * @brief Attach a device model to a SPI bus 
+ * 
+ * @param spi : SPI instance 
+ * @param device : device model (must stay valid while attached) 
+ */
+void sim_spi_attach(SPI_TypeDef *spi, sim_spi_device_t *device); 
+
+
+/**
+ * @brief Attach a device model to an I2C bus 
+ * 
+ * @param i2c : I2C instance 
+ * @param device : device model (must stay valid while attached) 
+ */
+void sim_i2c_attach(I2C_TypeDef *i2c, sim_i2c_device_t *device); 
+
+
+/**
+ * @brief Initialize and attach a register file I2C device 
+ * 
+ * @param i2c : I2C instance 
+ * @param regfile : register file instance 
+ * @param address : 7-bit device address 
+ * @param auto_increment_mask : register pointer bit that enables auto increment 
+ */
+void sim_i2c_regfile_attach(
+    I2C_TypeDef *i2c, 
+    sim_i2c_regfile_t *regfile, 
+    uint8_t address, 
+    uint8_t auto_increment_mask); 
+
+
+/**
+ * @brief Set up the link between the nRF24L01 on SPI2 and the simulated peer radio 
+ * 
+ * @details Packets and ACKs are each lost with the given probability and each trip 
+ *          through the air takes the extra latency on top of the packet's air time. 
+ *          The default is a perfect link. 
+ * 
+ * @param loss_percent : chance of losing a packet or ACK (0-100) 
+ * @param latency_ns : extra delay each way 
+ * @param seed : random seed for the losses 
+ */
+void sim_radio_link(double loss_percent, uint64_t latency_ns, uint64_t seed); 
+
+
+/**
+ * @brief Make a range of the simulated radio's channels busy 
+ * 
+ * @details Stands in for other traffic on the channels. A busy channel sets RPD and 
+ *          loses packets and ACKs with the given probability. 
+ * 
+ * @param first : first channel 
+ * @param last : last channel 
+ * @param percent : chance of the channel being in use (0-100) 
+ */
+void sim_radio_busy(uint8_t first, uint8_t last, double percent); 
+
+
+/**
+ * @brief Lose the simulated peer's ACKs 
+ * 
+ * @details ACKs are lost with the given probability on top of the link loss while the 
+ *          packets still arrive, which is the case where only the sender thinks a 
+ *          packet was lost. 
+ * 
+ * @param percent : chance of losing an ACK (0-100) 
+ */
+void sim_radio_ack_loss(double percent); 
+
+
+/**
+ * @brief Read the simulated radio link counters 
+ * 
+ * @param stats : counters 
+ */
+void sim_radio_stats(sim_radio_stats_t *stats); 
+
+
+/**
+ * @brief Insert a simulated SD card backed by a FAT image file 
+ * 
+ * @details FatFs reads and writes the image's sectors through the card (the disk 
+ *          driver in sim_sd.c). Without an image the card reads as not inserted. 
+ * 
+ * @param path : image file (a whole number of 512 byte sectors) 
+ * @return uint8_t : 1 if the image was opened 
+ */
+uint8_t sim_sd_image(const char *path); 
+
+
+/**
+ * @brief Set the simulated SD card's timing 
+ * 
+ * @param cmd_ns : overhead per read or write command 
+ * @param busy_ns : busy time after each write command 
+ * @param erase_ns : extra busy time when a write opens another erase block 
+ * @param erase_sectors : erase block size (sectors) 
+ */
+void sim_sd_timing(uint64_t cmd_ns, uint64_t busy_ns, uint64_t erase_ns, uint32_t erase_sectors); 
+
+
+/**
+ * @brief Make the simulated SD card's reads and writes fail at random 
+ * 
+ * @param percent : chance of a command failing (0-100) 
+ * @param seed : random seed for the failures 
+ */
+void sim_sd_fail(double percent, uint64_t seed); 
+
+
+/**
+ * @brief Read the simulated SD card counters 
+ * 
+ * @param stats : counters 
+ */
+void sim_sd_stats(sim_sd_stats_t *stats); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif 
+
+#endif   // _SIM_H_ 
@@ -0,0 +1,99 @@
+/**
+ * @file sim_core.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Simulator core run control and statistics 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _SIM_CORE_H_
+#define _SIM_CORE_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif 
+
+//=======================================================================================
+// Includes 
+
+#include <stdint.h> 
+#include <time.h> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Run statistics 
+typedef struct sim_core_stats_s
+{
+    uint64_t accesses;                 // Register accesses trapped 
+    uint64_t loops;                    // Main loop passes 
+    uint64_t skipped_ns;               // Time skipped by poll and idle acceleration 
+    uint64_t sleep_ns;                 // Time spent in WFI 
+    uint64_t wfi;                      // WFI calls 
+    uint64_t watchdog_steps;           // Times the wall clock watchdog moved time 
+    uint64_t end_ns;                   // Simulated time at the end of the run 
+    struct timespec wall_start;        // Host time at start up 
+}
+sim_core_stats_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+/**
+ * @brief Advance simulated time to an absolute time 
+ * 
+ * @param target : time (ns) to advance to 
+ */
+void sim_core_advance_to(uint64_t target); 
+
+
+/**
+ * @brief Stop the run once simulated time reaches a limit 
+ * 
+ * @param limit_ns : end of run time (ns) 
+ */
+void sim_core_set_time_limit(uint64_t limit_ns); 
+
+
+/**
+ * @brief End the run and print the summary 
+ * 
+ * @param reason : why the run ended 
+ */
+void sim_core_finish(const char *reason) __attribute__((noreturn)); 
+
+
+/**
+ * @brief Run summary - defined by the start up code 
+ * 
+ * @param reason : why the run ended 
+ */
+void sim_core_report(const char *reason); 
+
+
+/**
+ * @brief Run statistics 
+ * 
+ * @return const sim_core_stats_t* : statistics record 
+ */
+const sim_core_stats_t *sim_core_stats(void); 
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif 
+
+#endif   // _SIM_CORE_H_ 
@@ -0,0 +1,210 @@
+/**
+ * @file sim_model.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Peripheral model interface used inside the simulator 
+ * 
+ * @details Each peripheral instance registers a model that covers its register block. 
+ *          Register storage lives in shared memory that is mapped twice: once at the 
+ *          real peripheral address (protected so the application traps) and once at an 
+ *          alias address the models use freely. Models see the application's accesses 
+ *          through the hooks below and report interrupt request levels to the NVIC. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _SIM_MODEL_H_
+#define _SIM_MODEL_H_ 
+
+#ifdef __cplusplus
+extern "C" {
+#endif 
+
+//=======================================================================================
+// Includes 
+
+#include "sim.h" 
+#include <stddef.h> 
+#include <stdio.h> 
+#include <string.h> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Alias (untrapped) view of a peripheral register block, e.g. SIM_ALIAS(TIM9)->CNT 
+#define SIM_ALIAS(periph) ((__typeof__(periph))sim_alias((uint32_t)(uintptr_t)(periph))) 
+
+// Alias view of a register given its bus address 
+#define SIM_REG(addr) (*(volatile uint32_t *)sim_alias((uint32_t)(addr))) 
+
+// Model registration at start up (after the memory map exists, before main) 
+#define SIM_MODEL_INIT __attribute__((constructor(102))) 
+
+#define SIM_NEVER UINT64_MAX   // next_event return value when no event is pending 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+typedef struct sim_model_s sim_model_t; 
+
+// Peripheral model 
+struct sim_model_s
+{
+    const char *name;                 // Peripheral name for diagnostics 
+    uint32_t base;                    // Register block bus address 
+    uint32_t size;                    // Register block size (bytes) 
+    void *instance;                   // Model state 
+
+    // Reset the register block (alias memory is zeroed beforehand) 
+    void (*reset)(sim_model_t *model); 
+
+    // Before the application reads a register - refresh computed values 
+    void (*read)(sim_model_t *model, uint32_t offset); 
+
+    // After the application read a register - read side effects (flag clearing) 
+    void (*read_done)(sim_model_t *model, uint32_t offset); 
+
+    // After the application wrote a register - 'value' is what was written and is 
+    // already in the register, 'old_value' is the register content before the write 
+    void (*write)(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value); 
+
+    // Bring the model up to the given time 
+    void (*advance)(sim_model_t *model, uint64_t now_ns); 
+
+    // Time of the next internal event (SIM_NEVER if none) 
+    uint64_t (*next_event)(sim_model_t *model, uint64_t now_ns); 
+
+    // Longest time a poll loop on this register may be skipped ahead (0 = no limit) 
+    uint64_t (*poll_limit)(sim_model_t *model, uint32_t offset); 
+
+    // Recompute interrupt request lines (sim_nvic_level) 
+    void (*update_irq)(sim_model_t *model); 
+
+    uint8_t id;                       // Assigned at registration 
+    sim_model_t *next;                // Model list 
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Core services for models 
+
+/**
+ * @brief Register a peripheral model 
+ * 
+ * @param model : model descriptor (static storage) 
+ */
+void sim_model_register(sim_model_t *model); 
+
+
+/**
+ * @brief Alias address of a peripheral, bit-band or core register 
+ * 
+ * @param addr : bus address 
+ * @return void* : host pointer to the untrapped register storage 
+ */
+void *sim_alias(uint32_t addr); 
+
+
+/**
+ * @brief Drive an interrupt request line from a model 
+ * 
+ * @details Lines are level sensitive. Each model drives its own input to the line so 
+ *          shared vectors (e.g. TIM1_UP_TIM10) are the OR of their sources. 
+ * 
+ * @param model : model driving the line 
+ * @param irqn : interrupt number 
+ * @param level : request asserted 
+ */
+void sim_nvic_level(sim_model_t *model, IRQn_Type irqn, uint8_t level); 
+
+
+/**
+ * @brief Peripheral to memory DMA request 
+ * 
+ * @param periph_addr : peripheral data register address 
+ * @param data : data read from the peripheral 
+ * @return uint8_t : 1 if an enabled stream took the data 
+ */
+uint8_t sim_dma_p2m(uint32_t periph_addr, uint32_t data); 
+
+
+/**
+ * @brief Memory to peripheral DMA request 
+ * 
+ * @param periph_addr : peripheral data register address 
+ * @param data : data for the peripheral 
+ * @return uint8_t : 1 if an enabled stream supplied data 
+ */
+uint8_t sim_dma_m2p(uint32_t periph_addr, uint32_t *data); 
+
+
+/**
+ * @brief Check if an enabled DMA stream serves a peripheral address 
+ * 
+ * @param periph_addr : peripheral data register address 
+ * @return uint8_t : 1 if a stream is enabled for the address 
+ */
+uint8_t sim_dma_active(uint32_t periph_addr); 
+
+
+/**
+ * @brief Timer trigger output event (used by ADC external triggers) 
+ * 
+ * @param tim : timer that generated TRGO 
+ */
+void sim_adc_timer_trigger(TIM_TypeDef *tim); 
+
+
+/**
+ * @brief Report a simulator diagnostic on stderr 
+ * 
+ * @param fmt : printf style format 
+ */
+void sim_log(const char *fmt, ...) __attribute__((format(printf, 1, 2))); 
+
+
+/**
+ * @brief Convert a time in nanoseconds to clock cycles since reset 
+ * 
+ * @param ns : time 
+ * @param hz : clock frequency 
+ * @return uint64_t : number of whole clock cycles 
+ */
+static inline uint64_t sim_ns_to_cycles(uint64_t ns, uint64_t hz)
+{
+    return (uint64_t)(__extension__ ((unsigned __int128)ns * hz) / SIM_NS_PER_S); 
+}
+
+
+/**
+ * @brief Time of a clock edge given a cycle count 
+ * 
+ * @param cycles : clock cycles since reset 
+ * @param hz : clock frequency 
+ * @return uint64_t : first time (ns) at which the cycle count is reached 
+ */
+static inline uint64_t sim_cycles_to_ns(uint64_t cycles, uint64_t hz)
+{
+    return (uint64_t)(__extension__ ((unsigned __int128)cycles * SIM_NS_PER_S + hz - 1) / hz); 
+}
+
+//=======================================================================================
+
+#ifdef __cplusplus
+}
+#endif 
+
+#endif   // _SIM_MODEL_H_ 
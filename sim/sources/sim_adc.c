@@ -0,0 +1,357 @@
+/**
+ * @file sim_adc.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief ADC1 model (regular group) 
+ * 
+ * @details Conversions are started by SWSTART or by a timer trigger output selected 
+ *          with EXTSEL. Each conversion takes the programmed sampling time plus 12 ADC 
+ *          clock cycles. Results come from the values set with sim_adc_input and are 
+ *          scaled to the configured resolution. Scan, continuous and DMA modes are 
+ *          supported. Injected conversions and the analog watchdog are not modelled. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sim_model.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SIM_ADC_CHANNELS 19U 
+
+// EXTSEL codes of the timer trigger outputs 
+#define SIM_ADC_EXTSEL_TIM2_TRGO 0x6U 
+#define SIM_ADC_EXTSEL_TIM3_TRGO 0x8U 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// ADC state 
+typedef struct sim_adc_s
+{
+    uint16_t inputs[SIM_ADC_CHANNELS];  // Analog input of each channel (12-bit scale) 
+    uint8_t converting;                 // Conversion in progress 
+    uint8_t rank;                       // Sequence rank being converted 
+    uint64_t done_ns;                   // End of the current conversion 
+}
+sim_adc_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Globals 
+
+static sim_adc_t sim_adc_state; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helpers 
+
+// Channel converted at a sequence rank 
+static uint8_t sim_adc_channel(ADC_TypeDef *adc, uint8_t rank)
+{
+    uint32_t sqr = (rank < 6U) ? adc->SQR3 : ((rank < 12U) ? adc->SQR2 : adc->SQR1); 
+    return (uint8_t)((sqr >> ((rank % 6U) * 5U)) & 0x1FU); 
+}
+
+
+// Number of conversions in the regular sequence 
+static uint8_t sim_adc_length(ADC_TypeDef *adc)
+{
+    if (!(adc->CR1 & ADC_CR1_SCAN))
+    {
+        return 1; 
+    }
+
+    return (uint8_t)(((adc->SQR1 & ADC_SQR1_L) >> ADC_SQR1_L_Pos) + 1U); 
+}
+
+
+// Duration of one conversion of a channel 
+static uint64_t sim_adc_conversion_ns(ADC_TypeDef *adc, uint8_t channel)
+{
+    static const uint32_t sample_cycles[8] = { 3, 15, 28, 56, 84, 112, 144, 480 }; 
+    ADC_Common_TypeDef *common = SIM_ALIAS(ADC1_COMMON); 
+    uint32_t prescaler = 2U * ((((common->CCR & ADC_CCR_ADCPRE) >> ADC_CCR_ADCPRE_Pos)) + 1U); 
+    uint32_t smp = (channel < 10U) ? (adc->SMPR2 >> (channel * 3U)) :
+                                     (adc->SMPR1 >> ((channel - 10U) * 3U)); 
+    uint64_t cycles = sample_cycles[smp & 7U] + 12U; 
+
+    return sim_cycles_to_ns(cycles, SIM_PCLK2_HZ / prescaler); 
+}
+
+
+// Begin converting the channel at the current rank 
+static void sim_adc_start(ADC_TypeDef *adc, uint64_t now_ns)
+{
+    sim_adc_t *state = &sim_adc_state; 
+
+    state->converting = 1; 
+    state->done_ns = now_ns +
+        sim_adc_conversion_ns(adc, sim_adc_channel(adc, state->rank)); 
+    adc->SR |= ADC_SR_STRT; 
+}
+
+
+// Start a regular sequence 
+static void sim_adc_start_sequence(ADC_TypeDef *adc)
+{
+    if (!(adc->CR2 & ADC_CR2_ADON) || sim_adc_state.converting)
+    {
+        return; 
+    }
+
+    sim_adc_state.rank = 0; 
+    sim_adc_start(adc, sim_time_ns()); 
+}
+
+
+// Store a finished conversion 
+static void sim_adc_complete(ADC_TypeDef *adc, uint64_t now_ns)
+{
+    sim_adc_t *state = &sim_adc_state; 
+    uint8_t channel = sim_adc_channel(adc, state->rank); 
+    uint32_t resolution = (adc->CR1 & ADC_CR1_RES) >> ADC_CR1_RES_Pos; 
+    uint32_t value = (channel < SIM_ADC_CHANNELS) ? state->inputs[channel] : 0; 
+    uint8_t last = (uint8_t)((state->rank + 1U) >= sim_adc_length(adc)); 
+
+    value = (value & 0x0FFFU) >> (resolution * 2U); 
+
+    if (adc->CR2 & ADC_CR2_ALIGN)
+    {
+        value <<= 4U + (resolution * 2U); 
+    }
+
+    adc->DR = value; 
+    state->converting = 0; 
+
+    if ((adc->CR2 & ADC_CR2_DMA) && !(adc->SR & ADC_SR_OVR))
+    {
+        // The DMA reads DR straight away - EOC never stays set 
+        if (!sim_dma_p2m((uint32_t)(uintptr_t)&ADC1->DR, value))
+        {
+            if (adc->SR & ADC_SR_EOC)
+            {
+                adc->SR |= ADC_SR_OVR; 
+                return; 
+            }
+
+            adc->SR |= ADC_SR_EOC; 
+        }
+    }
+    else
+    {
+        if ((adc->SR & ADC_SR_EOC) && (adc->CR2 & ADC_CR2_EOCS))
+        {
+            adc->SR |= ADC_SR_OVR; 
+        }
+
+        if ((adc->CR2 & ADC_CR2_EOCS) || last)
+        {
+            adc->SR |= ADC_SR_EOC; 
+        }
+    }
+
+    if (!last)
+    {
+        state->rank++; 
+        sim_adc_start(adc, now_ns); 
+    }
+    else if (adc->CR2 & ADC_CR2_CONT)
+    {
+        state->rank = 0; 
+        sim_adc_start(adc, now_ns); 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Model 
+
+static void sim_adc_advance(sim_model_t *model, uint64_t now_ns)
+{
+    ADC_TypeDef *adc = SIM_ALIAS(ADC1); 
+    (void)model; 
+
+    while (sim_adc_state.converting && (sim_adc_state.done_ns <= now_ns))
+    {
+        sim_adc_complete(adc, sim_adc_state.done_ns); 
+    }
+}
+
+
+static uint64_t sim_adc_next_event(sim_model_t *model, uint64_t now_ns)
+{
+    (void)model; 
+    (void)now_ns; 
+    return sim_adc_state.converting ? sim_adc_state.done_ns : SIM_NEVER; 
+}
+
+
+static uint64_t sim_adc_poll_limit(sim_model_t *model, uint32_t offset)
+{
+    uint64_t now = sim_time_ns(); 
+    (void)model; 
+    (void)offset; 
+
+    if (sim_adc_state.converting && (sim_adc_state.done_ns > now))
+    {
+        return sim_adc_state.done_ns - now; 
+    }
+
+    return 0; 
+}
+
+
+static void sim_adc_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    ADC_TypeDef *adc = SIM_ALIAS(ADC1); 
+    (void)model; 
+
+    switch (offset)
+    {
+        case offsetof(ADC_TypeDef, SR):
+            // rc_w0 flags 
+            adc->SR = old_value & value; 
+            break; 
+
+        case offsetof(ADC_TypeDef, CR2):
+            if (!(value & ADC_CR2_ADON))
+            {
+                sim_adc_state.converting = 0; 
+            }
+
+            if (value & ADC_CR2_SWSTART)
+            {
+                adc->CR2 &= ~ADC_CR2_SWSTART; 
+                sim_adc_start_sequence(adc); 
+            }
+            break; 
+
+        case offsetof(ADC_TypeDef, DR):
+            adc->DR = old_value; 
+            break; 
+
+        default:
+            break; 
+    }
+}
+
+
+static void sim_adc_read_done(sim_model_t *model, uint32_t offset)
+{
+    (void)model; 
+
+    if (offset == offsetof(ADC_TypeDef, DR))
+    {
+        SIM_ALIAS(ADC1)->SR &= ~ADC_SR_EOC; 
+    }
+}
+
+
+static void sim_adc_update_irq(sim_model_t *model)
+{
+    ADC_TypeDef *adc = SIM_ALIAS(ADC1); 
+    uint32_t sr = adc->SR; 
+    uint32_t cr1 = adc->CR1; 
+
+    sim_nvic_level(model, ADC_IRQn, 
+                   ((sr & ADC_SR_EOC) && (cr1 & ADC_CR1_EOCIE)) ||
+                   ((sr & ADC_SR_OVR) && (cr1 & ADC_CR1_OVRIE))); 
+}
+
+
+static void sim_adc_reset(sim_model_t *model)
+{
+    (void)model; 
+
+    sim_adc_state.converting = 0; 
+    sim_adc_state.rank = 0; 
+}
+
+
+static sim_model_t sim_adc_model =
+{
+    .name = "ADC1", 
+    .base = ADC1_BASE, 
+    .size = 0x400U, 
+    .reset = sim_adc_reset, 
+    .read_done = sim_adc_read_done, 
+    .write = sim_adc_write, 
+    .advance = sim_adc_advance, 
+    .next_event = sim_adc_next_event, 
+    .poll_limit = sim_adc_poll_limit, 
+    .update_irq = sim_adc_update_irq
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// External triggers 
+
+// Timer trigger output 
+void sim_adc_timer_trigger(TIM_TypeDef *tim)
+{
+    ADC_TypeDef *adc = SIM_ALIAS(ADC1); 
+    uint32_t extsel = (adc->CR2 & ADC_CR2_EXTSEL) >> ADC_CR2_EXTSEL_Pos; 
+
+    if (!(adc->CR2 & ADC_CR2_EXTEN))
+    {
+        return; 
+    }
+
+    if (((tim == TIM2) && (extsel == SIM_ADC_EXTSEL_TIM2_TRGO)) ||
+        ((tim == TIM3) && (extsel == SIM_ADC_EXTSEL_TIM3_TRGO)))
+    {
+        sim_adc_start_sequence(adc); 
+    }
+}
+
+
+// Set the analog level of a channel 
+void sim_adc_input(uint8_t channel, uint16_t value)
+{
+    if (channel < SIM_ADC_CHANNELS)
+    {
+        sim_adc_state.inputs[channel] = value & 0x0FFFU; 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Registration 
+
+SIM_MODEL_INIT static void sim_adc_init(void)
+{
+    // Temperature sensor (25 C), internal reference (1.21 V) and VBAT / 4 at 3.3 V 
+    sim_adc_state.inputs[16] = 943; 
+    sim_adc_state.inputs[17] = 1502; 
+    sim_adc_state.inputs[18] = 1024; 
+
+    sim_model_register(&sim_adc_model); 
+}
+
+//=======================================================================================
@@ -0,0 +1,1510 @@
+/**
+ * @file sim_core.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Simulator core - register trapping, simulated time and interrupt delivery 
+ * 
+ * @details Register blocks are backed by a memfd mapped twice. The mapping at the real 
+ *          bus address has no access rights so every application access raises SIGSEGV. 
+ *          The handler lets time pass for the access, refreshes the register through the 
+ *          peripheral model, opens the page and single steps the faulting instruction 
+ *          (x86 trap flag). The following SIGTRAP closes the page again, hands written 
+ *          values to the model and takes any interrupt that became pending. 
+ * 
+ *          Time only moves at register accesses, at the main loop hook and at WFI, so a 
+ *          run is repeatable as long as the application does not spin on RAM alone. A 
+ *          wall clock watchdog moves time forward in that case (counted in the summary 
+ *          because it makes the run timing dependent). 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#define _GNU_SOURCE 
+
+#include "sim_model.h" 
+#include "sim_core.h" 
+
+#include <signal.h> 
+#include <stdarg.h> 
+#include <stdlib.h> 
+#include <sys/mman.h> 
+#include <sys/time.h> 
+#include <time.h> 
+#include <ucontext.h> 
+#include <unistd.h> 
+
+#if !defined(__x86_64__) || !defined(__linux__)
+#error "The peripheral simulator supports x86-64 Linux hosts only" 
+#endif 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SIM_NOINSTR __attribute__((no_instrument_function)) 
+
+#define SIM_PAGE_SIZE 0x1000U 
+#define SIM_WRITE_WORDS_MAX 16U         // Words one instruction can write (vector stores) 
+#define SIM_EFLAGS_TF 0x100UL           // x86 trap flag (single step) 
+#define SIM_PF_WRITE 0x2UL              // Page fault error code write bit 
+
+#define SIM_ACCESS_NS 24ULL             // Time for one bus access (~2 core cycles) 
+#define SIM_LOOP_NS 1000ULL             // Time for one pass of the main loop 
+#define SIM_POLL_THRESHOLD 8U           // Identical reads before a poll loop is skipped 
+#define SIM_POLL_FRACTION 16U           // Skip 1/16 of the time already spent polling 
+#define SIM_POLL_MAX_NS (SIM_NS_PER_MS) // Longest single skip 
+#define SIM_WATCHDOG_PERIOD_US 1000     // Wall time without progress before time is forced 
+#define SIM_WATCHDOG_MAX_NS (100ULL * SIM_NS_PER_MS) 
+
+#define SIM_IRQ_NUM 96U 
+#define SIM_PRIO_THREAD 0x100U          // Execution priority of thread mode 
+#define SIM_MAX_MODELS 64U 
+
+// Core register offsets (SCS block) 
+#define SIM_SCS_STK_CTRL 0x010U 
+#define SIM_SCS_STK_LOAD 0x014U 
+#define SIM_SCS_STK_VAL 0x018U 
+#define SIM_SCS_ISER 0x100U 
+#define SIM_SCS_ICER 0x180U 
+#define SIM_SCS_ISPR 0x200U 
+#define SIM_SCS_ICPR 0x280U 
+#define SIM_SCS_IABR 0x300U 
+#define SIM_SCS_IP 0x400U 
+#define SIM_SCS_CPUID 0xD00U 
+#define SIM_SCS_ICSR 0xD04U 
+#define SIM_SCS_AIRCR 0xD0CU 
+#define SIM_SCS_SHP 0xD18U 
+#define SIM_SCS_STIR 0xF00U 
+
+#define SIM_SCB_ICSR_PENDSVCLR (1UL << 27) 
+#define SIM_SCB_ICSR_PENDSTCLR (1UL << 25) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Doubly mapped register memory region 
+typedef struct sim_region_s
+{
+    uint32_t base;                     // Bus address 
+    uint32_t size;                     // Region size (bytes) 
+    uint8_t *alias;                    // Untrapped mapping 
+}
+sim_region_t; 
+
+
+// Register access in progress (between SIGSEGV and SIGTRAP) 
+typedef struct sim_access_s
+{
+    uint8_t active;                    // Faulting instruction is being single stepped 
+    uint8_t write;                     // Access is a write 
+    uint8_t bitband;                   // Access is to the bit-band alias 
+    uint32_t addr;                     // Word aligned bus address that faulted 
+    uint32_t page;                     // Bus address of the opened page 
+    sim_region_t *region;              // Region of the page 
+    uint32_t snapshot[SIM_PAGE_SIZE / sizeof(uint32_t)];   // Page content before the access 
+}
+sim_access_t; 
+
+
+// Timed callback 
+typedef struct sim_event_s
+{
+    uint64_t time; 
+    void (*callback)(void *context); 
+    void *context; 
+}
+sim_event_t; 
+
+
+// NVIC and system exception state 
+typedef struct sim_nvic_s
+{
+    uint64_t level[SIM_IRQ_NUM];       // Asserted sources per line (bit = model id) 
+    uint32_t pending[SIM_IRQ_NUM / 32U]; 
+    uint32_t active[SIM_IRQ_NUM / 32U]; 
+    uint64_t count[SIM_IRQ_NUM];       // Handler calls 
+    uint64_t systick_count; 
+    uint8_t systick_pending; 
+    uint8_t pendsv_pending; 
+    uint32_t exec_prio;                // Current execution priority 
+    uint32_t primask; 
+    uint64_t taken;                    // Total handler calls 
+}
+sim_nvic_t; 
+
+
+// SysTick counter state 
+typedef struct sim_systick_s
+{
+    uint64_t last_cycles;              // Counter clock cycles at the last update 
+    uint32_t val;                      // Current value 
+}
+sim_systick_t; 
+
+
+// Poll loop detection 
+typedef struct sim_poll_s
+{
+    uint32_t addr;                     // Address read repeatedly 
+    uint32_t count;                    // Consecutive identical reads 
+    uint64_t start;                    // Time the poll started 
+    uint64_t taken;                    // Interrupt count when the poll started 
+}
+sim_poll_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+static void sim_core_model_register(void); 
+static void sim_nvic_dispatch(void); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Globals 
+
+static sim_region_t sim_regions[] =
+{
+    { PERIPH_BASE,    0x00080000U, NULL },     // APB1, APB2, AHB1 register blocks 
+    { PERIPH_BB_BASE, 0x02000000U, NULL },     // Peripheral bit-band alias 
+    { SCS_BASE & 0xFFF00000U, 0x00100000U, NULL }  // Cortex-M4 private peripherals 
+}; 
+
+#define SIM_REGION_NUM (sizeof(sim_regions) / sizeof(sim_regions[0])) 
+
+static sim_access_t sim_access; 
+static sim_nvic_t sim_nvic; 
+static sim_systick_t sim_systick; 
+static sim_poll_t sim_poll; 
+static sim_core_stats_t sim_stats; 
+
+static uint64_t sim_now; 
+static uint64_t sim_time_limit = SIM_NEVER; 
+
+static sim_model_t *sim_models; 
+static uint8_t sim_model_count; 
+static sim_model_t *sim_periph_table[0x00080000U >> 10]; 
+
+static sim_event_t *sim_events; 
+static uint32_t sim_event_count; 
+static uint32_t sim_event_size; 
+
+static uint64_t sim_dwt_offset; 
+
+// Loop hook state 
+static uint64_t sim_loop_accesses; 
+static uint32_t sim_loop_idle; 
+static uint64_t sim_loop_idle_start; 
+
+// Watchdog state 
+static volatile sig_atomic_t sim_in_hook; 
+static uint64_t sim_watchdog_accesses; 
+static uint64_t sim_watchdog_loops; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Interrupt vectors 
+
+// Handlers defined (weak) in stm32f4xx_it.c or overridden by a test. Vectors with no 
+// handler in the image resolve to NULL and are treated as unused. 
+#define SIM_VECTOR(name) extern void name(void) __attribute__((weak)); 
+#define SIM_VECTORS \
+    SIM_VECTOR(WWDG_IRQHandler) SIM_VECTOR(PVD_IRQHandler) \
+    SIM_VECTOR(TAMP_STAMP_IRQHandler) SIM_VECTOR(RTC_WKUP_IRQHandler) \
+    SIM_VECTOR(FLASH_IRQHandler) SIM_VECTOR(RCC_IRQHandler) \
+    SIM_VECTOR(EXTI0_IRQHandler) SIM_VECTOR(EXTI1_IRQHandler) \
+    SIM_VECTOR(EXTI2_IRQHandler) SIM_VECTOR(EXTI3_IRQHandler) \
+    SIM_VECTOR(EXTI4_IRQHandler) SIM_VECTOR(DMA1_Stream0_IRQHandler) \
+    SIM_VECTOR(DMA1_Stream1_IRQHandler) SIM_VECTOR(DMA1_Stream2_IRQHandler) \
+    SIM_VECTOR(DMA1_Stream3_IRQHandler) SIM_VECTOR(DMA1_Stream4_IRQHandler) \
+    SIM_VECTOR(DMA1_Stream5_IRQHandler) SIM_VECTOR(DMA1_Stream6_IRQHandler) \
+    SIM_VECTOR(ADC_IRQHandler) SIM_VECTOR(EXTI9_5_IRQHandler) \
+    SIM_VECTOR(TIM1_BRK_TIM9_IRQHandler) SIM_VECTOR(TIM1_UP_TIM10_IRQHandler) \
+    SIM_VECTOR(TIM1_TRG_COM_TIM11_IRQHandler) SIM_VECTOR(TIM1_CC_IRQHandler) \
+    SIM_VECTOR(TIM2_IRQHandler) SIM_VECTOR(TIM3_IRQHandler) \
+    SIM_VECTOR(TIM4_IRQHandler) SIM_VECTOR(I2C1_EV_IRQHandler) \
+    SIM_VECTOR(I2C1_ER_IRQHandler) SIM_VECTOR(I2C2_EV_IRQHandler) \
+    SIM_VECTOR(I2C2_ER_IRQHandler) SIM_VECTOR(SPI1_IRQHandler) \
+    SIM_VECTOR(SPI2_IRQHandler) SIM_VECTOR(USART1_IRQHandler) \
+    SIM_VECTOR(USART2_IRQHandler) SIM_VECTOR(EXTI15_10_IRQHandler) \
+    SIM_VECTOR(RTC_Alarm_IRQHandler) SIM_VECTOR(OTG_FS_WKUP_IRQHandler) \
+    SIM_VECTOR(DMA1_Stream7_IRQHandler) SIM_VECTOR(SDIO_IRQHandler) \
+    SIM_VECTOR(TIM5_IRQHandler) SIM_VECTOR(SPI3_IRQHandler) \
+    SIM_VECTOR(DMA2_Stream0_IRQHandler) SIM_VECTOR(DMA2_Stream1_IRQHandler) \
+    SIM_VECTOR(DMA2_Stream2_IRQHandler) SIM_VECTOR(DMA2_Stream3_IRQHandler) \
+    SIM_VECTOR(DMA2_Stream4_IRQHandler) SIM_VECTOR(OTG_FS_IRQHandler) \
+    SIM_VECTOR(DMA2_Stream5_IRQHandler) SIM_VECTOR(DMA2_Stream6_IRQHandler) \
+    SIM_VECTOR(DMA2_Stream7_IRQHandler) SIM_VECTOR(USART6_IRQHandler) \
+    SIM_VECTOR(I2C3_EV_IRQHandler) SIM_VECTOR(I2C3_ER_IRQHandler) \
+    SIM_VECTOR(FPU_IRQHandler) SIM_VECTOR(SPI4_IRQHandler) \
+    SIM_VECTOR(SPI5_IRQHandler) SIM_VECTOR(SysTick_Handler) \
+    SIM_VECTOR(PendSV_Handler)
+
+SIM_VECTORS
+
+static void (*const sim_vectors[SIM_IRQ_NUM])(void) =
+{
+    [WWDG_IRQn] = WWDG_IRQHandler, 
+    [PVD_IRQn] = PVD_IRQHandler, 
+    [TAMP_STAMP_IRQn] = TAMP_STAMP_IRQHandler, 
+    [RTC_WKUP_IRQn] = RTC_WKUP_IRQHandler, 
+    [FLASH_IRQn] = FLASH_IRQHandler, 
+    [RCC_IRQn] = RCC_IRQHandler, 
+    [EXTI0_IRQn] = EXTI0_IRQHandler, 
+    [EXTI1_IRQn] = EXTI1_IRQHandler, 
+    [EXTI2_IRQn] = EXTI2_IRQHandler, 
+    [EXTI3_IRQn] = EXTI3_IRQHandler, 
+    [EXTI4_IRQn] = EXTI4_IRQHandler, 
+    [DMA1_Stream0_IRQn] = DMA1_Stream0_IRQHandler, 
+    [DMA1_Stream1_IRQn] = DMA1_Stream1_IRQHandler, 
+    [DMA1_Stream2_IRQn] = DMA1_Stream2_IRQHandler, 
+    [DMA1_Stream3_IRQn] = DMA1_Stream3_IRQHandler, 
+    [DMA1_Stream4_IRQn] = DMA1_Stream4_IRQHandler, 
+    [DMA1_Stream5_IRQn] = DMA1_Stream5_IRQHandler, 
+    [DMA1_Stream6_IRQn] = DMA1_Stream6_IRQHandler, 
+    [ADC_IRQn] = ADC_IRQHandler, 
+    [EXTI9_5_IRQn] = EXTI9_5_IRQHandler, 
+    [TIM1_BRK_TIM9_IRQn] = TIM1_BRK_TIM9_IRQHandler, 
+    [TIM1_UP_TIM10_IRQn] = TIM1_UP_TIM10_IRQHandler, 
+    [TIM1_TRG_COM_TIM11_IRQn] = TIM1_TRG_COM_TIM11_IRQHandler, 
+    [TIM1_CC_IRQn] = TIM1_CC_IRQHandler, 
+    [TIM2_IRQn] = TIM2_IRQHandler, 
+    [TIM3_IRQn] = TIM3_IRQHandler, 
+    [TIM4_IRQn] = TIM4_IRQHandler, 
+    [I2C1_EV_IRQn] = I2C1_EV_IRQHandler, 
+    [I2C1_ER_IRQn] = I2C1_ER_IRQHandler, 
+    [I2C2_EV_IRQn] = I2C2_EV_IRQHandler, 
+    [I2C2_ER_IRQn] = I2C2_ER_IRQHandler, 
+    [SPI1_IRQn] = SPI1_IRQHandler, 
+    [SPI2_IRQn] = SPI2_IRQHandler, 
+    [USART1_IRQn] = USART1_IRQHandler, 
+    [USART2_IRQn] = USART2_IRQHandler, 
+    [EXTI15_10_IRQn] = EXTI15_10_IRQHandler, 
+    [RTC_Alarm_IRQn] = RTC_Alarm_IRQHandler, 
+    [OTG_FS_WKUP_IRQn] = OTG_FS_WKUP_IRQHandler, 
+    [DMA1_Stream7_IRQn] = DMA1_Stream7_IRQHandler, 
+    [SDIO_IRQn] = SDIO_IRQHandler, 
+    [TIM5_IRQn] = TIM5_IRQHandler, 
+    [SPI3_IRQn] = SPI3_IRQHandler, 
+    [DMA2_Stream0_IRQn] = DMA2_Stream0_IRQHandler, 
+    [DMA2_Stream1_IRQn] = DMA2_Stream1_IRQHandler, 
+    [DMA2_Stream2_IRQn] = DMA2_Stream2_IRQHandler, 
+    [DMA2_Stream3_IRQn] = DMA2_Stream3_IRQHandler, 
+    [DMA2_Stream4_IRQn] = DMA2_Stream4_IRQHandler, 
+    [OTG_FS_IRQn] = OTG_FS_IRQHandler, 
+    [DMA2_Stream5_IRQn] = DMA2_Stream5_IRQHandler, 
+    [DMA2_Stream6_IRQn] = DMA2_Stream6_IRQHandler, 
+    [DMA2_Stream7_IRQn] = DMA2_Stream7_IRQHandler, 
+    [USART6_IRQn] = USART6_IRQHandler, 
+    [I2C3_EV_IRQn] = I2C3_EV_IRQHandler, 
+    [I2C3_ER_IRQn] = I2C3_ER_IRQHandler, 
+    [FPU_IRQn] = FPU_IRQHandler, 
+    [SPI4_IRQn] = SPI4_IRQHandler, 
+    [SPI5_IRQn] = SPI5_IRQHandler
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Diagnostics 
+
+// Report a simulator diagnostic on stderr 
+void sim_log(const char *fmt, ...)
+{
+    va_list args; 
+
+    fprintf(stderr, "[sim %10.3f ms] ", (double)sim_now / (double)SIM_NS_PER_MS); 
+    va_start(args, fmt); 
+    vfprintf(stderr, fmt, args); 
+    va_end(args); 
+    fputc('\n', stderr); 
+}
+
+
+// Simulator statistics 
+const sim_core_stats_t *sim_core_stats(void)
+{
+    return &sim_stats; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Memory map 
+
+// Find the region that holds an address 
+static SIM_NOINSTR sim_region_t *sim_region_find(uintptr_t addr)
+{
+    for (uint8_t i = 0; i < SIM_REGION_NUM; i++)
+    {
+        if ((addr >= sim_regions[i].base) &&
+            (addr < ((uintptr_t)sim_regions[i].base + sim_regions[i].size)))
+        {
+            return &sim_regions[i]; 
+        }
+    }
+
+    return NULL; 
+}
+
+
+// Alias address of a register 
+void *sim_alias(uint32_t addr)
+{
+    sim_region_t *region = sim_region_find(addr); 
+
+    if (region == NULL)
+    {
+        sim_log("no register memory at 0x%08X", addr); 
+        abort(); 
+    }
+
+    return region->alias + (addr - region->base); 
+}
+
+
+// Find the model that owns a register address 
+static SIM_NOINSTR sim_model_t *sim_model_find(uint32_t addr)
+{
+    if ((addr >= PERIPH_BASE) && (addr < (PERIPH_BASE + 0x00080000U)))
+    {
+        return sim_periph_table[(addr - PERIPH_BASE) >> 10]; 
+    }
+
+    for (sim_model_t *model = sim_models; model != NULL; model = model->next)
+    {
+        if ((addr >= model->base) && (addr < (model->base + model->size)))
+        {
+            return model; 
+        }
+    }
+
+    return NULL; 
+}
+
+
+// Register a peripheral model 
+void sim_model_register(sim_model_t *model)
+{
+    if (sim_model_count >= SIM_MAX_MODELS)
+    {
+        sim_log("too many peripheral models"); 
+        abort(); 
+    }
+
+    model->id = sim_model_count++; 
+    model->next = sim_models; 
+    sim_models = model; 
+
+    if ((model->base >= PERIPH_BASE) && (model->base < (PERIPH_BASE + 0x00080000U)))
+    {
+        for (uint32_t addr = model->base; addr < (model->base + model->size); addr += 0x400U)
+        {
+            sim_periph_table[(addr - PERIPH_BASE) >> 10] = model; 
+        }
+    }
+}
+
+
+// Map the register regions - runs before any model registers 
+__attribute__((constructor(101))) static void sim_core_map(void)
+{
+    for (uint8_t i = 0; i < SIM_REGION_NUM; i++)
+    {
+        sim_region_t *region = &sim_regions[i]; 
+        int fd = memfd_create("sim_registers", MFD_CLOEXEC); 
+
+        if ((fd < 0) || (ftruncate(fd, region->size) != 0))
+        {
+            perror("sim: memfd"); 
+            exit(EXIT_FAILURE); 
+        }
+
+        void *bus = mmap((void *)(uintptr_t)region->base, region->size, PROT_NONE, 
+                         MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0); 
+        void *alias = mmap(NULL, region->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0); 
+
+        if ((bus != (void *)(uintptr_t)region->base) || (alias == MAP_FAILED))
+        {
+            fprintf(stderr, "sim: unable to map registers at 0x%08X "
+                            "(the host build must be linked with -no-pie)\n", region->base); 
+            exit(EXIT_FAILURE); 
+        }
+
+        region->alias = (uint8_t *)alias; 
+        close(fd); 
+    }
+
+    sim_nvic.exec_prio = SIM_PRIO_THREAD; 
+    sim_core_model_register(); 
+}
+
+
+// Reset every model once all have registered 
+__attribute__((constructor(103))) static void sim_core_reset(void)
+{
+    for (sim_model_t *model = sim_models; model != NULL; model = model->next)
+    {
+        memset(sim_alias(model->base), 0, model->size); 
+
+        if (model->reset != NULL)
+        {
+            model->reset(model); 
+        }
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Time 
+
+// Current simulated time 
+uint64_t sim_time_ns(void)
+{
+    return sim_now; 
+}
+
+
+// Set the simulated time at which the run ends 
+void sim_core_set_time_limit(uint64_t limit_ns)
+{
+    sim_time_limit = limit_ns; 
+}
+
+
+// Schedule a callback at an absolute simulated time 
+void sim_schedule(uint64_t time_ns, void (*callback)(void *context), void *context)
+{
+    if (sim_event_count == sim_event_size)
+    {
+        sim_event_size = (sim_event_size == 0) ? 64U : (sim_event_size * 2U); 
+        sim_events = realloc(sim_events, sim_event_size * sizeof(sim_event_t)); 
+
+        if (sim_events == NULL)
+        {
+            abort(); 
+        }
+    }
+
+    // Binary heap insert ordered by time then insertion 
+    uint32_t i = sim_event_count++; 
+
+    while (i > 0)
+    {
+        uint32_t parent = (i - 1U) / 2U; 
+
+        if (sim_events[parent].time <= time_ns)
+        {
+            break; 
+        }
+
+        sim_events[i] = sim_events[parent]; 
+        i = parent; 
+    }
+
+    sim_events[i].time = time_ns; 
+    sim_events[i].callback = callback; 
+    sim_events[i].context = context; 
+}
+
+
+// Remove the earliest scheduled callback 
+static SIM_NOINSTR sim_event_t sim_event_pop(void)
+{
+    sim_event_t top = sim_events[0]; 
+    sim_event_t last = sim_events[--sim_event_count]; 
+    uint32_t i = 0; 
+
+    while (1)
+    {
+        uint32_t child = (2U * i) + 1U; 
+
+        if (child >= sim_event_count)
+        {
+            break; 
+        }
+
+        if (((child + 1U) < sim_event_count) &&
+            (sim_events[child + 1U].time < sim_events[child].time))
+        {
+            child++; 
+        }
+
+        if (last.time <= sim_events[child].time)
+        {
+            break; 
+        }
+
+        sim_events[i] = sim_events[child]; 
+        i = child; 
+    }
+
+    if (sim_event_count > 0)
+    {
+        sim_events[i] = last; 
+    }
+
+    return top; 
+}
+
+
+// Earliest pending event from the models and the scheduler 
+static SIM_NOINSTR uint64_t sim_next_event(void)
+{
+    uint64_t next = (sim_event_count > 0) ? sim_events[0].time : SIM_NEVER; 
+
+    for (sim_model_t *model = sim_models; model != NULL; model = model->next)
+    {
+        if (model->next_event != NULL)
+        {
+            uint64_t event = model->next_event(model, sim_now); 
+
+            if (event < next)
+            {
+                next = event; 
+            }
+        }
+    }
+
+    return next; 
+}
+
+
+// Recompute interrupt request lines 
+static SIM_NOINSTR void sim_update_irq(void)
+{
+    for (sim_model_t *model = sim_models; model != NULL; model = model->next)
+    {
+        if (model->update_irq != NULL)
+        {
+            model->update_irq(model); 
+        }
+    }
+}
+
+
+// End of run summary 
+void sim_core_finish(const char *reason)
+{
+    sim_stats.end_ns = sim_now; 
+    sim_core_report(reason); 
+    fflush(stdout); 
+    exit(EXIT_SUCCESS); 
+}
+
+
+// Advance simulated time to an absolute time 
+void sim_core_advance_to(uint64_t target)
+{
+    while (sim_now < target)
+    {
+        uint64_t next = sim_next_event(); 
+
+        if (next > target)
+        {
+            next = target; 
+        }
+        if (next <= sim_now)
+        {
+            next = sim_now + 1U; 
+        }
+
+        sim_now = next; 
+
+        for (sim_model_t *model = sim_models; model != NULL; model = model->next)
+        {
+            if (model->advance != NULL)
+            {
+                model->advance(model, sim_now); 
+            }
+        }
+
+        while ((sim_event_count > 0) && (sim_events[0].time <= sim_now))
+        {
+            sim_event_t event = sim_event_pop(); 
+            event.callback(event.context); 
+        }
+
+        if (sim_now >= sim_time_limit)
+        {
+            sim_core_finish("time limit"); 
+        }
+
+        sim_update_irq(); 
+        sim_nvic_dispatch(); 
+    }
+}
+
+
+// Advance simulated time 
+void sim_advance_ns(uint64_t ns)
+{
+    sim_core_advance_to(sim_now + ns); 
+}
+
+
+// Time for an application register access with poll loop acceleration 
+static SIM_NOINSTR void sim_access_time(uint32_t addr, uint8_t write)
+{
+    uint64_t step = SIM_ACCESS_NS; 
+
+    sim_stats.accesses++; 
+
+    if (!write && (addr == sim_poll.addr) && (sim_poll.taken == sim_nvic.taken))
+    {
+        if (++sim_poll.count > SIM_POLL_THRESHOLD)
+        {
+            // The same register is being read over and over with nothing else going 
+            // on. Skip ahead by a fraction of the time already spent waiting but never 
+            // past the next event that could change the register. 
+            uint64_t skip = (sim_now - sim_poll.start) / SIM_POLL_FRACTION; 
+            sim_model_t *model = sim_model_find(addr); 
+            uint64_t next = sim_next_event(); 
+
+            if (skip > SIM_POLL_MAX_NS)
+            {
+                skip = SIM_POLL_MAX_NS; 
+            }
+
+            if ((model != NULL) && (model->poll_limit != NULL))
+            {
+                uint64_t limit = model->poll_limit(model, addr - model->base); 
+
+                if ((limit != 0) && (skip > limit))
+                {
+                    skip = limit; 
+                }
+            }
+
+            if ((next > sim_now) && ((sim_now + skip) > next))
+            {
+                skip = next - sim_now; 
+            }
+
+            if (skip > step)
+            {
+                sim_stats.skipped_ns += skip - step; 
+                step = skip; 
+            }
+        }
+    }
+    else
+    {
+        sim_poll.addr = write ? 0U : addr; 
+        sim_poll.count = 0; 
+        sim_poll.start = sim_now; 
+        sim_poll.taken = sim_nvic.taken; 
+    }
+
+    sim_core_advance_to(sim_now + step); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Register access trapping 
+
+// Bus address of the register word behind a bit-band alias address 
+static SIM_NOINSTR uint32_t sim_bitband_target(uint32_t addr, uint32_t *bit)
+{
+    uint32_t offset = addr - PERIPH_BB_BASE; 
+    uint32_t byte = offset >> 5; 
+
+    *bit = ((byte & 3U) * 8U) + ((offset >> 2) & 7U); 
+    return PERIPH_BASE + (byte & ~3U); 
+}
+
+
+// Read hook for a register 
+static SIM_NOINSTR void sim_bus_read(uint32_t addr)
+{
+    sim_model_t *model = sim_model_find(addr); 
+
+    if ((model != NULL) && (model->read != NULL))
+    {
+        model->read(model, addr - model->base); 
+    }
+}
+
+
+// Read completion hook for a register 
+static SIM_NOINSTR void sim_bus_read_done(uint32_t addr)
+{
+    sim_model_t *model = sim_model_find(addr); 
+
+    if ((model != NULL) && (model->read_done != NULL))
+    {
+        model->read_done(model, addr - model->base); 
+    }
+}
+
+
+// Write hook for a register 
+static SIM_NOINSTR void sim_bus_write(uint32_t addr, uint32_t old_value, uint32_t value)
+{
+    sim_model_t *model = sim_model_find(addr); 
+
+    if ((model != NULL) && (model->write != NULL))
+    {
+        model->write(model, addr - model->base, old_value, value); 
+    }
+}
+
+
+// Register access fault - prepare the register and single step the access 
+static SIM_NOINSTR void sim_segv_handler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t *)context; 
+    uintptr_t fault = (uintptr_t)info->si_addr; 
+    sim_region_t *region = sim_region_find(fault); 
+
+    if ((region == NULL) || sim_access.active)
+    {
+        // Not a register access - let the fault happen for real 
+        signal(sig, SIG_DFL); 
+        return; 
+    }
+
+    uint32_t addr = (uint32_t)fault & ~3U; 
+    uint8_t write = (uc->uc_mcontext.gregs[REG_ERR] & SIM_PF_WRITE) ? 1U : 0U; 
+    uint8_t bitband = ((addr >= PERIPH_BB_BASE) && (addr < (PERIPH_BB_BASE + 0x02000000U))); 
+
+    // The access takes bus time. Interrupts that become due are taken before it. 
+    sim_in_hook = 1; 
+    sim_access_time(addr, write); 
+
+    if (bitband)
+    {
+        uint32_t bit; 
+        uint32_t target = sim_bitband_target(addr, &bit); 
+
+        sim_bus_read(target); 
+        SIM_REG(addr) = (SIM_REG(target) >> bit) & 1U; 
+    }
+    else
+    {
+        sim_bus_read(addr); 
+    }
+
+    sim_access.active = 1; 
+    sim_access.write = write; 
+    sim_access.bitband = bitband; 
+    sim_access.addr = addr; 
+    sim_access.page = addr & ~(SIM_PAGE_SIZE - 1U); 
+    sim_access.region = region; 
+    memcpy(sim_access.snapshot, sim_alias(sim_access.page), SIM_PAGE_SIZE); 
+
+    mprotect((void *)(uintptr_t)sim_access.page, SIM_PAGE_SIZE, PROT_READ | PROT_WRITE); 
+    uc->uc_mcontext.gregs[REG_EFL] |= SIM_EFLAGS_TF; 
+    sim_in_hook = 0; 
+}
+
+
+// Access completed - close the page and apply the access to the model 
+static SIM_NOINSTR void sim_trap_handler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t *)context; 
+
+    if (!sim_access.active)
+    {
+        signal(sig, SIG_DFL); 
+        return; 
+    }
+
+    uc->uc_mcontext.gregs[REG_EFL] &= ~SIM_EFLAGS_TF; 
+    mprotect((void *)(uintptr_t)sim_access.page, SIM_PAGE_SIZE, PROT_NONE); 
+    sim_access.active = 0; 
+    sim_in_hook = 1; 
+
+    if (sim_access.bitband)
+    {
+        uint32_t bit; 
+        uint32_t target = sim_bitband_target(sim_access.addr, &bit); 
+
+        if (sim_access.write)
+        {
+            uint32_t old_value = SIM_REG(target); 
+            uint32_t value = (SIM_REG(sim_access.addr) & 1U) ?
+                             (old_value | (1UL << bit)) : (old_value & ~(1UL << bit)); 
+
+            SIM_REG(target) = value; 
+            sim_bus_write(target, old_value, value); 
+        }
+        else
+        {
+            sim_bus_read_done(target); 
+        }
+    }
+    else if (sim_access.write)
+    {
+        // The faulting word is always handed over (writing a register with its current 
+        // value still has an effect, e.g. write 1 to clear). Other words the instruction 
+        // changed are found by comparing against the snapshot. The list is made before 
+        // any hook runs since hooks change other registers on the page themselves. 
+        volatile uint32_t *page = (volatile uint32_t *)sim_alias(sim_access.page); 
+        uint32_t index = (sim_access.addr - sim_access.page) / sizeof(uint32_t); 
+        uint32_t changed[SIM_WRITE_WORDS_MAX]; 
+        uint32_t values[SIM_WRITE_WORDS_MAX]; 
+        uint32_t count = 0; 
+
+        for (uint32_t i = 0; (i < (SIM_PAGE_SIZE / sizeof(uint32_t))) && (count < SIM_WRITE_WORDS_MAX); i++)
+        {
+            if ((i == index) || (page[i] != sim_access.snapshot[i]))
+            {
+                changed[count] = i; 
+                values[count++] = page[i]; 
+            }
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            sim_bus_write(sim_access.page + (changed[i] * sizeof(uint32_t)), 
+                          sim_access.snapshot[changed[i]], values[i]); 
+        }
+    }
+    else
+    {
+        sim_bus_read_done(sim_access.addr); 
+    }
+
+    sim_update_irq(); 
+    sim_nvic_dispatch(); 
+    sim_in_hook = 0; 
+}
+
+
+// Wall clock watchdog - keeps time moving while the application spins on RAM only 
+static SIM_NOINSTR void sim_watchdog_handler(int sig)
+{
+    (void)sig; 
+
+    if (sim_in_hook || sim_access.active)
+    {
+        return; 
+    }
+
+    if ((sim_stats.accesses == sim_watchdog_accesses) &&
+        (sim_stats.loops == sim_watchdog_loops))
+    {
+        uint64_t next = sim_next_event(); 
+        uint64_t target = sim_now + SIM_WATCHDOG_MAX_NS; 
+
+        if ((next > sim_now) && (next < target))
+        {
+            target = next; 
+        }
+
+        sim_stats.watchdog_steps++; 
+        sim_in_hook = 1; 
+        sim_core_advance_to(target); 
+        sim_in_hook = 0; 
+    }
+
+    sim_watchdog_accesses = sim_stats.accesses; 
+    sim_watchdog_loops = sim_stats.loops; 
+}
+
+
+// Install the signal handlers - after the models are reset, before main 
+__attribute__((constructor(104))) static void sim_core_start(void)
+{
+    struct sigaction action; 
+    struct itimerval timer; 
+
+    memset(&action, 0, sizeof(action)); 
+    action.sa_flags = SA_SIGINFO | SA_NODEFER; 
+    sigemptyset(&action.sa_mask); 
+    sigaddset(&action.sa_mask, SIGALRM); 
+
+    action.sa_sigaction = sim_segv_handler; 
+    sigaction(SIGSEGV, &action, NULL); 
+    action.sa_sigaction = sim_trap_handler; 
+    sigaction(SIGTRAP, &action, NULL); 
+
+    memset(&action, 0, sizeof(action)); 
+    action.sa_flags = SA_RESTART; 
+    action.sa_handler = sim_watchdog_handler; 
+    sigaction(SIGALRM, &action, NULL); 
+
+    timer.it_interval.tv_sec = 0; 
+    timer.it_interval.tv_usec = SIM_WATCHDOG_PERIOD_US; 
+    timer.it_value = timer.it_interval; 
+    setitimer(ITIMER_REAL, &timer, NULL); 
+
+    clock_gettime(CLOCK_MONOTONIC, &sim_stats.wall_start); 
+}
+
+
+// Main loop hook - the host build instruments project_app so every pass of the 
+// main loop in main.c takes time even if it touches no registers 
+SIM_NOINSTR void __cyg_profile_func_enter(void *function, void *call_site)
+{
+    (void)function; 
+    (void)call_site; 
+
+    if (sim_access.active || sim_in_hook)
+    {
+        return; 
+    }
+
+    uint64_t step = SIM_LOOP_NS; 
+
+    sim_stats.loops++; 
+
+    if (sim_stats.accesses == sim_loop_accesses)
+    {
+        // Nothing happened in the last pass - skip ahead towards the next event 
+        if (sim_loop_idle++ == 0)
+        {
+            sim_loop_idle_start = sim_now; 
+        }
+        else if (sim_loop_idle > SIM_POLL_THRESHOLD)
+        {
+            uint64_t skip = (sim_now - sim_loop_idle_start) / SIM_POLL_FRACTION; 
+            uint64_t next = sim_next_event(); 
+
+            if (skip > SIM_POLL_MAX_NS)
+            {
+                skip = SIM_POLL_MAX_NS; 
+            }
+            if ((next > sim_now) && ((sim_now + skip) > next))
+            {
+                skip = next - sim_now; 
+            }
+            if (skip > step)
+            {
+                sim_stats.skipped_ns += skip - step; 
+                step = skip; 
+            }
+        }
+    }
+    else
+    {
+        sim_loop_idle = 0; 
+    }
+
+    sim_in_hook = 1; 
+    sim_core_advance_to(sim_now + step); 
+    sim_in_hook = 0; 
+    sim_loop_accesses = sim_stats.accesses; 
+}
+
+
+SIM_NOINSTR void __cyg_profile_func_exit(void *function, void *call_site)
+{
+    (void)function; 
+    (void)call_site; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// NVIC 
+
+// Drive an interrupt request line from a model 
+void sim_nvic_level(sim_model_t *model, IRQn_Type irqn, uint8_t level)
+{
+    if ((irqn < 0) || ((uint32_t)irqn >= SIM_IRQ_NUM))
+    {
+        return; 
+    }
+
+    uint64_t mask = 1ULL << model->id; 
+    uint64_t old_level = sim_nvic.level[irqn]; 
+
+    if (level)
+    {
+        sim_nvic.level[irqn] |= mask; 
+
+        // A rising request latches the pending bit like the real NVIC 
+        if (old_level == 0)
+        {
+            sim_nvic.pending[irqn >> 5] |= 1UL << (irqn & 0x1F); 
+        }
+    }
+    else
+    {
+        sim_nvic.level[irqn] &= ~mask; 
+    }
+}
+
+
+// Handler call count 
+uint64_t sim_irq_count(IRQn_Type irqn)
+{
+    if (irqn == SysTick_IRQn)
+    {
+        return sim_nvic.systick_count; 
+    }
+
+    if ((irqn < 0) || ((uint32_t)irqn >= SIM_IRQ_NUM))
+    {
+        return 0; 
+    }
+
+    return sim_nvic.count[irqn]; 
+}
+
+
+// Priority of a system exception or interrupt 
+static SIM_NOINSTR uint32_t sim_nvic_priority(IRQn_Type irqn)
+{
+    if (irqn < 0)
+    {
+        volatile uint8_t *shp = (volatile uint8_t *)sim_alias(SCB_BASE + 0x18U); 
+        return shp[(((uint32_t)irqn) & 0xFU) - 4U]; 
+    }
+
+    return ((volatile uint8_t *)sim_alias(NVIC_BASE + 0x300U))[irqn]; 
+}
+
+
+// Call an exception handler at its priority 
+static SIM_NOINSTR void sim_nvic_call(IRQn_Type irqn, void (*handler)(void), uint32_t prio)
+{
+    uint32_t saved_prio = sim_nvic.exec_prio; 
+    uint8_t saved_hook = sim_in_hook; 
+
+    if (irqn >= 0)
+    {
+        sim_nvic.pending[irqn >> 5] &= ~(1UL << (irqn & 0x1F)); 
+        sim_nvic.active[irqn >> 5] |= 1UL << (irqn & 0x1F); 
+        sim_nvic.count[irqn]++; 
+    }
+
+    sim_nvic.taken++; 
+    sim_nvic.exec_prio = prio; 
+    sim_in_hook = 0; 
+
+    if (handler != NULL)
+    {
+        handler(); 
+    }
+
+    sim_in_hook = saved_hook; 
+    sim_nvic.exec_prio = saved_prio; 
+
+    if (irqn >= 0)
+    {
+        sim_nvic.active[irqn >> 5] &= ~(1UL << (irqn & 0x1F)); 
+    }
+}
+
+
+// Take every interrupt that can preempt the current execution priority 
+static SIM_NOINSTR void sim_nvic_dispatch(void)
+{
+    volatile uint32_t *iser = (volatile uint32_t *)sim_alias(NVIC_BASE); 
+
+    while (!sim_nvic.primask && !sim_access.active)
+    {
+        int32_t best = INT32_MIN; 
+        uint32_t best_prio = sim_nvic.exec_prio; 
+
+        if (sim_nvic.systick_pending && (sim_nvic_priority(SysTick_IRQn) < best_prio))
+        {
+            best = SysTick_IRQn; 
+            best_prio = sim_nvic_priority(SysTick_IRQn); 
+        }
+
+        if (sim_nvic.pendsv_pending && (sim_nvic_priority(PendSV_IRQn) < best_prio))
+        {
+            best = PendSV_IRQn; 
+            best_prio = sim_nvic_priority(PendSV_IRQn); 
+        }
+
+        for (uint32_t irqn = 0; irqn < SIM_IRQ_NUM; irqn++)
+        {
+            uint32_t mask = 1UL << (irqn & 0x1F); 
+
+            if ((iser[irqn >> 5] & mask) &&
+                ((sim_nvic.pending[irqn >> 5] & mask) || sim_nvic.level[irqn]) &&
+                !(sim_nvic.active[irqn >> 5] & mask) &&
+                (sim_nvic_priority((IRQn_Type)irqn) < best_prio))
+            {
+                best = (int32_t)irqn; 
+                best_prio = sim_nvic_priority((IRQn_Type)irqn); 
+            }
+        }
+
+        if (best == INT32_MIN)
+        {
+            break; 
+        }
+
+        if (best == SysTick_IRQn)
+        {
+            sim_nvic.systick_pending = 0; 
+            sim_nvic.systick_count++; 
+            sim_nvic_call(SysTick_IRQn, SysTick_Handler, best_prio); 
+        }
+        else if (best == PendSV_IRQn)
+        {
+            sim_nvic.pendsv_pending = 0; 
+            sim_nvic_call(PendSV_IRQn, PendSV_Handler, best_prio); 
+        }
+        else
+        {
+            sim_nvic_call((IRQn_Type)best, sim_vectors[best], best_prio); 
+        }
+
+        sim_update_irq(); 
+    }
+}
+
+
+// Set the simulated PRIMASK 
+void sim_core_set_primask(uint32_t primask)
+{
+    sim_nvic.primask = primask & 1U; 
+
+    if (!sim_nvic.primask && !sim_in_hook)
+    {
+        sim_nvic_dispatch(); 
+    }
+}
+
+
+// Read the simulated PRIMASK 
+uint32_t sim_core_get_primask(void)
+{
+    return sim_nvic.primask; 
+}
+
+
+// Wait for interrupt - sleep until the next event produces an interrupt 
+void sim_core_wfi(void)
+{
+    uint64_t taken = sim_nvic.taken; 
+    uint64_t deadline = sim_now + (10ULL * SIM_NS_PER_S); 
+
+    sim_stats.wfi++; 
+
+    while ((sim_nvic.taken == taken) && (sim_now < deadline))
+    {
+        uint64_t next = sim_next_event(); 
+        uint64_t start = sim_now; 
+
+        if ((next <= sim_now) || (next > (sim_now + SIM_POLL_MAX_NS)))
+        {
+            next = sim_now + SIM_POLL_MAX_NS; 
+        }
+
+        sim_core_advance_to(next); 
+        sim_stats.sleep_ns += sim_now - start; 
+
+        // With interrupts masked the core still wakes on a pending request 
+        if (sim_nvic.primask)
+        {
+            break; 
+        }
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Core peripheral models 
+
+// SysTick counter clock 
+static SIM_NOINSTR uint64_t sim_systick_hz(void)
+{
+    return (SIM_REG(SysTick_BASE) & SysTick_CTRL_CLKSOURCE_Msk) ? SIM_HCLK_HZ : (SIM_HCLK_HZ / 8U); 
+}
+
+
+// Reset the SCS block 
+static void sim_scs_reset(sim_model_t *model)
+{
+    (void)model; 
+    SIM_REG(SCB_BASE + 0x00U) = 0x410FC241UL;   // CPUID - Cortex-M4 r0p1 
+    SIM_REG(SCB_BASE + 0x0CU) = 0xFA050000UL;   // AIRCR 
+    SIM_REG(SysTick_BASE + 0x0CU) = 0xC0000000UL | ((SIM_HCLK_HZ / 8000U) - 1U);   // CALIB 
+}
+
+
+// Bring SysTick up to date 
+static void sim_scs_advance(sim_model_t *model, uint64_t now_ns)
+{
+    (void)model; 
+    volatile uint32_t *ctrl = &SIM_REG(SysTick_BASE); 
+    uint32_t load = SIM_REG(SysTick_BASE + 4U) & SysTick_LOAD_RELOAD_Msk; 
+    uint64_t cycles = sim_ns_to_cycles(now_ns, sim_systick_hz()); 
+    uint64_t elapsed = cycles - sim_systick.last_cycles; 
+
+    sim_systick.last_cycles = cycles; 
+
+    if (!(*ctrl & SysTick_CTRL_ENABLE_Msk) || (elapsed == 0))
+    {
+        return; 
+    }
+
+    if (sim_systick.val == 0)
+    {
+        // Reload on the first clock after reaching zero 
+        sim_systick.val = load; 
+        elapsed--; 
+    }
+
+    if (elapsed < sim_systick.val)
+    {
+        sim_systick.val -= (uint32_t)elapsed; 
+        return; 
+    }
+
+    elapsed -= sim_systick.val; 
+    sim_systick.val = (load == 0) ? 0 : (uint32_t)((load + 1U - (elapsed % (load + 1U))) % (load + 1U)); 
+
+    *ctrl |= SysTick_CTRL_COUNTFLAG_Msk; 
+
+    if (*ctrl & SysTick_CTRL_TICKINT_Msk)
+    {
+        sim_nvic.systick_pending = 1; 
+    }
+}
+
+
+// Next SysTick interrupt 
+static uint64_t sim_scs_next_event(sim_model_t *model, uint64_t now_ns)
+{
+    (void)model; 
+    (void)now_ns; 
+    uint32_t ctrl = SIM_REG(SysTick_BASE); 
+    uint32_t load = SIM_REG(SysTick_BASE + 4U) & SysTick_LOAD_RELOAD_Msk; 
+
+    if (!(ctrl & SysTick_CTRL_ENABLE_Msk) || !(ctrl & SysTick_CTRL_TICKINT_Msk) || (load == 0))
+    {
+        return SIM_NEVER; 
+    }
+
+    uint64_t remaining = (sim_systick.val == 0) ? ((uint64_t)load + 1U) : sim_systick.val; 
+    return sim_cycles_to_ns(sim_systick.last_cycles + remaining, sim_systick_hz()); 
+}
+
+
+// Refresh computed core registers before a read 
+static void sim_scs_read(sim_model_t *model, uint32_t offset)
+{
+    (void)model; 
+
+    if (offset == SIM_SCS_STK_VAL)
+    {
+        SIM_REG(SysTick_BASE + 8U) = sim_systick.val; 
+    }
+    else if ((offset >= SIM_SCS_ISPR) && (offset < (SIM_SCS_ISPR + 0x20U)))
+    {
+        uint32_t word = (offset - SIM_SCS_ISPR) / 4U; 
+        uint32_t value = sim_nvic.pending[word]; 
+
+        for (uint32_t bit = 0; bit < 32U; bit++)
+        {
+            if (sim_nvic.level[(word * 32U) + bit])
+            {
+                value |= 1UL << bit; 
+            }
+        }
+
+        SIM_REG(SCS_BASE + offset) = value; 
+        SIM_REG(SCS_BASE + SIM_SCS_ICPR + (offset - SIM_SCS_ISPR)) = value; 
+    }
+    else if ((offset >= SIM_SCS_ICPR) && (offset < (SIM_SCS_ICPR + 0x20U)))
+    {
+        sim_scs_read(model, SIM_SCS_ISPR + (offset - SIM_SCS_ICPR)); 
+    }
+    else if ((offset >= SIM_SCS_IABR) && (offset < (SIM_SCS_IABR + 0x20U)))
+    {
+        SIM_REG(SCS_BASE + offset) = sim_nvic.active[(offset - SIM_SCS_IABR) / 4U]; 
+    }
+    else if (offset == SIM_SCS_ICSR)
+    {
+        SIM_REG(SCS_BASE + offset) = (sim_nvic.systick_pending ? SCB_ICSR_PENDSTSET_Msk : 0) |
+                                     (sim_nvic.pendsv_pending ? SCB_ICSR_PENDSVSET_Msk : 0); 
+    }
+}
+
+
+// Read side effects 
+static void sim_scs_read_done(sim_model_t *model, uint32_t offset)
+{
+    (void)model; 
+
+    if (offset == SIM_SCS_STK_CTRL)
+    {
+        SIM_REG(SysTick_BASE) &= ~SysTick_CTRL_COUNTFLAG_Msk; 
+    }
+}
+
+
+// Core register writes 
+static void sim_scs_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    (void)model; 
+    volatile uint32_t *reg = &SIM_REG(SCS_BASE + offset); 
+
+    if (offset == SIM_SCS_STK_CTRL)
+    {
+        *reg = (value & 0x7U) | (old_value & SysTick_CTRL_COUNTFLAG_Msk); 
+
+        if ((value & SysTick_CTRL_ENABLE_Msk) && !(old_value & SysTick_CTRL_ENABLE_Msk))
+        {
+            sim_systick.last_cycles = sim_ns_to_cycles(sim_now, sim_systick_hz()); 
+        }
+    }
+    else if (offset == SIM_SCS_STK_VAL)
+    {
+        // Any write clears the counter and COUNTFLAG 
+        *reg = 0; 
+        sim_systick.val = 0; 
+        SIM_REG(SysTick_BASE) &= ~SysTick_CTRL_COUNTFLAG_Msk; 
+    }
+    else if ((offset >= SIM_SCS_ISER) && (offset < (SIM_SCS_ISER + 0x20U)))
+    {
+        *reg = old_value | value; 
+        SIM_REG(SCS_BASE + SIM_SCS_ICER + (offset - SIM_SCS_ISER)) = *reg; 
+    }
+    else if ((offset >= SIM_SCS_ICER) && (offset < (SIM_SCS_ICER + 0x20U)))
+    {
+        volatile uint32_t *iser = &SIM_REG(SCS_BASE + SIM_SCS_ISER + (offset - SIM_SCS_ICER)); 
+
+        *iser &= ~value; 
+        *reg = *iser; 
+    }
+    else if ((offset >= SIM_SCS_ISPR) && (offset < (SIM_SCS_ISPR + 0x20U)))
+    {
+        sim_nvic.pending[(offset - SIM_SCS_ISPR) / 4U] |= value; 
+    }
+    else if ((offset >= SIM_SCS_ICPR) && (offset < (SIM_SCS_ICPR + 0x20U)))
+    {
+        sim_nvic.pending[(offset - SIM_SCS_ICPR) / 4U] &= ~value; 
+    }
+    else if ((offset >= SIM_SCS_IABR) && (offset < (SIM_SCS_IABR + 0x20U)))
+    {
+        *reg = old_value; 
+    }
+    else if (offset == SIM_SCS_CPUID)
+    {
+        *reg = old_value; 
+    }
+    else if (offset == SIM_SCS_ICSR)
+    {
+        if (value & SCB_ICSR_PENDSTSET_Msk) { sim_nvic.systick_pending = 1; }
+        if (value & SIM_SCB_ICSR_PENDSTCLR) { sim_nvic.systick_pending = 0; }
+        if (value & SCB_ICSR_PENDSVSET_Msk) { sim_nvic.pendsv_pending = 1; }
+        if (value & SIM_SCB_ICSR_PENDSVCLR) { sim_nvic.pendsv_pending = 0; }
+        *reg = 0; 
+    }
+    else if (offset == SIM_SCS_AIRCR)
+    {
+        *reg = 0xFA050000UL | (value & SCB_AIRCR_PRIGROUP_Msk); 
+
+        if (((value >> SCB_AIRCR_VECTKEY_Pos) == 0x05FAU) && (value & SCB_AIRCR_SYSRESETREQ_Msk))
+        {
+            sim_core_finish("system reset requested"); 
+        }
+    }
+    else if (offset == SIM_SCS_STIR)
+    {
+        uint32_t irqn = value & 0x1FFU; 
+
+        if (irqn < SIM_IRQ_NUM)
+        {
+            sim_nvic.pending[irqn >> 5] |= 1UL << (irqn & 0x1F); 
+        }
+        *reg = 0; 
+    }
+}
+
+
+// DWT cycle counter clock is HCLK 
+static void sim_dwt_read(sim_model_t *model, uint32_t offset)
+{
+    (void)model; 
+
+    if ((offset == 0x04U) && (SIM_REG(DWT_BASE) & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        SIM_REG(DWT_BASE + 4U) = (uint32_t)(sim_ns_to_cycles(sim_now, SIM_HCLK_HZ) - sim_dwt_offset); 
+    }
+}
+
+
+static void sim_dwt_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    (void)model; 
+    uint64_t cycles = sim_ns_to_cycles(sim_now, SIM_HCLK_HZ); 
+
+    if (offset == 0x00U)
+    {
+        if ((value & DWT_CTRL_CYCCNTENA_Msk) && !(old_value & DWT_CTRL_CYCCNTENA_Msk))
+        {
+            // Counting resumes from the held value 
+            sim_dwt_offset = cycles - SIM_REG(DWT_BASE + 4U); 
+        }
+        else if (!(value & DWT_CTRL_CYCCNTENA_Msk) && (old_value & DWT_CTRL_CYCCNTENA_Msk))
+        {
+            SIM_REG(DWT_BASE + 4U) = (uint32_t)(cycles - sim_dwt_offset); 
+        }
+    }
+    else if (offset == 0x04U)
+    {
+        sim_dwt_offset = cycles - value; 
+    }
+}
+
+
+static sim_model_t sim_scs_model =
+{
+    .name = "SCS", 
+    .base = SCS_BASE, 
+    .size = 0x1000U, 
+    .reset = sim_scs_reset, 
+    .read = sim_scs_read, 
+    .read_done = sim_scs_read_done, 
+    .write = sim_scs_write, 
+    .advance = sim_scs_advance, 
+    .next_event = sim_scs_next_event
+}; 
+
+static sim_model_t sim_dwt_model =
+{
+    .name = "DWT", 
+    .base = DWT_BASE, 
+    .size = 0x1000U, 
+    .read = sim_dwt_read, 
+    .write = sim_dwt_write
+}; 
+
+
+// Register the core peripheral models 
+static void sim_core_model_register(void)
+{
+    sim_model_register(&sim_scs_model); 
+    sim_model_register(&sim_dwt_model); 
+}
+
+//=======================================================================================
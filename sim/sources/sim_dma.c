@@ -0,0 +1,446 @@
+/**
+ * @file sim_dma.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief DMA controller models (DMA1 and DMA2) 
+ * 
+ * @details Streams are matched to peripheral requests by their peripheral address 
+ *          register (the channel selection is not checked). Normal, circular and double 
+ *          buffer modes are supported with the half transfer and transfer complete 
+ *          flags. Memory to memory transfers complete as soon as the stream is enabled. 
+ *          Memory addresses are 32-bit bus addresses, which is why the host build is 
+ *          linked without PIE - DMA buffers must have static storage. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sim_model.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SIM_DMA_NUM 2U 
+#define SIM_DMA_STREAMS 8U 
+#define SIM_DMA_STREAM_OFFSET 0x10U 
+#define SIM_DMA_STREAM_SIZE 0x18U 
+
+// Per stream flag bits (shifted by the stream offset) 
+#define SIM_DMA_FEIF 0x01UL 
+#define SIM_DMA_DMEIF 0x04UL 
+#define SIM_DMA_TEIF 0x08UL 
+#define SIM_DMA_HTIF 0x10UL 
+#define SIM_DMA_TCIF 0x20UL 
+
+#define SIM_DMA_DIR_P2M 0U 
+#define SIM_DMA_DIR_M2P 1U 
+#define SIM_DMA_DIR_M2M 2U 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Stream state 
+typedef struct sim_dma_stream_s
+{
+    uint32_t reload;                   // NDTR at enable (circular/double buffer reload) 
+    uint32_t index;                    // Items transferred in the current buffer 
+}
+sim_dma_stream_t; 
+
+
+// Controller state 
+typedef struct sim_dma_s
+{
+    DMA_TypeDef *dma;                  // Bus address 
+    IRQn_Type irqs[SIM_DMA_STREAMS];   // Stream interrupts 
+    sim_dma_stream_t streams[SIM_DMA_STREAMS]; 
+}
+sim_dma_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Globals 
+
+static sim_dma_t sim_dmas[SIM_DMA_NUM] =
+{
+    {
+        DMA1, 
+        { DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn, 
+          DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn }, 
+        { { 0, 0 } }
+    }, 
+    {
+        DMA2, 
+        { DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn, 
+          DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn }, 
+        { { 0, 0 } }
+    }
+}; 
+
+static sim_model_t sim_dma_models[SIM_DMA_NUM]; 
+
+// Static image bounds (non-PIE executable) 
+extern char __executable_start; 
+extern char end; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helpers 
+
+// Alias view of a stream 
+static DMA_Stream_TypeDef *sim_dma_stream(sim_dma_t *state, uint8_t stream)
+{
+    return (DMA_Stream_TypeDef *)sim_alias((uint32_t)(uintptr_t)state->dma +
+                                           SIM_DMA_STREAM_OFFSET +
+                                           (stream * SIM_DMA_STREAM_SIZE)); 
+}
+
+
+// Status register and bit offset of a stream's flags 
+static volatile uint32_t *sim_dma_isr(sim_dma_t *state, uint8_t stream, uint8_t *shift)
+{
+    static const uint8_t shifts[4] = { 0, 6, 16, 22 }; 
+    DMA_TypeDef *dma = SIM_ALIAS(state->dma); 
+
+    *shift = shifts[stream & 3U]; 
+    return (stream < 4U) ? &dma->LISR : &dma->HISR; 
+}
+
+
+// Host pointer for a bus address used by a stream 
+static uint8_t *sim_dma_pointer(uint32_t addr)
+{
+    static uint8_t warned; 
+
+    if (((addr >= PERIPH_BASE) && (addr < (PERIPH_BASE + 0x00080000U))) ||
+        (addr >= (SCS_BASE & 0xFFF00000U)))
+    {
+        return (uint8_t *)sim_alias(addr); 
+    }
+
+    if (!warned && ((addr < (uint32_t)(uintptr_t)&__executable_start) ||
+                    (addr >= (uint32_t)(uintptr_t)&end + 0x10000000U)))
+    {
+        warned = 1; 
+        sim_log("DMA memory address 0x%08X is not static storage", addr); 
+    }
+
+    return (uint8_t *)(uintptr_t)addr; 
+}
+
+
+// Copy one item 
+static void sim_dma_copy(uint8_t *dst, const uint8_t *src, uint32_t size)
+{
+    switch (size)
+    {
+        case 1: *dst = *src; break; 
+        case 2: memcpy(dst, src, 2); break; 
+        default: memcpy(dst, src, 4); break; 
+    }
+}
+
+
+// One item moved - advance the counters and raise flags 
+static void sim_dma_item_done(sim_dma_t *state, uint8_t stream)
+{
+    DMA_Stream_TypeDef *s = sim_dma_stream(state, stream); 
+    sim_dma_stream_t *ss = &state->streams[stream]; 
+    uint8_t shift; 
+    volatile uint32_t *isr = sim_dma_isr(state, stream, &shift); 
+
+    ss->index++; 
+    s->NDTR = (s->NDTR - 1U) & 0xFFFFUL; 
+
+    if (ss->index == (ss->reload / 2U))
+    {
+        *isr |= SIM_DMA_HTIF << shift; 
+    }
+
+    if (s->NDTR == 0)
+    {
+        *isr |= SIM_DMA_TCIF << shift; 
+        ss->index = 0; 
+
+        if (s->CR & DMA_SxCR_DBM)
+        {
+            s->CR ^= DMA_SxCR_CT; 
+            s->NDTR = ss->reload; 
+        }
+        else if (s->CR & DMA_SxCR_CIRC)
+        {
+            s->NDTR = ss->reload; 
+        }
+        else
+        {
+            s->CR &= ~DMA_SxCR_EN; 
+        }
+    }
+}
+
+
+// Memory address of the current item 
+static uint32_t sim_dma_mem_addr(sim_dma_t *state, uint8_t stream)
+{
+    DMA_Stream_TypeDef *s = sim_dma_stream(state, stream); 
+    uint32_t msize = 1UL << ((s->CR & DMA_SxCR_MSIZE) >> DMA_SxCR_MSIZE_Pos); 
+    uint32_t base = ((s->CR & DMA_SxCR_DBM) && (s->CR & DMA_SxCR_CT)) ? s->M1AR : s->M0AR; 
+
+    return (s->CR & DMA_SxCR_MINC) ? (base + (state->streams[stream].index * msize)) : base; 
+}
+
+
+// Find the enabled stream serving a peripheral address in a direction 
+static uint8_t sim_dma_find(uint32_t periph_addr, uint32_t dir, sim_dma_t **state, uint8_t *stream)
+{
+    for (uint8_t d = 0; d < SIM_DMA_NUM; d++)
+    {
+        for (uint8_t i = 0; i < SIM_DMA_STREAMS; i++)
+        {
+            DMA_Stream_TypeDef *s = sim_dma_stream(&sim_dmas[d], i); 
+
+            if ((s->CR & DMA_SxCR_EN) && (s->PAR == periph_addr) &&
+                (((s->CR & DMA_SxCR_DIR) >> DMA_SxCR_DIR_Pos) == dir))
+            {
+                *state = &sim_dmas[d]; 
+                *stream = i; 
+                return 1; 
+            }
+        }
+    }
+
+    return 0; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Peripheral requests 
+
+// Peripheral to memory request 
+uint8_t sim_dma_p2m(uint32_t periph_addr, uint32_t data)
+{
+    sim_dma_t *state; 
+    uint8_t stream; 
+
+    if (!sim_dma_find(periph_addr, SIM_DMA_DIR_P2M, &state, &stream))
+    {
+        return 0; 
+    }
+
+    DMA_Stream_TypeDef *s = sim_dma_stream(state, stream); 
+    uint32_t msize = 1UL << ((s->CR & DMA_SxCR_MSIZE) >> DMA_SxCR_MSIZE_Pos); 
+
+    sim_dma_copy(sim_dma_pointer(sim_dma_mem_addr(state, stream)), (uint8_t *)&data, msize); 
+    sim_dma_item_done(state, stream); 
+    return 1; 
+}
+
+
+// Memory to peripheral request 
+uint8_t sim_dma_m2p(uint32_t periph_addr, uint32_t *data)
+{
+    sim_dma_t *state; 
+    uint8_t stream; 
+
+    if (!sim_dma_find(periph_addr, SIM_DMA_DIR_M2P, &state, &stream))
+    {
+        return 0; 
+    }
+
+    DMA_Stream_TypeDef *s = sim_dma_stream(state, stream); 
+    uint32_t msize = 1UL << ((s->CR & DMA_SxCR_MSIZE) >> DMA_SxCR_MSIZE_Pos); 
+
+    *data = 0; 
+    sim_dma_copy((uint8_t *)data, sim_dma_pointer(sim_dma_mem_addr(state, stream)), msize); 
+    sim_dma_item_done(state, stream); 
+    return 1; 
+}
+
+
+// Check if a stream is enabled for a peripheral address 
+uint8_t sim_dma_active(uint32_t periph_addr)
+{
+    sim_dma_t *state; 
+    uint8_t stream; 
+
+    return sim_dma_find(periph_addr, SIM_DMA_DIR_P2M, &state, &stream) ||
+           sim_dma_find(periph_addr, SIM_DMA_DIR_M2P, &state, &stream); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Model 
+
+// Memory to memory transfer runs to completion on enable 
+static void sim_dma_m2m(sim_dma_t *state, uint8_t stream)
+{
+    DMA_Stream_TypeDef *s = sim_dma_stream(state, stream); 
+    uint32_t psize = 1UL << ((s->CR & DMA_SxCR_PSIZE) >> DMA_SxCR_PSIZE_Pos); 
+    uint32_t msize = 1UL << ((s->CR & DMA_SxCR_MSIZE) >> DMA_SxCR_MSIZE_Pos); 
+    uint32_t src = s->PAR; 
+
+    while (s->CR & DMA_SxCR_EN)
+    {
+        uint32_t item = 0; 
+
+        sim_dma_copy((uint8_t *)&item, sim_dma_pointer(src), psize); 
+        sim_dma_copy(sim_dma_pointer(sim_dma_mem_addr(state, stream)), (uint8_t *)&item, msize); 
+
+        if (s->CR & DMA_SxCR_PINC)
+        {
+            src += psize; 
+        }
+
+        sim_dma_item_done(state, stream); 
+    }
+}
+
+
+static void sim_dma_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    sim_dma_t *state = (sim_dma_t *)model->instance; 
+    DMA_TypeDef *dma = SIM_ALIAS(state->dma); 
+
+    switch (offset)
+    {
+        case offsetof(DMA_TypeDef, LISR):
+        case offsetof(DMA_TypeDef, HISR):
+            SIM_REG((uint32_t)(uintptr_t)state->dma + offset) = old_value; 
+            return; 
+
+        case offsetof(DMA_TypeDef, LIFCR):
+            dma->LISR &= ~value; 
+            dma->LIFCR = 0; 
+            return; 
+
+        case offsetof(DMA_TypeDef, HIFCR):
+            dma->HISR &= ~value; 
+            dma->HIFCR = 0; 
+            return; 
+
+        default:
+            break; 
+    }
+
+    if (offset < SIM_DMA_STREAM_OFFSET)
+    {
+        return; 
+    }
+
+    uint8_t stream = (uint8_t)((offset - SIM_DMA_STREAM_OFFSET) / SIM_DMA_STREAM_SIZE); 
+    uint32_t reg = (offset - SIM_DMA_STREAM_OFFSET) % SIM_DMA_STREAM_SIZE; 
+
+    if ((stream >= SIM_DMA_STREAMS) || (reg != offsetof(DMA_Stream_TypeDef, CR)))
+    {
+        return; 
+    }
+
+    DMA_Stream_TypeDef *s = sim_dma_stream(state, stream); 
+
+    if ((value & DMA_SxCR_EN) && !(old_value & DMA_SxCR_EN))
+    {
+        state->streams[stream].reload = s->NDTR & 0xFFFFUL; 
+        state->streams[stream].index = 0; 
+
+        if (s->NDTR == 0)
+        {
+            s->CR &= ~DMA_SxCR_EN; 
+        }
+        else if (((s->CR & DMA_SxCR_DIR) >> DMA_SxCR_DIR_Pos) == SIM_DMA_DIR_M2M)
+        {
+            sim_dma_m2m(state, stream); 
+        }
+    }
+    else if (!(value & DMA_SxCR_EN) && (old_value & DMA_SxCR_EN))
+    {
+        // Disabling a stream with items left completes it early 
+        uint8_t shift; 
+        volatile uint32_t *isr = sim_dma_isr(state, stream, &shift); 
+
+        if (s->NDTR != 0)
+        {
+            *isr |= SIM_DMA_TCIF << shift; 
+        }
+    }
+}
+
+
+static void sim_dma_update_irq(sim_model_t *model)
+{
+    sim_dma_t *state = (sim_dma_t *)model->instance; 
+
+    for (uint8_t i = 0; i < SIM_DMA_STREAMS; i++)
+    {
+        DMA_Stream_TypeDef *s = sim_dma_stream(state, i); 
+        uint8_t shift; 
+        uint32_t flags = (*sim_dma_isr(state, i, &shift) >> shift) & 0x3DUL; 
+        uint32_t cr = s->CR; 
+        uint8_t request =
+            ((flags & SIM_DMA_TCIF) && (cr & DMA_SxCR_TCIE)) ||
+            ((flags & SIM_DMA_HTIF) && (cr & DMA_SxCR_HTIE)) ||
+            ((flags & SIM_DMA_TEIF) && (cr & DMA_SxCR_TEIE)) ||
+            ((flags & SIM_DMA_DMEIF) && (cr & DMA_SxCR_DMEIE)) ||
+            ((flags & SIM_DMA_FEIF) && (s->FCR & DMA_SxFCR_FEIE)); 
+
+        sim_nvic_level(model, state->irqs[i], request); 
+    }
+}
+
+
+static void sim_dma_reset(sim_model_t *model)
+{
+    sim_dma_t *state = (sim_dma_t *)model->instance; 
+
+    for (uint8_t i = 0; i < SIM_DMA_STREAMS; i++)
+    {
+        sim_dma_stream(state, i)->FCR = 0x21UL; 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Registration 
+
+SIM_MODEL_INIT static void sim_dma_init(void)
+{
+    static const char *const names[SIM_DMA_NUM] = { "DMA1", "DMA2" }; 
+
+    for (uint8_t i = 0; i < SIM_DMA_NUM; i++)
+    {
+        sim_model_t *model = &sim_dma_models[i]; 
+
+        model->name = names[i]; 
+        model->base = (uint32_t)(uintptr_t)sim_dmas[i].dma; 
+        model->size = 0x400U; 
+        model->instance = &sim_dmas[i]; 
+        model->reset = sim_dma_reset; 
+        model->write = sim_dma_write; 
+        model->update_irq = sim_dma_update_irq; 
+        sim_model_register(model); 
+    }
+}
+
+//=======================================================================================
@@ -0,0 +1,488 @@
+/**
+ * @file sim_gpio.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief GPIO, SYSCFG and EXTI models 
+ * 
+ * @details Input data is derived from the pin mode: outputs read back ODR, inputs read 
+ *          the externally driven level or their pull resistor. Every change of a pin 
+ *          level is passed to EXTI which latches the pending bit for the configured edge 
+ *          on the line the SYSCFG EXTICR register routes the port to. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sim_model.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SIM_GPIO_PORTS 6U 
+#define SIM_GPIO_LISTENERS 8U 
+#define SIM_EXTI_LINES 16U 
+#define SIM_GPIO_PINS 16U 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// GPIO port state 
+typedef struct sim_gpio_port_s
+{
+    GPIO_TypeDef *gpio;                // Port bus address 
+    uint8_t index;                     // Port number used by SYSCFG_EXTICR (A = 0) 
+    uint16_t ext_driven;               // Pins driven from outside 
+    uint16_t ext_level;                // Level of the driven pins 
+    uint16_t pin_level;                // Last pin levels (for edge detection) 
+    uint16_t odr;                      // Last output register (for listeners) 
+}
+sim_gpio_port_t; 
+
+
+// Output change listener 
+typedef struct sim_gpio_listener_s
+{
+    void (*callback)(void *context, GPIO_TypeDef *gpio, uint8_t pin, uint8_t level); 
+    void *context; 
+}
+sim_gpio_listener_t; 
+
+
+// Pulse train on an input pin 
+typedef struct sim_gpio_pulse_s
+{
+    GPIO_TypeDef *gpio;                // Port bus address 
+    uint8_t pin;                       // Pin number 
+    uint8_t level;                     // Level being driven 
+    uint8_t pending;                   // An edge is scheduled 
+    uint8_t endless;                   // Run until stopped 
+    uint32_t edges;                    // Edges left to drive 
+    uint64_t half_ns;                  // Half period 
+    uint64_t next_ns;                  // Time of the next edge 
+}
+sim_gpio_pulse_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Globals 
+
+static sim_gpio_port_t sim_gpio_ports[SIM_GPIO_PORTS] =
+{
+    { GPIOA, 0, 0, 0, 0, 0 }, 
+    { GPIOB, 1, 0, 0, 0, 0 }, 
+    { GPIOC, 2, 0, 0, 0, 0 }, 
+    { GPIOD, 3, 0, 0, 0, 0 }, 
+    { GPIOE, 4, 0, 0, 0, 0 }, 
+    { GPIOH, 7, 0, 0, 0, 0 }
+}; 
+
+static sim_model_t sim_gpio_models[SIM_GPIO_PORTS]; 
+static sim_gpio_listener_t sim_gpio_listeners[SIM_GPIO_LISTENERS]; 
+static sim_gpio_pulse_t sim_gpio_pulses[SIM_GPIO_PORTS][SIM_GPIO_PINS]; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// EXTI 
+
+// Pin level change from a GPIO port 
+static void sim_exti_edge(uint8_t port_index, uint8_t pin, uint8_t level)
+{
+    EXTI_TypeDef *exti = SIM_ALIAS(EXTI); 
+    SYSCFG_TypeDef *syscfg = SIM_ALIAS(SYSCFG); 
+    uint32_t source = (syscfg->EXTICR[pin >> 2] >> ((pin & 3U) * 4U)) & 0xFU; 
+    uint32_t line = 1UL << pin; 
+
+    if (source != port_index)
+    {
+        return; 
+    }
+
+    if ((level && (exti->RTSR & line)) || (!level && (exti->FTSR & line)))
+    {
+        exti->PR |= line; 
+    }
+}
+
+
+static void sim_exti_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    EXTI_TypeDef *exti = SIM_ALIAS(EXTI); 
+    (void)model; 
+
+    switch (offset)
+    {
+        case offsetof(EXTI_TypeDef, PR):
+            // Write 1 to clear - also clears the software interrupt bit 
+            exti->PR = old_value & ~value; 
+            exti->SWIER &= ~value; 
+            break; 
+
+        case offsetof(EXTI_TypeDef, SWIER):
+            exti->PR |= (value & ~old_value) & exti->IMR; 
+            break; 
+
+        default:
+            break; 
+    }
+}
+
+
+static void sim_exti_update_irq(sim_model_t *model)
+{
+    EXTI_TypeDef *exti = SIM_ALIAS(EXTI); 
+    uint32_t request = exti->PR & exti->IMR; 
+
+    sim_nvic_level(model, EXTI0_IRQn, (request & 0x0001UL) != 0); 
+    sim_nvic_level(model, EXTI1_IRQn, (request & 0x0002UL) != 0); 
+    sim_nvic_level(model, EXTI2_IRQn, (request & 0x0004UL) != 0); 
+    sim_nvic_level(model, EXTI3_IRQn, (request & 0x0008UL) != 0); 
+    sim_nvic_level(model, EXTI4_IRQn, (request & 0x0010UL) != 0); 
+    sim_nvic_level(model, EXTI9_5_IRQn, (request & 0x03E0UL) != 0); 
+    sim_nvic_level(model, EXTI15_10_IRQn, (request & 0xFC00UL) != 0); 
+}
+
+
+static sim_model_t sim_exti_model =
+{
+    .name = "EXTI", 
+    .base = EXTI_BASE, 
+    .size = 0x400U, 
+    .write = sim_exti_write, 
+    .update_irq = sim_exti_update_irq
+}; 
+
+static sim_model_t sim_syscfg_model =
+{
+    .name = "SYSCFG", 
+    .base = SYSCFG_BASE, 
+    .size = 0x400U
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// GPIO 
+
+// Recompute the pin levels of a port and report edges 
+static void sim_gpio_update(sim_gpio_port_t *port)
+{
+    GPIO_TypeDef *gpio = SIM_ALIAS(port->gpio); 
+    uint32_t moder = gpio->MODER; 
+    uint32_t pupdr = gpio->PUPDR; 
+    uint16_t odr = (uint16_t)gpio->ODR; 
+    uint16_t level = 0; 
+
+    for (uint8_t pin = 0; pin < SIM_EXTI_LINES; pin++)
+    {
+        uint32_t mode = (moder >> (pin * 2U)) & 3U; 
+        uint32_t pull = (pupdr >> (pin * 2U)) & 3U; 
+        uint16_t mask = (uint16_t)(1U << pin); 
+        uint8_t bit; 
+
+        if ((mode == 1U) || (mode == 2U))
+        {
+            // Output and alternate function pins read back what is driven. An alternate 
+            // function pin idles high (UART TX, SPI, I2C with pull up). 
+            bit = (mode == 1U) ? ((odr & mask) != 0) : 1U; 
+        }
+        else if (port->ext_driven & mask)
+        {
+            bit = (port->ext_level & mask) != 0; 
+        }
+        else
+        {
+            bit = (mode == 0U) && (pull == 1U); 
+        }
+
+        if (bit)
+        {
+            level |= mask; 
+        }
+    }
+
+    gpio->IDR = level; 
+
+    uint16_t changed = level ^ port->pin_level; 
+    port->pin_level = level; 
+
+    for (uint8_t pin = 0; changed != 0; pin++, changed >>= 1)
+    {
+        if (changed & 1U)
+        {
+            sim_exti_edge(port->index, pin, (level >> pin) & 1U); 
+        }
+    }
+
+    // Output listeners 
+    uint16_t odr_changed = odr ^ port->odr; 
+    port->odr = odr; 
+
+    for (uint8_t pin = 0; odr_changed != 0; pin++, odr_changed >>= 1)
+    {
+        if (!(odr_changed & 1U))
+        {
+            continue; 
+        }
+
+        for (uint8_t i = 0; i < SIM_GPIO_LISTENERS; i++)
+        {
+            if (sim_gpio_listeners[i].callback != NULL)
+            {
+                sim_gpio_listeners[i].callback(sim_gpio_listeners[i].context, 
+                                               port->gpio, pin, (odr >> pin) & 1U); 
+            }
+        }
+    }
+}
+
+
+static void sim_gpio_reset(sim_model_t *model)
+{
+    sim_gpio_port_t *port = (sim_gpio_port_t *)model->instance; 
+    GPIO_TypeDef *gpio = SIM_ALIAS(port->gpio); 
+
+    // Debug pins on port A and B are in alternate function mode after reset 
+    if (port->gpio == GPIOA)
+    {
+        gpio->MODER = 0xA8000000UL; 
+        gpio->OSPEEDR = 0x0C000000UL; 
+        gpio->PUPDR = 0x64000000UL; 
+    }
+    else if (port->gpio == GPIOB)
+    {
+        gpio->MODER = 0x00000280UL; 
+        gpio->OSPEEDR = 0x000000C0UL; 
+        gpio->PUPDR = 0x00000100UL; 
+    }
+
+    sim_gpio_update(port); 
+}
+
+
+static void sim_gpio_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    sim_gpio_port_t *port = (sim_gpio_port_t *)model->instance; 
+    GPIO_TypeDef *gpio = SIM_ALIAS(port->gpio); 
+
+    switch (offset)
+    {
+        case offsetof(GPIO_TypeDef, IDR):
+            gpio->IDR = old_value; 
+            break; 
+
+        case offsetof(GPIO_TypeDef, BSRR):
+            // Set takes priority over reset. BSRR always reads zero. 
+            gpio->ODR = (gpio->ODR & ~(value >> 16)) | (value & 0xFFFFUL); 
+            gpio->BSRR = 0; 
+            break; 
+
+        case offsetof(GPIO_TypeDef, ODR):
+            gpio->ODR = value & 0xFFFFUL; 
+            break; 
+
+        default:
+            break; 
+    }
+
+    sim_gpio_update(port); 
+}
+
+
+static void sim_gpio_read(sim_model_t *model, uint32_t offset)
+{
+    if (offset == offsetof(GPIO_TypeDef, IDR))
+    {
+        sim_gpio_update((sim_gpio_port_t *)model->instance); 
+    }
+}
+
+
+// Find the state of a port 
+static sim_gpio_port_t *sim_gpio_port(GPIO_TypeDef *gpio)
+{
+    for (uint8_t i = 0; i < SIM_GPIO_PORTS; i++)
+    {
+        if (sim_gpio_ports[i].gpio == gpio)
+        {
+            return &sim_gpio_ports[i]; 
+        }
+    }
+
+    sim_log("unknown GPIO port %p", (void *)gpio); 
+    return &sim_gpio_ports[0]; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Stimulus 
+
+// Drive an external level onto a GPIO pin 
+void sim_gpio_input(GPIO_TypeDef *gpio, uint8_t pin, uint8_t level)
+{
+    sim_gpio_port_t *port = sim_gpio_port(gpio); 
+    uint16_t mask = (uint16_t)(1U << (pin & 0xFU)); 
+
+    port->ext_driven |= mask; 
+    port->ext_level = level ? (port->ext_level | mask) : (port->ext_level & ~mask); 
+    sim_gpio_update(port); 
+}
+
+
+// Stop driving a GPIO pin 
+void sim_gpio_release(GPIO_TypeDef *gpio, uint8_t pin)
+{
+    sim_gpio_port_t *port = sim_gpio_port(gpio); 
+
+    port->ext_driven &= (uint16_t)~(1U << (pin & 0xFU)); 
+    sim_gpio_update(port); 
+}
+
+
+// Next edge of a pulse train 
+static void sim_gpio_pulse_edge(void *context)
+{
+    sim_gpio_pulse_t *pulse = (sim_gpio_pulse_t *)context; 
+
+    pulse->pending = 0; 
+
+    // Stopped or replaced by a train with no edges left 
+    if (!pulse->endless && (pulse->edges == 0))
+    {
+        return; 
+    }
+
+    // Edge scheduled by an earlier train - wait for the new train's first edge 
+    if (sim_time_ns() < pulse->next_ns)
+    {
+        pulse->pending = 1; 
+        sim_schedule(pulse->next_ns, sim_gpio_pulse_edge, pulse); 
+        return; 
+    }
+
+    pulse->level ^= 1U; 
+    sim_gpio_input(pulse->gpio, pulse->pin, pulse->level); 
+
+    if (!pulse->endless)
+    {
+        pulse->edges--; 
+    }
+
+    if (pulse->endless || pulse->edges)
+    {
+        // Edge times are kept on the original grid so the frequency doesn't drift 
+        pulse->next_ns += pulse->half_ns; 
+        pulse->pending = 1; 
+        sim_schedule(pulse->next_ns, sim_gpio_pulse_edge, pulse); 
+    }
+}
+
+
+// Drive a square wave onto a GPIO pin 
+void sim_gpio_pulse(GPIO_TypeDef *gpio, uint8_t pin, uint32_t hz, uint32_t count)
+{
+    sim_gpio_port_t *port = sim_gpio_port(gpio); 
+    sim_gpio_pulse_t *pulse = &sim_gpio_pulses[port - sim_gpio_ports][pin & 0xFU]; 
+
+    pulse->gpio = gpio; 
+    pulse->pin = pin & 0xFU; 
+
+    if (hz == 0)
+    {
+        // A scheduled edge sees no edges left and stops. The pin holds its level. 
+        pulse->endless = 0; 
+        pulse->edges = 0; 
+        return; 
+    }
+
+    // Each pulse is a rising then a falling edge starting from low 
+    pulse->level = 0; 
+    sim_gpio_input(gpio, pulse->pin, 0); 
+    pulse->endless = (count == 0); 
+    pulse->edges = count * 2U; 
+    pulse->half_ns = 500000000ULL / hz; 
+    pulse->next_ns = sim_time_ns() + pulse->half_ns; 
+
+    // A scheduled edge from an earlier train picks up the new timing when it runs 
+    if (!pulse->pending)
+    {
+        pulse->pending = 1; 
+        sim_schedule(pulse->next_ns, sim_gpio_pulse_edge, pulse); 
+    }
+}
+
+
+// Level the MCU drives on a pin 
+uint8_t sim_gpio_output(GPIO_TypeDef *gpio, uint8_t pin)
+{
+    return (SIM_ALIAS(gpio)->ODR >> (pin & 0xFU)) & 1U; 
+}
+
+
+// Register a callback for output changes 
+void sim_gpio_listen(
+    void (*callback)(void *context, GPIO_TypeDef *gpio, uint8_t pin, uint8_t level), 
+    void *context)
+{
+    for (uint8_t i = 0; i < SIM_GPIO_LISTENERS; i++)
+    {
+        if (sim_gpio_listeners[i].callback == NULL)
+        {
+            sim_gpio_listeners[i].callback = callback; 
+            sim_gpio_listeners[i].context = context; 
+            return; 
+        }
+    }
+
+    sim_log("too many GPIO listeners"); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Registration 
+
+SIM_MODEL_INIT static void sim_gpio_init(void)
+{
+    static const char *const names[SIM_GPIO_PORTS] =
+        { "GPIOA", "GPIOB", "GPIOC", "GPIOD", "GPIOE", "GPIOH" }; 
+
+    for (uint8_t i = 0; i < SIM_GPIO_PORTS; i++)
+    {
+        sim_model_t *model = &sim_gpio_models[i]; 
+
+        model->name = names[i]; 
+        model->base = (uint32_t)(uintptr_t)sim_gpio_ports[i].gpio; 
+        model->size = 0x400U; 
+        model->instance = &sim_gpio_ports[i]; 
+        model->reset = sim_gpio_reset; 
+        model->read = sim_gpio_read; 
+        model->write = sim_gpio_write; 
+        sim_model_register(model); 
+    }
+
+    sim_model_register(&sim_exti_model); 
+    sim_model_register(&sim_syscfg_model); 
+}
+
+//=======================================================================================
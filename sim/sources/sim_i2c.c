@@ -0,0 +1,563 @@
+/**
+ * @file sim_i2c.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief I2C models (master mode) and the register file device 
+ * 
+ * @details The master sequence follows the reference manual: START sets SB, the address 
+ *          written to DR sets ADDR when a device answers (AF otherwise), reading SR1 then 
+ *          SR2 clears ADDR and each data byte takes nine SCL periods as set by CCR. In 
+ *          receive mode a byte is fetched from the device while ACK is set, with BTF 
+ *          raised when a second byte waits behind an unread DR. DMA requests are not 
+ *          modelled. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sim_model.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SIM_I2C_NUM 3U 
+#define SIM_I2C_BYTE_BITS 9U           // Data bits plus acknowledge 
+
+// SR1 error flags (rc_w0) 
+#define SIM_I2C_SR1_ERRORS (I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF | I2C_SR1_OVR | \
+                            I2C_SR1_PECERR | I2C_SR1_TIMEOUT | I2C_SR1_SMBALERT)
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+// Bus phase 
+typedef enum {
+    SIM_I2C_IDLE, 
+    SIM_I2C_START,                     // Start condition sent, waiting for the address 
+    SIM_I2C_ADDRESS,                   // Address acknowledged, waiting for ADDR clear 
+    SIM_I2C_TRANSMIT, 
+    SIM_I2C_RECEIVE
+} sim_i2c_phase_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// I2C state 
+typedef struct sim_i2c_s
+{
+    I2C_TypeDef *i2c;                  // Bus address 
+    IRQn_Type ev_irqn;                 // Event interrupt 
+    IRQn_Type er_irqn;                 // Error interrupt 
+    sim_i2c_device_t *devices;         // Attached devices 
+    sim_i2c_device_t *device;          // Addressed device 
+    sim_i2c_phase_t phase;             // Bus phase 
+    uint8_t read;                      // Addressed for reading 
+    uint8_t sr1_read;                  // SR1 read while ADDR was set (ADDR clear sequence) 
+    uint8_t shifting;                  // Byte in the shift register 
+    uint8_t shift_data;                // Shift register contents 
+    uint8_t tx_pending;                // Byte waiting in DR (transmit) 
+    uint8_t tx_data;                   // Waiting byte 
+    uint8_t rx_held;                   // Received byte waiting behind an unread DR 
+    uint64_t done_ns;                  // End of the byte being shifted 
+}
+sim_i2c_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Globals 
+
+static sim_i2c_t sim_i2cs[SIM_I2C_NUM] =
+{
+    { .i2c = I2C1, .ev_irqn = I2C1_EV_IRQn, .er_irqn = I2C1_ER_IRQn }, 
+    { .i2c = I2C2, .ev_irqn = I2C2_EV_IRQn, .er_irqn = I2C2_ER_IRQn }, 
+    { .i2c = I2C3, .ev_irqn = I2C3_EV_IRQn, .er_irqn = I2C3_ER_IRQn }
+}; 
+
+static sim_model_t sim_i2c_models[SIM_I2C_NUM]; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helpers 
+
+// Duration of one byte on the bus 
+static uint64_t sim_i2c_byte_ns(I2C_TypeDef *i2c)
+{
+    uint32_t ccr = i2c->CCR & I2C_CCR_CCR; 
+    uint32_t period; 
+
+    if (ccr == 0)
+    {
+        ccr = 1; 
+    }
+
+    if (!(i2c->CCR & I2C_CCR_FS))
+    {
+        period = 2U * ccr; 
+    }
+    else
+    {
+        period = (i2c->CCR & I2C_CCR_DUTY) ? (25U * ccr) : (3U * ccr); 
+    }
+
+    return sim_cycles_to_ns((uint64_t)period * SIM_I2C_BYTE_BITS, SIM_PCLK1_HZ); 
+}
+
+
+// Start shifting a byte (transmit) or fetching one from the device (receive) 
+static void sim_i2c_shift(sim_i2c_t *state, I2C_TypeDef *i2c, uint8_t data, uint64_t now_ns)
+{
+    state->shifting = 1; 
+    state->shift_data = data; 
+    state->done_ns = now_ns + sim_i2c_byte_ns(i2c); 
+}
+
+
+// Fetch the next byte in receive mode if the master acknowledges 
+static void sim_i2c_receive_next(sim_i2c_t *state, I2C_TypeDef *i2c, uint64_t now_ns)
+{
+    if ((state->phase == SIM_I2C_RECEIVE) && !state->shifting && (i2c->CR1 & I2C_CR1_ACK))
+    {
+        uint8_t data = ((state->device != NULL) && (state->device->read != NULL)) ?
+                       state->device->read(state->device->context) : 0xFFU; 
+
+        sim_i2c_shift(state, i2c, data, now_ns); 
+    }
+}
+
+
+// Stop condition 
+static void sim_i2c_stop(sim_i2c_t *state, I2C_TypeDef *i2c)
+{
+    if ((state->device != NULL) && (state->device->stop != NULL))
+    {
+        state->device->stop(state->device->context); 
+    }
+
+    state->device = NULL; 
+    state->phase = SIM_I2C_IDLE; 
+    state->tx_pending = 0; 
+
+    if (!state->read)
+    {
+        state->shifting = 0; 
+    }
+
+    i2c->CR1 &= ~I2C_CR1_STOP; 
+    i2c->SR1 &= ~(I2C_SR1_TXE | I2C_SR1_BTF | I2C_SR1_SB | I2C_SR1_ADDR); 
+    i2c->SR2 &= ~(I2C_SR2_MSL | I2C_SR2_BUSY | I2C_SR2_TRA); 
+}
+
+
+// Address byte written after a start condition 
+static void sim_i2c_address(sim_i2c_t *state, I2C_TypeDef *i2c, uint8_t data)
+{
+    uint8_t address = data >> 1; 
+
+    state->read = data & 1U; 
+    state->device = NULL; 
+    i2c->SR1 &= ~I2C_SR1_SB; 
+
+    for (sim_i2c_device_t *device = state->devices; device != NULL; device = device->next)
+    {
+        if (device->address == address)
+        {
+            state->device = device; 
+            break; 
+        }
+    }
+
+    if (state->device == NULL)
+    {
+        i2c->SR1 |= I2C_SR1_AF; 
+        state->phase = SIM_I2C_IDLE; 
+        return; 
+    }
+
+    if (state->device->start != NULL)
+    {
+        state->device->start(state->device->context, state->read); 
+    }
+
+    state->phase = SIM_I2C_ADDRESS; 
+    state->sr1_read = 0; 
+    i2c->SR1 |= I2C_SR1_ADDR; 
+
+    if (state->read)
+    {
+        i2c->SR2 &= ~I2C_SR2_TRA; 
+    }
+    else
+    {
+        i2c->SR2 |= I2C_SR2_TRA; 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Model 
+
+static void sim_i2c_advance(sim_model_t *model, uint64_t now_ns)
+{
+    sim_i2c_t *state = (sim_i2c_t *)model->instance; 
+    I2C_TypeDef *i2c = SIM_ALIAS(state->i2c); 
+
+    while (state->shifting && (state->done_ns <= now_ns))
+    {
+        uint64_t done = state->done_ns; 
+        state->shifting = 0; 
+
+        if (!state->read)
+        {
+            if ((state->device != NULL) && (state->device->write != NULL))
+            {
+                state->device->write(state->device->context, state->shift_data); 
+            }
+
+            if (state->tx_pending)
+            {
+                state->tx_pending = 0; 
+                sim_i2c_shift(state, i2c, state->tx_data, done); 
+                i2c->SR1 |= I2C_SR1_TXE; 
+            }
+            else
+            {
+                i2c->SR1 |= I2C_SR1_TXE | I2C_SR1_BTF; 
+            }
+        }
+        else if (i2c->SR1 & I2C_SR1_RXNE)
+        {
+            // DR not read yet - the byte waits in the shift register 
+            state->rx_held = 1; 
+            i2c->SR1 |= I2C_SR1_BTF; 
+        }
+        else
+        {
+            i2c->DR = state->shift_data; 
+            i2c->SR1 |= I2C_SR1_RXNE; 
+            sim_i2c_receive_next(state, i2c, done); 
+        }
+    }
+}
+
+
+static uint64_t sim_i2c_next_event(sim_model_t *model, uint64_t now_ns)
+{
+    sim_i2c_t *state = (sim_i2c_t *)model->instance; 
+    (void)now_ns; 
+
+    return (state->shifting && !state->rx_held) ? state->done_ns : SIM_NEVER; 
+}
+
+
+static uint64_t sim_i2c_poll_limit(sim_model_t *model, uint32_t offset)
+{
+    sim_i2c_t *state = (sim_i2c_t *)model->instance; 
+    uint64_t now = sim_time_ns(); 
+    (void)offset; 
+
+    return (state->shifting && (state->done_ns > now)) ? (state->done_ns - now) : 0; 
+}
+
+
+static void sim_i2c_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    sim_i2c_t *state = (sim_i2c_t *)model->instance; 
+    I2C_TypeDef *i2c = SIM_ALIAS(state->i2c); 
+
+    switch (offset)
+    {
+        case offsetof(I2C_TypeDef, CR1):
+            if (value & I2C_CR1_SWRST)
+            {
+                state->phase = SIM_I2C_IDLE; 
+                state->device = NULL; 
+                state->shifting = 0; 
+                state->rx_held = 0; 
+                i2c->SR1 = 0; 
+                i2c->SR2 = 0; 
+                break; 
+            }
+
+            if ((value & I2C_CR1_START) && !(old_value & I2C_CR1_START))
+            {
+                // Start or repeated start 
+                state->phase = SIM_I2C_START; 
+                state->shifting = 0; 
+                state->tx_pending = 0; 
+                state->rx_held = 0; 
+                i2c->CR1 &= ~I2C_CR1_START; 
+                i2c->SR1 = (i2c->SR1 & SIM_I2C_SR1_ERRORS) | I2C_SR1_SB; 
+                i2c->SR2 |= I2C_SR2_MSL | I2C_SR2_BUSY; 
+            }
+
+            if (value & I2C_CR1_STOP)
+            {
+                sim_i2c_stop(state, i2c); 
+            }
+
+            if ((value & I2C_CR1_ACK) && !(old_value & I2C_CR1_ACK))
+            {
+                sim_i2c_receive_next(state, i2c, sim_time_ns()); 
+            }
+            break; 
+
+        case offsetof(I2C_TypeDef, DR):
+            if (state->phase == SIM_I2C_START)
+            {
+                sim_i2c_address(state, i2c, (uint8_t)value); 
+            }
+            else if (state->phase == SIM_I2C_TRANSMIT)
+            {
+                i2c->SR1 &= ~I2C_SR1_BTF; 
+
+                if (!state->shifting)
+                {
+                    sim_i2c_shift(state, i2c, (uint8_t)value, sim_time_ns()); 
+                }
+                else
+                {
+                    state->tx_pending = 1; 
+                    state->tx_data = (uint8_t)value; 
+                    i2c->SR1 &= ~I2C_SR1_TXE; 
+                }
+            }
+            break; 
+
+        case offsetof(I2C_TypeDef, SR1):
+            i2c->SR1 = old_value & (value | ~SIM_I2C_SR1_ERRORS); 
+            break; 
+
+        case offsetof(I2C_TypeDef, SR2):
+            i2c->SR2 = old_value; 
+            break; 
+
+        default:
+            break; 
+    }
+}
+
+
+static void sim_i2c_read_done(sim_model_t *model, uint32_t offset)
+{
+    sim_i2c_t *state = (sim_i2c_t *)model->instance; 
+    I2C_TypeDef *i2c = SIM_ALIAS(state->i2c); 
+
+    switch (offset)
+    {
+        case offsetof(I2C_TypeDef, SR1):
+            state->sr1_read = (i2c->SR1 & I2C_SR1_ADDR) != 0; 
+            break; 
+
+        case offsetof(I2C_TypeDef, SR2):
+            if (state->sr1_read && (state->phase == SIM_I2C_ADDRESS))
+            {
+                state->sr1_read = 0; 
+                i2c->SR1 &= ~I2C_SR1_ADDR; 
+
+                if (state->read)
+                {
+                    state->phase = SIM_I2C_RECEIVE; 
+                    sim_i2c_receive_next(state, i2c, sim_time_ns()); 
+                }
+                else
+                {
+                    state->phase = SIM_I2C_TRANSMIT; 
+                    i2c->SR1 |= I2C_SR1_TXE; 
+                }
+            }
+            break; 
+
+        case offsetof(I2C_TypeDef, DR):
+            i2c->SR1 &= ~I2C_SR1_RXNE; 
+
+            if (state->rx_held)
+            {
+                // Waiting byte moves into DR 
+                state->rx_held = 0; 
+                state->shifting = 0; 
+                i2c->DR = state->shift_data; 
+                i2c->SR1 = (i2c->SR1 & ~I2C_SR1_BTF) | I2C_SR1_RXNE; 
+                sim_i2c_receive_next(state, i2c, sim_time_ns()); 
+            }
+            break; 
+
+        default:
+            break; 
+    }
+}
+
+
+static void sim_i2c_update_irq(sim_model_t *model)
+{
+    sim_i2c_t *state = (sim_i2c_t *)model->instance; 
+    I2C_TypeDef *i2c = SIM_ALIAS(state->i2c); 
+    uint32_t sr1 = i2c->SR1; 
+    uint32_t cr2 = i2c->CR2; 
+    uint32_t events = I2C_SR1_SB | I2C_SR1_ADDR | I2C_SR1_BTF | I2C_SR1_STOPF; 
+
+    sim_nvic_level(model, state->ev_irqn, 
+                   ((cr2 & I2C_CR2_ITEVTEN) && (sr1 & events)) ||
+                   ((cr2 & I2C_CR2_ITEVTEN) && (cr2 & I2C_CR2_ITBUFEN) &&
+                    (sr1 & (I2C_SR1_TXE | I2C_SR1_RXNE)))); 
+    sim_nvic_level(model, state->er_irqn, 
+                   (cr2 & I2C_CR2_ITERREN) && (sr1 & SIM_I2C_SR1_ERRORS)); 
+}
+
+
+static void sim_i2c_reset(sim_model_t *model)
+{
+    sim_i2c_t *state = (sim_i2c_t *)model->instance; 
+
+    state->phase = SIM_I2C_IDLE; 
+    state->device = NULL; 
+    state->shifting = 0; 
+    state->tx_pending = 0; 
+    state->rx_held = 0; 
+    SIM_ALIAS(state->i2c)->TRISE = 0x0002UL; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Devices 
+
+// Attach a device to a bus 
+void sim_i2c_attach(I2C_TypeDef *i2c, sim_i2c_device_t *device)
+{
+    for (uint8_t i = 0; i < SIM_I2C_NUM; i++)
+    {
+        if (sim_i2cs[i].i2c == i2c)
+        {
+            device->next = sim_i2cs[i].devices; 
+            sim_i2cs[i].devices = device; 
+            return; 
+        }
+    }
+
+    sim_log("unknown I2C %p", (void *)i2c); 
+}
+
+
+// Register file - the first byte written after the address sets the register pointer 
+static void sim_i2c_regfile_start(void *context, uint8_t read)
+{
+    sim_i2c_regfile_t *regfile = (sim_i2c_regfile_t *)context; 
+
+    if (!read)
+    {
+        regfile->pointer_set = 0; 
+    }
+}
+
+
+// Advance the register pointer (the auto increment bit itself is kept) 
+static void sim_i2c_regfile_step(sim_i2c_regfile_t *regfile)
+{
+    uint8_t mask = regfile->auto_increment_mask; 
+
+    if ((mask == 0) || (regfile->pointer & mask))
+    {
+        regfile->pointer = (uint8_t)((regfile->pointer & mask) |
+                                     ((regfile->pointer + 1U) & (uint8_t)~mask)); 
+    }
+}
+
+
+static void sim_i2c_regfile_write(void *context, uint8_t data)
+{
+    sim_i2c_regfile_t *regfile = (sim_i2c_regfile_t *)context; 
+
+    if (!regfile->pointer_set)
+    {
+        regfile->pointer = data; 
+        regfile->pointer_set = 1; 
+        return; 
+    }
+
+    regfile->regs[regfile->pointer & (uint8_t)~regfile->auto_increment_mask] = data; 
+    sim_i2c_regfile_step(regfile); 
+}
+
+
+static uint8_t sim_i2c_regfile_read(void *context)
+{
+    sim_i2c_regfile_t *regfile = (sim_i2c_regfile_t *)context; 
+    uint8_t data = regfile->regs[regfile->pointer & (uint8_t)~regfile->auto_increment_mask]; 
+
+    sim_i2c_regfile_step(regfile); 
+    return data; 
+}
+
+
+// Attach a register file device 
+void sim_i2c_regfile_attach(
+    I2C_TypeDef *i2c, 
+    sim_i2c_regfile_t *regfile, 
+    uint8_t address, 
+    uint8_t auto_increment_mask)
+{
+    regfile->device.address = address; 
+    regfile->device.start = sim_i2c_regfile_start; 
+    regfile->device.write = sim_i2c_regfile_write; 
+    regfile->device.read = sim_i2c_regfile_read; 
+    regfile->device.stop = NULL; 
+    regfile->device.context = regfile; 
+    regfile->auto_increment_mask = auto_increment_mask; 
+    regfile->pointer = 0; 
+    regfile->pointer_set = 0; 
+    sim_i2c_attach(i2c, &regfile->device); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Registration 
+
+SIM_MODEL_INIT static void sim_i2c_init(void)
+{
+    static const char *const names[SIM_I2C_NUM] = { "I2C1", "I2C2", "I2C3" }; 
+
+    for (uint8_t i = 0; i < SIM_I2C_NUM; i++)
+    {
+        sim_model_t *model = &sim_i2c_models[i]; 
+
+        model->name = names[i]; 
+        model->base = (uint32_t)(uintptr_t)sim_i2cs[i].i2c; 
+        model->size = 0x400U; 
+        model->instance = &sim_i2cs[i]; 
+        model->reset = sim_i2c_reset; 
+        model->read_done = sim_i2c_read_done; 
+        model->write = sim_i2c_write; 
+        model->advance = sim_i2c_advance; 
+        model->next_event = sim_i2c_next_event; 
+        model->poll_limit = sim_i2c_poll_limit; 
+        model->update_irq = sim_i2c_update_irq; 
+        sim_model_register(model); 
+    }
+}
+
+//=======================================================================================
@@ -0,0 +1,504 @@
+/**
+ * @file sim_init.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Host build start up - command line, stimulus script and run summary 
+ * 
+ * @details Command line options of the host executable: 
+ *            --time-ms N    : stop after N ms of simulated time 
+ *            --script FILE  : timed stimulus (see below) 
+ *            --stdin        : forward standard input to USART2 (default on a terminal) 
+ *            --stats        : print interrupt, radio link and SD card counts in the run 
+ *                             summary 
+ *            --quiet        : no run summary 
+ *            --radio-loss PCT       : lose PCT % of the simulated radio's packets and ACKs 
+ *            --radio-latency-us US  : extra delay each way on the simulated radio link 
+ *            --radio-seed N         : random seed for the radio losses 
+ *            --radio-busy A-B:PCT   : channels A to B are in use PCT % of the time 
+ *            --radio-ack-loss PCT   : also lose PCT % of the simulated peer's ACKs 
+ *            --sd-image FILE        : FAT image file for the simulated SD card 
+ *            --sd-cmd-us US         : SD card overhead per read or write command 
+ *            --sd-busy-us US        : SD card busy time after each write command 
+ *            --sd-erase-us US       : SD card extra busy time when a write opens another 
+ *                                     erase block 
+ *            --sd-erase-kb KB       : SD card erase block size 
+ *            --sd-fail PCT          : fail PCT % of the SD card's reads and writes 
+ *            --sd-seed N            : random seed for the SD card failures 
+ * 
+ *          Script lines are "<ms> <command> <args>", '#' starts a comment: 
+ *            <ms> uart <1|2|6> <text>    : receive text (\r, \n, \t and \\ escapes) 
+ *            <ms> gpio <A-H> <pin> <0|1> : drive an input pin 
+ *            <ms> pulse <A-H> <pin> <hz> [count] 
+ *                                        : square wave on an input pin (count 0 or 
+ *                                          missing runs until stopped, hz 0 stops) 
+ *            <ms> adc <channel> <value>  : set an analog input (0-4095) 
+ *            <ms> quit                   : end the run 
+ * 
+ *          Line feeds from standard input are sent as carriage returns like a serial 
+ *          terminal does. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sim_model.h" 
+#include "sim_core.h" 
+#include <poll.h> 
+#include <stdlib.h> 
+#include <unistd.h> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SIM_INIT_LINE_MAX 256U 
+#define SIM_INIT_STDIN_POLL_NS SIM_NS_PER_MS 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Script stimulus 
+typedef struct sim_script_event_s
+{
+    char command[8];                   // uart, gpio, pulse, adc or quit 
+    uint32_t arg1;                     // USART number, GPIO port index or ADC channel 
+    uint32_t arg2;                     // GPIO pin or ADC value 
+    uint32_t arg3;                     // GPIO level or pulse frequency 
+    uint32_t arg4;                     // Pulse count 
+    uint32_t len;                      // Text length 
+    uint8_t text[SIM_INIT_LINE_MAX];   // UART text 
+}
+sim_script_event_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Globals 
+
+static uint8_t sim_init_stats; 
+static uint8_t sim_init_quiet; 
+static uint8_t sim_init_stdin; 
+static double sim_init_radio_loss; 
+static double sim_init_radio_latency_us; 
+static uint64_t sim_init_radio_seed = 1; 
+static double sim_init_radio_ack_loss; 
+static double sim_init_sd_cmd_us = 100.0; 
+static double sim_init_sd_busy_us = 500.0; 
+static double sim_init_sd_erase_us = 3000.0; 
+static uint32_t sim_init_sd_erase_kb = 64; 
+static double sim_init_sd_fail; 
+static uint64_t sim_init_sd_seed = 1; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Stimulus 
+
+// USART by number 
+static USART_TypeDef *sim_init_usart(uint32_t number)
+{
+    switch (number)
+    {
+        case 1: return USART1; 
+        case 6: return USART6; 
+        default: return USART2; 
+    }
+}
+
+
+// Run one script event 
+static void sim_script_run(void *context)
+{
+    sim_script_event_t *event = (sim_script_event_t *)context; 
+    static GPIO_TypeDef *const ports[] = { GPIOA, GPIOB, GPIOC, GPIOD, GPIOE, NULL, NULL, GPIOH }; 
+
+    if (!strcmp(event->command, "uart"))
+    {
+        sim_usart_rx(sim_init_usart(event->arg1), event->text, event->len); 
+    }
+    else if (!strcmp(event->command, "gpio"))
+    {
+        sim_gpio_input(ports[event->arg1], (uint8_t)event->arg2, (uint8_t)event->arg3); 
+    }
+    else if (!strcmp(event->command, "pulse"))
+    {
+        sim_gpio_pulse(
+            ports[event->arg1], (uint8_t)event->arg2, event->arg3, event->arg4); 
+    }
+    else if (!strcmp(event->command, "adc"))
+    {
+        sim_adc_input((uint8_t)event->arg1, (uint16_t)event->arg2); 
+    }
+    else if (!strcmp(event->command, "quit"))
+    {
+        sim_core_finish("script quit"); 
+    }
+
+    free(event); 
+}
+
+
+// Expand the escapes of a script text argument 
+static uint32_t sim_script_text(const char *src, uint8_t *dst)
+{
+    uint32_t len = 0; 
+
+    while ((*src != '\0') && (*src != '\n') && (len < SIM_INIT_LINE_MAX))
+    {
+        char c = *src++; 
+
+        if ((c == '\\') && (*src != '\0'))
+        {
+            c = *src++; 
+            c = (c == 'r') ? '\r' : (c == 'n') ? '\n' : (c == 't') ? '\t' : c; 
+        }
+
+        dst[len++] = (uint8_t)c; 
+    }
+
+    return len; 
+}
+
+
+// Parse a stimulus script and schedule its events 
+static void sim_script_load(const char *path)
+{
+    FILE *file = fopen(path, "r"); 
+    char line[SIM_INIT_LINE_MAX]; 
+    uint32_t line_number = 0; 
+
+    if (file == NULL)
+    {
+        sim_log("cannot open script '%s'", path); 
+        exit(EXIT_FAILURE); 
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        sim_script_event_t *event; 
+        double time_ms; 
+        int consumed = 0; 
+        char port; 
+
+        line_number++; 
+
+        if ((line[0] == '#') || (line[0] == '\n') || (line[0] == '\0'))
+        {
+            continue; 
+        }
+
+        event = calloc(1, sizeof(sim_script_event_t)); 
+
+        if ((event == NULL) ||
+            (sscanf(line, "%lf %7s %n", &time_ms, event->command, &consumed) < 2))
+        {
+            sim_log("%s:%u: bad line", path, line_number); 
+            exit(EXIT_FAILURE); 
+        }
+
+        const char *args = line + consumed; 
+        uint8_t ok = 1; 
+
+        if (!strcmp(event->command, "uart"))
+        {
+            int text = 0; 
+            ok = sscanf(args, "%u %n", &event->arg1, &text) == 1; 
+            event->len = sim_script_text(args + text, event->text); 
+        }
+        else if (!strcmp(event->command, "gpio"))
+        {
+            ok = (sscanf(args, " %c %u %u", &port, &event->arg2, &event->arg3) == 3) &&
+                 (port >= 'A') && (port <= 'H') && (port != 'F') && (port != 'G'); 
+            event->arg1 = (uint32_t)(port - 'A'); 
+        }
+        else if (!strcmp(event->command, "pulse"))
+        {
+            ok = (sscanf(args, " %c %u %u %u", 
+                         &port, &event->arg2, &event->arg3, &event->arg4) >= 3) &&
+                 (port >= 'A') && (port <= 'H') && (port != 'F') && (port != 'G'); 
+            event->arg1 = (uint32_t)(port - 'A'); 
+        }
+        else if (!strcmp(event->command, "adc"))
+        {
+            ok = sscanf(args, "%u %u", &event->arg1, &event->arg2) == 2; 
+        }
+        else
+        {
+            ok = !strcmp(event->command, "quit"); 
+        }
+
+        if (!ok)
+        {
+            sim_log("%s:%u: bad '%s' command", path, line_number, event->command); 
+            exit(EXIT_FAILURE); 
+        }
+
+        sim_schedule((uint64_t)(time_ms * (double)SIM_NS_PER_MS), sim_script_run, event); 
+    }
+
+    fclose(file); 
+}
+
+
+// Forward standard input to USART2 
+static void sim_stdin_poll(void *context)
+{
+    struct pollfd fd = { .fd = STDIN_FILENO, .events = POLLIN, .revents = 0 }; 
+    uint8_t data[SIM_INIT_LINE_MAX]; 
+    (void)context; 
+
+    if ((poll(&fd, 1, 0) > 0) && (fd.revents & (POLLIN | POLLHUP)))
+    {
+        ssize_t len = read(STDIN_FILENO, data, sizeof(data)); 
+
+        if (len <= 0)
+        {
+            // End of input - stop polling 
+            return; 
+        }
+
+        for (ssize_t i = 0; i < len; i++)
+        {
+            if (data[i] == '\n')
+            {
+                data[i] = '\r'; 
+            }
+        }
+
+        sim_usart_rx(USART2, data, (uint32_t)len); 
+    }
+
+    sim_schedule(sim_time_ns() + SIM_INIT_STDIN_POLL_NS, sim_stdin_poll, NULL); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Start up 
+
+static void sim_init_usage(const char *name)
+{
+    fprintf(stderr, 
+            "usage: %s [--time-ms N] [--script FILE] [--stdin] [--stats] [--quiet]\n"
+            "          [--radio-loss PCT] [--radio-latency-us US] [--radio-seed N]\n"
+            "          [--radio-busy A-B:PCT]... [--radio-ack-loss PCT] [--sd-image FILE]\n"
+            "          [--sd-cmd-us US] [--sd-busy-us US] [--sd-erase-us US]\n"
+            "          [--sd-erase-kb KB] [--sd-fail PCT] [--sd-seed N]\n", 
+            name); 
+    exit(EXIT_FAILURE); 
+}
+
+
+// Command line - glibc passes the program arguments to constructors 
+__attribute__((constructor(105))) static void sim_init(int argc, char **argv)
+{
+    sim_init_stdin = (uint8_t)isatty(STDIN_FILENO); 
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--time-ms") && (i + 1 < argc))
+        {
+            sim_core_set_time_limit((uint64_t)(strtod(argv[++i], NULL) * (double)SIM_NS_PER_MS)); 
+        }
+        else if (!strcmp(argv[i], "--script") && (i + 1 < argc))
+        {
+            sim_script_load(argv[++i]); 
+        }
+        else if (!strcmp(argv[i], "--stdin"))
+        {
+            sim_init_stdin = 1; 
+        }
+        else if (!strcmp(argv[i], "--stats"))
+        {
+            sim_init_stats = 1; 
+        }
+        else if (!strcmp(argv[i], "--quiet"))
+        {
+            sim_init_quiet = 1; 
+        }
+        else if (!strcmp(argv[i], "--radio-loss") && (i + 1 < argc))
+        {
+            sim_init_radio_loss = strtod(argv[++i], NULL); 
+        }
+        else if (!strcmp(argv[i], "--radio-latency-us") && (i + 1 < argc))
+        {
+            sim_init_radio_latency_us = strtod(argv[++i], NULL); 
+        }
+        else if (!strcmp(argv[i], "--radio-seed") && (i + 1 < argc))
+        {
+            sim_init_radio_seed = strtoull(argv[++i], NULL, 0); 
+        }
+        else if (!strcmp(argv[i], "--radio-busy") && (i + 1 < argc))
+        {
+            unsigned first, last; 
+            double busy; 
+
+            if (sscanf(argv[++i], "%u-%u:%lf", &first, &last, &busy) != 3)
+            {
+                sim_init_usage(argv[0]); 
+            }
+
+            sim_radio_busy((uint8_t)first, (uint8_t)last, busy); 
+        }
+        else if (!strcmp(argv[i], "--radio-ack-loss") && (i + 1 < argc))
+        {
+            sim_init_radio_ack_loss = strtod(argv[++i], NULL); 
+        }
+        else if (!strcmp(argv[i], "--sd-image") && (i + 1 < argc))
+        {
+            if (!sim_sd_image(argv[++i]))
+            {
+                fprintf(stderr, "[sim] can't open SD card image %s\n", argv[i]); 
+                exit(EXIT_FAILURE); 
+            }
+        }
+        else if (!strcmp(argv[i], "--sd-cmd-us") && (i + 1 < argc))
+        {
+            sim_init_sd_cmd_us = strtod(argv[++i], NULL); 
+        }
+        else if (!strcmp(argv[i], "--sd-busy-us") && (i + 1 < argc))
+        {
+            sim_init_sd_busy_us = strtod(argv[++i], NULL); 
+        }
+        else if (!strcmp(argv[i], "--sd-erase-us") && (i + 1 < argc))
+        {
+            sim_init_sd_erase_us = strtod(argv[++i], NULL); 
+        }
+        else if (!strcmp(argv[i], "--sd-erase-kb") && (i + 1 < argc))
+        {
+            sim_init_sd_erase_kb = (uint32_t)strtoul(argv[++i], NULL, 0); 
+        }
+        else if (!strcmp(argv[i], "--sd-fail") && (i + 1 < argc))
+        {
+            sim_init_sd_fail = strtod(argv[++i], NULL); 
+        }
+        else if (!strcmp(argv[i], "--sd-seed") && (i + 1 < argc))
+        {
+            sim_init_sd_seed = strtoull(argv[++i], NULL, 0); 
+        }
+        else
+        {
+            sim_init_usage(argv[0]); 
+        }
+    }
+
+    sim_radio_link(sim_init_radio_loss, 
+                   (uint64_t)(sim_init_radio_latency_us * (double)SIM_NS_PER_US), 
+                   sim_init_radio_seed); 
+    sim_radio_ack_loss(sim_init_radio_ack_loss); 
+
+    // 2 sectors per KB 
+    sim_sd_timing((uint64_t)(sim_init_sd_cmd_us * (double)SIM_NS_PER_US), 
+                  (uint64_t)(sim_init_sd_busy_us * (double)SIM_NS_PER_US), 
+                  (uint64_t)(sim_init_sd_erase_us * (double)SIM_NS_PER_US), 
+                  sim_init_sd_erase_kb * 2U); 
+    sim_sd_fail(sim_init_sd_fail, sim_init_sd_seed); 
+
+    if (sim_init_stdin)
+    {
+        sim_schedule(SIM_INIT_STDIN_POLL_NS, sim_stdin_poll, NULL); 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Run summary 
+
+void sim_core_report(const char *reason)
+{
+    const sim_core_stats_t *stats = sim_core_stats(); 
+    struct timespec now; 
+    double wall_s, sim_s; 
+
+    if (sim_init_quiet)
+    {
+        return; 
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now); 
+    wall_s = (double)(now.tv_sec - stats->wall_start.tv_sec) +
+             ((double)(now.tv_nsec - stats->wall_start.tv_nsec) / 1e9); 
+    sim_s = (double)stats->end_ns / (double)SIM_NS_PER_S; 
+
+    fflush(stdout); 
+    fprintf(stderr, "\n[sim] end of run: %s\n", reason); 
+    fprintf(stderr, "[sim]   simulated time  : %.6f s\n", sim_s); 
+    fprintf(stderr, "[sim]   wall time       : %.6f s (x%.2f)\n", 
+            wall_s, (wall_s > 0.0) ? (sim_s / wall_s) : 0.0); 
+    fprintf(stderr, "[sim]   register access : %llu\n", (unsigned long long)stats->accesses); 
+    fprintf(stderr, "[sim]   main loop passes: %llu\n", (unsigned long long)stats->loops); 
+    fprintf(stderr, "[sim]   time skipped    : %.6f s\n", 
+            (double)stats->skipped_ns / (double)SIM_NS_PER_S); 
+    fprintf(stderr, "[sim]   time in WFI     : %.6f s (%llu calls)\n", 
+            (double)stats->sleep_ns / (double)SIM_NS_PER_S, (unsigned long long)stats->wfi); 
+    fprintf(stderr, "[sim]   watchdog steps  : %llu\n", 
+            (unsigned long long)stats->watchdog_steps); 
+
+    if (sim_init_stats)
+    {
+        fprintf(stderr, "[sim]   interrupts:\n"); 
+
+        for (int irqn = (int)SysTick_IRQn; irqn <= (int)SPI5_IRQn; irqn++)
+        {
+            uint64_t count = sim_irq_count((IRQn_Type)irqn); 
+
+            if (count != 0)
+            {
+                fprintf(stderr, "[sim]     %4d : %llu\n", irqn, (unsigned long long)count); 
+            }
+        }
+
+        sim_radio_stats_t radio; 
+        sim_radio_stats(&radio); 
+
+        if (radio.packets != 0)
+        {
+            fprintf(stderr, "[sim]   radio link:\n"); 
+            fprintf(stderr, "[sim]     packets    : %llu\n", (unsigned long long)radio.packets); 
+            fprintf(stderr, "[sim]     delivered  : %llu\n", (unsigned long long)radio.delivered); 
+            fprintf(stderr, "[sim]     duplicates : %llu\n", (unsigned long long)radio.duplicates); 
+            fprintf(stderr, "[sim]     lost       : %llu\n", (unsigned long long)radio.lost); 
+            fprintf(stderr, "[sim]     ACKs lost  : %llu\n", (unsigned long long)radio.acks_lost); 
+            fprintf(stderr, "[sim]     ACKs late  : %llu\n", (unsigned long long)radio.acks_late); 
+            fprintf(stderr, "[sim]     MAX_RT     : %llu\n", (unsigned long long)radio.max_rt); 
+            fprintf(stderr, "[sim]     off channel: %llu\n", (unsigned long long)radio.off_channel); 
+            fprintf(stderr, "[sim]     channel    : %u (peer %u)\n", (unsigned)radio.channel, 
+                    (unsigned)radio.peer_channel); 
+        }
+
+        sim_sd_stats_t sd; 
+        sim_sd_stats(&sd); 
+
+        if ((sd.reads + sd.writes) != 0)
+        {
+            fprintf(stderr, "[sim]   sd card:\n"); 
+            fprintf(stderr, "[sim]     reads      : %llu (%llu sectors)\n", 
+                    (unsigned long long)sd.reads, (unsigned long long)sd.sectors_read); 
+            fprintf(stderr, "[sim]     writes     : %llu (%llu sectors)\n", 
+                    (unsigned long long)sd.writes, (unsigned long long)sd.sectors_written); 
+            fprintf(stderr, "[sim]     erase opens: %llu\n", (unsigned long long)sd.erase_changes); 
+            fprintf(stderr, "[sim]     busy       : %.6f s\n", 
+                    (double)sd.busy_ns / (double)SIM_NS_PER_S); 
+            fprintf(stderr, "[sim]     failures   : %llu\n", (unsigned long long)sd.failures); 
+        }
+    }
+}
+
+//=======================================================================================
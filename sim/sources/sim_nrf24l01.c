@@ -0,0 +1,957 @@
+/**
+ * @file sim_nrf24l01.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief nRF24L01 radio model with a simulated peer radio 
+ * 
+ * @details The radio on SPI2 (CSN PC1, CE PC0, IRQ PC4) is modelled at the command and 
+ *          register level: the registers, STATUS flags (write 1 to clear) and the IRQ 
+ *          pin, the 3 level RX and TX FIFOs, dynamic payload length and ACK payloads. A 
+ *          payload is sent when CE goes high in PTX mode (or is written while CE is 
+ *          high) and goes to a second radio inside the simulator that stays on the same 
+ *          channel, data rate and address as the MCU's radio, except while it follows a 
+ *          channel survey handshake (see below). 
+ * 
+ *          Each attempt takes the 130 us settling time plus the packet's air time at the 
+ *          data rate. Packets and ACKs are each lost with the probability set by 
+ *          sim_radio_link and each trip through the air is delayed by its latency. An 
+ *          ACK has to start arriving within the auto retransmit delay (ARD) that follows 
+ *          the packet or the packet is sent again, up to the auto retransmit count (ARC) 
+ *          before MAX_RT is set. OBSERVE_TX counts the retransmits and lost payloads. 
+ * 
+ *          The peer drops repeated packets (same PID and payload) and counts the link 
+ *          benchmark payloads it receives (nrf24l01_link.h). The benchmark's control 
+ *          payload clears the count. When the MCU's radio has ACK payloads on, the peer 
+ *          answers with its count (0xB3 then the count, little endian), which lands in the 
+ *          RX FIFO on pipe 0. The peer doesn't send on its own so a radio in PRX mode 
+ *          hears nothing from it. 
+ * 
+ *          Channels can be made busy with sim_radio_busy to stand in for other 2.4 GHz 
+ *          traffic. A busy channel loses packets and ACKs with its busy probability on 
+ *          top of the link loss, and RPD latches set with the same probability when CE 
+ *          goes low after the radio has listened (PRX, CE high) for the detector delay. 
+ *          sim_radio_ack_loss loses ACKs alone so a packet can arrive without the MCU's 
+ *          radio knowing. 
+ * 
+ *          The peer answers the channel survey handshake (nrf24l01_survey.h) the way the 
+ *          responder does: it moves to the channel in a change payload, goes back to the 
+ *          channel it was on if the confirmation doesn't come within 500 ms or no other 
+ *          payload follows the last confirmation within 1 s, and otherwise stays on the 
+ *          new channel, where the next handshake then starts. From the first change on 
+ *          it only hears packets sent on its own channel, and sim_radio_stats shows 
+ *          which channel each radio ended up on. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sim_model.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Wiring 
+#define SIM_NRF24L01_SPI SPI2 
+#define SIM_NRF24L01_CS_PORT GPIOC 
+#define SIM_NRF24L01_CS_PIN 1U 
+#define SIM_NRF24L01_CE_PORT GPIOC 
+#define SIM_NRF24L01_CE_PIN 0U 
+#define SIM_NRF24L01_IRQ_PORT GPIOC 
+#define SIM_NRF24L01_IRQ_PIN 4U 
+
+// Commands 
+#define SIM_NRF24L01_W_REGISTER 0x20U 
+#define SIM_NRF24L01_REGISTER_MASK 0x1FU 
+#define SIM_NRF24L01_R_RX_PL_WID 0x60U 
+#define SIM_NRF24L01_R_RX_PAYLOAD 0x61U 
+#define SIM_NRF24L01_W_TX_PAYLOAD 0xA0U 
+#define SIM_NRF24L01_W_ACK_PAYLOAD 0xA8U   // 0xA8 - 0xAD (pipe in the low bits) 
+#define SIM_NRF24L01_W_TX_NOACK 0xB0U 
+#define SIM_NRF24L01_FLUSH_TX 0xE1U 
+#define SIM_NRF24L01_FLUSH_RX 0xE2U 
+
+// Registers 
+#define SIM_NRF24L01_CONFIG 0x00U 
+#define SIM_NRF24L01_EN_AA 0x01U 
+#define SIM_NRF24L01_EN_RXADDR 0x02U 
+#define SIM_NRF24L01_SETUP_AW 0x03U 
+#define SIM_NRF24L01_SETUP_RETR 0x04U 
+#define SIM_NRF24L01_RF_CH 0x05U 
+#define SIM_NRF24L01_RF_SETUP 0x06U 
+#define SIM_NRF24L01_STATUS 0x07U 
+#define SIM_NRF24L01_OBSERVE_TX 0x08U 
+#define SIM_NRF24L01_RPD 0x09U 
+#define SIM_NRF24L01_RX_ADDR_P0 0x0AU 
+#define SIM_NRF24L01_RX_ADDR_P1 0x0BU 
+#define SIM_NRF24L01_RX_ADDR_P2 0x0CU 
+#define SIM_NRF24L01_TX_ADDR 0x10U 
+#define SIM_NRF24L01_FIFO_STATUS 0x17U 
+#define SIM_NRF24L01_DYNPD 0x1CU 
+#define SIM_NRF24L01_FEATURE 0x1DU 
+#define SIM_NRF24L01_REGS 0x20U 
+
+// Register bits 
+#define SIM_NRF24L01_CONFIG_IRQS 0x70U     // MASK_RX_DR, MASK_TX_DS and MASK_MAX_RT 
+#define SIM_NRF24L01_CONFIG_EN_CRC 0x08U 
+#define SIM_NRF24L01_CONFIG_CRCO 0x04U 
+#define SIM_NRF24L01_CONFIG_PWR_UP 0x02U 
+#define SIM_NRF24L01_CONFIG_PRIM_RX 0x01U 
+#define SIM_NRF24L01_RX_DR 0x40U 
+#define SIM_NRF24L01_TX_DS 0x20U 
+#define SIM_NRF24L01_MAX_RT 0x10U 
+#define SIM_NRF24L01_RX_P_NO_EMPTY 0x0EU 
+#define SIM_NRF24L01_STATUS_TX_FULL 0x01U 
+#define SIM_NRF24L01_RF_DR_LOW 0x20U 
+#define SIM_NRF24L01_RF_DR_HIGH 0x08U 
+#define SIM_NRF24L01_TX_FULL 0x20U 
+#define SIM_NRF24L01_TX_EMPTY 0x10U 
+#define SIM_NRF24L01_RX_FULL 0x02U 
+#define SIM_NRF24L01_RX_EMPTY 0x01U 
+#define SIM_NRF24L01_EN_DPL 0x04U 
+#define SIM_NRF24L01_EN_ACK_PAY 0x02U 
+
+// Radio 
+#define SIM_NRF24L01_FIFO_DEPTH 3U 
+#define SIM_NRF24L01_PAYLOAD_MAX 32U 
+#define SIM_NRF24L01_ADDR_MAX 5U 
+#define SIM_NRF24L01_PLOS_MAX 15U 
+#define SIM_NRF24L01_SETTLE_NS (130ULL * SIM_NS_PER_US)   // RX/TX settling time 
+#define SIM_NRF24L01_ARD_NS (250ULL * SIM_NS_PER_US)      // Retransmit delay step 
+#define SIM_NRF24L01_PCF_BITS 9U                          // Packet control field 
+#define SIM_NRF24L01_LOSS_SCALE 1000000U                  // Loss probability scale 
+#define SIM_NRF24L01_CHANNELS 126U                        // RF channels 
+#define SIM_NRF24L01_RPD_NS (170ULL * SIM_NS_PER_US)      // RX settling + RPD delay 
+
+// Link benchmark payload tags (nrf24l01_link.h) 
+#define SIM_NRF24L01_LINK_DATA 0xB1U 
+#define SIM_NRF24L01_LINK_CTRL 0xB2U 
+#define SIM_NRF24L01_LINK_PEER 0xB3U 
+#define SIM_NRF24L01_LINK_PEER_LEN 5U 
+
+// Channel survey handshake (nrf24l01_survey.h) 
+#define SIM_NRF24L01_SURVEY_TAG 0xB4U 
+#define SIM_NRF24L01_SURVEY_CHANGE 0x01U 
+#define SIM_NRF24L01_SURVEY_CONFIRM 0x02U 
+#define SIM_NRF24L01_SURVEY_LEN 3U 
+#define SIM_NRF24L01_SURVEY_CONFIRM_NS (500ULL * SIM_NS_PER_MS)    // Wait for the confirmation 
+#define SIM_NRF24L01_SURVEY_TRAFFIC_NS (1000ULL * SIM_NS_PER_MS)   // Wait for traffic after it 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+// Peer channel survey state 
+typedef enum {
+    SIM_NRF24L01_PEER_FOLLOW,          // On the MCU radio's channel (no handshake yet) 
+    SIM_NRF24L01_PEER_MOVED,           // Moved, waiting for the confirmation 
+    SIM_NRF24L01_PEER_CONFIRMED,       // Confirmed, waiting for other traffic 
+    SIM_NRF24L01_PEER_STAY             // Staying on its channel 
+} sim_nrf24l01_peer_state_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Payload in a FIFO 
+typedef struct sim_nrf24l01_payload_s
+{
+    uint8_t data[SIM_NRF24L01_PAYLOAD_MAX]; 
+    uint8_t len; 
+    uint8_t pipe;                      // Pipe (RX FIFO) or no ACK requested (TX FIFO) 
+}
+sim_nrf24l01_payload_t; 
+
+
+// Payload FIFO 
+typedef struct sim_nrf24l01_fifo_s
+{
+    sim_nrf24l01_payload_t entries[SIM_NRF24L01_FIFO_DEPTH]; 
+    uint8_t head;                      // Oldest entry 
+    uint8_t count;                     // Entries held 
+}
+sim_nrf24l01_fifo_t; 
+
+
+// Radio state 
+typedef struct sim_nrf24l01_s
+{
+    sim_spi_device_t device;           // SPI bus attachment 
+    uint8_t regs[SIM_NRF24L01_REGS];   // Single byte registers 
+    uint8_t addr[3][SIM_NRF24L01_ADDR_MAX];   // RX_ADDR_P0, RX_ADDR_P1 and TX_ADDR 
+    sim_nrf24l01_fifo_t rx;            // Received payloads 
+    sim_nrf24l01_fifo_t tx;            // Payloads to send 
+    sim_nrf24l01_payload_t write;      // Payload being written over SPI 
+    uint8_t cmd;                       // Command of the SPI transaction 
+    uint8_t index;                     // Bytes exchanged in the SPI transaction 
+    uint8_t ce;                        // CE pin level 
+    uint8_t irq;                       // IRQ pin level driven (0xFF before the first) 
+
+    // Transmit 
+    uint8_t sending;                   // Packet on the air 
+    uint8_t acked;                     // Outcome of the attempt in progress 
+    uint8_t retransmits;               // Retransmits of the payload being sent 
+    uint8_t arc_cnt;                   // OBSERVE_TX - retransmits of the last payload 
+    uint8_t plos_cnt;                  // OBSERVE_TX - payloads that hit MAX_RT 
+    uint8_t pid;                       // Packet ID of the payload being sent 
+    sim_nrf24l01_payload_t ack;        // ACK payload of the attempt in progress 
+
+    // Air 
+    uint32_t loss;                     // Loss probability per SIM_NRF24L01_LOSS_SCALE 
+    uint64_t latency_ns;               // Extra delay each way 
+    uint64_t rng;                      // Random state (xorshift64) 
+    uint32_t busy[SIM_NRF24L01_CHANNELS];   // Busy probability per SIM_NRF24L01_LOSS_SCALE 
+    uint64_t listen_ns;                // Time CE went high 
+    uint32_t ack_loss;                 // ACK loss probability per SIM_NRF24L01_LOSS_SCALE 
+
+    // Peer radio 
+    uint8_t peer_pid;                  // PID of the last packet received 
+    uint8_t peer_valid;                // A packet has been received 
+    sim_nrf24l01_payload_t peer_last;  // Last packet received (repeat check) 
+    uint32_t peer_count;               // Benchmark payloads received 
+    uint32_t peer_ack;                 // Count sent with the last ACK 
+    sim_nrf24l01_peer_state_t peer_state;   // Channel survey state 
+    uint8_t peer_channel;              // Channel once the peer stops following 
+    uint8_t peer_home;                 // Channel the last handshake started on 
+    uint64_t peer_step_ns;             // Time of the last handshake step 
+
+    sim_radio_stats_t stats; 
+}
+sim_nrf24l01_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Globals 
+
+static sim_nrf24l01_t sim_nrf24l01; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+static void sim_nrf24l01_attempt(sim_nrf24l01_t *radio, uint64_t start_ns); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helpers 
+
+// Random number (xorshift64) 
+static uint64_t sim_nrf24l01_random(sim_nrf24l01_t *radio)
+{
+    radio->rng ^= radio->rng << 13; 
+    radio->rng ^= radio->rng >> 7; 
+    radio->rng ^= radio->rng << 17; 
+    return radio->rng; 
+}
+
+
+// Check if the current channel is busy 
+static uint8_t sim_nrf24l01_busy(sim_nrf24l01_t *radio)
+{
+    uint8_t channel = radio->regs[SIM_NRF24L01_RF_CH]; 
+    uint32_t busy = (channel < SIM_NRF24L01_CHANNELS) ? radio->busy[channel] : 0; 
+
+    return (busy != 0) && ((sim_nrf24l01_random(radio) % SIM_NRF24L01_LOSS_SCALE) < busy); 
+}
+
+
+// Check if a packet is lost 
+static uint8_t sim_nrf24l01_lost(sim_nrf24l01_t *radio)
+{
+    uint8_t lost = (radio->loss != 0) &&
+                   ((sim_nrf24l01_random(radio) % SIM_NRF24L01_LOSS_SCALE) < radio->loss); 
+
+    return sim_nrf24l01_busy(radio) || lost; 
+}
+
+
+// Check if an ACK is lost 
+static uint8_t sim_nrf24l01_ack_lost(sim_nrf24l01_t *radio)
+{
+    uint8_t ack_lost = (radio->ack_loss != 0) &&
+                       ((sim_nrf24l01_random(radio) % SIM_NRF24L01_LOSS_SCALE) < radio->ack_loss); 
+
+    return sim_nrf24l01_lost(radio) || ack_lost; 
+}
+
+
+// Address width (bytes) 
+static uint8_t sim_nrf24l01_aw(const sim_nrf24l01_t *radio)
+{
+    uint8_t aw = radio->regs[SIM_NRF24L01_SETUP_AW] & 0x03U; 
+    return (aw == 0) ? 3U : (uint8_t)(aw + 2U); 
+}
+
+
+// Air time of a number of bits at the data rate 
+static uint64_t sim_nrf24l01_bits_ns(const sim_nrf24l01_t *radio, uint32_t bits)
+{
+    uint8_t rf_setup = radio->regs[SIM_NRF24L01_RF_SETUP]; 
+    uint64_t bps = (rf_setup & SIM_NRF24L01_RF_DR_LOW) ? 250000ULL :
+                   (rf_setup & SIM_NRF24L01_RF_DR_HIGH) ? 2000000ULL : 1000000ULL; 
+
+    return ((uint64_t)bits * SIM_NS_PER_S) / bps; 
+}
+
+
+// Air time of a packet - preamble, address, packet control field, payload and CRC 
+static uint64_t sim_nrf24l01_packet_ns(const sim_nrf24l01_t *radio, uint8_t len)
+{
+    uint8_t config = radio->regs[SIM_NRF24L01_CONFIG]; 
+    uint32_t crc = !(config & SIM_NRF24L01_CONFIG_EN_CRC) ? 0U :
+                   (config & SIM_NRF24L01_CONFIG_CRCO) ? 2U : 1U; 
+    uint32_t bytes = 1U + sim_nrf24l01_aw(radio) + len + crc; 
+
+    return sim_nrf24l01_bits_ns(radio, (bytes * 8U) + SIM_NRF24L01_PCF_BITS); 
+}
+
+
+// STATUS register 
+static uint8_t sim_nrf24l01_status(const sim_nrf24l01_t *radio)
+{
+    uint8_t status = radio->regs[SIM_NRF24L01_STATUS] & SIM_NRF24L01_CONFIG_IRQS; 
+
+    status |= (radio->rx.count != 0) ?
+              (uint8_t)(radio->rx.entries[radio->rx.head].pipe << 1) :
+              SIM_NRF24L01_RX_P_NO_EMPTY; 
+
+    if (radio->tx.count == SIM_NRF24L01_FIFO_DEPTH)
+    {
+        status |= SIM_NRF24L01_STATUS_TX_FULL; 
+    }
+
+    return status; 
+}
+
+
+// FIFO_STATUS register 
+static uint8_t sim_nrf24l01_fifo_status(const sim_nrf24l01_t *radio)
+{
+    uint8_t fifo_status = 0; 
+
+    fifo_status |= (radio->tx.count == 0) ? SIM_NRF24L01_TX_EMPTY : 0U; 
+    fifo_status |= (radio->tx.count == SIM_NRF24L01_FIFO_DEPTH) ? SIM_NRF24L01_TX_FULL : 0U; 
+    fifo_status |= (radio->rx.count == 0) ? SIM_NRF24L01_RX_EMPTY : 0U; 
+    fifo_status |= (radio->rx.count == SIM_NRF24L01_FIFO_DEPTH) ? SIM_NRF24L01_RX_FULL : 0U; 
+
+    return fifo_status; 
+}
+
+
+// Add a payload to a FIFO 
+static uint8_t sim_nrf24l01_push(sim_nrf24l01_fifo_t *fifo, const sim_nrf24l01_payload_t *payload)
+{
+    if (fifo->count == SIM_NRF24L01_FIFO_DEPTH)
+    {
+        return 0; 
+    }
+
+    fifo->entries[(fifo->head + fifo->count) % SIM_NRF24L01_FIFO_DEPTH] = *payload; 
+    fifo->count++; 
+    return 1; 
+}
+
+
+// Remove the oldest payload from a FIFO 
+static void sim_nrf24l01_pop(sim_nrf24l01_fifo_t *fifo)
+{
+    if (fifo->count != 0)
+    {
+        fifo->head = (uint8_t)((fifo->head + 1U) % SIM_NRF24L01_FIFO_DEPTH); 
+        fifo->count--; 
+    }
+}
+
+
+// Drive the IRQ pin (active low) 
+static void sim_nrf24l01_irq(sim_nrf24l01_t *radio)
+{
+    uint8_t active = radio->regs[SIM_NRF24L01_STATUS] & SIM_NRF24L01_CONFIG_IRQS &
+                     (uint8_t)~radio->regs[SIM_NRF24L01_CONFIG]; 
+    uint8_t level = (active != 0) ? 0U : 1U; 
+
+    if (level != radio->irq)
+    {
+        radio->irq = level; 
+        sim_gpio_input(SIM_NRF24L01_IRQ_PORT, SIM_NRF24L01_IRQ_PIN, level); 
+    }
+}
+
+
+// Address register storage (NULL for single byte registers) 
+static uint8_t *sim_nrf24l01_addr(sim_nrf24l01_t *radio, uint8_t reg)
+{
+    switch (reg)
+    {
+        case SIM_NRF24L01_RX_ADDR_P0: return radio->addr[0]; 
+        case SIM_NRF24L01_RX_ADDR_P1: return radio->addr[1]; 
+        case SIM_NRF24L01_TX_ADDR: return radio->addr[2]; 
+        default: return NULL; 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Peer radio 
+
+// Channel the peer listens on - goes home if a channel change stalls 
+static uint8_t sim_nrf24l01_peer_channel(sim_nrf24l01_t *radio)
+{
+    uint64_t wait_ns; 
+
+    switch (radio->peer_state)
+    {
+        case SIM_NRF24L01_PEER_FOLLOW:
+            radio->peer_channel = radio->regs[SIM_NRF24L01_RF_CH]; 
+            break; 
+
+        case SIM_NRF24L01_PEER_MOVED:
+        case SIM_NRF24L01_PEER_CONFIRMED:
+            wait_ns = (radio->peer_state == SIM_NRF24L01_PEER_MOVED) ? 
+                      SIM_NRF24L01_SURVEY_CONFIRM_NS : SIM_NRF24L01_SURVEY_TRAFFIC_NS; 
+
+            if ((sim_time_ns() - radio->peer_step_ns) >= wait_ns)
+            {
+                radio->peer_channel = radio->peer_home; 
+                radio->peer_state = SIM_NRF24L01_PEER_STAY; 
+            }
+            break; 
+
+        default:
+            break; 
+    }
+
+    return radio->peer_channel; 
+}
+
+
+// Follow the channel survey handshake 
+static void sim_nrf24l01_peer_survey(sim_nrf24l01_t *radio, const sim_nrf24l01_payload_t *packet)
+{
+    uint8_t handshake = (packet->len >= SIM_NRF24L01_SURVEY_LEN) && 
+                        (packet->data[0] == SIM_NRF24L01_SURVEY_TAG); 
+    uint8_t waiting = (radio->peer_state == SIM_NRF24L01_PEER_MOVED) || 
+                      (radio->peer_state == SIM_NRF24L01_PEER_CONFIRMED); 
+
+    if (!handshake)
+    {
+        // Other traffic on the new channel completes a change 
+        if (waiting)
+        {
+            radio->peer_state = SIM_NRF24L01_PEER_STAY; 
+        }
+    }
+    else if ((packet->data[1] == SIM_NRF24L01_SURVEY_CHANGE) && 
+             (packet->data[2] < SIM_NRF24L01_CHANNELS))
+    {
+        // A change that starts a handshake comes on the channel both radios are on 
+        if (!waiting)
+        {
+            radio->peer_home = radio->peer_channel; 
+        }
+
+        radio->peer_channel = packet->data[2]; 
+        radio->peer_state = SIM_NRF24L01_PEER_MOVED; 
+        radio->peer_step_ns = sim_time_ns(); 
+    }
+    else if ((packet->data[1] == SIM_NRF24L01_SURVEY_CONFIRM) && waiting)
+    {
+        radio->peer_state = SIM_NRF24L01_PEER_CONFIRMED; 
+        radio->peer_step_ns = sim_time_ns(); 
+    }
+}
+
+
+// Packet arrives at the peer - returns the count to send back in the ACK payload 
+static uint32_t sim_nrf24l01_peer_receive(sim_nrf24l01_t *radio, const sim_nrf24l01_payload_t *packet)
+{
+    const sim_nrf24l01_payload_t *last = &radio->peer_last; 
+
+    // A retransmit of a packet whose ACK was lost 
+    if (radio->peer_valid && (radio->peer_pid == radio->pid) && (last->len == packet->len) &&
+        !memcmp(last->data, packet->data, packet->len))
+    {
+        radio->stats.duplicates++; 
+        return radio->peer_ack; 
+    }
+
+    radio->stats.delivered++; 
+    radio->peer_valid = 1; 
+    radio->peer_pid = radio->pid; 
+    radio->peer_last = *packet; 
+    sim_nrf24l01_peer_survey(radio, packet); 
+
+    // The ACK payload was loaded before the packet arrived 
+    radio->peer_ack = radio->peer_count; 
+
+    if (packet->len != 0)
+    {
+        if (packet->data[0] == SIM_NRF24L01_LINK_CTRL)
+        {
+            radio->peer_count = 0; 
+        }
+        else if (packet->data[0] == SIM_NRF24L01_LINK_DATA)
+        {
+            radio->peer_count++; 
+        }
+    }
+
+    return radio->peer_ack; 
+}
+
+
+// Build the peer's ACK payload (length 0 if the MCU radio doesn't take ACK payloads) 
+static void sim_nrf24l01_peer_ack(sim_nrf24l01_t *radio, uint32_t count)
+{
+    uint8_t features = SIM_NRF24L01_EN_DPL | SIM_NRF24L01_EN_ACK_PAY; 
+
+    radio->ack.len = 0; 
+    radio->ack.pipe = 0; 
+
+    if (((radio->regs[SIM_NRF24L01_FEATURE] & features) == features) &&
+        (radio->regs[SIM_NRF24L01_DYNPD] & 0x01U))
+    {
+        radio->ack.data[0] = SIM_NRF24L01_LINK_PEER; 
+        radio->ack.data[1] = (uint8_t)count; 
+        radio->ack.data[2] = (uint8_t)(count >> 8); 
+        radio->ack.data[3] = (uint8_t)(count >> 16); 
+        radio->ack.data[4] = (uint8_t)(count >> 24); 
+        radio->ack.len = SIM_NRF24L01_LINK_PEER_LEN; 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Transmit 
+
+// Start sending the oldest TX FIFO payload if the radio is in PTX mode with CE high 
+static void sim_nrf24l01_tx_start(sim_nrf24l01_t *radio)
+{
+    uint8_t config = radio->regs[SIM_NRF24L01_CONFIG]; 
+
+    // MAX_RT stops the radio until it's cleared 
+    if (radio->sending || !radio->ce || (radio->tx.count == 0) ||
+        (config & SIM_NRF24L01_CONFIG_PRIM_RX) || !(config & SIM_NRF24L01_CONFIG_PWR_UP) ||
+        (radio->regs[SIM_NRF24L01_STATUS] & SIM_NRF24L01_MAX_RT))
+    {
+        return; 
+    }
+
+    radio->sending = 1; 
+    radio->retransmits = 0; 
+    radio->arc_cnt = 0; 
+    radio->pid = (uint8_t)((radio->pid + 1U) & 0x03U); 
+    sim_nrf24l01_attempt(radio, sim_time_ns()); 
+}
+
+
+// End of an attempt 
+static void sim_nrf24l01_attempt_done(void *context)
+{
+    sim_nrf24l01_t *radio = (sim_nrf24l01_t *)context; 
+    uint8_t arc = (uint8_t)(radio->regs[SIM_NRF24L01_SETUP_RETR] & 0x0FU); 
+
+    // Payload flushed while it was on the air 
+    if (radio->tx.count == 0)
+    {
+        radio->sending = 0; 
+        return; 
+    }
+
+    if (radio->acked)
+    {
+        sim_nrf24l01_pop(&radio->tx); 
+        radio->arc_cnt = radio->retransmits; 
+        radio->regs[SIM_NRF24L01_STATUS] |= SIM_NRF24L01_TX_DS; 
+
+        if ((radio->ack.len != 0) && sim_nrf24l01_push(&radio->rx, &radio->ack))
+        {
+            radio->regs[SIM_NRF24L01_STATUS] |= SIM_NRF24L01_RX_DR; 
+        }
+    }
+    else if (radio->retransmits < arc)
+    {
+        radio->retransmits++; 
+        sim_nrf24l01_attempt(radio, sim_time_ns()); 
+        return; 
+    }
+    else
+    {
+        radio->arc_cnt = radio->retransmits; 
+        radio->plos_cnt += (radio->plos_cnt < SIM_NRF24L01_PLOS_MAX) ? 1U : 0U; 
+        radio->regs[SIM_NRF24L01_STATUS] |= SIM_NRF24L01_MAX_RT; 
+        radio->stats.max_rt++; 
+    }
+
+    radio->sending = 0; 
+    sim_nrf24l01_irq(radio); 
+
+    // CE held high keeps sending while there are payloads 
+    sim_nrf24l01_tx_start(radio); 
+}
+
+
+// Send the oldest TX FIFO payload once and schedule the outcome 
+static void sim_nrf24l01_attempt(sim_nrf24l01_t *radio, uint64_t start_ns)
+{
+    const sim_nrf24l01_payload_t *packet = &radio->tx.entries[radio->tx.head]; 
+    uint64_t ard_ns = (uint64_t)((radio->regs[SIM_NRF24L01_SETUP_RETR] >> 4) + 1U) *
+                      SIM_NRF24L01_ARD_NS; 
+    uint64_t tx_end_ns = start_ns + SIM_NRF24L01_SETTLE_NS +
+                         sim_nrf24l01_packet_ns(radio, packet->len); 
+    uint64_t done_ns = tx_end_ns + ard_ns; 
+    uint8_t no_ack = packet->pipe || !(radio->regs[SIM_NRF24L01_EN_AA] & 0x01U); 
+
+    radio->stats.packets++; 
+    radio->acked = 0; 
+
+    if (sim_nrf24l01_peer_channel(radio) != radio->regs[SIM_NRF24L01_RF_CH])
+    {
+        radio->stats.off_channel++; 
+    }
+    else if (sim_nrf24l01_lost(radio))
+    {
+        radio->stats.lost++; 
+    }
+    else
+    {
+        uint32_t count = sim_nrf24l01_peer_receive(radio, packet); 
+
+        if (no_ack)
+        {
+            radio->acked = 1; 
+            radio->ack.len = 0; 
+            done_ns = tx_end_ns; 
+        }
+        else
+        {
+            // The ACK has to start arriving (address matched) within the retransmit delay 
+            uint64_t ack_start_ns = tx_end_ns + (2U * radio->latency_ns) + SIM_NRF24L01_SETTLE_NS; 
+            uint64_t ack_addr_ns = sim_nrf24l01_bits_ns(radio, (1U + sim_nrf24l01_aw(radio)) * 8U); 
+
+            sim_nrf24l01_peer_ack(radio, count); 
+
+            if (sim_nrf24l01_ack_lost(radio))
+            {
+                radio->stats.acks_lost++; 
+            }
+            else if ((ack_start_ns + ack_addr_ns) > (tx_end_ns + ard_ns))
+            {
+                radio->stats.acks_late++; 
+            }
+            else
+            {
+                radio->acked = 1; 
+                done_ns = ack_start_ns + sim_nrf24l01_packet_ns(radio, radio->ack.len); 
+            }
+        }
+    }
+
+    // Without an ACK the radio waits out the retransmit delay 
+    sim_schedule(done_ns, sim_nrf24l01_attempt_done, radio); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// SPI 
+
+// Register read 
+static uint8_t sim_nrf24l01_reg_read(sim_nrf24l01_t *radio, uint8_t reg, uint8_t index)
+{
+    uint8_t *addr = sim_nrf24l01_addr(radio, reg); 
+
+    if (addr != NULL)
+    {
+        return (index < sim_nrf24l01_aw(radio)) ? addr[index] : 0U; 
+    }
+
+    switch (reg)
+    {
+        case SIM_NRF24L01_STATUS: return sim_nrf24l01_status(radio); 
+        case SIM_NRF24L01_FIFO_STATUS: return sim_nrf24l01_fifo_status(radio); 
+        case SIM_NRF24L01_OBSERVE_TX: return (uint8_t)((radio->plos_cnt << 4) | radio->arc_cnt); 
+        default: return radio->regs[reg]; 
+    }
+}
+
+
+// Register write 
+static void sim_nrf24l01_reg_write(sim_nrf24l01_t *radio, uint8_t reg, uint8_t index, uint8_t data)
+{
+    uint8_t *addr = sim_nrf24l01_addr(radio, reg); 
+
+    if (addr != NULL)
+    {
+        if (index < SIM_NRF24L01_ADDR_MAX)
+        {
+            addr[index] = data; 
+        }
+        return; 
+    }
+
+    if (index != 0)
+    {
+        return; 
+    }
+
+    switch (reg)
+    {
+        case SIM_NRF24L01_STATUS:
+            radio->regs[reg] &= (uint8_t)~(data & SIM_NRF24L01_CONFIG_IRQS); 
+            break; 
+
+        case SIM_NRF24L01_OBSERVE_TX:
+        case SIM_NRF24L01_RPD:
+        case SIM_NRF24L01_FIFO_STATUS:
+            break; 
+
+        case SIM_NRF24L01_RF_CH:
+            // Changing channel clears the lost payload count 
+            radio->regs[reg] = data & 0x7FU; 
+            radio->plos_cnt = 0; 
+            break; 
+
+        default:
+            radio->regs[reg] = data; 
+            break; 
+    }
+}
+
+
+// Exchange one byte 
+static uint16_t sim_nrf24l01_transfer(void *context, uint16_t mosi)
+{
+    sim_nrf24l01_t *radio = (sim_nrf24l01_t *)context; 
+    uint8_t data = (uint8_t)mosi, miso = 0; 
+    uint8_t index, cmd; 
+
+    // The command byte clocks out STATUS 
+    if (radio->index == 0)
+    {
+        radio->cmd = data; 
+        radio->index = 1; 
+        radio->write.len = 0; 
+        return sim_nrf24l01_status(radio); 
+    }
+
+    index = (uint8_t)(radio->index - 1U); 
+    cmd = radio->cmd; 
+    radio->index += (radio->index < UINT8_MAX) ? 1U : 0U; 
+
+    if (cmd < SIM_NRF24L01_W_REGISTER)
+    {
+        miso = sim_nrf24l01_reg_read(radio, cmd & SIM_NRF24L01_REGISTER_MASK, index); 
+    }
+    else if (cmd < (2U * SIM_NRF24L01_W_REGISTER))
+    {
+        sim_nrf24l01_reg_write(radio, cmd & SIM_NRF24L01_REGISTER_MASK, index, data); 
+        sim_nrf24l01_irq(radio); 
+    }
+    else if (cmd == SIM_NRF24L01_R_RX_PL_WID)
+    {
+        miso = (radio->rx.count != 0) ? radio->rx.entries[radio->rx.head].len : 0U; 
+    }
+    else if (cmd == SIM_NRF24L01_R_RX_PAYLOAD)
+    {
+        const sim_nrf24l01_payload_t *payload = &radio->rx.entries[radio->rx.head]; 
+        miso = ((radio->rx.count != 0) && (index < payload->len)) ? payload->data[index] : 0U; 
+    }
+    else if ((cmd == SIM_NRF24L01_W_TX_PAYLOAD) || (cmd == SIM_NRF24L01_W_TX_NOACK) ||
+             ((cmd & 0xF8U) == SIM_NRF24L01_W_ACK_PAYLOAD))
+    {
+        if (index < SIM_NRF24L01_PAYLOAD_MAX)
+        {
+            radio->write.data[index] = data; 
+            radio->write.len = (uint8_t)(index + 1U); 
+        }
+    }
+
+    return miso; 
+}
+
+
+// Commands take effect when the radio is deselected 
+static void sim_nrf24l01_select(void *context, uint8_t selected)
+{
+    sim_nrf24l01_t *radio = (sim_nrf24l01_t *)context; 
+    uint8_t cmd = radio->cmd; 
+
+    if (selected || (radio->index == 0))
+    {
+        radio->index = 0; 
+        return; 
+    }
+
+    if ((cmd == SIM_NRF24L01_R_RX_PAYLOAD) && (radio->index > 1U))
+    {
+        sim_nrf24l01_pop(&radio->rx); 
+    }
+    else if (((cmd == SIM_NRF24L01_W_TX_PAYLOAD) || (cmd == SIM_NRF24L01_W_TX_NOACK) ||
+              ((cmd & 0xF8U) == SIM_NRF24L01_W_ACK_PAYLOAD)) && (radio->write.len != 0))
+    {
+        // ACK payloads (PRX) are held but never sent since the peer doesn't send 
+        radio->write.pipe = (cmd == SIM_NRF24L01_W_TX_NOACK) ? 1U : 0U; 
+        sim_nrf24l01_push(&radio->tx, &radio->write); 
+    }
+    else if (cmd == SIM_NRF24L01_FLUSH_TX)
+    {
+        radio->tx.count = 0; 
+    }
+    else if (cmd == SIM_NRF24L01_FLUSH_RX)
+    {
+        radio->rx.count = 0; 
+    }
+
+    radio->index = 0; 
+    sim_nrf24l01_irq(radio); 
+    sim_nrf24l01_tx_start(radio); 
+}
+
+
+// CE pin 
+static void sim_nrf24l01_ce_listener(void *context, GPIO_TypeDef *gpio, uint8_t pin, uint8_t level)
+{
+    sim_nrf24l01_t *radio = (sim_nrf24l01_t *)context; 
+
+    if ((gpio == SIM_NRF24L01_CE_PORT) && (pin == SIM_NRF24L01_CE_PIN))
+    {
+        uint8_t listening = (radio->regs[SIM_NRF24L01_CONFIG] & 
+                             (SIM_NRF24L01_CONFIG_PWR_UP | SIM_NRF24L01_CONFIG_PRIM_RX)) == 
+                            (SIM_NRF24L01_CONFIG_PWR_UP | SIM_NRF24L01_CONFIG_PRIM_RX); 
+
+        // The power detector latches when CE goes low after listening long enough 
+        if (level && !radio->ce)
+        {
+            radio->listen_ns = sim_time_ns(); 
+        }
+        else if (!level && radio->ce && listening)
+        {
+            radio->regs[SIM_NRF24L01_RPD] = 
+                ((sim_time_ns() - radio->listen_ns) >= SIM_NRF24L01_RPD_NS) && 
+                sim_nrf24l01_busy(radio); 
+        }
+
+        radio->ce = level; 
+        sim_nrf24l01_tx_start(radio); 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Control 
+
+// Set the loss, latency and random seed of the link 
+void sim_radio_link(double loss_percent, uint64_t latency_ns, uint64_t seed)
+{
+    double loss = (loss_percent < 0.0) ? 0.0 : (loss_percent > 100.0) ? 100.0 : loss_percent; 
+
+    sim_nrf24l01.loss = (uint32_t)((loss * (double)SIM_NRF24L01_LOSS_SCALE) / 100.0); 
+    sim_nrf24l01.latency_ns = latency_ns; 
+    sim_nrf24l01.rng = (seed != 0) ? seed : 1U; 
+}
+
+
+// Make a range of channels busy 
+void sim_radio_busy(uint8_t first, uint8_t last, double percent)
+{
+    double busy = (percent < 0.0) ? 0.0 : (percent > 100.0) ? 100.0 : percent; 
+
+    for (uint32_t channel = first; (channel <= last) && (channel < SIM_NRF24L01_CHANNELS); channel++)
+    {
+        sim_nrf24l01.busy[channel] = (uint32_t)((busy * (double)SIM_NRF24L01_LOSS_SCALE) / 100.0); 
+    }
+}
+
+
+// Lose the peer's ACKs 
+void sim_radio_ack_loss(double percent)
+{
+    double ack_loss = (percent < 0.0) ? 0.0 : (percent > 100.0) ? 100.0 : percent; 
+
+    sim_nrf24l01.ack_loss = (uint32_t)((ack_loss * (double)SIM_NRF24L01_LOSS_SCALE) / 100.0); 
+}
+
+
+// Link statistics 
+void sim_radio_stats(sim_radio_stats_t *stats)
+{
+    *stats = sim_nrf24l01.stats; 
+    stats->channel = sim_nrf24l01.regs[SIM_NRF24L01_RF_CH]; 
+    stats->peer_channel = sim_nrf24l01_peer_channel(&sim_nrf24l01); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Registration 
+
+// Release the IRQ pin (high) at power on 
+static void sim_nrf24l01_power_on(void *context)
+{
+    sim_nrf24l01_irq((sim_nrf24l01_t *)context); 
+}
+
+
+SIM_MODEL_INIT static void sim_nrf24l01_init(void)
+{
+    static const uint8_t resets[][2] =
+    {
+        { SIM_NRF24L01_CONFIG, 0x08U }, { SIM_NRF24L01_EN_AA, 0x3FU }, 
+        { SIM_NRF24L01_EN_RXADDR, 0x03U }, { SIM_NRF24L01_SETUP_AW, 0x03U }, 
+        { SIM_NRF24L01_SETUP_RETR, 0x03U }, { SIM_NRF24L01_RF_CH, 0x02U }, 
+        { SIM_NRF24L01_RF_SETUP, 0x0EU }, { SIM_NRF24L01_STATUS, 0x0EU }, 
+        { SIM_NRF24L01_RX_ADDR_P2, 0xC3U }, { SIM_NRF24L01_RX_ADDR_P2 + 1U, 0xC4U }, 
+        { SIM_NRF24L01_RX_ADDR_P2 + 2U, 0xC5U }, { SIM_NRF24L01_RX_ADDR_P2 + 3U, 0xC6U }
+    }; 
+    sim_nrf24l01_t *radio = &sim_nrf24l01; 
+
+    for (uint8_t i = 0; i < (sizeof(resets) / sizeof(resets[0])); i++)
+    {
+        radio->regs[resets[i][0]] = resets[i][1]; 
+    }
+
+    memset(radio->addr[0], 0xE7, SIM_NRF24L01_ADDR_MAX); 
+    memset(radio->addr[1], 0xC2, SIM_NRF24L01_ADDR_MAX); 
+    memset(radio->addr[2], 0xE7, SIM_NRF24L01_ADDR_MAX); 
+    radio->irq = 0xFFU; 
+    radio->rng = 1U; 
+
+    radio->device.cs_port = SIM_NRF24L01_CS_PORT; 
+    radio->device.cs_pin = SIM_NRF24L01_CS_PIN; 
+    radio->device.transfer = sim_nrf24l01_transfer; 
+    radio->device.select = sim_nrf24l01_select; 
+    radio->device.context = radio; 
+    sim_spi_attach(SIM_NRF24L01_SPI, &radio->device); 
+    sim_gpio_listen(sim_nrf24l01_ce_listener, radio); 
+    sim_schedule(0, sim_nrf24l01_power_on, radio); 
+}
+
+//=======================================================================================
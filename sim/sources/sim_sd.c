@@ -0,0 +1,755 @@
+/**
+ * @file sim_sd.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief SD card model - FatFs disk over an image file 
+ * 
+ * @details The host build uses this in place of the library's user_diskio.c (see 
+ *          CMakeLists.txt) so FatFs reads and writes the sectors of a FAT image file 
+ *          (--sd-image) instead of a card on the HW125's SPI bus. Everything above the 
+ *          disk layer (FatFs, the HW125 tests, sd_log) runs unchanged. With no image 
+ *          the card reads as not inserted. 
+ * 
+ *          Each disk call takes simulated time like the card would on SPI, with 
+ *          interrupts running in the meantime: 
+ *            - a fixed overhead per command (command, response and access delay) 
+ *            - the data at the HW125 test's SPI clock (42 MHz / 8), 515 bytes a sector 
+ *              (start token, data and CRC) 
+ *            - the busy time after each write command 
+ *            - an erase block penalty when a write goes to an erase block other than 
+ *              the last SIM_SD_OPEN_BLOCKS written to (or the one after them). Cards 
+ *              keep only a few erase blocks open at once, so scattered writes (ex. a 
+ *              FAT sector and then file data) cost much more than sequential ones. 
+ *          The timings are set on the command line. Reads and writes can also be made 
+ *          to fail at random (--sd-fail) to test the error handling above. 
+ * 
+ *          The same card also answers in SPI mode on SPI2 (CS PB12) for drivers that talk 
+ *          to it directly (sd_spi.c): the init sequence (CMD0, CMD8, an ACMD41 that 
+ *          finishes after the init time, CMD58 for a block addressed card), CMD9 (a 
+ *          version 2 CSD with the image's size), single and multi-block reads and writes 
+ *          (CMD17/18, CMD24/25, CMD12, stop token) and ACMD23. Data moves at whatever SPI 
+ *          clock the firmware sets. A read's data token comes after the command overhead 
+ *          and the card holds MISO low while busy after a write: the busy time after a 
+ *          single block write or a multi-block stop token, a short program time after 
+ *          each block of a multi-block write, plus the erase block penalty. CRCs aren't 
+ *          checked. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#define _GNU_SOURCE 
+
+#include "sim_model.h" 
+#include "ff_gen_drv.h" 
+
+#include <fcntl.h> 
+#include <unistd.h> 
+#include <sys/stat.h> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SIM_SD_SECTOR 512U                                // Sector size (bytes) 
+#define SIM_SD_SECTOR_BYTES 515U                          // Token + sector + CRC on SPI 
+#define SIM_SD_SPI_HZ 5250000ULL                          // SPI clock (42 MHz / 8) 
+#define SIM_SD_INIT_NS (100ULL * SIM_NS_PER_MS)           // Card initialization 
+#define SIM_SD_OPEN_BLOCKS 2U                             // Erase blocks open at once 
+#define SIM_SD_FAIL_SCALE 1000000U                        // Failure probability scale 
+
+// SPI mode 
+#define SIM_SD_SPI SPI2 
+#define SIM_SD_CS_PORT GPIOB 
+#define SIM_SD_CS_PIN 12U 
+#define SIM_SD_BLOCK_NS (20ULL * SIM_NS_PER_US)           // Program time per multi-block block 
+#define SIM_SD_CMD_LEN 6U                                 // Command frame bytes 
+#define SIM_SD_CMD_START 0x40U                            // Command start and transmission bits 
+#define SIM_SD_CMD_MASK 0xC0U 
+#define SIM_SD_CMD_INDEX 0x3FU 
+#define SIM_SD_IDLE 0xFFU                                 // MISO while not driving data 
+#define SIM_SD_BUSY 0x00U                                 // MISO while busy 
+#define SIM_SD_R1_IDLE 0x01U 
+#define SIM_SD_R1_ILLEGAL 0x04U 
+#define SIM_SD_R1_PARAM 0x40U 
+#define SIM_SD_TOKEN_START 0xFEU                          // Read data and single block write 
+#define SIM_SD_TOKEN_MULTI 0xFCU                          // Multi-block write data 
+#define SIM_SD_TOKEN_STOP 0xFDU                           // Multi-block write stop 
+#define SIM_SD_TOKEN_ERROR 0x01U                          // Read error token 
+#define SIM_SD_DATA_ACCEPTED 0x05U                        // Data response - accepted 
+#define SIM_SD_DATA_REJECTED 0x0DU                        // Data response - write error 
+#define SIM_SD_CRC_LEN 2U 
+#define SIM_SD_CSD_LEN 16U 
+#define SIM_SD_OUT_MAX (SIM_SD_SECTOR + 8U)               // MISO queue (token, block, CRC) 
+
+// Defaults 
+#define SIM_SD_CMD_NS (100ULL * SIM_NS_PER_US)            // Overhead per command 
+#define SIM_SD_BUSY_NS (500ULL * SIM_NS_PER_US)           // Busy after a write command 
+#define SIM_SD_ERASE_NS (3ULL * SIM_NS_PER_MS)            // Erase block change 
+#define SIM_SD_ERASE_SECTORS 128U                         // Erase block size (64 KB) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+// SPI mode state 
+typedef enum {
+    SIM_SD_MODE_CMD,                   // Waiting for a command 
+    SIM_SD_MODE_READ,                  // Sending data blocks 
+    SIM_SD_MODE_WRITE                  // Receiving data blocks 
+} sim_sd_mode_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Card state 
+typedef struct sim_sd_s
+{
+    int fd;                            // Image file (-1 for no card) 
+    DWORD sectors;                     // Sectors in the image 
+    DSTATUS status;                    // Disk status 
+
+    // Timing 
+    uint64_t cmd_ns;                   // Overhead per command 
+    uint64_t busy_ns;                  // Busy after a write command 
+    uint64_t erase_ns;                 // Erase block change 
+    uint32_t erase_sectors;            // Erase block size (sectors) 
+    DWORD open[SIM_SD_OPEN_BLOCKS];    // Erase blocks last written (most recent first) 
+
+    // Failures 
+    uint32_t fail;                     // Failure probability per SIM_SD_FAIL_SCALE 
+    uint64_t rng;                      // Random state (xorshift64) 
+
+    sim_sd_stats_t stats; 
+
+    // SPI mode 
+    sim_spi_device_t device; 
+    sim_sd_mode_t mode; 
+    uint8_t idle;                      // In the idle state (ACMD41 not finished) 
+    uint8_t init_started;              // ACMD41 seen since CMD0 
+    uint64_t init_done_ns;             // Time ACMD41 finishes 
+    uint8_t app;                       // Next command is an application command 
+    uint8_t cmd[SIM_SD_CMD_LEN];       // Command being received 
+    uint8_t cmd_len; 
+    uint8_t multi;                     // Multi-block read or write 
+    DWORD sector;                      // Next sector to read or write 
+    uint64_t token_ns;                 // Time the first read data token is ready 
+    uint64_t busy_until_ns;            // MISO held low until 
+    uint8_t out[SIM_SD_OUT_MAX];       // Bytes queued for MISO 
+    uint16_t out_len, out_pos; 
+    uint8_t receiving;                 // Write data token seen 
+    uint8_t block[SIM_SD_SECTOR + SIM_SD_CRC_LEN];   // Write data being received 
+    uint16_t block_len; 
+}
+sim_sd_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Globals 
+
+static sim_sd_t sim_sd =
+{
+    .fd = -1, 
+    .status = STA_NOINIT | STA_NODISK, 
+    .cmd_ns = SIM_SD_CMD_NS, 
+    .busy_ns = SIM_SD_BUSY_NS, 
+    .erase_ns = SIM_SD_ERASE_NS, 
+    .erase_sectors = SIM_SD_ERASE_SECTORS, 
+    .rng = 1U, 
+    .idle = 1U
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helpers 
+
+// Time to move sectors over SPI 
+static uint64_t sim_sd_transfer_ns(UINT count)
+{
+    return sim_cycles_to_ns((uint64_t)count * SIM_SD_SECTOR_BYTES * 8U, SIM_SD_SPI_HZ); 
+}
+
+
+// Check if a command fails 
+static uint8_t sim_sd_failed(sim_sd_t *card)
+{
+    if (card->fail == 0)
+    {
+        return 0; 
+    }
+
+    card->rng ^= card->rng << 13; 
+    card->rng ^= card->rng >> 7; 
+    card->rng ^= card->rng << 17; 
+
+    if ((card->rng % SIM_SD_FAIL_SCALE) < card->fail)
+    {
+        card->stats.failures++; 
+        return 1; 
+    }
+
+    return 0; 
+}
+
+
+// Erase block penalty of a write 
+static uint64_t sim_sd_erase_ns(sim_sd_t *card, DWORD sector, UINT count)
+{
+    DWORD first = sector / card->erase_sectors; 
+    DWORD last = (sector + count - 1U) / card->erase_sectors; 
+    uint8_t open = SIM_SD_OPEN_BLOCKS - 1U; 
+    uint64_t ns = 0; 
+
+    // Carrying on in an open block or into the block after it is free 
+    for (uint8_t i = 0; i < SIM_SD_OPEN_BLOCKS; i++)
+    {
+        if ((first == card->open[i]) || (first == (card->open[i] + 1U)))
+        {
+            open = i; 
+            break; 
+        }
+    }
+
+    if ((first != card->open[open]) && (first != (card->open[open] + 1U)))
+    {
+        ns = card->erase_ns; 
+        card->stats.erase_changes++; 
+    }
+
+    // The block written to becomes the most recent 
+    memmove(&card->open[1], &card->open[0], open * sizeof(card->open[0])); 
+    card->open[0] = last; 
+
+    return ns; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Disk functions 
+
+static DSTATUS sim_sd_initialize(BYTE pdrv)
+{
+    if (sim_sd.fd >= 0)
+    {
+        sim_advance_ns(SIM_SD_INIT_NS); 
+        sim_sd.status &= (DSTATUS)~STA_NOINIT; 
+    }
+
+    return sim_sd.status; 
+}
+
+
+static DSTATUS sim_sd_status(BYTE pdrv)
+{
+    return sim_sd.status; 
+}
+
+
+static DRESULT sim_sd_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+    size_t len = (size_t)count * SIM_SD_SECTOR; 
+
+    if (sim_sd.status & STA_NOINIT)
+    {
+        return RES_NOTRDY; 
+    }
+
+    if ((count == 0) || ((sector + count) > sim_sd.sectors) || (sector + count < sector))
+    {
+        return RES_PARERR; 
+    }
+
+    sim_advance_ns(sim_sd.cmd_ns + sim_sd_transfer_ns(count)); 
+    sim_sd.stats.reads++; 
+    sim_sd.stats.sectors_read += count; 
+
+    if (sim_sd_failed(&sim_sd) ||
+        (pread(sim_sd.fd, buff, len, (off_t)sector * SIM_SD_SECTOR) != (ssize_t)len))
+    {
+        return RES_ERROR; 
+    }
+
+    return RES_OK; 
+}
+
+
+#if _USE_WRITE == 1
+
+static DRESULT sim_sd_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+{
+    size_t len = (size_t)count * SIM_SD_SECTOR; 
+    uint64_t busy_ns; 
+
+    if (sim_sd.status & STA_NOINIT)
+    {
+        return RES_NOTRDY; 
+    }
+
+    if ((count == 0) || ((sector + count) > sim_sd.sectors) || (sector + count < sector))
+    {
+        return RES_PARERR; 
+    }
+
+    // A failed write leaves the sectors as they were 
+    busy_ns = sim_sd.busy_ns + sim_sd_erase_ns(&sim_sd, sector, count); 
+    sim_advance_ns(sim_sd.cmd_ns + sim_sd_transfer_ns(count) + busy_ns); 
+    sim_sd.stats.writes++; 
+    sim_sd.stats.sectors_written += count; 
+    sim_sd.stats.busy_ns += busy_ns; 
+
+    if (sim_sd_failed(&sim_sd) ||
+        (pwrite(sim_sd.fd, buff, len, (off_t)sector * SIM_SD_SECTOR) != (ssize_t)len))
+    {
+        return RES_ERROR; 
+    }
+
+    return RES_OK; 
+}
+
+#endif   // _USE_WRITE 
+
+
+#if _USE_IOCTL == 1
+
+static DRESULT sim_sd_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+{
+    if (sim_sd.status & STA_NOINIT)
+    {
+        return RES_NOTRDY; 
+    }
+
+    switch (cmd)
+    {
+        case CTRL_SYNC:
+            // Writes finish before the write call returns 
+            return RES_OK; 
+
+        case GET_SECTOR_COUNT:
+            *(DWORD *)buff = sim_sd.sectors; 
+            return RES_OK; 
+
+        case GET_SECTOR_SIZE:
+            *(WORD *)buff = SIM_SD_SECTOR; 
+            return RES_OK; 
+
+        case GET_BLOCK_SIZE:
+            *(DWORD *)buff = sim_sd.erase_sectors; 
+            return RES_OK; 
+
+        default:
+            return RES_PARERR; 
+    }
+}
+
+#endif   // _USE_IOCTL 
+
+
+// FatFs disk driver linked by MX_FATFS_Init (replaces the one in user_diskio.c) 
+Diskio_drvTypeDef USER_Driver =
+{
+    sim_sd_initialize, 
+    sim_sd_status, 
+    sim_sd_read, 
+#if _USE_WRITE == 1
+    sim_sd_write, 
+#endif   // _USE_WRITE 
+#if _USE_IOCTL == 1
+    sim_sd_ioctl, 
+#endif   // _USE_IOCTL 
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// SPI mode 
+
+// Queue a byte for MISO 
+static void sim_sd_spi_queue(sim_sd_t *card, uint8_t data)
+{
+    if (card->out_len < SIM_SD_OUT_MAX)
+    {
+        card->out[card->out_len++] = data; 
+    }
+}
+
+
+// Queue the next read data block 
+static void sim_sd_spi_read_block(sim_sd_t *card)
+{
+    card->out_len = 0; 
+    card->out_pos = 0; 
+
+    if ((card->sector >= card->sectors) || sim_sd_failed(card) || 
+        (pread(card->fd, &card->out[1], SIM_SD_SECTOR, (off_t)card->sector * SIM_SD_SECTOR) != 
+         (ssize_t)SIM_SD_SECTOR))
+    {
+        sim_sd_spi_queue(card, SIM_SD_TOKEN_ERROR); 
+        card->mode = SIM_SD_MODE_CMD; 
+        return; 
+    }
+
+    card->out[0] = SIM_SD_TOKEN_START; 
+    card->out_len = 1U + SIM_SD_SECTOR; 
+    sim_sd_spi_queue(card, SIM_SD_IDLE); 
+    sim_sd_spi_queue(card, SIM_SD_IDLE); 
+    card->stats.sectors_read++; 
+    card->sector++; 
+
+    // Multi-block reads carry on with the next block until CMD12 
+    if (!card->multi)
+    {
+        card->mode = SIM_SD_MODE_CMD; 
+    }
+}
+
+
+// Write data byte 
+static void sim_sd_spi_write_byte(sim_sd_t *card, uint8_t data, uint64_t now_ns)
+{
+    uint64_t busy_ns; 
+    uint8_t ok; 
+
+    if (!card->receiving)
+    {
+        if (data == (card->multi ? SIM_SD_TOKEN_MULTI : SIM_SD_TOKEN_START))
+        {
+            card->receiving = 1; 
+            card->block_len = 0; 
+        }
+        else if (card->multi && (data == SIM_SD_TOKEN_STOP))
+        {
+            card->mode = SIM_SD_MODE_CMD; 
+            card->busy_until_ns = now_ns + card->busy_ns; 
+            card->stats.busy_ns += card->busy_ns; 
+        }
+        return; 
+    }
+
+    card->block[card->block_len++] = data; 
+
+    if (card->block_len < sizeof(card->block))
+    {
+        return; 
+    }
+
+    // A failed write leaves the sector as it was 
+    card->receiving = 0; 
+    ok = (card->sector < card->sectors) && !sim_sd_failed(card) && 
+         (pwrite(card->fd, card->block, SIM_SD_SECTOR, (off_t)card->sector * SIM_SD_SECTOR) == 
+          (ssize_t)SIM_SD_SECTOR); 
+
+    card->out_len = 0; 
+    card->out_pos = 0; 
+    sim_sd_spi_queue(card, ok ? SIM_SD_DATA_ACCEPTED : SIM_SD_DATA_REJECTED); 
+
+    busy_ns = card->multi ? SIM_SD_BLOCK_NS : card->busy_ns; 
+    busy_ns += ok ? sim_sd_erase_ns(card, card->sector, 1U) : 0U; 
+    card->busy_until_ns = now_ns + busy_ns; 
+    card->stats.busy_ns += busy_ns; 
+    card->stats.sectors_written += ok; 
+    card->sector++; 
+
+    if (!card->multi)
+    {
+        card->mode = SIM_SD_MODE_CMD; 
+    }
+}
+
+
+// Command received 
+static void sim_sd_spi_command(sim_sd_t *card, uint64_t now_ns)
+{
+    // Version 2 CSD - the size goes in C_SIZE (bytes 7-9) 
+    static const uint8_t csd[SIM_SD_CSD_LEN] =
+    {
+        0x40U, 0x0EU, 0x00U, 0x32U, 0x5BU, 0x59U, 0x00U, 0x00U, 
+        0x00U, 0x00U, 0x7FU, 0x80U, 0x0AU, 0x40U, 0x00U, 0x01U
+    }; 
+    uint8_t index = card->cmd[0] & SIM_SD_CMD_INDEX; 
+    uint32_t arg = ((uint32_t)card->cmd[1] << 24) | ((uint32_t)card->cmd[2] << 16) | 
+                   ((uint32_t)card->cmd[3] << 8) | card->cmd[4]; 
+    uint8_t app = card->app; 
+    uint32_t c_size = (card->sectors >> 10) ? ((card->sectors >> 10) - 1U) : 0U; 
+    uint8_t r1; 
+
+    card->app = 0; 
+    card->out_len = 0; 
+    card->out_pos = 0; 
+
+    if (index == 0U)
+    {
+        card->idle = 1; 
+        card->init_started = 0; 
+        card->mode = SIM_SD_MODE_CMD; 
+    }
+    else if (app && (index == 41U))
+    {
+        // Initialization takes time from the first ACMD41 
+        if (!card->init_started)
+        {
+            card->init_started = 1; 
+            card->init_done_ns = now_ns + SIM_SD_INIT_NS; 
+        }
+
+        card->idle = (now_ns < card->init_done_ns) ? 1U : 0U; 
+    }
+    else if (index == 55U)
+    {
+        card->app = 1; 
+    }
+
+    r1 = card->idle ? SIM_SD_R1_IDLE : 0U; 
+
+    // One byte passes before the response 
+    sim_sd_spi_queue(card, SIM_SD_IDLE); 
+
+    switch (index)
+    {
+        case 0U: 
+        case 16U: 
+        case 55U: 
+            sim_sd_spi_queue(card, r1); 
+            break; 
+
+        case 8U: 
+            // R7 - voltage accepted and the check pattern 
+            sim_sd_spi_queue(card, r1); 
+            sim_sd_spi_queue(card, 0x00U); 
+            sim_sd_spi_queue(card, 0x00U); 
+            sim_sd_spi_queue(card, (uint8_t)((arg >> 8) & 0x0FU)); 
+            sim_sd_spi_queue(card, (uint8_t)arg); 
+            break; 
+
+        case 58U: 
+            // R3 - powered up and block addressed 
+            sim_sd_spi_queue(card, r1); 
+            sim_sd_spi_queue(card, 0xC0U); 
+            sim_sd_spi_queue(card, 0xFFU); 
+            sim_sd_spi_queue(card, 0x80U); 
+            sim_sd_spi_queue(card, 0x00U); 
+            break; 
+
+        case 9U: 
+            sim_sd_spi_queue(card, r1); 
+            sim_sd_spi_queue(card, SIM_SD_IDLE); 
+            sim_sd_spi_queue(card, SIM_SD_TOKEN_START); 
+
+            for (uint8_t i = 0; i < SIM_SD_CSD_LEN; i++)
+            {
+                sim_sd_spi_queue(card, (i == 7U) ? (uint8_t)((c_size >> 16) & 0x3FU) : 
+                                       (i == 8U) ? (uint8_t)(c_size >> 8) : 
+                                       (i == 9U) ? (uint8_t)c_size : csd[i]); 
+            }
+
+            sim_sd_spi_queue(card, SIM_SD_IDLE); 
+            sim_sd_spi_queue(card, SIM_SD_IDLE); 
+            break; 
+
+        case 12U: 
+            card->mode = SIM_SD_MODE_CMD; 
+            sim_sd_spi_queue(card, r1); 
+            break; 
+
+        case 17U: 
+        case 18U: 
+        case 24U: 
+        case 25U: 
+            if (!r1 && (arg >= card->sectors))
+            {
+                r1 = SIM_SD_R1_PARAM; 
+            }
+            else if (!r1)
+            {
+                card->multi = ((index == 18U) || (index == 25U)) ? 1U : 0U; 
+                card->sector = arg; 
+                card->receiving = 0; 
+
+                if (index < 24U)
+                {
+                    card->mode = SIM_SD_MODE_READ; 
+                    card->token_ns = now_ns + card->cmd_ns; 
+                    card->stats.reads++; 
+                }
+                else
+                {
+                    card->mode = SIM_SD_MODE_WRITE; 
+                    card->stats.writes++; 
+                }
+            }
+
+            sim_sd_spi_queue(card, r1); 
+            break; 
+
+        case 23U: 
+        case 41U: 
+            sim_sd_spi_queue(card, app ? r1 : (uint8_t)(r1 | SIM_SD_R1_ILLEGAL)); 
+            break; 
+
+        default: 
+            sim_sd_spi_queue(card, (uint8_t)(r1 | SIM_SD_R1_ILLEGAL)); 
+            break; 
+    }
+}
+
+
+// Exchange one byte 
+static uint16_t sim_sd_spi_transfer(void *context, uint16_t mosi)
+{
+    sim_sd_t *card = (sim_sd_t *)context; 
+    uint8_t data = (uint8_t)mosi; 
+    uint64_t now = sim_time_ns(); 
+
+    // No card - nothing drives MISO 
+    if (card->fd < 0)
+    {
+        return SIM_SD_IDLE; 
+    }
+
+    if ((card->mode == SIM_SD_MODE_WRITE) && (card->out_pos >= card->out_len) && 
+        (now >= card->busy_until_ns))
+    {
+        sim_sd_spi_write_byte(card, data, now); 
+        return SIM_SD_IDLE; 
+    }
+
+    // Commands can arrive while a read is sending data (CMD12) 
+    if ((card->mode != SIM_SD_MODE_WRITE) && 
+        ((card->cmd_len != 0) || ((data & SIM_SD_CMD_MASK) == SIM_SD_CMD_START)))
+    {
+        card->cmd[card->cmd_len++] = data; 
+
+        if (card->cmd_len == SIM_SD_CMD_LEN)
+        {
+            card->cmd_len = 0; 
+            sim_sd_spi_command(card, now); 
+        }
+
+        return SIM_SD_IDLE; 
+    }
+
+    if (card->out_pos < card->out_len)
+    {
+        return card->out[card->out_pos++]; 
+    }
+
+    if (now < card->busy_until_ns)
+    {
+        return SIM_SD_BUSY; 
+    }
+
+    if ((card->mode == SIM_SD_MODE_READ) && (now >= card->token_ns))
+    {
+        sim_sd_spi_read_block(card); 
+        return card->out[card->out_pos++]; 
+    }
+
+    return SIM_SD_IDLE; 
+}
+
+
+// Deselecting drops a partly received command and anything left to send 
+static void sim_sd_spi_select(void *context, uint8_t selected)
+{
+    sim_sd_t *card = (sim_sd_t *)context; 
+
+    if (!selected)
+    {
+        card->cmd_len = 0; 
+        card->out_len = 0; 
+        card->out_pos = 0; 
+    }
+}
+
+
+SIM_MODEL_INIT static void sim_sd_init(void)
+{
+    sim_sd.device.cs_port = SIM_SD_CS_PORT; 
+    sim_sd.device.cs_pin = SIM_SD_CS_PIN; 
+    sim_sd.device.transfer = sim_sd_spi_transfer; 
+    sim_sd.device.select = sim_sd_spi_select; 
+    sim_sd.device.context = &sim_sd; 
+    sim_spi_attach(SIM_SD_SPI, &sim_sd.device); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Control 
+
+// Insert a card backed by an image file 
+uint8_t sim_sd_image(const char *path)
+{
+    struct stat info; 
+    int fd = open(path, O_RDWR); 
+
+    if ((fd < 0) || (fstat(fd, &info) != 0) || (info.st_size < (off_t)SIM_SD_SECTOR))
+    {
+        if (fd >= 0)
+        {
+            close(fd); 
+        }
+        return 0; 
+    }
+
+    if (sim_sd.fd >= 0)
+    {
+        close(sim_sd.fd); 
+    }
+
+    sim_sd.fd = fd; 
+    sim_sd.sectors = (DWORD)(info.st_size / SIM_SD_SECTOR); 
+    sim_sd.status = STA_NOINIT; 
+
+    return 1; 
+}
+
+
+// Set the card's timing 
+void sim_sd_timing(uint64_t cmd_ns, uint64_t busy_ns, uint64_t erase_ns, uint32_t erase_sectors)
+{
+    sim_sd.cmd_ns = cmd_ns; 
+    sim_sd.busy_ns = busy_ns; 
+    sim_sd.erase_ns = erase_ns; 
+    sim_sd.erase_sectors = (erase_sectors != 0) ? erase_sectors : 1U; 
+}
+
+
+// Make reads and writes fail at random 
+void sim_sd_fail(double percent, uint64_t seed)
+{
+    double fail = (percent < 0.0) ? 0.0 : (percent > 100.0) ? 100.0 : percent; 
+
+    sim_sd.fail = (uint32_t)((fail * (double)SIM_SD_FAIL_SCALE) / 100.0); 
+    sim_sd.rng = (seed != 0) ? seed : 1U; 
+}
+
+
+// Card statistics 
+void sim_sd_stats(sim_sd_stats_t *stats)
+{
+    *stats = sim_sd.stats; 
+}
+
+//=======================================================================================
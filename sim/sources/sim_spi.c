@@ -0,0 +1,393 @@
+/**
+ * @file sim_spi.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief SPI models (master mode) 
+ * 
+ * @details A frame written to DR is exchanged with the attached device whose chip select 
+ *          pin is driven low at that moment. The received frame appears in DR once the 
+ *          frame time set by the baud rate prescaler has passed. The transmit buffer and 
+ *          shift register are modelled so TXE, RXNE and BSY behave like the hardware for 
+ *          both polled and DMA transfers. I2S mode is not modelled. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sim_model.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SIM_SPI_NUM 5U 
+#define SIM_SPI_IDLE_FRAME 0xFFFFU     // MISO pulled high when no device answers 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// SPI state 
+typedef struct sim_spi_s
+{
+    SPI_TypeDef *spi;                  // Bus address 
+    IRQn_Type irqn;                    // Interrupt 
+    uint32_t pclk_hz;                  // Peripheral clock 
+    sim_spi_device_t *devices;         // Attached devices 
+    uint8_t shifting;                  // Frame in the shift register 
+    uint8_t tx_pending;                // Frame waiting in the transmit buffer 
+    uint16_t tx_data;                  // Transmit buffer 
+    uint16_t rx_shift;                 // Frame being received 
+    uint16_t rx_data;                  // Receive buffer 
+    uint8_t dr_read;                   // DR read since the last overrun (OVR clear sequence) 
+    uint64_t done_ns;                  // End of the frame being shifted 
+}
+sim_spi_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Globals 
+
+static sim_spi_t sim_spis[SIM_SPI_NUM] =
+{
+    { SPI1, SPI1_IRQn, SIM_PCLK2_HZ, NULL, 0, 0, 0, 0, 0, 0, 0 }, 
+    { SPI2, SPI2_IRQn, SIM_PCLK1_HZ, NULL, 0, 0, 0, 0, 0, 0, 0 }, 
+    { SPI3, SPI3_IRQn, SIM_PCLK1_HZ, NULL, 0, 0, 0, 0, 0, 0, 0 }, 
+    { SPI4, SPI4_IRQn, SIM_PCLK2_HZ, NULL, 0, 0, 0, 0, 0, 0, 0 }, 
+    { SPI5, SPI5_IRQn, SIM_PCLK2_HZ, NULL, 0, 0, 0, 0, 0, 0, 0 }
+}; 
+
+static sim_model_t sim_spi_models[SIM_SPI_NUM]; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helpers 
+
+// Check if a device's chip select is active 
+static uint8_t sim_spi_selected(const sim_spi_device_t *device)
+{
+    return (device->cs_port == NULL) || !sim_gpio_output(device->cs_port, device->cs_pin); 
+}
+
+
+// Duration of one frame 
+static uint64_t sim_spi_frame_ns(sim_spi_t *state, SPI_TypeDef *spi)
+{
+    uint32_t bits = (spi->CR1 & SPI_CR1_DFF) ? 16U : 8U; 
+    uint32_t divider = 2UL << ((spi->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos); 
+
+    return sim_cycles_to_ns((uint64_t)bits * divider, state->pclk_hz); 
+}
+
+
+// Load a frame into the shift register and exchange it with the selected device 
+static void sim_spi_shift(sim_spi_t *state, SPI_TypeDef *spi, uint16_t data, uint64_t now_ns)
+{
+    uint16_t mask = (spi->CR1 & SPI_CR1_DFF) ? 0xFFFFU : 0x00FFU; 
+
+    state->rx_shift = SIM_SPI_IDLE_FRAME & mask; 
+
+    for (sim_spi_device_t *device = state->devices; device != NULL; device = device->next)
+    {
+        if (sim_spi_selected(device))
+        {
+            state->rx_shift = device->transfer(device->context, data & mask) & mask; 
+            break; 
+        }
+    }
+
+    state->shifting = 1; 
+    state->done_ns = now_ns + sim_spi_frame_ns(state, spi); 
+}
+
+
+// Frame written to the transmit buffer 
+static void sim_spi_transmit(sim_spi_t *state, SPI_TypeDef *spi, uint16_t data, uint64_t now_ns)
+{
+    if (!state->shifting)
+    {
+        sim_spi_shift(state, spi, data, now_ns); 
+    }
+    else
+    {
+        state->tx_pending = 1; 
+        state->tx_data = data; 
+    }
+}
+
+
+// Update the status register from the model state 
+static void sim_spi_status(sim_spi_t *state, SPI_TypeDef *spi)
+{
+    uint32_t sr = spi->SR & ~(SPI_SR_TXE | SPI_SR_BSY); 
+
+    if (!state->tx_pending)
+    {
+        sr |= SPI_SR_TXE; 
+    }
+
+    if (state->shifting || state->tx_pending)
+    {
+        sr |= SPI_SR_BSY; 
+    }
+
+    spi->SR = sr; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Model 
+
+static void sim_spi_advance(sim_model_t *model, uint64_t now_ns)
+{
+    sim_spi_t *state = (sim_spi_t *)model->instance; 
+    SPI_TypeDef *spi = SIM_ALIAS(state->spi); 
+    uint32_t dr_addr = (uint32_t)(uintptr_t)&state->spi->DR; 
+
+    while (1)
+    {
+        // Transmit DMA keeps the buffer full 
+        if ((spi->CR2 & SPI_CR2_TXDMAEN) && (spi->CR1 & SPI_CR1_SPE) && !state->tx_pending)
+        {
+            uint32_t data; 
+
+            if (sim_dma_m2p(dr_addr, &data))
+            {
+                sim_spi_transmit(state, spi, (uint16_t)data, now_ns); 
+                continue; 
+            }
+        }
+
+        if (!state->shifting || (state->done_ns > now_ns))
+        {
+            break; 
+        }
+
+        // Frame received 
+        uint64_t done = state->done_ns; 
+        state->shifting = 0; 
+
+        if ((spi->CR2 & SPI_CR2_RXDMAEN) && sim_dma_p2m(dr_addr, state->rx_shift))
+        {
+            state->rx_data = state->rx_shift; 
+        }
+        else
+        {
+            if (spi->SR & SPI_SR_RXNE)
+            {
+                spi->SR |= SPI_SR_OVR; 
+                state->dr_read = 0; 
+            }
+            else
+            {
+                state->rx_data = state->rx_shift; 
+                spi->SR |= SPI_SR_RXNE; 
+            }
+        }
+
+        if (state->tx_pending)
+        {
+            state->tx_pending = 0; 
+            sim_spi_shift(state, spi, state->tx_data, done); 
+        }
+    }
+
+    spi->DR = state->rx_data; 
+    sim_spi_status(state, spi); 
+}
+
+
+static uint64_t sim_spi_next_event(sim_model_t *model, uint64_t now_ns)
+{
+    sim_spi_t *state = (sim_spi_t *)model->instance; 
+    (void)now_ns; 
+
+    return state->shifting ? state->done_ns : SIM_NEVER; 
+}
+
+
+static uint64_t sim_spi_poll_limit(sim_model_t *model, uint32_t offset)
+{
+    sim_spi_t *state = (sim_spi_t *)model->instance; 
+    uint64_t now = sim_time_ns(); 
+    (void)offset; 
+
+    return (state->shifting && (state->done_ns > now)) ? (state->done_ns - now) : 0; 
+}
+
+
+static void sim_spi_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    sim_spi_t *state = (sim_spi_t *)model->instance; 
+    SPI_TypeDef *spi = SIM_ALIAS(state->spi); 
+
+    switch (offset)
+    {
+        case offsetof(SPI_TypeDef, DR):
+            if ((spi->CR1 & SPI_CR1_SPE) && !state->tx_pending)
+            {
+                sim_spi_transmit(state, spi, (uint16_t)value, sim_time_ns()); 
+            }
+            spi->DR = state->rx_data; 
+            sim_spi_status(state, spi); 
+            break; 
+
+        case offsetof(SPI_TypeDef, SR):
+            // Only CRCERR is writable (rc_w0) 
+            spi->SR = old_value & (value | ~SPI_SR_CRCERR); 
+            break; 
+
+        case offsetof(SPI_TypeDef, CR1):
+            if (!(value & SPI_CR1_SPE))
+            {
+                state->shifting = 0; 
+                state->tx_pending = 0; 
+                sim_spi_status(state, spi); 
+            }
+            break; 
+
+        default:
+            break; 
+    }
+}
+
+
+static void sim_spi_read_done(sim_model_t *model, uint32_t offset)
+{
+    sim_spi_t *state = (sim_spi_t *)model->instance; 
+    SPI_TypeDef *spi = SIM_ALIAS(state->spi); 
+
+    if (offset == offsetof(SPI_TypeDef, DR))
+    {
+        spi->SR &= ~SPI_SR_RXNE; 
+        state->dr_read = 1; 
+    }
+    else if ((offset == offsetof(SPI_TypeDef, SR)) && state->dr_read)
+    {
+        // DR read followed by SR read clears an overrun 
+        spi->SR &= ~SPI_SR_OVR; 
+    }
+}
+
+
+static void sim_spi_update_irq(sim_model_t *model)
+{
+    sim_spi_t *state = (sim_spi_t *)model->instance; 
+    SPI_TypeDef *spi = SIM_ALIAS(state->spi); 
+    uint32_t sr = spi->SR; 
+    uint32_t cr2 = spi->CR2; 
+
+    sim_nvic_level(model, state->irqn, 
+                   ((sr & SPI_SR_TXE) && (cr2 & SPI_CR2_TXEIE)) ||
+                   ((sr & SPI_SR_RXNE) && (cr2 & SPI_CR2_RXNEIE)) ||
+                   ((sr & SPI_SR_OVR) && (cr2 & SPI_CR2_ERRIE))); 
+}
+
+
+static void sim_spi_reset(sim_model_t *model)
+{
+    sim_spi_t *state = (sim_spi_t *)model->instance; 
+    SPI_TypeDef *spi = SIM_ALIAS(state->spi); 
+
+    state->shifting = 0; 
+    state->tx_pending = 0; 
+    state->rx_data = 0; 
+    spi->SR = SPI_SR_TXE; 
+    spi->CRCPR = 0x0007UL; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Devices 
+
+// Chip select edges 
+static void sim_spi_cs_listener(void *context, GPIO_TypeDef *gpio, uint8_t pin, uint8_t level)
+{
+    (void)context; 
+
+    for (uint8_t i = 0; i < SIM_SPI_NUM; i++)
+    {
+        for (sim_spi_device_t *device = sim_spis[i].devices; device != NULL; device = device->next)
+        {
+            if ((device->cs_port == gpio) && (device->cs_pin == pin) && (device->select != NULL))
+            {
+                device->select(device->context, !level); 
+            }
+        }
+    }
+}
+
+
+// Attach a device to a bus 
+void sim_spi_attach(SPI_TypeDef *spi, sim_spi_device_t *device)
+{
+    static uint8_t listening; 
+
+    for (uint8_t i = 0; i < SIM_SPI_NUM; i++)
+    {
+        if (sim_spis[i].spi == spi)
+        {
+            device->next = sim_spis[i].devices; 
+            sim_spis[i].devices = device; 
+
+            if (!listening)
+            {
+                listening = 1; 
+                sim_gpio_listen(sim_spi_cs_listener, NULL); 
+            }
+            return; 
+        }
+    }
+
+    sim_log("unknown SPI %p", (void *)spi); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Registration 
+
+SIM_MODEL_INIT static void sim_spi_init(void)
+{
+    static const char *const names[SIM_SPI_NUM] = { "SPI1", "SPI2", "SPI3", "SPI4", "SPI5" }; 
+
+    for (uint8_t i = 0; i < SIM_SPI_NUM; i++)
+    {
+        sim_model_t *model = &sim_spi_models[i]; 
+
+        model->name = names[i]; 
+        model->base = (uint32_t)(uintptr_t)sim_spis[i].spi; 
+        model->size = 0x400U; 
+        model->instance = &sim_spis[i]; 
+        model->reset = sim_spi_reset; 
+        model->read_done = sim_spi_read_done; 
+        model->write = sim_spi_write; 
+        model->advance = sim_spi_advance; 
+        model->next_event = sim_spi_next_event; 
+        model->poll_limit = sim_spi_poll_limit; 
+        model->update_irq = sim_spi_update_irq; 
+        sim_model_register(model); 
+    }
+}
+
+//=======================================================================================
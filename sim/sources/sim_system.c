@@ -0,0 +1,181 @@
+/**
+ * @file sim_system.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief RCC, PWR and FLASH interface models 
+ * 
+ * @details Oscillators and the PLL lock as soon as they are enabled and the system clock 
+ *          switch completes immediately so the HAL clock configuration in main.c runs 
+ *          without waiting. The simulated clock tree itself is fixed at the frequencies 
+ *          in sim.h. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sim_model.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// RCC 
+
+static void sim_rcc_reset(sim_model_t *model)
+{
+    RCC_TypeDef *rcc = SIM_ALIAS(RCC); 
+    (void)model; 
+
+    rcc->CR = 0x00000083UL;            // HSI on and ready 
+    rcc->PLLCFGR = 0x24003010UL; 
+    rcc->PLLI2SCFGR = 0x24003000UL; 
+    rcc->CSR = 0x0E000000UL; 
+}
+
+
+static void sim_rcc_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    RCC_TypeDef *rcc = SIM_ALIAS(RCC); 
+    (void)model; 
+    (void)old_value; 
+
+    switch (offset)
+    {
+        case offsetof(RCC_TypeDef, CR):
+            // Ready flags follow the enable bits 
+            value &= ~(RCC_CR_HSIRDY | RCC_CR_HSERDY | RCC_CR_PLLRDY | RCC_CR_PLLI2SRDY); 
+            if (value & RCC_CR_HSION) { value |= RCC_CR_HSIRDY; }
+            if (value & RCC_CR_HSEON) { value |= RCC_CR_HSERDY; }
+            if (value & RCC_CR_PLLON) { value |= RCC_CR_PLLRDY; }
+            if (value & RCC_CR_PLLI2SON) { value |= RCC_CR_PLLI2SRDY; }
+            rcc->CR = value; 
+            break; 
+
+        case offsetof(RCC_TypeDef, CFGR):
+            // Clock switch status follows the switch 
+            rcc->CFGR = (value & ~RCC_CFGR_SWS) | ((value & RCC_CFGR_SW) << RCC_CFGR_SWS_Pos); 
+            break; 
+
+        case offsetof(RCC_TypeDef, BDCR):
+            value &= ~RCC_BDCR_LSERDY; 
+            if (value & RCC_BDCR_LSEON) { value |= RCC_BDCR_LSERDY; }
+            rcc->BDCR = value; 
+            break; 
+
+        case offsetof(RCC_TypeDef, CSR):
+            value &= ~RCC_CSR_LSIRDY; 
+            if (value & RCC_CSR_LSION) { value |= RCC_CSR_LSIRDY; }
+            if (value & RCC_CSR_RMVF) { value &= ~(RCC_CSR_RMVF | 0xFE000000UL); }
+            rcc->CSR = value; 
+            break; 
+
+        default:
+            break; 
+    }
+}
+
+
+static sim_model_t sim_rcc_model =
+{
+    .name = "RCC", 
+    .base = RCC_BASE, 
+    .size = 0x400U, 
+    .reset = sim_rcc_reset, 
+    .write = sim_rcc_write
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// PWR 
+
+static void sim_pwr_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    PWR_TypeDef *pwr = SIM_ALIAS(PWR); 
+    (void)model; 
+    (void)old_value; 
+    (void)value; 
+
+    // Regulator voltage scaling is always ready 
+    if (offset == offsetof(PWR_TypeDef, CR))
+    {
+        pwr->CSR |= PWR_CSR_VOSRDY; 
+    }
+}
+
+
+static void sim_pwr_reset(sim_model_t *model)
+{
+    (void)model; 
+    SIM_ALIAS(PWR)->CR = 0x0000C000UL; 
+    SIM_ALIAS(PWR)->CSR = PWR_CSR_VOSRDY; 
+}
+
+
+static sim_model_t sim_pwr_model =
+{
+    .name = "PWR", 
+    .base = PWR_BASE, 
+    .size = 0x400U, 
+    .reset = sim_pwr_reset, 
+    .write = sim_pwr_write
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// FLASH interface 
+
+static void sim_flash_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    FLASH_TypeDef *flash = SIM_ALIAS(FLASH); 
+    (void)model; 
+
+    // Status flags are write 1 to clear 
+    if (offset == offsetof(FLASH_TypeDef, SR))
+    {
+        flash->SR = old_value & ~value; 
+    }
+}
+
+
+static void sim_flash_reset(sim_model_t *model)
+{
+    (void)model; 
+    SIM_ALIAS(FLASH)->CR = FLASH_CR_LOCK; 
+    SIM_ALIAS(FLASH)->OPTCR = 0x0FFFAAEDUL; 
+}
+
+
+static sim_model_t sim_flash_model =
+{
+    .name = "FLASH", 
+    .base = FLASH_R_BASE, 
+    .size = 0x400U, 
+    .reset = sim_flash_reset, 
+    .write = sim_flash_write
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Registration 
+
+SIM_MODEL_INIT static void sim_system_init(void)
+{
+    sim_model_register(&sim_rcc_model); 
+    sim_model_register(&sim_pwr_model); 
+    sim_model_register(&sim_flash_model); 
+}
+
+//=======================================================================================
@@ -0,0 +1,366 @@
+/**
+ * @file sim_tim.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief General purpose and advanced timer models 
+ * 
+ * @details Up counting time base with prescaler, auto reload, update and compare flags, 
+ *          the update generation bit and the update trigger output (TRGO with MMS = 
+ *          update) used to start ADC conversions. All timers are clocked at 
+ *          SIM_TIMCLK_HZ. Down/center counting, capture and PWM outputs are not modelled 
+ *          but CCRx values can be read back through the alias for checks. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sim_model.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SIM_TIM_NUM 8U 
+#define SIM_TIM_SR_MASK 0x1E5FUL       // Implemented status flags 
+#define SIM_TIM_MMS_UPDATE (2UL << TIM_CR2_MMS_Pos) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Timer state 
+typedef struct sim_tim_s
+{
+    TIM_TypeDef *tim;                  // Timer bus address 
+    uint8_t width32;                   // 32-bit counter (TIM2 and TIM5) 
+    IRQn_Type irq_up;                  // Update interrupt 
+    IRQn_Type irq_cc;                  // Capture/compare interrupt 
+    IRQn_Type irq_trg;                 // Trigger interrupt 
+    IRQn_Type irq_brk;                 // Break interrupt 
+    uint64_t last_cycles;              // Timer clock cycles at the last update 
+    uint32_t prescale;                 // Prescaler counter 
+}
+sim_tim_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Globals 
+
+static sim_tim_t sim_tims[SIM_TIM_NUM] =
+{
+    { TIM1,  0, TIM1_UP_TIM10_IRQn, TIM1_CC_IRQn, TIM1_TRG_COM_TIM11_IRQn, TIM1_BRK_TIM9_IRQn, 0, 0 }, 
+    { TIM2,  1, TIM2_IRQn, TIM2_IRQn, TIM2_IRQn, TIM2_IRQn, 0, 0 }, 
+    { TIM3,  0, TIM3_IRQn, TIM3_IRQn, TIM3_IRQn, TIM3_IRQn, 0, 0 }, 
+    { TIM4,  0, TIM4_IRQn, TIM4_IRQn, TIM4_IRQn, TIM4_IRQn, 0, 0 }, 
+    { TIM5,  1, TIM5_IRQn, TIM5_IRQn, TIM5_IRQn, TIM5_IRQn, 0, 0 }, 
+    { TIM9,  0, TIM1_BRK_TIM9_IRQn, TIM1_BRK_TIM9_IRQn, TIM1_BRK_TIM9_IRQn, TIM1_BRK_TIM9_IRQn, 0, 0 }, 
+    { TIM10, 0, TIM1_UP_TIM10_IRQn, TIM1_UP_TIM10_IRQn, TIM1_UP_TIM10_IRQn, TIM1_UP_TIM10_IRQn, 0, 0 }, 
+    { TIM11, 0, TIM1_TRG_COM_TIM11_IRQn, TIM1_TRG_COM_TIM11_IRQn, TIM1_TRG_COM_TIM11_IRQn, TIM1_TRG_COM_TIM11_IRQn, 0, 0 }
+}; 
+
+static sim_model_t sim_tim_models[SIM_TIM_NUM]; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Model 
+
+// Update event - flag and trigger output 
+static void sim_tim_update_event(sim_tim_t *state, TIM_TypeDef *tim)
+{
+    tim->SR |= TIM_SR_UIF; 
+
+    if ((tim->CR2 & TIM_CR2_MMS) == SIM_TIM_MMS_UPDATE)
+    {
+        sim_adc_timer_trigger(state->tim); 
+    }
+}
+
+
+// Count timer clock cycles since the last update 
+static void sim_tim_advance(sim_model_t *model, uint64_t now_ns)
+{
+    sim_tim_t *state = (sim_tim_t *)model->instance; 
+    TIM_TypeDef *tim = SIM_ALIAS(state->tim); 
+    uint64_t cycles = sim_ns_to_cycles(now_ns, SIM_TIMCLK_HZ); 
+    uint64_t elapsed = cycles - state->last_cycles; 
+
+    state->last_cycles = cycles; 
+
+    if (!(tim->CR1 & TIM_CR1_CEN) || (elapsed == 0))
+    {
+        return; 
+    }
+
+    // Prescaler 
+    uint64_t psc = (uint64_t)(tim->PSC & 0xFFFFUL) + 1U; 
+    uint64_t ticks = (state->prescale + elapsed) / psc; 
+    state->prescale = (uint32_t)((state->prescale + elapsed) % psc); 
+
+    if (ticks == 0)
+    {
+        return; 
+    }
+
+    // Counter 
+    uint64_t mask = state->width32 ? 0xFFFFFFFFULL : 0xFFFFULL; 
+    uint64_t arr = tim->ARR & mask; 
+    uint64_t period = arr + 1U; 
+    uint64_t cnt = tim->CNT & mask; 
+    uint64_t end = cnt + ticks; 
+
+    if (arr == 0)
+    {
+        // Counter is blocked with a zero auto reload value 
+        return; 
+    }
+
+    // Compare matches passed on the way (output compare channels only) 
+    volatile uint32_t *ccr = &tim->CCR1; 
+    uint32_t ccmr = tim->CCMR1 | ((uint32_t)tim->CCMR2 << 16); 
+
+    for (uint8_t ch = 0; ch < 4U; ch++)
+    {
+        uint32_t selection = (ccmr >> (ch * 8U)) & TIM_CCMR1_CC1S; 
+        uint64_t compare = ccr[ch] & mask; 
+
+        if (selection != 0)
+        {
+            continue; 
+        }
+
+        if ((ticks >= period) ||
+            ((compare > cnt) && (compare <= end)) ||
+            ((end > arr) && (compare <= (end - period))))
+        {
+            tim->SR |= (TIM_SR_CC1IF << ch); 
+        }
+    }
+
+    if (cnt > arr)
+    {
+        // Counter above the reload value counts up to the top before wrapping 
+        uint64_t to_top = mask - cnt + 1U; 
+
+        if (ticks < to_top)
+        {
+            tim->CNT = (uint32_t)(cnt + ticks); 
+            return; 
+        }
+
+        ticks -= to_top; 
+        cnt = 0; 
+        end = ticks; 
+        sim_tim_update_event(state, tim); 
+    }
+
+    if (end > arr)
+    {
+        sim_tim_update_event(state, tim); 
+    }
+
+    tim->CNT = (uint32_t)(end % period); 
+}
+
+
+// Time of the next update or compare match 
+static uint64_t sim_tim_event_time(sim_tim_t *state, uint8_t update)
+{
+    TIM_TypeDef *tim = SIM_ALIAS(state->tim); 
+    uint64_t mask = state->width32 ? 0xFFFFFFFFULL : 0xFFFFULL; 
+    uint64_t arr = tim->ARR & mask; 
+    uint64_t cnt = tim->CNT & mask; 
+
+    if (!(tim->CR1 & TIM_CR1_CEN) || (arr == 0) || (cnt > arr))
+    {
+        return SIM_NEVER; 
+    }
+
+    uint64_t psc = (uint64_t)(tim->PSC & 0xFFFFUL) + 1U; 
+    uint64_t ticks = update ? (arr + 1U - cnt) : UINT64_MAX; 
+
+    // Compare events only matter when their interrupt or DMA request is enabled 
+    volatile uint32_t *ccr = &tim->CCR1; 
+
+    for (uint8_t ch = 0; ch < 4U; ch++)
+    {
+        uint64_t compare = ccr[ch] & mask; 
+
+        if ((tim->DIER & ((TIM_DIER_CC1IE | TIM_DIER_CC1DE) << ch)) && (compare > cnt) &&
+            (compare <= arr) && ((compare - cnt) < ticks))
+        {
+            ticks = compare - cnt; 
+        }
+    }
+
+    if (ticks == UINT64_MAX)
+    {
+        return SIM_NEVER; 
+    }
+
+    uint64_t cycles = (ticks * psc) - state->prescale; 
+    return sim_cycles_to_ns(state->last_cycles + cycles, SIM_TIMCLK_HZ); 
+}
+
+
+// Next event that something outside the timer reacts to (interrupt, DMA or TRGO) 
+static uint64_t sim_tim_next_event(sim_model_t *model, uint64_t now_ns)
+{
+    sim_tim_t *state = (sim_tim_t *)model->instance; 
+    TIM_TypeDef *tim = SIM_ALIAS(state->tim); 
+    uint8_t update = (tim->DIER & (TIM_DIER_UIE | TIM_DIER_UDE)) ||
+                     ((tim->CR2 & TIM_CR2_MMS) == SIM_TIM_MMS_UPDATE); 
+    (void)now_ns; 
+
+    return sim_tim_event_time(state, update); 
+}
+
+
+// Limit poll skipping so software polling of the timer keeps its resolution 
+static uint64_t sim_tim_poll_limit(sim_model_t *model, uint32_t offset)
+{
+    sim_tim_t *state = (sim_tim_t *)model->instance; 
+    TIM_TypeDef *tim = SIM_ALIAS(state->tim); 
+    uint64_t now = sim_time_ns(); 
+
+    if (offset == offsetof(TIM_TypeDef, CNT))
+    {
+        // A quarter of the counter period 
+        uint64_t psc = (uint64_t)(tim->PSC & 0xFFFFUL) + 1U; 
+        uint64_t period = (uint64_t)(tim->ARR + 1ULL) * psc; 
+        return sim_cycles_to_ns((period / 4U) + 1U, SIM_TIMCLK_HZ); 
+    }
+
+    if (offset == offsetof(TIM_TypeDef, SR))
+    {
+        // Exactly up to the next update flag 
+        uint64_t next = sim_tim_event_time(state, 1U); 
+        return ((next != SIM_NEVER) && (next > now)) ? (next - now) : 0; 
+    }
+
+    return 0; 
+}
+
+
+static void sim_tim_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    sim_tim_t *state = (sim_tim_t *)model->instance; 
+    TIM_TypeDef *tim = SIM_ALIAS(state->tim); 
+
+    switch (offset)
+    {
+        case offsetof(TIM_TypeDef, CR1):
+            if ((value & TIM_CR1_CEN) && !(old_value & TIM_CR1_CEN))
+            {
+                state->last_cycles = sim_ns_to_cycles(sim_time_ns(), SIM_TIMCLK_HZ); 
+            }
+            break; 
+
+        case offsetof(TIM_TypeDef, SR):
+            // Flags are cleared by writing 0 
+            tim->SR = old_value & (value | ~SIM_TIM_SR_MASK); 
+            break; 
+
+        case offsetof(TIM_TypeDef, EGR):
+            if (value & TIM_EGR_UG)
+            {
+                // Reinitialize the counter and the prescaler 
+                tim->CNT = 0; 
+                state->prescale = 0; 
+
+                if (!(tim->CR1 & TIM_CR1_URS))
+                {
+                    sim_tim_update_event(state, tim); 
+                }
+            }
+            tim->SR |= (value & (TIM_EGR_CC1G | TIM_EGR_CC2G | TIM_EGR_CC3G | TIM_EGR_CC4G |
+                                 TIM_EGR_TG | TIM_EGR_BG)); 
+            tim->EGR = 0; 
+            break; 
+
+        case offsetof(TIM_TypeDef, CNT):
+            if (!state->width32)
+            {
+                tim->CNT = value & 0xFFFFUL; 
+            }
+            break; 
+
+        default:
+            break; 
+    }
+}
+
+
+static void sim_tim_update_irq(sim_model_t *model)
+{
+    sim_tim_t *state = (sim_tim_t *)model->instance; 
+    TIM_TypeDef *tim = SIM_ALIAS(state->tim); 
+    uint32_t request = tim->SR & tim->DIER; 
+
+    if (state->tim == TIM1)
+    {
+        sim_nvic_level(model, state->irq_up, (request & TIM_SR_UIF) != 0); 
+        sim_nvic_level(model, state->irq_cc, (request & (TIM_SR_CC1IF | TIM_SR_CC2IF |
+                                                         TIM_SR_CC3IF | TIM_SR_CC4IF)) != 0); 
+        sim_nvic_level(model, state->irq_trg, (request & (TIM_SR_TIF | TIM_SR_COMIF)) != 0); 
+        sim_nvic_level(model, state->irq_brk, (request & TIM_SR_BIF) != 0); 
+    }
+    else
+    {
+        sim_nvic_level(model, state->irq_up, (request & 0x5FUL) != 0); 
+    }
+}
+
+
+static void sim_tim_reset(sim_model_t *model)
+{
+    sim_tim_t *state = (sim_tim_t *)model->instance; 
+    TIM_TypeDef *tim = SIM_ALIAS(state->tim); 
+
+    tim->ARR = state->width32 ? 0xFFFFFFFFUL : 0xFFFFUL; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Registration 
+
+SIM_MODEL_INIT static void sim_tim_init(void)
+{
+    static const char *const names[SIM_TIM_NUM] =
+        { "TIM1", "TIM2", "TIM3", "TIM4", "TIM5", "TIM9", "TIM10", "TIM11" }; 
+
+    for (uint8_t i = 0; i < SIM_TIM_NUM; i++)
+    {
+        sim_model_t *model = &sim_tim_models[i]; 
+
+        model->name = names[i]; 
+        model->base = (uint32_t)(uintptr_t)sim_tims[i].tim; 
+        model->size = 0x400U; 
+        model->instance = &sim_tims[i]; 
+        model->reset = sim_tim_reset; 
+        model->write = sim_tim_write; 
+        model->advance = sim_tim_advance; 
+        model->next_event = sim_tim_next_event; 
+        model->poll_limit = sim_tim_poll_limit; 
+        model->update_irq = sim_tim_update_irq; 
+        sim_model_register(model); 
+    }
+}
+
+//=======================================================================================
@@ -0,0 +1,470 @@
+/**
+ * @file sim_usart.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief USART models 
+ * 
+ * @details Frames take 10 bit times at the baud rate programmed in BRR. Transmit has 
+ *          the data register plus the shift register so TXE and TC behave like the 
+ *          hardware, and transmitter DMA requests are served whenever TXE is set. 
+ *          Received bytes come from sim_usart_rx (and the terminal/script support in 
+ *          sim_init.c). They go to DMA when receiver DMA is enabled, otherwise to DR with 
+ *          RXNE/ORE. IDLE is set one frame after the last byte of a burst. Flags that the 
+ *          hardware clears with an SR read followed by a DR read are handled the same way. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sim_model.h" 
+#include <stdlib.h> 
+#include <unistd.h> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SIM_USART_NUM 3U 
+#define SIM_USART_RX_SIZE 4096U 
+#define SIM_USART_FRAME_BITS 10U 
+#define SIM_USART_SR_ERRORS (USART_SR_PE | USART_SR_FE | USART_SR_NE | USART_SR_ORE) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// USART state 
+typedef struct sim_usart_s
+{
+    USART_TypeDef *usart;              // Bus address 
+    IRQn_Type irqn;                    // Interrupt 
+    uint32_t fck;                      // Kernel clock 
+
+    // Transmitter 
+    uint8_t tdr_full;                  // Data register holds a byte 
+    uint8_t tdr;                       // Data register byte 
+    uint64_t shift_done;               // Time the shift register empties (0 = idle) 
+    void (*sink)(void *context, uint8_t data); 
+    void *sink_context; 
+
+    // Receiver 
+    uint8_t rx[SIM_USART_RX_SIZE];     // Bytes waiting to arrive 
+    uint32_t rx_head; 
+    uint32_t rx_tail; 
+    uint64_t rx_next;                  // Time the next byte completes (0 = none) 
+    uint64_t idle_at;                  // Time the line is detected idle (0 = none) 
+    uint8_t rdr;                       // Last received byte 
+    uint8_t sr_read;                   // SR was read (first half of the clear sequence) 
+
+    // Statistics 
+    uint64_t tx_bytes; 
+    uint64_t rx_bytes; 
+    uint64_t rx_overruns; 
+}
+sim_usart_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Globals 
+
+static sim_usart_t sim_usarts[SIM_USART_NUM]; 
+static sim_model_t sim_usart_models[SIM_USART_NUM]; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Model 
+
+// Frame time in ns 
+static uint64_t sim_usart_frame_ns(sim_usart_t *state)
+{
+    USART_TypeDef *usart = SIM_ALIAS(state->usart); 
+    uint32_t brr = usart->BRR & 0xFFFFUL; 
+    uint64_t div; 
+
+    if (brr == 0)
+    {
+        return (SIM_USART_FRAME_BITS * SIM_NS_PER_S) / 115200U; 
+    }
+
+    // baud = fck / (8 * (2 - OVER8) * USARTDIV) which reduces to fck / div 
+    if (usart->CR1 & USART_CR1_OVER8)
+    {
+        div = ((uint64_t)(brr >> 4) << 3) | (brr & 0x7U); 
+    }
+    else
+    {
+        div = brr; 
+    }
+
+    return (SIM_USART_FRAME_BITS * SIM_NS_PER_S * div) / state->fck; 
+}
+
+
+// Default transmit sink - the virtual COM port goes to stdout 
+static void sim_usart_stdout(void *context, uint8_t data)
+{
+    (void)context; 
+    ssize_t written = write(STDOUT_FILENO, &data, 1); 
+    (void)written; 
+}
+
+
+// Move the data register to the shift register 
+static void sim_usart_tx_start(sim_usart_t *state, uint64_t now_ns)
+{
+    state->tdr_full = 0; 
+    state->shift_done = now_ns + sim_usart_frame_ns(state); 
+    state->tx_bytes++; 
+
+    if (state->sink != NULL)
+    {
+        state->sink(state->sink_context, state->tdr); 
+    }
+}
+
+
+// Receive one byte from the line 
+static void sim_usart_rx_byte(sim_usart_t *state, uint8_t data)
+{
+    USART_TypeDef *usart = SIM_ALIAS(state->usart); 
+
+    state->rx_bytes++; 
+
+    if ((usart->CR3 & USART_CR3_DMAR) &&
+        sim_dma_p2m((uint32_t)(uintptr_t)&state->usart->DR, data))
+    {
+        return; 
+    }
+
+    if (usart->SR & USART_SR_RXNE)
+    {
+        // The previous byte was not read - the new one is lost 
+        usart->SR |= USART_SR_ORE; 
+        state->rx_overruns++; 
+        return; 
+    }
+
+    state->rdr = data; 
+    usart->SR |= USART_SR_RXNE; 
+}
+
+
+static void sim_usart_advance(sim_model_t *model, uint64_t now_ns)
+{
+    sim_usart_t *state = (sim_usart_t *)model->instance; 
+    USART_TypeDef *usart = SIM_ALIAS(state->usart); 
+    uint8_t enabled = (usart->CR1 & USART_CR1_UE) != 0; 
+
+    // Transmitter 
+    while (state->shift_done && (state->shift_done <= now_ns))
+    {
+        uint64_t done = state->shift_done; 
+
+        state->shift_done = 0; 
+
+        if (state->tdr_full)
+        {
+            sim_usart_tx_start(state, done); 
+            usart->SR |= USART_SR_TXE; 
+        }
+        else
+        {
+            usart->SR |= USART_SR_TC; 
+        }
+    }
+
+    // Transmitter DMA requests while the data register is empty 
+    if (enabled && (usart->CR3 & USART_CR3_DMAT) && (usart->CR1 & USART_CR1_TE))
+    {
+        uint32_t data; 
+
+        while ((usart->SR & USART_SR_TXE) &&
+               sim_dma_m2p((uint32_t)(uintptr_t)&state->usart->DR, &data))
+        {
+            state->tdr = (uint8_t)data; 
+            usart->SR &= ~(USART_SR_TXE | USART_SR_TC); 
+
+            if (state->shift_done == 0)
+            {
+                sim_usart_tx_start(state, now_ns); 
+                usart->SR |= USART_SR_TXE; 
+            }
+            else
+            {
+                state->tdr_full = 1; 
+            }
+        }
+    }
+
+    // Receiver 
+    while (state->rx_next && (state->rx_next <= now_ns))
+    {
+        uint8_t data = state->rx[state->rx_tail]; 
+
+        state->rx_tail = (state->rx_tail + 1U) % SIM_USART_RX_SIZE; 
+
+        if (enabled && (usart->CR1 & USART_CR1_RE))
+        {
+            sim_usart_rx_byte(state, data); 
+        }
+
+        if (state->rx_tail != state->rx_head)
+        {
+            state->rx_next += sim_usart_frame_ns(state); 
+        }
+        else
+        {
+            state->idle_at = state->rx_next + sim_usart_frame_ns(state); 
+            state->rx_next = 0; 
+        }
+    }
+
+    if (state->idle_at && (state->idle_at <= now_ns))
+    {
+        state->idle_at = 0; 
+
+        if (enabled && (usart->CR1 & USART_CR1_RE))
+        {
+            usart->SR |= USART_SR_IDLE; 
+        }
+    }
+}
+
+
+static uint64_t sim_usart_next_event(sim_model_t *model, uint64_t now_ns)
+{
+    sim_usart_t *state = (sim_usart_t *)model->instance; 
+    uint64_t next = SIM_NEVER; 
+    (void)now_ns; 
+
+    if (state->shift_done && (state->shift_done < next)) { next = state->shift_done; }
+    if (state->rx_next && (state->rx_next < next)) { next = state->rx_next; }
+    if (state->idle_at && (state->idle_at < next)) { next = state->idle_at; }
+
+    return next; 
+}
+
+
+static void sim_usart_read(sim_model_t *model, uint32_t offset)
+{
+    sim_usart_t *state = (sim_usart_t *)model->instance; 
+
+    if (offset == offsetof(USART_TypeDef, DR))
+    {
+        SIM_ALIAS(state->usart)->DR = state->rdr; 
+    }
+}
+
+
+static void sim_usart_read_done(sim_model_t *model, uint32_t offset)
+{
+    sim_usart_t *state = (sim_usart_t *)model->instance; 
+    USART_TypeDef *usart = SIM_ALIAS(state->usart); 
+
+    if (offset == offsetof(USART_TypeDef, SR))
+    {
+        state->sr_read = 1; 
+    }
+    else if (offset == offsetof(USART_TypeDef, DR))
+    {
+        usart->SR &= ~USART_SR_RXNE; 
+
+        // SR read followed by DR read clears IDLE and the error flags 
+        if (state->sr_read)
+        {
+            usart->SR &= ~(USART_SR_IDLE | SIM_USART_SR_ERRORS); 
+        }
+        state->sr_read = 0; 
+    }
+}
+
+
+static void sim_usart_write(sim_model_t *model, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+    sim_usart_t *state = (sim_usart_t *)model->instance; 
+    USART_TypeDef *usart = SIM_ALIAS(state->usart); 
+
+    switch (offset)
+    {
+        case offsetof(USART_TypeDef, SR):
+            // Only RXNE and TC can be cleared by writing 0 
+            usart->SR = old_value & (value | ~(USART_SR_RXNE | USART_SR_TC | USART_SR_LBD |
+                                               USART_SR_CTS)); 
+            break; 
+
+        case offsetof(USART_TypeDef, DR):
+            state->sr_read = 0; 
+
+            if (!(usart->CR1 & USART_CR1_UE) || !(usart->CR1 & USART_CR1_TE))
+            {
+                break; 
+            }
+
+            state->tdr = (uint8_t)value; 
+            usart->SR &= ~(USART_SR_TXE | USART_SR_TC); 
+
+            if (state->shift_done == 0)
+            {
+                sim_usart_tx_start(state, sim_time_ns()); 
+                usart->SR |= USART_SR_TXE; 
+            }
+            else
+            {
+                state->tdr_full = 1; 
+            }
+            break; 
+
+        case offsetof(USART_TypeDef, CR1):
+            // Enabling the transmitter sends an idle frame 
+            if ((value & USART_CR1_TE) && !(old_value & USART_CR1_TE))
+            {
+                usart->SR |= USART_SR_TXE | USART_SR_TC; 
+            }
+            break; 
+
+        default:
+            break; 
+    }
+}
+
+
+static void sim_usart_update_irq(sim_model_t *model)
+{
+    sim_usart_t *state = (sim_usart_t *)model->instance; 
+    USART_TypeDef *usart = SIM_ALIAS(state->usart); 
+    uint32_t sr = usart->SR; 
+    uint32_t cr1 = usart->CR1; 
+    uint8_t request =
+        ((sr & USART_SR_TXE) && (cr1 & USART_CR1_TXEIE)) ||
+        ((sr & USART_SR_TC) && (cr1 & USART_CR1_TCIE)) ||
+        ((sr & (USART_SR_RXNE | USART_SR_ORE)) && (cr1 & USART_CR1_RXNEIE)) ||
+        ((sr & USART_SR_IDLE) && (cr1 & USART_CR1_IDLEIE)) ||
+        ((sr & USART_SR_PE) && (cr1 & USART_CR1_PEIE)); 
+
+    sim_nvic_level(model, state->irqn, request); 
+}
+
+
+static void sim_usart_reset(sim_model_t *model)
+{
+    sim_usart_t *state = (sim_usart_t *)model->instance; 
+
+    SIM_ALIAS(state->usart)->SR = USART_SR_TXE | USART_SR_TC; 
+}
+
+
+// Find the state of a USART 
+static sim_usart_t *sim_usart_find(USART_TypeDef *usart)
+{
+    for (uint8_t i = 0; i < SIM_USART_NUM; i++)
+    {
+        if (sim_usarts[i].usart == usart)
+        {
+            return &sim_usarts[i]; 
+        }
+    }
+
+    sim_log("unknown USART %p", (void *)usart); 
+    abort(); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Stimulus 
+
+// Queue bytes on the receive line 
+void sim_usart_rx(USART_TypeDef *usart, const uint8_t *data, uint32_t len)
+{
+    sim_usart_t *state = sim_usart_find(usart); 
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        uint32_t next = (state->rx_head + 1U) % SIM_USART_RX_SIZE; 
+
+        if (next == state->rx_tail)
+        {
+            sim_log("%s receive queue full", usart == USART1 ? "USART1" :
+                                             usart == USART2 ? "USART2" : "USART6"); 
+            break; 
+        }
+
+        state->rx[state->rx_head] = data[i]; 
+        state->rx_head = next; 
+    }
+
+    if ((state->rx_next == 0) && (state->rx_head != state->rx_tail))
+    {
+        state->rx_next = sim_time_ns() + sim_usart_frame_ns(state); 
+        state->idle_at = 0; 
+    }
+}
+
+
+// Route transmitted bytes 
+void sim_usart_tx_sink(
+    USART_TypeDef *usart, 
+    void (*sink)(void *context, uint8_t data), 
+    void *context)
+{
+    sim_usart_t *state = sim_usart_find(usart); 
+
+    state->sink = sink; 
+    state->sink_context = context; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Registration 
+
+SIM_MODEL_INIT static void sim_usart_init(void)
+{
+    static USART_TypeDef *const instances[SIM_USART_NUM] = { USART1, USART2, USART6 }; 
+    static const IRQn_Type irqs[SIM_USART_NUM] = { USART1_IRQn, USART2_IRQn, USART6_IRQn }; 
+    static const uint32_t clocks[SIM_USART_NUM] = { SIM_PCLK2_HZ, SIM_PCLK1_HZ, SIM_PCLK2_HZ }; 
+    static const char *const names[SIM_USART_NUM] = { "USART1", "USART2", "USART6" }; 
+
+    for (uint8_t i = 0; i < SIM_USART_NUM; i++)
+    {
+        sim_model_t *model = &sim_usart_models[i]; 
+
+        sim_usarts[i].usart = instances[i]; 
+        sim_usarts[i].irqn = irqs[i]; 
+        sim_usarts[i].fck = clocks[i]; 
+
+        model->name = names[i]; 
+        model->base = (uint32_t)(uintptr_t)instances[i]; 
+        model->size = 0x400U; 
+        model->instance = &sim_usarts[i]; 
+        model->reset = sim_usart_reset; 
+        model->read = sim_usart_read; 
+        model->read_done = sim_usart_read_done; 
+        model->write = sim_usart_write; 
+        model->advance = sim_usart_advance; 
+        model->next_event = sim_usart_next_event; 
+        model->update_irq = sim_usart_update_irq; 
+        sim_model_register(model); 
+    }
+
+    sim_usarts[1].sink = sim_usart_stdout; 
+}
+
+//=======================================================================================
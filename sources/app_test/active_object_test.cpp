@@ -1057,7 +1057,7 @@ void ThreadLowState1(
 // USART2 interrupt - overridden 
 void USART2_IRQHandler(void)
 {
-    handler_flags.usart2_flag = SET_BIT; 
+    event_set_from_isr(EVENT_USART2); 
 
 #if AO_CPP_TEST 
 
@@ -1446,7 +1446,7 @@ void SerialInEvent(
     uint8_t *circular_buff_index, 
     uint8_t *input_buff)
 {
-    handler_flags.usart2_flag = CLEAR; 
+    (void)event_take(EVENT_MASK(EVENT_USART2)); 
 
     // Get the user input from the circular buffer 
     cb_parse(
@@ -504,12 +504,10 @@ void manual_blink_init(void)
 
 void manual_blink_loop(void)
 {
-    // This interrupt flag will be set when an idle line is detected on UART RX after 
+    // This interrupt event will be set when an idle line is detected on UART RX after 
     // receiving new data. 
-    if (handler_flags.usart2_flag)
+    if (event_take(EVENT_MASK(EVENT_USART2)))
     {
-        handler_flags.usart2_flag = CLEAR; 
-
         // Get the user input and update the LED blink rate 
         cb_parse(uart_dma_buff, user_in_buff, &buff_index, SERIAL_INPUT_MAX_LEN); 
         mb_ticks = (uint32_t)strtol((char *)user_in_buff, NULL, 10); 
@@ -780,12 +778,10 @@ void memory_management_init(void)
 
 void memory_management_loop(void)
 {
-    // This interrupt flag will be set when an idle line is detected on UART RX after 
+    // This interrupt event will be set when an idle line is detected on UART RX after 
     // receiving new data. 
-    if (handler_flags.usart2_flag)
+    if (event_take(EVENT_MASK(EVENT_USART2)))
     {
-        handler_flags.usart2_flag = CLEAR; 
-
         uint8_t user_in_buff_local[SERIAL_INPUT_MAX_LEN]; 
         uint32_t input_len; 
         uint8_t mem_info[MM_STR_MAX_LEN]; 
@@ -930,12 +926,10 @@ void queue_loop(void)
 {
     static uint32_t blink_count = CLEAR; 
 
-    // This interrupt flag will be set when an idle line is detected on UART RX after 
+    // This interrupt event will be set when an idle line is detected on UART RX after 
     // receiving new data. 
-    if (handler_flags.usart2_flag)
+    if (event_take(EVENT_MASK(EVENT_USART2)))
     {
-        handler_flags.usart2_flag = CLEAR; 
-
         // Get the user input from the circular buffer 
         cb_parse(uart_dma_buff, user_in_buff, &buff_index, SERIAL_INPUT_MAX_LEN); 
         
@@ -1640,11 +1634,10 @@ void software_timer_1_init(void)
 
 void software_timer_1_loop(void)
 {
-    // This interrupt flag will be set when an idle line is detected on UART RX after 
+    // This interrupt event will be set when an idle line is detected on UART RX after 
     // receiving new data. 
-    if (handler_flags.usart2_flag)
+    if (event_take(EVENT_MASK(EVENT_USART2)))
     {
-        handler_flags.usart2_flag = CLEAR; 
         uart_sendstring(USART2, ">>> "); 
 
         // Restart the display timeout and turn the board LED on 
@@ -1818,12 +1811,10 @@ void hardware_interrupt_init(void)
 
 void hardware_interrupt_loop(void)
 {
-    // This interrupt flag will be set when an idle line is detected on UART RX after 
+    // This interrupt event will be set when an idle line is detected on UART RX after 
     // receiving new data. 
-    if (handler_flags.usart2_flag)
+    if (event_take(EVENT_MASK(EVENT_USART2)))
     {
-        handler_flags.usart2_flag = CLEAR; 
-
         // Get the user input from the circular buffer 
         cb_parse(uart_dma_buff, user_in_buff, &buff_index, SERIAL_INPUT_MAX_LEN); 
 
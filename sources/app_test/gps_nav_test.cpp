@@ -33,6 +33,11 @@
 #include "lsm303agr_config.h" 
 #include "gps_coordinates.h" 
 #include "includes_cpp_drivers.h" 
+#include "bench_test.h" 
+#include "uart_tx_queue.h" 
+#include "dlog.h" 
+#include "timer_wheel.h" 
+#include "sys_time.h" 
 
 //=======================================================================================
 
@@ -54,7 +59,6 @@
 #define GNSS_SAMPLE_COUNTER 10    // Number of intervals to elapse before checking the GPS 
 
 // Data output 
-#define OUTPUT_LENGTH 70          // Max data string output length 
 
 //=======================================================================================
 
@@ -78,9 +82,12 @@ private:   // Private variables
     int16_t compass_heading;           // Current compass heading 
     int16_t error_heading;             // Error between compass and coordinate heading 
 
+    // Sample times on the system clock (us) 
+    uint64_t fix_time;                 // Last GPS position fix 
+    uint64_t heading_time;             // Last magnetometer heading 
+
     // Timer information 
-    TIM_TypeDef *timer_nonblocking;    // Timer used for non-blocking delays 
-    tim_compare_t data_timer;          // Data sampling delay timing info 
+    twheel_timer_t data_timer;         // Data sampling timer (timer wheel) 
     uint8_t timer_counter;             // GPS data update counter/timer 
 
     // Status 
@@ -91,7 +98,6 @@ public:   // Setup and teardown
     
     // Constructor 
     gps_nav_test(
-        TIM_TypeDef *timer, 
         double coordinate_filter_gain, 
         int16_t tn_offset) 
         : waypoint_index(CLEAR), 
@@ -100,7 +106,9 @@ public:   // Setup and teardown
           coordinate_heading(CLEAR), 
           compass_heading(CLEAR), 
           error_heading(CLEAR), 
-          timer_nonblocking(timer), 
+          fix_time(CLEAR), 
+          heading_time(CLEAR), 
+          data_timer(), 
           timer_counter(CLEAR), 
           m8q_status(M8Q_OK), 
           lsm303agr_status(LSM303AGR_OK) 
@@ -132,14 +140,26 @@ public:   // Navigation
 
 
     /**
-     * @brief Configure the non-blocking timing information 
+     * @brief Start the non-blocking data sampling timer 
      * 
-     * @details The non-blocking timer frequency can only be read after the timer has been 
-     *          set up. That means this function must be called independently and setup 
-     *          can't be handled in the constructor. 
+     * @details The timer runs on the timer wheel which can only be used after the wheel's 
+     *          hardware timer has been set up. That means this function must be called 
+     *          independently and setup can't be handled in the constructor. 
      */
     void non_blocking_timer_config(void); 
 
+
+    /**
+     * @brief Update the heading error from a magnetometer heading 
+     * 
+     * @details Corrects the magnetometer heading to be the true north heading then finds 
+     *          the error between this heading and the desired/target heading. Split out 
+     *          of nav_heading so it can be benchmarked without the device. 
+     * 
+     * @param m_heading : magnetometer heading (degrees*10) 
+     */
+    void nav_heading_update(int16_t m_heading); 
+
 private:   // Private members 
     
     /**
@@ -176,7 +196,7 @@ private:   // Private members
 
 
 // GPS navigation instance 
-static gps_nav_test gps_nav(TIM9, COORDINATE_LPF_GAIN, TN_OFFSET); 
+static gps_nav_test gps_nav(COORDINATE_LPF_GAIN, TN_OFFSET); 
 
 //=======================================================================================
 
@@ -210,6 +230,10 @@ void gps_nav_test_init(void)
         TIM_UP_INT_DISABLE); 
     tim_enable(TIM9); 
 
+    // Non-blocking delays run on the timer wheel, which shares the system clock timer 
+    sys_time_init(TIM5, EXTI_PRIORITY_1); 
+    twheel_hw_init(); 
+
     // Initialize UART
     uart_init(
         USART2, 
@@ -221,6 +245,10 @@ void gps_nav_test_init(void)
         UART_DMA_DISABLE, 
         UART_DMA_DISABLE); 
 
+    // Navigation output is sent through the transmit queue so it doesn't hold up the 
+    // device reads. Output is dropped if the serial terminal falls behind. 
+    uart_txq_init(UART_TXQ_DROP, EXTI_PRIORITY_1); 
+
     // Initialize I2C
     i2c_init(
         I2C1, 
@@ -249,7 +277,7 @@ void gps_nav_test_init(void)
     // LSM303AGR magnetometer setup  
     gps_nav_test_lsm303agr_init(); 
 
-    // Configure the non-blocking timer 
+    // Start the non-blocking timer 
     gps_nav.non_blocking_timer_config(); 
 }
 
@@ -312,13 +340,10 @@ void gps_nav_test_lsm303agr_init(void)
 }
 
 
-// Configure the non-blocking timing information 
+// Start the non-blocking data sampling timer 
 void gps_nav_test::non_blocking_timer_config(void)
 {
-    data_timer.clk_freq = tim_get_pclk_freq(timer_nonblocking); 
-    data_timer.time_cnt_total = CLEAR; 
-    data_timer.time_cnt = CLEAR; 
-    data_timer.time_start = SET_BIT; 
+    twheel_start(&data_timer, SAMPLE_INTERVAL, SAMPLE_INTERVAL, NULL, NULL); 
 }
 
 //=======================================================================================
@@ -343,12 +368,7 @@ void gps_nav_test_app(void)
 void gps_nav_test::gps_navigation(void)
 {
     // Update the heading and GPS data at an interval 
-    if (tim_compare(timer_nonblocking, 
-                    data_timer.clk_freq, 
-                    SAMPLE_INTERVAL, 
-                    &data_timer.time_cnt_total, 
-                    &data_timer.time_cnt, 
-                    &data_timer.time_start))
+    if (twheel_take(&data_timer))
     {
         // Update the heading 
         nav_heading(); 
@@ -374,7 +394,15 @@ void gps_nav_test::nav_heading(void)
     // error between the current (compass) and desired (GPS) headings. Heading error 
     // is determined here and not with each location update so it's updated faster. 
     lsm303agr_status = lsm303agr_m_update(); 
-    compass_heading = true_north_heading(lsm303agr_m_get_heading()); 
+    heading_time = sys_time_us(); 
+    nav_heading_update(lsm303agr_m_get_heading()); 
+}
+
+
+// Update the heading error from a magnetometer heading 
+void gps_nav_test::nav_heading_update(int16_t m_heading)
+{
+    compass_heading = true_north_heading(m_heading); 
     error_heading = heading_error(compass_heading, coordinate_heading); 
 }
 
@@ -391,6 +419,7 @@ void gps_nav_test::nav_location(void)
         // the result. 
         device_coordinates.lat = m8q_get_position_lat(); 
         device_coordinates.lon = m8q_get_position_lon(); 
+        fix_time = sys_time_us(); 
         coordinate_filter(device_coordinates, current); 
 
         // Calculate the distance to the target location and the heading needed to get 
@@ -425,18 +454,16 @@ void gps_nav_test::nav_location(void)
 // Output the navigation results 
 void gps_nav_test::nav_info_output(void)
 {
-    char output_buff[OUTPUT_LENGTH]; 
-
-    // Format the navigation data into a string 
-    snprintf(
-        output_buff, 
-        OUTPUT_LENGTH, 
-        "NAVSTAT: %u\r\nRadius: %ld     \r\nHeading Error: %d     \r\n", 
-        navstat, radius, error_heading); 
-
-    // Overwrite the old navigation data 
-    uart_sendstring(USART2, "\033[1A\033[1A\033[1A"); 
-    uart_sendstring(USART2, output_buff); 
+    // Age of the last samples (ms) - both are timed on the same clock 
+    uint64_t now = sys_time_us(); 
+    uint32_t fix_age = (uint32_t)((now - fix_time) / 1000); 
+    uint32_t heading_age = (uint32_t)((now - heading_time) / 1000); 
+
+    // Overwrite the old navigation data - formatted by the host decoder 
+    DLOG("\033[1A\033[1A\033[1A\033[1A" 
+         "NAVSTAT: %u\r\nRadius: %ld     \r\nHeading Error: %d     \r\n" 
+         "Fix age: %lu ms  Heading age: %lu ms     \r\n", 
+         navstat, radius, error_heading, fix_age, heading_age); 
 }
 
 
@@ -445,6 +472,7 @@ void gps_nav_test::nav_status_check(void)
 {
     if ((m8q_get_state() == M8Q_FAULT_STATE) || lsm303agr_status)
     {
+        uart_txq_flush(); 
         uart_send_new_line(USART2); 
         uart_sendstring(USART2, "\r\nM8Q state: "); 
         uart_send_integer(USART2, (int16_t)m8q_get_state()); 
@@ -455,3 +483,20 @@ void gps_nav_test::nav_status_check(void)
 }
 
 //=======================================================================================
+
+
+//=======================================================================================
+// Benchmarks 
+
+// Heading calculations of nav_heading - sweeps the magnetometer heading 
+static void gps_nav_test_bench_heading(void)
+{
+    static int16_t m_heading = CLEAR; 
+
+    gps_nav.nav_heading_update(m_heading); 
+    m_heading = (int16_t)((m_heading + 37) % 3600); 
+}
+
+BENCH_REGISTER("nav_heading", gps_nav_test_bench_heading)
+
+//=======================================================================================
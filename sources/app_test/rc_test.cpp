@@ -18,6 +18,13 @@
 #include "rc_test.h" 
 #include "nrf24l01_config.h" 
 #include "stm32f4xx_it.h" 
+#include "uart_rx_pipe.h" 
+#include "timer_wheel.h" 
+#include "sys_time.h" 
+#include "rc_xact.h" 
+#include "nrf24l01_rx.h" 
+#include "rc_frame.h" 
+#include "nrf24l01_ack.h" 
 
 #include "nrf24l01_test.h" 
 #include "hw125_test.h" 
@@ -48,6 +55,7 @@
 
 // Configuration 
 #define NRF24L01_RF_FREQ 10           // Comm frequency: 2400 MHz + this value (MHz) 
+#define RC_LINK_MSG_LEN 160           // Link statistics message buffer size 
 
 //=======================================================================================
 
@@ -60,8 +68,7 @@ class rc_test_trackers
 {
 public: 
     // Timing information 
-    TIM_TypeDef *timer_nonblocking;                // Timer used for non-blocking delays 
-    tim_compare_t delay_timer;                     // Delay timing info 
+    twheel_timer_t delay_timer;                    // Periodic action timer (timer wheel) 
 
     // Configuration 
     nrf24l01_data_pipe_t pipe; 
@@ -69,6 +76,14 @@ public:
     // Payload data 
     uint8_t read_buff[NRF24L01_MAX_PAYLOAD_LEN];   // Data read by PRX from PTX device 
     uint8_t write_buff[NRF24L01_MAX_PAYLOAD_LEN];  // Data sent to PRX from PTX device 
+    nrf24l01_rx_payload_t rx_payload;              // Payload taken from the receive ring 
+
+    // Link statistics - sender side 
+    uint32_t sent;                                 // Payloads sent 
+    uint32_t acked;                                // Payloads acknowledged by the receiver 
+    uint32_t telem_count;                          // Telemetry frames received in ACKs 
+    uint32_t telem_bad;                            // ACK payloads that failed to decode 
+    rc_frame_telem_t telem;                        // Last telemetry received 
 }; 
 
 // Device tracker instance 
@@ -87,6 +102,19 @@ void rc_motor_test_loop(void);
 void rc_ground_station_test_init(void); 
 void rc_ground_station_test_loop(void); 
 
+#if RC_SYSTEM_1 && (RC_MOTOR_TEST || RC_GROUND_STATION_TEST) 
+
+// Send a payload and count whether the receiver acknowledged it 
+static NRF24L01_STATUS rc_test_send(const uint8_t *payload); 
+
+// Take telemetry out of a received payload - TRUE if it decoded 
+static uint8_t rc_test_telem_check(const nrf24l01_rx_payload_t *payload); 
+
+// Display link statistics 
+static void rc_test_link_display(void); 
+
+#endif 
+
 //=======================================================================================
 
 
@@ -180,12 +208,10 @@ void rc_test_init(void)
     //==================================================
     // Initialize test data 
 
-    // Timing 
-    rc_test.timer_nonblocking = TIM9; 
-    rc_test.delay_timer.clk_freq = tim_get_pclk_freq(rc_test.timer_nonblocking); 
-    rc_test.delay_timer.time_cnt_total = CLEAR; 
-    rc_test.delay_timer.time_cnt = CLEAR; 
-    rc_test.delay_timer.time_start = SET_BIT; 
+    // Timing - non-blocking delays run on the timer wheel, which shares the system 
+    // clock timer. Each test sets the period of the delay timer. 
+    sys_time_init(TIM5, EXTI_PRIORITY_1); 
+    twheel_hw_init(); 
 
     // Configuration 
     rc_test.pipe = NRF24L01_DP_1; 
@@ -194,6 +220,13 @@ void rc_test_init(void)
     memset((void *)rc_test.read_buff, CLEAR, sizeof(rc_test.read_buff)); 
     memset((void *)rc_test.write_buff, CLEAR, sizeof(rc_test.write_buff)); 
 
+    // Link statistics 
+    rc_test.sent = CLEAR; 
+    rc_test.acked = CLEAR; 
+    rc_test.telem_count = CLEAR; 
+    rc_test.telem_bad = CLEAR; 
+    memset((void *)&rc_test.telem, CLEAR, sizeof(rc_test.telem)); 
+
     //==================================================
 
     //==================================================
@@ -217,11 +250,15 @@ void rc_test_init(void)
     nrf24l01_init_status |= nrf24l01_ptx_config(nrf24l01_pipe_addr); 
     nrf24l01_init_status |= nrf24l01_prx_config(nrf24l01_pipe_addr, rc_test.pipe); 
 
+    // Dynamic payload length and ACK payloads so the receiving system can send 
+    // telemetry back in the ACK of each payload it receives 
+    uint8_t nrf24l01_ack_status = nrf24l01_ack_init(); 
+
     // Power up the device now that it is configured 
     nrf24l01_init_status |= nrf24l01_pwr_up(); 
 
     // Check init status 
-    if (nrf24l01_init_status)
+    if (nrf24l01_init_status || !nrf24l01_ack_status)
     {
         uart_sendstring(USART2, "nRF24L01 init failed."); 
         while(1); 
@@ -231,6 +268,10 @@ void rc_test_init(void)
         uart_sendstring(USART2, "nRF24L01 init success."); 
     }
 
+    // Payloads are read into a ring by the radio's IRQ pin interrupt so the tests take 
+    // them as they arrive instead of polling the radio over SPI 
+    nrf24l01_rx_init(EXTI_PRIORITY_2); 
+
     //==================================================
 
 #if RC_SD_CARD_TEST 
@@ -263,6 +304,79 @@ void rc_test_app(void)
 //=======================================================================================
 
 
+#if RC_SYSTEM_1 && (RC_MOTOR_TEST || RC_GROUND_STATION_TEST) 
+
+//=======================================================================================
+// Link telemetry 
+
+// Send a payload and count whether the receiver acknowledged it 
+static NRF24L01_STATUS rc_test_send(const uint8_t *payload)
+{
+    NRF24L01_STATUS status = nrf24l01_rx_send(payload); 
+
+    rc_test.sent++; 
+
+    if (status == NRF24L01_OK)
+    {
+        rc_test.acked++; 
+    }
+
+    return status; 
+}
+
+
+// Take telemetry out of a received payload. ACK payloads come in on their own pipe so 
+// they're kept apart from payloads the other system sends. Only telemetry that decodes 
+// counts as hearing from the remote system. 
+static uint8_t rc_test_telem_check(const nrf24l01_rx_payload_t *payload)
+{
+    if (payload->pipe != NRF24L01_ACK_PIPE)
+    {
+        return FALSE; 
+    }
+
+    if (rc_frame_telem_decode(payload->data, &rc_test.telem) != RC_FRAME_OK)
+    {
+        rc_test.telem_bad++; 
+        return FALSE; 
+    }
+
+    rc_test.telem_count++; 
+
+    return TRUE; 
+}
+
+
+// Display link statistics 
+static void rc_test_link_display(void)
+{
+    char msg[RC_LINK_MSG_LEN]; 
+    uint32_t acked_pct = rc_test.sent ? ((rc_test.acked * 100) / rc_test.sent) : 0; 
+
+    snprintf(
+        msg, 
+        sizeof(msg), 
+        "\rLink: %lu sent, %lu%% acked, %lu telem, %lu bad | remote: seq %u, link %u%%, "
+        "lost %u, %u mV, %u.%u deg\033[K", 
+        (unsigned long)rc_test.sent, 
+        (unsigned long)acked_pct, 
+        (unsigned long)rc_test.telem_count, 
+        (unsigned long)rc_test.telem_bad, 
+        rc_test.telem.seq, 
+        rc_test.telem.link, 
+        rc_test.telem.lost, 
+        rc_test.telem.battery, 
+        rc_test.telem.heading / 10, 
+        rc_test.telem.heading % 10); 
+
+    uart_sendstring(USART2, msg); 
+}
+
+//=======================================================================================
+
+#endif 
+
+
 #if RC_SD_CARD_TEST 
 
 //=======================================================================================
@@ -273,6 +387,9 @@ void rc_test_app(void)
 //   - Look for serial terminal input from a user. Valid inputs are "push" followed by 
 //     a string or "pop". 
 //   - If an inout matches a pre-defined command then execute the command callback. 
+//     Callbacks start radio transactions (rc_xact.h) and return straight away so the 
+//     main loop keeps running while a transaction is in flight. A request is sent 
+//     again if no response is seen in time and the result is shown when it's done. 
 //   - Callback 1: ("push") 
 //     - Send a push request to system 2. 
 //     - If a response is seen then send the string/message to system 2. 
@@ -290,9 +407,10 @@ void rc_test_app(void)
 //     the command callback is executed. 
 //   - Callback 1: ("push") 
 //     - Send a push confirmation message to system 1. 
-//     - Wait for a message from system 1. 
+//     - Wait (without blocking) for a message from system 1. 
 //     - If a message is received then save it to the SD card and send a confirmation 
-//       back to system 1. 
+//       back to system 1. Repeats of the request or the message (lost confirmations) 
+//       are confirmed again without saving the message twice. 
 //   - Callback 2: ("pop") 
 //     - Get the most recent message from the SD card file and send it back to system 
 //       1. Delete the message from the file. 
@@ -301,12 +419,11 @@ void rc_test_app(void)
 // Macros 
 
 // Timing 
-#define RC_SD_PERIOD 50000          // (us) 
-#define RC_SD_PUSH_MSG_TIMEOUT 20   // Counts 
-#define RC_SD_PUSH_MSG_DELAY 10     // (ms) 
+#define RC_SD_RESPONSE_TIMEOUT 200000   // Time to wait for each response (us) 
+#define RC_SD_ATTEMPTS 3                // Sends of a request before giving up 
 
-// Commands 
-#define RC_SD_NUM_CMDS 2 
+// Time system 2 waits for a pushed message, or for repeats of it, after a request 
+#define RC_SD_MSG_TIMEOUT (RC_SD_RESPONSE_TIMEOUT * RC_SD_ATTEMPTS) 
 
 //==================================================
 
@@ -324,6 +441,35 @@ void rc_test_pop_callback(
     uint8_t arg_value, 
     uint8_t *arg_str); 
 
+// Radio link used by the transaction engine 
+static uint8_t rc_test_link_send(const uint8_t *payload); 
+static uint8_t rc_test_link_receive(uint8_t *payload); 
+
+#if RC_SYSTEM_1 
+
+// Transaction done callbacks 
+static void rc_test_push_confirmed(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response); 
+
+static void rc_test_push_done(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response); 
+
+static void rc_test_pop_done(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response); 
+
+#elif RC_SYSTEM_2 
+
+// Payloads from system 1 
+static void rc_test_sd_receive(const uint8_t *payload); 
+
+#endif 
+
 //==================================================
 
 
@@ -331,34 +477,57 @@ void rc_test_pop_callback(
 // Variables 
 
 // Messages sent between system 
-static const char 
+static constexpr char 
 push_cmd[] = "push",   // Doubles as a user command 
 pop_cmd[] = "pop", 
 push_confirm[] = "push confirm", 
 msg_confirm[] = "msg confirm"; 
 
-// Command table 
-static const nrf24l01_cmds_t rc_cmd_table[RC_SD_NUM_CMDS] = 
+// Command registry - used for user input (system 1) and radio messages (system 2) 
+static constexpr auto rc_cmd_registry = cmd_registry_make({ push_cmd, pop_cmd }); 
+static constexpr cmd_registry_t rc_cmds = rc_cmd_registry.registry(); 
+
+// Command callbacks - positions match rc_cmds 
+static const nrf24l01_cmd_ptr_t rc_cmd_table[] = 
 {
-    {push_cmd, &rc_test_push_callback}, 
-    {pop_cmd,  &rc_test_pop_callback} 
+    &rc_test_push_callback, 
+    &rc_test_pop_callback 
 };
 
+// Radio transactions 
+static const rc_xact_link_t rc_link = { &rc_test_link_send, &rc_test_link_receive }; 
+static rc_xact_engine_t rc_xact_engine; 
+
 #if RC_SYSTEM_1 
 
 static const char 
-push_status[] = "Push requested... ", 
+push_status[] = "\rPush: ", 
 push_success[] = "message saved.", 
-pop_status[] = "Popped message: "; 
+pop_status[] = "\rPopped message: ", 
+no_response[] = "no response.", 
+busy_status[] = "Busy - try again.", 
+user_prompt[] = "\r\n\n>>> "; 
 
 // Command data 
 static nrf24l01_cmd_data_t rc_cmd_data; 
 
+// Transactions 
+static rc_xact_t push_xact;                        // "push" request 
+static rc_xact_t msg_xact;                         // Pushed message 
+static rc_xact_t pop_xact;                         // "pop" request 
+static uint8_t push_msg[RC_XACT_PAYLOAD_LEN];      // Message to push 
+static uint8_t push_msg_len;                       // Message length (with terminator) 
+
 #elif RC_SYSTEM_2 
 
 static const char 
 no_msgs[] = "No messages to pop."; 
 
+// Pushed messages 
+static twheel_timer_t msg_timer;                   // Message wait timeout 
+static uint8_t msg_wait;                           // Waiting for a pushed message 
+static uint8_t last_msg[RC_XACT_PAYLOAD_LEN];      // Last message saved 
+
 #endif 
 
 //==================================================
@@ -422,8 +591,11 @@ void rc_sd_card_test_init(void)
     memset((void *)rc_cmd_data.cmd_id, CLEAR, sizeof(rc_cmd_data.cmd_id)); 
     rc_cmd_data.cmd_value = CLEAR; 
 
+    // Responses are only looked for while a transaction is in flight 
+    rc_xact_init(&rc_xact_engine, &rc_link, NULL, RC_SD_RESPONSE_TIMEOUT, RC_SD_ATTEMPTS); 
+
     // Provide an initial prompt for the user 
-    uart_sendstring(USART2, "\r\n\n>>> "); 
+    uart_sendstring(USART2, user_prompt); 
 
 #elif RC_SYSTEM_2 
 
@@ -452,6 +624,16 @@ void rc_sd_card_test_init(void)
     // Close the file. Will be opened for each read/write operation. 
     
     //==================================================
+
+    // Payloads from system 1 go to rc_test_sd_receive 
+    rc_xact_init(
+        &rc_xact_engine, 
+        &rc_link, 
+        &rc_test_sd_receive, 
+        RC_SD_RESPONSE_TIMEOUT, 
+        RC_SD_ATTEMPTS); 
+    msg_wait = CLEAR; 
+    memset((void *)last_msg, CLEAR, sizeof(last_msg)); 
     
 #endif 
 }
@@ -467,37 +649,21 @@ void rc_sd_card_test_loop(void)
 #if RC_SYSTEM_1 
 
     // Check for user input and match inputs to commands 
-    nrf24l01_test_user_input(&rc_cmd_data, rc_cmd_table, RC_SD_NUM_CMDS, NRF24L01_CMD_ARG_STR); 
+    nrf24l01_test_user_input(&rc_cmd_data, &rc_cmds, rc_cmd_table, NRF24L01_CMD_ARG_STR); 
+
+    // Look for responses and time out requests 
+    rc_xact_poll(&rc_xact_engine); 
 
 #elif RC_SYSTEM_2 
 
-    // Periodically check for action items 
-    if (tim_compare(rc_test.timer_nonblocking, 
-                    rc_test.delay_timer.clk_freq, 
-                    RC_SD_PERIOD, 
-                    &rc_test.delay_timer.time_cnt_total, 
-                    &rc_test.delay_timer.time_cnt, 
-                    &rc_test.delay_timer.time_start))
-    {
-        // time_start flag does not need to be set again because this timer runs 
-        // continuously. 
+    // Check for messages from system 1 
+    rc_xact_poll(&rc_xact_engine); 
 
-        // Look for a message from system 1 
-        if (nrf24l01_data_ready_status() == rc_test.pipe)
-        {
-            nrf24l01_receive_payload(rc_test.read_buff); 
-            
-            // Compare the input to the available commands 
-            for (uint8_t i = CLEAR; i < RC_SD_NUM_CMDS; i++) 
-            {
-                if (!strcmp(rc_cmd_table[i].user_cmds, (char *)rc_test.read_buff))
-                {
-                    // ID matched to a command. Execute the command callback. 
-                    (rc_cmd_table[i].cmd_ptr)(CLEAR, NULL); 
-                    break; 
-                }
-            }
-        }
+    // Stop waiting for a pushed message or repeats of it 
+    if (twheel_take(&msg_timer))
+    {
+        msg_wait = CLEAR; 
+        memset((void *)last_msg, CLEAR, sizeof(last_msg)); 
     }
 
 #endif 
@@ -516,117 +682,192 @@ void rc_test_push_callback(
 {
 #if RC_SYSTEM_1 
 
-    // Send a "push" command to system 2 
-    nrf24l01_send_payload((uint8_t *)push_cmd); 
+    // One exchange with system 2 at a time 
+    if (rc_xact_engine_busy(&rc_xact_engine))
+    {
+        uart_sendstring(USART2, busy_status); 
+        return; 
+    }
 
-    // Provide user feedback 
-    uart_sendstring(USART2, push_status); 
+    // Keep the message until system 2 is ready for it - the user input buffer can 
+    // change before then 
+    push_msg_len = (uint8_t)strnlen((char *)arg_str, RC_XACT_PAYLOAD_LEN - 1); 
+    memcpy((void *)push_msg, (void *)arg_str, push_msg_len); 
+    push_msg[push_msg_len++] = NULL_CHAR; 
+
+    // Send a "push" request to system 2. The message is sent once it's confirmed. 
+    rc_xact_request(
+        &rc_xact_engine, 
+        &push_xact, 
+        push_cmd, 
+        sizeof(push_cmd), 
+        push_confirm, 
+        sizeof(push_confirm), 
+        &rc_test_push_confirmed, 
+        NULL); 
 
-    // Check repeatedly for a push confirmation message. If the confirmation is received 
-    // within the time limit then send the message to system 2. 
-    for (uint8_t i = CLEAR; i < RC_SD_PUSH_MSG_TIMEOUT; i++)
-    {
-        tim_delay_ms(rc_test.timer_nonblocking, RC_SD_PUSH_MSG_DELAY); 
+#elif RC_SYSTEM_2 
 
-        if (nrf24l01_data_ready_status() == rc_test.pipe)
-        {
-            nrf24l01_receive_payload(rc_test.read_buff); 
+    // Confirm the request and wait for the message. A repeated request (the 
+    // confirmation was lost) is confirmed again. 
+    nrf24l01_rx_send((const uint8_t *)push_confirm); 
+    msg_wait = SET; 
+    memset((void *)last_msg, CLEAR, sizeof(last_msg)); 
+    twheel_start(&msg_timer, RC_SD_MSG_TIMEOUT, CLEAR, NULL, NULL); 
 
-            if (!strcmp(push_confirm, (char *)rc_test.read_buff))
-            {
-                // Send the message to system 2 
-                // nrf24l01_send_payload(rc_cmd_data.cmd_str); 
-                nrf24l01_send_payload(arg_str); 
-
-                // Check repeatedly for a message received confirmation. If the 
-                // confirmation is received within the time limit then provide feedback 
-                // to the user that the operation was successful. 
-                for (uint8_t j = CLEAR; j < RC_SD_PUSH_MSG_TIMEOUT; j++)
-                {
-                    tim_delay_ms(rc_test.timer_nonblocking, RC_SD_PUSH_MSG_DELAY); 
-
-                    // Look for a message from system 2 
-                    if (nrf24l01_data_ready_status() == rc_test.pipe)
-                    {
-                        nrf24l01_receive_payload(rc_test.read_buff); 
-
-                        if (!strcmp(msg_confirm, (char *)rc_test.read_buff))
-                        {
-                            // Output a confirmation 
-                            uart_sendstring(USART2, push_success); 
-                            break; 
-                        }
-                    }
-                }
-
-                break; 
-            }
-        }
+#endif 
+}
+
+
+// "pop" callback 
+void rc_test_pop_callback(
+    uint8_t arg, 
+    uint8_t *arg_str)
+{
+#if RC_SYSTEM_1 
+
+    // One exchange with system 2 at a time 
+    if (rc_xact_engine_busy(&rc_xact_engine))
+    {
+        uart_sendstring(USART2, busy_status); 
+        return; 
     }
 
+    // Send a "pop" request to system 2 - any payload back is the popped message 
+    rc_xact_request(
+        &rc_xact_engine, 
+        &pop_xact, 
+        pop_cmd, 
+        sizeof(pop_cmd), 
+        NULL, 
+        CLEAR, 
+        &rc_test_pop_done, 
+        NULL); 
+
 #elif RC_SYSTEM_2 
 
-    // Send a confirmation to system 1 that a "push" command was received 
-    nrf24l01_send_payload((uint8_t *)push_confirm); 
+    // Get the most recent message from the test file on the SD card 
+    // If there are none left then send the indication back to system 1. 
 
-    // Check multiple times (with a delay) if a message arrives 
-    for (uint8_t i = CLEAR; i < RC_SD_PUSH_MSG_TIMEOUT; i++)
-    {
-        tim_delay_ms(rc_test.timer_nonblocking, RC_SD_PUSH_MSG_DELAY); 
+    // Send the message back to system 1 - temp message for now 
+    nrf24l01_rx_send((const uint8_t *)no_msgs); 
 
-        // Look for a message from system 1 
-        if (nrf24l01_data_ready_status() == rc_test.pipe)
-        {
-            nrf24l01_receive_payload(rc_test.read_buff); 
+#endif 
+}
 
-            // Save the contents to the end of the test file on the SD card 
 
-            // Send another confirmation to system 1 that the message was received 
-            nrf24l01_send_payload((uint8_t *)msg_confirm); 
+// Send a payload 
+static uint8_t rc_test_link_send(const uint8_t *payload)
+{
+    return nrf24l01_rx_send(payload) == NRF24L01_OK; 
+}
+
+
+// Take a payload from the receive ring if one has arrived 
+static uint8_t rc_test_link_receive(uint8_t *payload)
+{
+    while (nrf24l01_rx_read(&rc_test.rx_payload))
+    {
+        if (rc_test.rx_payload.pipe == rc_test.pipe)
+        {
+            memcpy((void *)payload, (void *)rc_test.rx_payload.data, RC_XACT_PAYLOAD_LEN); 
+            return TRUE; 
         }
     }
 
-#endif 
+    return FALSE; 
 }
 
 
-// "pop" callback 
-void rc_test_pop_callback(
-    uint8_t arg, 
-    uint8_t *arg_str)
-{
 #if RC_SYSTEM_1 
 
-    // Send a "pop" command to system 2 
-    nrf24l01_send_payload((uint8_t *)pop_cmd); 
+// "push" request confirmed - send the message 
+static void rc_test_push_confirmed(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response)
+{
+    if (result != RC_XACT_OK)
+    {
+        uart_sendstring(USART2, push_status); 
+        uart_sendstring(USART2, no_response); 
+        uart_sendstring(USART2, user_prompt); 
+        return; 
+    }
+
+    rc_xact_request(
+        &rc_xact_engine, 
+        &msg_xact, 
+        push_msg, 
+        push_msg_len, 
+        msg_confirm, 
+        sizeof(msg_confirm), 
+        &rc_test_push_done, 
+        NULL); 
+}
+
+
+// Pushed message confirmed 
+static void rc_test_push_done(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response)
+{
+    uart_sendstring(USART2, push_status); 
+    uart_sendstring(USART2, (result == RC_XACT_OK) ? push_success : no_response); 
+    uart_sendstring(USART2, user_prompt); 
+}
+
 
-    // Provide user feedback 
+// "pop" response 
+static void rc_test_pop_done(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response)
+{
     uart_sendstring(USART2, pop_status); 
+    uart_sendstring(USART2, (result == RC_XACT_OK) ? (char *)response : no_response); 
+    uart_sendstring(USART2, user_prompt); 
+}
 
-    // Check repeatedly for a message from system 2. If a message is received then 
-    // output it for the user to see. 
-    for (uint8_t i = CLEAR; i < RC_SD_PUSH_MSG_TIMEOUT; i++)
+#elif RC_SYSTEM_2 
+
+// Payloads from system 1 
+static void rc_test_sd_receive(const uint8_t *payload)
+{
+    // Look up the input in the available commands 
+    uint8_t cmd_index = cmd_registry_find(&rc_cmds, (char *)payload); 
+
+    // The pushed message can be any text other than a command. A command ends the wait 
+    // (ex. system 1 gave up on the push). 
+    if (msg_wait && (cmd_index == CMD_REGISTRY_NONE))
     {
-        tim_delay_ms(rc_test.timer_nonblocking, RC_SD_PUSH_MSG_DELAY); 
+        msg_wait = CLEAR; 
 
-        if (nrf24l01_data_ready_status() == rc_test.pipe)
-        {
-            nrf24l01_receive_payload(rc_test.read_buff); 
-            uart_sendstring(USART2, (char *)rc_test.read_buff); 
-            break; 
-        }
-    }
+        // Save the contents to the end of the test file on the SD card 
+        memcpy((void *)last_msg, (void *)payload, sizeof(last_msg)); 
 
-#elif RC_SYSTEM_2 
+        // Send another confirmation to system 1 that the message was received 
+        nrf24l01_rx_send((const uint8_t *)msg_confirm); 
+        return; 
+    }
 
-    // Get the most recent message from the test file on the SD card 
-    // If there are none left then send the indication back to system 1. 
+    // The message was sent again because its confirmation was lost 
+    if (last_msg[0] && !memcmp((void *)last_msg, (void *)payload, sizeof(last_msg)))
+    {
+        nrf24l01_rx_send((const uint8_t *)msg_confirm); 
+        return; 
+    }
 
-    // Send the message back to system 1 - temp message for now 
-    nrf24l01_send_payload((uint8_t *)no_msgs); 
+    if (cmd_index != CMD_REGISTRY_NONE)
+    {
+        // ID matched to a command. Execute the command callback. 
+        msg_wait = CLEAR; 
+        (rc_cmd_table[cmd_index])(CLEAR, NULL); 
+    }
+}
 
 #endif 
-}
 
 //==================================================
 
@@ -640,34 +881,33 @@ void rc_test_pop_callback(
 
 // Description 
 // - System 1 reads two ADC values, one for each motor in system 2. The ADC values get 
-//   converted to a throttle command and a message gets sent to system 2 that indicates 
-//   the motor, direction and throttle to apply. 
-// - System 2 looks for messages from system 1 that contain commands for the throttle to 
-//   apply to each motor. The messages get decoded and the motor speed updated. If the 
-//   system loses radio connection (i.e. no message/command is received after a period 
-//   of time) then the motor speed is set to zero. 
+//   converted to throttle commands and both are sent to system 2 in one binary frame 
+//   (rc_frame.h) along with a sequence number. 
+// - System 2 takes frames from the radio receive ring as they arrive. A valid frame 
+//   updates the speed of both motors straight away. Gaps in the sequence numbers are 
+//   counted as lost frames. If the system loses radio connection (i.e. no valid frame 
+//   is received after a period of time) then the motor speed is set to zero. 
+// - System 2 answers each payload with telemetry in the radio's ACK (nrf24l01_ack.h). 
+//   System 1 takes it from the receive ring and displays link statistics every second. 
 
 //==================================================
 // Macros 
 
-// Command IDs 
-#define RC_MOTOR_LEFT_MOTOR 0x4C          // "L" character that indicates left motor 
-#define RC_MOTOR_RIGHT_MOTOR 0x52         // "R" character that indicates right motor 
-#define RC_MOTOR_FWD_THRUST 0x50          // "P" (plus) - indicates forward thrust 
-#define RC_MOTOR_REV_THRUST 0x4D          // "M" (minus) - indicates reverse thrust 
-#define RC_MOTOR_NEUTRAL 0x4E             // "N" (neutral) - indicates zero thrust 
 #define RC_MOTOR_NO_THRUST 0              // Force thruster output to zero 
 
 // Timing 
 #define RC_MOTOR_TIMEOUT 20               // No radio connection timeout counter 
-#define RC_MOTOR_SEND_PERIOD 100000       // Time between throttle command sends (us) 
-#define RC_MOTOR_RECEIVE_PERIOD 50000     // Time between throttle command sends (us) 
+#define RC_MOTOR_SEND_PERIOD 20000        // Time between throttle frame sends (us) 
+#define RC_MOTOR_RECEIVE_PERIOD 50000     // Time between radio loss timeout counts (us) 
+#define RC_MOTOR_DISPLAY_FRAMES 50        // Frames sent between link statistic displays 
+#define RC_MOTOR_LINK_COUNTS 20           // Timeout counts between link quality updates 
 
 // System parameters 
 #define RC_MOTOR_TEST_ADC_NUM 2           // Number of ADCs used for throttle command 
 #define RC_MOTOR_ESC_PERIOD 20000         // ESC PWM timer period (auto-reload register) 
 #define RC_MOTOR_ESC_FWD_SPEED_LIM 1600   // Forward PWM pulse time limit (us) 
 #define RC_MOTOR_ESC_REV_SPEED_LIM 1440   // Reverse PWM pulse time limit (us) 
+#define RC_MOTOR_PERCENT 100              // Link quality scale 
 
 //==================================================
 
@@ -680,10 +920,18 @@ void rc_test_pop_callback(
 // ADC storage - Location for the DMA to store ADC values 
 static uint16_t adc_data[RC_MOTOR_TEST_ADC_NUM]; 
 
-#elif RC_SYSTEM_2 
+#endif 
 
-// Command data 
-static nrf24l01_cmd_data_t rc_cmd_data; 
+// Throttle frame sent or last received 
+static rc_frame_t rc_frame; 
+
+#if RC_SYSTEM_2 
+
+// Frame sequence tracking and lost frame counts 
+static rc_frame_rx_t rc_frame_rx; 
+
+// Telemetry sent back in ACKs 
+static rc_frame_telem_t rc_telem; 
 
 #endif 
 
@@ -716,6 +964,18 @@ void rc_test_thruster_output(
  */
 void rc_test_no_radio(uint8_t *timer); 
 
+
+/**
+ * @brief Load telemetry to send back in the next ACK 
+ */
+void rc_test_telem_load(void); 
+
+
+/**
+ * @brief Link quality update - share of frames received since the last update 
+ */
+void rc_test_link_update(void); 
+
 #endif 
 
 //==================================================
@@ -795,6 +1055,10 @@ void rc_motor_test_init(void)
     //==================================================
 
     memset((void *)adc_data, CLEAR, sizeof(adc_data)); 
+    memset((void *)&rc_frame, CLEAR, sizeof(rc_frame)); 
+
+    twheel_start(&rc_test.delay_timer, RC_MOTOR_SEND_PERIOD, RC_MOTOR_SEND_PERIOD, 
+                 NULL, NULL); 
 
 #elif RC_SYSTEM_2 
 
@@ -828,11 +1092,15 @@ void rc_motor_test_init(void)
     
     //==================================================
 
-    memset((void *)rc_cmd_data.cb, CLEAR, sizeof(rc_cmd_data.cb)); 
-    rc_cmd_data.cb_index = CLEAR; 
-    memset((void *)rc_cmd_data.cmd_buff, CLEAR, sizeof(rc_cmd_data.cmd_buff)); 
-    memset((void *)rc_cmd_data.cmd_id, CLEAR, sizeof(rc_cmd_data.cmd_id)); 
-    rc_cmd_data.cmd_value = CLEAR; 
+    memset((void *)&rc_frame, CLEAR, sizeof(rc_frame)); 
+    memset((void *)&rc_frame_rx, CLEAR, sizeof(rc_frame_rx)); 
+    memset((void *)&rc_telem, CLEAR, sizeof(rc_telem)); 
+
+    // Telemetry is ready for the first ACK 
+    rc_test_telem_load(); 
+
+    twheel_start(&rc_test.delay_timer, RC_MOTOR_RECEIVE_PERIOD, RC_MOTOR_RECEIVE_PERIOD, 
+                 NULL, NULL); 
 
 #endif 
 }
@@ -848,119 +1116,81 @@ void rc_motor_test_loop(void)
 #if RC_SYSTEM_1 
 
     static gpio_pin_state_t led_state = GPIO_LOW; 
-    static uint8_t thruster = CLEAR; 
-    char side = CLEAR; 
-    char sign = RC_MOTOR_FWD_THRUST; 
-    int16_t throttle = CLEAR; 
-
-    if (tim_compare(rc_test.timer_nonblocking, 
-                    rc_test.delay_timer.clk_freq, 
-                    RC_MOTOR_SEND_PERIOD, 
-                    &rc_test.delay_timer.time_cnt_total, 
-                    &rc_test.delay_timer.time_cnt, 
-                    &rc_test.delay_timer.time_start))
-    {
-        // time_start flag does not need to be set again because this timer runs 
-        // continuously. 
-
-        // Choose between right and left thruster 
-        side = (thruster) ? RC_MOTOR_LEFT_MOTOR : RC_MOTOR_RIGHT_MOTOR; 
-
-        // Read the ADC input and format the value for writing to the payload 
-        throttle = esc_test_adc_mapping(adc_data[thruster]); 
-
-        if (throttle == RC_MOTOR_NO_THRUST)
-        {
-            sign = RC_MOTOR_NEUTRAL; 
-        }
-        else if (throttle < RC_MOTOR_NO_THRUST)
-        {
-            // If the throttle is negative then change the value to positive and set the sign 
-            // in the payload as negative. This helps on the receiving end. 
-            throttle = ~throttle + 1; 
-            sign = RC_MOTOR_REV_THRUST; 
-        }
+    static uint8_t display_count = CLEAR; 
 
-        // Format the payload with the thruster specifier and the throttle then send the 
-        // payload. 
-        snprintf(
-            (char *)rc_test.write_buff, 
-            NRF24L01_MAX_PAYLOAD_LEN, 
-            "%c%c %d", 
-            side, sign, throttle); 
+    if (twheel_take(&rc_test.delay_timer))
+    {
+        // Read the ADC inputs and send the throttle of both thrusters in one frame 
+        rc_frame.throttle[RC_FRAME_RIGHT] = esc_test_adc_mapping(adc_data[0]); 
+        rc_frame.throttle[RC_FRAME_LEFT] = esc_test_adc_mapping(adc_data[1]); 
+        rc_frame_encode(rc_test.write_buff, &rc_frame); 
 
-        if (nrf24l01_send_payload(rc_test.write_buff) == NRF24L01_OK)
+        if (rc_test_send(rc_test.write_buff) == NRF24L01_OK)
         {
             led_state = (gpio_pin_state_t)(GPIO_HIGH - led_state); 
             gpio_write(GPIOA, GPIOX_PIN_5, led_state); 
         } 
 
-        // Toggle the thruster flag 
-        thruster = SET_BIT - thruster; 
+        // The sequence number counts frames sent, including ones that failed, so the 
+        // receiver sees every lost frame as a gap 
+        rc_frame.seq++; 
+
+        // Counted apart from the 8-bit sequence number, which wraps at 256 
+        if (++display_count >= RC_MOTOR_DISPLAY_FRAMES)
+        {
+            display_count = CLEAR; 
+            rc_test_link_display(); 
+        }
+    }
+
+    // Telemetry from system 2 comes back in the ACKs of the frames sent 
+    while (nrf24l01_rx_read(&rc_test.rx_payload))
+    {
+        rc_test_telem_check(&rc_test.rx_payload); 
     }
 
 #elif RC_SYSTEM_2 
 
     static uint8_t timeout = CLEAR; 
 
-    if (tim_compare(rc_test.timer_nonblocking, 
-                    rc_test.delay_timer.clk_freq, 
-                    RC_MOTOR_RECEIVE_PERIOD, 
-                    &rc_test.delay_timer.time_cnt_total, 
-                    &rc_test.delay_timer.time_cnt, 
-                    &rc_test.delay_timer.time_start))
+    // Apply throttle frames as soon as they're received. Older frames, repeats and 
+    // payloads that aren't valid frames are dropped. 
+    while (nrf24l01_rx_read(&rc_test.rx_payload))
     {
-        // time_start flag does not need to be set again because this timer runs 
-        // continuously. 
-
-        // Check if a payload has been received 
-        if (nrf24l01_data_ready_status() == rc_test.pipe)
+        if (rc_test.rx_payload.pipe != rc_test.pipe)
         {
-            // Payload has been received. Read the payload from the device RX FIFO. 
-            nrf24l01_receive_payload(rc_cmd_data.cmd_buff); 
+            continue; 
+        }
 
-            // Validate the payload format 
-            if (nrf24l01_test_parse_cmd(&rc_cmd_data, NRF24L01_CMD_ARG_VALUE))
-            {
-                // Check that the command matches a valid throttle command. If it does then update 
-                // the thruster command. Throttle command filtering is done by system 1. 
-
-                int16_t cmd_value = (int16_t)rc_cmd_data.cmd_value; 
-                int16_t throttle = RC_MOTOR_NO_THRUST; 
-                uint8_t motor = rc_cmd_data.cmd_id[0]; 
-                uint8_t direction = rc_cmd_data.cmd_id[1]; 
-
-                // Determine the throttle command 
-                if (direction == RC_MOTOR_FWD_THRUST)
-                {
-                    throttle = cmd_value; 
-                }
-                else if (direction == RC_MOTOR_REV_THRUST)
-                {
-                    throttle = ~cmd_value + 1; 
-                }
-
-                // Determine the motor 
-                if (motor == RC_MOTOR_RIGHT_MOTOR)
-                {
-                    rc_test_thruster_output(&timeout, DEVICE_ONE, throttle); 
-                }
-                else if (motor == RC_MOTOR_LEFT_MOTOR)
-                {
-                    rc_test_thruster_output(&timeout, DEVICE_TWO, throttle); 
-                }
-            }
-            else 
+        // The ACK of this payload has gone out with the telemetry loaded before it so 
+        // the next one is loaded now, whether or not the payload was a valid frame 
+        uint8_t frame_used = rc_frame_rx_update(&rc_frame_rx, rc_test.rx_payload.data, 
+                                                &rc_frame); 
+        rc_test_telem_load(); 
+
+        if (frame_used)
+        {
+            if (rc_frame.flags & RC_FRAME_FLAG_STOP)
             {
-                rc_test_no_radio(&timeout); 
+                rc_frame.throttle[RC_FRAME_RIGHT] = RC_MOTOR_NO_THRUST; 
+                rc_frame.throttle[RC_FRAME_LEFT] = RC_MOTOR_NO_THRUST; 
             }
-        }
-        else 
-        {
-            rc_test_no_radio(&timeout); 
+
+            rc_test_thruster_output(
+                &timeout, DEVICE_ONE, rc_frame.throttle[RC_FRAME_RIGHT]); 
+            rc_test_thruster_output(
+                &timeout, DEVICE_TWO, rc_frame.throttle[RC_FRAME_LEFT]); 
         }
     }
 
+    // Periodically count towards the radio loss timeout. Each frame received clears 
+    // the count so the motors only stop if no valid frame is seen for a while. 
+    if (twheel_take(&rc_test.delay_timer))
+    {
+        rc_test_no_radio(&timeout); 
+        rc_test_link_update(); 
+    }
+
 #endif 
 }
 
@@ -992,9 +1222,51 @@ void rc_test_no_radio(uint8_t *timer)
     {
         rc_test_thruster_output(timer, DEVICE_ONE, RC_MOTOR_NO_THRUST); 
         rc_test_thruster_output(timer, DEVICE_TWO, RC_MOTOR_NO_THRUST); 
+
+        // Frames missed while the radio is lost aren't counted as lost 
+        rc_frame_rx_resync(&rc_frame_rx); 
     }
 }
 
+
+// Load telemetry to send back in the next ACK 
+void rc_test_telem_load(void)
+{
+    // There's no battery monitor or compass in this test so those are left at zero 
+    rc_telem.seq = rc_frame.seq; 
+    rc_telem.lost = (rc_frame_rx.lost > UINT16_MAX) ? 
+                    UINT16_MAX : (uint16_t)rc_frame_rx.lost; 
+
+    nrf24l01_ack_load(
+        rc_test.pipe, 
+        rc_test.write_buff, 
+        rc_frame_telem_encode(rc_test.write_buff, &rc_telem)); 
+}
+
+
+// Link quality update 
+void rc_test_link_update(void)
+{
+    static uint8_t counts = CLEAR; 
+    static uint32_t frames = CLEAR, lost = CLEAR; 
+
+    if (++counts < RC_MOTOR_LINK_COUNTS)
+    {
+        return; 
+    }
+
+    // Frames lost while the radio is out aren't counted (resync) but no frames are 
+    // received either so the link drops to zero 
+    uint32_t new_frames = rc_frame_rx.frames - frames; 
+    uint32_t new_total = new_frames + (rc_frame_rx.lost - lost); 
+
+    rc_telem.link = new_total ? (uint8_t)((new_frames * RC_MOTOR_PERCENT) / new_total) : 0; 
+
+    counts = CLEAR; 
+    frames = rc_frame_rx.frames; 
+    lost = rc_frame_rx.lost; 
+}
+
 #endif 
 
 //==================================================
@@ -1012,6 +1284,9 @@ void rc_test_no_radio(uint8_t *timer)
 //   responses. Inputs come from the serial terminal and responses are output to the 
 //   serial terminal. This is not a two way test, but rather used to test any system 
 //   that is controlled by a radio ground station. 
+// - A remote system that sends telemetry in its ACKs (ex. system 2 of the motor test) 
+//   has it shown with the link statistics each heartbeat. Telemetry also counts as a 
+//   response for the lost connection check. 
 
 //==================================================
 // Macros 
@@ -1066,54 +1341,17 @@ void rc_ground_station_test_init(void)
 #if RC_SYSTEM_1 
 
     //==================================================
-    // UART DMA - further configure the UART for DMA input 
-
-    // Enable the IDLE line interrupt 
-    uart_interrupt_init(
-        USART2, 
-        UART_INT_DISABLE, 
-        UART_INT_DISABLE, 
-        UART_INT_DISABLE, 
-        UART_INT_DISABLE, 
-        UART_INT_ENABLE, 
-        UART_INT_DISABLE, 
-        UART_INT_DISABLE); 
-
-    // Initialize the DMA stream for the UART 
-    dma_stream_init(
-        DMA1, 
-        DMA1_Stream5, 
-        DMA_CHNL_4, 
-        DMA_DIR_PM, 
-        DMA_CM_ENABLE,
-        DMA_PRIOR_VHI, 
-        DMA_DBM_DISABLE, 
-        DMA_ADDR_INCREMENT,   // Increment the buffer pointer to fill the buffer 
-        DMA_ADDR_FIXED,       // No peripheral increment - copy from DR only 
-        DMA_DATA_SIZE_BYTE, 
-        DMA_DATA_SIZE_BYTE); 
-
-    // Configure the DMA stream for the UART 
-    dma_stream_config(
-        DMA1_Stream5, 
-        (uint32_t)(&USART2->DR), 
-        (uint32_t)rc_gs_cmd_data.cb, 
-        (uint32_t)NULL, 
-        (uint16_t)NRF24L01_TEST_MAX_INPUT); 
-
-    // Enable the DMA stream for the UART 
-    dma_stream_enable(DMA1_Stream5); 
+    // UART input - read through the receive pipeline 
 
     // Initialize interrupt handler flags (called once) 
     int_handler_init(); 
 
-    // Enable the interrupt handlers (called for each interrupt) - for USART2_RX 
-    nvic_config(USART2_IRQn, EXTI_PRIORITY_0); 
+    // User commands are received by DMA into a circular buffer and read a line at a 
+    // time so input typed or pasted between loop passes isn't lost. 
+    uart_rxp_init(EXTI_PRIORITY_0); 
 
     //==================================================
 
-    memset((void *)rc_gs_cmd_data.cb, CLEAR, sizeof(rc_gs_cmd_data.cb)); 
-    rc_gs_cmd_data.cb_index = CLEAR; 
     memset((void *)rc_gs_cmd_data.cmd_buff, CLEAR, sizeof(rc_gs_cmd_data.cmd_buff)); 
     memset((void *)rc_gs_cmd_data.cmd_id, CLEAR, sizeof(rc_gs_cmd_data.cmd_id)); 
     rc_gs_cmd_data.cmd_value = CLEAR; 
@@ -1121,6 +1359,9 @@ void rc_ground_station_test_init(void)
 
     rc_ground_station_user_prompt(); 
 
+    twheel_start(&rc_test.delay_timer, RC_GS_ACTION_PERIOD, RC_GS_ACTION_PERIOD, NULL, 
+                 NULL); 
+
 #elif RC_SYSTEM_2 
 #endif 
 }
@@ -1139,51 +1380,58 @@ void rc_ground_station_test_loop(void)
     static uint8_t hb_timeout_counter = CLEAR; 
 
     // Check for user serial terminal input 
-    if (handler_flags.usart2_flag)
+    if (event_take(EVENT_MASK(EVENT_USART2) | EVENT_MASK(EVENT_DMA1_5)))
     {
-        handler_flags.usart2_flag = CLEAR; 
+        uart_rxp_line_t line; 
 
-        // Copy the new contents in the circular buffer to the user input buffer 
-        cb_parse(
-            rc_gs_cmd_data.cb, 
-            rc_gs_cmd_data.cmd_buff, 
-            &rc_gs_cmd_data.cb_index, 
-            NRF24L01_TEST_MAX_INPUT); 
+        while (uart_rxp_line_get(&line))
+        {
+            // Copy the command out of the circular buffer (payload size limit) 
+            uart_rxp_line_copy(
+                &line, 
+                (char *)rc_gs_cmd_data.cmd_buff, 
+                NRF24L01_TEST_MAX_INPUT); 
+            uart_rxp_line_release(); 
 
-        // Send string 
-        nrf24l01_send_payload(rc_gs_cmd_data.cmd_buff); 
+            // Send string 
+            rc_test_send(rc_gs_cmd_data.cmd_buff); 
 
-        rc_ground_station_user_prompt(); 
+            rc_ground_station_user_prompt(); 
+        }
     }
 
-    // Periodically check for action items 
-    if (tim_compare(rc_test.timer_nonblocking, 
-                    rc_test.delay_timer.clk_freq, 
-                    RC_GS_ACTION_PERIOD, 
-                    &rc_test.delay_timer.time_cnt_total, 
-                    &rc_test.delay_timer.time_cnt, 
-                    &rc_test.delay_timer.time_start))
+    // Look for incoming messages from the remote system 
+    while (nrf24l01_rx_read(&rc_test.rx_payload))
     {
-        // time_start flag does not need to be set again because this timer runs 
-        // continuously. 
+        if (rc_test_telem_check(&rc_test.rx_payload))
+        {
+            hb_timeout_counter = CLEAR; 
+            continue; 
+        }
 
-        // Look for an incoming message from the remote system 
-        if (nrf24l01_data_ready_status() == rc_test.pipe)
+        if (rc_test.rx_payload.pipe != rc_test.pipe)
         {
-            nrf24l01_receive_payload(rc_test.read_buff); 
+            continue; 
+        }
 
-            // Clear the timeout for any message received 
-            hb_timeout_counter = CLEAR; 
+        memcpy((void *)rc_test.read_buff, (void *)rc_test.rx_payload.data, 
+               sizeof(rc_test.read_buff)); 
 
-            if (strcmp((char *)rc_test.read_buff, ping_response) != 0)
-            {
-                // Display the message for the ground station to see 
-                uart_sendstring(USART2, "\033[1A\033[1A\r"); 
-                uart_sendstring(USART2, (char *)rc_test.read_buff); 
-                rc_ground_station_user_prompt(); 
-            }
+        // Clear the timeout for any message received 
+        hb_timeout_counter = CLEAR; 
+
+        if (strcmp((char *)rc_test.read_buff, ping_response) != 0)
+        {
+            // Display the message for the ground station to see 
+            uart_sendstring(USART2, "\033[1A\033[1A\r"); 
+            uart_sendstring(USART2, (char *)rc_test.read_buff); 
+            rc_ground_station_user_prompt(); 
         }
+    }
 
+    // Periodically check for action items 
+    if (twheel_take(&rc_test.delay_timer))
+    {
         // Check if the radio connection had been lost for too long 
         if (hb_timeout_counter++ >= RC_GS_HB_TIMEOUT_COUNTER)
         {
@@ -1199,7 +1447,12 @@ void rc_ground_station_test_loop(void)
         if (hb_send_counter++ >= RC_GS_HB_SEND_COUNTER)
         {
             hb_send_counter = CLEAR; 
-            nrf24l01_send_payload((uint8_t *)ping_msg); 
+            rc_test_send((const uint8_t *)ping_msg); 
+
+            // Display the link statistics above the prompt 
+            uart_sendstring(USART2, "\033[1A"); 
+            rc_test_link_display(); 
+            rc_ground_station_user_prompt(); 
         }
     }
 
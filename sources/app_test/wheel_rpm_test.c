@@ -20,6 +20,9 @@
 
 #include "wheel_rpm_test.h" 
 #include "stm32f4xx_it.h" 
+#include "bench_test.h" 
+#include "dlog.h" 
+#include "uart_tx_queue.h" 
 
 //=======================================================================================
 
@@ -28,7 +31,6 @@
 // Macros 
 
 #define RPM_SAMPLE_BUFF_SIZE 20   // Number of samples for RPM calculation 
-#define RPM_OUTPUT_BUFF_SIZE 20   // Output string buffer size 
 #define PRM_SAMPLE_PERIOD 200     // Time between samples (ms) 
 #define RPM_SEC_TO_MIN 60         // 60 seconds / minute 
 
@@ -43,14 +45,13 @@
 typedef struct rpm_test_data_s 
 {
     // Wheel revolution data 
-    uint8_t rev_count;                          // Revolution counter 
+    uint32_t rev_count;                         // Revolution counter 
     uint8_t rev_buff_index;                     // Revolution circular buffer index 
-    uint8_t rev_buff[RPM_SAMPLE_BUFF_SIZE];     // Revolution circular buffer 
+    uint16_t rev_buff[RPM_SAMPLE_BUFF_SIZE];    // Revolution circular buffer 
     uint32_t rev_sum;                           // Revolution summation for RPM calc 
 
     // User data 
     uint32_t rpm;                               // Calculated RPM 
-    char rpm_buff[RPM_OUTPUT_BUFF_SIZE];        // Serial string to show RPM 
 }
 rpm_test_data_t; 
 
@@ -59,6 +60,17 @@ static rpm_test_data_t rpm_test_data;
 //=======================================================================================
 
 
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Record the latest revolution count and calculate the RPM 
+ */
+static void wheel_rpm_test_calc(void); 
+
+//=======================================================================================
+
+
 //=======================================================================================
 // Setup code 
 
@@ -71,6 +83,10 @@ void wheel_rpm_test_init(void)
     // Initialize interrupt handler flags 
     int_handler_init(); 
 
+    // Count every revolution interrupt so no revolutions are lost when they come 
+    // quicker than the code loops 
+    event_count_enable(EVENT_MASK(EVENT_EXTI4), CLEAR); 
+
     // Periodic (counter update) interrupt timer for RPM calculation. If the counter 
     // reload value changes, make sure to update the PRM_SAMPLE_PERIOD macro. 
     tim_9_to_11_counter_init(
@@ -91,6 +107,10 @@ void wheel_rpm_test_init(void)
         UART_DMA_DISABLE, 
         UART_DMA_DISABLE); 
 
+    // RPM messages are logged with DLOG (decode with tools/dlog_decode.cpp). An update 
+    // is dropped rather than holding up the loop if the queue is full. 
+    uart_txq_init(UART_TXQ_DROP, EXTI_PRIORITY_2); 
+
     // External interrupt (rev count) setup 
     exti_init(); 
     exti_config(
@@ -114,7 +134,6 @@ void wheel_rpm_test_init(void)
     memset((void *)rpm_test_data.rev_buff, CLEAR, sizeof(rpm_test_data.rev_buff)); 
     rpm_test_data.rev_sum = CLEAR; 
     rpm_test_data.rpm = CLEAR; 
-    memset((void *)rpm_test_data.rpm_buff, CLEAR, sizeof(rpm_test_data.rpm_buff)); 
 }
 
 //=======================================================================================
@@ -126,67 +145,89 @@ void wheel_rpm_test_init(void)
 // Wheel RPM test application code 
 void wheel_rpm_test_app(void)
 {
-    // The interrupt handler for the external interrupt is not used directly because the 
-    // code loops quicker than there can be successive revolutions (for this test setup). 
+    // The interrupt handler for the external interrupt is not used directly. It counts 
+    // each revolution (see event_count_enable) so revolutions that come quicker than the 
+    // code loops are still counted. 
     // The interrupt handler for the periodic interrpt is not used directly because a 
     // calculation needs to be done which is better suited to be handled here. 
 
-    // External interrupt - revolution counter 
-    if (handler_flags.exti4_flag)
-    {
-        handler_flags.exti4_flag = CLEAR; 
-        rpm_test_data.rev_count++; 
-    }
+    // Take both events at once and handle each pending one in the same pass. Events 
+    // are handled lowest first so a revolution seen in the same pass as the periodic 
+    // interrupt is counted before the RPM calculation. 
+    event_mask_t events = event_take(
+        EVENT_MASK(EVENT_EXTI4) | EVENT_MASK(EVENT_TIM1_UP_TIM10)); 
 
-    // Periodic interrupt - RPM calculation 
-    if (handler_flags.tim1_up_tim10_glbl_flag)
+    while (events)
     {
-        handler_flags.tim1_up_tim10_glbl_flag = CLEAR; 
+        switch (event_next(&events))
+        {
+            case EVENT_EXTI4:   // External interrupt - revolution counter 
+                rpm_test_data.rev_count += event_count_take(EVENT_EXTI4); 
+                break; 
 
-        // Record the revolution count from the most recent invertal, update the circular 
-        // buffer index and total the revolutions over the last RPM_SAMPLE_BUFF_SIZE 
-        // intervals before calculating the RPM and outputting the result to the serial 
-        // terminal for the user to see. 
+            case EVENT_TIM1_UP_TIM10:   // Periodic interrupt - RPM calculation 
+                // Calculate the RPM and output the result to the serial terminal for 
+                // the user to see. 
+                wheel_rpm_test_calc(); 
 
-        rpm_test_data.rev_buff[rpm_test_data.rev_buff_index++] = rpm_test_data.rev_count; 
-        rpm_test_data.rev_count = CLEAR; 
+                DLOG("\rRPM: %lu  ", rpm_test_data.rpm); 
+                break; 
 
-        if (rpm_test_data.rev_buff_index >= RPM_SAMPLE_BUFF_SIZE)
-        {
-            rpm_test_data.rev_buff_index = CLEAR; 
+            default: 
+                break; 
         }
+    }
+}
 
-        rpm_test_data.rev_sum = CLEAR; 
+//=======================================================================================
 
-        for (uint8_t i = CLEAR; i < RPM_SAMPLE_BUFF_SIZE; i++)
-        {
-            rpm_test_data.rev_sum += rpm_test_data.rev_buff[i]; 
-        }
 
-        // RPM = (revolutions / (num_samples * sample_period[ms] / 1000[ms/s])) * 60[s/min] 
-        rpm_test_data.rpm = (uint32_t)(rpm_test_data.rev_sum * RPM_SEC_TO_MIN * SCALE_1000 / 
-                                      (RPM_SAMPLE_BUFF_SIZE * PRM_SAMPLE_PERIOD)); 
-        
-        // Note: Resolution for the RPM is dependent on the sample period (time between 
-        //       revolution count checks) and sample buffer size (amount of past time to 
-        //       look at when counting revolutions). These two values are multiplied 
-        //       together and make up the denominator of the equation above. A higher 
-        //       value of this multiplication gives a better/finer resolution whereas 
-        //       a lower value gives a worse resolution. These two values work against 
-        //       each other as more samples is better but increases time (i.e. the RPM 
-        //       reading will lag in time) and shorter period is better but brings down 
-        //       denominator value. You will have to pick a balance that works for you 
-        //       but the ideal scenario is to have many samples and a short period while 
-        //       still keeping the denominator large (i.e. sample number outweighs the 
-        //       period length). 
-
-        snprintf(
-            rpm_test_data.rpm_buff, 
-            RPM_OUTPUT_BUFF_SIZE, 
-            "\rRPM: %lu  ", 
-            rpm_test_data.rpm); 
-        uart_sendstring(USART2, rpm_test_data.rpm_buff); 
+//=======================================================================================
+// Test functions 
+
+// Record the latest revolution count and calculate the RPM 
+static void wheel_rpm_test_calc(void)
+{
+    // Record the revolution count from the most recent invertal, update the circular 
+    // buffer index and total the revolutions over the last RPM_SAMPLE_BUFF_SIZE 
+    // intervals before calculating the RPM. 
+
+    // Revolutions counted since the last revolution event was taken are included 
+    rpm_test_data.rev_count += event_count_take(EVENT_EXTI4); 
+    rpm_test_data.rev_buff[rpm_test_data.rev_buff_index++] = 
+        (uint16_t)rpm_test_data.rev_count; 
+    rpm_test_data.rev_count = CLEAR; 
+
+    if (rpm_test_data.rev_buff_index >= RPM_SAMPLE_BUFF_SIZE)
+    {
+        rpm_test_data.rev_buff_index = CLEAR; 
+    }
+
+    rpm_test_data.rev_sum = CLEAR; 
+
+    for (uint8_t i = CLEAR; i < RPM_SAMPLE_BUFF_SIZE; i++)
+    {
+        rpm_test_data.rev_sum += rpm_test_data.rev_buff[i]; 
     }
+
+    // RPM = (revolutions / (num_samples * sample_period[ms] / 1000[ms/s])) * 60[s/min] 
+    rpm_test_data.rpm = (uint32_t)((uint64_t)rpm_test_data.rev_sum * RPM_SEC_TO_MIN * 
+                                   SCALE_1000 / (RPM_SAMPLE_BUFF_SIZE * PRM_SAMPLE_PERIOD)); 
+    
+    // Note: Resolution for the RPM is dependent on the sample period (time between 
+    //       revolution count checks) and sample buffer size (amount of past time to 
+    //       look at when counting revolutions). These two values are multiplied 
+    //       together and make up the denominator of the equation above. A higher 
+    //       value of this multiplication gives a better/finer resolution whereas 
+    //       a lower value gives a worse resolution. These two values work against 
+    //       each other as more samples is better but increases time (i.e. the RPM 
+    //       reading will lag in time) and shorter period is better but brings down 
+    //       denominator value. You will have to pick a balance that works for you 
+    //       but the ideal scenario is to have many samples and a short period while 
+    //       still keeping the denominator large (i.e. sample number outweighs the 
+    //       period length). 
 }
 
+BENCH_REGISTER("wheel_rpm_test_calc", wheel_rpm_test_calc)
+
 //=======================================================================================
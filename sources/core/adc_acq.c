@@ -0,0 +1,475 @@
+/**
+ * @file adc_acq.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Timer triggered ADC acquisition 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "adc_acq.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define ADC_ACQ_BUFFS 2                     // Double buffer 
+#define ADC_ACQ_DMA_IRQN DMA2_Stream0_IRQn 
+#define ADC_ACQ_ADC_IRQN ADC_IRQn 
+#define ADC_ACQ_TIM_MAX 0x10000             // Prescaler and auto reload range 
+
+// EXTSEL codes of the timer trigger outputs 
+#define ADC_ACQ_EXTSEL_TIM2_TRGO 0x6 
+#define ADC_ACQ_EXTSEL_TIM3_TRGO 0x8 
+
+// Stream 0 flags in LIFCR 
+#define ADC_ACQ_DMA_FLAGS (DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | \
+                           DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0)
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Acquisition data. 'filled' counts blocks filled by the DMA and 'next' is the number of 
+// the next block to hand out, so filled - next blocks are waiting (only the newest is 
+// kept). 
+typedef struct adc_acq_data_s
+{
+    uint16_t buff[ADC_ACQ_BUFFS][ADC_ACQ_BUFF_SIZE];    // Blocks written by the DMA 
+    TIM_TypeDef *timer;                     // Trigger timer 
+    adc_acq_callback_t callback;            // Block callback 
+    uint16_t scans;                         // Sequences per block 
+    uint16_t len;                           // Samples per block 
+    uint8_t channels;                       // Channels per sequence 
+    volatile uint8_t target;                // Buffer being filled - interrupts only 
+    volatile uint8_t newest;                // Buffer of the newest block 
+    volatile uint32_t filled;               // Blocks filled - interrupts only 
+    uint32_t next;                          // Next block to hand out 
+    adc_acq_block_t block;                  // Held block 
+    uint8_t held_buff;                      // Buffer of the held block 
+    volatile uint8_t held;                  // A block is held 
+    volatile uint8_t overwritten;           // The held block was overwritten 
+    uint8_t init;                           // Acquisition is initialized 
+    adc_acq_stats_t stats;                  // Acquisition statistics 
+#if FREERTOS_ENABLE
+    TaskHandle_t task;                      // Task notified of filled blocks 
+#endif   // FREERTOS_ENABLE 
+}
+adc_acq_data_t; 
+
+static adc_acq_data_t adc_acq; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Start the DMA at the beginning of the buffer without the newest block - 
+ *        interrupts masked 
+ * 
+ * @details The newest block may be waiting to be handed out so it's left alone. Also 
+ *          clears an ADC overrun and re-enables ADC DMA requests which stop after an 
+ *          overrun. 
+ */
+static void adc_acq_dma_restart(void); 
+
+
+/**
+ * @brief Mask the acquisition interrupts 
+ */
+static void adc_acq_irq_disable(void); 
+
+
+/**
+ * @brief Unmask the acquisition interrupts 
+ */
+static void adc_acq_irq_enable(void); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Initialization 
+
+// Initialize the acquisition 
+uint32_t adc_acq_init(
+    TIM_TypeDef *timer, 
+    uint32_t rate, 
+    uint16_t scans, 
+    adc_acq_callback_t callback, 
+    uint8_t priority)
+{
+    uint32_t extsel, clock, ticks, psc, arr, max_scans; 
+
+    if (timer == TIM2)
+    {
+        RCC->APB1ENR |= RCC_APB1ENR_TIM2EN; 
+        extsel = ADC_ACQ_EXTSEL_TIM2_TRGO; 
+    }
+    else if (timer == TIM3)
+    {
+        RCC->APB1ENR |= RCC_APB1ENR_TIM3EN; 
+        extsel = ADC_ACQ_EXTSEL_TIM3_TRGO; 
+    }
+    else
+    {
+        return CLEAR; 
+    }
+
+    if (!rate)
+    {
+        return CLEAR; 
+    }
+
+    adc_acq_irq_disable(); 
+
+    ADC_ACQ_STREAM->CR &= ~DMA_SxCR_EN; 
+    while (ADC_ACQ_STREAM->CR & DMA_SxCR_EN); 
+
+    memset((void *)&adc_acq, CLEAR, sizeof(adc_acq)); 
+
+    adc_acq.timer = timer; 
+    adc_acq.callback = callback; 
+
+    // Block size - as many sequences as fit if 'scans' is too big 
+    adc_acq.channels = (ADC_ACQ_ADC->CR1 & ADC_CR1_SCAN) ?
+        (uint8_t)(((ADC_ACQ_ADC->SQR1 & ADC_SQR1_L) >> ADC_SQR1_L_Pos) + 1) : 1; 
+    max_scans = ADC_ACQ_BUFF_SIZE / adc_acq.channels; 
+    adc_acq.scans = (!scans || (scans > max_scans)) ? (uint16_t)max_scans : scans; 
+    adc_acq.len = adc_acq.scans * adc_acq.channels; 
+
+    // Timer - one update (trigger output) per sequence. The prescaler is kept as small 
+    // as possible so the auto reload gives the closest rate. 
+    clock = tim_get_pclk_freq(timer); 
+    ticks = (clock / rate) ? (clock / rate) : 1; 
+    psc = (ticks - 1) / ADC_ACQ_TIM_MAX; 
+    arr = (ticks / (psc + 1)) ? ((ticks / (psc + 1)) - 1) : CLEAR; 
+
+    timer->CR1 &= ~TIM_CR1_CEN; 
+    timer->CR2 &= ~TIM_CR2_MMS; 
+    timer->DIER = CLEAR; 
+    timer->PSC = psc; 
+    timer->ARR = arr; 
+    timer->EGR = TIM_EGR_UG;   // Load the prescaler before the trigger output is set 
+    timer->SR = CLEAR; 
+    timer->CNT = CLEAR; 
+    timer->CR2 |= TIM_CR2_MMS_1; 
+
+    // ADC - one sequence per trigger rising edge. DMA requests continue after each 
+    // block (DDS) since the DMA never stops in double buffer mode. 
+    ADC_ACQ_ADC->CR2 &= ~(ADC_CR2_CONT | ADC_CR2_EXTSEL | ADC_CR2_EXTEN | ADC_CR2_DMA); 
+    ADC_ACQ_ADC->CR2 |= (extsel << ADC_CR2_EXTSEL_Pos) | ADC_CR2_EXTEN_0 | ADC_CR2_DDS; 
+    ADC_ACQ_ADC->CR1 |= ADC_CR1_OVRIE; 
+
+    // ADC data register to each buffer in turn 
+    dma_stream_init(
+        ADC_ACQ_DMA, 
+        ADC_ACQ_STREAM, 
+        ADC_ACQ_CHNL, 
+        DMA_DIR_PM, 
+        DMA_CM_ENABLE, 
+        DMA_PRIOR_VHI, 
+        DMA_DBM_ENABLE, 
+        DMA_ADDR_INCREMENT,   // Increment the buffer pointer to fill the buffer 
+        DMA_ADDR_FIXED,       // No peripheral increment - copy from DR only 
+        DMA_DATA_SIZE_HALF, 
+        DMA_DATA_SIZE_HALF); 
+
+    dma_stream_config(
+        ADC_ACQ_STREAM, 
+        (uint32_t)(&ADC_ACQ_ADC->DR), 
+        (uint32_t)(uintptr_t)adc_acq.buff[0], 
+        (uint32_t)(uintptr_t)adc_acq.buff[1], 
+        adc_acq.len); 
+
+    // Transfer complete marks the end of each block 
+    dma_int_config(
+        ADC_ACQ_STREAM, 
+        DMA_TCIE_ENABLE, 
+        DMA_HTIE_DISABLE, 
+        DMA_TEIE_DISABLE, 
+        DMA_DMEIE_DISABLE); 
+
+    adc_acq.init = SET; 
+
+    nvic_config(ADC_ACQ_DMA_IRQN, priority); 
+    nvic_config(ADC_ACQ_ADC_IRQN, priority); 
+
+    return clock / ((psc + 1) * (arr + 1)); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Control 
+
+// Start sampling 
+void adc_acq_start(void)
+{
+    if (!adc_acq.init)
+    {
+        return; 
+    }
+
+    adc_acq_irq_disable(); 
+    adc_acq_dma_restart(); 
+    adc_acq_irq_enable(); 
+
+    adc_acq.timer->CNT = CLEAR; 
+    adc_acq.timer->CR1 |= TIM_CR1_CEN; 
+}
+
+
+// Stop sampling 
+void adc_acq_stop(void)
+{
+    if (!adc_acq.init)
+    {
+        return; 
+    }
+
+    adc_acq.timer->CR1 &= ~TIM_CR1_CEN; 
+
+    adc_acq_irq_disable(); 
+    ADC_ACQ_STREAM->CR &= ~DMA_SxCR_EN; 
+    while (ADC_ACQ_STREAM->CR & DMA_SxCR_EN); 
+    adc_acq_irq_enable(); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Blocks 
+
+// Get the newest filled block 
+uint8_t adc_acq_block_get(adc_acq_block_t *block)
+{
+    uint32_t filled; 
+
+    if (!adc_acq.init || (block == NULL))
+    {
+        return FALSE; 
+    }
+
+    if (adc_acq.held)
+    {
+        *block = adc_acq.block; 
+        return TRUE; 
+    }
+
+    adc_acq_irq_disable(); 
+
+    filled = adc_acq.filled; 
+
+    if (filled != adc_acq.next)
+    {
+        adc_acq.held_buff = adc_acq.newest; 
+        adc_acq.overwritten = CLEAR; 
+        adc_acq.held = SET; 
+    }
+
+    adc_acq_irq_enable(); 
+
+    if (!adc_acq.held)
+    {
+        return FALSE; 
+    }
+
+    // Older blocks were overwritten by the DMA so only the newest one can be used 
+    adc_acq.stats.lost += filled - 1 - adc_acq.next; 
+    adc_acq.next = filled; 
+
+    adc_acq.block.data = adc_acq.buff[adc_acq.held_buff]; 
+    adc_acq.block.scans = adc_acq.scans; 
+    adc_acq.block.channels = adc_acq.channels; 
+    adc_acq.block.number = filled - 1; 
+
+    *block = adc_acq.block; 
+    return TRUE; 
+}
+
+
+// Release the block from adc_acq_block_get 
+uint8_t adc_acq_block_release(void)
+{
+    uint8_t intact; 
+
+    if (!adc_acq.held)
+    {
+        return FALSE; 
+    }
+
+    adc_acq_irq_disable(); 
+    intact = !adc_acq.overwritten; 
+    adc_acq.held = CLEAR; 
+    adc_acq_irq_enable(); 
+
+    return intact; 
+}
+
+
+// Read the acquisition statistics 
+void adc_acq_get_stats(adc_acq_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return; 
+    }
+
+    adc_acq_irq_disable(); 
+    *stats = adc_acq.stats; 
+    adc_acq_irq_enable(); 
+}
+
+
+#if FREERTOS_ENABLE
+
+// Notify a task each time a block is filled 
+void adc_acq_notify_set(TaskHandle_t task)
+{
+    adc_acq_irq_disable(); 
+    adc_acq.task = task; 
+    adc_acq_irq_enable(); 
+}
+
+#endif   // FREERTOS_ENABLE 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helpers 
+
+// Start the DMA at the beginning of the buffer without the newest block 
+static void adc_acq_dma_restart(void)
+{
+    ADC_ACQ_STREAM->CR &= ~DMA_SxCR_EN; 
+    while (ADC_ACQ_STREAM->CR & DMA_SxCR_EN); 
+
+    ADC_ACQ_DMA->LIFCR = ADC_ACQ_DMA_FLAGS; 
+    adc_acq.target = adc_acq.newest ? CLEAR : SET; 
+
+    if (adc_acq.target)
+    {
+        ADC_ACQ_STREAM->CR |= DMA_SxCR_CT; 
+    }
+    else
+    {
+        ADC_ACQ_STREAM->CR &= ~DMA_SxCR_CT; 
+    }
+
+    ADC_ACQ_STREAM->NDTR = adc_acq.len; 
+
+    // The buffer may still be held from before the newest block was filled 
+    if (adc_acq.held && (adc_acq.held_buff == adc_acq.target) && !adc_acq.overwritten)
+    {
+        adc_acq.overwritten = SET; 
+        adc_acq.stats.overruns++; 
+    }
+
+    // DMA requests start again when the DMA bit is set after the overrun is cleared 
+    ADC_ACQ_ADC->CR2 &= ~ADC_CR2_DMA; 
+    ADC_ACQ_ADC->SR &= ~(ADC_SR_OVR | ADC_SR_EOC | ADC_SR_STRT); 
+    ADC_ACQ_ADC->CR2 |= ADC_CR2_DMA; 
+
+    ADC_ACQ_STREAM->CR |= DMA_SxCR_EN; 
+}
+
+
+// Mask the acquisition interrupts 
+static void adc_acq_irq_disable(void)
+{
+    NVIC_DisableIRQ(ADC_ACQ_DMA_IRQN); 
+    NVIC_DisableIRQ(ADC_ACQ_ADC_IRQN); 
+}
+
+
+// Unmask the acquisition interrupts 
+static void adc_acq_irq_enable(void)
+{
+    NVIC_EnableIRQ(ADC_ACQ_ADC_IRQN); 
+    NVIC_EnableIRQ(ADC_ACQ_DMA_IRQN); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Interrupt handler 
+
+// Interrupt handler hook 
+void adc_acq_irq_handler(void)
+{
+    adc_acq_block_t block; 
+    uint8_t target; 
+
+    if (!adc_acq.init)
+    {
+        return; 
+    }
+
+    // A missed DMA request stops the ADC's requests and shifts the channel order, so 
+    // the block being filled is dropped and the DMA starts over 
+    if (ADC_ACQ_ADC->SR & ADC_SR_OVR)
+    {
+        adc_acq.stats.adc_overruns++; 
+        adc_acq_dma_restart(); 
+        return; 
+    }
+
+    // The DMA switches buffers when one is full 
+    target = (ADC_ACQ_STREAM->CR & DMA_SxCR_CT) ? SET : CLEAR; 
+
+    if (target == adc_acq.target)
+    {
+        return; 
+    }
+
+    adc_acq.newest = adc_acq.target; 
+    adc_acq.target = target; 
+    adc_acq.filled++; 
+    adc_acq.stats.blocks++; 
+
+    // The DMA is now writing over the held block 
+    if (adc_acq.held && (adc_acq.held_buff == target) && !adc_acq.overwritten)
+    {
+        adc_acq.overwritten = SET; 
+        adc_acq.stats.overruns++; 
+    }
+
+    if (adc_acq.callback != NULL)
+    {
+        block.data = adc_acq.buff[adc_acq.newest]; 
+        block.scans = adc_acq.scans; 
+        block.channels = adc_acq.channels; 
+        block.number = adc_acq.filled - 1; 
+        adc_acq.callback(&block); 
+    }
+
+#if FREERTOS_ENABLE
+    if (adc_acq.task != NULL)
+    {
+        BaseType_t task_woken = pdFALSE; 
+        vTaskNotifyGiveFromISR(adc_acq.task, &task_woken); 
+        portYIELD_FROM_ISR(task_woken); 
+    }
+#endif   // FREERTOS_ENABLE 
+}
+
+//=======================================================================================
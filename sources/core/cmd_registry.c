@@ -0,0 +1,64 @@
+/**
+ * @file cmd_registry.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Command registry 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "cmd_registry.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Lookup 
+
+// Find a command 
+uint8_t cmd_registry_find(
+    const cmd_registry_t *registry, 
+    const char *cmd)
+{
+    const cmd_registry_slot_t *slot; 
+    uint32_t hash; 
+    uint8_t len = CLEAR; 
+
+    if ((registry == NULL) || (cmd == NULL))
+    {
+        return CMD_REGISTRY_NONE; 
+    }
+
+    hash = CMD_REGISTRY_HASH_INIT(registry->seed); 
+
+    while (cmd[len] != NULL_CHAR)
+    {
+        if (len >= CMD_REGISTRY_MAX_LEN)
+        {
+            return CMD_REGISTRY_NONE; 
+        }
+
+        hash = CMD_REGISTRY_HASH_STEP(hash, cmd[len]); 
+        len++; 
+    }
+
+    // Only the command in the input's slot can match 
+    slot = &registry->slots[CMD_REGISTRY_SLOT(hash, registry->mask)]; 
+
+    if ((slot->name == NULL) || (slot->len != len) || memcmp(slot->name, cmd, len))
+    {
+        return CMD_REGISTRY_NONE; 
+    }
+
+    return slot->index; 
+}
+
+//=======================================================================================
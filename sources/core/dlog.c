@@ -0,0 +1,65 @@
+/**
+ * @file dlog.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Deferred format logging 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "dlog.h" 
+#include "uart_tx_queue.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Logging 
+
+// Encode a message frame 
+uint8_t dlog_encode(
+    uint8_t *frame, 
+    uint16_t id, 
+    const uint32_t *args, 
+    uint8_t num_args)
+{
+    uint8_t len = DLOG_HEADER_LEN; 
+
+    num_args = (num_args < DLOG_ARGS_MAX) ? num_args : DLOG_ARGS_MAX; 
+
+    frame[0] = DLOG_SYNC; 
+    frame[1] = (uint8_t)(num_args * DLOG_ARG_LEN); 
+    frame[2] = (uint8_t)id; 
+    frame[3] = (uint8_t)(id >> SHIFT_8); 
+
+    for (uint8_t i = CLEAR; i < num_args; i++)
+    {
+        frame[len++] = (uint8_t)args[i]; 
+        frame[len++] = (uint8_t)(args[i] >> SHIFT_8); 
+        frame[len++] = (uint8_t)(args[i] >> SHIFT_16); 
+        frame[len++] = (uint8_t)(args[i] >> SHIFT_24); 
+    }
+
+    return len; 
+}
+
+
+// Send a message frame through the serial transmit queue 
+void dlog_write(
+    uint16_t id, 
+    const uint32_t *args, 
+    uint8_t num_args)
+{
+    uint8_t frame[DLOG_FRAME_MAX]; 
+    uart_txq_write(frame, dlog_encode(frame, id, args, num_args)); 
+}
+
+//=======================================================================================
@@ -0,0 +1,370 @@
+/**
+ * @file dsp_filter.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Fixed point filters 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "dsp_filter.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define DSP_Q15_BITS 15                     // Q15 fraction bits 
+#define DSP_Q31_BITS 31                     // Q31 fraction bits 
+#define DSP_HALF_SHIFT 16                   // Q15 to Q31 and high half word 
+#define DSP_MA_ADD_SUB 0xFFFF0001           // +1 (low) and -1 (high) for SMLAD 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+// Convert ADC results to Q15 
+void dsp_adc_to_q15(
+    const uint16_t *adc, 
+    uint8_t stride, 
+    dsp_q15_t *out, 
+    uint16_t len, 
+    uint8_t resolution)
+{
+    uint8_t shift = (resolution < DSP_Q15_BITS) ? (DSP_Q15_BITS - resolution) : CLEAR; 
+
+    if ((adc == NULL) || (out == NULL) || !stride)
+    {
+        return; 
+    }
+
+    for (uint16_t i = CLEAR; i < len; i++)
+    {
+        out[i] = (dsp_q15_t)(*adc << shift); 
+        adc += stride; 
+    }
+}
+
+
+// Run a block through a chain of Q15 stages 
+uint16_t dsp_chain_q15(
+    const dsp_stage_q15_t *stages, 
+    uint8_t num_stages, 
+    dsp_q15_t *block, 
+    uint16_t len)
+{
+    if ((stages == NULL) || (block == NULL))
+    {
+        return CLEAR; 
+    }
+
+    for (uint8_t i = CLEAR; (i < num_stages) && len; i++)
+    {
+        len = stages[i].process(stages[i].stage, block, block, len); 
+    }
+
+    return len; 
+}
+
+
+// Offset block function 
+uint16_t dsp_offset_q15(
+    void *stage, 
+    const dsp_q15_t *in, 
+    dsp_q15_t *out, 
+    uint16_t len)
+{
+    const dsp_offset_q15_t *offset = (const dsp_offset_q15_t *)stage; 
+    uint32_t offset_pair, samples; 
+    uint16_t i = CLEAR; 
+
+    offset_pair = dsp_pack_q15(offset->offset, offset->offset); 
+
+    // Two samples at a time. memcpy lets the compiler use a single (unaligned) word 
+    // access without breaking aliasing rules. 
+    for (; (i + DSP_Q15_PAIR) <= len; i += DSP_Q15_PAIR)
+    {
+        memcpy((void *)&samples, (const void *)&in[i], sizeof(samples)); 
+        samples = dsp_qadd16(samples, offset_pair); 
+        memcpy((void *)&out[i], (const void *)&samples, sizeof(samples)); 
+    }
+
+    if (i < len)
+    {
+        out[i] = (dsp_q15_t)dsp_ssat16((int32_t)in[i] + offset->offset); 
+    }
+
+    return len; 
+}
+
+
+// Moving average setup 
+void dsp_ma_q15_init(
+    dsp_ma_q15_t *ma, 
+    uint8_t window_log2, 
+    dsp_q15_t initial)
+{
+    if (ma == NULL)
+    {
+        return; 
+    }
+
+    if (window_log2 > DSP_MA_WINDOW_MAX_LOG2)
+    {
+        window_log2 = DSP_MA_WINDOW_MAX_LOG2; 
+    }
+
+    ma->window_log2 = window_log2; 
+    ma->index = CLEAR; 
+    ma->sum = (int32_t)initial * (1 << window_log2); 
+
+    for (uint8_t i = CLEAR; i < (1 << window_log2); i++)
+    {
+        ma->history[i] = initial; 
+    }
+}
+
+
+// Moving average block function 
+uint16_t dsp_ma_q15(
+    void *stage, 
+    const dsp_q15_t *in, 
+    dsp_q15_t *out, 
+    uint16_t len)
+{
+    dsp_ma_q15_t *ma = (dsp_ma_q15_t *)stage; 
+    const uint8_t mask = (uint8_t)((1 << ma->window_log2) - 1); 
+    int32_t sum = ma->sum; 
+    uint8_t index = ma->index; 
+    dsp_q15_t sample; 
+
+    for (uint16_t i = CLEAR; i < len; i++)
+    {
+        sample = in[i]; 
+
+        // Add the new sample and remove the oldest in one multiply accumulate 
+        sum = dsp_smlad(dsp_pack_q15(sample, ma->history[index]), DSP_MA_ADD_SUB, sum); 
+        ma->history[index] = sample; 
+        index = (index + 1) & mask; 
+
+        out[i] = (dsp_q15_t)(sum >> ma->window_log2); 
+    }
+
+    ma->sum = sum; 
+    ma->index = index; 
+
+    return len; 
+}
+
+
+// Single pole low pass setup - Q15 
+void dsp_iir1_q15_init(
+    dsp_iir1_q15_t *iir, 
+    dsp_q15_t alpha, 
+    dsp_q15_t initial)
+{
+    if (iir == NULL)
+    {
+        return; 
+    }
+
+    iir->alpha = (alpha < 0) ? CLEAR : alpha; 
+    iir->state = (dsp_q31_t)initial * (1 << DSP_HALF_SHIFT); 
+}
+
+
+// Single pole low pass block function - Q15 
+uint16_t dsp_iir1_q15(
+    void *stage, 
+    const dsp_q15_t *in, 
+    dsp_q15_t *out, 
+    uint16_t len)
+{
+    dsp_iir1_q15_t *iir = (dsp_iir1_q15_t *)stage; 
+    dsp_q31_t state = iir->state, error; 
+
+    for (uint16_t i = CLEAR; i < len; i++)
+    {
+        // The state keeps the fraction below Q15 so small steps still reach the input 
+        error = dsp_qsub((dsp_q31_t)in[i] * (1 << DSP_HALF_SHIFT), state); 
+        state = dsp_qadd(state, 
+                         (dsp_q31_t)(((int64_t)error * iir->alpha) >> DSP_Q15_BITS)); 
+        out[i] = (dsp_q15_t)(state >> DSP_HALF_SHIFT); 
+    }
+
+    iir->state = state; 
+
+    return len; 
+}
+
+
+// Single pole low pass setup - Q31 
+void dsp_iir1_q31_init(
+    dsp_iir1_q31_t *iir, 
+    dsp_q31_t alpha, 
+    dsp_q31_t initial)
+{
+    if (iir == NULL)
+    {
+        return; 
+    }
+
+    iir->alpha = (alpha < 0) ? CLEAR : alpha; 
+    iir->state = initial; 
+}
+
+
+// Single pole low pass - Q31 
+void dsp_iir1_q31(
+    dsp_iir1_q31_t *iir, 
+    const dsp_q31_t *in, 
+    dsp_q31_t *out, 
+    uint16_t len)
+{
+    dsp_q31_t state = iir->state, error; 
+
+    for (uint16_t i = CLEAR; i < len; i++)
+    {
+        error = dsp_qsub(in[i], state); 
+        state = dsp_qadd(state, 
+                         (dsp_q31_t)(((int64_t)error * iir->alpha) >> DSP_Q31_BITS)); 
+        out[i] = state; 
+    }
+
+    iir->state = state; 
+}
+
+
+// Biquad setup 
+void dsp_biquad_q15_init(
+    dsp_biquad_q15_t *biquad, 
+    const dsp_q15_t coeffs[5])
+{
+    if ((biquad == NULL) || (coeffs == NULL))
+    {
+        return; 
+    }
+
+    biquad->b0 = coeffs[0]; 
+    biquad->b12 = dsp_pack_q15(coeffs[1], coeffs[2]); 
+    biquad->a12 = dsp_pack_q15((dsp_q15_t)dsp_ssat16(-(int32_t)coeffs[3]), 
+                               (dsp_q15_t)dsp_ssat16(-(int32_t)coeffs[4])); 
+    biquad->x12 = CLEAR; 
+    biquad->y12 = CLEAR; 
+}
+
+
+// Biquad block function 
+uint16_t dsp_biquad_q15(
+    void *stage, 
+    const dsp_q15_t *in, 
+    dsp_q15_t *out, 
+    uint16_t len)
+{
+    dsp_biquad_q15_t *biquad = (dsp_biquad_q15_t *)stage; 
+    uint32_t x12 = biquad->x12, y12 = biquad->y12; 
+    int64_t acc; 
+    dsp_q15_t x, y; 
+
+    for (uint16_t i = CLEAR; i < len; i++)
+    {
+        x = in[i]; 
+
+        // Q14 * Q15 products summed in 64 bits then back to Q15. Each pair of past 
+        // samples and coefficients is one dual multiply accumulate. 
+        acc = (int64_t)((int32_t)biquad->b0 * x); 
+        acc = dsp_smlald(x12, biquad->b12, acc); 
+        acc = dsp_smlald(y12, biquad->a12, acc); 
+        y = (dsp_q15_t)dsp_ssat16((int32_t)(acc >> DSP_Q14_SHIFT)); 
+
+        // Shift the delay lines - n-1 moves to n-2 
+        x12 = (x12 << DSP_HALF_SHIFT) | (uint16_t)x; 
+        y12 = (y12 << DSP_HALF_SHIFT) | (uint16_t)y; 
+
+        out[i] = y; 
+    }
+
+    biquad->x12 = x12; 
+    biquad->y12 = y12; 
+
+    return len; 
+}
+
+
+// CIC decimator setup 
+uint8_t dsp_cic_q15_init(
+    dsp_cic_q15_t *cic, 
+    uint8_t order, 
+    uint8_t rate_log2)
+{
+    if ((cic == NULL) || !order || (order > DSP_CIC_ORDER_MAX) ||
+        ((order * rate_log2) > DSP_CIC_GROWTH_MAX))
+    {
+        return FALSE; 
+    }
+
+    memset((void *)cic, CLEAR, sizeof(dsp_cic_q15_t)); 
+    cic->order = order; 
+    cic->rate_log2 = rate_log2; 
+    cic->shift = order * rate_log2; 
+
+    return TRUE; 
+}
+
+
+// CIC decimator block function 
+uint16_t dsp_cic_q15(
+    void *stage, 
+    const dsp_q15_t *in, 
+    dsp_q15_t *out, 
+    uint16_t len)
+{
+    dsp_cic_q15_t *cic = (dsp_cic_q15_t *)stage; 
+    const uint8_t mask = (uint8_t)((1 << cic->rate_log2) - 1); 
+    uint32_t value, delayed; 
+    uint16_t num_out = CLEAR; 
+
+    for (uint16_t i = CLEAR; i < len; i++)
+    {
+        // Integrators wrap around on purpose - the combs take the differences back out 
+        // and the result is correct as long as it fits in the output. 
+        value = (uint32_t)(int32_t)in[i]; 
+
+        for (uint8_t j = CLEAR; j < cic->order; j++)
+        {
+            cic->integrators[j] += value; 
+            value = cic->integrators[j]; 
+        }
+
+        cic->phase = (cic->phase + 1) & mask; 
+
+        if (cic->phase)
+        {
+            continue; 
+        }
+
+        for (uint8_t j = CLEAR; j < cic->order; j++)
+        {
+            delayed = cic->combs[j]; 
+            cic->combs[j] = value; 
+            value -= delayed; 
+        }
+
+        out[num_out++] = (dsp_q15_t)((int32_t)value >> cic->shift); 
+    }
+
+    return num_out; 
+}
+
+//=======================================================================================
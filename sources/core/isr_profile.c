@@ -0,0 +1,338 @@
+/**
+ * @file isr_profile.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Interrupt handler latency and duration profiler 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "isr_profile.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define ISR_PROFILE_IRQ_OFFSET 16           // Index of IRQn 0 - system exceptions are < 0 
+#define ISR_PROFILE_IRQ_NUM (ISR_PROFILE_IRQ_OFFSET + SPI5_IRQn + 1) 
+#define ISR_PROFILE_BUCKET_LEN 16           // Max length of one bucket in a dump line 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Globals 
+
+// Profile table and the slot of each interrupt (slot + 1, 0 = not profiled). Each slot 
+// is only written by its own handler which can't preempt itself. 
+static isr_profile_t isr_profile_table[ISR_PROFILE_SLOTS]; 
+static uint8_t isr_profile_slots[ISR_PROFILE_IRQ_NUM]; 
+static uint8_t isr_profile_slots_used; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Find the profile of an interrupt 
+ * 
+ * @param irqn : interrupt number 
+ * @return isr_profile_t* : profile or NULL if the interrupt isn't profiled 
+ */
+static isr_profile_t *isr_profile_find(IRQn_Type irqn); 
+
+
+/**
+ * @brief Histogram bucket of a time 
+ * 
+ * @param cycles : time (CPU cycles) 
+ * @return uint8_t : bucket index 
+ */
+static inline uint8_t isr_profile_bucket(uint32_t cycles); 
+
+
+/**
+ * @brief Write one histogram of a profile 
+ * 
+ * @param write : line output function 
+ * @param label : histogram name 
+ * @param buckets : histogram buckets 
+ */
+static void isr_profile_dump_histogram(
+    void (*write)(const char *line), 
+    const char *label, 
+    const uint32_t *buckets); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Setup 
+
+// Profile an interrupt 
+uint8_t isr_profile_enable(
+    IRQn_Type irqn, 
+    const char *name)
+{
+    int16_t index = (int16_t)irqn + ISR_PROFILE_IRQ_OFFSET; 
+    isr_profile_t *profile; 
+
+    if ((index < 0) || (index >= ISR_PROFILE_IRQ_NUM))
+    {
+        return FALSE; 
+    }
+
+    // Trace must be enabled for the DWT to count 
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; 
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; 
+
+    __disable_irq(); 
+
+    if (!isr_profile_slots[index])
+    {
+        if (isr_profile_slots_used >= ISR_PROFILE_SLOTS)
+        {
+            __enable_irq(); 
+            return FALSE; 
+        }
+
+        isr_profile_slots[index] = ++isr_profile_slots_used; 
+    }
+
+    profile = &isr_profile_table[isr_profile_slots[index] - 1]; 
+    memset((void *)profile, CLEAR, sizeof(isr_profile_t)); 
+    profile->irqn = irqn; 
+    profile->name = name; 
+
+    __enable_irq(); 
+
+    return TRUE; 
+}
+
+
+// Clear the histograms of all profiled interrupts 
+void isr_profile_clear(void)
+{
+    for (uint8_t i = CLEAR; i < isr_profile_slots_used; i++)
+    {
+        isr_profile_t *profile = &isr_profile_table[i]; 
+
+        __disable_irq(); 
+        profile->count = CLEAR; 
+        profile->duration_max = CLEAR; 
+        profile->latency_max = CLEAR; 
+        memset((void *)profile->duration, CLEAR, sizeof(profile->duration)); 
+        memset((void *)profile->latency, CLEAR, sizeof(profile->latency)); 
+        __enable_irq(); 
+    }
+}
+
+
+// Copy the profile of an interrupt 
+uint8_t isr_profile_get(
+    IRQn_Type irqn, 
+    isr_profile_t *profile)
+{
+    isr_profile_t *source = isr_profile_find(irqn); 
+
+    if (source == NULL)
+    {
+        return FALSE; 
+    }
+
+    __disable_irq(); 
+    *profile = *source; 
+    __enable_irq(); 
+
+    return TRUE; 
+}
+
+
+// Write the profile of every profiled interrupt 
+void isr_profile_dump(void (*write)(const char *line))
+{
+    char line[ISR_PROFILE_LINE_LEN]; 
+    isr_profile_t profile; 
+
+    snprintf(
+        line, 
+        ISR_PROFILE_LINE_LEN, 
+        "\r\nISR profile (CPU cycles, %lu per us)\r\n", 
+        (unsigned long)(rcc_get_hclk_frq() / (DIVIDE_1000 * DIVIDE_1000))); 
+    write(line); 
+
+    for (uint8_t i = CLEAR; i < isr_profile_slots_used; i++)
+    {
+        if (!isr_profile_get(isr_profile_table[i].irqn, &profile))
+        {
+            continue; 
+        }
+
+        snprintf(
+            line, 
+            ISR_PROFILE_LINE_LEN, 
+            "%s (IRQn %d): %lu calls, duration max %lu, latency max %lu\r\n", 
+            (profile.name != NULL) ? profile.name : "?", 
+            (int)profile.irqn, 
+            (unsigned long)profile.count, 
+            (unsigned long)profile.duration_max, 
+            (unsigned long)profile.latency_max); 
+        write(line); 
+
+        isr_profile_dump_histogram(write, "  duration", profile.duration); 
+        isr_profile_dump_histogram(write, "  latency ", profile.latency); 
+    }
+}
+
+
+// Write one histogram of a profile 
+static void isr_profile_dump_histogram(
+    void (*write)(const char *line), 
+    const char *label, 
+    const uint32_t *buckets)
+{
+    char line[ISR_PROFILE_LINE_LEN]; 
+    uint8_t len = CLEAR, empty = TRUE; 
+
+    len += (uint8_t)snprintf(line, ISR_PROFILE_LINE_LEN, "%s", label); 
+
+    // Each bucket is shown by its upper limit - the last bucket has no limit 
+    for (uint8_t i = CLEAR; i < ISR_PROFILE_BUCKETS; i++)
+    {
+        if (!buckets[i])
+        {
+            continue; 
+        }
+
+        if ((len + ISR_PROFILE_BUCKET_LEN + 2) >= ISR_PROFILE_LINE_LEN)
+        {
+            snprintf(line + len, ISR_PROFILE_LINE_LEN - len, "\r\n"); 
+            write(line); 
+            len = (uint8_t)snprintf(line, ISR_PROFILE_LINE_LEN, "          "); 
+        }
+
+        if (i < (ISR_PROFILE_BUCKETS - 1))
+        {
+            len += (uint8_t)snprintf(
+                line + len, 
+                ISR_PROFILE_LINE_LEN - len, 
+                "  <%lu: %lu", 
+                (unsigned long)(1UL << i), 
+                (unsigned long)buckets[i]); 
+        }
+        else
+        {
+            len += (uint8_t)snprintf(
+                line + len, 
+                ISR_PROFILE_LINE_LEN - len, 
+                "  >=%lu: %lu", 
+                (unsigned long)(1UL << (i - 1)), 
+                (unsigned long)buckets[i]); 
+        }
+
+        empty = FALSE; 
+    }
+
+    // Skip histograms with no samples (ex. latency of an EXTI interrupt) 
+    if (!empty)
+    {
+        snprintf(line + len, ISR_PROFILE_LINE_LEN - len, "\r\n"); 
+        write(line); 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Handler hooks 
+
+// Handler start time 
+uint32_t isr_profile_enter(void)
+{
+    return DWT->CYCCNT; 
+}
+
+
+// Record a handler call 
+void isr_profile_exit(
+    IRQn_Type irqn, 
+    uint32_t start, 
+    uint32_t latency)
+{
+    uint32_t duration = DWT->CYCCNT - start; 
+    isr_profile_t *profile = isr_profile_find(irqn); 
+
+    if (profile == NULL)
+    {
+        return; 
+    }
+
+    profile->count++; 
+    profile->duration[isr_profile_bucket(duration)]++; 
+
+    if (duration > profile->duration_max)
+    {
+        profile->duration_max = duration; 
+    }
+
+    if (latency != ISR_PROFILE_NO_LATENCY)
+    {
+        profile->latency[isr_profile_bucket(latency)]++; 
+
+        if (latency > profile->latency_max)
+        {
+            profile->latency_max = latency; 
+        }
+    }
+}
+
+
+// Latency of a timer update interrupt 
+uint32_t isr_profile_timer_latency(TIM_TypeDef *timer)
+{
+    return timer->CNT * (timer->PSC + 1); 
+}
+
+
+// Latency of the SysTick interrupt 
+uint32_t isr_profile_systick_latency(void)
+{
+    return SysTick->LOAD - SysTick->VAL; 
+}
+
+
+// Find the profile of an interrupt 
+static isr_profile_t *isr_profile_find(IRQn_Type irqn)
+{
+    int16_t index = (int16_t)irqn + ISR_PROFILE_IRQ_OFFSET; 
+
+    if ((index < 0) || (index >= ISR_PROFILE_IRQ_NUM) || !isr_profile_slots[index])
+    {
+        return NULL; 
+    }
+
+    return &isr_profile_table[isr_profile_slots[index] - 1]; 
+}
+
+
+// Histogram bucket of a time - bucket n holds times from 2^(n-1) up to 2^n 
+static inline uint8_t isr_profile_bucket(uint32_t cycles)
+{
+    uint8_t bucket = cycles ? (uint8_t)(32 - __builtin_clz(cycles)) : CLEAR; 
+    return (bucket < ISR_PROFILE_BUCKETS) ? bucket : (ISR_PROFILE_BUCKETS - 1); 
+}
+
+//=======================================================================================
@@ -0,0 +1,154 @@
+/**
+ * @file nrf24l01_ack.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief nRF24L01 ACK payloads 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "nrf24l01_ack.h" 
+#include "nrf24l01_rx.h" 
+#include "nrf24l01_reg.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define NRF24L01_ACK_FEATURES (NRF24L01_REG_EN_DPL | NRF24L01_REG_EN_ACK_PAY) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// ACK payload data 
+typedef struct nrf24l01_ack_data_s
+{
+    uint8_t loaded;                         // A payload was loaded and not seen sent 
+    nrf24l01_ack_stats_t stats;             // ACK payload statistics 
+}
+nrf24l01_ack_data_t; 
+
+static nrf24l01_ack_data_t nrf24l01_ack; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Initialization 
+
+// Turn on dynamic payload length and ACK payloads 
+uint8_t nrf24l01_ack_init(void)
+{
+    memset((void *)&nrf24l01_ack, CLEAR, sizeof(nrf24l01_ack)); 
+
+    nrf24l01_rx_lock(); 
+
+    // FEATURE can only be written once unlocked on the nRF24L01. The nRF24L01+ doesn't 
+    // need it and ignores it. 
+    nrf24l01_reg_write(NRF24L01_REG_FEATURE, NRF24L01_ACK_FEATURES); 
+
+    if (nrf24l01_reg_read(NRF24L01_REG_FEATURE) != NRF24L01_ACK_FEATURES)
+    {
+        uint8_t key = NRF24L01_REG_ACTIVATE_KEY; 
+        nrf24l01_reg_cmd(NRF24L01_REG_ACTIVATE, &key, NULL, 1); 
+        nrf24l01_reg_write(NRF24L01_REG_FEATURE, NRF24L01_ACK_FEATURES); 
+    }
+
+    // Dynamic payload length needs auto acknowledgement on the same pipe and the PTX 
+    // receives ACKs on pipe 0 
+    nrf24l01_reg_write(NRF24L01_REG_EN_AA, NRF24L01_REG_PIPES); 
+    nrf24l01_reg_write(NRF24L01_REG_DYNPD, NRF24L01_REG_PIPES); 
+    nrf24l01_reg_write(NRF24L01_REG_EN_RXADDR, 
+        nrf24l01_reg_read(NRF24L01_REG_EN_RXADDR) | NRF24L01_REG_ERX_P0); 
+    nrf24l01_reg_write(NRF24L01_REG_CONFIG, 
+        nrf24l01_reg_read(NRF24L01_REG_CONFIG) | NRF24L01_REG_MASK_TX_DS); 
+
+    uint8_t status =
+        (nrf24l01_reg_read(NRF24L01_REG_FEATURE) == NRF24L01_ACK_FEATURES) &&
+        (nrf24l01_reg_read(NRF24L01_REG_DYNPD) == NRF24L01_REG_PIPES); 
+
+    nrf24l01_rx_unlock(); 
+
+    return status; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// ACK payloads 
+
+// Load a payload to send with the next ACK on a pipe 
+uint8_t nrf24l01_ack_load(
+    nrf24l01_data_pipe_t pipe, 
+    const uint8_t *data, 
+    uint8_t len)
+{
+    uint8_t fifo_status, loaded = FALSE; 
+
+    if ((data == NULL) || (len == 0) || (len > NRF24L01_MAX_PAYLOAD_LEN) ||
+        (pipe > NRF24L01_DP_5))
+    {
+        return FALSE; 
+    }
+
+    nrf24l01_rx_lock(); 
+
+    // The data sent flag is set when an ACK payload goes out. It's cleared here too in 
+    // case the driver rewrites CONFIG without the mask, which leaves the IRQ pin low. 
+    if (nrf24l01_reg_read(NRF24L01_REG_STATUS) & NRF24L01_REG_TX_DS)
+    {
+        nrf24l01_reg_write(NRF24L01_REG_STATUS, NRF24L01_REG_TX_DS); 
+    }
+
+    fifo_status = nrf24l01_reg_read(NRF24L01_REG_FIFO_STATUS); 
+
+    if (nrf24l01_ack.loaded && (fifo_status & NRF24L01_REG_TX_EMPTY))
+    {
+        nrf24l01_ack.loaded = CLEAR; 
+        nrf24l01_ack.stats.sent++; 
+    }
+
+    if (nrf24l01_ack.loaded || (fifo_status & NRF24L01_REG_TX_FULL))
+    {
+        nrf24l01_ack.stats.waiting++; 
+    }
+    else
+    {
+        nrf24l01_reg_cmd(NRF24L01_REG_W_ACK_PAYLOAD | (uint8_t)pipe, data, NULL, len); 
+
+        nrf24l01_ack.loaded = SET; 
+        nrf24l01_ack.stats.loaded++; 
+        loaded = TRUE; 
+    }
+
+    // Unlocking pends the receive interrupt if a payload came in while it was masked 
+    nrf24l01_rx_unlock(); 
+
+    return loaded; 
+}
+
+
+// Read the ACK payload statistics 
+void nrf24l01_ack_stats(nrf24l01_ack_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = nrf24l01_ack.stats; 
+    }
+}
+
+//=======================================================================================
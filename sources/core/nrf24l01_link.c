@@ -0,0 +1,430 @@
+/**
+ * @file nrf24l01_link.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief nRF24L01 link benchmark 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "nrf24l01_link.h" 
+#include "nrf24l01_reg.h" 
+#include "nrf24l01_ack.h" 
+#include "sys_time.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define NRF24L01_LINK_HEADER_LEN 1          // Tag byte 
+#define NRF24L01_LINK_COUNT_LEN 4           // Sequence number or count (bytes) 
+#define NRF24L01_LINK_PEER_LEN (NRF24L01_LINK_HEADER_LEN + NRF24L01_LINK_COUNT_LEN) 
+#define NRF24L01_LINK_CTRL_LEN 2            // Tag and data rate 
+#define NRF24L01_LINK_US_PER_S 1000000 
+#define NRF24L01_LINK_PERCENT 100 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Benchmark data 
+typedef struct nrf24l01_link_data_s
+{
+    // Sender 
+    nrf24l01_link_config_t config;          // Run settings 
+    uint32_t seq;                           // Sequence number of the next payload 
+    uint32_t sent;                          // Payloads sent 
+    uint32_t acked;                         // Payloads acknowledged 
+    uint32_t retransmits;                   // Retransmits of all payloads 
+    uint32_t peer;                          // Receiver count from the last ACK payload 
+    uint64_t start;                         // Run start time (us) 
+    uint64_t end;                           // End of the last send (us) 
+    uint32_t rtt_max;                       // Longest RTT (us) 
+    uint32_t rtt[NRF24L01_LINK_RTT_BUCKETS];   // RTT histogram 
+
+    // Receiver 
+    uint32_t count;                         // Benchmark payloads taken 
+}
+nrf24l01_link_data_t; 
+
+static nrf24l01_link_data_t nrf24l01_link; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+/**
+ * @brief Send a payload through the radio's registers 
+ * 
+ * @param payload : payload 
+ * @param len : payload length 
+ * @param rtt : time from the start of the send until it finished (us) 
+ * @return uint8_t : TRUE if the payload was acknowledged 
+ */
+static uint8_t nrf24l01_link_transmit(
+    const uint8_t *payload, 
+    uint8_t len, 
+    uint32_t *rtt); 
+
+
+/**
+ * @brief Read ACK payloads left in the RX FIFO by a send 
+ */
+static void nrf24l01_link_ack_read(void); 
+
+
+/**
+ * @brief Change the data rate 
+ * 
+ * @param rate : data rate 
+ */
+static void nrf24l01_link_rate(nrf24l01_data_rate_t rate); 
+
+
+/**
+ * @brief RTT percentile from the histogram 
+ * 
+ * @param percent : percentile 
+ * @return uint32_t : RTT (us) - top of the bucket holding the percentile 
+ */
+static uint32_t nrf24l01_link_percentile(uint32_t percent); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Sender 
+
+// Start a run 
+uint8_t nrf24l01_link_start(const nrf24l01_link_config_t *config)
+{
+    uint8_t ctrl[NRF24L01_LINK_CTRL_LEN] = { NRF24L01_LINK_CTRL, (uint8_t)config->rate }; 
+    uint8_t retries = (config->retries > NRF24L01_LINK_RETRIES_MAX) ?
+                      NRF24L01_LINK_RETRIES_MAX : config->retries; 
+    nrf24l01_data_rate_t rate = nrf24l01_get_rf_setup_dr(); 
+    uint8_t acked = FALSE; 
+    uint32_t rtt; 
+
+    // The receiver only hears the control payload at the rate it's on now, so the rate 
+    // can't change until it has acknowledged it 
+    for (uint8_t i = CLEAR; (i < NRF24L01_LINK_CTRL_TRIES) && !acked; i++)
+    {
+        acked = nrf24l01_link_transmit(ctrl, NRF24L01_LINK_CTRL_LEN, &rtt); 
+    }
+
+    nrf24l01_link_rate(config->rate); 
+
+    // The receiver changes rate as soon as it has the control payload so if only the 
+    // ACKs were lost it's now on the new rate. Sending again there finds it. 
+    for (uint8_t i = CLEAR; (i < NRF24L01_LINK_CTRL_TRIES) && !acked; i++)
+    {
+        acked = nrf24l01_link_transmit(ctrl, NRF24L01_LINK_CTRL_LEN, &rtt); 
+    }
+
+    if (!acked)
+    {
+        nrf24l01_link_rate(rate); 
+        return FALSE; 
+    }
+
+    nrf24l01_rx_lock(); 
+    nrf24l01_reg_write(
+        NRF24L01_REG_SETUP_RETR, 
+        (uint8_t)((config->delay << NRF24L01_REG_ARD_POS) | retries)); 
+    nrf24l01_rx_unlock(); 
+
+    memset((void *)&nrf24l01_link, CLEAR, sizeof(nrf24l01_link)); 
+    nrf24l01_link.config = *config; 
+
+    if (nrf24l01_link.config.len > NRF24L01_MAX_PAYLOAD_LEN)
+    {
+        nrf24l01_link.config.len = NRF24L01_MAX_PAYLOAD_LEN; 
+    }
+    else if (nrf24l01_link.config.len < NRF24L01_LINK_HEADER_LEN)
+    {
+        nrf24l01_link.config.len = NRF24L01_LINK_HEADER_LEN; 
+    }
+
+    nrf24l01_link.start = sys_time_us(); 
+    nrf24l01_link.end = nrf24l01_link.start; 
+
+    return TRUE; 
+}
+
+
+// Send one benchmark payload 
+uint8_t nrf24l01_link_send(void)
+{
+    uint8_t payload[NRF24L01_MAX_PAYLOAD_LEN]; 
+    uint8_t len = nrf24l01_link.config.len, acked; 
+    uint32_t rtt, bucket; 
+
+    // Tag, sequence number (as much as fits) then a fill pattern 
+    payload[0] = NRF24L01_LINK_DATA; 
+
+    for (uint8_t i = NRF24L01_LINK_HEADER_LEN; i < len; i++)
+    {
+        payload[i] = (i <= NRF24L01_LINK_COUNT_LEN) ?
+            (uint8_t)(nrf24l01_link.seq >> (SHIFT_8 * (i - NRF24L01_LINK_HEADER_LEN))) :
+            (uint8_t)i; 
+    }
+
+    acked = nrf24l01_link_transmit(payload, len, &rtt); 
+
+    nrf24l01_link.seq++; 
+    nrf24l01_link.sent++; 
+    nrf24l01_link.end = sys_time_us(); 
+    bucket = rtt / NRF24L01_LINK_RTT_BUCKET_US; 
+    nrf24l01_link.rtt[(bucket < NRF24L01_LINK_RTT_BUCKETS) ?
+                      bucket : (NRF24L01_LINK_RTT_BUCKETS - 1)]++; 
+
+    if (rtt > nrf24l01_link.rtt_max)
+    {
+        nrf24l01_link.rtt_max = rtt; 
+    }
+
+    if (acked)
+    {
+        nrf24l01_link.acked++; 
+    }
+
+    return acked; 
+}
+
+
+// Results of the run so far 
+void nrf24l01_link_result(nrf24l01_link_result_t *result)
+{
+    uint64_t elapsed = nrf24l01_link.end - nrf24l01_link.start; 
+    uint32_t sent = nrf24l01_link.sent; 
+
+    if (result == NULL)
+    {
+        return; 
+    }
+
+    memset((void *)result, CLEAR, sizeof(nrf24l01_link_result_t)); 
+    result->sent = sent; 
+    result->acked = nrf24l01_link.acked; 
+    result->peer = nrf24l01_link.peer; 
+
+    if (elapsed)
+    {
+        result->payloads_per_s =
+            (uint32_t)(((uint64_t)nrf24l01_link.acked * NRF24L01_LINK_US_PER_S) / elapsed); 
+        result->goodput = result->payloads_per_s * nrf24l01_link.config.len; 
+    }
+
+    if (sent)
+    {
+        result->rtt_p50 = nrf24l01_link_percentile(50); 
+        result->rtt_p90 = nrf24l01_link_percentile(90); 
+        result->rtt_p99 = nrf24l01_link_percentile(99); 
+        result->rtt_max = nrf24l01_link.rtt_max; 
+        result->retransmit = (uint32_t)(((uint64_t)nrf24l01_link.retransmits *
+                                         NRF24L01_LINK_SCALE) / sent); 
+        result->loss = (uint32_t)(((uint64_t)(sent - nrf24l01_link.acked) *
+                                   NRF24L01_LINK_SCALE) / sent); 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Receiver 
+
+// Handle a payload taken from the receive ring 
+void nrf24l01_link_peer(const nrf24l01_rx_payload_t *payload)
+{
+    uint8_t ack[NRF24L01_LINK_PEER_LEN]; 
+
+    if (payload->data[0] == NRF24L01_LINK_CTRL)
+    {
+        // The control payload's ACK has already gone out at the old data rate 
+        nrf24l01_link.count = CLEAR; 
+        nrf24l01_link_rate((nrf24l01_data_rate_t)payload->data[1]); 
+    }
+    else if (payload->data[0] == NRF24L01_LINK_DATA)
+    {
+        nrf24l01_link.count++; 
+    }
+    else
+    {
+        return; 
+    }
+
+    ack[0] = NRF24L01_LINK_PEER; 
+
+    for (uint8_t i = CLEAR; i < NRF24L01_LINK_COUNT_LEN; i++)
+    {
+        ack[NRF24L01_LINK_HEADER_LEN + i] = (uint8_t)(nrf24l01_link.count >> (SHIFT_8 * i)); 
+    }
+
+    nrf24l01_ack_load(payload->pipe, ack, NRF24L01_LINK_PEER_LEN); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helpers 
+
+// Send a payload through the radio's registers 
+static uint8_t nrf24l01_link_transmit(
+    const uint8_t *payload, 
+    uint8_t len, 
+    uint32_t *rtt)
+{
+    uint8_t config, status; 
+    uint64_t start, now; 
+    uint16_t polls; 
+
+    nrf24l01_rx_lock(); 
+
+    // Leave receive mode (standby) and switch to PTX. The end of the send is seen on the 
+    // IRQ pin so it's unmasked until then. 
+    nrf24l01_reg_ce(GPIO_LOW); 
+    config = nrf24l01_reg_read(NRF24L01_REG_CONFIG); 
+    nrf24l01_reg_write(
+        NRF24L01_REG_CONFIG, 
+        config & ~(NRF24L01_REG_PRIM_RX | NRF24L01_REG_MASK_TX_DS |
+                   NRF24L01_REG_MASK_MAX_RT)); 
+    nrf24l01_reg_cmd(NRF24L01_REG_W_TX_PAYLOAD, payload, NULL, len); 
+
+    // A CE pulse sends one payload 
+    start = sys_time_us(); 
+    nrf24l01_reg_ce(GPIO_HIGH); 
+    while ((sys_time_us() - start) < NRF24L01_LINK_CE_PULSE_US); 
+    nrf24l01_reg_ce(GPIO_LOW); 
+
+    // Waiting on the pin keeps the SPI bus quiet during the send. The pin can already be 
+    // low from a payload received before the send so STATUS has the final say. 
+    do
+    {
+        for (polls = CLEAR; 
+             (gpio_read(NRF24L01_RX_GPIO, NRF24L01_RX_PIN_MASK) != GPIO_LOW) &&
+             (polls < NRF24L01_LINK_PIN_POLLS); 
+             polls++); 
+
+        status = nrf24l01_reg_cmd(NRF24L01_REG_NOP, NULL, NULL, 0); 
+        now = sys_time_us(); 
+    }
+    while (!(status & (NRF24L01_REG_TX_DS | NRF24L01_REG_MAX_RT)) &&
+           ((now - start) < NRF24L01_LINK_TIMEOUT_US)); 
+
+    *rtt = (uint32_t)(now - start); 
+    nrf24l01_link.retransmits +=
+        nrf24l01_reg_read(NRF24L01_REG_OBSERVE_TX) & NRF24L01_REG_ARC_CNT; 
+
+    // A payload that wasn't acknowledged stays in the TX FIFO 
+    if (!(status & NRF24L01_REG_TX_DS))
+    {
+        nrf24l01_reg_cmd(NRF24L01_REG_FLUSH_TX, NULL, NULL, 0); 
+    }
+
+    nrf24l01_reg_write(NRF24L01_REG_STATUS, NRF24L01_REG_TX_DS | NRF24L01_REG_MAX_RT); 
+    nrf24l01_link_ack_read(); 
+
+    // Back to receive mode 
+    nrf24l01_reg_write(NRF24L01_REG_CONFIG, config | NRF24L01_REG_PRIM_RX); 
+    nrf24l01_reg_ce(GPIO_HIGH); 
+
+    // Unlocking pends the receive interrupt for payloads left in the RX FIFO 
+    nrf24l01_rx_unlock(); 
+
+    return (status & NRF24L01_REG_TX_DS) ? TRUE : FALSE; 
+}
+
+
+// Read ACK payloads left in the RX FIFO by a send 
+static void nrf24l01_link_ack_read(void)
+{
+    uint8_t data[NRF24L01_MAX_PAYLOAD_LEN]; 
+    uint8_t status, width; 
+
+    // ACK payloads come in on pipe 0. Payloads from other pipes are left for the 
+    // receive interrupt. 
+    while (!(nrf24l01_reg_read(NRF24L01_REG_FIFO_STATUS) & NRF24L01_REG_RX_EMPTY))
+    {
+        status = nrf24l01_reg_cmd(NRF24L01_REG_NOP, NULL, NULL, 0); 
+
+        if (((status & NRF24L01_REG_RX_P_NO) >> NRF24L01_REG_RX_P_NO_POS) != NRF24L01_DP_0)
+        {
+            return; 
+        }
+
+        nrf24l01_reg_cmd(NRF24L01_REG_R_RX_PL_WID, NULL, &width, 1); 
+
+        if (width > NRF24L01_MAX_PAYLOAD_LEN)
+        {
+            // Corrupt width - the payload can't be read 
+            nrf24l01_reg_cmd(NRF24L01_REG_FLUSH_RX, NULL, NULL, 0); 
+            break; 
+        }
+
+        nrf24l01_reg_cmd(NRF24L01_REG_R_RX_PAYLOAD, NULL, data, width); 
+
+        if ((width == NRF24L01_LINK_PEER_LEN) && (data[0] == NRF24L01_LINK_PEER))
+        {
+            nrf24l01_link.peer = CLEAR; 
+
+            for (uint8_t i = CLEAR; i < NRF24L01_LINK_COUNT_LEN; i++)
+            {
+                nrf24l01_link.peer |=
+                    (uint32_t)data[NRF24L01_LINK_HEADER_LEN + i] << (SHIFT_8 * i); 
+            }
+        }
+    }
+
+    // Every payload was read so the flag can go 
+    nrf24l01_reg_write(NRF24L01_REG_STATUS, NRF24L01_REG_RX_DR); 
+}
+
+
+// Change the data rate 
+static void nrf24l01_link_rate(nrf24l01_data_rate_t rate)
+{
+    nrf24l01_rx_lock(); 
+    nrf24l01_set_rf_setup_dr(rate); 
+    nrf24l01_rf_setup_write(); 
+    nrf24l01_rx_unlock(); 
+}
+
+
+// RTT percentile from the histogram 
+static uint32_t nrf24l01_link_percentile(uint32_t percent)
+{
+    uint32_t target = ((nrf24l01_link.sent * percent) + NRF24L01_LINK_PERCENT - 1) /
+                      NRF24L01_LINK_PERCENT; 
+    uint32_t total = CLEAR; 
+
+    for (uint16_t i = CLEAR; i < NRF24L01_LINK_RTT_BUCKETS; i++)
+    {
+        total += nrf24l01_link.rtt[i]; 
+
+        if (total >= target)
+        {
+            uint32_t top = (uint32_t)(i + 1) * NRF24L01_LINK_RTT_BUCKET_US; 
+            return (top < nrf24l01_link.rtt_max) ? top : nrf24l01_link.rtt_max; 
+        }
+    }
+
+    return nrf24l01_link.rtt_max; 
+}
+
+//=======================================================================================
@@ -0,0 +1,112 @@
+/**
+ * @file nrf24l01_reg.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief nRF24L01 register access 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "nrf24l01_reg.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+/**
+ * @brief Send and receive one byte 
+ * 
+ * @param data : byte to send 
+ * @return uint8_t : byte received 
+ */
+static uint8_t nrf24l01_reg_transfer(uint8_t data); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Register access 
+
+// Read a register 
+uint8_t nrf24l01_reg_read(uint8_t reg)
+{
+    uint8_t value; 
+
+    nrf24l01_reg_cmd(NRF24L01_REG_R_REGISTER | reg, NULL, &value, 1); 
+
+    return value; 
+}
+
+
+// Write a register 
+void nrf24l01_reg_write(
+    uint8_t reg, 
+    uint8_t value)
+{
+    nrf24l01_reg_cmd(NRF24L01_REG_W_REGISTER | reg, &value, NULL, 1); 
+}
+
+
+// Send a command with data 
+uint8_t nrf24l01_reg_cmd(
+    uint8_t cmd, 
+    const uint8_t *tx, 
+    uint8_t *rx, 
+    uint8_t len)
+{
+    uint8_t status, data; 
+
+    gpio_write(NRF24L01_REG_SS_GPIO, NRF24L01_REG_SS_PIN, GPIO_LOW); 
+
+    status = nrf24l01_reg_transfer(cmd); 
+
+    for (uint8_t i = CLEAR; i < len; i++)
+    {
+        data = nrf24l01_reg_transfer((tx != NULL) ? tx[i] : NRF24L01_REG_NOP); 
+
+        if (rx != NULL)
+        {
+            rx[i] = data; 
+        }
+    }
+
+    // The radio acts on the command when it's deselected 
+    while (NRF24L01_REG_SPI->SR & SPI_SR_BSY); 
+    gpio_write(NRF24L01_REG_SS_GPIO, NRF24L01_REG_SS_PIN, GPIO_HIGH); 
+
+    return status; 
+}
+
+
+// Set the radio enable (CE) pin 
+void nrf24l01_reg_ce(gpio_pin_state_t level)
+{
+    gpio_write(NRF24L01_REG_CE_GPIO, NRF24L01_REG_CE_PIN, level); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// SPI 
+
+// Send and receive one byte 
+static uint8_t nrf24l01_reg_transfer(uint8_t data)
+{
+    while (!(NRF24L01_REG_SPI->SR & SPI_SR_TXE)); 
+    NRF24L01_REG_SPI->DR = data; 
+    while (!(NRF24L01_REG_SPI->SR & SPI_SR_RXNE)); 
+    return (uint8_t)NRF24L01_REG_SPI->DR; 
+}
+
+//=======================================================================================
@@ -0,0 +1,246 @@
+/**
+ * @file nrf24l01_rx.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Interrupt driven nRF24L01 receive 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "nrf24l01_rx.h" 
+#include "sys_time.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define NRF24L01_RX_MASK (NRF24L01_RX_SIZE - 1) 
+
+_Static_assert((NRF24L01_RX_SIZE & NRF24L01_RX_MASK) == 0, 
+               "NRF24L01_RX_SIZE must be a power of 2"); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Receive data. The counts are free running and masked to find the ring position. 
+// Payloads from 'tail' to 'head' are unread. 
+typedef struct nrf24l01_rx_data_s
+{
+    nrf24l01_rx_payload_t ring[NRF24L01_RX_SIZE];   // Received payloads 
+    uint32_t head;                          // Payloads added - interrupt only 
+    uint32_t tail;                          // Payloads taken - main loop only 
+    uint8_t scratch[NRF24L01_MAX_PAYLOAD_LEN];      // Payload read with the ring full 
+    uint8_t init;                           // Receive path is initialized 
+    nrf24l01_rx_stats_t stats;              // Receive statistics 
+}
+nrf24l01_rx_data_t; 
+
+static nrf24l01_rx_data_t nrf24l01_rx; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Initialization 
+
+// Initialize the interrupt driven receive path 
+void nrf24l01_rx_init(uint8_t priority)
+{
+    NVIC_DisableIRQ(NRF24L01_RX_IRQN); 
+
+    memset((void *)&nrf24l01_rx, CLEAR, sizeof(nrf24l01_rx)); 
+
+    // The IRQ pin is active low and stays low until the radio's flags are cleared 
+    exti_init(); 
+    exti_config(
+        NRF24L01_RX_GPIO, 
+        NRF24L01_RX_EXTI_PORT, 
+        NRF24L01_RX_PIN, 
+        PUPDR_PU, 
+        NRF24L01_RX_EXTI_LINE, 
+        EXTI_INT_NOT_MASKED, 
+        EXTI_EVENT_MASKED, 
+        EXTI_RISE_TRIG_DISABLE, 
+        EXTI_FALL_TRIG_ENABLE); 
+
+    nrf24l01_rx.init = SET; 
+
+    nvic_config(NRF24L01_RX_IRQN, priority); 
+
+    // Payloads received before now have no edge to start the interrupt 
+    nrf24l01_rx_unlock(); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Main loop functions 
+
+// Take the oldest payload from the ring 
+uint8_t nrf24l01_rx_read(nrf24l01_rx_payload_t *payload)
+{
+    uint32_t tail = nrf24l01_rx.tail; 
+
+    if ((payload == NULL) ||
+        (tail == __atomic_load_n(&nrf24l01_rx.head, __ATOMIC_ACQUIRE)))
+    {
+        return FALSE; 
+    }
+
+    memcpy((void *)payload, (void *)&nrf24l01_rx.ring[tail & NRF24L01_RX_MASK], 
+           sizeof(nrf24l01_rx_payload_t)); 
+
+    // The slot can be written again once the copy is done 
+    __atomic_store_n(&nrf24l01_rx.tail, tail + 1, __ATOMIC_RELEASE); 
+
+    return TRUE; 
+}
+
+
+// Payloads waiting in the ring 
+uint8_t nrf24l01_rx_count(void)
+{
+    return (uint8_t)(__atomic_load_n(&nrf24l01_rx.head, __ATOMIC_ACQUIRE) -
+                     nrf24l01_rx.tail); 
+}
+
+
+// Send a payload with the receive interrupt masked 
+NRF24L01_STATUS nrf24l01_rx_send(const uint8_t *payload)
+{
+    NRF24L01_STATUS status; 
+
+    nrf24l01_rx_lock(); 
+    status = nrf24l01_send_payload((uint8_t *)payload); 
+    nrf24l01_rx_unlock(); 
+
+    return status; 
+}
+
+
+// Mask the receive interrupt 
+void nrf24l01_rx_lock(void)
+{
+    if (nrf24l01_rx.init)
+    {
+        NVIC_DisableIRQ(NRF24L01_RX_IRQN); 
+    }
+}
+
+
+// Unmask the receive interrupt 
+void nrf24l01_rx_unlock(void)
+{
+    if (!nrf24l01_rx.init)
+    {
+        return; 
+    }
+
+    if (gpio_read(NRF24L01_RX_GPIO, NRF24L01_RX_PIN_MASK) == GPIO_LOW)
+    {
+        NVIC_SetPendingIRQ(NRF24L01_RX_IRQN); 
+    }
+
+    NVIC_EnableIRQ(NRF24L01_RX_IRQN); 
+}
+
+
+// Read the receive statistics 
+void nrf24l01_rx_stats(nrf24l01_rx_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return; 
+    }
+
+    nrf24l01_rx_lock(); 
+    *stats = nrf24l01_rx.stats; 
+    nrf24l01_rx_unlock(); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Interrupt handler 
+
+// Interrupt handler hook 
+void nrf24l01_rx_irq_handler(void)
+{
+    nrf24l01_rx_payload_t *slot; 
+    uint64_t time; 
+    uint32_t head, used; 
+    uint8_t pipe, read = CLEAR; 
+
+    if (!nrf24l01_rx.init)
+    {
+        return; 
+    }
+
+    time = sys_time_us(); 
+    head = nrf24l01_rx.head; 
+    nrf24l01_rx.stats.interrupts++; 
+
+    // The FIFO is read until the status shows no payload so a payload that lands while 
+    // the others are read isn't left behind without an edge 
+    while (read < NRF24L01_RX_FIFO_DEPTH)
+    {
+        pipe = (uint8_t)nrf24l01_data_ready_status(); 
+
+        if (pipe > NRF24L01_DP_5)
+        {
+            break; 
+        }
+
+        read++; 
+        used = head - __atomic_load_n(&nrf24l01_rx.tail, __ATOMIC_ACQUIRE); 
+
+        if (used >= NRF24L01_RX_SIZE)
+        {
+            // Still read so the radio's FIFO empties and the IRQ pin is released 
+            nrf24l01_receive_payload(nrf24l01_rx.scratch); 
+            nrf24l01_rx.stats.dropped++; 
+            continue; 
+        }
+
+        slot = &nrf24l01_rx.ring[head & NRF24L01_RX_MASK]; 
+        nrf24l01_receive_payload(slot->data); 
+        slot->time = time; 
+        slot->pipe = pipe; 
+        head++; 
+
+        __atomic_store_n(&nrf24l01_rx.head, head, __ATOMIC_RELEASE); 
+        nrf24l01_rx.stats.received++; 
+
+        if (++used > nrf24l01_rx.stats.used_max)
+        {
+            nrf24l01_rx.stats.used_max = (uint8_t)used; 
+        }
+    }
+
+    if (!read)
+    {
+        nrf24l01_rx.stats.empty++; 
+    }
+    else if (gpio_read(NRF24L01_RX_GPIO, NRF24L01_RX_PIN_MASK) == GPIO_LOW)
+    {
+        // More payloads came in than one pass reads - run again after this return 
+        NVIC_SetPendingIRQ(NRF24L01_RX_IRQN); 
+    }
+}
+
+//=======================================================================================
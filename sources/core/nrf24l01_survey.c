@@ -0,0 +1,342 @@
+/**
+ * @file nrf24l01_survey.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief nRF24L01 RF channel survey 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "nrf24l01_survey.h" 
+#include "nrf24l01_reg.h" 
+#include "sys_time.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Handshake payload bytes 
+#define NRF24L01_SURVEY_TAG_BYTE 0 
+#define NRF24L01_SURVEY_STEP_BYTE 1 
+#define NRF24L01_SURVEY_CH_BYTE 2 
+
+_Static_assert((NRF24L01_SURVEY_CH_MIN <= NRF24L01_SURVEY_CH_MAX) && 
+               (NRF24L01_SURVEY_CH_MAX < NRF24L01_SURVEY_CHANNELS), 
+               "Survey channel range must be within the radio's channels"); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Survey data 
+typedef struct nrf24l01_survey_data_s
+{
+    nrf24l01_survey_t survey;               // Occupancy histogram 
+    uint8_t home;                           // Channel the handshake starts on 
+    uint8_t channel;                        // Responder - channel moved to 
+    uint8_t pending;                        // Responder - moved, no traffic there yet 
+    uint8_t confirmed;                      // Responder - confirmation received 
+    uint64_t moved;                         // Responder - time of the last step (us) 
+}
+nrf24l01_survey_data_t; 
+
+static nrf24l01_survey_data_t nrf24l01_survey; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+/**
+ * @brief Change the radio's channel 
+ * 
+ * @param channel : channel 
+ */
+static void nrf24l01_survey_channel(uint8_t channel); 
+
+
+/**
+ * @brief Check if the link can move to a channel 
+ * 
+ * @param channel : channel 
+ * @return uint8_t : TRUE if within NRF24L01_SURVEY_CH_MIN - NRF24L01_SURVEY_CH_MAX 
+ */
+static uint8_t nrf24l01_survey_allowed(uint8_t channel); 
+
+
+/**
+ * @brief Send a handshake payload until it's acknowledged 
+ * 
+ * @param payload : payload 
+ * @return uint8_t : TRUE if acknowledged within NRF24L01_SURVEY_TRIES sends 
+ */
+static uint8_t nrf24l01_survey_send(const uint8_t *payload); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Survey 
+
+// Clear the histogram and set the home channel 
+void nrf24l01_survey_init(uint8_t home)
+{
+    memset((void *)&nrf24l01_survey, CLEAR, sizeof(nrf24l01_survey)); 
+    nrf24l01_survey.home = (home > NRF24L01_RF_CH_MAX) ? NRF24L01_RF_CH_MAX : home; 
+}
+
+
+// Listen on every channel once 
+void nrf24l01_survey_sweep(void)
+{
+    uint8_t rf_ch, config; 
+    uint64_t start; 
+
+    nrf24l01_rx_lock(); 
+
+    rf_ch = nrf24l01_reg_read(NRF24L01_REG_RF_CH); 
+    config = nrf24l01_reg_read(NRF24L01_REG_CONFIG); 
+    nrf24l01_reg_write(NRF24L01_REG_CONFIG, config | NRF24L01_REG_PRIM_RX); 
+
+    for (uint8_t channel = CLEAR; channel < NRF24L01_SURVEY_CHANNELS; channel++)
+    {
+        // The power detector needs the radio in receive mode for the dwell time and 
+        // latches when CE goes low 
+        nrf24l01_reg_ce(GPIO_LOW); 
+        nrf24l01_reg_write(NRF24L01_REG_RF_CH, channel); 
+        nrf24l01_reg_ce(GPIO_HIGH); 
+
+        start = sys_time_us(); 
+        while ((sys_time_us() - start) < NRF24L01_SURVEY_DWELL_US); 
+        nrf24l01_reg_ce(GPIO_LOW); 
+
+        if (nrf24l01_reg_read(NRF24L01_REG_RPD) & NRF24L01_REG_RPD_SET)
+        {
+            nrf24l01_survey.survey.hits[channel]++; 
+        }
+    }
+
+    // Back to receiving on the original channel 
+    nrf24l01_reg_write(NRF24L01_REG_RF_CH, rf_ch); 
+    nrf24l01_reg_write(NRF24L01_REG_CONFIG, config); 
+    nrf24l01_reg_ce(GPIO_HIGH); 
+
+    nrf24l01_rx_unlock(); 
+
+    if (nrf24l01_survey.survey.sweeps < UINT16_MAX)
+    {
+        nrf24l01_survey.survey.sweeps++; 
+    }
+}
+
+
+// Quietest channel in the histogram 
+uint8_t nrf24l01_survey_best(void)
+{
+    uint32_t score, weight, best_score = UINT32_MAX; 
+    uint8_t best = nrf24l01_survey.home; 
+    int16_t neighbour; 
+
+    // Hits on neighbouring channels count less the further they are. Neighbours outside 
+    // the channels that can be picked still count. 
+    for (int16_t channel = NRF24L01_SURVEY_CH_MIN; channel <= NRF24L01_SURVEY_CH_MAX; 
+         channel++)
+    {
+        score = CLEAR; 
+
+        for (int16_t offset = -NRF24L01_SURVEY_SPREAD; offset <= NRF24L01_SURVEY_SPREAD; 
+             offset++)
+        {
+            neighbour = channel + offset; 
+
+            if ((neighbour >= 0) && (neighbour < NRF24L01_SURVEY_CHANNELS))
+            {
+                weight = (uint32_t)(NRF24L01_SURVEY_SPREAD + 1 -
+                                    ((offset < 0) ? -offset : offset)); 
+                score += nrf24l01_survey.survey.hits[neighbour] * weight; 
+            }
+        }
+
+        if (score < best_score)
+        {
+            best_score = score; 
+            best = (uint8_t)channel; 
+        }
+    }
+
+    return best; 
+}
+
+
+// Copy the histogram 
+void nrf24l01_survey_get(nrf24l01_survey_t *survey)
+{
+    if (survey != NULL)
+    {
+        *survey = nrf24l01_survey.survey; 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Handshake 
+
+// Move both radios to a channel (initiator) 
+uint8_t nrf24l01_survey_propose(uint8_t channel)
+{
+    uint8_t payload[NRF24L01_MAX_PAYLOAD_LEN]; 
+
+    if (!nrf24l01_survey_allowed(channel))
+    {
+        return FALSE; 
+    }
+
+    memset((void *)payload, CLEAR, sizeof(payload)); 
+    payload[NRF24L01_SURVEY_TAG_BYTE] = NRF24L01_SURVEY_TAG; 
+    payload[NRF24L01_SURVEY_STEP_BYTE] = NRF24L01_SURVEY_CHANGE; 
+    payload[NRF24L01_SURVEY_CH_BYTE] = channel; 
+
+    // The responder moves as soon as it has the new channel so the confirmation is sent 
+    // whether or not its ACK made it back 
+    nrf24l01_survey_channel(nrf24l01_survey.home); 
+    nrf24l01_survey_send(payload); 
+
+    nrf24l01_survey_channel(channel); 
+    payload[NRF24L01_SURVEY_STEP_BYTE] = NRF24L01_SURVEY_CONFIRM; 
+
+    // The responder stays once the link carries traffic, so this is now where the 
+    // next handshake starts 
+    if (nrf24l01_survey_send(payload))
+    {
+        nrf24l01_survey.home = channel; 
+        return TRUE; 
+    }
+
+    nrf24l01_survey_channel(nrf24l01_survey.home); 
+    return FALSE; 
+}
+
+
+// Handle a payload taken from the receive ring (responder) 
+uint8_t nrf24l01_survey_accept(const nrf24l01_rx_payload_t *payload)
+{
+    uint8_t channel = payload->data[NRF24L01_SURVEY_CH_BYTE]; 
+
+    // Other traffic means the initiator is on this channel too, so the move is done 
+    // and the next handshake starts here 
+    if (payload->data[NRF24L01_SURVEY_TAG_BYTE] != NRF24L01_SURVEY_TAG)
+    {
+        if (nrf24l01_survey.pending)
+        {
+            nrf24l01_survey.home = nrf24l01_survey.channel; 
+            nrf24l01_survey.pending = CLEAR; 
+        }
+
+        return FALSE; 
+    }
+
+    if (!nrf24l01_survey_allowed(channel))
+    {
+        return FALSE; 
+    }
+
+    switch (payload->data[NRF24L01_SURVEY_STEP_BYTE])
+    {
+        case NRF24L01_SURVEY_CHANGE:
+            // The payload was acknowledged when it arrived so the channel can change now 
+            nrf24l01_survey_channel(channel); 
+            nrf24l01_survey.channel = channel; 
+            nrf24l01_survey.pending = SET; 
+            nrf24l01_survey.confirmed = CLEAR; 
+            nrf24l01_survey.moved = payload->time; 
+            break; 
+
+        case NRF24L01_SURVEY_CONFIRM:
+            // The initiator may not have seen the ACK so wait for traffic before staying 
+            if (nrf24l01_survey.pending)
+            {
+                nrf24l01_survey.confirmed = SET; 
+                nrf24l01_survey.moved = payload->time; 
+            }
+            break; 
+
+        default:
+            return FALSE; 
+    }
+
+    return TRUE; 
+}
+
+
+// Go home if the confirmation or the traffic after it is late (responder) 
+uint8_t nrf24l01_survey_update(void)
+{
+    uint64_t timeout = nrf24l01_survey.confirmed ? 
+                       NRF24L01_SURVEY_TRAFFIC_US : NRF24L01_SURVEY_CONFIRM_US; 
+
+    if (nrf24l01_survey.pending && (sys_time_since(nrf24l01_survey.moved) >= timeout))
+    {
+        nrf24l01_survey.pending = CLEAR; 
+        nrf24l01_survey.confirmed = CLEAR; 
+        nrf24l01_survey_channel(nrf24l01_survey.home); 
+        return TRUE; 
+    }
+
+    return FALSE; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helpers 
+
+// Change the radio's channel 
+static void nrf24l01_survey_channel(uint8_t channel)
+{
+    nrf24l01_rx_lock(); 
+    nrf24l01_set_rf_ch(channel); 
+    nrf24l01_rf_ch_write(); 
+    nrf24l01_rx_unlock(); 
+}
+
+
+// Check if the link can move to a channel 
+static uint8_t nrf24l01_survey_allowed(uint8_t channel)
+{
+    // Unsigned wrap covers channels below the minimum 
+    return (uint8_t)(channel - NRF24L01_SURVEY_CH_MIN) <= 
+           (NRF24L01_SURVEY_CH_MAX - NRF24L01_SURVEY_CH_MIN); 
+}
+
+
+// Send a handshake payload until it's acknowledged 
+static uint8_t nrf24l01_survey_send(const uint8_t *payload)
+{
+    for (uint8_t i = CLEAR; i < NRF24L01_SURVEY_TRIES; i++)
+    {
+        if (nrf24l01_rx_send(payload) == NRF24L01_OK)
+        {
+            return TRUE; 
+        }
+    }
+
+    return FALSE; 
+}
+
+//=======================================================================================
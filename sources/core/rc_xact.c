@@ -0,0 +1,332 @@
+/**
+ * @file rc_xact.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Radio request/response transaction engine 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "rc_xact.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Send the request of the transaction in flight and start its timeout 
+ * 
+ * @param engine : engine 
+ */
+static void rc_xact_send(rc_xact_engine_t *engine); 
+
+
+/**
+ * @brief Start the next queued transaction if none is in flight 
+ * 
+ * @param engine : engine 
+ */
+static void rc_xact_next(rc_xact_engine_t *engine); 
+
+
+/**
+ * @brief Take a transaction out of the queue and call its callback 
+ * 
+ * @param engine : engine 
+ * @param xact : transaction 
+ * @param result : transaction result 
+ * @param response : response payload (NULL for none) 
+ * @return uint8_t : TRUE if the transaction was in the engine's queue 
+ */
+static uint8_t rc_xact_finish(
+    rc_xact_engine_t *engine, 
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response); 
+
+
+/**
+ * @brief Check if a payload answers a transaction 
+ * 
+ * @param xact : transaction 
+ * @param payload : received payload 
+ * @return uint8_t : TRUE if the payload is the expected response 
+ */
+static uint8_t rc_xact_match(
+    const rc_xact_t *xact, 
+    const uint8_t *payload); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+// Initialize an engine 
+void rc_xact_init(
+    rc_xact_engine_t *engine, 
+    const rc_xact_link_t *link, 
+    rc_xact_receive_t receive, 
+    uint32_t timeout, 
+    uint8_t attempts)
+{
+    rc_xact_t *xact = engine->head, *next; 
+
+    if (xact != NULL)
+    {
+        twheel_stop(&engine->timer); 
+    }
+
+    memset((void *)engine, CLEAR, sizeof(rc_xact_engine_t)); 
+    engine->link = *link; 
+    engine->receive = receive; 
+    engine->timeout = timeout; 
+    engine->attempts = attempts ? attempts : 1; 
+
+    // Transactions still queued are cancelled so they aren't left busy. This is done 
+    // after the reset so a callback can request them again on the new engine. 
+    for (; xact != NULL; xact = next)
+    {
+        next = xact->next; 
+        xact->next = NULL; 
+        xact->state = RC_XACT_IDLE; 
+
+        if (xact->callback != NULL)
+        {
+            xact->callback(xact, RC_XACT_CANCELLED, NULL); 
+        }
+    }
+}
+
+
+// Request a transaction 
+uint8_t rc_xact_request(
+    rc_xact_engine_t *engine, 
+    rc_xact_t *xact, 
+    const void *request, 
+    uint8_t request_len, 
+    const void *response, 
+    uint8_t response_len, 
+    rc_xact_callback_t callback, 
+    void *arg)
+{
+    if (rc_xact_busy(xact))
+    {
+        return FALSE; 
+    }
+
+    if (request_len > RC_XACT_PAYLOAD_LEN)
+    {
+        request_len = RC_XACT_PAYLOAD_LEN; 
+    }
+
+    memcpy((void *)xact->request, request, request_len); 
+    memset((void *)&xact->request[request_len], CLEAR, RC_XACT_PAYLOAD_LEN - request_len); 
+    xact->response = (const uint8_t *)response; 
+    xact->response_len =
+        (response_len > RC_XACT_PAYLOAD_LEN) ? RC_XACT_PAYLOAD_LEN : response_len; 
+    xact->attempts = CLEAR; 
+    xact->callback = callback; 
+    xact->arg = arg; 
+    xact->next = NULL; 
+    xact->state = RC_XACT_QUEUED; 
+
+    if (engine->tail == NULL)
+    {
+        engine->head = xact; 
+    }
+    else
+    {
+        engine->tail->next = xact; 
+    }
+
+    engine->tail = xact; 
+    rc_xact_next(engine); 
+
+    return TRUE; 
+}
+
+
+// Cancel a transaction 
+void rc_xact_cancel(
+    rc_xact_engine_t *engine, 
+    rc_xact_t *xact)
+{
+    // A transaction requested on another engine is left alone 
+    if (!rc_xact_busy(xact) || !rc_xact_finish(engine, xact, RC_XACT_CANCELLED, NULL))
+    {
+        return; 
+    }
+
+    rc_xact_next(engine); 
+}
+
+
+// Run the engine 
+void rc_xact_poll(rc_xact_engine_t *engine)
+{
+    rc_xact_t *xact; 
+
+    // Nothing can be done with a payload while idle without a receive callback, so 
+    // the radio is left alone 
+    if ((engine->head == NULL) && (engine->receive == NULL))
+    {
+        return; 
+    }
+
+    // Read everything the radio has. A payload that answers the transaction in flight 
+    // finishes it and the next one is sent before reading on. 
+    while (engine->link.receive(engine->buff))
+    {
+        xact = engine->head; 
+
+        if ((xact != NULL) && (xact->state == RC_XACT_WAITING) &&
+            rc_xact_match(xact, engine->buff))
+        {
+            engine->stats.completed++; 
+            rc_xact_finish(engine, xact, RC_XACT_OK, engine->buff); 
+            rc_xact_next(engine); 
+        }
+        else
+        {
+            engine->stats.unmatched++; 
+
+            if (engine->receive != NULL)
+            {
+                engine->receive(engine->buff); 
+            }
+        }
+    }
+
+    // No response in time - send again or give up 
+    xact = engine->head; 
+
+    if ((xact != NULL) && twheel_take(&engine->timer))
+    {
+        if (xact->attempts < engine->attempts)
+        {
+            engine->stats.retries++; 
+            rc_xact_send(engine); 
+        }
+        else
+        {
+            engine->stats.timeouts++; 
+            rc_xact_finish(engine, xact, RC_XACT_TIMEOUT, NULL); 
+            rc_xact_next(engine); 
+        }
+    }
+}
+
+
+// Send the request of the transaction in flight and start its timeout 
+static void rc_xact_send(rc_xact_engine_t *engine)
+{
+    rc_xact_t *xact = engine->head; 
+
+    xact->attempts++; 
+    xact->state = RC_XACT_WAITING; 
+
+    if (!engine->link.send(xact->request))
+    {
+        engine->stats.send_fails++; 
+    }
+
+    // The timeout starts after the send so the time the link takes isn't counted 
+    twheel_take(&engine->timer); 
+    twheel_start(&engine->timer, engine->timeout, CLEAR, NULL, NULL); 
+}
+
+
+// Start the next queued transaction if none is in flight 
+static void rc_xact_next(rc_xact_engine_t *engine)
+{
+    rc_xact_t *xact = engine->head; 
+
+    if ((xact != NULL) && (xact->state == RC_XACT_QUEUED))
+    {
+        engine->stats.sent++; 
+        rc_xact_send(engine); 
+    }
+}
+
+
+// Take a transaction out of the queue and call its callback 
+static uint8_t rc_xact_finish(
+    rc_xact_engine_t *engine, 
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response)
+{
+    rc_xact_t *prev = NULL, *link; 
+
+    for (link = engine->head; link != NULL; link = link->next)
+    {
+        if (link == xact)
+        {
+            break; 
+        }
+
+        prev = link; 
+    }
+
+    // Unlinking a transaction that isn't in this queue would join another list to it 
+    if (link == NULL)
+    {
+        return FALSE; 
+    }
+
+    // The transaction in flight has the timeout 
+    if (prev == NULL)
+    {
+        twheel_stop(&engine->timer); 
+        twheel_take(&engine->timer); 
+        engine->head = xact->next; 
+    }
+    else
+    {
+        prev->next = xact->next; 
+    }
+
+    if (engine->tail == xact)
+    {
+        engine->tail = prev; 
+    }
+
+    xact->next = NULL; 
+    xact->state = RC_XACT_IDLE; 
+
+    // Called last so the callback can request the transaction again 
+    if (xact->callback != NULL)
+    {
+        xact->callback(xact, result, response); 
+    }
+
+    return TRUE; 
+}
+
+
+// Check if a payload answers a transaction 
+static uint8_t rc_xact_match(
+    const rc_xact_t *xact, 
+    const uint8_t *payload)
+{
+    if (xact->response == NULL)
+    {
+        return TRUE; 
+    }
+
+    return !memcmp((const void *)payload, (const void *)xact->response, 
+                   xact->response_len); 
+}
+
+//=======================================================================================
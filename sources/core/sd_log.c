@@ -0,0 +1,412 @@
+/**
+ * @file sd_log.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief SD card logging engine 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sd_log.h" 
+#include "sys_time.h" 
+#include "diskio.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SD_LOG_US_PER_S 1000000             // Microseconds per second 
+#define SD_LOG_FA_MODIFIED 0x40             // FIL flag - directory entry out of date (ff.c) 
+#define SD_LOG_FIRST_CLUST 2                // First data cluster number 
+
+_Static_assert(SD_LOG_BUFFS >= 2, "SD_LOG_BUFFS must be 2 or more"); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Logging data. The buffer indexes are free running. Buffers from 'tail' to 'head' are 
+// full and waiting to be written and buffer 'head' is being filled. 
+typedef struct sd_log_data_s
+{
+    uint8_t buff[SD_LOG_BUFFS][SD_LOG_BUFF_SIZE];   // Buffers 
+    uint16_t len[SD_LOG_BUFFS];             // Bytes in each full buffer 
+    volatile uint32_t head;                 // Buffer being filled - producer only 
+    volatile uint32_t tail;                 // Next buffer to write - main loop only 
+    uint16_t fill;                          // Bytes in the buffer being filled 
+    uint16_t limit;                         // Size of the buffer being filled 
+    FIL *file;                              // Log file 
+    uint16_t sync_every;                    // Buffers written between syncs 
+    uint16_t unsynced;                      // Buffers written since the last sync 
+    uint64_t start;                         // Time the log was opened (us) 
+    uint64_t write_time;                    // Time spent writing buffers (us) 
+    sd_log_stats_t stats;                   // Logging statistics 
+
+    // Contiguous file 
+    uint8_t contig;                         // Buffers are written straight to the disk 
+    FSIZE_t size;                           // Space allocated to the file (bytes) 
+    DWORD sector;                           // Next sector to write 
+    DWORD end;                              // First sector past the allocated space 
+}
+sd_log_data_t; 
+
+static sd_log_data_t sd_log; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Clear the buffers and statistics and start logging 
+ * 
+ * @param file : open file 
+ * @param sync_every : buffers written between syncs 
+ */
+static void sd_log_start(
+    FIL *file, 
+    uint16_t sync_every); 
+
+
+/**
+ * @brief Write a buffer to the file 
+ * 
+ * @param index : buffer index (free running) 
+ */
+static void sd_log_write_buff(uint32_t index); 
+
+
+/**
+ * @brief Sync the file 
+ */
+static void sd_log_sync(void); 
+
+
+/**
+ * @brief Bytes written per second since the log was opened 
+ * 
+ * @return uint32_t : write rate (bytes/s) 
+ */
+static uint32_t sd_log_rate(void); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Logging 
+
+// Start logging to a file 
+uint8_t sd_log_open(
+    FIL *file, 
+    uint16_t sync_every)
+{
+    if ((file == NULL) || (sd_log.file != NULL))
+    {
+        return FALSE; 
+    }
+
+    sd_log.contig = CLEAR; 
+    sd_log_start(file, sync_every); 
+
+    return TRUE; 
+}
+
+
+// Start logging to a contiguous file 
+uint8_t sd_log_open_contig(
+    FIL *file, 
+    FSIZE_t size, 
+    uint16_t sync_every)
+{
+#if _USE_EXPAND 
+
+    FATFS *fs; 
+
+    // Buffers are written as whole sectors so the space is too. This keeps the bytes 
+    // logged within the file's size. 
+    size = ((size + SD_LOG_SECTOR - 1) / SD_LOG_SECTOR) * SD_LOG_SECTOR; 
+
+    if ((file == NULL) || (sd_log.file != NULL) || (size == 0) || f_size(file) || 
+        (f_expand(file, size, SET) != FR_OK))
+    {
+        return FALSE; 
+    }
+
+    // The clusters are in one run so the file's sectors follow on from its first one 
+    fs = file->obj.fs; 
+    sd_log.sector = fs->database + 
+                    (DWORD)fs->csize * (file->obj.sclust - SD_LOG_FIRST_CLUST); 
+    sd_log.end = sd_log.sector + (DWORD)(size / SD_LOG_SECTOR); 
+    sd_log.size = size; 
+    sd_log.contig = SET; 
+    sd_log_start(file, sync_every); 
+
+    return TRUE; 
+
+#else   // _USE_EXPAND 
+
+    return FALSE; 
+
+#endif   // _USE_EXPAND 
+}
+
+
+// Append a record 
+uint8_t sd_log_write(
+    const void *data, 
+    uint16_t len)
+{
+    const uint8_t *record = (const uint8_t *)data; 
+    uint32_t head = sd_log.head; 
+    uint8_t *buff = sd_log.buff[head % SD_LOG_BUFFS]; 
+    uint32_t waiting = head - sd_log.tail; 
+    uint16_t room = sd_log.limit - sd_log.fill; 
+
+    if ((sd_log.file == NULL) || (data == NULL))
+    {
+        return FALSE; 
+    }
+
+    // The buffer being filled must be free and, if the record runs past the end of it, 
+    // so must the next one 
+    if ((waiting >= SD_LOG_BUFFS) || (len > SD_LOG_BUFF_SIZE) ||
+        ((len > room) && ((waiting + 1) >= SD_LOG_BUFFS)))
+    {
+        sd_log.stats.dropped++; 
+        sd_log.stats.dropped_bytes += len; 
+        return FALSE; 
+    }
+
+    if (len < room)
+    {
+        memcpy((void *)&buff[sd_log.fill], (void *)record, len); 
+        sd_log.fill += len; 
+    }
+    else
+    {
+        // Fill the buffer, hand it to the main loop and start the next one 
+        memcpy((void *)&buff[sd_log.fill], (void *)record, room); 
+        sd_log.len[head % SD_LOG_BUFFS] = sd_log.limit; 
+        sd_log.head = ++head; 
+
+        buff = sd_log.buff[head % SD_LOG_BUFFS]; 
+        sd_log.fill = len - room; 
+        sd_log.limit = SD_LOG_BUFF_SIZE; 
+        memcpy((void *)buff, (void *)&record[room], sd_log.fill); 
+
+        waiting++; 
+        if (waiting > sd_log.stats.waiting_max)
+        {
+            sd_log.stats.waiting_max = (uint8_t)waiting; 
+        }
+    }
+
+    sd_log.stats.records++; 
+    return TRUE; 
+}
+
+
+// Write the oldest full buffer to the file 
+uint8_t sd_log_service(void)
+{
+    if ((sd_log.file == NULL) || (sd_log.tail == sd_log.head))
+    {
+        return FALSE; 
+    }
+
+    sd_log_write_buff(sd_log.tail); 
+    sd_log.tail++; 
+
+    if (sd_log.sync_every && (++sd_log.unsynced >= sd_log.sync_every))
+    {
+        sd_log_sync(); 
+    }
+
+    return TRUE; 
+}
+
+
+// Write everything left and stop logging 
+uint8_t sd_log_close(void)
+{
+    if (sd_log.file == NULL)
+    {
+        return FALSE; 
+    }
+
+    while (sd_log.tail != sd_log.head)
+    {
+        sd_log_write_buff(sd_log.tail); 
+        sd_log.tail++; 
+    }
+
+    // The partly filled buffer isn't a whole number of sectors so it goes last. A 
+    // contiguous file gets whole sectors with the unused part zeroed. 
+    if (sd_log.fill)
+    {
+        if (sd_log.contig)
+        {
+            memset((void *)&sd_log.buff[sd_log.head % SD_LOG_BUFFS][sd_log.fill], CLEAR, 
+                   SD_LOG_BUFF_SIZE - sd_log.fill); 
+        }
+
+        sd_log.len[sd_log.head % SD_LOG_BUFFS] = sd_log.fill; 
+        sd_log_write_buff(sd_log.head); 
+        sd_log.fill = CLEAR; 
+    }
+
+    // Give the allocated space past the logged data back 
+    if (sd_log.contig)
+    {
+        sd_log.file->obj.objsize = sd_log.size; 
+
+        if ((f_lseek(sd_log.file, sd_log.stats.bytes) != FR_OK) || 
+            (f_truncate(sd_log.file) != FR_OK))
+        {
+            sd_log.stats.errors++; 
+        }
+    }
+
+    sd_log_sync(); 
+    sd_log.stats.rate = sd_log_rate(); 
+    sd_log.file = NULL; 
+
+    return (sd_log.stats.errors == 0); 
+}
+
+
+// Read the logging statistics 
+void sd_log_get_stats(sd_log_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return; 
+    }
+
+    *stats = sd_log.stats; 
+
+    // The rate is fixed when the log is closed 
+    if (sd_log.file != NULL)
+    {
+        stats->rate = sd_log_rate(); 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helpers 
+
+// Clear the buffers and statistics and start logging 
+static void sd_log_start(
+    FIL *file, 
+    uint16_t sync_every)
+{
+    sd_log.head = CLEAR; 
+    sd_log.tail = CLEAR; 
+    sd_log.fill = CLEAR; 
+    sd_log.sync_every = sync_every; 
+    sd_log.unsynced = CLEAR; 
+    memset((void *)&sd_log.stats, CLEAR, sizeof(sd_log.stats)); 
+    sd_log.write_time = CLEAR; 
+
+    // Cut the first buffer short so the writes after it start on a sector boundary 
+    sd_log.limit = SD_LOG_BUFF_SIZE - (uint16_t)(f_tell(file) % SD_LOG_SECTOR); 
+
+    sd_log.start = sys_time_us(); 
+    sd_log.file = file; 
+}
+
+
+// Write a buffer to the file 
+static void sd_log_write_buff(uint32_t index)
+{
+    uint16_t len = sd_log.len[index % SD_LOG_BUFFS]; 
+    uint8_t *buff = sd_log.buff[index % SD_LOG_BUFFS]; 
+    UINT count = (len + SD_LOG_SECTOR - 1) / SD_LOG_SECTOR; 
+    uint64_t start = sys_time_us(); 
+    uint32_t time; 
+    UINT bw = CLEAR; 
+
+    if (sd_log.contig)
+    {
+        // Straight to the file's sectors - no cluster chain or FAT updates. A full file 
+        // drops the buffer. 
+        if (((sd_log.sector + count) <= sd_log.end) && 
+            (disk_write(sd_log.file->obj.fs->drv, buff, sd_log.sector, count) == RES_OK))
+        {
+            sd_log.sector += count; 
+            bw = len; 
+        }
+        else
+        {
+            sd_log.stats.errors++; 
+        }
+    }
+    else if ((f_write(sd_log.file, (void *)buff, len, &bw) != FR_OK) || (bw != len))
+    {
+        sd_log.stats.errors++; 
+    }
+
+    time = (uint32_t)sys_time_since(start); 
+    sd_log.stats.write_max_us = (time > sd_log.stats.write_max_us) ?
+                                time : sd_log.stats.write_max_us; 
+    sd_log.write_time += time; 
+    sd_log.stats.bytes += bw; 
+    sd_log.stats.buffers++; 
+    sd_log.stats.write_avg_us = (uint32_t)(sd_log.write_time / sd_log.stats.buffers); 
+}
+
+
+// Sync the file 
+static void sd_log_sync(void)
+{
+    uint64_t start = sys_time_us(); 
+    uint32_t time; 
+
+    // The directory entry of a contiguous file gets the size logged so far. The space 
+    // past it stays allocated to the file until it's closed. 
+    if (sd_log.contig)
+    {
+        sd_log.file->obj.objsize = sd_log.stats.bytes; 
+        sd_log.file->flag |= SD_LOG_FA_MODIFIED; 
+    }
+
+    if (f_sync(sd_log.file) != FR_OK)
+    {
+        sd_log.stats.errors++; 
+    }
+
+    time = (uint32_t)sys_time_since(start); 
+    sd_log.stats.sync_max_us = (time > sd_log.stats.sync_max_us) ?
+                               time : sd_log.stats.sync_max_us; 
+    sd_log.stats.syncs++; 
+    sd_log.unsynced = CLEAR; 
+}
+
+
+
+// Bytes written per second since the log was opened 
+static uint32_t sd_log_rate(void)
+{
+    uint64_t elapsed = sys_time_since(sd_log.start); 
+    uint64_t bytes = sd_log.stats.bytes; 
+
+    return elapsed ? (uint32_t)((bytes * SD_LOG_US_PER_S) / elapsed) : CLEAR; 
+}
+
+//=======================================================================================
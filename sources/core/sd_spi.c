@@ -0,0 +1,1004 @@
+/**
+ * @file sd_spi.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief SD card SPI block driver with DMA data transfers 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sd_spi.h" 
+#include "sys_time.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Commands 
+#define SD_SPI_CMD0 0                       // GO_IDLE_STATE 
+#define SD_SPI_CMD1 1                       // SEND_OP_COND (MMC) 
+#define SD_SPI_CMD8 8                       // SEND_IF_COND 
+#define SD_SPI_CMD9 9                       // SEND_CSD 
+#define SD_SPI_CMD12 12                     // STOP_TRANSMISSION 
+#define SD_SPI_CMD16 16                     // SET_BLOCKLEN 
+#define SD_SPI_CMD17 17                     // READ_SINGLE_BLOCK 
+#define SD_SPI_CMD18 18                     // READ_MULTIPLE_BLOCK 
+#define SD_SPI_CMD24 24                     // WRITE_BLOCK 
+#define SD_SPI_CMD25 25                     // WRITE_MULTIPLE_BLOCK 
+#define SD_SPI_CMD55 55                     // APP_CMD 
+#define SD_SPI_CMD58 58                     // READ_OCR 
+#define SD_SPI_ACMD 0x80                    // Application command (sent after CMD55) 
+#define SD_SPI_ACMD23 (SD_SPI_ACMD | 23)    // SET_WR_BLK_ERASE_COUNT 
+#define SD_SPI_ACMD41 (SD_SPI_ACMD | 41)    // SD_SEND_OP_COND 
+
+// Command frame 
+#define SD_SPI_CMD_START 0x40               // Start and transmission bits 
+#define SD_SPI_CMD_MASK 0x3F                // Command index bits 
+#define SD_SPI_CMD0_CRC 0x95                // CMD0 CRC and stop bit 
+#define SD_SPI_CMD8_CRC 0x87                // CMD8 CRC and stop bit (argument below) 
+#define SD_SPI_CRC_OFF 0x01                 // Stop bit - CRC is off in SPI mode 
+#define SD_SPI_CMD8_ARG 0x1AA               // 2.7-3.6 V and check pattern 
+#define SD_SPI_ACMD41_HCS 0x40000000        // Host supports block addressed cards 
+#define SD_SPI_OCR_CCS 0x40                 // OCR first byte - card is block addressed 
+
+// Responses and tokens 
+#define SD_SPI_R1_READY 0x00                // Command accepted 
+#define SD_SPI_R1_IDLE 0x01                 // In the idle state (initializing) 
+#define SD_SPI_R1_NONE 0x80                 // Start bit not seen - no response 
+#define SD_SPI_R1_TRIES 10                  // Bytes read while waiting for a response 
+#define SD_SPI_R7_LEN 4                     // R3 and R7 bytes after R1 
+#define SD_SPI_R7_VHS 2                     // R7 voltage accepted byte 
+#define SD_SPI_R7_CHECK 3                   // R7 check pattern byte 
+#define SD_SPI_TOKEN_START 0xFE             // Read data and single block write data 
+#define SD_SPI_TOKEN_MULTI 0xFC             // Multi-block write data 
+#define SD_SPI_TOKEN_STOP 0xFD              // End of a multi-block write 
+#define SD_SPI_DATA_RESP_MASK 0x1F          // Data response bits 
+#define SD_SPI_DATA_ACCEPTED 0x05           // Data response - accepted 
+#define SD_SPI_IDLE_BYTE 0xFF               // MOSI while reading, MISO while ready 
+#define SD_SPI_POWER_UP_BYTES 10            // 80 clocks deselected after power up 
+#define SD_SPI_CRC_LEN 2                    // Data block CRC bytes 
+#define SD_SPI_CSD_LEN 16                   // CSD register bytes 
+
+// CSD register 
+#define SD_SPI_CSD_V2 1                     // CSD structure - version 2 (SDHC/SDXC) 
+#define SD_SPI_CSD_V2_SHIFT 10              // Version 2 - (C_SIZE + 1) * 1024 sectors 
+#define SD_SPI_SECTOR_SHIFT 9               // Bytes per sector as a power of 2 
+
+// DMA stream flags 
+#define SD_SPI_RX_FLAGS (DMA_LIFCR_CTCIF3 | DMA_LIFCR_CHTIF3 | DMA_LIFCR_CTEIF3 |  \
+                         DMA_LIFCR_CDMEIF3 | DMA_LIFCR_CFEIF3)
+#define SD_SPI_TX_FLAGS (DMA_HIFCR_CTCIF4 | DMA_HIFCR_CHTIF4 | DMA_HIFCR_CTEIF4 |  \
+                         DMA_HIFCR_CDMEIF4 | DMA_HIFCR_CFEIF4)
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Driver data 
+typedef struct sd_spi_data_s
+{
+    sd_spi_card_t card;                     // Card type 
+    uint32_t sectors;                       // Card size (sectors) 
+    uint8_t dma;                            // Data blocks are moved by the DMA 
+    void (*idle)(void);                     // Called while waiting 
+    uint8_t fill;                           // Sent by the TX stream during reads 
+    uint8_t sink;                           // Received by the RX stream during writes 
+    sd_spi_stats_t stats;                   // Driver statistics 
+}
+sd_spi_data_t; 
+
+static sd_spi_data_t sd_spi; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Prototypes 
+
+/**
+ * @brief Set up the SPI RX and TX DMA streams 
+ */
+static void sd_spi_dma_init(void); 
+
+
+/**
+ * @brief Change the SPI clock 
+ * 
+ * @param br : baud rate divider (fPCLK / 2^(br + 1)) 
+ */
+static void sd_spi_clock(uint8_t br); 
+
+
+/**
+ * @brief Find the card type and bring the card out of the idle state 
+ * 
+ * @return sd_spi_card_t : card type (SD_SPI_CT_NONE if no card answered) 
+ */
+static sd_spi_card_t sd_spi_identify(void); 
+
+
+/**
+ * @brief Read the card size from its CSD register 
+ * 
+ * @return uint32_t : number of sectors (0 if the CSD couldn't be read) 
+ */
+static uint32_t sd_spi_read_csd(void); 
+
+
+/**
+ * @brief Send a command 
+ * 
+ * @details Application commands (SD_SPI_ACMD) are sent after CMD55. The card is left 
+ *          selected. 
+ * 
+ * @param cmd : command index 
+ * @param arg : argument 
+ * @return uint8_t : R1 response (SD_SPI_IDLE_BYTE if the card stayed busy) 
+ */
+static uint8_t sd_spi_cmd(
+    uint8_t cmd, 
+    uint32_t arg); 
+
+
+/**
+ * @brief Status of a command that wasn't accepted 
+ * 
+ * @param r1 : R1 response 
+ * @return sd_spi_status_t : SD_SPI_TIMEOUT if the card didn't answer 
+ */
+static sd_spi_status_t sd_spi_cmd_status(uint8_t r1); 
+
+
+/**
+ * @brief Receive a data block 
+ * 
+ * @param buff : buffer for the block 
+ * @param len : block size (bytes) 
+ * @return sd_spi_status_t : SD_SPI_OK if the block was received 
+ */
+static sd_spi_status_t sd_spi_rx_block(
+    uint8_t *buff, 
+    uint16_t len); 
+
+
+/**
+ * @brief Send a data block 
+ * 
+ * @param buff : SD_SPI_SECTOR bytes (not used with the stop token) 
+ * @param token : data token or SD_SPI_TOKEN_STOP 
+ * @return sd_spi_status_t : SD_SPI_OK if the card accepted the block 
+ */
+static sd_spi_status_t sd_spi_tx_block(
+    const uint8_t *buff, 
+    uint8_t token); 
+
+
+/**
+ * @brief Move a data block 
+ * 
+ * @param rx : buffer for the received bytes (NULL to throw them away) 
+ * @param tx : bytes to send (NULL to send SD_SPI_IDLE_BYTE) 
+ * @param len : number of bytes 
+ */
+static void sd_spi_data(
+    uint8_t *rx, 
+    const uint8_t *tx, 
+    uint16_t len); 
+
+
+/**
+ * @brief Select the card and wait for it to be ready 
+ * 
+ * @return uint8_t : TRUE if the card is ready 
+ */
+static uint8_t sd_spi_select(void); 
+
+
+/**
+ * @brief Deselect the card 
+ */
+static void sd_spi_deselect(void); 
+
+
+/**
+ * @brief Wait for the card to stop holding MISO low (busy) 
+ * 
+ * @return uint8_t : TRUE if the card is ready 
+ */
+static uint8_t sd_spi_ready(void); 
+
+
+/**
+ * @brief Send and receive one byte 
+ * 
+ * @param data : byte to send 
+ * @return uint8_t : byte received 
+ */
+static uint8_t sd_spi_transfer(uint8_t data); 
+
+
+/**
+ * @brief Count a failed read or write 
+ * 
+ * @param status : result 
+ * @return sd_spi_status_t : result 
+ */
+static sd_spi_status_t sd_spi_result(sd_spi_status_t status); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Block access 
+
+// Initialize the card 
+sd_spi_status_t sd_spi_init(void)
+{
+    memset((void *)&sd_spi.stats, CLEAR, sizeof(sd_spi.stats)); 
+    sd_spi.card = SD_SPI_CT_NONE; 
+    sd_spi.sectors = CLEAR; 
+    sd_spi.dma = SET; 
+    sd_spi.fill = SD_SPI_IDLE_BYTE; 
+
+    sd_spi_dma_init(); 
+    sd_spi_clock(SD_SPI_BR_INIT); 
+
+    // The card needs clocks with CS high before it takes commands 
+    gpio_write(SD_SPI_SS_GPIO, SD_SPI_SS_PIN, GPIO_HIGH); 
+
+    for (uint8_t i = CLEAR; i < SD_SPI_POWER_UP_BYTES; i++)
+    {
+        sd_spi_transfer(SD_SPI_IDLE_BYTE); 
+    }
+
+    sd_spi.card = sd_spi_identify(); 
+
+    // Byte addressed cards get a 512 byte block length 
+    if ((sd_spi.card != SD_SPI_CT_NONE) && (sd_spi.card != SD_SPI_CT_SDC2_BLOCK) &&
+        (sd_spi_cmd(SD_SPI_CMD16, SD_SPI_SECTOR) != SD_SPI_R1_READY))
+    {
+        sd_spi.card = SD_SPI_CT_NONE; 
+    }
+
+    if (sd_spi.card != SD_SPI_CT_NONE)
+    {
+        sd_spi.sectors = sd_spi_read_csd(); 
+    }
+
+    sd_spi_deselect(); 
+
+    if (!sd_spi.sectors)
+    {
+        sd_spi.card = SD_SPI_CT_NONE; 
+        return SD_SPI_NOT_READY; 
+    }
+
+    sd_spi_clock(SD_SPI_BR_FAST); 
+
+    return SD_SPI_OK; 
+}
+
+
+// Read sectors 
+sd_spi_status_t sd_spi_read(
+    uint8_t *buff, 
+    uint32_t sector, 
+    uint32_t count)
+{
+    uint8_t cmd = (count == 1) ? SD_SPI_CMD17 : SD_SPI_CMD18; 
+    uint8_t r1; 
+    sd_spi_status_t status; 
+
+    if (sd_spi.card == SD_SPI_CT_NONE)
+    {
+        return SD_SPI_NOT_READY; 
+    }
+
+    if ((buff == NULL) || !count || (sector >= sd_spi.sectors) ||
+        (count > (sd_spi.sectors - sector)))
+    {
+        return SD_SPI_PARAM; 
+    }
+
+    sd_spi.stats.reads++; 
+    r1 = sd_spi_cmd(cmd, (sd_spi.card == SD_SPI_CT_SDC2_BLOCK) ?
+                          sector : (sector << SD_SPI_SECTOR_SHIFT)); 
+
+    if (r1 == SD_SPI_R1_READY)
+    {
+        status = SD_SPI_OK; 
+
+        while (count-- && (status == SD_SPI_OK))
+        {
+            status = sd_spi_rx_block(buff, SD_SPI_SECTOR); 
+            buff += SD_SPI_SECTOR; 
+            sd_spi.stats.sectors_read += (status == SD_SPI_OK); 
+        }
+
+        // Multi-block reads carry on until they're stopped 
+        if (cmd == SD_SPI_CMD18)
+        {
+            sd_spi_cmd(SD_SPI_CMD12, CLEAR); 
+        }
+    }
+    else
+    {
+        status = sd_spi_cmd_status(r1); 
+    }
+
+    sd_spi_deselect(); 
+
+    return sd_spi_result(status); 
+}
+
+
+// Write sectors 
+sd_spi_status_t sd_spi_write(
+    const uint8_t *buff, 
+    uint32_t sector, 
+    uint32_t count)
+{
+    uint32_t addr; 
+    uint8_t r1; 
+    sd_spi_status_t status; 
+
+    if (sd_spi.card == SD_SPI_CT_NONE)
+    {
+        return SD_SPI_NOT_READY; 
+    }
+
+    if ((buff == NULL) || !count || (sector >= sd_spi.sectors) ||
+        (count > (sd_spi.sectors - sector)))
+    {
+        return SD_SPI_PARAM; 
+    }
+
+    sd_spi.stats.writes++; 
+    addr = (sd_spi.card == SD_SPI_CT_SDC2_BLOCK) ? sector : (sector << SD_SPI_SECTOR_SHIFT); 
+
+    if (count == 1)
+    {
+        r1 = sd_spi_cmd(SD_SPI_CMD24, addr); 
+        status = (r1 == SD_SPI_R1_READY) ?
+                 sd_spi_tx_block(buff, SD_SPI_TOKEN_START) : sd_spi_cmd_status(r1); 
+        sd_spi.stats.sectors_written += (status == SD_SPI_OK); 
+    }
+    else
+    {
+        // Let SD cards erase the blocks before the data arrives 
+        if (sd_spi.card != SD_SPI_CT_MMC)
+        {
+            sd_spi_cmd(SD_SPI_ACMD23, count); 
+        }
+
+        r1 = sd_spi_cmd(SD_SPI_CMD25, addr); 
+
+        if (r1 == SD_SPI_R1_READY)
+        {
+            status = SD_SPI_OK; 
+
+            while (count-- && (status == SD_SPI_OK))
+            {
+                status = sd_spi_tx_block(buff, SD_SPI_TOKEN_MULTI); 
+                buff += SD_SPI_SECTOR; 
+                sd_spi.stats.sectors_written += (status == SD_SPI_OK); 
+            }
+
+            // The write is ended even if a block failed 
+            if ((sd_spi_tx_block(NULL, SD_SPI_TOKEN_STOP) != SD_SPI_OK) &&
+                (status == SD_SPI_OK))
+            {
+                status = SD_SPI_TIMEOUT; 
+            }
+        }
+        else
+        {
+            status = sd_spi_cmd_status(r1); 
+        }
+    }
+
+    sd_spi_deselect(); 
+
+    return sd_spi_result(status); 
+}
+
+
+// Wait for the card to finish writing 
+sd_spi_status_t sd_spi_sync(void)
+{
+    sd_spi_status_t status; 
+
+    if (sd_spi.card == SD_SPI_CT_NONE)
+    {
+        return SD_SPI_NOT_READY; 
+    }
+
+    status = sd_spi_select() ? SD_SPI_OK : SD_SPI_TIMEOUT; 
+    sd_spi_deselect(); 
+
+    return sd_spi_result(status); 
+}
+
+
+// Card type 
+sd_spi_card_t sd_spi_get_card_type(void)
+{
+    return sd_spi.card; 
+}
+
+
+// Card size 
+uint32_t sd_spi_get_sectors(void)
+{
+    return sd_spi.sectors; 
+}
+
+
+// Turn the DMA data transfers on or off 
+void sd_spi_set_dma(uint8_t enable)
+{
+    sd_spi.dma = enable ? SET : CLEAR; 
+}
+
+
+// Set the function called while the driver waits 
+void sd_spi_set_idle(void (*idle)(void))
+{
+    sd_spi.idle = idle; 
+}
+
+
+// Read the driver statistics 
+void sd_spi_get_stats(sd_spi_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = sd_spi.stats; 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Card 
+
+// Find the card type and bring the card out of the idle state 
+static sd_spi_card_t sd_spi_identify(void)
+{
+    uint8_t resp[SD_SPI_R7_LEN], cmd; 
+    sd_spi_card_t card; 
+    uint64_t start = sys_time_us(); 
+
+    if (sd_spi_cmd(SD_SPI_CMD0, CLEAR) != SD_SPI_R1_IDLE)
+    {
+        return SD_SPI_CT_NONE; 
+    }
+
+    if (sd_spi_cmd(SD_SPI_CMD8, SD_SPI_CMD8_ARG) == SD_SPI_R1_IDLE)
+    {
+        // SD version 2 - the card must accept the voltage range and echo the pattern 
+        for (uint8_t i = CLEAR; i < SD_SPI_R7_LEN; i++)
+        {
+            resp[i] = sd_spi_transfer(SD_SPI_IDLE_BYTE); 
+        }
+
+        if ((resp[SD_SPI_R7_VHS] != (uint8_t)(SD_SPI_CMD8_ARG >> 8)) ||
+            (resp[SD_SPI_R7_CHECK] != (uint8_t)SD_SPI_CMD8_ARG))
+        {
+            return SD_SPI_CT_NONE; 
+        }
+
+        while (sd_spi_cmd(SD_SPI_ACMD41, SD_SPI_ACMD41_HCS) != SD_SPI_R1_READY)
+        {
+            if (sys_time_since(start) >= SD_SPI_INIT_US)
+            {
+                return SD_SPI_CT_NONE; 
+            }
+        }
+
+        if (sd_spi_cmd(SD_SPI_CMD58, CLEAR) != SD_SPI_R1_READY)
+        {
+            return SD_SPI_CT_NONE; 
+        }
+
+        for (uint8_t i = CLEAR; i < SD_SPI_R7_LEN; i++)
+        {
+            resp[i] = sd_spi_transfer(SD_SPI_IDLE_BYTE); 
+        }
+
+        return (resp[0] & SD_SPI_OCR_CCS) ? SD_SPI_CT_SDC2_BLOCK : SD_SPI_CT_SDC2_BYTE; 
+    }
+
+    // SD version 1 or MMC (doesn't know ACMD41) 
+    if (sd_spi_cmd(SD_SPI_ACMD41, CLEAR) <= SD_SPI_R1_IDLE)
+    {
+        card = SD_SPI_CT_SDC1; 
+        cmd = SD_SPI_ACMD41; 
+    }
+    else
+    {
+        card = SD_SPI_CT_MMC; 
+        cmd = SD_SPI_CMD1; 
+    }
+
+    while (sd_spi_cmd(cmd, CLEAR) != SD_SPI_R1_READY)
+    {
+        if (sys_time_since(start) >= SD_SPI_INIT_US)
+        {
+            return SD_SPI_CT_NONE; 
+        }
+    }
+
+    return card; 
+}
+
+
+// Read the card size from its CSD register 
+static uint32_t sd_spi_read_csd(void)
+{
+    uint8_t csd[SD_SPI_CSD_LEN]; 
+    uint32_t c_size; 
+    uint8_t shift; 
+
+    if ((sd_spi_cmd(SD_SPI_CMD9, CLEAR) != SD_SPI_R1_READY) ||
+        (sd_spi_rx_block(csd, SD_SPI_CSD_LEN) != SD_SPI_OK))
+    {
+        return CLEAR; 
+    }
+
+    if ((csd[0] >> 6) == SD_SPI_CSD_V2)
+    {
+        c_size = ((uint32_t)(csd[7] & 0x3F) << 16) | ((uint32_t)csd[8] << 8) | csd[9]; 
+        return (c_size + 1) << SD_SPI_CSD_V2_SHIFT; 
+    }
+
+    // Version 1 - (C_SIZE + 1) * 2^(C_SIZE_MULT + 2) blocks of 2^READ_BL_LEN bytes 
+    c_size = ((uint32_t)(csd[6] & 0x03) << 10) | ((uint32_t)csd[7] << 2) | (csd[8] >> 6); 
+    shift = (csd[5] & 0x0F) + (((csd[9] & 0x03) << 1) | (csd[10] >> 7)) + 2; 
+
+    return (c_size + 1) << (shift - SD_SPI_SECTOR_SHIFT); 
+}
+
+
+// Send a command 
+static uint8_t sd_spi_cmd(
+    uint8_t cmd, 
+    uint32_t arg)
+{
+    uint8_t r1 = SD_SPI_IDLE_BYTE, crc; 
+
+    if (cmd & SD_SPI_ACMD)
+    {
+        cmd &= (uint8_t)~SD_SPI_ACMD; 
+        r1 = sd_spi_cmd(SD_SPI_CMD55, CLEAR); 
+
+        if (r1 > SD_SPI_R1_IDLE)
+        {
+            return r1; 
+        }
+    }
+
+    // A stop command goes in the middle of a read so the card is already selected 
+    if (cmd != SD_SPI_CMD12)
+    {
+        sd_spi_deselect(); 
+
+        if (!sd_spi_select())
+        {
+            return SD_SPI_IDLE_BYTE; 
+        }
+    }
+
+    crc = (cmd == SD_SPI_CMD0) ? SD_SPI_CMD0_CRC :
+          (cmd == SD_SPI_CMD8) ? SD_SPI_CMD8_CRC : SD_SPI_CRC_OFF; 
+
+    sd_spi_transfer(SD_SPI_CMD_START | (cmd & SD_SPI_CMD_MASK)); 
+    sd_spi_transfer((uint8_t)(arg >> 24)); 
+    sd_spi_transfer((uint8_t)(arg >> 16)); 
+    sd_spi_transfer((uint8_t)(arg >> 8)); 
+    sd_spi_transfer((uint8_t)arg); 
+    sd_spi_transfer(crc); 
+
+    // The byte after a stop command is filler 
+    if (cmd == SD_SPI_CMD12)
+    {
+        sd_spi_transfer(SD_SPI_IDLE_BYTE); 
+    }
+
+    for (uint8_t i = CLEAR; i < SD_SPI_R1_TRIES; i++)
+    {
+        r1 = sd_spi_transfer(SD_SPI_IDLE_BYTE); 
+
+        if (!(r1 & SD_SPI_R1_NONE))
+        {
+            break; 
+        }
+    }
+
+    return r1; 
+}
+
+
+// Status of a command that wasn't accepted 
+static sd_spi_status_t sd_spi_cmd_status(uint8_t r1)
+{
+    return (r1 & SD_SPI_R1_NONE) ? SD_SPI_TIMEOUT : SD_SPI_ERROR; 
+}
+
+
+// Receive a data block 
+static sd_spi_status_t sd_spi_rx_block(
+    uint8_t *buff, 
+    uint16_t len)
+{
+    uint64_t start = sys_time_us(); 
+    uint8_t token; 
+
+    while ((token = sd_spi_transfer(SD_SPI_IDLE_BYTE)) == SD_SPI_IDLE_BYTE)
+    {
+        if (sys_time_since(start) >= SD_SPI_TOKEN_US)
+        {
+            return SD_SPI_TIMEOUT; 
+        }
+
+        if (sd_spi.idle != NULL)
+        {
+            sd_spi.idle(); 
+        }
+    }
+
+    if (token != SD_SPI_TOKEN_START)
+    {
+        return SD_SPI_ERROR; 
+    }
+
+    sd_spi_data(buff, NULL, len); 
+    sd_spi_data(NULL, NULL, SD_SPI_CRC_LEN); 
+
+    return SD_SPI_OK; 
+}
+
+
+// Send a data block 
+static sd_spi_status_t sd_spi_tx_block(
+    const uint8_t *buff, 
+    uint8_t token)
+{
+    uint8_t resp; 
+
+    // The card is busy with the block before this one 
+    if (!sd_spi_ready())
+    {
+        return SD_SPI_TIMEOUT; 
+    }
+
+    sd_spi_transfer(token); 
+
+    if (token == SD_SPI_TOKEN_STOP)
+    {
+        return SD_SPI_OK; 
+    }
+
+    sd_spi_data(NULL, buff, SD_SPI_SECTOR); 
+    sd_spi_data(NULL, NULL, SD_SPI_CRC_LEN); 
+    resp = sd_spi_transfer(SD_SPI_IDLE_BYTE); 
+
+    return ((resp & SD_SPI_DATA_RESP_MASK) == SD_SPI_DATA_ACCEPTED) ?
+           SD_SPI_OK : SD_SPI_ERROR; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// SPI and DMA 
+
+// Set up the SPI RX and TX DMA streams 
+static void sd_spi_dma_init(void)
+{
+    // RX has the higher priority so a received byte is never overwritten 
+    dma_stream_init(
+        SD_SPI_DMA, 
+        SD_SPI_RX_STREAM, 
+        SD_SPI_CHNL, 
+        DMA_DIR_PM, 
+        DMA_CM_DISABLE, 
+        DMA_PRIOR_VHI, 
+        DMA_DBM_DISABLE, 
+        DMA_ADDR_INCREMENT, 
+        DMA_ADDR_FIXED, 
+        DMA_DATA_SIZE_BYTE, 
+        DMA_DATA_SIZE_BYTE); 
+
+    dma_stream_init(
+        SD_SPI_DMA, 
+        SD_SPI_TX_STREAM, 
+        SD_SPI_CHNL, 
+        DMA_DIR_MP, 
+        DMA_CM_DISABLE, 
+        DMA_PRIOR_LOW, 
+        DMA_DBM_DISABLE, 
+        DMA_ADDR_INCREMENT, 
+        DMA_ADDR_FIXED, 
+        DMA_DATA_SIZE_BYTE, 
+        DMA_DATA_SIZE_BYTE); 
+
+    dma_stream_config(
+        SD_SPI_RX_STREAM, 
+        (uint32_t)(&SD_SPI_SPI->DR), 
+        (uint32_t)(uintptr_t)&sd_spi.sink, 
+        (uint32_t)NULL, 
+        (uint16_t)CLEAR); 
+
+    dma_stream_config(
+        SD_SPI_TX_STREAM, 
+        (uint32_t)(&SD_SPI_SPI->DR), 
+        (uint32_t)(uintptr_t)&sd_spi.fill, 
+        (uint32_t)NULL, 
+        (uint16_t)CLEAR); 
+}
+
+
+// Change the SPI clock 
+static void sd_spi_clock(uint8_t br)
+{
+    while (SD_SPI_SPI->SR & SPI_SR_BSY); 
+
+    SD_SPI_SPI->CR1 &= ~SPI_CR1_SPE; 
+    SD_SPI_SPI->CR1 = (SD_SPI_SPI->CR1 & ~SPI_CR1_BR) |
+                      (((uint32_t)br << SPI_CR1_BR_Pos) & SPI_CR1_BR); 
+    SD_SPI_SPI->CR1 |= SPI_CR1_SPE; 
+}
+
+
+// Move a data block 
+static void sd_spi_data(
+    uint8_t *rx, 
+    const uint8_t *tx, 
+    uint16_t len)
+{
+    uint8_t data; 
+
+    // Short transfers aren't worth setting up the DMA for 
+    if (!sd_spi.dma || (len < SD_SPI_SECTOR))
+    {
+        for (uint16_t i = CLEAR; i < len; i++)
+        {
+            data = sd_spi_transfer((tx != NULL) ? tx[i] : SD_SPI_IDLE_BYTE); 
+
+            if (rx != NULL)
+            {
+                rx[i] = data; 
+            }
+        }
+
+        return; 
+    }
+
+    // Buffers that aren't given use a fixed byte so the address doesn't move 
+    SD_SPI_DMA->LIFCR = SD_SPI_RX_FLAGS; 
+    SD_SPI_DMA->HIFCR = SD_SPI_TX_FLAGS; 
+
+    SD_SPI_RX_STREAM->M0AR = (rx != NULL) ? (uint32_t)(uintptr_t)rx :
+                                            (uint32_t)(uintptr_t)&sd_spi.sink; 
+    SD_SPI_RX_STREAM->CR = (rx != NULL) ? (SD_SPI_RX_STREAM->CR | DMA_SxCR_MINC) :
+                                          (SD_SPI_RX_STREAM->CR & ~DMA_SxCR_MINC); 
+    SD_SPI_RX_STREAM->NDTR = len; 
+
+    SD_SPI_TX_STREAM->M0AR = (tx != NULL) ? (uint32_t)(uintptr_t)tx :
+                                            (uint32_t)(uintptr_t)&sd_spi.fill; 
+    SD_SPI_TX_STREAM->CR = (tx != NULL) ? (SD_SPI_TX_STREAM->CR | DMA_SxCR_MINC) :
+                                          (SD_SPI_TX_STREAM->CR & ~DMA_SxCR_MINC); 
+    SD_SPI_TX_STREAM->NDTR = len; 
+
+    // RX is ready before the first byte goes out 
+    SD_SPI_RX_STREAM->CR |= DMA_SxCR_EN; 
+    SD_SPI_TX_STREAM->CR |= DMA_SxCR_EN; 
+    SD_SPI_SPI->CR2 |= SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN; 
+
+    // The RX stream finishes once the last byte is in so the bus is idle after it 
+    while (SD_SPI_RX_STREAM->CR & DMA_SxCR_EN)
+    {
+        if (sd_spi.idle != NULL)
+        {
+            sd_spi.idle(); 
+        }
+    }
+
+    SD_SPI_SPI->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN); 
+}
+
+
+// Select the card and wait for it to be ready 
+static uint8_t sd_spi_select(void)
+{
+    gpio_write(SD_SPI_SS_GPIO, SD_SPI_SS_PIN, GPIO_LOW); 
+
+    // A clock with CS low lets the card drive MISO 
+    sd_spi_transfer(SD_SPI_IDLE_BYTE); 
+
+    if (sd_spi_ready())
+    {
+        return TRUE; 
+    }
+
+    sd_spi_deselect(); 
+    return FALSE; 
+}
+
+
+// Deselect the card 
+static void sd_spi_deselect(void)
+{
+    gpio_write(SD_SPI_SS_GPIO, SD_SPI_SS_PIN, GPIO_HIGH); 
+
+    // A clock with CS high makes the card let go of MISO 
+    sd_spi_transfer(SD_SPI_IDLE_BYTE); 
+}
+
+
+// Wait for the card to stop holding MISO low (busy) 
+static uint8_t sd_spi_ready(void)
+{
+    uint64_t start = sys_time_us(); 
+    uint32_t time; 
+    uint8_t ready; 
+
+    while (!(ready = (sd_spi_transfer(SD_SPI_IDLE_BYTE) == SD_SPI_IDLE_BYTE)) &&
+           (sys_time_since(start) < SD_SPI_BUSY_US))
+    {
+        if (sd_spi.idle != NULL)
+        {
+            sd_spi.idle(); 
+        }
+    }
+
+    time = (uint32_t)sys_time_since(start); 
+    sd_spi.stats.busy_max_us = (time > sd_spi.stats.busy_max_us) ?
+                               time : sd_spi.stats.busy_max_us; 
+
+    return ready; 
+}
+
+
+// Send and receive one byte 
+static uint8_t sd_spi_transfer(uint8_t data)
+{
+    while (!(SD_SPI_SPI->SR & SPI_SR_TXE)); 
+    SD_SPI_SPI->DR = data; 
+    while (!(SD_SPI_SPI->SR & SPI_SR_RXNE)); 
+    return (uint8_t)SD_SPI_SPI->DR; 
+}
+
+
+// Count a failed read or write 
+static sd_spi_status_t sd_spi_result(sd_spi_status_t status)
+{
+    if (status == SD_SPI_TIMEOUT)
+    {
+        sd_spi.stats.timeouts++; 
+    }
+    else if (status != SD_SPI_OK)
+    {
+        sd_spi.stats.errors++; 
+    }
+
+    return status; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// FatFs disk driver 
+
+// Result of a block access as a FatFs result 
+static DRESULT sd_spi_disk_result(sd_spi_status_t status)
+{
+    switch (status)
+    {
+        case SD_SPI_OK: return RES_OK; 
+        case SD_SPI_NOT_READY: return RES_NOTRDY; 
+        case SD_SPI_PARAM: return RES_PARERR; 
+        default: return RES_ERROR; 
+    }
+}
+
+
+static DSTATUS sd_spi_disk_initialize(BYTE pdrv)
+{
+    return (sd_spi_init() == SD_SPI_OK) ? CLEAR : STA_NOINIT; 
+}
+
+
+static DSTATUS sd_spi_disk_status(BYTE pdrv)
+{
+    return (sd_spi.card == SD_SPI_CT_NONE) ? STA_NOINIT : CLEAR; 
+}
+
+
+static DRESULT sd_spi_disk_read(
+    BYTE pdrv, 
+    BYTE *buff, 
+    DWORD sector, 
+    UINT count)
+{
+    return sd_spi_disk_result(sd_spi_read(buff, sector, count)); 
+}
+
+
+#if _USE_WRITE == 1
+
+static DRESULT sd_spi_disk_write(
+    BYTE pdrv, 
+    const BYTE *buff, 
+    DWORD sector, 
+    UINT count)
+{
+    return sd_spi_disk_result(sd_spi_write(buff, sector, count)); 
+}
+
+#endif   // _USE_WRITE 
+
+
+#if _USE_IOCTL == 1
+
+static DRESULT sd_spi_disk_ioctl(
+    BYTE pdrv, 
+    BYTE cmd, 
+    void *buff)
+{
+    if (sd_spi.card == SD_SPI_CT_NONE)
+    {
+        return RES_NOTRDY; 
+    }
+
+    switch (cmd)
+    {
+        case CTRL_SYNC:
+            return sd_spi_disk_result(sd_spi_sync()); 
+
+        case GET_SECTOR_COUNT:
+            *(DWORD *)buff = sd_spi.sectors; 
+            return RES_OK; 
+
+        case GET_SECTOR_SIZE:
+            *(WORD *)buff = SD_SPI_SECTOR; 
+            return RES_OK; 
+
+        default:
+            return RES_PARERR; 
+    }
+}
+
+#endif   // _USE_IOCTL 
+
+
+// FatFs disk driver 
+Diskio_drvTypeDef sd_spi_driver =
+{
+    sd_spi_disk_initialize, 
+    sd_spi_disk_status, 
+    sd_spi_disk_read, 
+#if _USE_WRITE == 1
+    sd_spi_disk_write, 
+#endif   // _USE_WRITE 
+#if _USE_IOCTL == 1
+    sd_spi_disk_ioctl, 
+#endif   // _USE_IOCTL 
+}; 
+
+//=======================================================================================
@@ -16,7 +16,15 @@
 // Includes 
 
 #include "stm32f4xx_it.h" 
+#include "isr_profile.h" 
+#include "uart_tx_queue.h" 
+#include "uart_rx_pipe.h" 
+#include "adc_acq.h" 
+#include "timer_wheel.h" 
+#include "sys_time.h" 
+#include "nrf24l01_rx.h" 
 #include "stm32f4xx_hal.h" 
+#include <stdatomic.h> 
 
 #if FREERTOS_ENABLE 
 #include "stm32f4xx_hal_tim.h" 
@@ -30,14 +38,28 @@
 
 #define __weak __attribute__((weak)) 
 
+#define EVENT_WORD_BITS 32U 
+#define EVENT_WORDS ((EVENT_NUM + EVENT_WORD_BITS - 1U) / EVENT_WORD_BITS) 
+
+// Events are set in interrupts so the event words must not need a lock 
+_Static_assert(ATOMIC_INT_LOCK_FREE == 2, "event words must be lock-free"); 
+_Static_assert(sizeof(unsigned int) * 8U == EVENT_WORD_BITS, "event word size"); 
+
 //=======================================================================================
 
 
 //=======================================================================================
 // Globals 
 
-// Instance of interrupt flag data record 
-int_handle_flags_t handler_flags; 
+// Event words - each holds the pending state of EVENT_WORD_BITS events. The Cortex-M4 
+// can only update 32 bits atomically so the events are split over more than one word. 
+static atomic_uint event_words[EVENT_WORDS]; 
+
+// Event counters - only updated for events with counting enabled 
+static atomic_uint event_count_words[EVENT_WORDS];      // Counting enabled 
+static atomic_uint event_stamp_words[EVENT_WORDS];      // Timestamps enabled 
+static atomic_uint event_counts[EVENT_NUM];             // Interrupts since last take 
+static atomic_uint event_stamps[EVENT_NUM];             // DWT count of last interrupt 
 
 
 // TIM11 HAL timer handler - when FreeRTOS needs SysTick 
@@ -51,11 +73,153 @@ extern TIM_HandleTypeDef htim11;
 //=======================================================================================
 // Initialization 
 
-// Interrupt handler flag initialization 
+// Interrupt handler event initialization 
 void int_handler_init(void)
 {
-    // Clear all flags 
-    memset((void *)&handler_flags, CLEAR, sizeof(int_handle_flags_t)); 
+    // Clear all events 
+    for (uint8_t i = CLEAR; i < EVENT_WORDS; i++)
+    {
+        atomic_store_explicit(&event_words[i], CLEAR, memory_order_relaxed); 
+        atomic_store_explicit(&event_count_words[i], CLEAR, memory_order_relaxed); 
+        atomic_store_explicit(&event_stamp_words[i], CLEAR, memory_order_relaxed); 
+    }
+
+    // Clear the event counters 
+    for (uint8_t i = CLEAR; i < EVENT_NUM; i++)
+    {
+        atomic_store_explicit(&event_counts[i], CLEAR, memory_order_relaxed); 
+        atomic_store_explicit(&event_stamps[i], CLEAR, memory_order_relaxed); 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Events 
+
+// Set an event 
+void event_set_from_isr(event_id_t event)
+{
+    uint8_t word = event / EVENT_WORD_BITS; 
+    unsigned int bit = 1U << (event % EVENT_WORD_BITS); 
+
+    // Count the interrupt before setting the event so the count is up to date when the 
+    // event is taken 
+    if (atomic_load_explicit(&event_count_words[word], memory_order_relaxed) & bit)
+    {
+        if (atomic_load_explicit(&event_stamp_words[word], memory_order_relaxed) & bit)
+        {
+            atomic_store_explicit(
+                &event_stamps[event], DWT->CYCCNT, memory_order_relaxed); 
+        }
+
+        atomic_fetch_add_explicit(&event_counts[event], 1U, memory_order_relaxed); 
+    }
+
+    atomic_fetch_or_explicit(&event_words[word], bit, memory_order_release); 
+}
+
+
+// Take (read and clear) a group of events 
+event_mask_t event_take(event_mask_t mask)
+{
+    event_mask_t events = CLEAR; 
+
+    for (uint8_t i = CLEAR; i < EVENT_WORDS; i++)
+    {
+        unsigned int word_mask = (unsigned int)(mask >> (i * EVENT_WORD_BITS)); 
+
+        if (word_mask)
+        {
+            unsigned int word = atomic_fetch_and_explicit(
+                &event_words[i], ~word_mask, memory_order_acquire); 
+            events |= (event_mask_t)(word & word_mask) << (i * EVENT_WORD_BITS); 
+        }
+    }
+
+    return events; 
+}
+
+
+// Take (read and clear) all events 
+event_mask_t event_take_all(void)
+{
+    event_mask_t events = CLEAR; 
+
+    for (uint8_t i = CLEAR; i < EVENT_WORDS; i++)
+    {
+        unsigned int word = atomic_exchange_explicit(
+            &event_words[i], CLEAR, memory_order_acquire); 
+        events |= (event_mask_t)word << (i * EVENT_WORD_BITS); 
+    }
+
+    return events; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Event counters 
+
+// Count events instead of only flagging them 
+void event_count_enable(
+    event_mask_t events, 
+    uint8_t timestamp)
+{
+    if (timestamp)
+    {
+        // Trace must be enabled for the DWT to count 
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; 
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; 
+    }
+
+    for (uint8_t i = CLEAR; i < EVENT_WORDS; i++)
+    {
+        unsigned int word_mask = (unsigned int)(events >> (i * EVENT_WORD_BITS)); 
+
+        if (timestamp)
+        {
+            atomic_fetch_or_explicit(
+                &event_stamp_words[i], word_mask, memory_order_relaxed); 
+        }
+        else
+        {
+            atomic_fetch_and_explicit(
+                &event_stamp_words[i], ~word_mask, memory_order_relaxed); 
+        }
+
+        atomic_fetch_or_explicit(&event_count_words[i], word_mask, memory_order_relaxed); 
+    }
+}
+
+
+// Stop counting events 
+void event_count_disable(event_mask_t events)
+{
+    for (uint8_t i = CLEAR; i < EVENT_WORDS; i++)
+    {
+        unsigned int word_mask = (unsigned int)(events >> (i * EVENT_WORD_BITS)); 
+        atomic_fetch_and_explicit(
+            &event_count_words[i], ~word_mask, memory_order_relaxed); 
+        atomic_fetch_and_explicit(
+            &event_stamp_words[i], ~word_mask, memory_order_relaxed); 
+    }
+}
+
+
+// Take (read and clear) an event count 
+uint32_t event_count_take(event_id_t event)
+{
+    return atomic_exchange_explicit(&event_counts[event], CLEAR, memory_order_acquire); 
+}
+
+
+// DWT cycle count of the last counted interrupt 
+uint32_t event_count_timestamp(event_id_t event)
+{
+    return atomic_load_explicit(&event_stamps[event], memory_order_relaxed); 
 }
 
 //=======================================================================================
@@ -117,8 +281,12 @@ void PendSV_Handler(void)
 // This function handles System tick timer 
 void SysTick_Handler(void)
 {
+    ISR_PROFILE_ENTER(isr_profile_systick_latency()); 
+
     // HAL timer counter increment 
     HAL_IncTick();
+
+    ISR_PROFILE_EXIT(SysTick_IRQn); 
 }
 
 #endif   // !FREERTOS_ENABLE 
@@ -134,202 +302,256 @@ void SysTick_Handler(void)
 // EXTI Line 0 
 __weak void EXTI0_IRQHandler(void)
 {
-    handler_flags.exti0_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_EXTI0); 
     exti_pr_clear(EXTI_L0); 
+    ISR_PROFILE_EXIT(EXTI0_IRQn); 
 }
 
 
 // EXTI Line 1 
 __weak void EXTI1_IRQHandler(void)
 {
-    handler_flags.exti1_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_EXTI1); 
     exti_pr_clear(EXTI_L1);  
+    ISR_PROFILE_EXIT(EXTI1_IRQn); 
 }
 
 
 // EXTI Line 2 
 __weak void EXTI2_IRQHandler(void)
 {
-    handler_flags.exti2_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_EXTI2); 
     exti_pr_clear(EXTI_L2); 
+    ISR_PROFILE_EXIT(EXTI2_IRQn); 
 }
 
 
 // EXTI Line 3 
 __weak void EXTI3_IRQHandler(void)
 {
-    handler_flags.exti3_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_EXTI3); 
     exti_pr_clear(EXTI_L3); 
+    ISR_PROFILE_EXIT(EXTI3_IRQn); 
 }
 
 
 // EXTI Line 4 
 __weak void EXTI4_IRQHandler(void)
 {
-    handler_flags.exti4_flag = SET_BIT; 
-    exti_pr_clear(EXTI_L4); 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    exti_pr_clear(EXTI_L4);   // First so an edge while the radio is read isn't lost 
+    nrf24l01_rx_irq_handler(); 
+    event_set_from_isr(EVENT_EXTI4); 
+    ISR_PROFILE_EXIT(EXTI4_IRQn); 
 }
 
 
 // EXTI lines 5-9 
 __weak void EXTI9_5_IRQHandler(void)
 {
-    handler_flags.exti5_9_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_EXTI5_9); 
     exti_pr_clear(EXTI_L5 | EXTI_L6 | EXTI_L7 | EXTI_L8 | EXTI_L9); 
+    ISR_PROFILE_EXIT(EXTI9_5_IRQn); 
 }
 
 
 // EXTI lines 10-15 
 __weak void EXTI15_10_IRQHandler(void)
 {
-    handler_flags.exti10_15_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_EXTI10_15); 
     exti_pr_clear(EXTI_L10 | EXTI_L11 | EXTI_L12 | EXTI_L13 | EXTI_L14 | EXTI_L15); 
+    ISR_PROFILE_EXIT(EXTI15_10_IRQn); 
 }
 
 
 // DMA1 Stream 0 
 __weak void DMA1_Stream0_IRQHandler(void)
 {
-    handler_flags.dma1_0_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA1_0); 
     dma_clear_int_flags(DMA1); 
+    ISR_PROFILE_EXIT(DMA1_Stream0_IRQn); 
 }
 
 
 // DMA1 Stream 1 
 __weak void DMA1_Stream1_IRQHandler(void)
 {
-    handler_flags.dma1_1_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA1_1); 
     dma_clear_int_flags(DMA1); 
+    ISR_PROFILE_EXIT(DMA1_Stream1_IRQn); 
 }
 
 
 // DMA1 Stream 2 
 __weak void DMA1_Stream2_IRQHandler(void)
 {
-    handler_flags.dma1_2_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA1_2); 
     dma_clear_int_flags(DMA1); 
+    ISR_PROFILE_EXIT(DMA1_Stream2_IRQn); 
 }
 
 
 // DMA1 Stream 3 
 __weak void DMA1_Stream3_IRQHandler(void)
 {
-    handler_flags.dma1_3_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA1_3); 
     dma_clear_int_flags(DMA1); 
+    ISR_PROFILE_EXIT(DMA1_Stream3_IRQn); 
 }
 
 
 // DMA1 Stream 4 
 __weak void DMA1_Stream4_IRQHandler(void)
 {
-    handler_flags.dma1_4_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA1_4); 
     dma_clear_int_flags(DMA1); 
+    ISR_PROFILE_EXIT(DMA1_Stream4_IRQn); 
 }
 
 
 // DMA1 Stream 5 
 __weak void DMA1_Stream5_IRQHandler(void)
 {
-    handler_flags.dma1_5_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    uart_rxp_irq_handler(); 
+    event_set_from_isr(EVENT_DMA1_5); 
     dma_clear_int_flags(DMA1); 
+    ISR_PROFILE_EXIT(DMA1_Stream5_IRQn); 
 }
 
 
 // DMA1 Stream 6 
 __weak void DMA1_Stream6_IRQHandler(void)
 {
-    handler_flags.dma1_6_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    uart_txq_dma_handler(); 
+    event_set_from_isr(EVENT_DMA1_6); 
     dma_clear_int_flags(DMA1); 
+    ISR_PROFILE_EXIT(DMA1_Stream6_IRQn); 
 }
 
 
 // DMA1 Stream 7 
 __weak void DMA1_Stream7_IRQHandler(void)
 {
-    handler_flags.dma1_7_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA1_7); 
     dma_clear_int_flags(DMA1); 
+    ISR_PROFILE_EXIT(DMA1_Stream7_IRQn); 
 }
 
 
 // DMA2 Stream 0 
 __weak void DMA2_Stream0_IRQHandler(void)
 {
-    handler_flags.dma2_0_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    adc_acq_irq_handler(); 
+    event_set_from_isr(EVENT_DMA2_0); 
     dma_clear_int_flags(DMA2); 
+    ISR_PROFILE_EXIT(DMA2_Stream0_IRQn); 
 }
 
 
 // DMA2 Stream 1 
 __weak void DMA2_Stream1_IRQHandler(void)
 {
-    handler_flags.dma2_1_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA2_1); 
     dma_clear_int_flags(DMA2); 
+    ISR_PROFILE_EXIT(DMA2_Stream1_IRQn); 
 }
 
 
 // DMA2 Stream 2 
 __weak void DMA2_Stream2_IRQHandler(void)
 {
-    handler_flags.dma2_2_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA2_2); 
     dma_clear_int_flags(DMA2); 
+    ISR_PROFILE_EXIT(DMA2_Stream2_IRQn); 
 }
 
 
 // DMA2 Stream 3 
 __weak void DMA2_Stream3_IRQHandler(void)
 {
-    handler_flags.dma2_3_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA2_3); 
     dma_clear_int_flags(DMA2); 
+    ISR_PROFILE_EXIT(DMA2_Stream3_IRQn); 
 }
 
 
 // DMA2 Stream 4 
 __weak void DMA2_Stream4_IRQHandler(void)
 {
-    handler_flags.dma2_4_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA2_4); 
     dma_clear_int_flags(DMA2); 
+    ISR_PROFILE_EXIT(DMA2_Stream4_IRQn); 
 }
 
 
 // DMA2 Stream 5 
 __weak void DMA2_Stream5_IRQHandler(void)
 {
-    handler_flags.dma2_5_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA2_5); 
     dma_clear_int_flags(DMA2); 
+    ISR_PROFILE_EXIT(DMA2_Stream5_IRQn); 
 }
 
 
 // DMA2 Stream 6 
 __weak void DMA2_Stream6_IRQHandler(void)
 {
-    handler_flags.dma2_6_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA2_6); 
     dma_clear_int_flags(DMA2); 
+    ISR_PROFILE_EXIT(DMA2_Stream6_IRQn); 
 }
 
 
 // DMA2 Stream 7 
 __weak void DMA2_Stream7_IRQHandler(void)
 {
-    handler_flags.dma2_7_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_DMA2_7); 
     dma_clear_int_flags(DMA2); 
+    ISR_PROFILE_EXIT(DMA2_Stream7_IRQn); 
 }
 
 
 // Timer 1 break + timer 9 global 
 __weak void TIM1_BRK_TIM9_IRQHandler(void)
 {
-    handler_flags.tim1_brk_tim9_glbl_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(isr_profile_timer_latency(TIM9)); 
+    event_set_from_isr(EVENT_TIM1_BRK_TIM9); 
     tim_uif_clear(TIM1); 
     tim_uif_clear(TIM9); 
+    ISR_PROFILE_EXIT(TIM1_BRK_TIM9_IRQn); 
 }
 
 
 // Timer 1 update + timer 10 global 
 __weak void TIM1_UP_TIM10_IRQHandler(void)
 {
-    handler_flags.tim1_up_tim10_glbl_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(isr_profile_timer_latency(TIM10)); 
+    event_set_from_isr(EVENT_TIM1_UP_TIM10); 
     tim_uif_clear(TIM1); 
     tim_uif_clear(TIM10); 
+    ISR_PROFILE_EXIT(TIM1_UP_TIM10_IRQn); 
 }
 
 #if FREERTOS_ENABLE 
@@ -345,9 +567,11 @@ void TIM1_TRG_COM_TIM11_IRQHandler(void)
 // Timer 1 trigger and communication + timer 11 global interrupts 
 __weak void TIM1_TRG_COM_TIM11_IRQHandler(void)
 {
-    handler_flags.tim1_trg_tim11_glbl_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(isr_profile_timer_latency(TIM11)); 
+    event_set_from_isr(EVENT_TIM1_TRG_TIM11); 
     tim_uif_clear(TIM1); 
     tim_uif_clear(TIM11); 
+    ISR_PROFILE_EXIT(TIM1_TRG_COM_TIM11_IRQn); 
 }
 
 #endif   // FREERTOS_ENABLE 
@@ -355,74 +579,112 @@ __weak void TIM1_TRG_COM_TIM11_IRQHandler(void)
 // Timer 1 capture compare 
 __weak void TIM1_CC_IRQHandler(void)
 {
-    handler_flags.tim1_cc_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(isr_profile_timer_latency(TIM1)); 
+    event_set_from_isr(EVENT_TIM1_CC); 
     tim_uif_clear(TIM1); 
+    ISR_PROFILE_EXIT(TIM1_CC_IRQn); 
 }
 
 
 // Timer 2 
 __weak void TIM2_IRQHandler(void)
 {
-    handler_flags.tim2_glbl_flag = SET_BIT; 
-    tim_uif_clear(TIM2); 
+    ISR_PROFILE_ENTER(isr_profile_timer_latency(TIM2)); 
+    // The system clock's timer flags are cleared by its own hooks 
+    if (sys_time_irq_handler(TIM2))
+    {
+        twheel_irq_handler(); 
+    }
+    else
+    {
+        tim_uif_clear(TIM2); 
+    }
+
+    event_set_from_isr(EVENT_TIM2); 
+    ISR_PROFILE_EXIT(TIM2_IRQn); 
 }
 
 
 // Timer 3
 __weak void TIM3_IRQHandler(void)
 {
-    handler_flags.tim3_glbl_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(isr_profile_timer_latency(TIM3)); 
+    event_set_from_isr(EVENT_TIM3); 
     tim_uif_clear(TIM3); 
+    ISR_PROFILE_EXIT(TIM3_IRQn); 
 }
 
 
 // Timer 4
 __weak void TIM4_IRQHandler(void)
 {
-    handler_flags.tim4_glbl_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(isr_profile_timer_latency(TIM4)); 
+    event_set_from_isr(EVENT_TIM4); 
     tim_uif_clear(TIM4); 
+    ISR_PROFILE_EXIT(TIM4_IRQn); 
 }
 
 
 // Timer 5
 __weak void TIM5_IRQHandler(void)
 {
-    handler_flags.tim5_glbl_flag = SET_BIT; 
-    tim_uif_clear(TIM5); 
+    ISR_PROFILE_ENTER(isr_profile_timer_latency(TIM5)); 
+    // The system clock's timer flags are cleared by its own hooks 
+    if (sys_time_irq_handler(TIM5))
+    {
+        twheel_irq_handler(); 
+    }
+    else
+    {
+        tim_uif_clear(TIM5); 
+    }
+
+    event_set_from_isr(EVENT_TIM5); 
+    ISR_PROFILE_EXIT(TIM5_IRQn); 
 }
 
 
 // ADC1 
 __weak void ADC_IRQHandler(void)
 {
-    handler_flags.adc_flag = SET_BIT;  
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    adc_acq_irq_handler(); 
+    event_set_from_isr(EVENT_ADC);  
+    ISR_PROFILE_EXIT(ADC_IRQn); 
 }
 
 
 // USART1 
 __weak void USART1_IRQHandler(void)
 {
-    handler_flags.usart1_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_USART1); 
     dummy_read(USART1->SR); 
     dummy_read(USART1->DR); 
+    ISR_PROFILE_EXIT(USART1_IRQn); 
 }
 
 
 // USART2 
 __weak void USART2_IRQHandler(void)
 {
-    handler_flags.usart2_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    uart_rxp_irq_handler(); 
+    event_set_from_isr(EVENT_USART2); 
     dummy_read(USART2->SR); 
     dummy_read(USART2->DR); 
+    ISR_PROFILE_EXIT(USART2_IRQn); 
 }
 
 
 // USART6 
 __weak void USART6_IRQHandler(void)
 {
-    handler_flags.usart6_flag = SET_BIT; 
+    ISR_PROFILE_ENTER(ISR_PROFILE_NO_LATENCY); 
+    event_set_from_isr(EVENT_USART6); 
     dummy_read(USART6->SR); 
     dummy_read(USART6->DR); 
+    ISR_PROFILE_EXIT(USART6_IRQn); 
 }
 
 //=======================================================================================
@@ -0,0 +1,247 @@
+/**
+ * @file sys_time.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief System clock 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "sys_time.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define SYS_TIME_CNT_MAX 0xFFFFFFFF         // Free running 32-bit counter 
+#define SYS_TIME_CNT_HALF 0x80000000        // Counts below this just wrapped 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Clock data 
+typedef struct sys_time_s
+{
+    TIM_TypeDef *timer;                     // Microsecond counter 
+    volatile uint32_t high;                 // Upper 32 bits of the time (overflows) 
+    uint32_t cycles_per_us;                 // Core clock cycles per microsecond (0 = off) 
+    uint32_t ref_cycles;                    // Cycle count when the counter ticked ... 
+    uint32_t ref_us;                        // ... over to this value 
+}
+sys_time_t; 
+
+static sys_time_t sys_time; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Line up the cycle counter with the microsecond counter 
+ * 
+ * @details Waits for the microsecond counter to tick over (up to 1 us) and takes the 
+ *          cycle count at that point. 
+ */
+static void sys_time_dwt_init(void); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+// Start the system clock 
+uint8_t sys_time_init(
+    TIM_TypeDef *timer, 
+    uint8_t priority)
+{
+    IRQn_Type irqn; 
+
+    if (timer == TIM2)
+    {
+        RCC->APB1ENR |= RCC_APB1ENR_TIM2EN; 
+        irqn = TIM2_IRQn; 
+    }
+    else if (timer == TIM5)
+    {
+        RCC->APB1ENR |= RCC_APB1ENR_TIM5EN; 
+        irqn = TIM5_IRQn; 
+    }
+    else
+    {
+        return FALSE; 
+    }
+
+    NVIC_DisableIRQ(irqn); 
+    memset((void *)&sys_time, CLEAR, sizeof(sys_time)); 
+
+    // Free running microsecond counter that interrupts when it wraps 
+    timer->CR1 &= ~TIM_CR1_CEN; 
+    timer->DIER = CLEAR; 
+    timer->PSC = (tim_get_pclk_freq(timer) / SYS_TIME_CLK_HZ) - 1; 
+    timer->ARR = SYS_TIME_CNT_MAX; 
+    timer->EGR = TIM_EGR_UG;   // Load the prescaler 
+    timer->SR = CLEAR; 
+    timer->CNT = CLEAR; 
+    timer->DIER = TIM_DIER_UIE; 
+    timer->CR1 |= TIM_CR1_CEN; 
+
+    sys_time.timer = timer; 
+
+#if SYS_TIME_DWT_ENABLE
+    // The cycles in each microsecond only line up if both clocks are the same 
+    if ((rcc_get_hclk_frq() == tim_get_pclk_freq(timer)) &&
+        !(rcc_get_hclk_frq() % SYS_TIME_CLK_HZ))
+    {
+        sys_time_dwt_init(); 
+    }
+#endif   // SYS_TIME_DWT_ENABLE 
+
+    nvic_config(irqn, priority); 
+
+    return TRUE; 
+}
+
+
+// Time since the clock was started 
+uint64_t sys_time_us(void)
+{
+    TIM_TypeDef *timer = sys_time.timer; 
+    uint32_t high, count, status; 
+
+    if (timer == NULL)
+    {
+        return CLEAR; 
+    }
+
+    // The overflow interrupt can only run once in a read so this repeats at most once 
+    do
+    {
+        high = sys_time.high; 
+        count = timer->CNT; 
+        status = timer->SR; 
+    }
+    while (high != sys_time.high); 
+
+    // Overflow not counted yet - its interrupt is pending or masked. A count from before 
+    // the wrap belongs to the old upper half. 
+    if ((status & TIM_SR_UIF) && (count < SYS_TIME_CNT_HALF))
+    {
+        high++; 
+    }
+
+    return ((uint64_t)high << 32) | count; 
+}
+
+
+// Time since the clock was started with sub-microsecond resolution 
+uint64_t sys_time_ns(void)
+{
+#if SYS_TIME_DWT_ENABLE
+    uint64_t us; 
+    uint32_t cycles; 
+    int32_t fraction; 
+
+    if (sys_time.cycles_per_us)
+    {
+        // Cycle count within the same microsecond 
+        do
+        {
+            us = sys_time_us(); 
+            cycles = DWT->CYCCNT; 
+        }
+        while ((uint32_t)us != sys_time.timer->CNT); 
+
+        // Cycles since the microsecond started. Both clocks count the same cycles so the 
+        // cycles since the reference less whole microseconds is the part left over. Only 
+        // the low 32 bits are needed so cycle counter wraps don't matter. 
+        fraction = (int32_t)((cycles - sys_time.ref_cycles) -
+                             (((uint32_t)us - sys_time.ref_us) * sys_time.cycles_per_us)); 
+
+        if (fraction < 0)
+        {
+            fraction = CLEAR; 
+        }
+        else if ((uint32_t)fraction >= sys_time.cycles_per_us)
+        {
+            fraction = (int32_t)sys_time.cycles_per_us - 1; 
+        }
+
+        return (us * SYS_TIME_NS_PER_US) +
+               (((uint32_t)fraction * SYS_TIME_NS_PER_US) / sys_time.cycles_per_us); 
+    }
+#endif   // SYS_TIME_DWT_ENABLE 
+
+    return sys_time_us() * SYS_TIME_NS_PER_US; 
+}
+
+
+// Timer used by the clock 
+TIM_TypeDef *sys_time_timer(void)
+{
+    return sys_time.timer; 
+}
+
+
+// Interrupt handler hook 
+uint8_t sys_time_irq_handler(TIM_TypeDef *timer)
+{
+    if ((timer == NULL) || (timer != sys_time.timer))
+    {
+        return FALSE; 
+    }
+
+    if (timer->SR & TIM_SR_UIF)
+    {
+        // A higher priority interrupt reading the clock between these two steps would 
+        // count the overflow twice 
+        __disable_irq(); 
+        sys_time.high++; 
+        timer->SR = ~TIM_SR_UIF; 
+        __enable_irq(); 
+    }
+
+    return TRUE; 
+}
+
+
+// Line up the cycle counter with the microsecond counter 
+static void sys_time_dwt_init(void)
+{
+    TIM_TypeDef *timer = sys_time.timer; 
+    uint32_t count, cycles; 
+
+    // Trace must be enabled for the DWT to count. The count isn't reset so other users 
+    // (ex. benchmarks) aren't thrown off. 
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; 
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; 
+
+    count = timer->CNT; 
+
+    do
+    {
+        cycles = DWT->CYCCNT; 
+    }
+    while (timer->CNT == count); 
+
+    sys_time.ref_cycles = cycles; 
+    sys_time.ref_us = count + 1; 
+    sys_time.cycles_per_us = rcc_get_hclk_frq() / SYS_TIME_CLK_HZ; 
+}
+
+//=======================================================================================
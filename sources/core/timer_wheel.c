@@ -0,0 +1,601 @@
+/**
+ * @file timer_wheel.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Hierarchical timer wheel 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "timer_wheel.h" 
+#include "sys_time.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define TWHEEL_SLOT_MASK (TWHEEL_SLOTS - 1) 
+#define TWHEEL_SLOT_NONE 0xFFFF             // Timer isn't in a wheel slot 
+
+// Longest time between compare interrupts (ticks). Keeps the compare well under 2^31 
+// counts ahead of the counter so it can't be mistaken for a time in the past. 
+#define TWHEEL_SLEEP_MAX_TICKS (0x3FFFFFFFUL / TWHEEL_TICK_US) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Hardware timer wheel 
+typedef struct twheel_hw_s
+{
+    twheel_t wheel;                         // Timers 
+    TIM_TypeDef *timer;                     // Microsecond counter 
+    IRQn_Type irqn;                         // Timer interrupt 
+    uint32_t now_cnt;                       // Counter value the wheel's next tick is due 
+    volatile uint8_t fired;                 // A timer expired since the last sleep 
+    volatile uint8_t updating;              // The wheel is being advanced (callbacks run) 
+}
+twheel_hw_t; 
+
+static twheel_hw_t twheel_hw; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Put a timer in the slot for its expiry tick 
+ * 
+ * @param wheel : wheel 
+ * @param timer : timer with its expiry tick set 
+ */
+static void twheel_place(
+    twheel_t *wheel, 
+    twheel_timer_t *timer); 
+
+
+/**
+ * @brief Move a slot's timers down to the slots for their expiry ticks 
+ * 
+ * @param wheel : wheel 
+ * @param level : level of the slot 
+ * @param slot : slot 
+ */
+static void twheel_cascade(
+    twheel_t *wheel, 
+    uint8_t level, 
+    uint8_t slot); 
+
+
+/**
+ * @brief Process the next tick 
+ * 
+ * @param wheel : wheel 
+ * @return uint32_t : number of expiries 
+ */
+static uint32_t twheel_tick(twheel_t *wheel); 
+
+
+/**
+ * @brief Advance the hardware wheel to the counter and set the next compare 
+ * 
+ * @details Called in the timer interrupt or with it masked. 
+ */
+static void twheel_hw_update(void); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// List functions 
+
+// Empty a list 
+static inline void twheel_link_init(twheel_link_t *head)
+{
+    head->next = head; 
+    head->prev = head; 
+}
+
+
+// Add a link to the end of a list 
+static inline void twheel_link_add(
+    twheel_link_t *head, 
+    twheel_link_t *link)
+{
+    link->next = head; 
+    link->prev = head->prev; 
+    head->prev->next = link; 
+    head->prev = link; 
+}
+
+
+// Remove a link from its list 
+static inline void twheel_link_remove(twheel_link_t *link)
+{
+    link->prev->next = link->next; 
+    link->next->prev = link->prev; 
+    link->next = link; 
+    link->prev = link; 
+}
+
+
+// Move all links of a list to an empty list 
+static inline void twheel_link_move(
+    twheel_link_t *from, 
+    twheel_link_t *to)
+{
+    if (from->next == from)
+    {
+        twheel_link_init(to); 
+        return; 
+    }
+
+    to->next = from->next; 
+    to->prev = from->prev; 
+    to->next->prev = to; 
+    to->prev->next = to; 
+    twheel_link_init(from); 
+}
+
+
+// Rotate a slot bitmap so 'slot' becomes bit 0 
+static inline uint64_t twheel_rotate(
+    uint64_t used, 
+    uint8_t slot)
+{
+    return slot ? ((used >> slot) | (used << (TWHEEL_SLOTS - slot))) : used; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Wheel functions 
+
+// Initialize a wheel 
+void twheel_init(
+    twheel_t *wheel, 
+    uint32_t now)
+{
+    if (wheel == NULL)
+    {
+        return; 
+    }
+
+    for (uint8_t i = CLEAR; i < TWHEEL_LEVELS; i++)
+    {
+        for (uint8_t j = CLEAR; j < TWHEEL_SLOTS; j++)
+        {
+            twheel_link_init(&wheel->slots[i][j]); 
+        }
+
+        wheel->used[i] = CLEAR; 
+    }
+
+    wheel->now = now; 
+}
+
+
+// Add a timer to a wheel 
+uint8_t twheel_add(
+    twheel_t *wheel, 
+    twheel_timer_t *timer, 
+    uint32_t delay, 
+    uint32_t period)
+{
+    if ((wheel == NULL) || (timer == NULL) ||
+        (delay > TWHEEL_MAX_TICKS) || (period > TWHEEL_MAX_TICKS))
+    {
+        return FALSE; 
+    }
+
+    twheel_remove(wheel, timer); 
+
+    timer->expires = wheel->now + delay; 
+    timer->period = period; 
+    twheel_place(wheel, timer); 
+
+    return TRUE; 
+}
+
+
+// Remove a timer from a wheel 
+void twheel_remove(
+    twheel_t *wheel, 
+    twheel_timer_t *timer)
+{
+    uint8_t level, slot; 
+
+    if ((wheel == NULL) || (timer == NULL) || !timer->active)
+    {
+        return; 
+    }
+
+    twheel_link_remove(&timer->link); 
+    timer->active = FALSE; 
+
+    // Timers being expired are in a list of their own 
+    if (timer->slot == TWHEEL_SLOT_NONE)
+    {
+        return; 
+    }
+
+    level = (uint8_t)(timer->slot >> TWHEEL_SLOT_BITS); 
+    slot = (uint8_t)(timer->slot & TWHEEL_SLOT_MASK); 
+    timer->slot = TWHEEL_SLOT_NONE; 
+
+    if (wheel->slots[level][slot].next == &wheel->slots[level][slot])
+    {
+        wheel->used[level] &= ~((uint64_t)1 << slot); 
+    }
+}
+
+
+// Ticks until the next tick with work to do 
+uint32_t twheel_next(
+    const twheel_t *wheel, 
+    uint32_t limit)
+{
+    uint32_t next = limit, span, start, ticks; 
+    uint64_t used; 
+
+    // Level 0 - the slot of each timer is its expiry tick 
+    used = twheel_rotate(wheel->used[0], (uint8_t)(wheel->now & TWHEEL_SLOT_MASK)); 
+
+    if (used)
+    {
+        next = (uint32_t)__builtin_ctzll(used); 
+    }
+
+    // Upper levels - a slot is cascaded on the first tick of its span 
+    for (uint8_t level = 1; level < TWHEEL_LEVELS; level++)
+    {
+        if (!wheel->used[level])
+        {
+            continue; 
+        }
+
+        span = 1UL << (TWHEEL_SLOT_BITS * level); 
+        start = (wheel->now + span - 1) & ~(span - 1); 
+        used = twheel_rotate(wheel->used[level], 
+                             (uint8_t)((start >> (TWHEEL_SLOT_BITS * level)) &
+                                       TWHEEL_SLOT_MASK)); 
+        ticks = (start - wheel->now) + ((uint32_t)__builtin_ctzll(used) * span); 
+
+        if (ticks < next)
+        {
+            next = ticks; 
+        }
+    }
+
+    return (next < limit) ? next : limit; 
+}
+
+
+// Process a number of ticks 
+uint32_t twheel_advance(
+    twheel_t *wheel, 
+    uint32_t ticks)
+{
+    uint32_t expiries = CLEAR, skip; 
+
+    if (wheel == NULL)
+    {
+        return CLEAR; 
+    }
+
+    while (ticks)
+    {
+        // Jump over ticks with nothing to do 
+        skip = twheel_next(wheel, ticks); 
+        wheel->now += skip; 
+        ticks -= skip; 
+
+        if (ticks)
+        {
+            expiries += twheel_tick(wheel); 
+            ticks--; 
+        }
+    }
+
+    return expiries; 
+}
+
+
+// Put a timer in the slot for its expiry tick 
+static void twheel_place(
+    twheel_t *wheel, 
+    twheel_timer_t *timer)
+{
+    uint32_t delta = timer->expires - wheel->now; 
+    uint8_t level = CLEAR, slot; 
+
+    if ((int32_t)delta < 0)
+    {
+        // Already due - expires on the next tick processed 
+        slot = (uint8_t)(wheel->now & TWHEEL_SLOT_MASK); 
+    }
+    else
+    {
+        while ((level < (TWHEEL_LEVELS - 1)) &&
+               (delta >= (1UL << (TWHEEL_SLOT_BITS * (level + 1)))))
+        {
+            level++; 
+        }
+
+        slot = (uint8_t)((timer->expires >> (TWHEEL_SLOT_BITS * level)) &
+                         TWHEEL_SLOT_MASK); 
+    }
+
+    twheel_link_add(&wheel->slots[level][slot], &timer->link); 
+    wheel->used[level] |= (uint64_t)1 << slot; 
+    timer->slot = (uint16_t)((level << TWHEEL_SLOT_BITS) | slot); 
+    timer->active = TRUE; 
+}
+
+
+// Move a slot's timers down to the slots for their expiry ticks 
+static void twheel_cascade(
+    twheel_t *wheel, 
+    uint8_t level, 
+    uint8_t slot)
+{
+    twheel_link_t list; 
+    twheel_timer_t *timer; 
+
+    twheel_link_move(&wheel->slots[level][slot], &list); 
+    wheel->used[level] &= ~((uint64_t)1 << slot); 
+
+    while (list.next != &list)
+    {
+        timer = (twheel_timer_t *)list.next; 
+        twheel_link_remove(&timer->link); 
+        twheel_place(wheel, timer); 
+    }
+}
+
+
+// Process the next tick 
+static uint32_t twheel_tick(twheel_t *wheel)
+{
+    uint32_t tick = wheel->now, expiries = CLEAR; 
+    uint8_t slot = (uint8_t)(tick & TWHEEL_SLOT_MASK); 
+    twheel_link_t list; 
+    twheel_timer_t *timer; 
+
+    // Bring the upper level timers that expire in the coming span down a level 
+    for (uint8_t level = 1; level < TWHEEL_LEVELS; level++)
+    {
+        if (tick & ((1UL << (TWHEEL_SLOT_BITS * level)) - 1))
+        {
+            break; 
+        }
+
+        twheel_cascade(wheel, level, 
+                       (uint8_t)((tick >> (TWHEEL_SLOT_BITS * level)) & TWHEEL_SLOT_MASK)); 
+    }
+
+    // The expiring timers are taken out first so callbacks can add or remove any timer. 
+    // Timers added from now on go after this tick. 
+    twheel_link_move(&wheel->slots[0][slot], &list); 
+    wheel->used[0] &= ~((uint64_t)1 << slot); 
+    wheel->now = tick + 1; 
+
+    for (twheel_link_t *link = list.next; link != &list; link = link->next)
+    {
+        timer = (twheel_timer_t *)link; 
+        timer->slot = TWHEEL_SLOT_NONE; 
+    }
+
+    while (list.next != &list)
+    {
+        timer = (twheel_timer_t *)list.next; 
+        twheel_link_remove(&timer->link); 
+        timer->active = FALSE; 
+        timer->expired++; 
+        expiries++; 
+
+        // Periodic timers go back in from the tick they were due on to keep their phase 
+        if (timer->period)
+        {
+            timer->expires += timer->period; 
+            twheel_place(wheel, timer); 
+        }
+
+        if (timer->callback != NULL)
+        {
+            timer->callback(timer); 
+        }
+    }
+
+    return expiries; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Hardware timer functions 
+
+// Start the hardware timer wheel 
+uint8_t twheel_hw_init(void)
+{
+    TIM_TypeDef *timer = sys_time_timer(); 
+
+    if (timer == NULL)
+    {
+        return FALSE; 
+    }
+
+    // The interrupt is shared with the system clock so it's only held off while the 
+    // wheel is reset 
+    if (twheel_hw.timer != NULL)
+    {
+        NVIC_DisableIRQ(twheel_hw.irqn); 
+    }
+
+    timer->DIER &= ~TIM_DIER_CC1IE; 
+    memset((void *)&twheel_hw, CLEAR, sizeof(twheel_hw)); 
+
+    twheel_init(&twheel_hw.wheel, CLEAR); 
+    twheel_hw.timer = timer; 
+    twheel_hw.irqn = (timer == TIM2) ? TIM2_IRQn : TIM5_IRQn; 
+    twheel_hw.now_cnt = timer->CNT + TWHEEL_TICK_US; 
+
+    // Compare 1 (frozen output) is used for deadlines only 
+    timer->CCMR1 &= ~(TIM_CCMR1_CC1S | TIM_CCMR1_OC1M); 
+    timer->CCR1 = twheel_hw.now_cnt + (TWHEEL_SLEEP_MAX_TICKS * TWHEEL_TICK_US); 
+    timer->SR = ~TIM_SR_CC1IF; 
+    timer->DIER |= TIM_DIER_CC1IE; 
+
+    NVIC_EnableIRQ(twheel_hw.irqn); 
+
+    return TRUE; 
+}
+
+
+// Start a timer on the hardware timer wheel 
+uint8_t twheel_start(
+    twheel_timer_t *timer, 
+    uint32_t delay, 
+    uint32_t period, 
+    twheel_callback_t callback, 
+    void *arg)
+{
+    uint32_t delay_ticks = (uint32_t)(((uint64_t)delay + TWHEEL_TICK_US - 1) /
+                                      TWHEEL_TICK_US); 
+    uint32_t period_ticks = (period + (TWHEEL_TICK_US / 2)) / TWHEEL_TICK_US; 
+    uint8_t added; 
+
+    if ((twheel_hw.timer == NULL) || (timer == NULL))
+    {
+        return FALSE; 
+    }
+
+    // A period shorter than half a tick is one tick 
+    if (period && !period_ticks)
+    {
+        period_ticks = 1; 
+    }
+
+    if (twheel_hw.updating)
+    {
+        // Called from a callback - the update sets the compare when it's done 
+        timer->callback = callback; 
+        timer->arg = arg; 
+        return twheel_add(&twheel_hw.wheel, timer, delay_ticks, period_ticks); 
+    }
+
+    NVIC_DisableIRQ(twheel_hw.irqn); 
+
+    // Bring the wheel up to date so the delay counts from the next tick, which is due 
+    // within a tick from now 
+    twheel_hw_update(); 
+    timer->callback = callback; 
+    timer->arg = arg; 
+    added = twheel_add(&twheel_hw.wheel, timer, delay_ticks, period_ticks); 
+    twheel_hw_update(); 
+
+    NVIC_EnableIRQ(twheel_hw.irqn); 
+
+    return added; 
+}
+
+
+// Stop a timer on the hardware timer wheel 
+void twheel_stop(twheel_timer_t *timer)
+{
+    if (twheel_hw.timer == NULL)
+    {
+        return; 
+    }
+
+    if (twheel_hw.updating)
+    {
+        twheel_remove(&twheel_hw.wheel, timer); 
+        return; 
+    }
+
+    NVIC_DisableIRQ(twheel_hw.irqn); 
+    twheel_remove(&twheel_hw.wheel, timer); 
+    NVIC_EnableIRQ(twheel_hw.irqn); 
+}
+
+
+// Sleep until the next deadline or interrupt 
+void twheel_sleep(void)
+{
+    // A pending interrupt still wakes the core with interrupts masked so nothing that 
+    // happens between the check and WFI is missed. 
+    __disable_irq(); 
+
+    if (!twheel_hw.fired)
+    {
+        __WFI(); 
+    }
+
+    twheel_hw.fired = CLEAR; 
+    __enable_irq(); 
+}
+
+
+// Interrupt handler hook 
+void twheel_irq_handler(void)
+{
+    if ((twheel_hw.timer == NULL) || !(twheel_hw.timer->SR & TIM_SR_CC1IF))
+    {
+        return; 
+    }
+
+    twheel_hw.timer->SR = ~TIM_SR_CC1IF; 
+    twheel_hw_update(); 
+}
+
+
+// Advance the hardware wheel to the counter and set the next compare 
+static void twheel_hw_update(void)
+{
+    TIM_TypeDef *timer = twheel_hw.timer; 
+    uint32_t elapsed, due, next; 
+
+    twheel_hw.updating = SET; 
+
+    do
+    {
+        // Ticks whose time has come 
+        elapsed = timer->CNT - twheel_hw.now_cnt; 
+        due = ((int32_t)elapsed < 0) ? CLEAR : ((elapsed / TWHEEL_TICK_US) + 1); 
+
+        if (due)
+        {
+            if (twheel_advance(&twheel_hw.wheel, due))
+            {
+                twheel_hw.fired = SET; 
+            }
+
+            twheel_hw.now_cnt += due * TWHEEL_TICK_US; 
+        }
+
+        next = twheel_next(&twheel_hw.wheel, TWHEEL_SLEEP_MAX_TICKS); 
+        timer->CCR1 = twheel_hw.now_cnt + (next * TWHEEL_TICK_US); 
+    }
+    while ((int32_t)(timer->CCR1 - timer->CNT) <= 0); 
+
+    twheel_hw.updating = CLEAR; 
+}
+
+//=======================================================================================
@@ -0,0 +1,432 @@
+/**
+ * @file tlog.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Binary telemetry log 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "tlog.h" 
+#include "sd_log.h" 
+#include "sys_time.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define TLOG_PAD_LEN 64                     // Zeros written at a time to fill a chunk 
+#define TLOG_INDEX_LEN (TLOG_HEADER_LEN + (TLOG_INDEX_EVERY * TLOG_INDEX_ENTRY_LEN)) 
+#define TLOG_DATA_POS (TLOG_HEADER_LEN + TLOG_RECORD_HEADER_LEN)   // Contents in stage 
+
+// Chunk header byte positions 
+enum {
+    TLOG_POS_MAGIC, 
+    TLOG_POS_KIND = TLOG_POS_MAGIC + 2, 
+    TLOG_POS_VERSION, 
+    TLOG_POS_CHUNK, 
+    TLOG_POS_TIME = TLOG_POS_CHUNK + 4, 
+    TLOG_POS_END = TLOG_POS_TIME + 8
+}; 
+
+// Record byte positions 
+enum {
+    TLOG_POS_TYPE, 
+    TLOG_POS_OFFSET, 
+    TLOG_POS_DATA = TLOG_POS_OFFSET + 3
+}; 
+
+_Static_assert(TLOG_POS_END == TLOG_HEADER_LEN, 
+               "TLOG_HEADER_LEN doesn't match the chunk header"); 
+_Static_assert(TLOG_POS_DATA == TLOG_RECORD_HEADER_LEN, 
+               "TLOG_RECORD_HEADER_LEN doesn't match the record header"); 
+_Static_assert(TLOG_CHUNK_SIZE <= SD_LOG_BUFF_SIZE, 
+               "A chunk must fit in a logging engine buffer"); 
+_Static_assert(TLOG_INDEX_LEN <= TLOG_CHUNK_SIZE, "TLOG_INDEX_EVERY is too big"); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Telemetry log data 
+typedef struct tlog_data_s
+{
+    uint8_t open;                           // A log is open 
+    uint32_t chunk;                         // Number of the chunk being filled or next 
+    uint8_t chunk_open;                     // Chunk 'chunk' has been started 
+    uint8_t index_open;                     // The open chunk is an index chunk 
+    uint16_t used;                          // Bytes written to the open chunk 
+    uint64_t time;                          // Header time of the open data chunk (us) 
+    uint8_t index[TLOG_INDEX_LEN];          // Index chunk being filled (header and times) 
+    uint16_t indexed;                       // Data chunks in 'index' 
+    uint64_t index_time;                    // Header time of the first of them (us) 
+    uint8_t stage[TLOG_HEADER_LEN + TLOG_RECORD_MAX_LEN];   // Chunk header and record 
+    tlog_stats_t stats;                     // Logging statistics 
+}
+tlog_data_t; 
+
+static tlog_data_t tlog; 
+
+// Zeros for the ends of chunks 
+static const uint8_t tlog_zeros[TLOG_PAD_LEN]; 
+
+// Record contents length of each type 
+static const uint8_t tlog_record_lens[TLOG_TYPE_COUNT] = TLOG_RECORD_LENS; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Write a little endian value 
+ * 
+ * @param buff : where the value goes 
+ * @param value : value 
+ * @param len : number of bytes 
+ */
+static void tlog_put(
+    uint8_t *buff, 
+    uint64_t value, 
+    uint8_t len); 
+
+
+/**
+ * @brief Write a chunk header 
+ * 
+ * @param buff : where the header goes 
+ * @param kind : chunk kind 
+ * @param time : header time (us) 
+ */
+static void tlog_header(
+    uint8_t *buff, 
+    tlog_chunk_t kind, 
+    uint64_t time); 
+
+
+/**
+ * @brief Fill the rest of the open chunk with zeros 
+ * 
+ * @details Carries on from where it left off if the logging engine was full. 
+ * 
+ * @return uint8_t : TRUE if the chunk is finished 
+ */
+static uint8_t tlog_finish(void); 
+
+
+/**
+ * @brief Write the index chunk for the last TLOG_INDEX_EVERY data chunks 
+ * 
+ * @return uint8_t : TRUE if the index chunk is finished 
+ */
+static uint8_t tlog_write_index(void); 
+
+
+/**
+ * @brief Stamp a record and write it 
+ * 
+ * @details Starts a new data chunk (and writes the index chunk if due) if the record 
+ *          doesn't fit in the open one or its time offset is too big. The record's 
+ *          contents must already be in the stage at TLOG_DATA_POS. 
+ * 
+ * @param type : record type 
+ * @return uint8_t : TRUE if written, FALSE if dropped or no log is open 
+ */
+static uint8_t tlog_append(tlog_type_t type); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Control functions 
+
+// Start a telemetry log 
+uint8_t tlog_open(
+    FIL *file, 
+    FSIZE_t size, 
+    uint16_t sync_every)
+{
+    uint8_t open; 
+
+    if (tlog.open || (file == NULL) || f_size(file))
+    {
+        return FALSE; 
+    }
+
+    open = size ? sd_log_open_contig(file, size, sync_every) :
+                  sd_log_open(file, sync_every); 
+
+    if (open)
+    {
+        memset((void *)&tlog, CLEAR, sizeof(tlog)); 
+        tlog.open = TRUE; 
+    }
+
+    return open; 
+}
+
+
+// Finish the last chunk and stop logging 
+uint8_t tlog_close(void)
+{
+    if (!tlog.open)
+    {
+        return FALSE; 
+    }
+
+    // The main loop makes room until the chunk is finished 
+    while (tlog.chunk_open && !tlog_finish())
+    {
+        sd_log_service(); 
+    }
+
+    tlog.open = FALSE; 
+
+    return sd_log_close(); 
+}
+
+
+// Read the telemetry log statistics 
+void tlog_get_stats(tlog_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = tlog.stats; 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Records 
+
+// Log a GPS fix 
+uint8_t tlog_gps(const tlog_gps_t *gps)
+{
+    uint8_t *data = &tlog.stage[TLOG_DATA_POS]; 
+
+    tlog_put(&data[0], (uint32_t)gps->lat, 4); 
+    tlog_put(&data[4], (uint32_t)gps->lon, 4); 
+    tlog_put(&data[8], (uint32_t)gps->alt, 4); 
+    tlog_put(&data[12], gps->speed, 2); 
+    data[14] = gps->fix; 
+    data[15] = gps->sats; 
+
+    return tlog_append(TLOG_TYPE_GPS); 
+}
+
+
+// Log the heading 
+uint8_t tlog_heading(const tlog_heading_t *heading)
+{
+    uint8_t *data = &tlog.stage[TLOG_DATA_POS]; 
+
+    tlog_put(&data[0], heading->heading, 2); 
+    tlog_put(&data[2], heading->target, 2); 
+
+    return tlog_append(TLOG_TYPE_HEADING); 
+}
+
+
+// Log IMU readings 
+uint8_t tlog_imu(const tlog_imu_t *imu)
+{
+    uint8_t *data = &tlog.stage[TLOG_DATA_POS]; 
+
+    for (uint8_t axis = CLEAR; axis < TLOG_IMU_AXES; axis++)
+    {
+        tlog_put(&data[axis * 2], (uint16_t)imu->accel[axis], 2); 
+        tlog_put(&data[(TLOG_IMU_AXES + axis) * 2], (uint16_t)imu->gyro[axis], 2); 
+    }
+
+    return tlog_append(TLOG_TYPE_IMU); 
+}
+
+
+// Log the thruster throttle 
+uint8_t tlog_throttle(const tlog_throttle_t *throttle)
+{
+    uint8_t *data = &tlog.stage[TLOG_DATA_POS]; 
+
+    tlog_put(&data[0], (uint16_t)throttle->throttle[TLOG_RIGHT], 2); 
+    tlog_put(&data[2], (uint16_t)throttle->throttle[TLOG_LEFT], 2); 
+
+    return tlog_append(TLOG_TYPE_THROTTLE); 
+}
+
+
+// Log radio link statistics 
+uint8_t tlog_radio(const tlog_radio_t *radio)
+{
+    uint8_t *data = &tlog.stage[TLOG_DATA_POS]; 
+
+    data[0] = radio->link; 
+    data[1] = radio->channel; 
+    tlog_put(&data[2], radio->frames, 2); 
+    tlog_put(&data[4], radio->lost, 2); 
+    tlog_put(&data[6], radio->bad, 2); 
+
+    return tlog_append(TLOG_TYPE_RADIO); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Chunks 
+
+// Write a little endian value 
+static void tlog_put(
+    uint8_t *buff, 
+    uint64_t value, 
+    uint8_t len)
+{
+    for (uint8_t i = CLEAR; i < len; i++)
+    {
+        buff[i] = (uint8_t)(value >> (SHIFT_8 * i)); 
+    }
+}
+
+
+// Write a chunk header 
+static void tlog_header(
+    uint8_t *buff, 
+    tlog_chunk_t kind, 
+    uint64_t time)
+{
+    tlog_put(&buff[TLOG_POS_MAGIC], TLOG_MAGIC, 2); 
+    buff[TLOG_POS_KIND] = (uint8_t)kind; 
+    buff[TLOG_POS_VERSION] = TLOG_VERSION; 
+    tlog_put(&buff[TLOG_POS_CHUNK], tlog.chunk, 4); 
+    tlog_put(&buff[TLOG_POS_TIME], time, 8); 
+}
+
+
+// Fill the rest of the open chunk with zeros 
+static uint8_t tlog_finish(void)
+{
+    uint16_t len; 
+
+    while (tlog.used < TLOG_CHUNK_SIZE)
+    {
+        len = ((TLOG_CHUNK_SIZE - tlog.used) < TLOG_PAD_LEN) ?
+              (TLOG_CHUNK_SIZE - tlog.used) : TLOG_PAD_LEN; 
+
+        if (!sd_log_write(tlog_zeros, len))
+        {
+            return FALSE; 
+        }
+
+        tlog.used += len; 
+        tlog.stats.pad_bytes += len; 
+    }
+
+    tlog.chunk_open = FALSE; 
+    tlog.index_open = FALSE; 
+    tlog.chunk++; 
+
+    return TRUE; 
+}
+
+
+// Write the index chunk for the last TLOG_INDEX_EVERY data chunks 
+static uint8_t tlog_write_index(void)
+{
+    // The header and times go at once and the zeros after them can follow later. The 
+    // index starts over for the next data chunks once the times are written. 
+    tlog_header(tlog.index, TLOG_CHUNK_INDEX, tlog.index_time); 
+
+    if (!sd_log_write(tlog.index, TLOG_INDEX_LEN))
+    {
+        return FALSE; 
+    }
+
+    tlog.chunk_open = TRUE; 
+    tlog.index_open = TRUE; 
+    tlog.used = TLOG_INDEX_LEN; 
+    tlog.indexed = CLEAR; 
+    tlog.stats.index_chunks++; 
+
+    return tlog_finish(); 
+}
+
+
+// Stamp a record and write it 
+static uint8_t tlog_append(tlog_type_t type)
+{
+    uint64_t now = sys_time_us(); 
+    uint16_t len = TLOG_RECORD_HEADER_LEN + tlog_record_lens[type]; 
+    uint8_t *record = &tlog.stage[TLOG_HEADER_LEN]; 
+    uint8_t start; 
+
+    if (!tlog.open)
+    {
+        return FALSE; 
+    }
+
+    // An index chunk left unfinished, or a data chunk that's full or too old for the 
+    // record's time offset, is finished first. The index chunk goes before the next 
+    // data chunk once it's due. 
+    if ((tlog.chunk_open &&
+         (tlog.index_open || ((tlog.used + len) > TLOG_CHUNK_SIZE) ||
+          ((now - tlog.time) > TLOG_OFFSET_MAX)) && !tlog_finish()) ||
+        (!tlog.chunk_open && (tlog.indexed >= TLOG_INDEX_EVERY) && !tlog_write_index()))
+    {
+        tlog.stats.dropped++; 
+        return FALSE; 
+    }
+
+    // A new chunk's header goes with its first record 
+    start = !tlog.chunk_open; 
+    record[TLOG_POS_TYPE] = (uint8_t)type; 
+    tlog_put(&record[TLOG_POS_OFFSET], start ? CLEAR : (now - tlog.time), 3); 
+
+    if (start)
+    {
+        tlog_header(tlog.stage, TLOG_CHUNK_DATA, now); 
+    }
+
+    if (!sd_log_write(start ? tlog.stage : record, start ? (TLOG_HEADER_LEN + len) : len))
+    {
+        tlog.stats.dropped++; 
+        return FALSE; 
+    }
+
+    if (start)
+    {
+        if (!tlog.indexed)
+        {
+            tlog.index_time = now; 
+        }
+
+        tlog_put(&tlog.index[TLOG_HEADER_LEN + (tlog.indexed * TLOG_INDEX_ENTRY_LEN)], 
+                 now, TLOG_INDEX_ENTRY_LEN); 
+        tlog.indexed++; 
+        tlog.chunk_open = TRUE; 
+        tlog.used = TLOG_HEADER_LEN; 
+        tlog.time = now; 
+        tlog.stats.data_chunks++; 
+    }
+
+    tlog.used += len; 
+    tlog.stats.records++; 
+    tlog.stats.record_bytes += len; 
+
+    return TRUE; 
+}
+
+//=======================================================================================
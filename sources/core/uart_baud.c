@@ -0,0 +1,140 @@
+/**
+ * @file uart_baud.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief UART baud rate calculator 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "uart_baud.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define UART_BAUD_FRAC_BITS 4               // BRR fraction field width 
+#define UART_BAUD_ERROR_SCALE 10000         // Error units per 1 (hundredths of a percent) 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Functions 
+
+// Find the baud rate setting for a peripheral clock 
+uint8_t uart_baud_calc(
+    uint32_t pclk, 
+    uint32_t baud, 
+    uart_baud_t *setting)
+{
+    uart_baud_t calc; 
+    uint32_t div; 
+    int64_t error; 
+
+    if ((setting == NULL) || !baud || (baud > pclk))
+    {
+        return FALSE; 
+    }
+
+    // Divider rounded to the nearest step 
+    div = (uint32_t)(((uint64_t)pclk + (baud / 2)) / baud); 
+
+    if (div >= UART_BAUD_DIV_MIN_OVER16)
+    {
+        calc.over8 = CLEAR; 
+        calc.mantissa = (uint16_t)(div >> UART_BAUD_FRAC_BITS); 
+        calc.fraction = (uint8_t)(div & 0x0F); 
+    }
+    else if (div >= UART_BAUD_DIV_MIN_OVER8)
+    {
+        calc.over8 = SET; 
+        calc.mantissa = (uint16_t)(div >> (UART_BAUD_FRAC_BITS - 1)); 
+        calc.fraction = (uint8_t)(div & 0x07); 
+    }
+    else
+    {
+        return FALSE; 
+    }
+
+    if (calc.mantissa > UART_BAUD_MANT_MAX)
+    {
+        return FALSE; 
+    }
+
+    calc.brr = (uint16_t)((calc.mantissa << UART_BAUD_FRAC_BITS) | calc.fraction); 
+    calc.actual = (uint32_t)(((uint64_t)pclk + (div / 2)) / div); 
+
+    error = (((int64_t)pclk - ((int64_t)baud * div)) * UART_BAUD_ERROR_SCALE) /
+            ((int64_t)baud * div); 
+
+    if ((error > UART_BAUD_ERROR_MAX) || (error < -UART_BAUD_ERROR_MAX))
+    {
+        return FALSE; 
+    }
+
+    calc.error = (int16_t)error; 
+    *setting = calc; 
+
+    return TRUE; 
+}
+
+
+// Peripheral clock of a UART 
+uint32_t uart_baud_pclk(USART_TypeDef *uart)
+{
+    if ((uart == USART1) || (uart == USART6))
+    {
+        return rcc_get_pclk2_frq(); 
+    }
+
+    return rcc_get_pclk1_frq(); 
+}
+
+
+// Set the baud rate of an initialized UART 
+uint8_t uart_baud_set(
+    USART_TypeDef *uart, 
+    uint32_t baud, 
+    uart_baud_t *setting)
+{
+    uart_baud_t calc; 
+    uint32_t cr1; 
+
+    if ((uart == NULL) || !uart_baud_calc(uart_baud_pclk(uart), baud, &calc))
+    {
+        return FALSE; 
+    }
+
+    // Let the last byte leave the shift register so it isn't cut off 
+    if (uart->CR1 & USART_CR1_TE)
+    {
+        while (!(uart->SR & USART_SR_TC)) {}
+    }
+
+    cr1 = uart->CR1; 
+    uart->CR1 = cr1 & ~USART_CR1_UE; 
+    uart->BRR = calc.brr; 
+    uart->CR1 = calc.over8 ? ((cr1 & ~USART_CR1_UE) | USART_CR1_OVER8) :
+                             ((cr1 & ~USART_CR1_UE) & ~USART_CR1_OVER8); 
+    uart->CR1 |= (cr1 & USART_CR1_UE); 
+
+    if (setting != NULL)
+    {
+        *setting = calc; 
+    }
+
+    return TRUE; 
+}
+
+//=======================================================================================
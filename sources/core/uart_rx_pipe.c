@@ -0,0 +1,394 @@
+/**
+ * @file uart_rx_pipe.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief UART receive pipeline and line assembler 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "uart_rx_pipe.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define UART_RXP_MASK (UART_RXP_SIZE - 1) 
+#define UART_RXP_DMA_IRQN DMA1_Stream5_IRQn 
+#define UART_RXP_UART_IRQN USART2_IRQn 
+
+_Static_assert((UART_RXP_SIZE & UART_RXP_MASK) == 0, "UART_RXP_SIZE must be a power of 2"); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Pipeline data. The counts are free running and masked to find the buffer position. 
+// Bytes from 'tail' to 'head' are unread and 'scan' is how far the line search got. 
+typedef struct uart_rxp_data_s
+{
+    uint8_t buff[UART_RXP_SIZE];            // Circular buffer written by the DMA 
+    volatile uint32_t head;                 // Bytes received - interrupts only 
+    volatile uint16_t dma_pos;              // DMA position at the last update 
+    uint32_t tail;                          // Start of the unread input 
+    uint32_t scan;                          // Next byte to check for a line end 
+    uint32_t line_end;                      // End of the held line (after the terminator) 
+    uart_rxp_line_t line;                   // Held line 
+    uint8_t held;                           // A line is held 
+    uint8_t discard;                        // Drop input up to the next line end 
+    uint8_t init;                           // Pipeline is initialized 
+    uart_rxp_stats_t stats;                 // Pipeline statistics 
+}
+uart_rxp_data_t; 
+
+static uart_rxp_data_t uart_rxp; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Update the received count from the DMA position - interrupts masked 
+ */
+static void uart_rxp_update(void); 
+
+
+/**
+ * @brief Received count with the latest input included 
+ * 
+ * @return uint32_t : bytes received 
+ */
+static uint32_t uart_rxp_sync(void); 
+
+
+/**
+ * @brief Check for input overwritten before it was read 
+ * 
+ * @param head : bytes received 
+ */
+static void uart_rxp_overrun_check(uint32_t head); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Initialization 
+
+// Initialize the receive pipeline 
+void uart_rxp_init(uint8_t priority)
+{
+    NVIC_DisableIRQ(UART_RXP_DMA_IRQN); 
+    NVIC_DisableIRQ(UART_RXP_UART_IRQN); 
+
+    memset((void *)&uart_rxp, CLEAR, sizeof(uart_rxp)); 
+
+    // UART data register to memory, restarting at the top of the buffer when full 
+    dma_stream_init(
+        UART_RXP_DMA, 
+        UART_RXP_STREAM, 
+        UART_RXP_CHNL, 
+        DMA_DIR_PM, 
+        DMA_CM_ENABLE, 
+        DMA_PRIOR_VHI, 
+        DMA_DBM_DISABLE, 
+        DMA_ADDR_INCREMENT,   // Increment the buffer pointer to fill the buffer 
+        DMA_ADDR_FIXED,       // No peripheral increment - copy from DR only 
+        DMA_DATA_SIZE_BYTE, 
+        DMA_DATA_SIZE_BYTE); 
+
+    dma_stream_config(
+        UART_RXP_STREAM, 
+        (uint32_t)(&UART_RXP_UART->DR), 
+        (uint32_t)(uintptr_t)uart_rxp.buff, 
+        (uint32_t)NULL, 
+        (uint16_t)UART_RXP_SIZE); 
+
+    // Half transfer and transfer complete keep the count updated during long input 
+    dma_int_config(
+        UART_RXP_STREAM, 
+        DMA_TCIE_ENABLE, 
+        DMA_HTIE_ENABLE, 
+        DMA_TEIE_DISABLE, 
+        DMA_DMEIE_DISABLE); 
+
+    dma_stream_enable(UART_RXP_STREAM); 
+
+    // IDLE line updates the count at the end of input that doesn't reach a half buffer 
+    UART_RXP_UART->CR3 |= USART_CR3_DMAR; 
+    UART_RXP_UART->CR1 |= USART_CR1_IDLEIE; 
+
+    uart_rxp.init = SET; 
+
+    nvic_config(UART_RXP_DMA_IRQN, priority); 
+    nvic_config(UART_RXP_UART_IRQN, priority); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Line assembler 
+
+// Get the next line 
+uint8_t uart_rxp_line_get(uart_rxp_line_t *line)
+{
+    uint32_t head, start, len, first; 
+    uint8_t data; 
+
+    if (!uart_rxp.init || (line == NULL))
+    {
+        return FALSE; 
+    }
+
+    if (uart_rxp.held)
+    {
+        *line = uart_rxp.line; 
+        return TRUE; 
+    }
+
+    head = uart_rxp_sync(); 
+    uart_rxp_overrun_check(head); 
+
+    while (uart_rxp.scan != head)
+    {
+        data = uart_rxp.buff[uart_rxp.scan & UART_RXP_MASK]; 
+        uart_rxp.scan++; 
+
+        if ((data != '\r') && (data != '\n'))
+        {
+            // No line end within a full buffer - the line can't be held 
+            if ((uart_rxp.scan - uart_rxp.tail) >= UART_RXP_SIZE)
+            {
+                if (!uart_rxp.discard)
+                {
+                    uart_rxp.stats.long_lines++; 
+                    uart_rxp.discard = SET; 
+                }
+
+                uart_rxp.tail = uart_rxp.scan; 
+            }
+
+            continue; 
+        }
+
+        len = uart_rxp.scan - 1 - uart_rxp.tail; 
+
+        // Skip the rest of a dropped line and empty lines (ex. "\r\n") 
+        if (uart_rxp.discard || !len)
+        {
+            uart_rxp.discard = CLEAR; 
+            uart_rxp.tail = uart_rxp.scan; 
+            continue; 
+        }
+
+        // Slice of the line - split in two if it wraps around the end of the buffer 
+        start = uart_rxp.tail & UART_RXP_MASK; 
+        first = UART_RXP_SIZE - start; 
+        first = (len < first) ? len : first; 
+
+        uart_rxp.line.data[0] = &uart_rxp.buff[start]; 
+        uart_rxp.line.len[0] = (uint16_t)first; 
+        uart_rxp.line.data[1] = uart_rxp.buff; 
+        uart_rxp.line.len[1] = (uint16_t)(len - first); 
+        uart_rxp.line.total = (uint16_t)len; 
+
+        uart_rxp.line_end = uart_rxp.scan; 
+        uart_rxp.held = SET; 
+        uart_rxp.stats.lines++; 
+
+        *line = uart_rxp.line; 
+        return TRUE; 
+    }
+
+    return FALSE; 
+}
+
+
+// Release the line from uart_rxp_line_get 
+uint8_t uart_rxp_line_release(void)
+{
+    uint32_t head, overwritten; 
+    uint8_t intact = TRUE; 
+
+    if (!uart_rxp.held)
+    {
+        return FALSE; 
+    }
+
+    // A byte is overwritten once a full buffer of input has been received after it 
+    head = uart_rxp_sync(); 
+
+    if ((head - uart_rxp.tail) > UART_RXP_SIZE)
+    {
+        overwritten = head - uart_rxp.tail - UART_RXP_SIZE; 
+        overwritten = (overwritten < uart_rxp.line.total) ? 
+                      overwritten : uart_rxp.line.total; 
+        uart_rxp.stats.overruns++; 
+        uart_rxp.stats.lost += overwritten; 
+        intact = FALSE; 
+    }
+
+    uart_rxp.tail = uart_rxp.line_end; 
+    uart_rxp.held = CLEAR; 
+
+    return intact; 
+}
+
+
+// Copy a line slice into a null terminated string 
+uint16_t uart_rxp_line_copy(
+    const uart_rxp_line_t *line, 
+    char *buff, 
+    uint16_t size)
+{
+    uint16_t len = CLEAR, part_len; 
+
+    if ((line == NULL) || (buff == NULL) || !size)
+    {
+        return CLEAR; 
+    }
+
+    for (uint8_t i = CLEAR; i < UART_RXP_PARTS; i++)
+    {
+        part_len = line->len[i]; 
+
+        if ((len + part_len) >= size)
+        {
+            part_len = size - 1 - len; 
+        }
+
+        memcpy((void *)&buff[len], (const void *)line->data[i], part_len); 
+        len += part_len; 
+    }
+
+    buff[len] = NULL_CHAR; 
+
+    return len; 
+}
+
+
+// Read the pipeline statistics 
+void uart_rxp_get_stats(uart_rxp_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return; 
+    }
+
+    NVIC_DisableIRQ(UART_RXP_DMA_IRQN); 
+    NVIC_DisableIRQ(UART_RXP_UART_IRQN); 
+    *stats = uart_rxp.stats; 
+    NVIC_EnableIRQ(UART_RXP_UART_IRQN); 
+    NVIC_EnableIRQ(UART_RXP_DMA_IRQN); 
+}
+
+
+// Check for input overwritten before it was read 
+static void uart_rxp_overrun_check(uint32_t head)
+{
+    uint32_t limit; 
+    uint8_t data; 
+
+    while ((head - uart_rxp.tail) > UART_RXP_SIZE)
+    {
+        // Nothing from 'tail' to 'scan' is a line end. If the overwritten input was all 
+        // checked already then look at the rest of a buffer's worth of input after 
+        // 'tail'. Without a line end the line is too long for the buffer rather than 
+        // lost to a slow reader. 
+        limit = uart_rxp.tail + UART_RXP_SIZE; 
+
+        while (((head - uart_rxp.scan) <= UART_RXP_SIZE) && (uart_rxp.scan != limit))
+        {
+            data = uart_rxp.buff[uart_rxp.scan & UART_RXP_MASK]; 
+
+            if ((data == '\r') || (data == '\n'))
+            {
+                break; 
+            }
+
+            uart_rxp.scan++; 
+        }
+
+        if (uart_rxp.scan == limit)
+        {
+            if (!uart_rxp.discard)
+            {
+                uart_rxp.stats.long_lines++; 
+                uart_rxp.discard = SET; 
+            }
+
+            uart_rxp.tail = uart_rxp.scan; 
+            continue; 
+        }
+
+        // Keep the input that's still in the buffer but drop up to the next line end 
+        // because the start of that line is gone 
+        uart_rxp.stats.overruns++; 
+        uart_rxp.stats.lost += head - uart_rxp.tail - UART_RXP_SIZE; 
+        uart_rxp.tail = head - UART_RXP_SIZE; 
+        uart_rxp.scan = uart_rxp.tail; 
+        uart_rxp.discard = SET; 
+    }
+}
+
+
+// Received count with the latest input included 
+static uint32_t uart_rxp_sync(void)
+{
+    uint32_t head; 
+
+    NVIC_DisableIRQ(UART_RXP_DMA_IRQN); 
+    NVIC_DisableIRQ(UART_RXP_UART_IRQN); 
+    uart_rxp_update(); 
+    head = uart_rxp.head; 
+    NVIC_EnableIRQ(UART_RXP_UART_IRQN); 
+    NVIC_EnableIRQ(UART_RXP_DMA_IRQN); 
+
+    return head; 
+}
+
+
+// Update the received count from the DMA position 
+static void uart_rxp_update(void)
+{
+    // NDTR counts down from the buffer size and reloads when it reaches zero. The 
+    // interrupts run at least every half buffer so the distance moved is never more 
+    // than a full buffer. 
+    uint16_t pos = (uint16_t)((UART_RXP_SIZE - UART_RXP_STREAM->NDTR) & UART_RXP_MASK); 
+    uint16_t moved = (uint16_t)((pos - uart_rxp.dma_pos) & UART_RXP_MASK); 
+
+    uart_rxp.dma_pos = pos; 
+    uart_rxp.head += moved; 
+    uart_rxp.stats.received += moved; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Interrupt handler 
+
+// Interrupt handler hook 
+void uart_rxp_irq_handler(void)
+{
+    if (uart_rxp.init)
+    {
+        uart_rxp_update(); 
+    }
+}
+
+//=======================================================================================
@@ -0,0 +1,417 @@
+/**
+ * @file uart_tx_queue.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Non-blocking UART transmit queue 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "uart_tx_queue.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define UART_TXQ_MASK (UART_TXQ_SIZE - 1) 
+#define UART_TXQ_IRQN DMA1_Stream6_IRQn 
+#define UART_TXQ_INT_LEN 12                 // Max integer text length ("-2147483648") 
+
+// Stream 6 interrupt flags 
+#define UART_TXQ_FLAGS (DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6 |  \
+                        DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6)
+
+_Static_assert((UART_TXQ_SIZE & UART_TXQ_MASK) == 0, "UART_TXQ_SIZE must be a power of 2"); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Queue data. The indexes are free running and masked to find the buffer position. 
+// Bytes from 'tail' to 'next' are being sent by the DMA and bytes from 'next' to 'head' 
+// are waiting to be sent. 
+typedef struct uart_txq_data_s
+{
+    uint8_t buff[UART_TXQ_SIZE];            // Ring buffer 
+    volatile uint32_t head;                 // Next free byte - main loop only 
+    volatile uint32_t next;                 // Next byte to hand to the DMA 
+    volatile uint32_t tail;                 // Start of the current transfer 
+    volatile uint16_t dma_len;              // Current transfer length (0 = DMA idle) 
+    uart_txq_policy_t policy;               // Overflow policy 
+    uint8_t init;                           // Queue is initialized 
+    uart_txq_stats_t stats;                 // Queue statistics 
+}
+uart_txq_data_t; 
+
+static uart_txq_data_t uart_txq; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Start a transfer of the waiting data - DMA interrupt masked or in the handler 
+ */
+static void uart_txq_start(void); 
+
+
+/**
+ * @brief Wait for the queue to empty down to a number of bytes 
+ * 
+ * @param used : bytes left in the queue when done 
+ */
+static void uart_txq_wait(uint16_t used); 
+
+
+/**
+ * @brief Start a transfer if the DMA is idle 
+ * 
+ * @details A finished transfer that the interrupt hasn't handled yet is handled here. 
+ */
+static void uart_txq_kick(void); 
+
+
+/**
+ * @brief Drop the oldest waiting data to make room - DMA interrupt masked 
+ * 
+ * @details The newer waiting data is moved down over the dropped data so the queue 
+ *          stays in one piece. Data being sent by the DMA is never touched. 
+ * 
+ * @param len : room needed 
+ * @return uint16_t : room available (less than 'len' if the waiting data isn't enough) 
+ */
+static uint16_t uart_txq_overwrite(uint16_t len); 
+
+
+/**
+ * @brief Copy data into the queue - the room must have already been checked 
+ * 
+ * @param data : data to copy 
+ * @param len : number of bytes 
+ */
+static void uart_txq_copy(
+    const uint8_t *data, 
+    uint16_t len); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Initialization 
+
+// Initialize the transmit queue 
+void uart_txq_init(
+    uart_txq_policy_t policy, 
+    uint8_t priority)
+{
+    // Memory to UART data register, one transfer at a time (no circular mode) 
+    dma_stream_init(
+        UART_TXQ_DMA, 
+        UART_TXQ_STREAM, 
+        UART_TXQ_CHNL, 
+        DMA_DIR_MP, 
+        DMA_CM_DISABLE, 
+        DMA_PRIOR_LOW, 
+        DMA_DBM_DISABLE, 
+        DMA_ADDR_INCREMENT,   // Increment the buffer pointer 
+        DMA_ADDR_FIXED,       // No peripheral increment - copy to DR only 
+        DMA_DATA_SIZE_BYTE, 
+        DMA_DATA_SIZE_BYTE); 
+
+    dma_stream_config(
+        UART_TXQ_STREAM, 
+        (uint32_t)(&UART_TXQ_UART->DR), 
+        (uint32_t)(uintptr_t)uart_txq.buff, 
+        (uint32_t)NULL, 
+        (uint16_t)CLEAR); 
+
+    // Transfer complete starts the next transfer 
+    dma_int_config(
+        UART_TXQ_STREAM, 
+        DMA_TCIE_ENABLE, 
+        DMA_HTIE_DISABLE, 
+        DMA_TEIE_DISABLE, 
+        DMA_DMEIE_DISABLE); 
+
+    UART_TXQ_UART->CR3 |= USART_CR3_DMAT; 
+
+    NVIC_DisableIRQ(UART_TXQ_IRQN); 
+    uart_txq.head = CLEAR; 
+    uart_txq.next = CLEAR; 
+    uart_txq.tail = CLEAR; 
+    uart_txq.dma_len = CLEAR; 
+    uart_txq.policy = policy; 
+    memset((void *)&uart_txq.stats, CLEAR, sizeof(uart_txq.stats)); 
+    uart_txq.init = SET; 
+
+    nvic_config(UART_TXQ_IRQN, priority); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Queue functions 
+
+// Queue data to send 
+uint16_t uart_txq_write(
+    const uint8_t *data, 
+    uint16_t len)
+{
+    uint16_t room, queued = CLEAR; 
+
+    if (!uart_txq.init || (data == NULL))
+    {
+        return CLEAR; 
+    }
+
+    while (len)
+    {
+        NVIC_DisableIRQ(UART_TXQ_IRQN); 
+
+        room = (uint16_t)(UART_TXQ_SIZE - (uart_txq.head - uart_txq.tail)); 
+
+        if (len > room)
+        {
+            switch (uart_txq.policy)
+            {
+                case UART_TXQ_OVERWRITE:
+                    room = uart_txq_overwrite(len); 
+
+                    // Not enough waiting data to drop - keep the newest of the new data 
+                    if (len > room)
+                    {
+                        uart_txq.stats.dropped += len - room; 
+                        data += len - room; 
+                        len = room; 
+                    }
+                    break; 
+
+                case UART_TXQ_BLOCK:
+                    // Queue what fits and wait for the DMA to make room for the rest 
+                    if (!room)
+                    {
+                        NVIC_EnableIRQ(UART_TXQ_IRQN); 
+                        uart_txq_wait(UART_TXQ_SIZE - 1); 
+                        continue; 
+                    }
+                    break; 
+
+                default:   // UART_TXQ_DROP 
+                    uart_txq.stats.dropped += len; 
+                    NVIC_EnableIRQ(UART_TXQ_IRQN); 
+                    return queued; 
+            }
+        }
+
+        room = (len < room) ? len : room; 
+        uart_txq_copy(data, room); 
+
+        if (!uart_txq.dma_len)
+        {
+            uart_txq_start(); 
+        }
+
+        NVIC_EnableIRQ(UART_TXQ_IRQN); 
+
+        data += room; 
+        len -= room; 
+        queued += room; 
+    }
+
+    return queued; 
+}
+
+
+// Queue a string to send 
+uint16_t uart_txq_puts(const char *string)
+{
+    return uart_txq_write((const uint8_t *)string, (uint16_t)strlen(string)); 
+}
+
+
+// Queue an integer to send as text 
+uint16_t uart_txq_send_integer(int32_t integer)
+{
+    char text[UART_TXQ_INT_LEN]; 
+    int len = snprintf(text, UART_TXQ_INT_LEN, "%ld", (long)integer); 
+    return uart_txq_write((const uint8_t *)text, (uint16_t)len); 
+}
+
+
+// Wait for all queued data to be sent 
+void uart_txq_flush(void)
+{
+    if (!uart_txq.init)
+    {
+        return; 
+    }
+
+    uart_txq_wait(CLEAR); 
+
+    // The last byte leaves the UART after the DMA is done 
+    while (!(UART_TXQ_UART->SR & USART_SR_TC)) {}
+}
+
+
+// Number of bytes waiting to be sent 
+uint16_t uart_txq_used(void)
+{
+    return (uint16_t)(uart_txq.head - uart_txq.tail); 
+}
+
+
+// Read the queue statistics 
+void uart_txq_get_stats(uart_txq_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = uart_txq.stats; 
+    }
+}
+
+
+// Wait for the queue to empty down to a number of bytes 
+static void uart_txq_wait(uint16_t used)
+{
+    // Transfers are finished here if the interrupt can't run (ex. interrupts disabled) 
+    while (uart_txq_used() > used)
+    {
+        if (!(UART_TXQ_STREAM->CR & DMA_SxCR_EN))
+        {
+            uart_txq_kick(); 
+        }
+    }
+}
+
+
+// Start a transfer if the DMA is idle 
+static void uart_txq_kick(void)
+{
+    NVIC_DisableIRQ(UART_TXQ_IRQN); 
+
+    if (uart_txq.dma_len && !(UART_TXQ_STREAM->CR & DMA_SxCR_EN))
+    {
+        UART_TXQ_DMA->HIFCR = UART_TXQ_FLAGS; 
+        uart_txq.dma_len = CLEAR; 
+    }
+
+    if (!uart_txq.dma_len)
+    {
+        uart_txq_start(); 
+    }
+
+    NVIC_EnableIRQ(UART_TXQ_IRQN); 
+}
+
+
+// Start a transfer of the waiting data 
+static void uart_txq_start(void)
+{
+    uint32_t len = uart_txq.head - uart_txq.next; 
+    uint32_t offset = uart_txq.next & UART_TXQ_MASK; 
+
+    uart_txq.tail = uart_txq.next; 
+
+    if (!len)
+    {
+        return; 
+    }
+
+    // A transfer can't wrap around the end of the buffer 
+    if (len > (UART_TXQ_SIZE - offset))
+    {
+        len = UART_TXQ_SIZE - offset; 
+    }
+
+    UART_TXQ_STREAM->M0AR = (uint32_t)(uintptr_t)&uart_txq.buff[offset]; 
+    UART_TXQ_STREAM->NDTR = len; 
+    uart_txq.dma_len = (uint16_t)len; 
+    uart_txq.next += len; 
+    UART_TXQ_STREAM->CR |= DMA_SxCR_EN; 
+}
+
+
+// Drop the oldest waiting data to make room 
+static uint16_t uart_txq_overwrite(uint16_t len)
+{
+    uint32_t room = UART_TXQ_SIZE - (uart_txq.head - uart_txq.tail); 
+    uint32_t waiting = uart_txq.head - uart_txq.next; 
+    uint32_t drop = len - room; 
+
+    drop = (drop < waiting) ? drop : waiting; 
+
+    for (uint32_t i = uart_txq.next; (i + drop) != uart_txq.head; i++)
+    {
+        uart_txq.buff[i & UART_TXQ_MASK] = uart_txq.buff[(i + drop) & UART_TXQ_MASK]; 
+    }
+
+    uart_txq.head -= drop; 
+    uart_txq.stats.dropped += drop; 
+
+    return (uint16_t)(room + drop); 
+}
+
+
+// Copy data into the queue 
+static void uart_txq_copy(
+    const uint8_t *data, 
+    uint16_t len)
+{
+    uint32_t offset = uart_txq.head & UART_TXQ_MASK; 
+    uint32_t first = UART_TXQ_SIZE - offset; 
+    uint32_t used; 
+
+    first = (len < first) ? len : first; 
+    memcpy((void *)&uart_txq.buff[offset], (const void *)data, first); 
+    memcpy((void *)uart_txq.buff, (const void *)(data + first), len - first); 
+
+    uart_txq.head += len; 
+    uart_txq.stats.queued += len; 
+
+    used = uart_txq.head - uart_txq.tail; 
+
+    if (used > uart_txq.stats.used_max)
+    {
+        uart_txq.stats.used_max = used; 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Interrupt handler 
+
+// DMA stream interrupt handler 
+void uart_txq_dma_handler(void)
+{
+    // The stream is disabled by hardware at the end of a transfer. The flags aren't used 
+    // to check this because the DMA1 handler clears the flags of every stream. 
+    if (!uart_txq.init || !uart_txq.dma_len || (UART_TXQ_STREAM->CR & DMA_SxCR_EN))
+    {
+        return; 
+    }
+
+    UART_TXQ_DMA->HIFCR = UART_TXQ_FLAGS; 
+
+    // The transfer is done - start on the data queued since it started 
+    uart_txq.dma_len = CLEAR; 
+    uart_txq_start(); 
+}
+
+//=======================================================================================
@@ -392,9 +392,8 @@ void hc05_test_app()
     static uint8_t btn_block = CLEAR; 
 
     // Update user input button status 
-    if (handler_flags.tim1_up_tim10_glbl_flag)
+    if (event_take(EVENT_MASK(EVENT_TIM1_UP_TIM10)))
     {
-        handler_flags.tim1_up_tim10_glbl_flag = CLEAR; 
         debounce((uint8_t)gpio_port_read(GPIOC)); 
     }
 
@@ -16,6 +16,13 @@
 // Includes 
 
 #include "hw125_test.h"
+#include "uart_baud.h" 
+#include "sys_time.h" 
+#include "timer_wheel.h" 
+#include "sd_log.h" 
+#include "sd_spi.h" 
+#include "tlog.h" 
+#include "diskio.h" 
 
 //=======================================================================================
 
@@ -26,14 +33,39 @@
 // Conditional compilation 
 #define FORMAT_EXFAT 0 
 #define HW125_CONTROLLER_TEST 0     // For switching between driver and controller testing 
+#define HW125_SD_SPI_DMA 1          // FatFs uses the DMA block driver (sd_spi) - driver test 
+
+// Serial terminal 
+#define HW125_TEST_BAUD 921600      // Serial terminal baud rate 
 
 // File system 
 #define BUFF_SIZE 255 
 
 // User interface 
-#define HW125_NUM_DRIVER_CMDS 17    // Number of driver test commands for the user 
-#define HW125_NUM_CONT_CMDS 18      // Number of controller test commands for the user 
 #define CMD_SIZE 50                 // Max user command string length 
+#define HW125_CMD_FUNC(name, func) &func,   // Command list entry to its callback 
+
+// Logging benchmark 
+#define HW125_LOG_PERIOD 1000       // Time between IMU and ADC samples (us) 
+#define HW125_LOG_FILE "sdlog.bin"  // Log file 
+#define HW125_LOG_IMU_AXES 6        // Accelerometer and gyroscope axes per sample 
+#define HW125_LOG_ADC_CHNLS 4       // ADC channels per sample 
+#define HW125_LOG_KB 1024           // Bytes per KB 
+#define HW125_LOG_US_PER_S 1000000  // Microseconds per second 
+
+// Block transfer benchmark 
+#define HW125_BENCH_FILE "sdbench.bin"   // Benchmark file 
+#define HW125_BENCH_SECTORS 16      // Most sectors per transfer 
+#define HW125_BENCH_FIRST_CLUST 2   // First data cluster number 
+
+// Telemetry log 
+#define HW125_TLOG_FILE "tlog.bin"  // Telemetry log file 
+#define HW125_TLOG_PERIOD 10000     // Time between IMU records (us) 
+#define HW125_TLOG_HEADING_EVERY 10 // IMU records per heading and throttle record 
+#define HW125_TLOG_GPS_EVERY 20     // IMU records per GPS record 
+#define HW125_TLOG_RADIO_EVERY 100  // IMU records per radio record 
+#define HW125_TLOG_SYNC_EVERY 8     // Logging engine buffers written between syncs 
+#define HW125_TLOG_TEXT_LEN 96      // Longest record as a line of text 
 
 // Controller testing 
 #define HW125_NUM_USER_CMDS 10      // Number of defined user commands for controller test 
@@ -104,6 +136,27 @@ void file_seek(void);                 // Navigate the file
 void file_rewind(void);               // Navigate to the beginning of the file 
 void file_fast_fwd(void);             // Navigate to the end of the file 
 void file_remove(void);               // Remove files from the drive 
+void file_log_bench(void);            // Log samples at 1 kHz and report the write rate 
+void file_sd_bench(void);             // Time raw sector writes and reads 
+void file_tlog(void);                 // Log made up telemetry and compare it to text 
+
+// Log a sample - logging benchmark timer callback 
+void file_log_bench_sample(twheel_timer_t *timer); 
+
+// Count main loop passes while the card driver waits - block benchmark idle callback 
+void file_sd_bench_idle(void); 
+
+// Log a round of telemetry - telemetry log timer callback 
+void file_tlog_sample(twheel_timer_t *timer); 
+
+// Write then read back a file's sectors - block benchmark pass 
+void file_sd_bench_run(
+    DWORD sector, 
+    DWORD count, 
+    UINT chunk); 
+
+// Check a file's clusters are in one run - block benchmark file check 
+uint8_t file_sd_bench_contig(FIL *file); 
 
 //==================================================
 
@@ -137,6 +190,17 @@ void display_buffer(void);
 //=======================================================================================
 // Global variables 
 
+// Logging benchmark sample 
+typedef struct hw125_log_sample_s 
+{
+    uint32_t time;                             // Sample time (us) 
+    uint32_t count;                            // Sample number 
+    int16_t imu[HW125_LOG_IMU_AXES];           // Accelerometer and gyroscope readings 
+    uint16_t adc[HW125_LOG_ADC_CHNLS];         // ADC readings 
+}
+hw125_log_sample_t; 
+
+
 // Data record 
 typedef struct hw125_test_record_s 
 {
@@ -169,6 +233,22 @@ typedef struct hw125_test_record_s
     DWORD fre_clust;                      // Stores number of free clusters 
     DWORD total, free_space;              // Total and free volume space 
 
+    // Logging benchmark 
+    FIL log_file;                         // Log file 
+    twheel_timer_t log_timer;             // Sample timer 
+    QWORD log_burst;                      // Samples logged each timer period 
+    volatile uint32_t log_count;          // Samples logged 
+    volatile uint32_t log_append_max;     // Longest sd_log_write call (us) 
+
+    // Block transfer benchmark 
+    FIL bench_file;                       // Benchmark file 
+    BYTE bench_buff[HW125_BENCH_SECTORS * SD_SPI_SECTOR];   // Transfer buffer 
+    volatile uint32_t bench_idle;         // Idle callback calls 
+
+    // Telemetry log 
+    volatile uint32_t tlog_count;         // Telemetry timer periods 
+    volatile uint32_t tlog_text;          // Bytes the records would take as text 
+
     #if FORMAT_EXFAT 
 
     BYTE work[512];                       // Used to format the volume 
@@ -189,36 +269,10 @@ static hw125_test_record_t hw125_test_record;
 // For user input prompt 
 uint8_t action; 
 
-// Command pointers 
-typedef struct hw125_user_cmds_s 
+// User commands - positions match hw125_cont_cmds 
+static void (*const cmd_table[])(void) = 
 {
-    char user_cmds[CMD_SIZE];              // Stores the defined user input commands 
-    void (*fatfs_func_ptrs_t)(void);       // Pointer to FatFs file operation function 
-}
-hw125_user_cmds_t; 
-
-
-// User commands 
-static hw125_user_cmds_t cmd_table[HW125_NUM_CONT_CMDS] = 
-{
-    {"eject",       &hw125_cont_test_eject_set}, 
-    {"insert",      &hw125_cont_test_eject_clear}, 
-    {"reset",       &hw125_cont_test_reset_set}, 
-    {"make_dir",    &hw125_cont_test_make_dir}, 
-    {"open",        &hw125_cont_test_file_open}, 
-    {"close",       &hw125_cont_test_file_close}, 
-    {"write",       &hw125_cont_test_file_write}, 
-    {"puts",        &hw125_cont_test_put_string}, 
-    {"printf",      &hw125_cont_test_printf}, 
-    {"seek",        &hw125_cont_test_file_seek}, 
-    {"state",       &hw125_cont_test_state}, 
-    {"fault_code",  &hw125_cont_test_fault_code}, 
-    {"fault_mode",  &hw125_cont_test_fault_mode}, 
-    {"status",      &hw125_cont_test_file_status}, 
-    {"read",        &hw125_cont_test_file_read}, 
-    {"gets",        &hw125_cont_test_get_string}, 
-    {"eof",         &hw125_cont_test_file_end}, 
-    {"read_buffer", &display_buffer} 
+    HW125_CONT_CMDS(HW125_CMD_FUNC)
 }; 
 
 
@@ -229,35 +283,10 @@ static hw125_user_cmds_t cmd_table[HW125_NUM_CONT_CMDS] =
 extern Disk_drvTypeDef disk;
 
 
-// Command pointers 
-typedef struct hw125_user_cmds_s 
+// User commands - positions match hw125_driver_cmds 
+static void (*const cmd_table[])(void) = 
 {
-    char user_cmds[CMD_SIZE];              // Stores the defined user input commands 
-    void (*fatfs_func_ptrs_t)(void);       // Pointer to FatFs file operation function 
-}
-hw125_user_cmds_t; 
-
-
-// User commands 
-static hw125_user_cmds_t cmd_table[HW125_NUM_DRIVER_CMDS] = 
-{
-    {"f_mount",     &mount_card}, 
-    {"f_unmount",   &unmount_card}, 
-    {"f_cap",       &card_capacity}, 
-    {"f_check",     &file_check}, 
-    {"f_mkdir",     &file_mkdir}, 
-    {"f_open",      &file_open}, 
-    {"f_close",     &file_close}, 
-    {"f_puts",      &file_put_string}, 
-    {"f_gets",      &file_get_string}, 
-    {"f_printf",    &file_printf}, 
-    {"f_write",     &file_write}, 
-    {"f_read",      &file_read}, 
-    {"f_lseek",     &file_seek}, 
-    {"f_rewind",    &file_rewind}, 
-    {"f_fastfwd",   &file_fast_fwd}, 
-    {"f_unlink",    &file_remove}, 
-    {"read_buffer", &display_buffer} 
+    HW125_DRIVER_CMDS(HW125_CMD_FUNC)
 }; 
 
 #endif   // HW125_CONTROLLER_TEST 
@@ -287,6 +316,10 @@ void hw125_test_init()
         TIM_UP_INT_DISABLE); 
     tim_enable(TIM9); 
 
+    // Logging benchmark sample timer 
+    sys_time_init(TIM5, EXTI_PRIORITY_1); 
+    twheel_hw_init(); 
+
     // UART2 for serial terminal communication 
     uart_init(
         USART2, 
@@ -297,6 +330,7 @@ void hw125_test_init()
         UART_MANT_42_9600, 
         UART_DMA_DISABLE, 
         UART_DMA_DISABLE); 
+    uart_baud_set(USART2, HW125_TEST_BAUD, NULL); 
 
     // SPI2 and slave select pin for SD card 
     spi_init(
@@ -318,6 +352,14 @@ void hw125_test_init()
     // SD card user initialization 
     hw125_user_init(SPI2, GPIOB, GPIOX_PIN_12); 
 
+#if !HW125_CONTROLLER_TEST && HW125_SD_SPI_DMA 
+
+    // FatFs drive 0 uses the DMA block driver instead of the HW125 driver 
+    FATFS_UnLinkDriver(USERPath); 
+    FATFS_LinkDriver(&sd_spi_driver, USERPath); 
+
+#endif   // !HW125_CONTROLLER_TEST && HW125_SD_SPI_DMA 
+
 #if HW125_CONTROLLER_TEST 
 
     // hw125 controller 
@@ -352,7 +394,7 @@ void hw125_test_init()
 // Test code 
 void hw125_test_app()
 {
-    hw125_test_record.cmd_index = 0xFF; 
+    hw125_test_record.cmd_index = CMD_REGISTRY_NONE; 
 
 #if HW125_CONTROLLER_TEST 
 
@@ -376,22 +418,14 @@ void hw125_test_app()
                              &hw125_test_record.read_len, 
                              FORMAT_FILE_STRING))
             {
-                // Compare the input to the defined user commands 
-                for (uint8_t i = 0; i < HW125_NUM_CONT_CMDS; i++) 
-                {
-                    if (str_compare(hw125_test_record.cmd_buff, 
-                                    cmd_table[i].user_cmds, 
-                                    BYTE_0)) 
-                    {
-                        hw125_test_record.cmd_index = i; 
-                        break; 
-                    }
-                }
+                // Look up the input in the defined user commands 
+                hw125_test_record.cmd_index = 
+                    cmd_registry_find(&hw125_cont_cmds, hw125_test_record.cmd_buff); 
 
                 // Use the index to call the function as needed 
-                if (hw125_test_record.cmd_index != 0xFF) 
+                if (hw125_test_record.cmd_index != CMD_REGISTRY_NONE) 
                 {
-                    (cmd_table[hw125_test_record.cmd_index].fatfs_func_ptrs_t)(); 
+                    (cmd_table[hw125_test_record.cmd_index])(); 
                 } 
             }
         }
@@ -407,20 +441,14 @@ void hw125_test_app()
         "\r\nOperation >>> ", 
         hw125_test_record.cmd_buff, CMD_SIZE, &hw125_test_record.read_len, FORMAT_FILE_STRING); 
 
-    // Compare the input to the defined user commands 
-    for (uint8_t i = CLEAR; i < HW125_NUM_DRIVER_CMDS; i++) 
-    {
-        if (str_compare(hw125_test_record.cmd_buff, cmd_table[i].user_cmds, BYTE_0)) 
-        {
-            hw125_test_record.cmd_index = i; 
-            break; 
-        }
-    }
+    // Look up the input in the defined user commands 
+    hw125_test_record.cmd_index = 
+        cmd_registry_find(&hw125_driver_cmds, hw125_test_record.cmd_buff); 
 
     // Use the index to call the function as needed 
-    if (hw125_test_record.cmd_index != 0xFF) 
+    if (hw125_test_record.cmd_index != CMD_REGISTRY_NONE) 
     {
-        (cmd_table[hw125_test_record.cmd_index].fatfs_func_ptrs_t)(); 
+        (cmd_table[hw125_test_record.cmd_index])(); 
     } 
 
     // Delay 
@@ -676,6 +704,29 @@ void mount_card(void)
         uart_sendstring(USART2, "\nMounted successfully. Volume type: "); 
 
         // Check the volume type 
+#if HW125_SD_SPI_DMA 
+
+        switch (sd_spi_get_card_type())
+        {
+            case SD_SPI_CT_MMC: 
+                uart_sendstring(USART2, "MMC V3\r\n");
+                break;
+            case SD_SPI_CT_SDC1: 
+                uart_sendstring(USART2, "SDC V1\r\n");
+                break;
+            case SD_SPI_CT_SDC2_BLOCK: 
+                uart_sendstring(USART2, "SDC V2 block\r\n");
+                break;
+            case SD_SPI_CT_SDC2_BYTE: 
+                uart_sendstring(USART2, "SDC V2 byte\r\n");
+                break;
+            default: 
+                uart_sendstring(USART2, "Unknown\r\n");
+                break;
+        }
+
+#else   // HW125_SD_SPI_DMA 
+
         switch (hw125_get_card_type())
         {
             case HW125_CT_MMC: 
@@ -694,6 +745,8 @@ void mount_card(void)
                 uart_sendstring(USART2, "Unknown\r\n");
                 break;
         }
+
+#endif   // HW125_SD_SPI_DMA 
     }
     else 
     {
@@ -987,6 +1040,557 @@ void file_remove(void)
     }
 }
 
+
+// Log samples at 1 kHz and report the write rate 
+void file_log_bench(void) 
+{
+    QWORD duration, sync_every, prealloc; 
+    uint64_t start; 
+    sd_log_stats_t stats; 
+    uint8_t open; 
+
+    // Get the run length, samples per period, sync cadence and file space 
+    get_input(
+        "\nDuration (s): ", 
+        hw125_test_record.buffer, 
+        BUFF_SIZE, 
+        &duration, 
+        FORMAT_FILE_NUM); 
+
+    get_input(
+        "\nSamples per ms: ", 
+        hw125_test_record.buffer, 
+        BUFF_SIZE, 
+        &hw125_test_record.log_burst, 
+        FORMAT_FILE_NUM); 
+
+    get_input(
+        "\nSync every (buffers, 0 to sync at the end): ", 
+        hw125_test_record.buffer, 
+        BUFF_SIZE, 
+        &sync_every, 
+        FORMAT_FILE_NUM); 
+
+    get_input(
+        "\nPre-allocate (KB, 0 to grow the file): ", 
+        hw125_test_record.buffer, 
+        BUFF_SIZE, 
+        &prealloc, 
+        FORMAT_FILE_NUM); 
+
+#if !_USE_EXPAND 
+
+    if (prealloc) 
+    {
+        uart_sendstring(USART2, "\r\nPre-allocation needs _USE_EXPAND in ffconf.h\r\n"); 
+        return; 
+    }
+
+#endif   // !_USE_EXPAND 
+
+    hw125_test_record.fresult = f_open(&hw125_test_record.log_file, 
+                                       HW125_LOG_FILE, 
+                                       FA_CREATE_ALWAYS | FA_WRITE); 
+
+    if (hw125_test_record.fresult != FR_OK) 
+    {
+        uart_sendstring(USART2, "\r\nFailed to open " HW125_LOG_FILE "\r\n"); 
+        return; 
+    }
+
+    // Samples are logged from the timer interrupt while the main loop writes the 
+    // buffers to the card 
+    hw125_test_record.log_count = CLEAR; 
+    hw125_test_record.log_append_max = CLEAR; 
+
+    if (prealloc)
+    {
+        open = sd_log_open_contig(&hw125_test_record.log_file, 
+                                  (FSIZE_t)(prealloc * HW125_LOG_KB), 
+                                  (uint16_t)sync_every); 
+    }
+    else 
+    {
+        open = sd_log_open(&hw125_test_record.log_file, (uint16_t)sync_every); 
+    }
+
+    if (!open) 
+    {
+        uart_sendstring(USART2, "\r\nNo contiguous space for the log\r\n"); 
+        f_close(&hw125_test_record.log_file); 
+        return; 
+    }
+
+    twheel_start(&hw125_test_record.log_timer, HW125_LOG_PERIOD, HW125_LOG_PERIOD, 
+                 file_log_bench_sample, NULL); 
+
+    start = sys_time_us(); 
+
+    while (sys_time_since(start) < (duration * HW125_LOG_US_PER_S)) 
+    {
+        sd_log_service(); 
+    }
+
+    twheel_stop(&hw125_test_record.log_timer); 
+    sd_log_close(); 
+    f_close(&hw125_test_record.log_file); 
+    sd_log_get_stats(&stats); 
+
+    snprintf(hw125_test_record.buffer, BUFF_SIZE, 
+             "\r\n%lu samples, %lu bytes in %lu buffers, %lu syncs\r\n" 
+             "Rate: %lu KB/s, write avg %lu max %lu us, sync max %lu us, "
+             "append max %lu us\r\n", 
+             (unsigned long)stats.records, 
+             (unsigned long)stats.bytes, 
+             (unsigned long)stats.buffers, 
+             (unsigned long)stats.syncs, 
+             (unsigned long)(stats.rate / HW125_LOG_KB), 
+             (unsigned long)stats.write_avg_us, 
+             (unsigned long)stats.write_max_us, 
+             (unsigned long)stats.sync_max_us, 
+             (unsigned long)hw125_test_record.log_append_max); 
+    uart_sendstring(USART2, hw125_test_record.buffer); 
+
+    snprintf(hw125_test_record.buffer, BUFF_SIZE, 
+             "Dropped %lu samples (%lu bytes), %u buffers waiting max, %lu errors\r\n", 
+             (unsigned long)stats.dropped, 
+             (unsigned long)stats.dropped_bytes, 
+             (unsigned)stats.waiting_max, 
+             (unsigned long)stats.errors); 
+    uart_sendstring(USART2, hw125_test_record.buffer); 
+}
+
+
+// Log a sample - logging benchmark timer callback 
+void file_log_bench_sample(twheel_timer_t *timer) 
+{
+    hw125_log_sample_t sample; 
+    uint64_t start = sys_time_us(); 
+    uint32_t time; 
+
+    // Made up readings that change with each sample 
+    for (QWORD i = CLEAR; i < hw125_test_record.log_burst; i++) 
+    {
+        sample.time = (uint32_t)start; 
+        sample.count = hw125_test_record.log_count++; 
+
+        for (uint8_t axis = CLEAR; axis < HW125_LOG_IMU_AXES; axis++) 
+        {
+            sample.imu[axis] = (int16_t)(sample.count * (axis + 1)); 
+        }
+
+        for (uint8_t chnl = CLEAR; chnl < HW125_LOG_ADC_CHNLS; chnl++) 
+        {
+            sample.adc[chnl] = (uint16_t)((sample.count + chnl) & 0x0FFF); 
+        }
+
+        sd_log_write(&sample, sizeof(sample)); 
+    }
+
+    time = (uint32_t)sys_time_since(start); 
+
+    if (time > hw125_test_record.log_append_max) 
+    {
+        hw125_test_record.log_append_max = time; 
+    }
+}
+
+
+// Time raw sector writes and reads 
+void file_sd_bench(void) 
+{
+    QWORD size, chunk; 
+    FATFS *fs; 
+    DWORD sector, count; 
+
+    // Get the amount of data and the transfer size 
+    get_input(
+        "\nSize (KB): ", 
+        hw125_test_record.buffer, 
+        BUFF_SIZE, 
+        &size, 
+        FORMAT_FILE_NUM); 
+
+    get_input(
+        "\nSectors per transfer (1-16): ", 
+        hw125_test_record.buffer, 
+        BUFF_SIZE, 
+        &chunk, 
+        FORMAT_FILE_NUM); 
+
+    if (!size || !chunk || (chunk > HW125_BENCH_SECTORS)) 
+    {
+        uart_sendstring(USART2, "\r\nInvalid size\r\n"); 
+        return; 
+    }
+
+    // The sectors of a contiguous file are used so nothing else on the card is touched 
+    hw125_test_record.fresult = f_open(&hw125_test_record.bench_file, 
+                                       HW125_BENCH_FILE, 
+                                       FA_CREATE_ALWAYS | FA_WRITE | FA_READ); 
+
+    if (hw125_test_record.fresult == FR_OK) 
+    {
+#if _USE_EXPAND 
+
+        hw125_test_record.fresult = f_expand(&hw125_test_record.bench_file, 
+                                             (FSIZE_t)(size * HW125_LOG_KB), 
+                                             SET); 
+
+#else   // _USE_EXPAND 
+
+        // Seeking past the end grows the file. The clusters it gets are only used if 
+        // they came out in one run. 
+        hw125_test_record.fresult = f_lseek(&hw125_test_record.bench_file, 
+                                            (FSIZE_t)(size * HW125_LOG_KB)); 
+
+        if ((hw125_test_record.fresult == FR_OK) && 
+            ((f_tell(&hw125_test_record.bench_file) != (FSIZE_t)(size * HW125_LOG_KB)) || 
+             !file_sd_bench_contig(&hw125_test_record.bench_file))) 
+        {
+            hw125_test_record.fresult = FR_DENIED; 
+        }
+
+#endif   // _USE_EXPAND 
+    }
+
+    if (hw125_test_record.fresult != FR_OK) 
+    {
+        uart_sendstring(USART2, "\r\nNo contiguous space for " HW125_BENCH_FILE "\r\n"); 
+        f_close(&hw125_test_record.bench_file); 
+        f_unlink(HW125_BENCH_FILE); 
+        return; 
+    }
+
+    fs = hw125_test_record.bench_file.obj.fs; 
+    sector = fs->database + 
+             (DWORD)fs->csize * (hw125_test_record.bench_file.obj.sclust - 
+                                 HW125_BENCH_FIRST_CLUST); 
+    count = (DWORD)((size * HW125_LOG_KB) / SD_SPI_SECTOR); 
+
+#if HW125_SD_SPI_DMA 
+
+    // Polled then DMA data transfers. The idle callback stands in for a control loop. 
+    sd_spi_set_idle(file_sd_bench_idle); 
+
+    for (uint8_t dma = CLEAR; dma <= SET; dma++) 
+    {
+        sd_spi_set_dma(dma); 
+        uart_sendstring(USART2, dma ? "\r\nDMA    - " : "\r\nPolled - "); 
+        file_sd_bench_run(sector, count, (UINT)chunk); 
+    }
+
+    sd_spi_set_idle(NULL); 
+
+#else   // HW125_SD_SPI_DMA 
+
+    uart_sendstring(USART2, "\r\nHW125  - "); 
+    file_sd_bench_run(sector, count, (UINT)chunk); 
+
+#endif   // HW125_SD_SPI_DMA 
+
+    f_close(&hw125_test_record.bench_file); 
+    f_unlink(HW125_BENCH_FILE); 
+}
+
+
+// Check a file's clusters are in one run - block benchmark file check 
+uint8_t file_sd_bench_contig(FIL *file) 
+{
+    FSIZE_t csize = (FSIZE_t)file->obj.fs->csize * SD_SPI_SECTOR; 
+
+    // A seek leaves clust on the cluster holding the byte before the new position so 
+    // each cluster is checked one byte into it 
+    for (FSIZE_t ofs = CLEAR; ofs < f_size(file); ofs += csize) 
+    {
+        if ((f_lseek(file, ofs + 1) != FR_OK) || 
+            (file->clust != (file->obj.sclust + (DWORD)(ofs / csize)))) 
+        {
+            return FALSE; 
+        }
+    }
+
+    return TRUE; 
+}
+
+
+// Count main loop passes while the card driver waits - block benchmark idle callback 
+void file_sd_bench_idle(void) 
+{
+    hw125_test_record.bench_idle++; 
+}
+
+
+// Write then read back a file's sectors - block benchmark pass 
+void file_sd_bench_run(
+    DWORD sector, 
+    DWORD count, 
+    UINT chunk) 
+{
+    BYTE *buff = hw125_test_record.bench_buff; 
+    BYTE pdrv = hw125_test_record.bench_file.obj.fs->drv; 
+    DRESULT result = RES_OK; 
+    uint64_t start, write_us = CLEAR, read_us = CLEAR; 
+    uint64_t kb_us = (uint64_t)count * SD_SPI_SECTOR * HW125_LOG_US_PER_S / HW125_LOG_KB; 
+    uint32_t write_idle, bad = CLEAR; 
+    DWORD done, n, tag; 
+    BYTE *data; 
+    uint8_t ok; 
+
+    // Each sector starts with its number followed by a fixed pattern 
+    for (UINT i = CLEAR; i < sizeof(hw125_test_record.bench_buff); i++) 
+    {
+        buff[i] = (BYTE)i; 
+    }
+
+    // Only the disk calls are timed. The size is scaled so dividing by the time gives 
+    // KB/s. 
+    hw125_test_record.bench_idle = CLEAR; 
+
+    for (done = CLEAR; (done < count) && (result == RES_OK); done += n) 
+    {
+        n = ((count - done) < chunk) ? (count - done) : chunk; 
+
+        for (DWORD i = CLEAR; i < n; i++) 
+        {
+            tag = done + i; 
+            memcpy((void *)&buff[i * SD_SPI_SECTOR], (void *)&tag, sizeof(tag)); 
+        }
+
+        start = sys_time_us(); 
+        result = disk_write(pdrv, buff, sector + done, (UINT)n); 
+        write_us += sys_time_since(start); 
+    }
+
+    start = sys_time_us(); 
+    result = (result == RES_OK) ? disk_ioctl(pdrv, CTRL_SYNC, NULL) : result; 
+    write_us += sys_time_since(start); 
+    write_idle = hw125_test_record.bench_idle; 
+
+    hw125_test_record.bench_idle = CLEAR; 
+
+    for (done = CLEAR; (done < count) && (result == RES_OK); done += n) 
+    {
+        n = ((count - done) < chunk) ? (count - done) : chunk; 
+
+        start = sys_time_us(); 
+        result = disk_read(pdrv, buff, sector + done, (UINT)n); 
+        read_us += sys_time_since(start); 
+
+        // Check each sector's number and pattern 
+        for (DWORD i = CLEAR; i < n; i++) 
+        {
+            data = &buff[i * SD_SPI_SECTOR]; 
+            memcpy((void *)&tag, (void *)data, sizeof(tag)); 
+            ok = (tag == (done + i)); 
+
+            for (UINT j = sizeof(tag); ok && (j < SD_SPI_SECTOR); j++) 
+            {
+                ok = (data[j] == (BYTE)j); 
+            }
+
+            bad += !ok; 
+        }
+    }
+
+    if (result != RES_OK) 
+    {
+        snprintf(hw125_test_record.buffer, BUFF_SIZE, "disk error %u\r\n", (unsigned)result); 
+        uart_sendstring(USART2, hw125_test_record.buffer); 
+        return; 
+    }
+
+    snprintf(hw125_test_record.buffer, BUFF_SIZE, 
+             "write %lu KB/s (%lu idle calls), read %lu KB/s (%lu idle calls), " 
+             "%lu bad sectors\r\n", 
+             (unsigned long)(write_us ? (kb_us / write_us) : CLEAR), 
+             (unsigned long)write_idle, 
+             (unsigned long)(read_us ? (kb_us / read_us) : CLEAR), 
+             (unsigned long)hw125_test_record.bench_idle, 
+             (unsigned long)bad); 
+    uart_sendstring(USART2, hw125_test_record.buffer); 
+}
+
+
+// Log made up telemetry and compare it to text 
+void file_tlog(void) 
+{
+    QWORD duration, prealloc; 
+    uint64_t start; 
+    tlog_stats_t stats; 
+    uint32_t size; 
+
+    // Get the run length and file space 
+    get_input(
+        "\nDuration (s): ", 
+        hw125_test_record.buffer, 
+        BUFF_SIZE, 
+        &duration, 
+        FORMAT_FILE_NUM); 
+
+    get_input(
+        "\nPre-allocate (KB, 0 to grow the file): ", 
+        hw125_test_record.buffer, 
+        BUFF_SIZE, 
+        &prealloc, 
+        FORMAT_FILE_NUM); 
+
+#if !_USE_EXPAND 
+
+    if (prealloc) 
+    {
+        uart_sendstring(USART2, "\r\nPre-allocation needs _USE_EXPAND in ffconf.h\r\n"); 
+        return; 
+    }
+
+#endif   // !_USE_EXPAND 
+
+    hw125_test_record.fresult = f_open(&hw125_test_record.log_file, 
+                                       HW125_TLOG_FILE, 
+                                       FA_CREATE_ALWAYS | FA_WRITE); 
+
+    if (hw125_test_record.fresult != FR_OK) 
+    {
+        uart_sendstring(USART2, "\r\nFailed to open " HW125_TLOG_FILE "\r\n"); 
+        return; 
+    }
+
+    if (!tlog_open(&hw125_test_record.log_file, 
+                   (FSIZE_t)(prealloc * HW125_LOG_KB), 
+                   HW125_TLOG_SYNC_EVERY)) 
+    {
+        uart_sendstring(USART2, "\r\nNo contiguous space for the log\r\n"); 
+        f_close(&hw125_test_record.log_file); 
+        return; 
+    }
+
+    // Records are logged from the timer interrupt while the main loop writes the 
+    // buffers to the card 
+    hw125_test_record.tlog_count = CLEAR; 
+    hw125_test_record.tlog_text = CLEAR; 
+
+    twheel_start(&hw125_test_record.log_timer, HW125_TLOG_PERIOD, HW125_TLOG_PERIOD, 
+                 file_tlog_sample, NULL); 
+
+    start = sys_time_us(); 
+
+    while (sys_time_since(start) < (duration * HW125_LOG_US_PER_S)) 
+    {
+        sd_log_service(); 
+    }
+
+    twheel_stop(&hw125_test_record.log_timer); 
+    tlog_close(); 
+    size = (uint32_t)f_size(&hw125_test_record.log_file); 
+    f_close(&hw125_test_record.log_file); 
+    tlog_get_stats(&stats); 
+
+    snprintf(hw125_test_record.buffer, BUFF_SIZE, 
+             "\r\n%lu records (%lu dropped), %lu data and %lu index chunks\r\n" 
+             "File %lu bytes (records %lu, padding %lu), as text %lu bytes\r\n", 
+             (unsigned long)stats.records, 
+             (unsigned long)stats.dropped, 
+             (unsigned long)stats.data_chunks, 
+             (unsigned long)stats.index_chunks, 
+             (unsigned long)size, 
+             (unsigned long)stats.record_bytes, 
+             (unsigned long)stats.pad_bytes, 
+             (unsigned long)hw125_test_record.tlog_text); 
+    uart_sendstring(USART2, hw125_test_record.buffer); 
+}
+
+
+// Log a round of telemetry - telemetry log timer callback 
+void file_tlog_sample(twheel_timer_t *timer) 
+{
+    uint32_t count = hw125_test_record.tlog_count++; 
+    uint32_t time = (uint32_t)(sys_time_us() / DIVIDE_1000); 
+    char text[HW125_TLOG_TEXT_LEN]; 
+    int len = CLEAR; 
+    tlog_imu_t imu; 
+    tlog_heading_t heading; 
+    tlog_throttle_t throttle; 
+    tlog_gps_t gps; 
+    tlog_radio_t radio; 
+
+    // Made up readings that change with each period. The same record written as a 
+    // line of text (the way f_printf would) is counted for comparison. 
+    for (uint8_t axis = CLEAR; axis < TLOG_IMU_AXES; axis++) 
+    {
+        imu.accel[axis] = (int16_t)(count * (axis + 1)); 
+        imu.gyro[axis] = (int16_t)(count * (axis + 4)); 
+    }
+
+    if (tlog_imu(&imu)) 
+    {
+        len += snprintf(text, sizeof(text), "%lu,IMU,%d,%d,%d,%d,%d,%d\n", 
+                        (unsigned long)time, imu.accel[0], imu.accel[1], imu.accel[2], 
+                        imu.gyro[0], imu.gyro[1], imu.gyro[2]); 
+    }
+
+    if (!(count % HW125_TLOG_HEADING_EVERY)) 
+    {
+        heading.heading = (uint16_t)(count % 3600); 
+        heading.target = 900; 
+        throttle.throttle[TLOG_RIGHT] = (int16_t)(count % 200) - 100; 
+        throttle.throttle[TLOG_LEFT] = 100 - (int16_t)(count % 200); 
+
+        if (tlog_heading(&heading)) 
+        {
+            len += snprintf(text, sizeof(text), "%lu,HDG,%u.%u,%u.%u\n", 
+                            (unsigned long)time, heading.heading / 10, 
+                            heading.heading % 10, heading.target / 10, 
+                            heading.target % 10); 
+        }
+
+        if (tlog_throttle(&throttle)) 
+        {
+            len += snprintf(text, sizeof(text), "%lu,THR,%d,%d\n", (unsigned long)time, 
+                            throttle.throttle[TLOG_RIGHT], 
+                            throttle.throttle[TLOG_LEFT]); 
+        }
+    }
+
+    if (!(count % HW125_TLOG_GPS_EVERY)) 
+    {
+        gps.lat = 451234567 + (int32_t)count; 
+        gps.lon = -751234567 - (int32_t)count; 
+        gps.alt = 7000 + (int32_t)(count % 100); 
+        gps.speed = (uint16_t)(count % 500); 
+        gps.fix = 3; 
+        gps.sats = 9; 
+
+        if (tlog_gps(&gps)) 
+        {
+            len += snprintf(text, sizeof(text), 
+                            "%lu,GPS,%ld.%07ld,-%ld.%07ld,%ld.%02ld,%u.%02u,%u,%u\n", 
+                            (unsigned long)time, (long)(gps.lat / 10000000), 
+                            (long)(gps.lat % 10000000), (long)(-gps.lon / 10000000), 
+                            (long)(-gps.lon % 10000000), (long)(gps.alt / 100), 
+                            (long)(gps.alt % 100), gps.speed / 100, gps.speed % 100, 
+                            gps.fix, gps.sats); 
+        }
+    }
+
+    if (!(count % HW125_TLOG_RADIO_EVERY)) 
+    {
+        radio.link = (uint8_t)(100 - (count % 5)); 
+        radio.channel = 76; 
+        radio.frames = 50; 
+        radio.lost = (uint16_t)(count % 3); 
+        radio.bad = CLEAR; 
+
+        if (tlog_radio(&radio)) 
+        {
+            len += snprintf(text, sizeof(text), "%lu,RAD,%u,%u,%u,%u,%u\n", 
+                            (unsigned long)time, radio.link, radio.channel, 
+                            radio.frames, radio.lost, radio.bad); 
+        }
+    }
+
+    hw125_test_record.tlog_text += (uint32_t)len; 
+}
+
 #endif   // HW125_CONTROLLER_TEST
 
 // Get user inputs 
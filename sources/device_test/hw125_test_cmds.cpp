@@ -0,0 +1,37 @@
+/**
+ * @file hw125_test_cmds.cpp 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief HW125 test command registries 
+ * 
+ * @details Built at compile time from the command lists in hw125_test.h. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "hw125_test.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Command registries 
+
+static constexpr auto hw125_cont_table = 
+    cmd_registry_make({ HW125_CONT_CMDS(CMD_REGISTRY_NAME) }); 
+
+static constexpr auto hw125_driver_table = 
+    cmd_registry_make({ HW125_DRIVER_CMDS(CMD_REGISTRY_NAME) }); 
+
+constexpr cmd_registry_t hw125_cont_cmds = hw125_cont_table.registry(); 
+constexpr cmd_registry_t hw125_driver_cmds = hw125_driver_table.registry(); 
+
+//=======================================================================================
@@ -206,9 +206,8 @@ void lsm303agr_test_app(void)
     // Test code for the LSM303AGR here 
 
     // Periodically update and display data 
-    if (handler_flags.tim1_up_tim10_glbl_flag)
+    if (event_take(EVENT_MASK(EVENT_TIM1_UP_TIM10)))
     {
-        handler_flags.tim1_up_tim10_glbl_flag = CLEAR; 
         test_data.schedule_counter++; 
         
         // Update the magnetometer data 
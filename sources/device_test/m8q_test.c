@@ -18,6 +18,8 @@
 #include "m8q_test.h"
 #include "m8q_config.h"
 #include "stm32f4xx_it.h" 
+#include "uart_tx_queue.h" 
+#include "uart_baud.h" 
 
 //=======================================================================================
 
@@ -46,6 +48,7 @@
 #define M8Q_TEST_0_READ_COUNT_LIM 90 
 #define M8Q_TEST_0_OVERFLOW_COUNT_LO 40 
 #define M8Q_TEST_0_OVERFLOW_COUNT_HI 70 
+#define M8Q_TEST_0_BAUD 921600       // Serial terminal baud rate 
 
 // Test 1 
 #define M8Q_TEST_1_DATA_BUFF_LIM 0 
@@ -168,6 +171,11 @@ void m8q_test_0_init(void)
 
         while (TRUE); 
     }
+
+    // The data stream is sent through the transmit queue so reading the device isn't 
+    // held up by the serial terminal. A stream that doesn't fit in the queue is dropped. 
+    uart_baud_set(USART2, M8Q_TEST_0_BAUD, NULL); 
+    uart_txq_init(UART_TXQ_DROP, EXTI_PRIORITY_1); 
 }
 
 
@@ -312,8 +320,8 @@ void m8q_test_0(void)
                 {
                     case M8Q_OK: 
                         // Output the data stream 
-                        uart_send_new_line(USART2); 
-                        uart_sendstring(USART2, (char *)test_data.data_stream); 
+                        uart_txq_puts("\r\n"); 
+                        uart_txq_puts((char *)test_data.data_stream); 
                         break; 
 
                     case M8Q_NO_DATA_AVAILABLE: 
@@ -322,20 +330,20 @@ void m8q_test_0(void)
 
                     case M8Q_DATA_BUFF_OVERFLOW: 
                         // Indicate an overflow (data stream larger than max allowed buffer size) 
-                        uart_sendstring(USART2, "\r\nBuffer overflow. Stream cleared.\r\n"); 
+                        uart_txq_puts("\r\nBuffer overflow. Stream cleared.\r\n"); 
                         break; 
 
                     default:   // Everything else 
                         // Output the fault status 
-                        uart_sendstring(USART2, "\r\nDriver fault: "); 
-                        uart_send_integer(USART2, (int16_t)driver_status); 
-                        uart_send_new_line(USART2); 
+                        uart_txq_puts("\r\nDriver fault: "); 
+                        uart_txq_send_integer((int32_t)driver_status); 
+                        uart_txq_puts("\r\n"); 
                         break; 
                 }
             }
             else if (test_data.schedule_counter == M8Q_TEST_0_OVERFLOW_COUNT_LO)
             {
-                uart_sendstring(USART2, "\r\nRead pause.\r\n"); 
+                uart_txq_puts("\r\nRead pause.\r\n"); 
             }
             else 
             {
@@ -459,9 +467,8 @@ void m8q_test_2(void)
 // Common/shared test code 
 void m8q_test_general(void)
 {
-    if (handler_flags.tim1_up_tim10_glbl_flag)
+    if (event_take(EVENT_MASK(EVENT_TIM1_UP_TIM10)))
     {
-        handler_flags.tim1_up_tim10_glbl_flag = CLEAR; 
         test_data.schedule_counter++; 
         test_data.attempt_flag = SET_BIT; 
     }
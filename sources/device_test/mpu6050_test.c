@@ -16,6 +16,7 @@
 // Includes 
 
 #include "mpu6050_test.h"
+#include "sys_time.h" 
 
 //=======================================================================================
 
@@ -37,6 +38,7 @@
 // Driver test 
 #define MPU6050_DRIVER_LOOP_DELAY 100    // Delay (blocking) between code loops (ms) 
 #define MPU6050_DRIVER_ST_DELAY 10       // Delay (blocking) after self test (ms) 
+#define MPU6050_TIME_STR_LEN 40          // Sample time output string length 
 
 // Controller test 
 #define MPU6050_NUM_TEST_CMDS 17         // Number of controller test commands for the user 
@@ -137,6 +139,9 @@ void mpu6050_test_init()
         TIM_UP_INT_DISABLE); 
     tim_enable(TIM9); 
 
+    // Sample timestamps 
+    sys_time_init(TIM5, EXTI_PRIORITY_1); 
+
     // Initialize UART2
     uart_init(
         USART2, 
@@ -464,9 +469,15 @@ void mpu6050_test_app()
     static int16_t mpu6050_temp_sensor; 
     static float mpu6050_accel[MPU6050_NUM_AXIS]; 
     static float mpu6050_gyro[MPU6050_NUM_AXIS]; 
+    static uint64_t mpu6050_read_time; 
+    uint64_t mpu6050_read_interval; 
+    char time_str[MPU6050_TIME_STR_LEN]; 
 
-    // Update the accelerometer, temperature and gyroscope readings for device one 
+    // Update the accelerometer, temperature and gyroscope readings for device one and 
+    // timestamp the sample on the system clock 
     mpu6050_read_all(DEVICE_ONE); 
+    mpu6050_read_interval = sys_time_since(mpu6050_read_time); 
+    mpu6050_read_time += mpu6050_read_interval; 
 
     // Get the formatted temp (degC), accelerometer (g's) and gyroscope (deg/s) data 
     mpu6050_temp_sensor = (int16_t)(mpu6050_get_temp(DEVICE_ONE) * SCALE_100); 
@@ -482,6 +493,11 @@ void mpu6050_test_app()
         &mpu6050_gyro[MPU6050_Z_AXIS]); 
 
     // Display the first device results - values are scaled to remove decimal 
+    snprintf(time_str, sizeof(time_str), "t1 = %lu ms  dt1 = %lu us  ", 
+             (unsigned long)(mpu6050_read_time / 1000), 
+             (unsigned long)mpu6050_read_interval); 
+    uart_sendstring(USART2, time_str); 
+
     uart_sendstring(USART2, "temp1 = ");
     uart_send_integer(USART2, mpu6050_temp_sensor);
     uart_send_spaces(USART2, UART_SPACE_2);
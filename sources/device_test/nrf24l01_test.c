@@ -24,6 +24,14 @@
 #include "nrf24l01_test.h" 
 #include "nrf24l01_config.h" 
 #include "stm32f4xx_it.h" 
+#include "bench_test.h" 
+#include "timer_wheel.h" 
+#include "sys_time.h" 
+#include "nrf24l01_rx.h" 
+#include "rc_frame.h" 
+#include "nrf24l01_ack.h" 
+#include "nrf24l01_link.h" 
+#include "nrf24l01_survey.h" 
 
 //=======================================================================================
 
@@ -41,6 +49,8 @@
 // Test code 
 #define NRF24L01_HEARTBEAT 1          // Heartbeat 
 #define NRF24L01_MANUAL_CONTROL 0     // Perform actions based on user input 
+#define NRF24L01_LINK_BENCH 0         // Link throughput and latency benchmark 
+#define NRF24L01_CHANNEL_SURVEY 0     // RF channel survey and channel change 
 
 // Hardware 
 #define NRF24L01_TEST_SCREEN 0        // HD44780U screen in the system - shuts screen off 
@@ -51,7 +61,6 @@
 #define NRF24L01_RF_FREQ 10           // Comm frequency: 2400 MHz + this value (MHz) 
 
 // User commands 
-#define NUM_USER_CMDS 4               // Number of test states 
 
 //=======================================================================================
 
@@ -63,14 +72,17 @@
 typedef struct nrf24l01_test_trackers_s 
 {
     // Timing information 
-    TIM_TypeDef *timer_nonblocking;                // Timer used for non-blocking delays 
-    tim_compare_t delay_timer;                     // Delay timing info 
+    twheel_timer_t delay_timer;                    // Periodic action timer (timer wheel) 
 
     // Configuration 
     nrf24l01_data_pipe_t pipe; 
 
     // Payload data 
     uint8_t read_buff[NRF24L01_MAX_PAYLOAD_LEN];   // Data read by PRX from PTX device 
+    nrf24l01_rx_payload_t rx_payload;              // Payload taken from the receive ring 
+
+    // Channel survey 
+    uint8_t link_up;                               // Last keep alive was acknowledged 
 }
 nrf24l01_test_trackers_t; 
 
@@ -88,6 +100,10 @@ void nrf24l01_heartbeat_test_init(void);
 void nrf24l01_manual_control_test_init(void); 
 void nrf24l01_heartbeat_test_loop(void); 
 void nrf24l01_manual_control_test_loop(void); 
+void nrf24l01_link_bench_test_init(void); 
+void nrf24l01_link_bench_test_loop(void); 
+void nrf24l01_channel_survey_test_init(void); 
+void nrf24l01_channel_survey_test_loop(void); 
 
 
 /**
@@ -95,6 +111,16 @@ void nrf24l01_manual_control_test_loop(void);
  */
 void nrf24l01_test_user_prompt(void); 
 
+
+/**
+ * @brief Take a payload for the test's data pipe from the receive ring 
+ * 
+ * @details Copies the payload to the read buffer. Payloads from other pipes are dropped. 
+ * 
+ * @return uint8_t : TRUE if a payload was taken 
+ */
+static uint8_t nrf24l01_test_receive(void); 
+
 //=======================================================================================
 
 
@@ -187,12 +213,10 @@ void nrf24l01_test_init(void)
     //==================================================
     // Initialize test data 
 
-    // Timing 
-    nrf24l01_test.timer_nonblocking = TIM9; 
-    nrf24l01_test.delay_timer.clk_freq = tim_get_pclk_freq(nrf24l01_test.timer_nonblocking); 
-    nrf24l01_test.delay_timer.time_cnt_total = CLEAR; 
-    nrf24l01_test.delay_timer.time_cnt = CLEAR; 
-    nrf24l01_test.delay_timer.time_start = SET_BIT; 
+    // Timing - non-blocking delays run on the timer wheel, which shares the system 
+    // clock timer. Each test sets the period of the delay timer. 
+    sys_time_init(TIM5, EXTI_PRIORITY_1); 
+    twheel_hw_init(); 
 
     // Configuration 
     nrf24l01_test.pipe = NRF24L01_DP_1; 
@@ -237,12 +261,20 @@ void nrf24l01_test_init(void)
         uart_sendstring(USART2, "nRF24L01 init success."); 
     }
 
+    // Payloads are read into a ring by the radio's IRQ pin interrupt so the tests take 
+    // them as they arrive instead of polling the radio over SPI 
+    nrf24l01_rx_init(EXTI_PRIORITY_2); 
+
     //==================================================
 
 #if NRF24L01_HEARTBEAT 
     nrf24l01_heartbeat_test_init(); 
 #elif NRF24L01_MANUAL_CONTROL 
     nrf24l01_manual_control_test_init(); 
+#elif NRF24L01_LINK_BENCH 
+    nrf24l01_link_bench_test_init(); 
+#elif NRF24L01_CHANNEL_SURVEY 
+    nrf24l01_channel_survey_test_init(); 
 #endif 
 }
 
@@ -258,9 +290,30 @@ void nrf24l01_test_app(void)
     nrf24l01_heartbeat_test_loop(); 
 #elif NRF24L01_MANUAL_CONTROL 
     nrf24l01_manual_control_test_loop(); 
+#elif NRF24L01_LINK_BENCH 
+    nrf24l01_link_bench_test_loop(); 
+#elif NRF24L01_CHANNEL_SURVEY 
+    nrf24l01_channel_survey_test_loop(); 
 #endif 
 }
 
+
+// Take a payload for the test's data pipe from the receive ring 
+static uint8_t nrf24l01_test_receive(void)
+{
+    while (nrf24l01_rx_read(&nrf24l01_test.rx_payload))
+    {
+        if (nrf24l01_test.rx_payload.pipe == nrf24l01_test.pipe)
+        {
+            memcpy((void *)nrf24l01_test.read_buff, (void *)nrf24l01_test.rx_payload.data, 
+                   sizeof(nrf24l01_test.read_buff)); 
+            return TRUE; 
+        }
+    }
+
+    return FALSE; 
+}
+
 //=======================================================================================
 
 
@@ -281,7 +334,7 @@ void nrf24l01_test_app(void)
 //==================================================
 // Macros 
 
-#define HB_PERIOD 50000             // Time between checking for new data (us) 
+#define HB_PERIOD 50000             // Time between heartbeat send checks (us) 
 #define HB_SEND_TIMER 40            // Counter to control message send frequency 
 
 #define HB_LETTER_O 0x6F            // ASCII for lowercase "o" 
@@ -339,6 +392,8 @@ void nrf24l01_heartbeat_test_init(void)
 
 #elif NRF24L01_SYSTEM_2 
 #endif 
+
+    twheel_start(&nrf24l01_test.delay_timer, HB_PERIOD, HB_PERIOD, NULL, NULL); 
 }
 
 //==================================================
@@ -349,23 +404,15 @@ void nrf24l01_heartbeat_test_init(void)
 
 void nrf24l01_heartbeat_test_loop(void)
 {
-    // Periodically check for action items 
-    if (tim_compare(nrf24l01_test.timer_nonblocking, 
-                    nrf24l01_test.delay_timer.clk_freq, 
-                    HB_PERIOD, 
-                    &nrf24l01_test.delay_timer.time_cnt_total, 
-                    &nrf24l01_test.delay_timer.time_cnt, 
-                    &nrf24l01_test.delay_timer.time_start))
-    {
-        // time_start flag does not need to be set again because this timer runs 
-        // continuously. 
-
 #if NRF24L01_SYSTEM_1 
 
+    // Periodically check for action items 
+    if (twheel_take(&nrf24l01_test.delay_timer))
+    {
         // Send heartbeat message periodically 
         if (!hb_test.send_timer++)
         {
-            if (nrf24l01_send_payload((uint8_t *)hb_test.hb_msg) == NRF24L01_OK)
+            if (nrf24l01_rx_send((uint8_t *)hb_test.hb_msg) == NRF24L01_OK)
             {
                 // Toggle the board LED 
                 hb_test.led_state = GPIO_HIGH - hb_test.led_state; 
@@ -382,52 +429,48 @@ void nrf24l01_heartbeat_test_loop(void)
         {
             hb_test.send_timer = CLEAR; 
         }
+    }
 
-        // Look for a heartbeat response 
-        if (nrf24l01_data_ready_status() == nrf24l01_test.pipe)
+    // Look for a heartbeat response 
+    while (nrf24l01_test_receive())
+    {
+        // Check if the received message is the one we need 
+        if (!strcmp((char *)nrf24l01_test.read_buff, hb_test.hb_res))
         {
-            nrf24l01_receive_payload(nrf24l01_test.read_buff); 
-
-            // Check if the received message is the one we need 
-            if (!strcmp((char *)nrf24l01_test.read_buff, hb_test.hb_res))
-            {
-                // Display the response and update the heatbeat message and response 
-                uart_sendstring(USART2, (char *)nrf24l01_test.read_buff); 
-                hb_test.msg_counter++; 
-                snprintf(hb_test.hb_msg, NRF24L01_MAX_PAYLOAD_LEN, 
-                         hb_message, hb_test.msg_counter); 
-                snprintf(hb_test.hb_res, NRF24L01_MAX_PAYLOAD_LEN, 
-                         hb_response, hb_test.msg_counter); 
-            }
+            // Display the response and update the heatbeat message and response 
+            uart_sendstring(USART2, (char *)nrf24l01_test.read_buff); 
+            hb_test.msg_counter++; 
+            snprintf(hb_test.hb_msg, NRF24L01_MAX_PAYLOAD_LEN, 
+                     hb_message, hb_test.msg_counter); 
+            snprintf(hb_test.hb_res, NRF24L01_MAX_PAYLOAD_LEN, 
+                     hb_response, hb_test.msg_counter); 
         }
+    }
 
 #elif NRF24L01_SYSTEM_2 
 
-        // Look for a heartbeat message 
-        if (nrf24l01_data_ready_status() == nrf24l01_test.pipe)
+    // Look for a heartbeat message and respond as soon as it's received 
+    while (nrf24l01_test_receive())
+    {
+        // Modify the received message to get the desired response (changes "ping#" 
+        // to "pong#!"). Note that the contents of the received message is not 
+        // checked on purpose as it's not necessary for this test. 
+        uint8_t msg_index = 1; 
+        nrf24l01_test.read_buff[msg_index] = HB_LETTER_O; 
+        
+        while (nrf24l01_test.read_buff[msg_index] != NULL_CHAR) 
         {
-            nrf24l01_receive_payload(nrf24l01_test.read_buff); 
-
-            // Modify the received message to get the desired response (changes "ping#" 
-            // to "pong#!"). Note that the contents of the received message is not 
-            // checked on purpose as it's not necessary for this test. 
-            uint8_t msg_index = 1; 
-            nrf24l01_test.read_buff[msg_index] = HB_LETTER_O; 
-            
-            while (nrf24l01_test.read_buff[msg_index] != NULL_CHAR) 
-            {
-                msg_index++; 
-            }
+            msg_index++; 
+        }
 
-            nrf24l01_test.read_buff[msg_index] = HB_EXCLAMATION; 
-            nrf24l01_test.read_buff[++msg_index] = NULL_CHAR; 
+        nrf24l01_test.read_buff[msg_index] = HB_EXCLAMATION; 
+        nrf24l01_test.read_buff[++msg_index] = NULL_CHAR; 
 
-            // Send the response back 
-            nrf24l01_send_payload(nrf24l01_test.read_buff); 
-        }
+        // Send the response back 
+        nrf24l01_rx_send(nrf24l01_test.read_buff); 
+    }
 
 #endif 
-    }
 }
 
 //==================================================
@@ -446,21 +489,13 @@ void nrf24l01_heartbeat_test_loop(void)
 //     match it to one of the pre-defined commands. If a command is matched then execute 
 //     the command callback. If not then do nothing. 
 //   - Commands are used to change device settings and ping the second system. 
-//   - Periodically looks for a message from the second system. The second system will 
-//     only send a message when responding to a ping. 
+//   - Looks for a message from the second system as it arrives. The second system 
+//     will only send a message when responding to a ping. 
 // - System 2: 
-//   - Periodically check for a ping message from system 1. If a message is received then 
+//   - Check for a ping message from system 1 as it arrives. If a message is received then 
 //     the message is checked to see if it matches the ping message. If there is a match 
 //     then a response is sent. 
 
-//==================================================
-// Macros 
-
-#define MC_PERIOD 50000   // Time between checking for new data (us) 
-
-//==================================================
-
-
 //==================================================
 // Prototypes 
 
@@ -554,23 +589,17 @@ ping_res[] = "pong";
 
 #if NRF24L01_SYSTEM_1 
 
-// User commands and feedback 
+// User feedback 
 static const char 
-set_ch[] = "channel", 
-set_dr[] = "data_rate", 
-set_pwr[] = "power", 
 update_success[] = "Success.", 
 update_failed[] = "Failed.", 
 invalid_value[] = "Invalid command value.", 
 ping_failed[] = "Ping failed to send."; 
 
-// Command table 
-static const nrf24l01_cmds_t mc_cmd_table[NUM_USER_CMDS] = 
+// Command callbacks - positions match nrf24l01_mc_cmds 
+static const nrf24l01_cmd_ptr_t mc_cmd_table[] = 
 {
-    {ping_msg, &nrf24l01_test_send_ping}, 
-    {set_ch,   &nrf24l01_test_set_rf_ch}, 
-    {set_dr,   &nrf24l01_test_set_rf_dr}, 
-    {set_pwr,  &nrf24l01_test_set_rf_pwr} 
+    NRF24L01_MC_CMDS(NRF24L01_CMD_PTR)
 }; 
 
 // Command data 
@@ -657,47 +686,37 @@ void nrf24l01_manual_control_test_loop(void)
 #if NRF24L01_SYSTEM_1 
 
     // Check for user input 
-    nrf24l01_test_user_input(&mc_cmd_data, mc_cmd_table, NUM_USER_CMDS, NRF24L01_CMD_ARG_VALUE); 
+    nrf24l01_test_user_input(
+        &mc_cmd_data, 
+        &nrf24l01_mc_cmds, 
+        mc_cmd_table, 
+        NRF24L01_CMD_ARG_VALUE); 
     
 #endif 
 
-    // Periodically check for action items 
-    if (tim_compare(nrf24l01_test.timer_nonblocking, 
-                    nrf24l01_test.delay_timer.clk_freq, 
-                    MC_PERIOD, 
-                    &nrf24l01_test.delay_timer.time_cnt_total, 
-                    &nrf24l01_test.delay_timer.time_cnt, 
-                    &nrf24l01_test.delay_timer.time_start))
+    // Look for ping messages and responses 
+    while (nrf24l01_test_receive())
     {
-        // time_start flag does not need to be set again because this timer runs 
-        // continuously. 
-
-        // Look for a heartbeat message 
-        if (nrf24l01_data_ready_status() == nrf24l01_test.pipe)
-        {
-            nrf24l01_receive_payload(nrf24l01_test.read_buff); 
-
 #if NRF24L01_SYSTEM_1 
 
-            // If a ping response message is seen then display the response 
-            if (!strcmp(ping_res, (char *)nrf24l01_test.read_buff))
-            {
-                nrf24l01_test_user_feedback("\033[1A\033[1A\r"); 
-                nrf24l01_test_user_feedback(ping_msg); 
-                nrf24l01_test_user_feedback("..."); 
-                nrf24l01_test_user_feedback(ping_res); 
-                nrf24l01_test_user_prompt(); 
-            }
+        // If a ping response message is seen then display the response 
+        if (!strcmp(ping_res, (char *)nrf24l01_test.read_buff))
+        {
+            nrf24l01_test_user_feedback("\033[1A\033[1A\r"); 
+            nrf24l01_test_user_feedback(ping_msg); 
+            nrf24l01_test_user_feedback("..."); 
+            nrf24l01_test_user_feedback(ping_res); 
+            nrf24l01_test_user_prompt(); 
+        }
 
 #elif NRF24L01_SYSTEM_2 
 
-            // If a ping message is seen then send a response back 
-            if (!strcmp(ping_msg, (char *)nrf24l01_test.read_buff))
-            {
-                nrf24l01_send_payload((uint8_t *)ping_res);     
-            }
-#endif 
+        // If a ping message is seen then send a response back 
+        if (!strcmp(ping_msg, (char *)nrf24l01_test.read_buff))
+        {
+            nrf24l01_rx_send((const uint8_t *)ping_res); 
         }
+#endif 
     }
 }
 
@@ -714,7 +733,7 @@ void nrf24l01_test_send_ping(
     uint8_t arg_value, 
     uint8_t *arg_str)
 {
-    if (nrf24l01_send_payload((uint8_t *)ping_msg) == NRF24L01_OK)
+    if (nrf24l01_rx_send((const uint8_t *)ping_msg) == NRF24L01_OK)
     {
         nrf24l01_test_user_feedback(ping_msg); 
         nrf24l01_test_user_feedback("..."); 
@@ -733,10 +752,13 @@ void nrf24l01_test_set_rf_ch(
 {
     if (rf_ch <= NRF24L01_RF_CH_MAX)
     {
+        // The receive interrupt uses the same SPI port 
+        nrf24l01_rx_lock(); 
         nrf24l01_set_rf_ch(rf_ch); 
         nrf24l01_rf_ch_write(); 
-        
         nrf24l01_rf_ch_read(); 
+        nrf24l01_rx_unlock(); 
+
         nrf24l01_test_update_feedback(nrf24l01_get_rf_ch() == rf_ch); 
     }
     else 
@@ -753,10 +775,12 @@ void nrf24l01_test_set_rf_dr(
 {
     if (rf_dr <= (uint8_t)NRF24L01_DR_250KBPS)
     {
+        nrf24l01_rx_lock(); 
         nrf24l01_set_rf_setup_dr((nrf24l01_data_rate_t)rf_dr); 
         nrf24l01_rf_setup_write(); 
-
         nrf24l01_rf_setup_read(); 
+        nrf24l01_rx_unlock(); 
+
         nrf24l01_test_update_feedback(
             nrf24l01_get_rf_setup_dr() == (nrf24l01_data_rate_t)rf_dr); 
     }
@@ -774,10 +798,12 @@ void nrf24l01_test_set_rf_pwr(
 {
     if (rf_pwr <= (uint8_t)NRF24L01_RF_PWR_0DBM)
     {
+        nrf24l01_rx_lock(); 
         nrf24l01_set_rf_setup_pwr((nrf24l01_rf_pwr_t)rf_pwr); 
         nrf24l01_rf_setup_write(); 
-
         nrf24l01_rf_setup_read(); 
+        nrf24l01_rx_unlock(); 
+
         nrf24l01_test_update_feedback(
             nrf24l01_get_rf_setup_pwr() == (nrf24l01_rf_pwr_t)rf_pwr); 
     }
@@ -808,6 +834,436 @@ void nrf24l01_test_user_feedback(const char *user_msg)
 
 //=======================================================================================
 
+
+#elif NRF24L01_LINK_BENCH 
+
+//=======================================================================================
+// Link benchmark test 
+
+// Description 
+// - System 1 runs the link benchmark (nrf24l01_link.h) for each combination of the data 
+//   rates, payload lengths and retry counts below. Payloads are sent back to back, one 
+//   per loop pass, and each run's results are written to the serial terminal as one 
+//   line when it's done: acknowledged payloads/s and bytes/s, RTT percentiles, the 
+//   retransmit and loss rates and the receiver's count. 
+// - System 2 takes payloads from the receive ring and returns its count in the ACKs. 
+//   It follows system 1's data rate changes. 
+// - On the host build system 2 is a second simulated radio connected to the first, 
+//   with the loss and latency set on the command line (see sim_nrf24l01.c). 
+
+//==================================================
+// Macros 
+
+#ifdef SIM_HOST_BUILD
+#define LB_SENDS 200                  // Payloads sent per run (simulated SPI is slow) 
+#else
+#define LB_SENDS 1000                 // Payloads sent per run 
+#endif   // SIM_HOST_BUILD 
+#define LB_MSG_LEN 160                // Results line buffer size 
+#define LB_PERCENT_SCALE 100          // Rate scale per percent 
+
+//==================================================
+
+
+//==================================================
+// Variables 
+
+#if NRF24L01_SYSTEM_1 
+
+// Run settings - every combination is run 
+static const nrf24l01_data_rate_t lb_rates[] = 
+{
+    NRF24L01_DR_2MBPS, 
+    NRF24L01_DR_1MBPS, 
+    NRF24L01_DR_250KBPS 
+}; 
+static const char *const lb_rate_names[] = { "2M", "1M", "250K" }; 
+static const uint8_t lb_delays[] = { 1, 1, 3 };   // Retry delay for each rate (ACK payload) 
+static const uint8_t lb_lens[] = { 8, 16, 32 }; 
+static const uint8_t lb_retries[] = { 0, 3, 15 }; 
+
+#define LB_NUM_RATES (sizeof(lb_rates) / sizeof(lb_rates[0])) 
+#define LB_NUM_LENS (sizeof(lb_lens) / sizeof(lb_lens[0])) 
+#define LB_NUM_RETRIES (sizeof(lb_retries) / sizeof(lb_retries[0])) 
+#define LB_RUNS (LB_NUM_RATES * LB_NUM_LENS * LB_NUM_RETRIES) 
+
+// Benchmark state 
+static uint16_t lb_run;               // Run in progress (LB_RUNS once done) 
+static uint16_t lb_sends;             // Payloads sent in the run 
+
+#endif 
+
+//==================================================
+
+
+//==================================================
+// Prototypes 
+
+#if NRF24L01_SYSTEM_1 
+
+/**
+ * @brief Start a run 
+ * 
+ * @details A run the receiver doesn't take is reported and skipped. 
+ * 
+ * @param run : run number 
+ * @return uint8_t : TRUE if the run started 
+ */
+uint8_t nrf24l01_link_bench_start(uint16_t run); 
+
+
+/**
+ * @brief Write the results of a run to the serial terminal 
+ * 
+ * @param run : run number 
+ */
+void nrf24l01_link_bench_report(uint16_t run); 
+
+#endif 
+
+//==================================================
+
+
+//==================================================
+// Setup 
+
+void nrf24l01_link_bench_test_init(void)
+{
+    // Variable payload lengths and the receiver's count need ACK payloads on both 
+    if (!nrf24l01_ack_init())
+    {
+        uart_sendstring(USART2, "\r\nnRF24L01 ACK payload setup failed."); 
+        while(1); 
+    }
+
+#if NRF24L01_SYSTEM_1 
+
+    char msg[LB_MSG_LEN]; 
+
+    snprintf(msg, sizeof(msg), "\r\nLink benchmark: %u runs of %u payloads\r\n", 
+             (unsigned)LB_RUNS, (unsigned)LB_SENDS); 
+    uart_sendstring(USART2, msg); 
+
+    lb_run = CLEAR; 
+
+    while ((lb_run < LB_RUNS) && !nrf24l01_link_bench_start(lb_run))
+    {
+        lb_run++; 
+    }
+
+#endif 
+}
+
+//==================================================
+
+
+//==================================================
+// Loop 
+
+void nrf24l01_link_bench_test_loop(void)
+{
+#if NRF24L01_SYSTEM_1 
+
+    if (lb_run >= LB_RUNS)
+    {
+        return; 
+    }
+
+    nrf24l01_link_send(); 
+
+    if (++lb_sends >= LB_SENDS)
+    {
+        nrf24l01_link_bench_report(lb_run); 
+
+        while ((++lb_run < LB_RUNS) && !nrf24l01_link_bench_start(lb_run)); 
+
+        if (lb_run >= LB_RUNS)
+        {
+            uart_sendstring(USART2, "Link benchmark done\r\n"); 
+        }
+    }
+
+#elif NRF24L01_SYSTEM_2 
+
+    while (nrf24l01_rx_read(&nrf24l01_test.rx_payload))
+    {
+        if (nrf24l01_test.rx_payload.pipe == nrf24l01_test.pipe)
+        {
+            nrf24l01_link_peer(&nrf24l01_test.rx_payload); 
+        }
+    }
+
+#endif 
+}
+
+//==================================================
+
+
+//==================================================
+// Test functions 
+
+#if NRF24L01_SYSTEM_1 
+
+// Start a run 
+uint8_t nrf24l01_link_bench_start(uint16_t run)
+{
+    uint8_t rate = (uint8_t)(run / (LB_NUM_LENS * LB_NUM_RETRIES)); 
+    nrf24l01_link_config_t config; 
+    char msg[LB_MSG_LEN]; 
+
+    config.rate = lb_rates[rate]; 
+    config.delay = lb_delays[rate]; 
+    config.len = lb_lens[(run / LB_NUM_RETRIES) % LB_NUM_LENS]; 
+    config.retries = lb_retries[run % LB_NUM_RETRIES]; 
+
+    lb_sends = CLEAR; 
+
+    if (nrf24l01_link_start(&config))
+    {
+        return TRUE; 
+    }
+
+    snprintf(
+        msg, 
+        sizeof(msg), 
+        "%-4s %2uB rt%-2u | receiver didn't take the configuration\r\n", 
+        lb_rate_names[rate], 
+        (unsigned)config.len, 
+        (unsigned)config.retries); 
+    uart_sendstring(USART2, msg); 
+
+    return FALSE; 
+}
+
+
+// Write the results of a run to the serial terminal 
+void nrf24l01_link_bench_report(uint16_t run)
+{
+    nrf24l01_link_result_t result; 
+    char msg[LB_MSG_LEN]; 
+
+    nrf24l01_link_result(&result); 
+
+    snprintf(
+        msg, 
+        sizeof(msg), 
+        "%-4s %2uB rt%-2u | %5lu pl/s %6lu B/s | RTT p50 %4lu p90 %4lu p99 %4lu "
+        "max %5lu us | rtx %lu.%02lu%% loss %lu.%02lu%% | peer %lu/%lu\r\n", 
+        lb_rate_names[run / (LB_NUM_LENS * LB_NUM_RETRIES)], 
+        (unsigned)lb_lens[(run / LB_NUM_RETRIES) % LB_NUM_LENS], 
+        (unsigned)lb_retries[run % LB_NUM_RETRIES], 
+        (unsigned long)result.payloads_per_s, 
+        (unsigned long)result.goodput, 
+        (unsigned long)result.rtt_p50, 
+        (unsigned long)result.rtt_p90, 
+        (unsigned long)result.rtt_p99, 
+        (unsigned long)result.rtt_max, 
+        (unsigned long)(result.retransmit / LB_PERCENT_SCALE), 
+        (unsigned long)(result.retransmit % LB_PERCENT_SCALE), 
+        (unsigned long)(result.loss / LB_PERCENT_SCALE), 
+        (unsigned long)(result.loss % LB_PERCENT_SCALE), 
+        (unsigned long)result.peer, 
+        (unsigned long)result.sent); 
+
+    uart_sendstring(USART2, msg); 
+}
+
+#endif 
+
+//==================================================
+
+//=======================================================================================
+
+#elif NRF24L01_CHANNEL_SURVEY 
+
+//=======================================================================================
+// Channel survey test 
+
+// Description 
+// - System 1 sweeps every RF channel CS_SWEEPS times (nrf24l01_survey.h) and writes the 
+//   occupancy to the serial terminal as one digit per channel (the percent of sweeps 
+//   the channel was in use, / 10, '+' for 100%), along with the time the sweeps took 
+//   and the quietest channel. It then moves both systems to the quietest channel and 
+//   sends a keep alive payload every CS_KEEPALIVE_PERIOD, reporting when the keep 
+//   alives stop or start being acknowledged. 
+// - System 2 takes payloads from the receive ring and follows system 1's channel 
+//   changes. It goes back to the starting channel if a change isn't confirmed or no 
+//   keep alive follows the confirmation. 
+// - On the host build the busy channels and ACK loss are set on the command line (see 
+//   sim_nrf24l01.c) and --stats shows the channel each system ended up on. 
+
+//==================================================
+// Macros 
+
+#define CS_SWEEPS 32                  // Sweeps in the survey 
+#define CS_ROW 63                     // Channels per line of the occupancy map 
+#define CS_MSG_LEN 80                 // Message buffer size 
+#define CS_PERCENT 100                // Percent scale 
+#define CS_DIGIT_SCALE 10             // Percent per occupancy map digit 
+#define CS_KEEPALIVE_PERIOD 200000    // Time between keep alive payloads (us) 
+#define CS_KEEPALIVE_TAG 0xB5         // Keep alive payload tag (first byte) 
+
+//==================================================
+
+
+//==================================================
+// Prototypes 
+
+#if NRF24L01_SYSTEM_1 
+
+/**
+ * @brief Write the occupancy map to the serial terminal 
+ * 
+ * @param survey : occupancy histogram 
+ */
+void nrf24l01_channel_survey_report(const nrf24l01_survey_t *survey); 
+
+#endif 
+
+//==================================================
+
+
+//==================================================
+// Setup 
+
+void nrf24l01_channel_survey_test_init(void)
+{
+    nrf24l01_survey_init(NRF24L01_RF_FREQ); 
+
+#if NRF24L01_SYSTEM_1 
+
+    nrf24l01_survey_t survey; 
+    char msg[CS_MSG_LEN]; 
+    uint64_t start; 
+    uint32_t survey_time; 
+    uint8_t channel; 
+
+    start = sys_time_us(); 
+
+    for (uint8_t i = CLEAR; i < CS_SWEEPS; i++)
+    {
+        nrf24l01_survey_sweep(); 
+    }
+
+    survey_time = (uint32_t)sys_time_since(start); 
+    nrf24l01_survey_get(&survey); 
+    nrf24l01_channel_survey_report(&survey); 
+
+    channel = nrf24l01_survey_best(); 
+    snprintf(msg, sizeof(msg), "%u sweeps in %lu us, quietest channel: %u\r\n", 
+             (unsigned)survey.sweeps, (unsigned long)survey_time, (unsigned)channel); 
+    uart_sendstring(USART2, msg); 
+
+    if (nrf24l01_survey_propose(channel))
+    {
+        snprintf(msg, sizeof(msg), "Moved to channel %u\r\n", (unsigned)channel); 
+    }
+    else 
+    {
+        snprintf(msg, sizeof(msg), "No answer, staying on channel %u\r\n", 
+                 (unsigned)NRF24L01_RF_FREQ); 
+    }
+    uart_sendstring(USART2, msg); 
+
+    // The responder only stays on a new channel once traffic arrives there 
+    nrf24l01_test.link_up = SET; 
+    twheel_start(&nrf24l01_test.delay_timer, CS_KEEPALIVE_PERIOD, CS_KEEPALIVE_PERIOD, 
+                 NULL, NULL); 
+
+#endif 
+}
+
+//==================================================
+
+
+//==================================================
+// Loop 
+
+void nrf24l01_channel_survey_test_loop(void)
+{
+#if NRF24L01_SYSTEM_1 
+
+    uint8_t keepalive[NRF24L01_MAX_PAYLOAD_LEN]; 
+    uint8_t acked; 
+
+    if (twheel_take(&nrf24l01_test.delay_timer))
+    {
+        memset((void *)keepalive, CLEAR, sizeof(keepalive)); 
+        keepalive[0] = CS_KEEPALIVE_TAG; 
+        acked = (nrf24l01_rx_send(keepalive) == NRF24L01_OK); 
+
+        if (acked != nrf24l01_test.link_up)
+        {
+            nrf24l01_test.link_up = acked; 
+            uart_sendstring(USART2, acked ? "Keep alive acknowledged\r\n" : 
+                                            "Keep alive not acknowledged\r\n"); 
+        }
+    }
+
+#elif NRF24L01_SYSTEM_2 
+
+    char msg[CS_MSG_LEN]; 
+
+    while (nrf24l01_rx_read(&nrf24l01_test.rx_payload))
+    {
+        if ((nrf24l01_test.rx_payload.pipe == nrf24l01_test.pipe) && 
+            nrf24l01_survey_accept(&nrf24l01_test.rx_payload))
+        {
+            snprintf(msg, sizeof(msg), "Channel change step %u: channel %u\r\n", 
+                     (unsigned)nrf24l01_test.rx_payload.data[1], 
+                     (unsigned)nrf24l01_test.rx_payload.data[2]); 
+            uart_sendstring(USART2, msg); 
+        }
+    }
+
+    if (nrf24l01_survey_update())
+    {
+        uart_sendstring(USART2, "Channel change not completed, back home\r\n"); 
+    }
+
+#endif 
+}
+
+//==================================================
+
+
+//==================================================
+// Test functions 
+
+#if NRF24L01_SYSTEM_1 
+
+// Write the occupancy map to the serial terminal 
+void nrf24l01_channel_survey_report(const nrf24l01_survey_t *survey)
+{
+    char row[CS_ROW + 1]; 
+    uint8_t index = CLEAR; 
+    uint32_t percent; 
+
+    uart_sendstring(USART2, "\r\nChannel occupancy (% / 10):\r\n"); 
+
+    for (uint8_t channel = CLEAR; channel < NRF24L01_SURVEY_CHANNELS; channel++)
+    {
+        percent = (survey->sweeps == 0) ? 0 : 
+                  ((uint32_t)survey->hits[channel] * CS_PERCENT) / survey->sweeps; 
+        row[index++] = (percent >= CS_PERCENT) ? '+' : 
+                       (char)(ZERO_CHAR + (percent / CS_DIGIT_SCALE)); 
+
+        if ((index == CS_ROW) || (channel == (NRF24L01_SURVEY_CHANNELS - 1)))
+        {
+            row[index] = NULL_CHAR; 
+            uart_sendstring(USART2, row); 
+            uart_sendstring(USART2, "\r\n"); 
+            index = CLEAR; 
+        }
+    }
+}
+
+#endif 
+
+//==================================================
+
+//=======================================================================================
+
 #endif 
 
 
@@ -824,15 +1280,15 @@ void nrf24l01_test_user_prompt(void)
 // Check for user input and execute callbacks if a valid command arrives 
 void nrf24l01_test_user_input(
     nrf24l01_cmd_data_t *cmd_data, 
-    const nrf24l01_cmds_t *cmd_table, 
-    uint8_t num_cmds, 
+    const cmd_registry_t *cmds, 
+    const nrf24l01_cmd_ptr_t *cmd_ptrs, 
     nrf24l01_cmd_arg_t cmd_arg_type)
 {
+    uint8_t cmd_index; 
+
     // Check for user serial terminal input 
-    if (handler_flags.usart2_flag)
+    if (event_take(EVENT_MASK(EVENT_USART2)))
     {
-        handler_flags.usart2_flag = CLEAR; 
-
         // Copy the new contents in the circular buffer to the user input buffer 
         cb_parse(
             cmd_data->cb, 
@@ -843,15 +1299,13 @@ void nrf24l01_test_user_input(
         // Validate the input - parse into an ID and value if valid 
         if (nrf24l01_test_parse_cmd(cmd_data, cmd_arg_type))
         {
-            // Valid input - compare the ID to each of the available pre-defined commands 
-            for (uint8_t i = CLEAR; i < num_cmds; i++) 
+            // Valid input - look up the ID in the pre-defined commands 
+            cmd_index = cmd_registry_find(cmds, (char *)cmd_data->cmd_id); 
+
+            if (cmd_index != CMD_REGISTRY_NONE)
             {
-                if (!strcmp(cmd_table[i].user_cmds, (char *)cmd_data->cmd_id))
-                {
-                    // ID matched to a command. Execute the command. 
-                    (cmd_table[i].cmd_ptr)(cmd_data->cmd_value, cmd_data->cmd_str); 
-                    break; 
-                }
+                // ID matched to a command. Execute the command. 
+                (cmd_ptrs[cmd_index])(cmd_data->cmd_value, cmd_data->cmd_str); 
             }
         }
 
@@ -945,3 +1399,50 @@ uint8_t nrf24l01_test_parse_cmd(
 }
 
 //=======================================================================================
+
+
+//=======================================================================================
+// Benchmarks 
+
+// Parse a user command with a value 
+static void nrf24l01_test_bench_parse_cmd(void)
+{
+    static nrf24l01_cmd_data_t cmd_data = { .cmd_buff = "rf_ch 120" }; 
+    (void)nrf24l01_test_parse_cmd(&cmd_data, NRF24L01_CMD_ARG_VALUE); 
+}
+
+BENCH_REGISTER("nrf24l01_test_parse_cmd", nrf24l01_test_bench_parse_cmd)
+
+
+// Look up a user command ID 
+static void nrf24l01_test_bench_cmd_find(void)
+{
+    (void)cmd_registry_find(&nrf24l01_mc_cmds, "data_rate"); 
+}
+
+BENCH_REGISTER("nrf24l01_test_cmd_find", nrf24l01_test_bench_cmd_find)
+
+
+// Encode a throttle frame (both thrusters) 
+static void nrf24l01_test_bench_frame_encode(void)
+{
+    static rc_frame_t frame = { .seq = 1, .throttle = { 120, -80 } }; 
+    static uint8_t payload[NRF24L01_MAX_PAYLOAD_LEN]; 
+    (void)rc_frame_encode(payload, &frame); 
+}
+
+BENCH_REGISTER("rc_frame_encode", nrf24l01_test_bench_frame_encode)
+
+
+// Decode a throttle frame - compare with nrf24l01_test_parse_cmd for one thruster 
+static void nrf24l01_test_bench_frame_decode(void)
+{
+    static const uint8_t payload[RC_FRAME_LEN] = 
+        { 0xC1, 0x01, 0x00, 0x78, 0x00, 0xB0, 0xFF, 0x07 }; 
+    static rc_frame_t frame; 
+    (void)rc_frame_decode(payload, &frame); 
+}
+
+BENCH_REGISTER("rc_frame_decode", nrf24l01_test_bench_frame_decode)
+
+//=======================================================================================
@@ -0,0 +1,33 @@
+/**
+ * @file nrf24l01_test_cmds.cpp 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief nRF24L01 test command registry 
+ * 
+ * @details Built at compile time from the command list in nrf24l01_test.h. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "nrf24l01_test.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Command registry 
+
+static constexpr auto nrf24l01_mc_table = 
+    cmd_registry_make({ NRF24L01_MC_CMDS(CMD_REGISTRY_NAME) }); 
+
+constexpr cmd_registry_t nrf24l01_mc_cmds = nrf24l01_mc_table.registry(); 
+
+//=======================================================================================
@@ -16,6 +16,8 @@
 // Includes 
 
 #include "dma_test.h"
+#include "adc_acq.h" 
+#include "stm32f4xx_it.h" 
 
 //=======================================================================================
 
@@ -29,9 +31,14 @@
 #define DMA_TEST_MODE_1 0             // Mode 1 test code control (see source file) 
 #define DMA_TEST_MODE_2 1             // Mode 2 test code control (see source file) 
 #define DMA_TEST_MODE_3 0             // Mode 3 test code control (see source file) 
+#define DMA_TEST_MODE_4 0             // Mode 4 test code control (see source file) 
 
 // Data 
 #define ADC_BUFF_SIZE 3               // Size according to the number of ADCs used 
+#define DMA_ACQ_RATE 1000             // Mode 4 sequences per second (Hz) 
+#define DMA_ACQ_SCANS 100             // Mode 4 sequences per block 
+#define DMA_ACQ_PRINT_BLOCKS 10       // Mode 4 blocks between terminal updates 
+#define DMA_ACQ_STATS_LEN 80          // Mode 4 statistics string length 
 
 // Formatting 
 #define ADC_PRINT_SPACES 5            // Spaces between values displayed in the terminal 
@@ -82,6 +89,13 @@ static uint16_t adc_data[ADC_BUFF_SIZE];  // Location for the DMA to store ADC v
 //     - Memory fixed 
 //     - One ADC initialized 
 //     - No sequence definition 
+// 
+// 4. Timer triggered acquisition (adc_acq.h) 
+//     - CONT disabled 
+//     - SCAN enabled 
+//     - TIM2 update starts each sequence 
+//     - DMA double buffer mode, block averages shown 
+//     - Sequence defined 
 //==================================================
 
 
@@ -128,7 +142,7 @@ void dma_test_init()
 #else 
         ADC_PARAM_ENABLE, 
 #endif 
-#if DMA_TEST_MODE_1  // For ADC continuous mode 
+#if (DMA_TEST_MODE_1 || DMA_TEST_MODE_4)  // For ADC continuous mode 
         ADC_PARAM_DISABLE, 
 #else 
         ADC_PARAM_ENABLE, 
@@ -175,6 +189,14 @@ void dma_test_init()
     //==================================================
     // DMA init 
 
+#if DMA_TEST_MODE_4 
+
+    // Sequences are started by TIM2 and stored in blocks by DMA2 Stream 0 
+    adc_acq_init(TIM2, DMA_ACQ_RATE, DMA_ACQ_SCANS, NULL, EXTI_PRIORITY_1); 
+    adc_acq_start(); 
+
+#else   // DMA_TEST_MODE_4 
+
     // Initialize the DMA stream 
     dma_stream_init(
         DMA2, 
@@ -203,6 +225,8 @@ void dma_test_init()
 
     // Enable the DMA stream 
     dma_stream_enable(DMA2_Stream0); 
+
+#endif   // DMA_TEST_MODE_4 
     
     //==================================================
 
@@ -254,6 +278,44 @@ void dma_test_app()
 
     //==================================================
 
+    //==================================================
+    // Average each channel over a block - timer triggered acquisition only 
+
+#if DMA_TEST_MODE_4 
+
+    adc_acq_block_t block; 
+    adc_acq_stats_t stats; 
+    char stats_str[DMA_ACQ_STATS_LEN]; 
+    uint32_t sum; 
+
+    if (!event_take(EVENT_MASK(EVENT_DMA2_0)) || !adc_acq_block_get(&block))
+    {
+        return; 
+    }
+
+    for (uint8_t i = CLEAR; (i < block.channels) && (i < ADC_BUFF_SIZE); i++)
+    {
+        sum = CLEAR; 
+
+        for (uint16_t j = CLEAR; j < block.scans; j++)
+        {
+            sum += block.data[(j * block.channels) + i]; 
+        }
+
+        adc_data[i] = (uint16_t)(sum / block.scans); 
+    }
+
+    adc_acq_block_release(); 
+
+    if ((block.number + 1) % DMA_ACQ_PRINT_BLOCKS)
+    {
+        return; 
+    }
+
+#endif   // DMA_TEST_MODE_4 
+
+    //==================================================
+
     // Display the result to the serial terminal 
     uart_sendstring(USART2, "First ADC: "); 
     uart_send_integer(USART2, (int16_t)adc_data[FIRST_ADC]); 
@@ -276,8 +338,26 @@ void dma_test_app()
 
 #endif   // ADC_DMA_SECOND_CHANNEL 
 
+#if DMA_TEST_MODE_4 
+
+    // Blocks missed by the loop or overwritten 
+    adc_acq_get_stats(&stats); 
+    snprintf(
+        stats_str, 
+        DMA_ACQ_STATS_LEN, 
+        "Blocks: %lu  Lost: %lu  Overruns: %lu  ADC overruns: %lu\r\n", 
+        (unsigned long)stats.blocks, 
+        (unsigned long)stats.lost, 
+        (unsigned long)stats.overruns, 
+        (unsigned long)stats.adc_overruns); 
+    uart_sendstring(USART2, stats_str); 
+
+#else   // DMA_TEST_MODE_4 
+
     // Delay 
     tim_delay_ms(TIM9, 1000); 
+
+#endif   // DMA_TEST_MODE_4 
 }
 
 //=======================================================================================
@@ -273,11 +273,8 @@ void int_test_external_init(void)
 void int_test_external_app(void)
 {
     // Check for the external interrupt from the user 
-    if (handler_flags.exti0_flag)
+    if (event_take(EVENT_MASK(EVENT_EXTI0)))
     {
-        // Reset the EXTI handler flag 
-        handler_flags.exti0_flag = CLEAR; 
-
         // Do something to show the interrupt works 
         uart_sendstring(USART2, "got it!"); 
         uart_send_new_line(USART2); 
@@ -287,19 +284,13 @@ void int_test_external_app(void)
         // Start the ADC conversions 
         adc_start(ADC1); 
 
-        // Wait for the ADC sequence to be converted 
-        while(!(handler_flags.adc_flag)); 
-
-        // Reset the ADC handler flag 
-        handler_flags.adc_flag = CLEAR; 
+        // Wait for the ADC sequence to be converted (taking the event clears it) 
+        while (!event_take(EVENT_MASK(EVENT_ADC))); 
 
 #if INT_DMA_ENABLE 
 
-        // Wait for the DMA transfer to complete 
-        while(!(handler_flags.dma2_0_flag)); 
-
-        // Reset the DMA handler flag 
-        handler_flags.dma2_0_flag = CLEAR; 
+        // Wait for the DMA transfer to complete (taking the event clears it) 
+        while (!event_take(EVENT_MASK(EVENT_DMA2_0))); 
 
 #endif   // INT_DMA_ENABLE 
 
@@ -298,11 +298,8 @@ void timers_test_app()
 
 #if TIM_PERIODIC 
 
-    if (handler_flags.tim1_brk_tim9_glbl_flag)
+    if (event_take(EVENT_MASK(EVENT_TIM1_BRK_TIM9)))
     {
-        // Clear interrupt handler 
-        handler_flags.tim1_brk_tim9_glbl_flag = CLEAR; 
-
         // Update the user button status 
         debounce((uint8_t)gpio_port_read(GPIOC)); 
 
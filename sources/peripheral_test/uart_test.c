@@ -17,6 +17,8 @@
 
 #include "uart_test.h" 
 #include "stm32f4xx_it.h" 
+#include "uart_rx_pipe.h" 
+#include "bench_test.h" 
 
 //=======================================================================================
 
@@ -24,20 +26,24 @@
 //=======================================================================================
 // Macros 
 
-#define UART_TEST_MAX_INPUT 30        // Max user input size (bytes) 
+#define UART_TEST_MAX_INPUT 30        // Max user input size (bytes) - cb_parse benchmark 
+#define UART_TEST_LINE_LEN 80         // Max status line length 
+
+// Serial terminal input events - IDLE line and DMA half/full buffer 
+#define UART_TEST_RX_EVENTS (EVENT_MASK(EVENT_USART2) | EVENT_MASK(EVENT_DMA1_5)) 
 
 //=======================================================================================
 
 
 //=======================================================================================
-// Global variables 
+// Function prototypes 
 
-// A circular buffer is used to store a continuous stream of UART (serial terminal) inputs 
-// and is also used to parse the most recent user input which gets stored in a user input 
-// buffer. 
-static uint8_t uart_dma_buff[UART_TEST_MAX_INPUT];     // Circular buffer for uart inputs 
-static uint8_t user_input_buff[UART_TEST_MAX_INPUT];   // Stores latest user input 
-static uint8_t buff_index;                             // Circular buffer index 
+/**
+ * @brief Send a line slice back to the serial terminal 
+ * 
+ * @param line : line slice 
+ */
+static void uart_test_echo(const uart_rxp_line_t *line); 
 
 //=======================================================================================
 
@@ -63,76 +69,25 @@ void uart_test_init(void)
         UART_MANT_42_9600, 
         UART_DMA_DISABLE, 
         UART_DMA_ENABLE); 
-    
-    // Enable IDLE line interrupts - this interrupt is triggered when the RX line 
-    // goes idle (no more data coming in). This is used to read variable length 
-    // UART inputs via DMA. If DMA transfer interrupts are used then the interrupt 
-    // will only trigger for fixed lengths. 
-    uart_interrupt_init(
-        USART2, 
-        UART_INT_DISABLE, 
-        UART_INT_DISABLE, 
-        UART_INT_DISABLE, 
-        UART_INT_DISABLE, 
-        UART_INT_ENABLE, 
-        UART_INT_DISABLE, 
-        UART_INT_DISABLE); 
 
     //==================================================
 
-    //===================================================
-    // Initialize DMA 
-
-    // Initialize the DMA stream 
-    dma_stream_init(
-        DMA1, 
-        DMA1_Stream5, 
-        DMA_CHNL_4, 
-        DMA_DIR_PM, 
-        DMA_CM_ENABLE,
-        DMA_PRIOR_VHI, 
-        DMA_DBM_DISABLE, 
-        DMA_ADDR_INCREMENT,   // Increment the buffer pointer to fill the buffer 
-        DMA_ADDR_FIXED,       // No peripheral increment - copy from DR only 
-        DMA_DATA_SIZE_BYTE, 
-        DMA_DATA_SIZE_BYTE); 
-
-    // Configure the DMA stream 
-    dma_stream_config(
-        DMA1_Stream5, 
-        (uint32_t)(&USART2->DR), 
-        (uint32_t)uart_dma_buff, 
-        (uint32_t)NULL, 
-        (uint16_t)UART_TEST_MAX_INPUT); 
-
-    // Enable the DMA stream 
-    dma_stream_enable(DMA1_Stream5); 
-    
-    //===================================================
-
     //==================================================
-    // Initialize interrupts 
+    // Initialize interrupts and the receive pipeline 
 
     // Initialize interrupt handler flags (called once) 
     int_handler_init(); 
 
-    // Enable the interrupt handlers (called for each interrupt) - for USART2_RX 
-    nvic_config(USART2_IRQn, EXTI_PRIORITY_0); 
-
-    //==================================================
-
-    //==================================================
-    // Initialize variables 
-
-    memset((void *)uart_dma_buff, CLEAR, sizeof(uart_dma_buff)); 
-    memset((void *)user_input_buff, CLEAR, sizeof(user_input_buff)); 
-    buff_index = CLEAR; 
+    // Serial terminal input is received by DMA into a circular buffer. Lines are read 
+    // from the buffer as they're completed so input of any length up to the buffer 
+    // size can be pasted at once. 
+    uart_rxp_init(EXTI_PRIORITY_0); 
 
     //==================================================
 
     uart_sendstring(USART2, "\r\n>>> "); 
 
-} 
+}
 
 //=======================================================================================
 
@@ -142,22 +97,70 @@ void uart_test_init(void)
 
 void uart_test_app(void)
 {
-    // This interrupt flag will be set when an idle line is detected on UART RX after 
-    // receiving new data. This new data gets echoed back over the UART. 
-    if (handler_flags.usart2_flag)
+    uart_rxp_line_t line; 
+    uart_rxp_stats_t stats; 
+    char status[UART_TEST_LINE_LEN]; 
+
+    // These interrupt events are set when an idle line is detected on UART RX after 
+    // receiving new data or when the DMA has filled half of the circular buffer. Each 
+    // completed line gets echoed back over the UART. 
+    if (!event_take(UART_TEST_RX_EVENTS))
     {
-        // Reset the USART2 interrupt flag 
-        handler_flags.usart2_flag = CLEAR; 
-
-        // Copy the new contents in the circular buffer to the user input buffer 
-        cb_parse(uart_dma_buff, user_input_buff, &buff_index, UART_TEST_MAX_INPUT); 
+        return; 
+    }
 
-        // Echo the user input back to the terminal 
-        uart_send_new_line(USART2); 
-        uart_sendstring(USART2, (char *)user_input_buff); 
+    while (uart_rxp_line_get(&line))
+    {
         uart_send_new_line(USART2); 
-        uart_sendstring(USART2, "\r\n>>> "); 
+        uart_test_echo(&line); 
+
+        if (!uart_rxp_line_release())
+        {
+            uart_sendstring(USART2, "\r\n(input overwritten while echoing)"); 
+        }
+
+        uart_rxp_get_stats(&stats); 
+        snprintf(
+            status, 
+            UART_TEST_LINE_LEN, 
+            "\r\n(%u bytes, overruns: %lu, long lines: %lu)\r\n>>> ", 
+            (unsigned)line.total, 
+            (unsigned long)stats.overruns, 
+            (unsigned long)stats.long_lines); 
+        uart_sendstring(USART2, status); 
     }
 }
 
+
+// Send a line slice back to the serial terminal 
+static void uart_test_echo(const uart_rxp_line_t *line)
+{
+    for (uint8_t i = CLEAR; i < UART_RXP_PARTS; i++)
+    {
+        for (uint16_t j = CLEAR; j < line->len[i]; j++)
+        {
+            uart_sendchar(USART2, line->data[i][j]); 
+        }
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Benchmarks 
+
+// Parse a user input that wraps around the end of the circular buffer 
+static void uart_test_bench_cb_parse(void)
+{
+    static uint8_t cb[UART_TEST_MAX_INPUT] = " 42\r"; 
+    static uint8_t input[UART_TEST_MAX_INPUT]; 
+    uint8_t index = UART_TEST_MAX_INPUT - 3; 
+
+    memcpy((void *)&cb[UART_TEST_MAX_INPUT - 3], "set", 3); 
+    cb_parse(cb, input, &index, UART_TEST_MAX_INPUT); 
+}
+
+BENCH_REGISTER("cb_parse", uart_test_bench_cb_parse)
+
 //=======================================================================================
@@ -0,0 +1,65 @@
+/**
+ * @file bench_host.cpp 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Micro-benchmark harness timer for the host build 
+ * 
+ * @details The simulated DWT cycle counter follows simulated time which only moves at 
+ *          peripheral register accesses, so it can't time code on the host. The host 
+ *          build times benchmarks with the steady clock instead. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifdef SIM_HOST_BUILD
+
+//=======================================================================================
+// Includes 
+
+#include "bench_test.h" 
+#include <chrono> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+static std::chrono::steady_clock::time_point bench_host_start; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Timer 
+
+// Timer init 
+void bench_clock_init(void)
+{
+    bench_host_start = std::chrono::steady_clock::now(); 
+}
+
+
+// Timer count - wraps every ~4.3s like the cycle counter does every ~51s at 84MHz 
+uint32_t bench_clock_now(void)
+{
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - bench_host_start).count()); 
+}
+
+
+// Timer ticks per microsecond 
+uint32_t bench_clock_ticks_per_us(void)
+{
+    return DIVIDE_1000; 
+}
+
+//=======================================================================================
+
+#endif   // SIM_HOST_BUILD 
@@ -0,0 +1,340 @@
+/**
+ * @file bench_test.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Micro-benchmark harness 
+ * 
+ * @details Results are sent to the serial terminal as one line per benchmark. Use them 
+ *          to check a function fits in the time it has - ex. the 100ms sample interval 
+ *          of the GPS navigation test or the 50ms period of the nRF24L01 heartbeat. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "bench_test.h" 
+#include "sys_time.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define BENCH_TEST_LINE_LEN 90        // Max result line length 
+
+// Unit of the timer ticks 
+#ifdef SIM_HOST_BUILD
+#define BENCH_TEST_UNIT "ns" 
+#else
+#define BENCH_TEST_UNIT "cycles" 
+#endif   // SIM_HOST_BUILD 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Registered benchmarks - kept in registration order 
+static bench_t *bench_list_head; 
+static bench_t *bench_list_tail; 
+
+static uint32_t bench_samples[BENCH_ITERATIONS_MAX];   // Iteration times 
+static uint32_t bench_overhead;                        // Cost of reading the timer 
+static uint8_t bench_test_run_flag;                    // Run the benchmarks 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Empty benchmark - used to measure the cost of reading the timer 
+ */
+static void bench_empty(void); 
+
+
+/**
+ * @brief Sort the iteration times (ascending) 
+ * 
+ * @param samples : iteration times 
+ * @param num : number of iteration times 
+ */
+static void bench_sort(
+    uint32_t *samples, 
+    uint16_t num); 
+
+
+/**
+ * @brief Run each registered benchmark and output the results 
+ */
+static void bench_test_run_all(void); 
+
+
+/**
+ * @brief Read the system clock 
+ */
+static void bench_sys_time_us(void); 
+
+
+/**
+ * @brief Read the system clock with sub-microsecond resolution 
+ */
+static void bench_sys_time_ns(void); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Setup code 
+
+void bench_test_init(void)
+{
+    bench_t empty = { "empty", bench_empty, NULL }; 
+    bench_result_t result; 
+
+    // Initialize GPIO ports 
+    gpio_port_init(); 
+
+    // Initialize UART - used to output the results and rerun the benchmarks 
+    uart_init(
+        USART2, 
+        GPIOA, 
+        PIN_3, 
+        PIN_2, 
+        UART_FRAC_42_9600, 
+        UART_MANT_42_9600, 
+        UART_DMA_DISABLE, 
+        UART_DMA_DISABLE); 
+
+    // Start the timer and find the cost of reading it 
+    bench_clock_init(); 
+    bench_overhead = CLEAR; 
+    bench_run(&empty, BENCH_WARMUP, BENCH_ITERATIONS, &result); 
+    bench_overhead = result.min; 
+
+    // System clock benchmarks - started after the cycle counter is reset so the 
+    // sub-microsecond time lines up 
+    sys_time_init(TIM5, EXTI_PRIORITY_1); 
+
+    bench_test_run_flag = SET; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test code 
+
+void bench_test_app(void)
+{
+    // Any serial terminal input runs the benchmarks again 
+    if (USART2->SR & USART_SR_RXNE)
+    {
+        (void)USART2->DR; 
+        bench_test_run_flag = SET; 
+    }
+
+    if (bench_test_run_flag)
+    {
+        bench_test_run_flag = CLEAR; 
+        bench_test_run_all(); 
+    }
+}
+
+
+// Run each registered benchmark and output the results 
+static void bench_test_run_all(void)
+{
+    char line[BENCH_TEST_LINE_LEN]; 
+    bench_result_t result; 
+    uint32_t ticks_per_us = bench_clock_ticks_per_us(); 
+
+    snprintf(
+        line, 
+        BENCH_TEST_LINE_LEN, 
+        "\r\n%-24s %10s %10s %10s %10s\r\n", 
+        "benchmark (" BENCH_TEST_UNIT ")", "min", "median", "p99", "p99 (us)"); 
+    uart_sendstring(USART2, line); 
+
+    for (const bench_t *bench = bench_list_head; bench != NULL; bench = bench->next)
+    {
+        bench_run(bench, BENCH_WARMUP, BENCH_ITERATIONS, &result); 
+
+        snprintf(
+            line, 
+            BENCH_TEST_LINE_LEN, 
+            "%-24s %10lu %10lu %10lu %7lu.%02lu\r\n", 
+            bench->name, 
+            (unsigned long)result.min, 
+            (unsigned long)result.median, 
+            (unsigned long)result.p99, 
+            (unsigned long)(result.p99 / ticks_per_us), 
+            (unsigned long)(((result.p99 % ticks_per_us) * SCALE_100) / ticks_per_us)); 
+        uart_sendstring(USART2, line); 
+    }
+
+    snprintf(
+        line, 
+        BENCH_TEST_LINE_LEN, 
+        "timer overhead: %lu " BENCH_TEST_UNIT " (removed)\r\n", 
+        (unsigned long)bench_overhead); 
+    uart_sendstring(USART2, line); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Benchmark functions 
+
+// Add a benchmark to the list 
+void bench_register(bench_t *bench)
+{
+    bench->next = NULL; 
+
+    if (bench_list_tail == NULL)
+    {
+        bench_list_head = bench; 
+    }
+    else
+    {
+        bench_list_tail->next = bench; 
+    }
+
+    bench_list_tail = bench; 
+}
+
+
+// Time a benchmark 
+void bench_run(
+    const bench_t *bench, 
+    uint16_t warmup, 
+    uint16_t iterations, 
+    bench_result_t *result)
+{
+    uint32_t start, ticks; 
+
+    if (iterations > BENCH_ITERATIONS_MAX)
+    {
+        iterations = BENCH_ITERATIONS_MAX; 
+    }
+    else if (iterations == CLEAR)
+    {
+        iterations = 1; 
+    }
+
+    // Fill the flash cache and branch predictor before timing 
+    for (uint16_t i = CLEAR; i < warmup; i++)
+    {
+        bench->fn(); 
+    }
+
+    for (uint16_t i = CLEAR; i < iterations; i++)
+    {
+        start = bench_clock_now(); 
+        bench->fn(); 
+        ticks = bench_clock_now() - start; 
+        bench_samples[i] = (ticks > bench_overhead) ? (ticks - bench_overhead) : CLEAR; 
+    }
+
+    bench_sort(bench_samples, iterations); 
+
+    result->min = bench_samples[0]; 
+    result->median = bench_samples[iterations / 2]; 
+    result->p99 = bench_samples[((iterations * 99U) + 99U) / 100U - 1U]; 
+}
+
+
+// Sort the iteration times (ascending) 
+static void bench_sort(
+    uint32_t *samples, 
+    uint16_t num)
+{
+    // Insertion sort - the sample buffer is small and usually close to sorted 
+    for (uint16_t i = 1; i < num; i++)
+    {
+        uint32_t sample = samples[i]; 
+        uint16_t j = i; 
+
+        while ((j > CLEAR) && (samples[j - 1] > sample))
+        {
+            samples[j] = samples[j - 1]; 
+            j--; 
+        }
+
+        samples[j] = sample; 
+    }
+}
+
+
+// Empty benchmark 
+static void bench_empty(void)
+{
+    __asm__ volatile ("" ::: "memory"); 
+}
+
+
+// Read the system clock 
+static void bench_sys_time_us(void)
+{
+    volatile uint64_t time = sys_time_us(); 
+    (void)time; 
+}
+
+BENCH_REGISTER("sys_time_us", bench_sys_time_us)
+
+
+// Read the system clock with sub-microsecond resolution 
+static void bench_sys_time_ns(void)
+{
+    volatile uint64_t time = sys_time_ns(); 
+    (void)time; 
+}
+
+BENCH_REGISTER("sys_time_ns", bench_sys_time_ns)
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Timer 
+
+// The host build timer is in bench_host.cpp 
+#ifndef SIM_HOST_BUILD
+
+// Timer init 
+void bench_clock_init(void)
+{
+    // Trace must be enabled for the DWT to count 
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; 
+    DWT->CYCCNT = CLEAR; 
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; 
+}
+
+
+// Timer count 
+uint32_t bench_clock_now(void)
+{
+    return DWT->CYCCNT; 
+}
+
+
+// Timer ticks per microsecond 
+uint32_t bench_clock_ticks_per_us(void)
+{
+    return rcc_get_hclk_frq() / (DIVIDE_1000 * DIVIDE_1000); 
+}
+
+#endif   // SIM_HOST_BUILD 
+
+//=======================================================================================
@@ -0,0 +1,199 @@
+/**
+ * @file dlog_test.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Deferred format logging test 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "dlog_test.h" 
+#include "dlog.h" 
+#include "uart_tx_queue.h" 
+#include "bench_test.h" 
+#include <stdarg.h> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define DLOG_TEST_PERIOD 500                // Time between counter messages (ms) 
+#define DLOG_TEST_LINE_LEN 100              // Max text message length 
+#define DLOG_TEST_TEXT_TAG "text: " 
+#define DLOG_TEST_DLOG_TAG "dlog: " 
+
+// Sends a message as text and with DLOG and counts the bytes each took (without tags) 
+#define DLOG_TEST_PAIR(fmt, ...)                                                     \
+    do                                                                               \
+    {                                                                                \
+        dlog_test_data.text_bytes += dlog_test_text(DLOG_TEST_TEXT_TAG fmt,          \
+                                                    ##__VA_ARGS__);                  \
+        DLOG(DLOG_TEST_DLOG_TAG fmt, ##__VA_ARGS__);                                 \
+        dlog_test_data.frame_bytes += DLOG_HEADER_LEN +                              \
+                                      (DLOG_ARG_LEN * DLOG_NARGS(__VA_ARGS__));      \
+    }                                                                                \
+    while (0)
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+typedef struct dlog_test_data_s
+{
+    uint32_t text_bytes;                    // Bytes sent as text 
+    uint32_t frame_bytes;                   // Bytes sent as frames 
+    uint32_t count;                         // Counter message number 
+}
+dlog_test_data_t; 
+
+static dlog_test_data_t dlog_test_data; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Format a message on the device and queue it 
+ * 
+ * @param fmt : format string 
+ * @param ... : arguments 
+ * @return uint32_t : message length without the tag 
+ */
+static uint32_t dlog_test_text(const char *fmt, ...); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Setup code 
+
+void dlog_test_init(void)
+{
+    char line[DLOG_TEST_LINE_LEN]; 
+    float value = -273.15f; 
+
+    memset((void *)&dlog_test_data, CLEAR, sizeof(dlog_test_data)); 
+
+    // Initialize GPIO ports 
+    gpio_port_init(); 
+
+    // Initialize timers 
+    tim_9_to_11_counter_init(
+        TIM9, 
+        TIM_84MHZ_1US_PSC, 
+        0xFFFF,  // Max ARR value 
+        TIM_UP_INT_DISABLE); 
+    tim_enable(TIM9); 
+
+    // Initialize UART 
+    uart_init(
+        USART2, 
+        GPIOA, 
+        PIN_3, 
+        PIN_2, 
+        UART_FRAC_42_9600, 
+        UART_MANT_42_9600, 
+        UART_DMA_DISABLE, 
+        UART_DMA_DISABLE); 
+
+    // Nothing is dropped so the byte counts match what was sent 
+    uart_txq_init(UART_TXQ_BLOCK, EXTI_PRIORITY_1); 
+
+    uart_txq_puts("\r\nDeferred logging test - decode with tools/dlog_decode.cpp\r\n\n"); 
+
+    // Messages of the tests that use DLOG and the argument types supported 
+    DLOG_TEST_PAIR("no arguments\r\n"); 
+    DLOG_TEST_PAIR("\rRPM: %lu  \r\n", (unsigned long)4321); 
+    DLOG_TEST_PAIR("NAVSTAT: %u\r\nRadius: %ld     \r\nHeading Error: %d     \r\n", 
+                   3U, -1250L, -179); 
+    DLOG_TEST_PAIR("%c%c %d\r\n", 'L', '-', -42); 
+    DLOG_TEST_PAIR("0x%08lX %x %5d|%-5d| 100%%\r\n", 0xDEADBEEFUL, 255U, 7, -7); 
+    DLOG_TEST_PAIR("%d %d %d %d %d %d %d %d\r\n", 1, -2, 3, -4, 5, -6, 7, INT16_MIN); 
+
+    // Floats are sent as their bits 
+    dlog_test_data.text_bytes += dlog_test_text(DLOG_TEST_TEXT_TAG "%.2f %e\r\n", 
+                                                (double)value, (double)value); 
+    DLOG(DLOG_TEST_DLOG_TAG "%.2f %e\r\n", dlog_float(value), dlog_float(value)); 
+    dlog_test_data.frame_bytes += DLOG_HEADER_LEN + (2 * DLOG_ARG_LEN); 
+
+    snprintf(
+        line, 
+        DLOG_TEST_LINE_LEN, 
+        "\r\nText: %lu bytes, DLOG: %lu bytes\r\n\n", 
+        (unsigned long)dlog_test_data.text_bytes, 
+        (unsigned long)dlog_test_data.frame_bytes); 
+    uart_txq_puts(line); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test code 
+
+void dlog_test_app(void)
+{
+    DLOG("Counter: %lu\r\n", dlog_test_data.count++); 
+    tim_delay_ms(TIM9, DLOG_TEST_PERIOD); 
+}
+
+
+// Format a message on the device and queue it 
+static uint32_t dlog_test_text(const char *fmt, ...)
+{
+    char line[DLOG_TEST_LINE_LEN]; 
+    va_list args; 
+    int len; 
+
+    va_start(args, fmt); 
+    len = vsnprintf(line, DLOG_TEST_LINE_LEN, fmt, args); 
+    va_end(args); 
+
+    uart_txq_puts(line); 
+
+    return (len > (int)strlen(DLOG_TEST_TEXT_TAG)) ?
+           (uint32_t)len - (uint32_t)strlen(DLOG_TEST_TEXT_TAG) : CLEAR; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Benchmarks 
+
+// Wheel RPM test message with DLOG - times the encoding only as the transmit queue 
+// isn't initialized when benchmarks run 
+static void dlog_test_bench_dlog(void)
+{
+    static uint32_t rpm = CLEAR; 
+    DLOG("\rRPM: %lu  ", rpm++); 
+}
+
+BENCH_REGISTER("dlog_write", dlog_test_bench_dlog)
+
+
+// Wheel RPM test message with snprintf 
+static void dlog_test_bench_snprintf(void)
+{
+    static uint32_t rpm = CLEAR; 
+    static char line[DLOG_TEST_LINE_LEN]; 
+    snprintf(line, DLOG_TEST_LINE_LEN, "\rRPM: %lu  ", (unsigned long)rpm++); 
+}
+
+BENCH_REGISTER("snprintf", dlog_test_bench_snprintf)
+
+//=======================================================================================
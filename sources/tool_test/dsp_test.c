@@ -0,0 +1,861 @@
+/**
+ * @file dsp_test.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Fixed point filter test 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "dsp_test.h" 
+#include "dsp_filter.h" 
+#include "adc_acq.h" 
+#include "stm32f4xx_it.h" 
+#include "bench_test.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Test signal 
+#define DSP_TEST_SIGNAL_LEN 512             // Samples in the test signal 
+#define DSP_TEST_BLOCK_LEN 45               // Block length (odd and not a multiple of 4) 
+#define DSP_TEST_SQUARE_PERIOD 64           // Square wave period (samples) 
+#define DSP_TEST_SQUARE_AMP 16384           // Square wave amplitude 
+#define DSP_TEST_NOISE_SHIFT 3              // Noise amplitude = full scale >> shift 
+#define DSP_TEST_STEP_START 448             // First sample of the large steps 
+#define DSP_TEST_STEP_AMP 30000             // Large step amplitude 
+#define DSP_TEST_SEED 0x12345678            // Pseudo random sequence start 
+#define DSP_TEST_LCG_MUL 1664525            // Pseudo random sequence multiplier 
+#define DSP_TEST_LCG_INC 1013904223         // Pseudo random sequence increment 
+#define DSP_TEST_OPS_CHECKS 1000            // Inputs used to check each operation 
+
+// Filter settings - 50 Hz low pass biquad at 1 kHz and 4x decimation 
+#define DSP_TEST_OFFSET 12000               // Offset stage (saturates the test signal) 
+#define DSP_TEST_MA_LOG2 4                  // Moving average window = 16 
+#define DSP_TEST_IIR_ALPHA DSP_Q15(0.05)    // Single pole gain 
+#define DSP_TEST_IIR_Q31_ALPHA DSP_Q31(0.05) 
+#define DSP_TEST_CIC_ORDER 3                // CIC stages 
+#define DSP_TEST_CIC_RATE_LOG2 2            // CIC decimation = 4 
+#define DSP_TEST_CIC_TAPS (DSP_TEST_CIC_ORDER * ((1 << DSP_TEST_CIC_RATE_LOG2) - 1) + 1) 
+
+// Reference check limits (Q15 LSBs). The single pole output is the state truncated once. 
+// The biquad truncates each output by up to 1 LSB and the error is fed back through the 
+// poles, which add up to sum(|h[n]|) = 13.6 for the impulse response of 1 / A(z). 
+#define DSP_TEST_IIR1_LSB_MAX 1 
+#define DSP_TEST_BIQUAD_LSB_MAX 14 
+
+// Live ADC filtering 
+#define DSP_TEST_RATE 1000                  // ADC samples per second (Hz) 
+#define DSP_TEST_SCANS 100                  // Samples per block 
+#define DSP_TEST_ADC_BITS 8                 // ADC resolution 
+#define DSP_TEST_PRINT_BLOCKS 2             // Blocks between terminal updates 
+#define DSP_TEST_PRINT_SPACES 3             // Spaces after the filtered value 
+
+// Benchmarks 
+#define DSP_TEST_BENCH_LEN 128              // Samples filtered per benchmark call 
+
+// Output 
+#define DSP_TEST_LINE_LEN 80                // Max terminal line length 
+#define DSP_TEST_FNV_OFFSET 0x811C9DC5      // FNV-1a checksum start 
+#define DSP_TEST_FNV_PRIME 0x01000193       // FNV-1a checksum prime 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Enums 
+
+// Checksum test cases - order of dsp_test_expected 
+typedef enum {
+    DSP_TEST_CASE_OFFSET, 
+    DSP_TEST_CASE_MA, 
+    DSP_TEST_CASE_IIR1, 
+    DSP_TEST_CASE_IIR1_Q31, 
+    DSP_TEST_CASE_BIQUAD, 
+    DSP_TEST_CASE_CIC, 
+    DSP_TEST_CASE_CHAIN, 
+    DSP_TEST_CASE_NUM
+} dsp_test_case_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Stages used by the checks, the application and the benchmarks 
+typedef struct dsp_test_stages_s
+{
+    dsp_offset_q15_t offset; 
+    dsp_ma_q15_t ma; 
+    dsp_iir1_q15_t iir1; 
+    dsp_iir1_q31_t iir1_q31; 
+    dsp_biquad_q15_t biquad; 
+    dsp_cic_q15_t cic; 
+}
+dsp_test_stages_t; 
+
+static dsp_test_stages_t dsp_test_stages; 
+
+// Application chain and the last filtered value 
+static dsp_test_stages_t dsp_test_app_stages; 
+static dsp_q15_t dsp_test_app_out; 
+
+// 50 Hz low pass at 1 kHz (Butterworth) - b0, b1, b2, a1, a2 
+static const dsp_q15_t dsp_test_lpf[] = { 329, 658, 329, -25576, 10508 }; 
+
+// Test case names and the checksums of the host build 
+static const char *dsp_test_names[DSP_TEST_CASE_NUM] = 
+{
+    "offset", "ma", "iir1", "iir1_q31", "biquad", "cic", "chain"
+}; 
+
+static const uint32_t dsp_test_expected[DSP_TEST_CASE_NUM] = 
+{
+    0xDCA776BA, 0x7F88F75F, 0xBD843341, 0x2C58B600, 0xA2C03799, 0x01460AA6, 0x93272D2D
+}; 
+
+// Benchmark stages - the biquad coefficients are left at 0 as they don't change the time 
+static dsp_test_stages_t dsp_test_bench_stages = 
+{
+    .ma = { .window_log2 = DSP_TEST_MA_LOG2 }, 
+    .iir1 = { .alpha = DSP_TEST_IIR_ALPHA }, 
+    .cic = 
+    {
+        .order = DSP_TEST_CIC_ORDER, 
+        .rate_log2 = DSP_TEST_CIC_RATE_LOG2, 
+        .shift = DSP_TEST_CIC_ORDER * DSP_TEST_CIC_RATE_LOG2
+    }
+}; 
+
+// Samples - shared by the checks and benchmarks to save RAM 
+static dsp_q15_t dsp_test_signal[DSP_TEST_SIGNAL_LEN]; 
+static dsp_q15_t dsp_test_block[DSP_TEST_SIGNAL_LEN]; 
+static dsp_q31_t dsp_test_block_q31[DSP_TEST_BLOCK_LEN]; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Next pseudo random number 
+ * 
+ * @param seed : sequence state 
+ * @return uint32_t : random number 
+ */
+static uint32_t dsp_test_rand(uint32_t *seed); 
+
+
+/**
+ * @brief Add a value to a checksum 
+ * 
+ * @param hash : checksum 
+ * @param value : value added (low byte first) 
+ * @param bytes : bytes of 'value' used 
+ * @return uint32_t : updated checksum 
+ */
+static uint32_t dsp_test_hash(
+    uint32_t hash, 
+    uint32_t value, 
+    uint8_t bytes); 
+
+
+/**
+ * @brief Set up the stages used by a test case 
+ * 
+ * @param stages : stages to set up 
+ * @param chain : chain of stages for the test case 
+ * @param test_case : test case 
+ * @return uint8_t : number of stages in the chain 
+ */
+static uint8_t dsp_test_stages_init(
+    dsp_test_stages_t *stages, 
+    dsp_stage_q15_t *chain, 
+    dsp_test_case_t test_case); 
+
+
+/**
+ * @brief Check the DSP operations against the plain C versions 
+ * 
+ * @return uint8_t : TRUE if all the results match 
+ */
+static uint8_t dsp_test_ops_check(void); 
+
+
+/**
+ * @brief Run the test signal through a test case in blocks and checksum the output 
+ * 
+ * @param test_case : test case 
+ * @return uint32_t : checksum of the output 
+ */
+static uint32_t dsp_test_case_run(dsp_test_case_t test_case); 
+
+
+/**
+ * @brief Division rounded toward minus infinity 
+ * 
+ * @param num : numerator 
+ * @param den : denominator (> 0) 
+ * @return int32_t : quotient 
+ */
+static int32_t dsp_test_floor_div(
+    int32_t num, 
+    int32_t den); 
+
+
+/**
+ * @brief Moving average outputs that differ from the sums of their windows 
+ * 
+ * @return uint16_t : mismatches 
+ */
+static uint16_t dsp_test_ma_check(void); 
+
+
+/**
+ * @brief CIC outputs that differ from the test signal convolved with the CIC's impulse 
+ *        response 
+ * 
+ * @return uint16_t : mismatches 
+ */
+static uint16_t dsp_test_cic_check(void); 
+
+
+/**
+ * @brief Largest difference between the single pole low pass and a double precision 
+ *        version 
+ * 
+ * @return uint32_t : largest difference (Q15 LSBs) 
+ */
+static uint32_t dsp_test_iir1_error(void); 
+
+
+/**
+ * @brief Largest difference between the biquad and a double precision version 
+ * 
+ * @return uint32_t : largest difference (Q15 LSBs) 
+ */
+static uint32_t dsp_test_biquad_error(void); 
+
+
+/**
+ * @brief Print the result of a reference check 
+ * 
+ * @param name : check name 
+ * @param value : mismatches or largest difference 
+ * @param unit : what 'value' counts 
+ * @param limit : largest 'value' that passes 
+ * @return uint8_t : TRUE if the check passed 
+ */
+static uint8_t dsp_test_ref_report(
+    const char *name, 
+    uint32_t value, 
+    const char *unit, 
+    uint32_t limit); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Setup code 
+
+void dsp_test_init(void)
+{
+    char line[DSP_TEST_LINE_LEN]; 
+    uint32_t seed = DSP_TEST_SEED, checksum; 
+    uint8_t failed = CLEAR; 
+
+    memset((void *)&dsp_test_app_stages, CLEAR, sizeof(dsp_test_app_stages)); 
+
+    // Initialize GPIO ports 
+    gpio_port_init(); 
+
+    // Initialize UART 
+    uart_init(
+        USART2, 
+        GPIOA, 
+        PIN_3, 
+        PIN_2, 
+        UART_FRAC_42_9600, 
+        UART_MANT_42_9600, 
+        UART_DMA_DISABLE, 
+        UART_DMA_DISABLE); 
+
+    uart_sendstring(USART2, DSP_SIMD ? "\r\nDSP instructions\r\n" : "\r\nPlain C\r\n"); 
+
+    //================================================== 
+    // Checks 
+
+    if (!dsp_test_ops_check())
+    {
+        failed++; 
+    }
+
+    // Test signal - noise, a square wave and large steps 
+    for (uint16_t i = CLEAR; i < DSP_TEST_SIGNAL_LEN; i++)
+    {
+        dsp_test_signal[i] = (dsp_q15_t)((int16_t)(dsp_test_rand(&seed) >> 16) >>
+                                         DSP_TEST_NOISE_SHIFT); 
+
+        if (i >= DSP_TEST_STEP_START)
+        {
+            dsp_test_signal[i] += (i & 0x08) ? DSP_TEST_STEP_AMP : -DSP_TEST_STEP_AMP; 
+        }
+        else
+        {
+            dsp_test_signal[i] += ((i % DSP_TEST_SQUARE_PERIOD) <
+                                   (DSP_TEST_SQUARE_PERIOD / 2)) ?
+                                  DSP_TEST_SQUARE_AMP : -DSP_TEST_SQUARE_AMP; 
+        }
+    }
+
+    for (uint8_t i = CLEAR; i < DSP_TEST_CASE_NUM; i++)
+    {
+        checksum = dsp_test_case_run((dsp_test_case_t)i); 
+        failed += (checksum != dsp_test_expected[i]); 
+
+        snprintf(
+            line, 
+            DSP_TEST_LINE_LEN, 
+            "%-10s 0x%08lX  %s\r\n", 
+            dsp_test_names[i], 
+            (unsigned long)checksum, 
+            (checksum == dsp_test_expected[i]) ? "PASS" : "FAIL"); 
+        uart_sendstring(USART2, line); 
+    }
+
+    // The checksums only catch changes so the filters are also checked against exact 
+    // sums and double precision versions 
+    failed += !dsp_test_ref_report("ma_ref", dsp_test_ma_check(), "mismatches", 0); 
+    failed += !dsp_test_ref_report("cic_ref", dsp_test_cic_check(), "mismatches", 0); 
+    failed += !dsp_test_ref_report("iir1_ref", dsp_test_iir1_error(), "LSB max", 
+                                   DSP_TEST_IIR1_LSB_MAX); 
+    failed += !dsp_test_ref_report("biquad_ref", dsp_test_biquad_error(), "LSB max", 
+                                   DSP_TEST_BIQUAD_LSB_MAX); 
+
+    snprintf(line, DSP_TEST_LINE_LEN, "%u failed\r\n\n", (unsigned)failed); 
+    uart_sendstring(USART2, line); 
+
+    //================================================== 
+
+    //================================================== 
+    // Live ADC filtering 
+
+    // Initialize the ADC port (called once) 
+    adc1_clock_enable(RCC); 
+    adc_port_init(
+        ADC1, 
+        ADC1_COMMON, 
+        ADC_PCLK2_4, 
+        ADC_RES_8, 
+        ADC_PARAM_ENABLE, 
+        ADC_PARAM_DISABLE, 
+        ADC_PARAM_DISABLE, 
+        ADC_PARAM_ENABLE, 
+        ADC_PARAM_ENABLE, 
+        ADC_PARAM_DISABLE, 
+        ADC_PARAM_DISABLE); 
+
+    // Initialize the ADC pin and channel 
+    adc_pin_init(ADC1, GPIOA, PIN_6, ADC_CHANNEL_6, ADC_SMP_15); 
+    adc_seq(ADC1, ADC_CHANNEL_6, ADC_SEQ_1); 
+    adc_on(ADC1); 
+
+    dsp_biquad_q15_init(&dsp_test_app_stages.biquad, dsp_test_lpf); 
+    dsp_cic_q15_init(&dsp_test_app_stages.cic, DSP_TEST_CIC_ORDER, DSP_TEST_CIC_RATE_LOG2); 
+
+    // Blocks are read in the application 
+    adc_acq_init(TIM2, DSP_TEST_RATE, DSP_TEST_SCANS, NULL, EXTI_PRIORITY_1); 
+    adc_acq_start(); 
+
+    //================================================== 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test code 
+
+void dsp_test_app(void)
+{
+    const dsp_stage_q15_t chain[] = 
+    {
+        { dsp_biquad_q15, (void *)&dsp_test_app_stages.biquad }, 
+        { dsp_cic_q15, (void *)&dsp_test_app_stages.cic }
+    }; 
+    dsp_q15_t samples[DSP_TEST_SCANS]; 
+    adc_acq_block_t block; 
+    uint16_t len; 
+
+    if (!event_take(EVENT_MASK(EVENT_DMA2_0)) || !adc_acq_block_get(&block))
+    {
+        return; 
+    }
+
+    dsp_adc_to_q15(block.data, block.channels, samples, block.scans, DSP_TEST_ADC_BITS); 
+    adc_acq_block_release(); 
+
+    len = dsp_chain_q15(chain, sizeof(chain) / sizeof(chain[0]), samples, block.scans); 
+
+    if (len)
+    {
+        dsp_test_app_out = samples[len - 1]; 
+    }
+
+    if ((block.number + 1) % DSP_TEST_PRINT_BLOCKS)
+    {
+        return; 
+    }
+
+    // Back to ADC counts 
+    uart_sendstring(USART2, "\rFiltered ADC: "); 
+    uart_send_integer(USART2, (int16_t)(dsp_test_app_out >> (15 - DSP_TEST_ADC_BITS))); 
+    uart_send_spaces(USART2, DSP_TEST_PRINT_SPACES); 
+}
+
+
+// Next pseudo random number 
+static uint32_t dsp_test_rand(uint32_t *seed)
+{
+    *seed = (*seed * DSP_TEST_LCG_MUL) + DSP_TEST_LCG_INC; 
+    return *seed; 
+}
+
+
+// Add a value to a checksum 
+static uint32_t dsp_test_hash(
+    uint32_t hash, 
+    uint32_t value, 
+    uint8_t bytes)
+{
+    while (bytes--)
+    {
+        hash = (hash ^ (value & 0xFF)) * DSP_TEST_FNV_PRIME; 
+        value >>= 8; 
+    }
+
+    return hash; 
+}
+
+
+// Set up the stages used by a test case 
+static uint8_t dsp_test_stages_init(
+    dsp_test_stages_t *stages, 
+    dsp_stage_q15_t *chain, 
+    dsp_test_case_t test_case)
+{
+    uint8_t num = CLEAR; 
+
+    stages->offset.offset = DSP_TEST_OFFSET; 
+    dsp_ma_q15_init(&stages->ma, DSP_TEST_MA_LOG2, CLEAR); 
+    dsp_iir1_q15_init(&stages->iir1, DSP_TEST_IIR_ALPHA, CLEAR); 
+    dsp_iir1_q31_init(&stages->iir1_q31, DSP_TEST_IIR_Q31_ALPHA, CLEAR); 
+    dsp_biquad_q15_init(&stages->biquad, dsp_test_lpf); 
+    dsp_cic_q15_init(&stages->cic, DSP_TEST_CIC_ORDER, DSP_TEST_CIC_RATE_LOG2); 
+
+    if ((test_case == DSP_TEST_CASE_OFFSET) || (test_case == DSP_TEST_CASE_CHAIN))
+    {
+        chain[num++] = (dsp_stage_q15_t){ dsp_offset_q15, (void *)&stages->offset }; 
+    }
+
+    if ((test_case == DSP_TEST_CASE_MA) || (test_case == DSP_TEST_CASE_CHAIN))
+    {
+        chain[num++] = (dsp_stage_q15_t){ dsp_ma_q15, (void *)&stages->ma }; 
+    }
+
+    if ((test_case == DSP_TEST_CASE_IIR1) || (test_case == DSP_TEST_CASE_CHAIN))
+    {
+        chain[num++] = (dsp_stage_q15_t){ dsp_iir1_q15, (void *)&stages->iir1 }; 
+    }
+
+    if ((test_case == DSP_TEST_CASE_BIQUAD) || (test_case == DSP_TEST_CASE_CHAIN))
+    {
+        chain[num++] = (dsp_stage_q15_t){ dsp_biquad_q15, (void *)&stages->biquad }; 
+    }
+
+    if ((test_case == DSP_TEST_CASE_CIC) || (test_case == DSP_TEST_CASE_CHAIN))
+    {
+        chain[num++] = (dsp_stage_q15_t){ dsp_cic_q15, (void *)&stages->cic }; 
+    }
+
+    return num; 
+}
+
+
+// Check the DSP operations against the plain C versions 
+static uint8_t dsp_test_ops_check(void)
+{
+    char line[DSP_TEST_LINE_LEN]; 
+    uint32_t seed = DSP_TEST_SEED, x, y; 
+    int32_t acc; 
+    int64_t acc64; 
+    uint16_t mismatches = CLEAR; 
+
+    for (uint16_t i = CLEAR; i < DSP_TEST_OPS_CHECKS; i++)
+    {
+        x = dsp_test_rand(&seed); 
+        y = dsp_test_rand(&seed); 
+        acc = (int32_t)dsp_test_rand(&seed); 
+        acc64 = (int64_t)(((uint64_t)(uint32_t)acc << 32) | dsp_test_rand(&seed)); 
+
+        // Include the saturation limits 
+        if (i & 0x01)
+        {
+            x |= 0x80008000; 
+            y = (i & 0x02) ? 0x7FFF7FFF : 0x80008000; 
+        }
+
+        mismatches += (dsp_smlad(x, y, acc) != dsp_smlad_c(x, y, acc)); 
+        mismatches += (dsp_smlald(x, y, acc64) != dsp_smlald_c(x, y, acc64)); 
+        mismatches += (dsp_qadd((int32_t)x, (int32_t)y) != 
+                       dsp_qadd_c((int32_t)x, (int32_t)y)); 
+        mismatches += (dsp_qsub((int32_t)x, (int32_t)y) != 
+                       dsp_qsub_c((int32_t)x, (int32_t)y)); 
+        mismatches += (dsp_qadd16(x, y) != dsp_qadd16_c(x, y)); 
+        mismatches += (dsp_ssat16(acc) != dsp_ssat16_c(acc)); 
+    }
+
+    snprintf(
+        line, 
+        DSP_TEST_LINE_LEN, 
+        "%-10s %u mismatches  %s\r\n", 
+        "ops", 
+        (unsigned)mismatches, 
+        mismatches ? "FAIL" : "PASS"); 
+    uart_sendstring(USART2, line); 
+
+    return !mismatches; 
+}
+
+
+// Run the test signal through a test case in blocks and checksum the output 
+static uint32_t dsp_test_case_run(dsp_test_case_t test_case)
+{
+    dsp_stage_q15_t chain[DSP_TEST_CASE_NUM]; 
+    uint32_t hash = DSP_TEST_FNV_OFFSET; 
+    uint16_t len, num_out; 
+    uint8_t num_stages; 
+
+    num_stages = dsp_test_stages_init(&dsp_test_stages, chain, test_case); 
+
+    for (uint16_t i = CLEAR; i < DSP_TEST_SIGNAL_LEN; i += len)
+    {
+        len = DSP_TEST_SIGNAL_LEN - i; 
+
+        if (len > DSP_TEST_BLOCK_LEN)
+        {
+            len = DSP_TEST_BLOCK_LEN; 
+        }
+
+        if (test_case == DSP_TEST_CASE_IIR1_Q31)
+        {
+            for (uint16_t j = CLEAR; j < len; j++)
+            {
+                dsp_test_block_q31[j] = (dsp_q31_t)dsp_test_signal[i + j] * (1 << 16); 
+            }
+
+            dsp_iir1_q31(&dsp_test_stages.iir1_q31, dsp_test_block_q31, 
+                         dsp_test_block_q31, len); 
+
+            for (uint16_t j = CLEAR; j < len; j++)
+            {
+                hash = dsp_test_hash(hash, (uint32_t)dsp_test_block_q31[j], 4); 
+            }
+
+            continue; 
+        }
+
+        memcpy((void *)dsp_test_block, (void *)&dsp_test_signal[i], 
+               len * sizeof(dsp_q15_t)); 
+        num_out = dsp_chain_q15(chain, num_stages, dsp_test_block, len); 
+
+        for (uint16_t j = CLEAR; j < num_out; j++)
+        {
+            hash = dsp_test_hash(hash, (uint16_t)dsp_test_block[j], 2); 
+        }
+    }
+
+    return hash; 
+}
+
+
+// Division rounded toward minus infinity 
+static int32_t dsp_test_floor_div(
+    int32_t num, 
+    int32_t den)
+{
+    // C division rounds toward 0 
+    return (num < 0) ? ((num - (den - 1)) / den) : (num / den); 
+}
+
+
+// Moving average outputs that differ from the sums of their windows 
+static uint16_t dsp_test_ma_check(void)
+{
+    const uint16_t window = 1 << DSP_TEST_MA_LOG2; 
+    uint16_t mismatches = CLEAR; 
+    int32_t sum; 
+
+    dsp_ma_q15_init(&dsp_test_stages.ma, DSP_TEST_MA_LOG2, CLEAR); 
+    dsp_ma_q15(&dsp_test_stages.ma, dsp_test_signal, dsp_test_block, DSP_TEST_SIGNAL_LEN); 
+
+    // The window starts out filled with the starting value (0) 
+    for (uint16_t i = CLEAR; i < DSP_TEST_SIGNAL_LEN; i++)
+    {
+        sum = CLEAR; 
+
+        for (uint16_t k = CLEAR; (k < window) && (k <= i); k++)
+        {
+            sum += dsp_test_signal[i - k]; 
+        }
+
+        mismatches += (dsp_test_block[i] != dsp_test_floor_div(sum, window)); 
+    }
+
+    return mismatches; 
+}
+
+
+// CIC outputs that differ from the test signal convolved with the CIC's impulse response 
+static uint16_t dsp_test_cic_check(void)
+{
+    const uint16_t rate = 1 << DSP_TEST_CIC_RATE_LOG2; 
+    int32_t taps[DSP_TEST_CIC_TAPS], next[DSP_TEST_CIC_TAPS], sum; 
+    uint16_t len = 1, num_out, mismatches = CLEAR, n; 
+
+    // Each integrator/comb pair is a sum of the last 'rate' samples so the impulse 
+    // response is a run of 'rate' ones convolved with itself once per pair 
+    memset((void *)taps, CLEAR, sizeof(taps)); 
+    taps[0] = 1; 
+
+    for (uint8_t stage = CLEAR; stage < DSP_TEST_CIC_ORDER; stage++)
+    {
+        memset((void *)next, CLEAR, sizeof(next)); 
+
+        for (uint16_t i = CLEAR; i < len; i++)
+        {
+            for (uint16_t k = CLEAR; k < rate; k++)
+            {
+                next[i + k] += taps[i]; 
+            }
+        }
+
+        memcpy((void *)taps, (void *)next, sizeof(taps)); 
+        len += rate - 1; 
+    }
+
+    dsp_cic_q15_init(&dsp_test_stages.cic, DSP_TEST_CIC_ORDER, DSP_TEST_CIC_RATE_LOG2); 
+    num_out = dsp_cic_q15(&dsp_test_stages.cic, dsp_test_signal, dsp_test_block, 
+                          DSP_TEST_SIGNAL_LEN); 
+    mismatches += (num_out != (DSP_TEST_SIGNAL_LEN / rate)); 
+
+    // An output follows every 'rate' inputs and is scaled by the DC gain rate^order 
+    for (uint16_t m = CLEAR; m < num_out; m++)
+    {
+        n = (uint16_t)(((m + 1) * rate) - 1); 
+        sum = CLEAR; 
+
+        for (uint16_t k = CLEAR; (k < DSP_TEST_CIC_TAPS) && (k <= n); k++)
+        {
+            sum += taps[k] * dsp_test_signal[n - k]; 
+        }
+
+        mismatches += (dsp_test_block[m] != 
+                       dsp_test_floor_div(sum, 1 << (DSP_TEST_CIC_ORDER * 
+                                                     DSP_TEST_CIC_RATE_LOG2))); 
+    }
+
+    return mismatches; 
+}
+
+
+// Largest difference between the single pole low pass and a double precision version 
+static uint32_t dsp_test_iir1_error(void)
+{
+    const double alpha = (double)DSP_TEST_IIR_ALPHA / 32768.0; 
+    double y = 0.0, step, error, max = 0.0; 
+
+    dsp_iir1_q15_init(&dsp_test_stages.iir1, DSP_TEST_IIR_ALPHA, CLEAR); 
+    dsp_iir1_q15(&dsp_test_stages.iir1, dsp_test_signal, dsp_test_block, 
+                 DSP_TEST_SIGNAL_LEN); 
+
+    for (uint16_t i = CLEAR; i < DSP_TEST_SIGNAL_LEN; i++)
+    {
+        // The large steps saturate the filter's Q31 input to state difference 
+        step = dsp_test_signal[i] - y; 
+        step = (step > DSP_Q15_MAX) ? DSP_Q15_MAX : step; 
+        step = (step < -DSP_Q15_MAX - 1) ? -DSP_Q15_MAX - 1 : step; 
+        y += alpha * step; 
+
+        error = y - dsp_test_block[i]; 
+        error = (error < 0.0) ? -error : error; 
+        max = (error > max) ? error : max; 
+    }
+
+    return (uint32_t)(max + 0.5); 
+}
+
+
+// Largest difference between the biquad and a double precision version 
+static uint32_t dsp_test_biquad_error(void)
+{
+    double b[3], a[2], x1 = 0.0, x2 = 0.0, y0, y1 = 0.0, y2 = 0.0, error, max = 0.0; 
+
+    for (uint8_t i = CLEAR; i < 3; i++)
+    {
+        b[i] = (double)dsp_test_lpf[i] / (1 << DSP_Q14_SHIFT); 
+    }
+
+    a[0] = (double)dsp_test_lpf[3] / (1 << DSP_Q14_SHIFT); 
+    a[1] = (double)dsp_test_lpf[4] / (1 << DSP_Q14_SHIFT); 
+
+    dsp_biquad_q15_init(&dsp_test_stages.biquad, dsp_test_lpf); 
+    dsp_biquad_q15(&dsp_test_stages.biquad, dsp_test_signal, dsp_test_block, 
+                   DSP_TEST_SIGNAL_LEN); 
+
+    for (uint16_t i = CLEAR; i < DSP_TEST_SIGNAL_LEN; i++)
+    {
+        y0 = (b[0] * dsp_test_signal[i]) + (b[1] * x1) + (b[2] * x2) -
+             (a[0] * y1) - (a[1] * y2); 
+        x2 = x1; 
+        x1 = dsp_test_signal[i]; 
+        y2 = y1; 
+        y1 = y0; 
+
+        error = y0 - dsp_test_block[i]; 
+        error = (error < 0.0) ? -error : error; 
+        max = (error > max) ? error : max; 
+    }
+
+    return (uint32_t)(max + 0.5); 
+}
+
+
+// Print the result of a reference check 
+static uint8_t dsp_test_ref_report(
+    const char *name, 
+    uint32_t value, 
+    const char *unit, 
+    uint32_t limit)
+{
+    char line[DSP_TEST_LINE_LEN]; 
+
+    snprintf(
+        line, 
+        DSP_TEST_LINE_LEN, 
+        "%-10s %lu %s  %s\r\n", 
+        name, 
+        (unsigned long)value, 
+        unit, 
+        (value <= limit) ? "PASS" : "FAIL"); 
+    uart_sendstring(USART2, line); 
+
+    return (value <= limit); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Benchmarks 
+
+// Each benchmark filters DSP_TEST_BENCH_LEN samples of the test signal. The signal is 
+// only made by the test setup but the sample values don't change the time. 
+
+static void dsp_test_bench_ma(void)
+{
+    dsp_ma_q15(&dsp_test_bench_stages.ma, dsp_test_signal, dsp_test_block, 
+               DSP_TEST_BENCH_LEN); 
+}
+
+BENCH_REGISTER("dsp_ma", dsp_test_bench_ma)
+
+
+static void dsp_test_bench_iir1(void)
+{
+    dsp_iir1_q15(&dsp_test_bench_stages.iir1, dsp_test_signal, dsp_test_block, 
+                 DSP_TEST_BENCH_LEN); 
+}
+
+BENCH_REGISTER("dsp_iir1", dsp_test_bench_iir1)
+
+
+static void dsp_test_bench_biquad(void)
+{
+    dsp_biquad_q15(&dsp_test_bench_stages.biquad, dsp_test_signal, dsp_test_block, 
+                   DSP_TEST_BENCH_LEN); 
+}
+
+BENCH_REGISTER("dsp_biquad", dsp_test_bench_biquad)
+
+
+static void dsp_test_bench_cic(void)
+{
+    dsp_cic_q15(&dsp_test_bench_stages.cic, dsp_test_signal, dsp_test_block, 
+                DSP_TEST_BENCH_LEN); 
+}
+
+BENCH_REGISTER("dsp_cic", dsp_test_bench_cic)
+
+
+// Same biquad in single precision (FPU) 
+static void dsp_test_bench_biquad_float(void)
+{
+    static float x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f; 
+    const float scale = 1.0f / (1 << DSP_Q14_SHIFT); 
+    float x, y; 
+
+    for (uint16_t i = CLEAR; i < DSP_TEST_BENCH_LEN; i++)
+    {
+        x = (float)dsp_test_signal[i]; 
+        y = (scale * dsp_test_lpf[0] * x) + (scale * dsp_test_lpf[1] * x1) +
+            (scale * dsp_test_lpf[2] * x2) - (scale * dsp_test_lpf[3] * y1) -
+            (scale * dsp_test_lpf[4] * y2); 
+        x2 = x1; 
+        x1 = x; 
+        y2 = y1; 
+        y1 = y; 
+        dsp_test_block[i] = (dsp_q15_t)y; 
+    }
+}
+
+BENCH_REGISTER("dsp_biquad_float", dsp_test_bench_biquad_float)
+
+
+// Same biquad in double precision (software on the target) 
+static void dsp_test_bench_biquad_double(void)
+{
+    static double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0; 
+    const double scale = 1.0 / (1 << DSP_Q14_SHIFT); 
+    double x, y; 
+
+    for (uint16_t i = CLEAR; i < DSP_TEST_BENCH_LEN; i++)
+    {
+        x = (double)dsp_test_signal[i]; 
+        y = (scale * dsp_test_lpf[0] * x) + (scale * dsp_test_lpf[1] * x1) +
+            (scale * dsp_test_lpf[2] * x2) - (scale * dsp_test_lpf[3] * y1) -
+            (scale * dsp_test_lpf[4] * y2); 
+        x2 = x1; 
+        x1 = x; 
+        y2 = y1; 
+        y1 = y; 
+        dsp_test_block[i] = (dsp_q15_t)y; 
+    }
+}
+
+BENCH_REGISTER("dsp_biquad_double", dsp_test_bench_biquad_double)
+
+//=======================================================================================
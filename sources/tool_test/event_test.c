@@ -0,0 +1,384 @@
+/**
+ * @file event_test.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Interrupt event word test 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "event_test.h" 
+#include "stm32f4xx_it.h" 
+
+#ifdef SIM_HOST_BUILD
+#include <pthread.h> 
+#include <sched.h> 
+#include <signal.h> 
+#include <stdatomic.h> 
+#include <time.h> 
+#endif   // SIM_HOST_BUILD 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define EVENT_TEST_WINDOW 10000          // TIM10 events between results (1s) 
+#define EVENT_TEST_LINE_LEN 100          // Max result line length 
+
+// Timer events and the event set by the main loop 
+#define EVENT_TEST_TIMER_EVENTS (EVENT_MASK(EVENT_TIM1_BRK_TIM9) |  \
+                                 EVENT_MASK(EVENT_TIM1_UP_TIM10) |  \
+                                 EVENT_MASK(EVENT_TIM1_TRG_TIM11))
+#define EVENT_TEST_MAIN_EVENT EVENT_EXTI0 
+
+// Host stress test 
+#define EVENT_TEST_THREADS 4             // Threads setting events 
+#define EVENT_TEST_ROUNDS 2000           // Times each thread sets each of its events 
+#define EVENT_TEST_TIMEOUT_NS 2000000000 // No progress for this long - event lost 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Event counts 
+typedef struct event_test_data_s
+{
+    uint32_t tim9_count;                 // TIM9 events taken 
+    uint32_t tim10_count;                // TIM10 events taken 
+    uint32_t tim11_count;                // TIM11 events taken 
+    uint32_t main_count;                 // Main loop events taken 
+    uint32_t window_count;               // Results sent 
+}
+event_test_data_t; 
+
+static event_test_data_t event_test_data; 
+
+#ifdef SIM_HOST_BUILD
+
+// Host stress test counts - set by the threads and taken by the main loop 
+static atomic_uint event_test_sent[EVENT_NUM]; 
+static atomic_uint event_test_taken[EVENT_NUM]; 
+static atomic_uint event_test_abort; 
+
+#endif   // SIM_HOST_BUILD 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Send the event counts to the serial terminal 
+ */
+static void event_test_output(void); 
+
+#ifdef SIM_HOST_BUILD
+
+/**
+ * @brief Host stress test - several threads set events while the main loop takes them 
+ */
+static void event_test_stress(void); 
+
+#endif   // SIM_HOST_BUILD 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Setup code 
+
+void event_test_init(void)
+{
+    // Initialize GPIO ports 
+    gpio_port_init(); 
+
+    // Initialize UART - used to output the results 
+    uart_init(
+        USART2, 
+        GPIOA, 
+        PIN_3, 
+        PIN_2, 
+        UART_FRAC_42_9600, 
+        UART_MANT_42_9600, 
+        UART_DMA_DISABLE, 
+        UART_DMA_DISABLE); 
+
+    // Initialize interrupt handler events 
+    int_handler_init(); 
+
+#ifdef SIM_HOST_BUILD
+    event_test_stress(); 
+    int_handler_init(); 
+#endif   // SIM_HOST_BUILD 
+
+    // Periodic (counter update) interrupt timers - all with the same period 
+    tim_9_to_11_counter_init(
+        TIM9, 
+        TIM_84MHZ_1US_PSC, 
+        0x0064,  // ARR=100, (100 counts)*(1us/count) = 100us 
+        TIM_UP_INT_ENABLE); 
+    tim_9_to_11_counter_init(
+        TIM10, 
+        TIM_84MHZ_1US_PSC, 
+        0x0064,  // ARR=100, (100 counts)*(1us/count) = 100us 
+        TIM_UP_INT_ENABLE); 
+    tim_9_to_11_counter_init(
+        TIM11, 
+        TIM_84MHZ_1US_PSC, 
+        0x0064,  // ARR=100, (100 counts)*(1us/count) = 100us 
+        TIM_UP_INT_ENABLE); 
+
+    nvic_config(TIM1_BRK_TIM9_IRQn, EXTI_PRIORITY_0); 
+    nvic_config(TIM1_UP_TIM10_IRQn, EXTI_PRIORITY_1); 
+    nvic_config(TIM1_TRG_COM_TIM11_IRQn, EXTI_PRIORITY_2); 
+
+    memset((void *)&event_test_data, CLEAR, sizeof(event_test_data)); 
+
+    tim_enable(TIM9); 
+    tim_enable(TIM10); 
+    tim_enable(TIM11); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test code 
+
+void event_test_app(void)
+{
+    event_mask_t events; 
+
+    // Set and take an event in the same event word as the timer events. Each take is a 
+    // read-modify-write of the word that a timer interrupt can land in the middle of. 
+    event_set_from_isr(EVENT_TEST_MAIN_EVENT); 
+
+    if (event_take(EVENT_MASK(EVENT_TEST_MAIN_EVENT)))
+    {
+        event_test_data.main_count++; 
+    }
+
+    // Count every pending timer event in one pass 
+    events = event_take(EVENT_TEST_TIMER_EVENTS); 
+
+    while (events)
+    {
+        switch (event_next(&events))
+        {
+            case EVENT_TIM1_BRK_TIM9:
+                event_test_data.tim9_count++; 
+                break; 
+
+            case EVENT_TIM1_UP_TIM10:
+                event_test_data.tim10_count++; 
+                break; 
+
+            case EVENT_TIM1_TRG_TIM11:
+                event_test_data.tim11_count++; 
+                break; 
+
+            default:
+                break; 
+        }
+    }
+
+    if (event_test_data.tim10_count >= EVENT_TEST_WINDOW)
+    {
+        event_test_output(); 
+
+        // Timer events were missed while the results were sent so start a new window 
+        (void)event_take(EVENT_TEST_TIMER_EVENTS); 
+        event_test_data.tim9_count = CLEAR; 
+        event_test_data.tim10_count = CLEAR; 
+        event_test_data.tim11_count = CLEAR; 
+        event_test_data.main_count = CLEAR; 
+    }
+}
+
+
+// Send the event counts to the serial terminal 
+static void event_test_output(void)
+{
+    char line[EVENT_TEST_LINE_LEN]; 
+    uint32_t min = event_test_data.tim9_count; 
+    uint32_t max = event_test_data.tim9_count; 
+
+    min = (event_test_data.tim10_count < min) ? event_test_data.tim10_count : min; 
+    min = (event_test_data.tim11_count < min) ? event_test_data.tim11_count : min; 
+    max = (event_test_data.tim10_count > max) ? event_test_data.tim10_count : max; 
+    max = (event_test_data.tim11_count > max) ? event_test_data.tim11_count : max; 
+
+    // The timers are started one after the other so the counts can be one apart 
+    snprintf(
+        line, 
+        EVENT_TEST_LINE_LEN, 
+        "%lu: TIM9 %lu  TIM10 %lu  TIM11 %lu  main %lu  %s\r\n", 
+        (unsigned long)event_test_data.window_count++, 
+        (unsigned long)event_test_data.tim9_count, 
+        (unsigned long)event_test_data.tim10_count, 
+        (unsigned long)event_test_data.tim11_count, 
+        (unsigned long)event_test_data.main_count, 
+        ((max - min) <= 1) ? "ok" : "LOST"); 
+    uart_sendstring(USART2, line); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Host stress test 
+
+#ifdef SIM_HOST_BUILD
+
+// Thread - sets its share of the events 
+static void *event_test_producer(void *context)
+{
+    uint32_t thread = (uint32_t)(uintptr_t)context; 
+
+    for (uint32_t round = CLEAR; round < EVENT_TEST_ROUNDS; round++)
+    {
+        for (uint32_t event = thread; event < EVENT_NUM; event += EVENT_TEST_THREADS)
+        {
+            // Wait for the last set of this event to be taken so each set should be 
+            // taken exactly once 
+            while (atomic_load(&event_test_taken[event]) != 
+                   atomic_load(&event_test_sent[event]))
+            {
+                if (atomic_load(&event_test_abort))
+                {
+                    return NULL; 
+                }
+
+                sched_yield(); 
+            }
+
+            atomic_fetch_add(&event_test_sent[event], 1); 
+            event_set_from_isr((event_id_t)event); 
+        }
+    }
+
+    return NULL; 
+}
+
+
+// Monotonic time (ns) 
+static uint64_t event_test_time_ns(void)
+{
+    struct timespec now; 
+    clock_gettime(CLOCK_MONOTONIC, &now); 
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec; 
+}
+
+
+// Host stress test 
+static void event_test_stress(void)
+{
+    // Take masks - all events, even events and odd events 
+    static const event_mask_t masks[] =
+    {
+        ~(event_mask_t)CLEAR, 
+        0x5555555555555555ULL, 
+        0xAAAAAAAAAAAAAAAAULL
+    }; 
+
+    pthread_t threads[EVENT_TEST_THREADS]; 
+    sigset_t signals, old_signals; 
+    uint64_t expected = (uint64_t)EVENT_TEST_ROUNDS * EVENT_NUM; 
+    uint64_t taken = CLEAR, duplicates = CLEAR, lost = CLEAR; 
+    uint64_t progress_ns = event_test_time_ns(); 
+    uint32_t pass = CLEAR; 
+    char line[EVENT_TEST_LINE_LEN]; 
+
+    for (uint8_t i = CLEAR; i < EVENT_NUM; i++)
+    {
+        atomic_store(&event_test_sent[i], CLEAR); 
+        atomic_store(&event_test_taken[i], CLEAR); 
+    }
+
+    atomic_store(&event_test_abort, CLEAR); 
+
+    // The threads only touch RAM - keep the simulator's signals on the main thread 
+    sigfillset(&signals); 
+    pthread_sigmask(SIG_BLOCK, &signals, &old_signals); 
+
+    for (uint32_t i = CLEAR; i < EVENT_TEST_THREADS; i++)
+    {
+        pthread_create(&threads[i], NULL, event_test_producer, (void *)(uintptr_t)i); 
+    }
+
+    pthread_sigmask(SIG_SETMASK, &old_signals, NULL); 
+
+    // Take events with take_all and with partial masks until every set is taken 
+    while (taken < expected)
+    {
+        event_mask_t events = (pass & 1U) ? event_take_all() :
+                                            event_take(masks[(pass >> 1) % 3U]); 
+        pass++; 
+
+        if (!events)
+        {
+            if ((event_test_time_ns() - progress_ns) > EVENT_TEST_TIMEOUT_NS)
+            {
+                // A thread is waiting on an event that will never be taken 
+                atomic_store(&event_test_abort, SET_BIT); 
+                break; 
+            }
+
+            continue; 
+        }
+
+        progress_ns = event_test_time_ns(); 
+
+        while (events)
+        {
+            event_id_t event = event_next(&events); 
+
+            if (atomic_load(&event_test_taken[event]) >= 
+                atomic_load(&event_test_sent[event]))
+            {
+                duplicates++; 
+            }
+
+            atomic_fetch_add(&event_test_taken[event], 1); 
+            taken++; 
+        }
+    }
+
+    for (uint32_t i = CLEAR; i < EVENT_TEST_THREADS; i++)
+    {
+        pthread_join(threads[i], NULL); 
+    }
+
+    for (uint8_t i = CLEAR; i < EVENT_NUM; i++)
+    {
+        lost += atomic_load(&event_test_sent[i]) - atomic_load(&event_test_taken[i]); 
+    }
+
+    snprintf(
+        line, 
+        EVENT_TEST_LINE_LEN, 
+        "\r\nstress: %u threads, %llu taken, %llu lost, %llu duplicate - %s\r\n", 
+        EVENT_TEST_THREADS, 
+        (unsigned long long)taken, 
+        (unsigned long long)lost, 
+        (unsigned long long)duplicates, 
+        ((taken == expected) && !lost && !duplicates) ? "ok" : "FAIL"); 
+    uart_sendstring(USART2, line); 
+}
+
+#endif   // SIM_HOST_BUILD 
+
+//=======================================================================================
@@ -0,0 +1,234 @@
+/**
+ * @file isr_profile_test.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Interrupt handler profiler test 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "isr_profile_test.h" 
+#include "isr_profile.h" 
+#include "stm32f4xx_it.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define ISR_PROFILE_TEST_FILE "isr_prof.txt"     // SD card file the profile is added to 
+
+// Timer events taken by the main loop 
+#define ISR_PROFILE_TEST_EVENTS (EVENT_MASK(EVENT_TIM1_BRK_TIM9) |  \
+                                 EVENT_MASK(EVENT_TIM1_UP_TIM10) |  \
+                                 EVENT_MASK(EVENT_TIM1_TRG_TIM11))
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+#if ISR_PROFILE_TEST_SD
+static FATFS isr_profile_test_fs; 
+static FIL isr_profile_test_file; 
+#endif   // ISR_PROFILE_TEST_SD 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Send a profile line to the serial terminal 
+ * 
+ * @param line : profile line 
+ */
+static void isr_profile_test_terminal(const char *line); 
+
+
+#if ISR_PROFILE_TEST_SD
+
+/**
+ * @brief Append the profile to the SD card file 
+ */
+static void isr_profile_test_sd(void); 
+
+
+/**
+ * @brief Write a profile line to the open SD card file 
+ * 
+ * @param line : profile line 
+ */
+static void isr_profile_test_sd_write(const char *line); 
+
+#endif   // ISR_PROFILE_TEST_SD 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Setup code 
+
+void isr_profile_test_init(void)
+{
+    // Initialize GPIO ports 
+    gpio_port_init(); 
+
+    // Initialize UART - used for commands and to output the profile 
+    uart_init(
+        USART2, 
+        GPIOA, 
+        PIN_3, 
+        PIN_2, 
+        UART_FRAC_42_9600, 
+        UART_MANT_42_9600, 
+        UART_DMA_DISABLE, 
+        UART_DMA_DISABLE); 
+
+#if ISR_PROFILE_TEST_SD
+
+    // SPI2 and slave select pin for SD card 
+    spi_init(
+        SPI2, 
+        GPIOB,   // SCK pin GPIO port 
+        PIN_10,  // SCK pin 
+        GPIOB,   // Data (MISO/MOSI) pin GPIO port 
+        PIN_14,  // MISO pin 
+        PIN_15,  // MOSI pin 
+        SPI_BR_FPCLK_8, 
+        SPI_CLOCK_MODE_0); 
+    spi_ss_init(GPIOB, PIN_12); 
+
+    // SD card user initialization 
+    hw125_user_init(SPI2, GPIOB, GPIOX_PIN_12); 
+
+#endif   // ISR_PROFILE_TEST_SD 
+
+    // Initialize interrupt handler events 
+    int_handler_init(); 
+
+    // Update interrupt timers - the higher rate timers have the higher priorities 
+    tim_9_to_11_counter_init(
+        TIM9, 
+        TIM_84MHZ_1US_PSC, 
+        0x0064,  // ARR=100, (100 counts)*(1us/count) = 100us 
+        TIM_UP_INT_ENABLE); 
+    tim_9_to_11_counter_init(
+        TIM10, 
+        TIM_84MHZ_1US_PSC, 
+        0x03E8,  // ARR=1000, (1000 counts)*(1us/count) = 1ms 
+        TIM_UP_INT_ENABLE); 
+    tim_9_to_11_counter_init(
+        TIM11, 
+        TIM_84MHZ_1US_PSC, 
+        0x2710,  // ARR=10000, (10000 counts)*(1us/count) = 10ms 
+        TIM_UP_INT_ENABLE); 
+
+    nvic_config(TIM1_BRK_TIM9_IRQn, EXTI_PRIORITY_0); 
+    nvic_config(TIM1_UP_TIM10_IRQn, EXTI_PRIORITY_1); 
+    nvic_config(TIM1_TRG_COM_TIM11_IRQn, EXTI_PRIORITY_2); 
+
+    // Profile the timers and SysTick 
+    isr_profile_enable(TIM1_BRK_TIM9_IRQn, "TIM9"); 
+    isr_profile_enable(TIM1_UP_TIM10_IRQn, "TIM10"); 
+    isr_profile_enable(TIM1_TRG_COM_TIM11_IRQn, "TIM11"); 
+    isr_profile_enable(SysTick_IRQn, "SysTick"); 
+
+#if !ISR_PROFILE_ENABLE
+    uart_sendstring(USART2, "\r\nSet ISR_PROFILE_ENABLE to profile the handlers\r\n"); 
+#endif   // !ISR_PROFILE_ENABLE 
+
+    uart_sendstring(USART2, "\r\nd: dump  c: clear  s: write to SD card\r\n"); 
+
+    tim_enable(TIM9); 
+    tim_enable(TIM10); 
+    tim_enable(TIM11); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test code 
+
+void isr_profile_test_app(void)
+{
+    // Keep the timer events from piling up 
+    (void)event_take(ISR_PROFILE_TEST_EVENTS); 
+
+    // Single character serial terminal commands 
+    if (USART2->SR & USART_SR_RXNE)
+    {
+        switch ((char)USART2->DR)
+        {
+            case 'd':
+                isr_profile_dump(isr_profile_test_terminal); 
+                break; 
+
+            case 'c':
+                isr_profile_clear(); 
+                uart_sendstring(USART2, "\r\nprofile cleared\r\n"); 
+                break; 
+
+            case 's':
+#if ISR_PROFILE_TEST_SD
+                isr_profile_test_sd(); 
+#else   // ISR_PROFILE_TEST_SD 
+                uart_sendstring(USART2, "\r\nSD card disabled (ISR_PROFILE_TEST_SD)\r\n"); 
+#endif   // ISR_PROFILE_TEST_SD 
+                break; 
+
+            default:
+                break; 
+        }
+    }
+}
+
+
+// Send a profile line to the serial terminal 
+static void isr_profile_test_terminal(const char *line)
+{
+    uart_sendstring(USART2, (char *)line); 
+}
+
+
+#if ISR_PROFILE_TEST_SD
+
+// Append the profile to the SD card file 
+static void isr_profile_test_sd(void)
+{
+    if ((f_mount(&isr_profile_test_fs, "", HW125_MOUNT_NOW) != FR_OK) ||
+        (f_open(&isr_profile_test_file, 
+                ISR_PROFILE_TEST_FILE, 
+                FA_OPEN_APPEND | FA_WRITE) != FR_OK))
+    {
+        uart_sendstring(USART2, "\r\nSD card not available\r\n"); 
+        return; 
+    }
+
+    isr_profile_dump(isr_profile_test_sd_write); 
+    f_close(&isr_profile_test_file); 
+    uart_sendstring(USART2, "\r\nprofile written to " ISR_PROFILE_TEST_FILE "\r\n"); 
+}
+
+
+// Write a profile line to the open SD card file 
+static void isr_profile_test_sd_write(const char *line)
+{
+    f_puts(line, &isr_profile_test_file); 
+}
+
+#endif   // ISR_PROFILE_TEST_SD 
+
+//=======================================================================================
@@ -0,0 +1,696 @@
+/**
+ * @file rc_xact_test.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Radio transaction engine test 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "rc_xact_test.h" 
+#include "rc_xact.h" 
+#include "timer_wheel.h" 
+#include "sys_time.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Engine 
+#define RC_XACT_TEST_TIMEOUT 20000          // Time to wait for each response (us) 
+#define RC_XACT_TEST_ATTEMPTS 4             // Sends of a request before giving up 
+
+// Simulated link 
+#define RC_XACT_TEST_FRAMES 8               // Payloads in flight in each direction 
+#define RC_XACT_TEST_LATENCY_MAX 5000       // Longest payload delay (us) 
+#define RC_XACT_TEST_LOSS 20                // Payloads lost in the lossy phase (%) 
+#define RC_XACT_TEST_LOSSY_OK 90            // Lossy phase operations that must succeed (%) 
+#define RC_XACT_TEST_PCT 100                // Percent scale 
+
+// Simulated peer - waits for the pushed message as long as system 1 keeps sending it 
+#define RC_XACT_TEST_STACK 16               // Messages the peer holds 
+#define RC_XACT_TEST_MSG_WAIT (RC_XACT_TEST_TIMEOUT * RC_XACT_TEST_ATTEMPTS) 
+
+// Rounds 
+#define RC_XACT_TEST_CLEAN_OPS 64           // Pushes and pops in the lossless phase 
+#define RC_XACT_TEST_MSGS_MAX 512           // Messages pushed before the next round 
+#define RC_XACT_TEST_POP_PCT 40             // Pops out of all operations (%) 
+
+// Pseudo random sequence 
+#define RC_XACT_TEST_SEED 0x2545F491        // Sequence start 
+#define RC_XACT_TEST_LCG_MUL 1664525        // Sequence multiplier 
+#define RC_XACT_TEST_LCG_INC 1013904223     // Sequence increment 
+
+// Output 
+#define RC_XACT_TEST_REPORT_PERIOD 1000000  // Time between result lines (us) 
+#define RC_XACT_TEST_LINE_LEN 160           // Max terminal line length 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Messages - the same as the RC test 
+static const char
+push_cmd[] = "push", 
+pop_cmd[] = "pop", 
+push_confirm[] = "push confirm", 
+msg_confirm[] = "msg confirm", 
+no_msgs[] = "No messages to pop.", 
+msg_format[] = "msg %lu"; 
+
+// Payload on its way through the simulated link 
+typedef struct rc_xact_test_frame_s
+{
+    uint8_t payload[RC_XACT_PAYLOAD_LEN];   // Payload 
+    uint64_t due;                           // Time it arrives (us) 
+}
+rc_xact_test_frame_t; 
+
+// One direction of the simulated link - payloads arrive in the order they were sent 
+typedef struct rc_xact_test_channel_s
+{
+    rc_xact_test_frame_t frames[RC_XACT_TEST_FRAMES]; 
+    uint8_t head;                           // Next payload to arrive 
+    uint8_t count;                          // Payloads in flight 
+}
+rc_xact_test_channel_t; 
+
+// Simulated system 2 
+typedef struct rc_xact_test_peer_s
+{
+    uint8_t msgs[RC_XACT_TEST_STACK][RC_XACT_PAYLOAD_LEN];   // Saved messages 
+    uint8_t count;                          // Saved messages 
+    uint8_t msg_wait;                       // Waiting for a pushed message 
+    uint64_t wait_end;                      // End of the message wait (us) 
+    uint8_t last_msg[RC_XACT_PAYLOAD_LEN];  // Last message saved 
+}
+rc_xact_test_peer_t; 
+
+// Test data 
+typedef struct rc_xact_test_s
+{
+    // Simulated link and peer 
+    rc_xact_test_channel_t to_peer;         // System 1 to system 2 
+    rc_xact_test_channel_t to_client;       // System 2 to system 1 
+    rc_xact_test_peer_t peer;               // System 2 
+    uint8_t loss;                           // Payloads lost (%) 
+    uint32_t seed;                          // Pseudo random sequence state 
+
+    // System 1 
+    rc_xact_engine_t engine;                // Transaction engine 
+    rc_xact_t push_xact;                    // "push" request 
+    rc_xact_t msg_xact;                     // Pushed message 
+    rc_xact_t pop_xact;                     // "pop" request 
+    uint8_t push_msg[RC_XACT_PAYLOAD_LEN];  // Message being pushed 
+    uint32_t push_num;                      // Number of the message being pushed 
+
+    // Reference - messages the peer should hold (lossless phase) 
+    uint32_t ref[RC_XACT_TEST_STACK];       // Message numbers 
+    uint8_t ref_count;                      // Messages 
+    uint8_t popped[RC_XACT_TEST_MSGS_MAX / 8];   // Messages popped this round (bits) 
+    uint32_t msg_num;                       // Next message number 
+
+    // Rounds 
+    uint32_t round;                         // Round number 
+    uint32_t phase_ops;                     // Operations in the lossless phase so far 
+    uint32_t lossy_ops;                     // Operations in the lossy phase 
+    uint32_t lossy_ok;                      // Lossy phase operations that succeeded 
+
+    // Results 
+    uint32_t ops;                           // Pushes and pops done 
+    uint32_t ok;                            // Pushes and pops that succeeded 
+    uint32_t errors;                        // Wrong results 
+    uint32_t loops;                         // Main loop runs since the last report 
+    uint32_t poll_max;                      // Longest rc_xact_poll call (us) 
+    twheel_timer_t report;                  // Result output timer 
+}
+rc_xact_test_t; 
+
+static rc_xact_test_t rc_xact_test; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Next pseudo random number 
+ * 
+ * @return uint32_t : random number 
+ */
+static uint32_t rc_xact_test_rand(void); 
+
+
+/**
+ * @brief Send a payload through one direction of the simulated link 
+ * 
+ * @param channel : link direction 
+ * @param payload : payload 
+ * @return uint8_t : TRUE if the payload will arrive, FALSE if it's lost 
+ */
+static uint8_t rc_xact_test_channel_put(
+    rc_xact_test_channel_t *channel, 
+    const uint8_t *payload); 
+
+
+/**
+ * @brief Take a payload that has arrived from one direction of the simulated link 
+ * 
+ * @param channel : link direction 
+ * @param payload : buffer for the payload 
+ * @return uint8_t : TRUE if a payload was taken 
+ */
+static uint8_t rc_xact_test_channel_get(
+    rc_xact_test_channel_t *channel, 
+    uint8_t *payload); 
+
+
+/**
+ * @brief Simulated link functions used by the engine (system 1 side) 
+ */
+static uint8_t rc_xact_test_link_send(const uint8_t *payload); 
+static uint8_t rc_xact_test_link_receive(uint8_t *payload); 
+
+
+/**
+ * @brief Run the simulated system 2 - answers payloads that have arrived 
+ */
+static void rc_xact_test_peer(void); 
+
+
+/**
+ * @brief Send a payload from the simulated system 2 
+ * 
+ * @param payload : payload (string) 
+ */
+static void rc_xact_test_peer_send(const char *payload); 
+
+
+/**
+ * @brief Start the next push or pop, and the next round when this one is over 
+ */
+static void rc_xact_test_next(void); 
+
+
+/**
+ * @brief Start a round - the peer and the reference start empty and lossless 
+ */
+static void rc_xact_test_round(void); 
+
+
+/**
+ * @brief Output the results 
+ */
+static void rc_xact_test_report(void); 
+
+
+/**
+ * @brief Transaction done callbacks (see rc_test.cpp) 
+ */
+static void rc_xact_test_push_confirmed(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response); 
+
+static void rc_xact_test_push_done(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response); 
+
+static void rc_xact_test_pop_done(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Setup code 
+
+void rc_xact_test_init(void)
+{
+    static const rc_xact_link_t link =
+    {
+        &rc_xact_test_link_send, 
+        &rc_xact_test_link_receive
+    }; 
+
+    // Initialize GPIO ports 
+    gpio_port_init(); 
+
+    // Initialize UART 
+    uart_init(
+        USART2, 
+        GPIOA, 
+        PIN_3, 
+        PIN_2, 
+        UART_FRAC_42_9600, 
+        UART_MANT_42_9600, 
+        UART_DMA_DISABLE, 
+        UART_DMA_DISABLE); 
+
+    // Timeouts run on the timer wheel and the link delays on the system clock 
+    sys_time_init(TIM5, EXTI_PRIORITY_1); 
+    twheel_hw_init(); 
+
+    memset((void *)&rc_xact_test, CLEAR, sizeof(rc_xact_test)); 
+    rc_xact_test.seed = RC_XACT_TEST_SEED; 
+    rc_xact_init(
+        &rc_xact_test.engine, 
+        &link, 
+        NULL, 
+        RC_XACT_TEST_TIMEOUT, 
+        RC_XACT_TEST_ATTEMPTS); 
+    rc_xact_test_round(); 
+
+    twheel_start(&rc_xact_test.report, RC_XACT_TEST_REPORT_PERIOD, 
+                 RC_XACT_TEST_REPORT_PERIOD, NULL, NULL); 
+
+    uart_sendstring(USART2, "\r\nRadio transactions - simulated peer\r\n"); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test code 
+
+void rc_xact_test_app(void)
+{
+    uint64_t start; 
+    uint32_t poll_time; 
+
+    rc_xact_test.loops++; 
+
+    // System 1 - the rest of the loop keeps running while a transaction is in flight 
+    start = sys_time_us(); 
+    rc_xact_poll(&rc_xact_test.engine); 
+    poll_time = (uint32_t)sys_time_since(start); 
+
+    if (poll_time > rc_xact_test.poll_max)
+    {
+        rc_xact_test.poll_max = poll_time; 
+    }
+
+    // System 2 
+    rc_xact_test_peer(); 
+
+    if (rc_xact_engine_busy(&rc_xact_test.engine))
+    {
+        return; 
+    }
+
+    // Results are sent between transactions so the (blocking) output can't hold up a 
+    // response past its timeout 
+    if (twheel_take(&rc_xact_test.report))
+    {
+        rc_xact_test_report(); 
+    }
+
+    rc_xact_test_next(); 
+}
+
+
+// Output the results 
+static void rc_xact_test_report(void)
+{
+    char line[RC_XACT_TEST_LINE_LEN]; 
+
+    snprintf(
+        line, 
+        RC_XACT_TEST_LINE_LEN, 
+        "%lu %-5s ops %lu ok %lu retry %lu loop/s %lu poll %lu us err %lu %s\r\n", 
+        (unsigned long)rc_xact_test.round, 
+        rc_xact_test.loss ? "lossy" : "clean", 
+        (unsigned long)rc_xact_test.ops, 
+        (unsigned long)rc_xact_test.ok, 
+        (unsigned long)rc_xact_test.engine.stats.retries, 
+        (unsigned long)rc_xact_test.loops, 
+        (unsigned long)rc_xact_test.poll_max, 
+        (unsigned long)rc_xact_test.errors, 
+        rc_xact_test.errors ? "FAIL" : "PASS"); 
+    uart_sendstring(USART2, line); 
+
+    rc_xact_test.loops = CLEAR; 
+    rc_xact_test.poll_max = CLEAR; 
+}
+
+
+// Next pseudo random number 
+static uint32_t rc_xact_test_rand(void)
+{
+    rc_xact_test.seed = (rc_xact_test.seed * RC_XACT_TEST_LCG_MUL) + RC_XACT_TEST_LCG_INC; 
+    return rc_xact_test.seed >> 8; 
+}
+
+
+// Send a payload through one direction of the simulated link 
+static uint8_t rc_xact_test_channel_put(
+    rc_xact_test_channel_t *channel, 
+    const uint8_t *payload)
+{
+    rc_xact_test_frame_t *frame; 
+    uint64_t due; 
+
+    if ((rc_xact_test_rand() % RC_XACT_TEST_PCT) < rc_xact_test.loss)
+    {
+        return FALSE; 
+    }
+
+    if (channel->count >= RC_XACT_TEST_FRAMES)
+    {
+        return FALSE; 
+    }
+
+    // A payload can't arrive before the one sent ahead of it 
+    due = sys_time_us() + (rc_xact_test_rand() % (RC_XACT_TEST_LATENCY_MAX + 1)); 
+
+    if (channel->count)
+    {
+        frame = 
+            &channel->frames[(channel->head + channel->count - 1) % RC_XACT_TEST_FRAMES]; 
+
+        if (frame->due > due)
+        {
+            due = frame->due; 
+        }
+    }
+
+    frame = &channel->frames[(channel->head + channel->count) % RC_XACT_TEST_FRAMES]; 
+    memcpy((void *)frame->payload, (void *)payload, RC_XACT_PAYLOAD_LEN); 
+    frame->due = due; 
+    channel->count++; 
+
+    return TRUE; 
+}
+
+
+// Take a payload that has arrived from one direction of the simulated link 
+static uint8_t rc_xact_test_channel_get(
+    rc_xact_test_channel_t *channel, 
+    uint8_t *payload)
+{
+    rc_xact_test_frame_t *frame = &channel->frames[channel->head]; 
+
+    if (!channel->count || (frame->due > sys_time_us()))
+    {
+        return FALSE; 
+    }
+
+    memcpy((void *)payload, (void *)frame->payload, RC_XACT_PAYLOAD_LEN); 
+    channel->head = (channel->head + 1) % RC_XACT_TEST_FRAMES; 
+    channel->count--; 
+
+    return TRUE; 
+}
+
+
+// Send a payload from system 1 
+static uint8_t rc_xact_test_link_send(const uint8_t *payload)
+{
+    return rc_xact_test_channel_put(&rc_xact_test.to_peer, payload); 
+}
+
+
+// Read a payload sent to system 1 
+static uint8_t rc_xact_test_link_receive(uint8_t *payload)
+{
+    return rc_xact_test_channel_get(&rc_xact_test.to_client, payload); 
+}
+
+
+// Run the simulated system 2 
+static void rc_xact_test_peer(void)
+{
+    rc_xact_test_peer_t *peer = &rc_xact_test.peer; 
+    uint8_t payload[RC_XACT_PAYLOAD_LEN]; 
+
+    // Stop waiting for a pushed message or repeats of it 
+    if ((peer->msg_wait || peer->last_msg[0]) && (sys_time_us() >= peer->wait_end))
+    {
+        peer->msg_wait = CLEAR; 
+        memset((void *)peer->last_msg, CLEAR, RC_XACT_PAYLOAD_LEN); 
+    }
+
+    while (rc_xact_test_channel_get(&rc_xact_test.to_peer, payload))
+    {
+        // The pushed message can be any text other than a command. A command ends the 
+        // wait (ex. system 1 gave up on the push). 
+        if (peer->msg_wait && strcmp(push_cmd, (char *)payload) &&
+            strcmp(pop_cmd, (char *)payload))
+        {
+            peer->msg_wait = CLEAR; 
+            memcpy((void *)peer->last_msg, (void *)payload, RC_XACT_PAYLOAD_LEN); 
+
+            // The oldest message is dropped when full 
+            if (peer->count >= RC_XACT_TEST_STACK)
+            {
+                memmove((void *)peer->msgs[0], (void *)peer->msgs[1], 
+                        (RC_XACT_TEST_STACK - 1) * RC_XACT_PAYLOAD_LEN); 
+                peer->count--; 
+            }
+
+            memcpy((void *)peer->msgs[peer->count++], (void *)payload, RC_XACT_PAYLOAD_LEN); 
+            rc_xact_test_peer_send(msg_confirm); 
+        }
+        else if (peer->last_msg[0] &&
+                 !memcmp((void *)peer->last_msg, (void *)payload, RC_XACT_PAYLOAD_LEN))
+        {
+            // The message was sent again because its confirmation was lost 
+            rc_xact_test_peer_send(msg_confirm); 
+        }
+        else if (!strcmp(push_cmd, (char *)payload))
+        {
+            peer->msg_wait = SET; 
+            peer->wait_end = sys_time_us() + RC_XACT_TEST_MSG_WAIT; 
+            memset((void *)peer->last_msg, CLEAR, RC_XACT_PAYLOAD_LEN); 
+            rc_xact_test_peer_send(push_confirm); 
+        }
+        else if (!strcmp(pop_cmd, (char *)payload))
+        {
+            peer->msg_wait = CLEAR; 
+            rc_xact_test_peer_send(peer->count ?
+                                   (char *)peer->msgs[--peer->count] : no_msgs); 
+        }
+    }
+}
+
+
+// Send a payload from the simulated system 2 
+static void rc_xact_test_peer_send(const char *payload)
+{
+    uint8_t buff[RC_XACT_PAYLOAD_LEN]; 
+
+    memset((void *)buff, CLEAR, RC_XACT_PAYLOAD_LEN); 
+    strncpy((char *)buff, payload, RC_XACT_PAYLOAD_LEN - 1); 
+    rc_xact_test_channel_put(&rc_xact_test.to_client, buff); 
+}
+
+
+// Start the next push or pop 
+static void rc_xact_test_next(void)
+{
+    uint8_t pop; 
+
+    // The lossless phase is followed by the lossy phase 
+    if (!rc_xact_test.loss && (rc_xact_test.phase_ops >= RC_XACT_TEST_CLEAN_OPS))
+    {
+        rc_xact_test.loss = RC_XACT_TEST_LOSS; 
+    }
+    else if (rc_xact_test.msg_num >= RC_XACT_TEST_MSGS_MAX)
+    {
+        rc_xact_test_round(); 
+    }
+
+    if (!rc_xact_test.loss)
+    {
+        rc_xact_test.phase_ops++; 
+    }
+
+    pop = (rc_xact_test_rand() % RC_XACT_TEST_PCT) < RC_XACT_TEST_POP_PCT; 
+
+    if (pop)
+    {
+        // Any payload back is the popped message 
+        rc_xact_request(
+            &rc_xact_test.engine, 
+            &rc_xact_test.pop_xact, 
+            pop_cmd, 
+            sizeof(pop_cmd), 
+            NULL, 
+            CLEAR, 
+            &rc_xact_test_pop_done, 
+            NULL); 
+    }
+    else
+    {
+        // The message is sent once the push request is confirmed 
+        rc_xact_test.push_num = rc_xact_test.msg_num++; 
+        memset((void *)rc_xact_test.push_msg, CLEAR, RC_XACT_PAYLOAD_LEN); 
+        snprintf((char *)rc_xact_test.push_msg, RC_XACT_PAYLOAD_LEN, msg_format, 
+                 (unsigned long)rc_xact_test.push_num); 
+
+        rc_xact_request(
+            &rc_xact_test.engine, 
+            &rc_xact_test.push_xact, 
+            push_cmd, 
+            sizeof(push_cmd), 
+            push_confirm, 
+            sizeof(push_confirm), 
+            &rc_xact_test_push_confirmed, 
+            NULL); 
+    }
+}
+
+
+// Start a round 
+static void rc_xact_test_round(void)
+{
+    // Sending again must get most operations through the losses 
+    if ((rc_xact_test.lossy_ok * RC_XACT_TEST_PCT) <
+        (rc_xact_test.lossy_ops * RC_XACT_TEST_LOSSY_OK))
+    {
+        rc_xact_test.errors++; 
+    }
+
+    rc_xact_test.lossy_ops = CLEAR; 
+    rc_xact_test.lossy_ok = CLEAR; 
+    memset((void *)&rc_xact_test.to_peer, CLEAR, sizeof(rc_xact_test_channel_t)); 
+    memset((void *)&rc_xact_test.to_client, CLEAR, sizeof(rc_xact_test_channel_t)); 
+    memset((void *)&rc_xact_test.peer, CLEAR, sizeof(rc_xact_test_peer_t)); 
+    memset((void *)rc_xact_test.popped, CLEAR, sizeof(rc_xact_test.popped)); 
+    rc_xact_test.ref_count = CLEAR; 
+    rc_xact_test.msg_num = CLEAR; 
+    rc_xact_test.phase_ops = CLEAR; 
+    rc_xact_test.loss = CLEAR; 
+    rc_xact_test.round++; 
+}
+
+
+// "push" request confirmed - send the message 
+static void rc_xact_test_push_confirmed(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response)
+{
+    if (result != RC_XACT_OK)
+    {
+        rc_xact_test_push_done(xact, result, response); 
+        return; 
+    }
+
+    rc_xact_request(
+        &rc_xact_test.engine, 
+        &rc_xact_test.msg_xact, 
+        rc_xact_test.push_msg, 
+        RC_XACT_PAYLOAD_LEN, 
+        msg_confirm, 
+        sizeof(msg_confirm), 
+        &rc_xact_test_push_done, 
+        NULL); 
+}
+
+
+// Pushed message confirmed 
+static void rc_xact_test_push_done(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response)
+{
+    rc_xact_test.ops++; 
+    rc_xact_test.ok += (result == RC_XACT_OK); 
+
+    if (rc_xact_test.loss)
+    {
+        rc_xact_test.lossy_ops++; 
+        rc_xact_test.lossy_ok += (result == RC_XACT_OK); 
+        return; 
+    }
+
+    // Nothing is lost so every push must succeed 
+    if (result != RC_XACT_OK)
+    {
+        rc_xact_test.errors++; 
+        return; 
+    }
+
+    if (rc_xact_test.ref_count >= RC_XACT_TEST_STACK)
+    {
+        memmove((void *)&rc_xact_test.ref[0], (void *)&rc_xact_test.ref[1], 
+                (RC_XACT_TEST_STACK - 1) * sizeof(uint32_t)); 
+        rc_xact_test.ref_count--; 
+    }
+
+    rc_xact_test.ref[rc_xact_test.ref_count++] = rc_xact_test.push_num; 
+}
+
+
+// "pop" response 
+static void rc_xact_test_pop_done(
+    rc_xact_t *xact, 
+    rc_xact_result_t result, 
+    const uint8_t *response)
+{
+    char *end; 
+    unsigned long num; 
+    uint8_t valid; 
+
+    rc_xact_test.ops++; 
+    rc_xact_test.ok += (result == RC_XACT_OK); 
+
+    if (rc_xact_test.loss)
+    {
+        rc_xact_test.lossy_ops++; 
+        rc_xact_test.lossy_ok += (result == RC_XACT_OK); 
+    }
+
+    if (result != RC_XACT_OK)
+    {
+        // Nothing is lost so every pop must succeed 
+        rc_xact_test.errors += !rc_xact_test.loss; 
+        return; 
+    }
+
+    if (!strcmp(no_msgs, (const char *)response))
+    {
+        // With losses the peer can be empty while the reference isn't 
+        rc_xact_test.errors += (!rc_xact_test.loss && rc_xact_test.ref_count); 
+        return; 
+    }
+
+    // Any other response must be a message pushed this round and not popped before 
+    valid = !strncmp((const char *)response, msg_format, sizeof("msg ") - 1); 
+    num = strtoul((const char *)response + sizeof("msg ") - 1, &end, 10); 
+    valid = valid && (num < rc_xact_test.msg_num) &&
+            !(rc_xact_test.popped[num / 8] & (1 << (num % 8))); 
+
+    if (valid)
+    {
+        rc_xact_test.popped[num / 8] |= (1 << (num % 8)); 
+    }
+
+    // Without losses it must be the last message pushed 
+    if (!rc_xact_test.loss)
+    {
+        valid = valid && rc_xact_test.ref_count &&
+                (rc_xact_test.ref[--rc_xact_test.ref_count] == num); 
+    }
+
+    rc_xact_test.errors += !valid; 
+}
+
+//=======================================================================================
@@ -0,0 +1,512 @@
+/**
+ * @file timer_wheel_test.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Timer wheel test 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "timer_wheel_test.h" 
+#include "timer_wheel.h" 
+#include "sys_time.h" 
+#include "bench_test.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+// Simulated time check 
+#define TWHEEL_TEST_TIMERS 16               // Timers in the check 
+#define TWHEEL_TEST_STEPS 2000              // Random steps (start/stop then advance) 
+#define TWHEEL_TEST_START 0xFFFF0000        // First tick - the tick count wraps 
+#define TWHEEL_TEST_SEED 0x2545F491         // Pseudo random sequence start 
+#define TWHEEL_TEST_LCG_MUL 1664525         // Pseudo random sequence multiplier 
+#define TWHEEL_TEST_LCG_INC 1013904223      // Pseudo random sequence increment 
+#define TWHEEL_TEST_LONG_STEP 0xFFFFF       // Longest step (ticks) - reaches level 3 
+#define TWHEEL_TEST_MID_STEP 0xFFF          // Medium step (ticks) 
+#define TWHEEL_TEST_SHORT_STEP 0x3F         // Short step (ticks) 
+#define TWHEEL_TEST_PERIOD_LEVELS 3         // Periods are kept to the lower levels 
+#define TWHEEL_TEST_RESTART_MAX 0xFFF       // Longest delay when restarted by a callback 
+
+// Hardware wheel application 
+#define TWHEEL_TEST_FAST_PERIOD 250000      // Fast periodic timer (us) 
+#define TWHEEL_TEST_SLOW_PERIOD 1000000     // Slow periodic timer (us) 
+#define TWHEEL_TEST_ONCE_STEP 100000        // One shot timer delay increase (us) 
+#define TWHEEL_TEST_ONCE_MAX 3000000        // One shot timer delay before starting over 
+
+// Benchmarks 
+#define TWHEEL_TEST_BENCH_TIMERS 32         // Periodic timers in the benchmark wheel 
+#define TWHEEL_TEST_BENCH_TICKS 64          // Ticks per advance benchmark call 
+#define TWHEEL_TEST_BENCH_STRIDE 997        // Delay step between start/stop calls 
+
+// Output 
+#define TWHEEL_TEST_LINE_LEN 80             // Max terminal line length 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Reference copy of a timer in the simulated time check 
+typedef struct twheel_test_ref_s
+{
+    twheel_timer_t timer;                   // Timer in the wheel 
+    uint32_t expires;                       // Tick the timer should expire on 
+    uint32_t period;                        // Period (ticks) - 0 for one shot 
+    uint32_t restart;                       // One shot restart delay (ticks) - 0 for none 
+    uint32_t count;                         // Expiries since the last check 
+    uint8_t active;                         // Timer should be in the wheel 
+}
+twheel_test_ref_t; 
+
+static twheel_t twheel_test_wheel; 
+static twheel_test_ref_t twheel_test_refs[TWHEEL_TEST_TIMERS]; 
+static uint32_t twheel_test_errors; 
+
+// Hardware wheel application 
+typedef struct twheel_test_app_s
+{
+    twheel_timer_t fast;                    // Periodic - counted 
+    twheel_timer_t slow;                    // Periodic - updates the terminal 
+    twheel_timer_t once;                    // One shot - restarted in its callback 
+    uint32_t fast_count;                    // Fast timer expiries 
+    uint32_t once_count;                    // One shot timer expiries 
+    uint32_t once_delay;                    // Delay of the one shot timer (us) 
+}
+twheel_test_app_t; 
+
+static twheel_test_app_t twheel_test_app; 
+
+// Benchmark wheel and timers 
+static twheel_t twheel_test_bench_wheel; 
+static twheel_timer_t twheel_test_bench_timers[TWHEEL_TEST_BENCH_TIMERS]; 
+static twheel_timer_t twheel_test_bench_timer; 
+static uint8_t twheel_test_bench_ready; 
+static uint32_t twheel_test_bench_delay; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Next pseudo random number 
+ * 
+ * @param seed : sequence state 
+ * @return uint32_t : random number 
+ */
+static uint32_t twheel_test_rand(uint32_t *seed); 
+
+
+/**
+ * @brief Random delay from a random wheel level 
+ * 
+ * @details Includes 0, the longest delay and the first delay of each level above 0. 
+ * 
+ * @param seed : sequence state 
+ * @param levels : number of levels to pick from 
+ * @return uint32_t : delay (ticks) 
+ */
+static uint32_t twheel_test_delay(
+    uint32_t *seed, 
+    uint8_t levels); 
+
+
+/**
+ * @brief Simulated time check timer callback - checks the expiry against the reference 
+ * 
+ * @param timer : timer that expired 
+ */
+static void twheel_test_callback(twheel_timer_t *timer); 
+
+
+/**
+ * @brief Compare the wheel with the reference after a step 
+ */
+static void twheel_test_compare(void); 
+
+
+/**
+ * @brief Run the wheel in simulated time against the reference 
+ * 
+ * @return uint32_t : number of expiries 
+ */
+static uint32_t twheel_test_sim(void); 
+
+
+/**
+ * @brief One shot timer callback - restarts the timer with a longer delay 
+ * 
+ * @param timer : one shot timer 
+ */
+static void twheel_test_once_callback(twheel_timer_t *timer); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Setup code 
+
+void timer_wheel_test_init(void)
+{
+    char line[TWHEEL_TEST_LINE_LEN]; 
+    uint32_t expiries; 
+
+    memset((void *)&twheel_test_app, CLEAR, sizeof(twheel_test_app)); 
+
+    // Initialize GPIO ports 
+    gpio_port_init(); 
+
+    // Initialize UART 
+    uart_init(
+        USART2, 
+        GPIOA, 
+        PIN_3, 
+        PIN_2, 
+        UART_FRAC_42_9600, 
+        UART_MANT_42_9600, 
+        UART_DMA_DISABLE, 
+        UART_DMA_DISABLE); 
+
+    //==================================================
+    // Simulated time check 
+
+    expiries = twheel_test_sim(); 
+
+    snprintf(
+        line, 
+        TWHEEL_TEST_LINE_LEN, 
+        "\r\nSimulated: %lu expiries, %lu errors  %s\r\n\n", 
+        (unsigned long)expiries, 
+        (unsigned long)twheel_test_errors, 
+        twheel_test_errors ? "FAIL" : "PASS"); 
+    uart_sendstring(USART2, line); 
+
+    //==================================================
+
+    //==================================================
+    // Hardware wheel 
+
+    sys_time_init(TIM5, EXTI_PRIORITY_1); 
+    twheel_hw_init(); 
+
+    twheel_test_app.once_delay = TWHEEL_TEST_ONCE_STEP; 
+    twheel_start(&twheel_test_app.fast, TWHEEL_TEST_FAST_PERIOD, TWHEEL_TEST_FAST_PERIOD, 
+                 NULL, NULL); 
+    twheel_start(&twheel_test_app.slow, TWHEEL_TEST_SLOW_PERIOD, TWHEEL_TEST_SLOW_PERIOD, 
+                 NULL, NULL); 
+    twheel_start(&twheel_test_app.once, twheel_test_app.once_delay, CLEAR, 
+                 twheel_test_once_callback, NULL); 
+
+    //==================================================
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test code 
+
+void timer_wheel_test_app(void)
+{
+    char line[TWHEEL_TEST_LINE_LEN]; 
+
+    // Nothing else to do until a timer expires 
+    twheel_sleep(); 
+
+    twheel_test_app.fast_count += twheel_take(&twheel_test_app.fast); 
+    twheel_test_app.once_count += twheel_take(&twheel_test_app.once); 
+
+    if (!twheel_take(&twheel_test_app.slow))
+    {
+        return; 
+    }
+
+    snprintf(
+        line, 
+        TWHEEL_TEST_LINE_LEN, 
+        "\rfast: %lu  one shot: %lu (%lu ms)   ", 
+        (unsigned long)twheel_test_app.fast_count, 
+        (unsigned long)twheel_test_app.once_count, 
+        (unsigned long)(twheel_test_app.once_delay / 1000)); 
+    uart_sendstring(USART2, line); 
+}
+
+
+// Next pseudo random number 
+static uint32_t twheel_test_rand(uint32_t *seed)
+{
+    *seed = (*seed * TWHEEL_TEST_LCG_MUL) + TWHEEL_TEST_LCG_INC; 
+    return *seed >> 8; 
+}
+
+
+// Random delay from a random wheel level 
+static uint32_t twheel_test_delay(
+    uint32_t *seed, 
+    uint8_t levels)
+{
+    uint32_t r = twheel_test_rand(seed); 
+
+    switch (r & 0x07)
+    {
+        case 0:
+            return CLEAR; 
+        case 1:
+            return (1UL << (TWHEEL_SLOT_BITS * levels)) - 1; 
+        case 2:
+            // First delay of a level above 0 
+            return 1UL << (TWHEEL_SLOT_BITS * (1 + ((r >> 3) % (levels - 1)))); 
+        default:
+            return twheel_test_rand(seed) &
+                   ((1UL << (TWHEEL_SLOT_BITS * (1 + ((r >> 3) % levels)))) - 1); 
+    }
+}
+
+
+// Simulated time check timer callback 
+static void twheel_test_callback(twheel_timer_t *timer)
+{
+    twheel_test_ref_t *ref = (twheel_test_ref_t *)timer->arg; 
+
+    // The wheel's next tick is set past the one being processed before callbacks 
+    if (!ref->active || (ref->expires != (twheel_test_wheel.now - 1)))
+    {
+        twheel_test_errors++; 
+    }
+
+    ref->count++; 
+
+    if (ref->period)
+    {
+        ref->expires += ref->period; 
+    }
+    else if (ref->restart)
+    {
+        twheel_add(&twheel_test_wheel, timer, ref->restart, CLEAR); 
+        ref->expires = twheel_test_wheel.now + ref->restart; 
+    }
+    else
+    {
+        ref->active = FALSE; 
+    }
+
+    if (twheel_active(timer) != ref->active)
+    {
+        twheel_test_errors++; 
+    }
+}
+
+
+// Compare the wheel with the reference after a step 
+static void twheel_test_compare(void)
+{
+    uint32_t earliest = TWHEEL_MAX_TICKS + 1, delta; 
+    twheel_test_ref_t *ref; 
+
+    for (uint8_t i = CLEAR; i < TWHEEL_TEST_TIMERS; i++)
+    {
+        ref = &twheel_test_refs[i]; 
+
+        if (twheel_take(&ref->timer) != ref->count)
+        {
+            twheel_test_errors++; 
+        }
+
+        ref->count = CLEAR; 
+
+        if (twheel_active(&ref->timer) != ref->active)
+        {
+            twheel_test_errors++; 
+        }
+
+        if (!ref->active)
+        {
+            continue; 
+        }
+
+        // Overdue timers were missed 
+        delta = ref->expires - twheel_test_wheel.now; 
+
+        if ((int32_t)delta < 0)
+        {
+            twheel_test_errors++; 
+        }
+        else if (delta < earliest)
+        {
+            earliest = delta; 
+        }
+    }
+
+    // The wheel can wake early (to move timers down a level) but never late 
+    if (twheel_next(&twheel_test_wheel, TWHEEL_MAX_TICKS + 1) > earliest)
+    {
+        twheel_test_errors++; 
+    }
+}
+
+
+// Run the wheel in simulated time against the reference 
+static uint32_t twheel_test_sim(void)
+{
+    uint32_t seed = TWHEEL_TEST_SEED, expiries = CLEAR, r, step; 
+    twheel_test_ref_t *ref; 
+
+    memset((void *)twheel_test_refs, CLEAR, sizeof(twheel_test_refs)); 
+    twheel_init(&twheel_test_wheel, TWHEEL_TEST_START); 
+    twheel_test_errors = CLEAR; 
+
+    for (uint8_t i = CLEAR; i < TWHEEL_TEST_TIMERS; i++)
+    {
+        twheel_test_refs[i].timer.callback = twheel_test_callback; 
+        twheel_test_refs[i].timer.arg = (void *)&twheel_test_refs[i]; 
+    }
+
+    // Too long a delay is refused 
+    if (twheel_add(&twheel_test_wheel, &twheel_test_refs[0].timer, TWHEEL_MAX_TICKS + 1, 
+                   CLEAR))
+    {
+        twheel_test_errors++; 
+    }
+
+    for (uint16_t i = CLEAR; i < TWHEEL_TEST_STEPS; i++)
+    {
+        r = twheel_test_rand(&seed); 
+        ref = &twheel_test_refs[r % TWHEEL_TEST_TIMERS]; 
+
+        // Start (or restart) or stop a random timer 
+        if ((r >> 8) & 0x03)
+        {
+            ref->period = ((r >> 10) & 0x01) ?
+                          twheel_test_delay(&seed, TWHEEL_TEST_PERIOD_LEVELS) + 1 : CLEAR; 
+            ref->restart = (!ref->period && ((r >> 11) & 0x01)) ?
+                           (twheel_test_rand(&seed) & TWHEEL_TEST_RESTART_MAX) + 1 : CLEAR; 
+            r = twheel_test_delay(&seed, TWHEEL_LEVELS); 
+
+            if (!twheel_add(&twheel_test_wheel, &ref->timer, r, ref->period))
+            {
+                twheel_test_errors++; 
+            }
+
+            ref->expires = twheel_test_wheel.now + r; 
+            ref->active = TRUE; 
+        }
+        else
+        {
+            twheel_remove(&twheel_test_wheel, &ref->timer); 
+            ref->active = FALSE; 
+        }
+
+        // Advance a random number of ticks 
+        r = twheel_test_rand(&seed); 
+
+        switch (r & 0x1F)
+        {
+            case 0:
+                // Stop the level 0 periodic timers first to keep the run time down 
+                for (uint8_t j = CLEAR; j < TWHEEL_TEST_TIMERS; j++)
+                {
+                    if (twheel_test_refs[j].period &&
+                        (twheel_test_refs[j].period < TWHEEL_SLOTS))
+                    {
+                        twheel_remove(&twheel_test_wheel, &twheel_test_refs[j].timer); 
+                        twheel_test_refs[j].active = FALSE; 
+                    }
+                }
+
+                step = (r >> 5) & TWHEEL_TEST_LONG_STEP; 
+                break; 
+            case 1: case 2: case 3: case 4: case 5: case 6: case 7:
+                step = (r >> 5) & TWHEEL_TEST_MID_STEP; 
+                break; 
+            default:
+                step = (r >> 5) & TWHEEL_TEST_SHORT_STEP; 
+                break; 
+        }
+
+        expiries += twheel_advance(&twheel_test_wheel, step); 
+        twheel_test_compare(); 
+    }
+
+    return expiries; 
+}
+
+
+// One shot timer callback 
+static void twheel_test_once_callback(twheel_timer_t *timer)
+{
+    twheel_test_app.once_delay += TWHEEL_TEST_ONCE_STEP; 
+
+    if (twheel_test_app.once_delay > TWHEEL_TEST_ONCE_MAX)
+    {
+        twheel_test_app.once_delay = TWHEEL_TEST_ONCE_STEP; 
+    }
+
+    twheel_start(timer, twheel_test_app.once_delay, CLEAR, twheel_test_once_callback, 
+                 NULL); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Benchmarks 
+
+// The benchmark wheel is loaded with periodic timers spread over the lower levels the 
+// first time either benchmark is called. 
+static void twheel_test_bench_setup(void)
+{
+    if (twheel_test_bench_ready)
+    {
+        return; 
+    }
+
+    twheel_init(&twheel_test_bench_wheel, CLEAR); 
+
+    for (uint8_t i = CLEAR; i < TWHEEL_TEST_BENCH_TIMERS; i++)
+    {
+        twheel_add(&twheel_test_bench_wheel, &twheel_test_bench_timers[i], i * i * i, 
+                   (i * TWHEEL_TEST_BENCH_STRIDE) % TWHEEL_MAX_TICKS + 1); 
+    }
+
+    twheel_test_bench_ready = TRUE; 
+}
+
+
+// Start and stop a timer - the delay changes each call to use every level 
+static void twheel_test_bench_start_stop(void)
+{
+    twheel_test_bench_setup(); 
+    twheel_test_bench_delay = (twheel_test_bench_delay + TWHEEL_TEST_BENCH_STRIDE) &
+                              TWHEEL_MAX_TICKS; 
+    twheel_add(&twheel_test_bench_wheel, &twheel_test_bench_timer, twheel_test_bench_delay, 
+               CLEAR); 
+    twheel_remove(&twheel_test_bench_wheel, &twheel_test_bench_timer); 
+}
+
+BENCH_REGISTER("twheel_start_stop", twheel_test_bench_start_stop)
+
+
+// Advance the loaded wheel 
+static void twheel_test_bench_advance(void)
+{
+    twheel_test_bench_setup(); 
+    twheel_advance(&twheel_test_bench_wheel, TWHEEL_TEST_BENCH_TICKS); 
+}
+
+BENCH_REGISTER("twheel_advance", twheel_test_bench_advance)
+
+//=======================================================================================
@@ -0,0 +1,243 @@
+/**
+ * @file uart_baud_test.c 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief UART baud rate calculator test 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "uart_baud_test.h" 
+#include "uart_baud.h" 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define UART_BAUD_TEST_BAUD 921600          // Baud rate used after the table check 
+#define UART_BAUD_TEST_LINE_LEN 80          // Max table line length 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Expected setting for a clock and baud rate 
+typedef struct uart_baud_test_case_s
+{
+    uint32_t pclk;                          // Peripheral clock (Hz) 
+    uint32_t baud;                          // Requested baud rate 
+    uint16_t brr;                           // BRR register value (0 if not supported) 
+    uint8_t over8;                          // Oversampling by 8 
+    uint32_t actual;                        // Actual baud rate 
+    int16_t error;                          // Error (hundredths of a percent) 
+}
+uart_baud_test_case_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Global variables 
+
+// Settings worked out by hand from USARTDIV = PCLK / (8 * (2 - OVER8) * baud) rather 
+// than with uart_baud_calc's math. Covers both oversampling modes, the switch between 
+// them and each reason a rate isn't supported (mantissa too big, divider too small, 
+// error over 2%). 
+static const uart_baud_test_case_t uart_baud_test_cases[] =
+{
+    {   8000000,     1200, 0x1A0B, 0,     1200,    0 }, 
+    {   8000000,   115200, 0x0045, 0,   115942,   64 }, 
+    {  16000000,     9600, 0x0683, 0,     9598,   -1 }, 
+    {  16000000,   115200, 0x008B, 0,   115108,   -7 }, 
+    {  16000000,   250000, 0x0040, 0,   250000,    0 }, 
+    {  16000000,  1000000, 0x0010, 0,  1000000,    0 },     // Lowest OVER16 divider 
+    {  16000000,  1500000, 0x0000, 0,        0,    0 },     // -3.03% 
+    {  16000000,  2000000, 0x0010, 1,  2000000,    0 }, 
+    {  25000000,   115200, 0x00D9, 0,   115207,    0 }, 
+    {  25000000,   921600, 0x001B, 0,   925926,   46 }, 
+    {  25000000,  3000000, 0x0000, 0,        0,    0 },     // +4.17% 
+    {  42000000,     1200, 0x88B8, 0,     1200,    0 }, 
+    {  42000000,     9600, 0x1117, 0,     9600,    0 }, 
+    {  42000000,   115200, 0x016D, 0,   115068,  -11 }, 
+    {  42000000,   921600, 0x002E, 0,   913043,  -92 }, 
+    {  42000000,  2000000, 0x0015, 0,  2000000,    0 }, 
+    {  42000000,  3000000, 0x0016, 1,  3000000,    0 }, 
+    {  42000000,  5250000, 0x0010, 1,  5250000,    0 },     // Lowest OVER8 divider 
+    {  42000000,  6000000, 0x0000, 0,        0,    0 },     // Divider 7 
+    {  84000000,     1200, 0x0000, 0,        0,    0 },     // Mantissa 4375 
+    {  84000000,     9600, 0x222E, 0,     9600,    0 }, 
+    {  84000000,   115200, 0x02D9, 0,   115226,    2 }, 
+    {  84000000,   921600, 0x005B, 0,   923077,   16 }, 
+    {  84000000, 10500000, 0x0010, 1, 10500000,    0 }, 
+    { 100000000,     1200, 0x0000, 0,        0,    0 },     // Mantissa 5208 
+    { 100000000, 10500000, 0x0000, 0,        0,    0 }      // -4.76% 
+}; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Function prototypes 
+
+/**
+ * @brief Check the baud rate setting for one clock and baud rate 
+ * 
+ * @param expected : clock, baud rate and the setting expected 
+ * @return uint8_t : TRUE if the result is correct 
+ */
+static uint8_t uart_baud_test_check(const uart_baud_test_case_t *expected); 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Setup code 
+
+void uart_baud_test_init(void)
+{
+    uart_baud_t setting; 
+    uint16_t checked = CLEAR, failed = CLEAR; 
+    char line[UART_BAUD_TEST_LINE_LEN]; 
+
+    // Initialize GPIO ports 
+    gpio_port_init(); 
+
+    // Initialize UART at the default baud rate - changed after the table check 
+    uart_init(
+        USART2, 
+        GPIOA, 
+        PIN_3, 
+        PIN_2, 
+        UART_FRAC_42_9600, 
+        UART_MANT_42_9600, 
+        UART_DMA_DISABLE, 
+        UART_DMA_DISABLE); 
+
+    uart_sendstring(USART2, "\r\n     PCLK     BAUD   BRR O8   ACTUAL   ERROR\r\n"); 
+
+    for (uint8_t i = CLEAR; 
+         i < (sizeof(uart_baud_test_cases) / sizeof(uart_baud_test_case_t)); 
+         i++)
+    {
+        checked++; 
+
+        if (!uart_baud_test_check(&uart_baud_test_cases[i]))
+        {
+            failed++; 
+        }
+    }
+
+    // The fixed values the UART was just initialized with 
+    checked++; 
+
+    if (!uart_baud_calc(42000000, 9600, &setting) || 
+        (setting.mantissa != UART_MANT_42_9600) || 
+        (setting.fraction != UART_FRAC_42_9600))
+    {
+        uart_sendstring(USART2, "UART_MANT_42_9600 / UART_FRAC_42_9600 mismatch  FAIL\r\n"); 
+        failed++; 
+    }
+
+    snprintf(
+        line, 
+        UART_BAUD_TEST_LINE_LEN, 
+        "\r\n%u combinations checked, %u failed\r\n", 
+        (unsigned)checked, 
+        (unsigned)failed); 
+    uart_sendstring(USART2, line); 
+
+    // Switch the serial terminal to the test baud rate 
+    if (uart_baud_calc(uart_baud_pclk(USART2), UART_BAUD_TEST_BAUD, &setting))
+    {
+        snprintf(
+            line, 
+            UART_BAUD_TEST_LINE_LEN, 
+            "Switching to %lu baud (actual %lu)\r\n", 
+            (unsigned long)UART_BAUD_TEST_BAUD, 
+            (unsigned long)setting.actual); 
+        uart_sendstring(USART2, line); 
+        uart_baud_set(USART2, UART_BAUD_TEST_BAUD, NULL); 
+        uart_sendstring(USART2, "\r\nType to echo\r\n"); 
+    }
+    else
+    {
+        uart_sendstring(USART2, "Test baud rate not supported by the UART clock\r\n"); 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Test code 
+
+void uart_baud_test_app(void)
+{
+    // Echo received characters at the new baud rate 
+    if (USART2->SR & USART_SR_RXNE)
+    {
+        uart_sendchar(USART2, (uint8_t)USART2->DR); 
+    }
+}
+
+
+// Check the baud rate setting for one clock and baud rate 
+static uint8_t uart_baud_test_check(const uart_baud_test_case_t *expected)
+{
+    uart_baud_t setting; 
+    char line[UART_BAUD_TEST_LINE_LEN]; 
+    uint8_t valid; 
+
+    if (!uart_baud_calc(expected->pclk, expected->baud, &setting))
+    {
+        valid = (expected->brr == 0); 
+
+        snprintf(
+            line, 
+            UART_BAUD_TEST_LINE_LEN, 
+            "%9lu %8lu   not supported%s\r\n", 
+            (unsigned long)expected->pclk, 
+            (unsigned long)expected->baud, 
+            valid ? "" : "  FAIL"); 
+        uart_sendstring(USART2, line); 
+        return valid; 
+    }
+
+    // The mantissa and fraction are the two fields of BRR 
+    valid = (setting.brr == expected->brr) && 
+            (setting.over8 == expected->over8) && 
+            (setting.actual == expected->actual) && 
+            (setting.error == expected->error) && 
+            (setting.brr == ((setting.mantissa << 4) | setting.fraction)); 
+
+    snprintf(
+        line, 
+        UART_BAUD_TEST_LINE_LEN, 
+        "%9lu %8lu  %04X  %u %8lu  %c%d.%02d%%%s\r\n", 
+        (unsigned long)expected->pclk, 
+        (unsigned long)expected->baud, 
+        (unsigned)setting.brr, 
+        (unsigned)setting.over8, 
+        (unsigned long)setting.actual, 
+        (setting.error < 0) ? '-' : '+', 
+        abs(setting.error) / 100, 
+        abs(setting.error) % 100, 
+        valid ? "" : "  FAIL"); 
+    uart_sendstring(USART2, line); 
+
+    return valid; 
+}
+
+//=======================================================================================
@@ -0,0 +1,427 @@
+/**
+ * @file dlog_decode.cpp 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Deferred format log decoder (host tool) 
+ * 
+ * @details Turns the message frames sent by DLOG (headers/core/dlog.h) back into text 
+ *          using the format strings in the dlog_fmt section of the ELF file that was 
+ *          run (target or host build). Input is read from a capture file or stdin as it 
+ *          arrives so the serial port or the host build can be piped straight in. Bytes 
+ *          that aren't part of a frame are written out unchanged. 
+ * 
+ *            make decoder 
+ *            ./build_host/STM32F4-driver-test-host | ./build_host/dlog_decode \
+ *                build_host/STM32F4-driver-test-host 
+ *            ./build_host/dlog_decode build/STM32F4-driver-test.elf capture.bin 
+ *            ./build_host/dlog_decode --list build/STM32F4-driver-test.elf 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//======================================================================================= 
+// Includes 
+
+#include <cstdint> 
+#include <cstdio> 
+#include <cstring> 
+#include <fstream> 
+#include <iterator> 
+#include <string> 
+#include <vector> 
+#include <unistd.h> 
+
+//======================================================================================= 
+
+
+//======================================================================================= 
+// Macros 
+
+// Frame format - must match dlog.h 
+#define DLOG_SYNC 0xD1 
+#define DLOG_HEADER_LEN 4 
+#define DLOG_ARGS_MAX 8 
+#define DLOG_ARG_LEN 4 
+
+#define DLOG_DECODE_READ_LEN 256             // Input read size 
+#define DLOG_DECODE_SPEC_LEN 32              // Max conversion specification length 
+#define DLOG_DECODE_TEXT_LEN 512             // Max length of a converted argument 
+
+//======================================================================================= 
+
+
+//======================================================================================= 
+// Format strings 
+
+// ELF header and section header fields needed (little endian, 32 or 64-bit) 
+static uint64_t dlog_decode_read(
+    const std::vector<uint8_t> &data, 
+    size_t offset, 
+    size_t size)
+{
+    uint64_t value = 0; 
+
+    if ((offset + size) > data.size())
+    {
+        return 0; 
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        value |= static_cast<uint64_t>(data[offset + i]) << (8 * i); 
+    }
+
+    return value; 
+}
+
+
+// Find the dlog_fmt section contents in an ELF file 
+static bool dlog_decode_load(
+    const char *path, 
+    std::string &formats)
+{
+    std::ifstream file(path, std::ios::binary); 
+    std::vector<uint8_t> elf((std::istreambuf_iterator<char>(file)), 
+                             std::istreambuf_iterator<char>()); 
+
+    if ((elf.size() < 0x34) || memcmp(elf.data(), "\177ELF", 4) || (elf[5] != 1))
+    {
+        fprintf(stderr, "%s is not a little endian ELF file\n", path); 
+        return false; 
+    }
+
+    // Header field offsets depend on the ELF class 
+    bool is_64 = (elf[4] == 2); 
+    uint64_t shoff = dlog_decode_read(elf, is_64 ? 0x28 : 0x20, is_64 ? 8 : 4); 
+    uint64_t shentsize = dlog_decode_read(elf, is_64 ? 0x3A : 0x2E, 2); 
+    uint64_t shnum = dlog_decode_read(elf, is_64 ? 0x3C : 0x30, 2); 
+    uint64_t shstrndx = dlog_decode_read(elf, is_64 ? 0x3E : 0x32, 2); 
+    size_t offset_field = is_64 ? 0x18 : 0x10; 
+    size_t size_field = is_64 ? 0x20 : 0x14; 
+    size_t field_len = is_64 ? 8 : 4; 
+
+    uint64_t names = dlog_decode_read(
+        elf, shoff + (shstrndx * shentsize) + offset_field, field_len); 
+
+    for (uint64_t i = 0; i < shnum; i++)
+    {
+        uint64_t header = shoff + (i * shentsize); 
+        uint64_t name = names + dlog_decode_read(elf, header, 4); 
+
+        if ((name < elf.size()) &&
+            !strncmp(reinterpret_cast<const char *>(&elf[name]), "dlog_fmt", 
+                     elf.size() - name))
+        {
+            uint64_t offset = dlog_decode_read(elf, header + offset_field, field_len); 
+            uint64_t size = dlog_decode_read(elf, header + size_field, field_len); 
+
+            if ((offset + size) > elf.size())
+            {
+                break; 
+            }
+
+            formats.assign(reinterpret_cast<const char *>(&elf[offset]), size); 
+            return true; 
+        }
+    }
+
+    fprintf(stderr, "No dlog_fmt section in %s\n", path); 
+    return false; 
+}
+
+//======================================================================================= 
+
+
+//======================================================================================= 
+// Formatting 
+
+/**
+ * @brief Format a message the way printf would have on the target 
+ * 
+ * @details Integer conversions take a 32-bit argument (length modifiers are ignored 
+ *          since int and long are both 32-bit on the target) and float conversions take 
+ *          the bits of a float. 
+ * 
+ * @param fmt : format string 
+ * @param args : arguments (NULL to count the arguments only) 
+ * @param num_args : number of arguments 
+ * @param text : formatted text 
+ * @return size_t : number of arguments the format uses 
+ */
+static size_t dlog_decode_format(
+    const char *fmt, 
+    const uint32_t *args, 
+    size_t num_args, 
+    std::string &text)
+{
+    size_t used = 0; 
+    char spec[DLOG_DECODE_SPEC_LEN + 4]; 
+    char converted[DLOG_DECODE_TEXT_LEN]; 
+
+    while (*fmt)
+    {
+        if (*fmt != '%')
+        {
+            text += *fmt++; 
+            continue; 
+        }
+
+        // Flags, width and precision are kept and the length modifier is dropped 
+        size_t spec_len = 0; 
+        spec[spec_len++] = *fmt++; 
+
+        while (*fmt && strchr("-+ #0123456789.", *fmt) && (spec_len < DLOG_DECODE_SPEC_LEN))
+        {
+            spec[spec_len++] = *fmt++; 
+        }
+
+        while (*fmt && strchr("hlLqjzt", *fmt))
+        {
+            fmt++; 
+        }
+
+        char conversion = *fmt; 
+
+        if (!conversion)
+        {
+            break; 
+        }
+
+        fmt++; 
+
+        if (conversion == '%')
+        {
+            text += '%'; 
+            continue; 
+        }
+
+        uint32_t arg = (args != NULL) && (used < num_args) ? args[used] : 0; 
+        used++; 
+        converted[0] = '\0'; 
+
+        if (strchr("di", conversion))
+        {
+            spec[spec_len++] = 'l'; 
+            spec[spec_len++] = conversion; 
+            spec[spec_len] = '\0'; 
+            snprintf(converted, sizeof(converted), spec, 
+                     static_cast<long>(static_cast<int32_t>(arg))); 
+        }
+        else if (strchr("uoxX", conversion))
+        {
+            spec[spec_len++] = 'l'; 
+            spec[spec_len++] = conversion; 
+            spec[spec_len] = '\0'; 
+            snprintf(converted, sizeof(converted), spec, static_cast<unsigned long>(arg)); 
+        }
+        else if (conversion == 'c')
+        {
+            spec[spec_len++] = conversion; 
+            spec[spec_len] = '\0'; 
+            snprintf(converted, sizeof(converted), spec, static_cast<int>(arg & 0xFF)); 
+        }
+        else if (strchr("fFeEgGaA", conversion))
+        {
+            float value; 
+            memcpy(&value, &arg, sizeof(value)); 
+            spec[spec_len++] = conversion; 
+            spec[spec_len] = '\0'; 
+            snprintf(converted, sizeof(converted), spec, static_cast<double>(value)); 
+        }
+        else
+        {
+            // Strings and pointers can't be sent 
+            snprintf(converted, sizeof(converted), "<%%%c 0x%08lX>", conversion, 
+                     static_cast<unsigned long>(arg)); 
+        }
+
+        text += converted; 
+    }
+
+    return used; 
+}
+
+//======================================================================================= 
+
+
+//======================================================================================= 
+// Decoding 
+
+/**
+ * @brief Decode the frames at the start of the pending input 
+ * 
+ * @param formats : dlog_fmt section contents 
+ * @param pending : input not yet written out 
+ * @param more : more input may arrive (hold back a frame that isn't complete yet) 
+ */
+static void dlog_decode_process(
+    const std::string &formats, 
+    std::vector<uint8_t> &pending, 
+    bool more)
+{
+    std::string out; 
+    size_t i = 0; 
+
+    while (i < pending.size())
+    {
+        if (pending[i] != DLOG_SYNC)
+        {
+            out += static_cast<char>(pending[i++]); 
+            continue; 
+        }
+
+        // Wait for the rest of the frame 
+        if ((pending.size() - i) < DLOG_HEADER_LEN)
+        {
+            if (more)
+            {
+                break; 
+            }
+
+            out += static_cast<char>(pending[i++]); 
+            continue; 
+        }
+
+        size_t args_len = pending[i + 1]; 
+        size_t id = pending[i + 2] | (static_cast<size_t>(pending[i + 3]) << 8); 
+        size_t num_args = args_len / DLOG_ARG_LEN; 
+        bool valid = !(args_len % DLOG_ARG_LEN) && (num_args <= DLOG_ARGS_MAX) &&
+                     (id < formats.size()) && (!id || (formats[id - 1] == '\0')); 
+
+        if (valid && ((pending.size() - i) < (DLOG_HEADER_LEN + args_len)))
+        {
+            if (more)
+            {
+                break; 
+            }
+
+            valid = false; 
+        }
+
+        if (valid)
+        {
+            uint32_t args[DLOG_ARGS_MAX]; 
+            std::string text; 
+
+            for (size_t j = 0; j < num_args; j++)
+            {
+                size_t arg = i + DLOG_HEADER_LEN + (j * DLOG_ARG_LEN); 
+                args[j] = pending[arg] | (pending[arg + 1] << 8) |
+                          (pending[arg + 2] << 16) |
+                          (static_cast<uint32_t>(pending[arg + 3]) << 24); 
+            }
+
+            // The format must use exactly the number of arguments sent 
+            valid = (dlog_decode_format(&formats[id], args, num_args, text) == num_args); 
+
+            if (valid)
+            {
+                out += text; 
+                i += DLOG_HEADER_LEN + args_len; 
+                continue; 
+            }
+        }
+
+        // Not a frame - the sync byte is plain output 
+        out += static_cast<char>(pending[i++]); 
+    }
+
+    fwrite(out.data(), 1, out.size(), stdout); 
+    fflush(stdout); 
+    pending.erase(pending.begin(), pending.begin() + i); 
+}
+
+
+// List the message IDs and formats 
+static void dlog_decode_list(const std::string &formats)
+{
+    std::string unused; 
+
+    for (size_t id = 0; id < formats.size(); id += strlen(&formats[id]) + 1)
+    {
+        if (!formats[id])
+        {
+            continue; 
+        }
+
+        size_t num_args = dlog_decode_format(&formats[id], NULL, 0, unused); 
+        printf("%5zu  %zu args  \"", id, num_args); 
+
+        for (const char *c = &formats[id]; *c; c++)
+        {
+            if ((*c < ' ') || (*c > '~'))
+            {
+                printf("\\x%02X", static_cast<uint8_t>(*c)); 
+            }
+            else
+            {
+                putchar(*c); 
+            }
+        }
+
+        printf("\"\n"); 
+    }
+}
+
+//======================================================================================= 
+
+
+//======================================================================================= 
+// Main 
+
+int main(int argc, char **argv)
+{
+    std::string formats; 
+    std::vector<uint8_t> pending; 
+    uint8_t buff[DLOG_DECODE_READ_LEN]; 
+    bool list = (argc > 1) && !strcmp(argv[1], "--list"); 
+    int arg = list ? 2 : 1; 
+
+    if ((argc - arg) < 1)
+    {
+        fprintf(stderr, "Usage: %s [--list] ELF [CAPTURE]\n", argv[0]); 
+        return 1; 
+    }
+
+    if (!dlog_decode_load(argv[arg], formats))
+    {
+        return 1; 
+    }
+
+    if (list)
+    {
+        dlog_decode_list(formats); 
+        return 0; 
+    }
+
+    FILE *input = ((argc - arg) > 1) ? fopen(argv[arg + 1], "rb") : stdin; 
+
+    if (input == NULL)
+    {
+        fprintf(stderr, "Can't open %s\n", argv[arg + 1]); 
+        return 1; 
+    }
+
+    // Decode as input arrives - read returns whatever a pipe has so far 
+    for (ssize_t len; (len = read(fileno(input), buff, sizeof(buff))) > 0;)
+    {
+        pending.insert(pending.end(), buff, buff + len); 
+        dlog_decode_process(formats, pending, true); 
+    }
+
+    dlog_decode_process(formats, pending, false); 
+
+    if (input != stdin)
+    {
+        fclose(input); 
+    }
+
+    return 0; 
+}
+
+//======================================================================================= 
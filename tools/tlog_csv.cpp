@@ -0,0 +1,358 @@
+/**
+ * @file tlog_csv.cpp 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Telemetry log to CSV exporter (host tool) 
+ * 
+ * @details Writes the records of a telemetry log (headers/core/tlog.h) between two 
+ *          times to stdout as CSV. Each row has the record's time (seconds on the 
+ *          system clock), its type and the columns of every type asked for, with only 
+ *          its own type's columns filled in. --info gives the log's time span, chunk 
+ *          and record counts and what a seek cost instead. 
+ * 
+ *            make tlog 
+ *            ./build_host/tlog_csv --info tlog.bin 
+ *            ./build_host/tlog_csv --from 120 --to 150 tlog.bin > event.csv 
+ *            ./build_host/tlog_csv --types gps,heading tlog.bin > track.csv 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "tlog_reader.h" 
+#include <cstdlib> 
+#include <cstring> 
+#include <string> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define TLOG_CSV_US_PER_S 1000000.0         // Microseconds per second 
+#define TLOG_CSV_DEG 1e7                    // GPS 1e-7 degrees per degree 
+#define TLOG_CSV_CM 100.0                   // Centimeters per meter 
+#define TLOG_CSV_TENTHS 10.0                // Tenths of a degree per degree 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Columns 
+
+// Name and columns of each record type 
+static const struct
+{
+    const char *name; 
+    const char *columns; 
+}
+tlog_csv_types[TLOG_TYPE_COUNT] =
+{
+    { "end", "" }, 
+    { "gps", "lat,lon,alt_m,speed_mps,fix,sats" }, 
+    { "heading", "heading_deg,target_deg" }, 
+    { "imu", "ax,ay,az,gx,gy,gz" }, 
+    { "throttle", "right,left" }, 
+    { "radio", "link,channel,frames,lost,bad" }
+}; 
+
+
+// Number of columns of a type 
+static size_t tlog_csv_num_columns(size_t type)
+{
+    const char *columns = tlog_csv_types[type].columns; 
+
+    if (!*columns)
+    {
+        return 0; 
+    }
+
+    size_t num = 1; 
+
+    for (const char *c = columns; *c; c++)
+    {
+        num += (*c == ','); 
+    }
+
+    return num; 
+}
+
+
+// Values of a record's own columns 
+static std::string tlog_csv_values(const tlog_record_t &record)
+{
+    char text[128]; 
+
+    switch (record.type)
+    {
+        case TLOG_TYPE_GPS:
+            snprintf(text, sizeof(text), "%.7f,%.7f,%.2f,%.2f,%u,%u", 
+                     record.gps.lat / TLOG_CSV_DEG, record.gps.lon / TLOG_CSV_DEG, 
+                     record.gps.alt / TLOG_CSV_CM, record.gps.speed / TLOG_CSV_CM, 
+                     record.gps.fix, record.gps.sats); 
+            break; 
+
+        case TLOG_TYPE_HEADING:
+            snprintf(text, sizeof(text), "%.1f,%.1f", 
+                     record.heading.heading / TLOG_CSV_TENTHS, 
+                     record.heading.target / TLOG_CSV_TENTHS); 
+            break; 
+
+        case TLOG_TYPE_IMU:
+            snprintf(text, sizeof(text), "%d,%d,%d,%d,%d,%d", 
+                     record.imu.accel[0], record.imu.accel[1], record.imu.accel[2], 
+                     record.imu.gyro[0], record.imu.gyro[1], record.imu.gyro[2]); 
+            break; 
+
+        case TLOG_TYPE_THROTTLE:
+            snprintf(text, sizeof(text), "%d,%d", 
+                     record.throttle.throttle[TLOG_RIGHT], 
+                     record.throttle.throttle[TLOG_LEFT]); 
+            break; 
+
+        case TLOG_TYPE_RADIO:
+            snprintf(text, sizeof(text), "%u,%u,%u,%u,%u", 
+                     record.radio.link, record.radio.channel, record.radio.frames, 
+                     record.radio.lost, record.radio.bad); 
+            break; 
+
+        default:
+            text[0] = '\0'; 
+            break; 
+    }
+
+    return text; 
+}
+
+
+// Select the types named in a comma separated list 
+static bool tlog_csv_select(
+    const char *list, 
+    bool *selected)
+{
+    std::string names(list); 
+    size_t start = 0; 
+
+    std::fill(selected, selected + TLOG_TYPE_COUNT, false); 
+
+    while (start <= names.size())
+    {
+        size_t end = names.find(',', start); 
+        std::string name = names.substr(start, (end == std::string::npos) ?
+                                               std::string::npos : (end - start)); 
+        bool found = false; 
+
+        for (size_t type = TLOG_TYPE_GPS; type < TLOG_TYPE_COUNT; type++)
+        {
+            if (name == tlog_csv_types[type].name)
+            {
+                selected[type] = found = true; 
+            }
+        }
+
+        if (!found)
+        {
+            fprintf(stderr, "Unknown record type '%s'\n", name.c_str()); 
+            return false; 
+        }
+
+        if (end == std::string::npos)
+        {
+            break; 
+        }
+
+        start = end + 1; 
+    }
+
+    return true; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Output 
+
+// Write the records between two times as CSV 
+static void tlog_csv_export(
+    tlog_reader &reader, 
+    uint64_t from, 
+    uint64_t to, 
+    const bool *selected)
+{
+    tlog_record_t record; 
+    std::string line; 
+
+    printf("time_s,type"); 
+
+    for (size_t type = TLOG_TYPE_GPS; type < TLOG_TYPE_COUNT; type++)
+    {
+        if (selected[type])
+        {
+            printf(",%s", tlog_csv_types[type].columns); 
+        }
+    }
+
+    printf("\n"); 
+
+    if (!reader.seek(from))
+    {
+        return; 
+    }
+
+    while (reader.next(record) && (record.time <= to))
+    {
+        if (!selected[record.type])
+        {
+            continue; 
+        }
+
+        char time[32]; 
+        snprintf(time, sizeof(time), "%.6f", record.time / TLOG_CSV_US_PER_S); 
+        line = time; 
+        line += ','; 
+        line += tlog_csv_types[record.type].name; 
+
+        // Empty columns for the other types 
+        for (size_t type = TLOG_TYPE_GPS; type < TLOG_TYPE_COUNT; type++)
+        {
+            if (!selected[type])
+            {
+                continue; 
+            }
+
+            if (type == record.type)
+            {
+                line += ','; 
+                line += tlog_csv_values(record); 
+            }
+            else
+            {
+                line.append(tlog_csv_num_columns(type), ','); 
+            }
+        }
+
+        line += '\n'; 
+        fwrite(line.data(), 1, line.size(), stdout); 
+    }
+}
+
+
+// Log summary 
+static void tlog_csv_info(
+    tlog_reader &reader, 
+    uint64_t from)
+{
+    tlog_record_t record; 
+    uint64_t counts[TLOG_TYPE_COUNT] = { 0 }; 
+    uint64_t first = 0, last = 0, total = 0, data_chunks, index_chunks; 
+    uint32_t reads; 
+
+    reader.chunks(data_chunks, index_chunks); 
+
+    while (reader.next(record))
+    {
+        first = total ? first : record.time; 
+        last = record.time; 
+        counts[record.type]++; 
+        total++; 
+    }
+
+    printf("%llu data chunks, %llu index chunks, %llu records\n", 
+           static_cast<unsigned long long>(data_chunks), 
+           static_cast<unsigned long long>(index_chunks), 
+           static_cast<unsigned long long>(total)); 
+    printf("Time %.3f s to %.3f s (%.3f s)\n", first / TLOG_CSV_US_PER_S, 
+           last / TLOG_CSV_US_PER_S, (last - first) / TLOG_CSV_US_PER_S); 
+
+    for (size_t type = TLOG_TYPE_GPS; type < TLOG_TYPE_COUNT; type++)
+    {
+        printf("  %-9s %llu\n", tlog_csv_types[type].name, 
+               static_cast<unsigned long long>(counts[type])); 
+    }
+
+    // What finding a time costs 
+    from = from ? from : (first + ((last - first) / 2)); 
+    reads = reader.reads(); 
+    reader.seek(from); 
+    printf("Seek to %.3f s: %u reads\n", from / TLOG_CSV_US_PER_S, 
+           static_cast<unsigned>(reader.reads() - reads)); 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Main 
+
+int main(int argc, char **argv)
+{
+    tlog_reader reader; 
+    bool selected[TLOG_TYPE_COUNT]; 
+    bool info = false; 
+    uint64_t from = 0, to = UINT64_MAX; 
+    int arg = 1; 
+
+    std::fill(selected, selected + TLOG_TYPE_COUNT, true); 
+
+    for (; (arg < (argc - 1)) && !strncmp(argv[arg], "--", 2); arg++)
+    {
+        if (!strcmp(argv[arg], "--info"))
+        {
+            info = true; 
+        }
+        else if (!strcmp(argv[arg], "--from") && ((arg + 2) < argc))
+        {
+            from = static_cast<uint64_t>(strtod(argv[++arg], NULL) * TLOG_CSV_US_PER_S); 
+        }
+        else if (!strcmp(argv[arg], "--to") && ((arg + 2) < argc))
+        {
+            to = static_cast<uint64_t>(strtod(argv[++arg], NULL) * TLOG_CSV_US_PER_S); 
+        }
+        else if (!strcmp(argv[arg], "--types") && ((arg + 2) < argc))
+        {
+            if (!tlog_csv_select(argv[++arg], selected))
+            {
+                return 1; 
+            }
+        }
+        else
+        {
+            break; 
+        }
+    }
+
+    if (arg != (argc - 1))
+    {
+        fprintf(stderr, "Usage: %s [--info] [--from S] [--to S] [--types gps,heading,imu,"
+                        "throttle,radio] LOG\n", argv[0]); 
+        return 1; 
+    }
+
+    if (!reader.open(argv[arg]))
+    {
+        fprintf(stderr, "%s is not a telemetry log\n", argv[arg]); 
+        return 1; 
+    }
+
+    if (info)
+    {
+        tlog_csv_info(reader, from); 
+    }
+    else
+    {
+        tlog_csv_export(reader, from, to, selected); 
+    }
+
+    return 0; 
+}
+
+//=======================================================================================
@@ -0,0 +1,329 @@
+/**
+ * @file tlog_reader.cpp 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Telemetry log reader (host tool) 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+//=======================================================================================
+// Includes 
+
+#include "tlog_reader.h" 
+#include <algorithm> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Macros 
+
+#define TLOG_READER_GROUP (TLOG_INDEX_EVERY + 1)   // Data chunks and their index chunk 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Helpers 
+
+// Read a little endian value 
+static uint64_t tlog_reader_get(
+    const uint8_t *buff, 
+    size_t len)
+{
+    uint64_t value = 0; 
+
+    for (size_t i = 0; i < len; i++)
+    {
+        value |= static_cast<uint64_t>(buff[i]) << (8 * i); 
+    }
+
+    return value; 
+}
+
+
+// Decode the contents of a record 
+static void tlog_reader_decode(
+    const uint8_t *data, 
+    tlog_record_t &record)
+{
+    switch (record.type)
+    {
+        case TLOG_TYPE_GPS:
+            record.gps.lat = static_cast<int32_t>(tlog_reader_get(&data[0], 4)); 
+            record.gps.lon = static_cast<int32_t>(tlog_reader_get(&data[4], 4)); 
+            record.gps.alt = static_cast<int32_t>(tlog_reader_get(&data[8], 4)); 
+            record.gps.speed = static_cast<uint16_t>(tlog_reader_get(&data[12], 2)); 
+            record.gps.fix = data[14]; 
+            record.gps.sats = data[15]; 
+            break; 
+
+        case TLOG_TYPE_HEADING:
+            record.heading.heading = static_cast<uint16_t>(tlog_reader_get(&data[0], 2)); 
+            record.heading.target = static_cast<uint16_t>(tlog_reader_get(&data[2], 2)); 
+            break; 
+
+        case TLOG_TYPE_IMU:
+            for (size_t axis = 0; axis < TLOG_IMU_AXES; axis++)
+            {
+                record.imu.accel[axis] =
+                    static_cast<int16_t>(tlog_reader_get(&data[axis * 2], 2)); 
+                record.imu.gyro[axis] =
+                    static_cast<int16_t>(tlog_reader_get(&data[(TLOG_IMU_AXES + axis) * 2], 2)); 
+            }
+            break; 
+
+        case TLOG_TYPE_THROTTLE:
+            record.throttle.throttle[TLOG_RIGHT] =
+                static_cast<int16_t>(tlog_reader_get(&data[0], 2)); 
+            record.throttle.throttle[TLOG_LEFT] =
+                static_cast<int16_t>(tlog_reader_get(&data[2], 2)); 
+            break; 
+
+        case TLOG_TYPE_RADIO:
+            record.radio.link = data[0]; 
+            record.radio.channel = data[1]; 
+            record.radio.frames = static_cast<uint16_t>(tlog_reader_get(&data[2], 2)); 
+            record.radio.lost = static_cast<uint16_t>(tlog_reader_get(&data[4], 2)); 
+            record.radio.bad = static_cast<uint16_t>(tlog_reader_get(&data[6], 2)); 
+            break; 
+
+        default:
+            break; 
+    }
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// File 
+
+tlog_reader::~tlog_reader()
+{
+    if (file != nullptr)
+    {
+        std::fclose(file); 
+    }
+}
+
+
+// Open a log file 
+bool tlog_reader::open(const char *path)
+{
+    uint8_t header[TLOG_HEADER_LEN]; 
+    long size; 
+
+    if (file != nullptr)
+    {
+        std::fclose(file); 
+    }
+
+    file = std::fopen(path, "rb"); 
+
+    if ((file == nullptr) || std::fseek(file, 0, SEEK_END) || ((size = std::ftell(file)) < 0))
+    {
+        return false; 
+    }
+
+    num_chunks = (static_cast<uint64_t>(size) + TLOG_CHUNK_SIZE - 1) / TLOG_CHUNK_SIZE; 
+    num_index = num_chunks / TLOG_READER_GROUP; 
+    num_data = (num_index * TLOG_INDEX_EVERY) + (num_chunks % TLOG_READER_GROUP); 
+    num_reads = 0; 
+    index_group = UINT64_MAX; 
+    index.assign(TLOG_CHUNK_SIZE, 0); 
+    chunk.assign(TLOG_CHUNK_SIZE, 0); 
+    data = 0; 
+    loaded = false; 
+    from = 0; 
+
+    // A chunk cut off before its header was written isn't counted 
+    while (num_data && !read_chunk(data_chunk(num_data - 1), header, sizeof(header)))
+    {
+        num_data--; 
+    }
+
+    return num_data && read_chunk(0, header, sizeof(header)); 
+}
+
+
+// Read bytes of a chunk 
+bool tlog_reader::read_chunk(
+    uint64_t chunk_num, 
+    uint8_t *buff, 
+    size_t len)
+{
+    size_t got = 0; 
+    uint8_t kind = ((chunk_num % TLOG_READER_GROUP) == TLOG_INDEX_EVERY) ?
+                   TLOG_CHUNK_INDEX : TLOG_CHUNK_DATA; 
+
+    if (!std::fseek(file, static_cast<long>(chunk_num * TLOG_CHUNK_SIZE), SEEK_SET))
+    {
+        got = std::fread(buff, 1, len, file); 
+    }
+
+    std::fill(buff + got, buff + len, 0); 
+    num_reads++; 
+
+    return (got >= TLOG_HEADER_LEN) && (tlog_reader_get(&buff[0], 2) == TLOG_MAGIC) &&
+           (buff[2] == kind) && (buff[3] == TLOG_VERSION) &&
+           (tlog_reader_get(&buff[4], 4) == (chunk_num & UINT32_MAX)); 
+}
+
+
+// Chunk number of a data chunk 
+uint64_t tlog_reader::data_chunk(uint64_t data_num)
+{
+    return data_num + (data_num / TLOG_INDEX_EVERY); 
+}
+
+
+// Chunks in the file 
+void tlog_reader::chunks(
+    uint64_t &data_chunks, 
+    uint64_t &index_chunks) const
+{
+    data_chunks = num_data; 
+    index_chunks = num_index; 
+}
+
+
+// Reads from the file since it was opened 
+uint32_t tlog_reader::reads(void) const
+{
+    return num_reads; 
+}
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Seeking 
+
+// Header time of a data chunk 
+bool tlog_reader::data_time(
+    uint64_t data_num, 
+    uint64_t &chunk_time)
+{
+    uint8_t header[TLOG_HEADER_LEN]; 
+    uint64_t group = data_num / TLOG_INDEX_EVERY; 
+
+    // Indexed chunks come from the index chunk, which is kept for the next look up 
+    if (group < num_index)
+    {
+        if ((group != index_group) &&
+            !read_chunk((group * TLOG_READER_GROUP) + TLOG_INDEX_EVERY, 
+                        index.data(), index.size()))
+        {
+            index_group = UINT64_MAX; 
+            return false; 
+        }
+
+        index_group = group; 
+        chunk_time = tlog_reader_get(
+            &index[TLOG_HEADER_LEN + ((data_num % TLOG_INDEX_EVERY) * TLOG_INDEX_ENTRY_LEN)], 
+            TLOG_INDEX_ENTRY_LEN); 
+        return true; 
+    }
+
+    if (!read_chunk(data_chunk(data_num), header, sizeof(header)))
+    {
+        return false; 
+    }
+
+    chunk_time = tlog_reader_get(&header[8], 8); 
+    return true; 
+}
+
+
+// Move to a time 
+bool tlog_reader::seek(uint64_t seek_time)
+{
+    uint64_t low = 0, high = num_data, mid, chunk_time; 
+    tlog_record_t record; 
+
+    // Last data chunk starting at or before the time. A chunk whose time can't be read 
+    // is taken as before it. 
+    while ((high - low) > 1)
+    {
+        mid = low + ((high - low) / 2); 
+
+        if (!data_time(mid, chunk_time) || (chunk_time <= seek_time))
+        {
+            low = mid; 
+        }
+        else
+        {
+            high = mid; 
+        }
+    }
+
+    data = low; 
+    loaded = false; 
+    from = seek_time; 
+
+    // Check there's a record left without using it up 
+    if (!next(record))
+    {
+        return false; 
+    }
+
+    loaded = false; 
+    from = record.time; 
+
+    return true; 
+}
+
+
+// Read the next record 
+bool tlog_reader::next(tlog_record_t &record)
+{
+    static const uint8_t lens[TLOG_TYPE_COUNT] = TLOG_RECORD_LENS; 
+
+    while (data < num_data)
+    {
+        if (!loaded)
+        {
+            if (!read_chunk(data_chunk(data), chunk.data(), chunk.size()))
+            {
+                data++; 
+                continue; 
+            }
+
+            time = tlog_reader_get(&chunk[8], 8); 
+            pos = TLOG_HEADER_LEN; 
+            loaded = true; 
+        }
+
+        // Zeros, an unknown type or a record cut off end the chunk 
+        uint8_t type = ((pos + TLOG_RECORD_HEADER_LEN) <= chunk.size()) ? chunk[pos] : 0; 
+
+        if ((type == TLOG_TYPE_END) || (type >= TLOG_TYPE_COUNT) ||
+            ((pos + TLOG_RECORD_HEADER_LEN + lens[type]) > chunk.size()))
+        {
+            data++; 
+            loaded = false; 
+            continue; 
+        }
+
+        record.type = static_cast<tlog_type_t>(type); 
+        record.time = time + tlog_reader_get(&chunk[pos + 1], 3); 
+        tlog_reader_decode(&chunk[pos + TLOG_RECORD_HEADER_LEN], record); 
+        pos += TLOG_RECORD_HEADER_LEN + lens[type]; 
+
+        if (record.time >= from)
+        {
+            return true; 
+        }
+    }
+
+    return false; 
+}
+
+//=======================================================================================
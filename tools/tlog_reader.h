@@ -0,0 +1,170 @@
+/**
+ * @file tlog_reader.h 
+ * 
+ * @author Sam Donnelly (samueldonnelly11@gmail.com) 
+ * 
+ * @brief Telemetry log reader (host tool) interface 
+ * 
+ * @details Reads the records of a telemetry log (headers/core/tlog.h) copied off the 
+ *          SD card. A seek finds the data chunk holding a time with a binary search 
+ *          that takes chunk times from the index chunks where there are any and from 
+ *          the data chunk headers after the last one, so only a few reads are needed 
+ *          however long the log is. Records are then read in time order from there. 
+ * 
+ *          A log cut short (ex. power lost before tlog_close) is read up to its last 
+ *          whole record. Chunks with a bad header are skipped. 
+ * 
+ * @version 0.1 
+ * @date 2026-10-16 
+ * 
+ * @copyright Copyright (c) 2026 
+ * 
+ */
+
+#ifndef _TLOG_READER_H_ 
+#define _TLOG_READER_H_ 
+
+//=======================================================================================
+// Includes 
+
+#include "tlog_format.h" 
+#include <cstdint> 
+#include <cstdio> 
+#include <vector> 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Structs 
+
+// Decoded record 
+typedef struct tlog_record_s
+{
+    tlog_type_t type;                       // Record type 
+    uint64_t time;                          // Time (us) 
+    union
+    {
+        tlog_gps_t gps; 
+        tlog_heading_t heading; 
+        tlog_imu_t imu; 
+        tlog_throttle_t throttle; 
+        tlog_radio_t radio; 
+    }; 
+}
+tlog_record_t; 
+
+//=======================================================================================
+
+
+//=======================================================================================
+// Classes 
+
+class tlog_reader
+{
+public:
+    tlog_reader() = default; 
+    ~tlog_reader(); 
+    tlog_reader(const tlog_reader &) = delete; 
+    tlog_reader &operator=(const tlog_reader &) = delete; 
+
+    /**
+     * @brief Open a log file 
+     * 
+     * @details Reading starts at the first record. 
+     * 
+     * @param path : log file 
+     * @return bool : true if the file starts with a telemetry log chunk 
+     */
+    bool open(const char *path); 
+
+    /**
+     * @brief Move to a time 
+     * 
+     * @param seek_time : time (us) 
+     * @return bool : true if there are records at or after the time 
+     */
+    bool seek(uint64_t seek_time); 
+
+    /**
+     * @brief Read the next record 
+     * 
+     * @param record : decoded record 
+     * @return bool : true if there was a record, false at the end of the log 
+     */
+    bool next(tlog_record_t &record); 
+
+    /**
+     * @brief Chunks in the file 
+     * 
+     * @param data_chunks : data chunks 
+     * @param index_chunks : index chunks 
+     */
+    void chunks(
+        uint64_t &data_chunks, 
+        uint64_t &index_chunks) const; 
+
+    /**
+     * @brief Reads from the file since it was opened (ex. to see what a seek cost) 
+     * 
+     * @return uint32_t : number of reads 
+     */
+    uint32_t reads(void) const; 
+
+private:
+    /**
+     * @brief Read bytes of a chunk 
+     * 
+     * @details Bytes past the end of the file read as zeros. 
+     * 
+     * @param chunk_num : chunk number 
+     * @param buff : where the bytes go 
+     * @param len : number of bytes from the start of the chunk 
+     * @return bool : true if the chunk has a valid header for its place 
+     */
+    bool read_chunk(
+        uint64_t chunk_num, 
+        uint8_t *buff, 
+        size_t len); 
+
+    /**
+     * @brief Header time of a data chunk 
+     * 
+     * @param data_num : data chunk number (counting data chunks only) 
+     * @param chunk_time : header time (us) 
+     * @return bool : true if the time was found 
+     */
+    bool data_time(
+        uint64_t data_num, 
+        uint64_t &chunk_time); 
+
+    /**
+     * @brief Chunk number of a data chunk 
+     * 
+     * @param data_num : data chunk number (counting data chunks only) 
+     * @return uint64_t : chunk number in the file 
+     */
+    static uint64_t data_chunk(uint64_t data_num); 
+
+    std::FILE *file = nullptr;              // Log file 
+    uint64_t num_chunks = 0;                // Chunks in the file (last may be partial) 
+    uint64_t num_data = 0;                  // Data chunks 
+    uint64_t num_index = 0;                 // Index chunks 
+    uint32_t num_reads = 0;                 // Reads from the file 
+
+    // Index chunk last read 
+    std::vector<uint8_t> index;             // Index chunk contents 
+    uint64_t index_group = UINT64_MAX;      // Index chunk number (counting index chunks) 
+
+    // Reading position 
+    std::vector<uint8_t> chunk;             // Data chunk being read 
+    uint64_t data = 0;                      // Data chunk number being read 
+    bool loaded = false;                    // 'chunk' holds data chunk 'data' 
+    uint64_t time = 0;                      // Header time of the data chunk being read 
+    size_t pos = 0;                         // Next record in the data chunk 
+    uint64_t from = 0;                      // Records before this time are skipped (us) 
+}; 
+
+//=======================================================================================
+
+#endif   // _TLOG_READER_H_ 